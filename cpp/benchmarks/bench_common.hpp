@@ -0,0 +1,179 @@
+/**
+ * @file bench_common.hpp
+ * @author Carlos Salguero
+ * @brief Shared fixtures and helpers for VeloxDB benchmarks
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+#include <vector>
+#include <velox/metrics/perf_counters.hpp>
+#include <velox/storage/storage_engine.hpp>
+
+namespace velox::bench {
+/// @brief Table used by the storage benchmarks
+constexpr std::string_view BENCH_TABLE = "bench";
+
+/**
+ * @brief Unique scratch directory removed on destruction
+ */
+class TempDirectory {
+public:
+  /**
+   * @brief Create a fresh directory under the system temp path
+   *
+   * @param prefix Directory name prefix
+   */
+  explicit TempDirectory(std::string_view prefix = "velox_bench") {
+    static std::atomic<uint64_t> sequence{0};
+    m_path = std::filesystem::temp_directory_path() /
+             fmt::format("{}_{}_{}", prefix, ::getpid(),
+                         sequence.fetch_add(1, std::memory_order_relaxed));
+    std::filesystem::create_directories(m_path);
+  }
+
+  /// @brief Remove the directory and its contents
+  ~TempDirectory() {
+    std::error_code ec;
+    std::filesystem::remove_all(m_path, ec);
+  }
+
+  TempDirectory(const TempDirectory &) = delete;
+  TempDirectory &operator=(const TempDirectory &) = delete;
+
+  /**
+   * @brief Get the directory path
+   * @return Path
+   */
+  [[nodiscard]] const std::filesystem::path &path() const noexcept {
+    return m_path;
+  }
+
+private:
+  std::filesystem::path m_path;
+};
+
+/**
+ * @brief Storage engine living in its own scratch directory
+ */
+struct EngineEnvironment {
+  TempDirectory directory;
+  std::unique_ptr<storage::StorageEngine> engine;
+
+  /**
+   * @brief Create and initialize an engine
+   *
+   * @param buffer_pool_size Buffer pool size in pages
+   * @param enable_wal Whether write-ahead logging is enabled
+   * @return Environment, or nullptr if the engine failed to initialize
+   */
+  [[nodiscard]] static std::unique_ptr<EngineEnvironment>
+  create(size_t buffer_pool_size, bool enable_wal = true) {
+    auto env = std::make_unique<EngineEnvironment>();
+
+    storage::StorageConfig config;
+    config.data_directory = env->directory.path();
+    config.buffer_pool_size = buffer_pool_size;
+    config.enable_wal = enable_wal;
+
+    env->engine = std::make_unique<storage::StorageEngine>(std::move(config));
+    if (!env->engine->initialize()) {
+      return nullptr;
+    }
+
+    return env;
+  }
+
+  /// @brief Shut the engine down before the directory is removed
+  ~EngineEnvironment() {
+    if (engine && engine->is_initialized()) {
+      (void)engine->shutdown();
+    }
+  }
+};
+
+/**
+ * @brief Deterministic payload of a given size
+ *
+ * @param size Payload size in bytes
+ * @param seed Generator seed
+ * @return Random bytes
+ */
+[[nodiscard]] inline std::vector<uint8_t> make_payload(size_t size,
+                                                       uint64_t seed = 42) {
+  std::mt19937_64 rng(seed);
+  std::vector<uint8_t> payload(size);
+  for (auto &byte : payload) {
+    byte = static_cast<uint8_t>(rng());
+  }
+
+  return payload;
+}
+
+/**
+ * @brief Reports hardware counters per iteration into benchmark output
+ *
+ * @note Construct before the timing loop; counters are added to the state
+ *       on destruction. Does nothing when perf counters are unavailable.
+ */
+class PerfReport {
+public:
+  /**
+   * @brief Start measuring
+   *
+   * @param state Benchmark state receiving the counters
+   */
+  explicit PerfReport(benchmark::State &state)
+      : m_state(state), m_counters(metrics::thread_perf_counters()) {
+    if (m_counters) {
+      m_start = m_counters->read();
+    }
+  }
+
+  /// @brief Stop measuring and publish per-iteration counters
+  ~PerfReport() {
+    if (!m_counters) {
+      return;
+    }
+
+    const auto delta = m_counters->read() - m_start;
+    for (size_t i = 0; i < metrics::PERF_EVENT_COUNT; ++i) {
+      const auto event = static_cast<metrics::PerfEvent>(i);
+      if (delta.has(event)) {
+        m_state.counters[std::string(metrics::to_string(event))] =
+            benchmark::Counter(static_cast<double>(delta.get(event)),
+                               benchmark::Counter::kAvgIterations);
+      }
+    }
+
+    if (delta.ipc() > 0.0) {
+      m_state.counters["ipc"] =
+          benchmark::Counter(delta.ipc(), benchmark::Counter::kAvgThreads);
+    }
+  }
+
+  PerfReport(const PerfReport &) = delete;
+  PerfReport &operator=(const PerfReport &) = delete;
+
+private:
+  benchmark::State &m_state;
+  const metrics::PerfCounters *m_counters;
+  metrics::PerfSample m_start;
+};
+
+} // namespace velox::bench
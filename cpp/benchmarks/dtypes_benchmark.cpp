@@ -0,0 +1,460 @@
+/**
+ * @file dtypes_benchmark.cpp
+ * @author Carlos Salguero
+ * @brief Benchmarks for value serialization, comparison and hashing
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "bench_common.hpp"
+
+#include <velox/dtypes.hpp>
+
+namespace velox::bench {
+namespace {
+using dtypes::TypeId;
+using dtypes::Value;
+
+/// @brief Distinct inputs cycled through by each benchmark (power of two)
+constexpr size_t VALUE_POOL_SIZE = 1024;
+
+/// @brief Types with a Value representation
+/// @note INTERVAL, ARRAY, STRUCT, MAP and CUSTOM have no Value alternative yet
+constexpr std::array BENCH_TYPES = {
+    TypeId::NULL_TYPE, TypeId::BOOLEAN, TypeId::TINYINT,   TypeId::SMALLINT,
+    TypeId::INTEGER,   TypeId::BIGINT,  TypeId::REAL,      TypeId::DOUBLE,
+    TypeId::DECIMAL,   TypeId::VARCHAR, TypeId::CHAR,      TypeId::TEXT,
+    TypeId::BLOB,      TypeId::DATE,    TypeId::TIME,      TypeId::TIMESTAMP,
+    TypeId::UUID,      TypeId::JSON,
+};
+
+/// @brief Row layouts modelled on common table shapes
+enum class RowShape : uint8_t {
+  NARROW = 0,  ///< Key plus a few fixed-width columns
+  ORDERS = 1,  ///< Mixed OLTP row (decimal, date, short strings)
+  WIDE = 2,    ///< 32 mixed columns
+  TEXTUAL = 3, ///< Dominated by long strings
+};
+
+constexpr std::string_view to_string(RowShape shape) noexcept {
+  switch (shape) {
+  case RowShape::NARROW:
+    return "narrow";
+  case RowShape::ORDERS:
+    return "orders";
+  case RowShape::WIDE:
+    return "wide";
+  case RowShape::TEXTUAL:
+    return "textual";
+  }
+
+  return "unknown";
+}
+
+std::string random_string(std::mt19937_64 &rng, size_t length) {
+  static constexpr std::string_view ALPHABET =
+      "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 ";
+  std::string result(length, ' ');
+  for (auto &c : result) {
+    c = ALPHABET[rng() % ALPHABET.size()];
+  }
+
+  return result;
+}
+
+/// @brief Random value of a type with realistic magnitude and length
+Value make_value(TypeId type, std::mt19937_64 &rng) {
+  switch (type) {
+  case TypeId::NULL_TYPE:
+    return nullptr;
+  case TypeId::BOOLEAN:
+    return static_cast<bool>(rng() & 1);
+  case TypeId::TINYINT:
+    return static_cast<int8_t>(rng());
+  case TypeId::SMALLINT:
+    return static_cast<int16_t>(rng());
+  case TypeId::INTEGER:
+    return static_cast<int32_t>(rng());
+  case TypeId::BIGINT:
+    return static_cast<int64_t>(rng());
+  case TypeId::REAL:
+    return static_cast<float>(rng() % 1000000) / 100.0f;
+  case TypeId::DOUBLE:
+    return static_cast<double>(rng() % 1000000000) / 1000.0;
+  case TypeId::DECIMAL:
+    return dtypes::Decimal(static_cast<int64_t>(rng() % 100000000), 12, 2);
+  case TypeId::VARCHAR:
+    return random_string(rng, 8 + rng() % 25);
+  case TypeId::CHAR:
+    return random_string(rng, 10);
+  case TypeId::TEXT:
+    return random_string(rng, 256 + rng() % 512);
+  case TypeId::BLOB: {
+    std::vector<uint8_t> blob(64 + rng() % 64);
+    for (auto &byte : blob) {
+      byte = static_cast<uint8_t>(rng());
+    }
+    return blob;
+  }
+  case TypeId::DATE:
+    return dtypes::Date(static_cast<int32_t>(rng() % 20000));
+  case TypeId::TIME:
+    return dtypes::Time(static_cast<int64_t>(rng() % 86400000000ULL));
+  case TypeId::TIMESTAMP:
+    return dtypes::Timestamp(
+        static_cast<int64_t>(rng() % 1700000000000000ULL));
+  case TypeId::UUID: {
+    std::array<uint8_t, 16> bytes;
+    for (auto &byte : bytes) {
+      byte = static_cast<uint8_t>(rng());
+    }
+    return dtypes::UUID(bytes);
+  }
+  case TypeId::JSON:
+    return fmt::format(R"({{"id":{},"name":"{}","tags":["{}","{}"]}})",
+                       rng() % 100000, random_string(rng, 12),
+                       random_string(rng, 6), random_string(rng, 6));
+  default:
+    return nullptr;
+  }
+}
+
+std::vector<Value> make_values(TypeId type, uint64_t seed = 42) {
+  std::mt19937_64 rng(seed);
+  std::vector<Value> values;
+  values.reserve(VALUE_POOL_SIZE);
+  for (size_t i = 0; i < VALUE_POOL_SIZE; ++i) {
+    values.push_back(make_value(type, rng));
+  }
+
+  return values;
+}
+
+dtypes::Row make_row(RowShape shape, std::mt19937_64 &rng) {
+  std::vector<Value> values;
+  auto add = [&](TypeId type) { values.push_back(make_value(type, rng)); };
+
+  switch (shape) {
+  case RowShape::NARROW:
+    for (auto type : {TypeId::BIGINT, TypeId::INTEGER, TypeId::DOUBLE,
+                      TypeId::BOOLEAN}) {
+      add(type);
+    }
+    break;
+  case RowShape::ORDERS:
+    for (auto type : {TypeId::BIGINT, TypeId::INTEGER, TypeId::CHAR,
+                      TypeId::DECIMAL, TypeId::DATE, TypeId::CHAR,
+                      TypeId::VARCHAR, TypeId::INTEGER, TypeId::VARCHAR}) {
+      add(type);
+    }
+    break;
+  case RowShape::WIDE:
+    for (size_t i = 0; i < 32; ++i) {
+      add(BENCH_TYPES[1 + i % (BENCH_TYPES.size() - 1)]);
+    }
+    break;
+  case RowShape::TEXTUAL:
+    for (auto type : {TypeId::BIGINT, TypeId::VARCHAR, TypeId::TEXT,
+                      TypeId::TEXT, TypeId::JSON, TypeId::TIMESTAMP}) {
+      add(type);
+    }
+    break;
+  }
+
+  return dtypes::Row(std::move(values));
+}
+
+std::vector<dtypes::Row> make_rows(RowShape shape, uint64_t seed = 42) {
+  std::mt19937_64 rng(seed);
+  std::vector<dtypes::Row> rows;
+  rows.reserve(VALUE_POOL_SIZE);
+  for (size_t i = 0; i < VALUE_POOL_SIZE; ++i) {
+    rows.push_back(make_row(shape, rng));
+  }
+
+  return rows;
+}
+
+TypeId type_arg(benchmark::State &state) {
+  const auto type = static_cast<TypeId>(state.range(0));
+  state.SetLabel(std::string(dtypes::to_string(type)));
+  return type;
+}
+
+RowShape shape_arg(benchmark::State &state) {
+  const auto shape = static_cast<RowShape>(state.range(0));
+  state.SetLabel(std::string(to_string(shape)));
+  return shape;
+}
+} // namespace
+
+/// Args: TypeId
+static void BM_SerializeValue(benchmark::State &state) {
+  const auto values = make_values(type_arg(state));
+  size_t bytes = 0;
+  size_t i = 0;
+
+  for (auto _ : state) {
+    auto encoded = dtypes::serialize_value(values[i++ & (VALUE_POOL_SIZE - 1)]);
+    bytes += encoded.size();
+    benchmark::DoNotOptimize(encoded.data());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+/// Args: TypeId
+static void BM_DeserializeValue(benchmark::State &state) {
+  const auto values = make_values(type_arg(state));
+  std::vector<std::vector<uint8_t>> encoded;
+  encoded.reserve(values.size());
+  for (const auto &value : values) {
+    encoded.push_back(dtypes::serialize_value(value));
+  }
+
+  size_t bytes = 0;
+  size_t i = 0;
+
+  for (auto _ : state) {
+    const auto &data = encoded[i++ & (VALUE_POOL_SIZE - 1)];
+    auto decoded = dtypes::deserialize_value(data);
+    if (!decoded) {
+      state.SkipWithError("deserialize_value failed");
+      break;
+    }
+
+    bytes += data.size();
+    benchmark::DoNotOptimize(decoded);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+/// Args: TypeId
+static void BM_CompareValues(benchmark::State &state) {
+  const auto type = type_arg(state);
+  const auto lhs = make_values(type, 1);
+  const auto rhs = make_values(type, 2);
+  size_t i = 0;
+
+  for (auto _ : state) {
+    const auto index = i++ & (VALUE_POOL_SIZE - 1);
+    benchmark::DoNotOptimize(dtypes::compare_values(lhs[index], rhs[index]));
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+/// Args: TypeId
+static void BM_HashValue(benchmark::State &state) {
+  const auto values = make_values(type_arg(state));
+  const dtypes::hash::ValueHasher hasher;
+  size_t i = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(hasher(values[i++ & (VALUE_POOL_SIZE - 1)]));
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+/// Args: RowShape
+static void BM_RowSerialize(benchmark::State &state) {
+  const auto rows = make_rows(shape_arg(state));
+  size_t bytes = 0;
+  size_t i = 0;
+
+  for (auto _ : state) {
+    auto encoded = rows[i++ & (VALUE_POOL_SIZE - 1)].serialize();
+    bytes += encoded.size();
+    benchmark::DoNotOptimize(encoded.data());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+/// Args: RowShape
+static void BM_RowDeserialize(benchmark::State &state) {
+  const auto rows = make_rows(shape_arg(state));
+  std::vector<std::vector<uint8_t>> encoded;
+  encoded.reserve(rows.size());
+  for (const auto &row : rows) {
+    encoded.push_back(row.serialize());
+  }
+
+  size_t bytes = 0;
+  size_t i = 0;
+
+  for (auto _ : state) {
+    const auto &data = encoded[i++ & (VALUE_POOL_SIZE - 1)];
+    auto row = dtypes::Row::deserialize(data);
+    if (!row) {
+      state.SkipWithError("Row::deserialize failed");
+      break;
+    }
+
+    bytes += data.size();
+    benchmark::DoNotOptimize(row);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+/// Args: RowShape
+static void BM_RowCompare(benchmark::State &state) {
+  const auto shape = shape_arg(state);
+  const auto lhs = make_rows(shape, 1);
+  auto rhs = lhs;
+
+  // Equal leading columns force comparison deeper into the row
+  std::mt19937_64 rng(2);
+  for (auto &row : rhs) {
+    const auto column = row.size() / 2 + rng() % (row.size() - row.size() / 2);
+    row[column] = make_value(dtypes::get_type_id(row[column]), rng);
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    const auto index = i++ & (VALUE_POOL_SIZE - 1);
+    benchmark::DoNotOptimize(lhs[index].compare(rhs[index]));
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+/// Args: RowShape
+static void BM_RowHash(benchmark::State &state) {
+  const auto rows = make_rows(shape_arg(state));
+  const dtypes::hash::RowHasher hasher;
+  size_t i = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(hasher(rows[i++ & (VALUE_POOL_SIZE - 1)]));
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+/// Args: number of key columns
+static void BM_CreateCompositeKey(benchmark::State &state) {
+  // Typical index key column types, in order
+  static constexpr std::array KEY_TYPES = {TypeId::BIGINT, TypeId::VARCHAR,
+                                           TypeId::DATE, TypeId::INTEGER};
+  const auto columns = static_cast<size_t>(state.range(0));
+
+  std::mt19937_64 rng(42);
+  std::vector<std::vector<Value>> keys(VALUE_POOL_SIZE);
+  for (auto &key : keys) {
+    for (size_t c = 0; c < columns; ++c) {
+      key.push_back(make_value(KEY_TYPES[c % KEY_TYPES.size()], rng));
+    }
+  }
+
+  size_t bytes = 0;
+  size_t i = 0;
+
+  for (auto _ : state) {
+    auto encoded =
+        dtypes::key::create_composite_key(keys[i++ & (VALUE_POOL_SIZE - 1)]);
+    bytes += encoded.size();
+    benchmark::DoNotOptimize(encoded.data());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+static void BM_DateFromString(benchmark::State &state) {
+  std::mt19937_64 rng(42);
+  std::vector<std::string> inputs;
+  inputs.reserve(VALUE_POOL_SIZE);
+  for (size_t i = 0; i < VALUE_POOL_SIZE; ++i) {
+    inputs.push_back(fmt::format("{:04}-{:02}-{:02}", 1970 + rng() % 60,
+                                 1 + rng() % 12, 1 + rng() % 28));
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    auto date = dtypes::Date::from_string(inputs[i++ & (VALUE_POOL_SIZE - 1)]);
+    benchmark::DoNotOptimize(date);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+static void BM_TimeFromString(benchmark::State &state) {
+  std::mt19937_64 rng(42);
+  std::vector<std::string> inputs;
+  inputs.reserve(VALUE_POOL_SIZE);
+  for (size_t i = 0; i < VALUE_POOL_SIZE; ++i) {
+    inputs.push_back(fmt::format("{:02}:{:02}:{:02}.{:06}", rng() % 24,
+                                 rng() % 60, rng() % 60, rng() % 1000000));
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    auto time = dtypes::Time::from_string(inputs[i++ & (VALUE_POOL_SIZE - 1)]);
+    benchmark::DoNotOptimize(time);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+static void BM_TimestampFromString(benchmark::State &state) {
+  std::mt19937_64 rng(42);
+  std::vector<std::string> inputs;
+  inputs.reserve(VALUE_POOL_SIZE);
+  for (size_t i = 0; i < VALUE_POOL_SIZE; ++i) {
+    inputs.push_back(fmt::format("{:04}-{:02}-{:02} {:02}:{:02}:{:02}.{:06}",
+                                 1970 + rng() % 60, 1 + rng() % 12,
+                                 1 + rng() % 28, rng() % 24, rng() % 60,
+                                 rng() % 60, rng() % 1000000));
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    auto timestamp =
+        dtypes::Timestamp::from_string(inputs[i++ & (VALUE_POOL_SIZE - 1)]);
+    benchmark::DoNotOptimize(timestamp);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+namespace {
+void type_args(benchmark::internal::Benchmark *b) {
+  b->ArgName("type");
+  for (auto type : BENCH_TYPES) {
+    b->Arg(static_cast<int64_t>(type));
+  }
+}
+
+void shape_args(benchmark::internal::Benchmark *b) {
+  b->ArgName("shape")->DenseRange(static_cast<int64_t>(RowShape::NARROW),
+                                  static_cast<int64_t>(RowShape::TEXTUAL));
+}
+} // namespace
+
+BENCHMARK(BM_SerializeValue)->Apply(type_args);
+BENCHMARK(BM_DeserializeValue)->Apply(type_args);
+BENCHMARK(BM_CompareValues)->Apply(type_args);
+BENCHMARK(BM_HashValue)->Apply(type_args);
+BENCHMARK(BM_RowSerialize)->Apply(shape_args);
+BENCHMARK(BM_RowDeserialize)->Apply(shape_args);
+BENCHMARK(BM_RowCompare)->Apply(shape_args);
+BENCHMARK(BM_RowHash)->Apply(shape_args);
+BENCHMARK(BM_CreateCompositeKey)->ArgName("columns")->DenseRange(1, 4);
+BENCHMARK(BM_DateFromString);
+BENCHMARK(BM_TimeFromString);
+BENCHMARK(BM_TimestampFromString);
+
+} // namespace velox::bench
+
+BENCHMARK_MAIN();
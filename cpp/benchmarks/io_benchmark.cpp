@@ -0,0 +1,532 @@
+/**
+ * @file io_benchmark.cpp
+ * @author Carlos Salguero
+ * @brief fio-like page I/O benchmark comparing file access backends
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Runs page-sized reads and writes at a given queue depth against one
+ * preallocated file, through each backend:
+ *
+ *   buffered  pread/pwrite through the page cache
+ *   direct    pread/pwrite with O_DIRECT
+ *   mmap      memcpy to/from a shared mapping
+ *   io_uring  O_DIRECT reads/writes via liburing (if built with it)
+ *
+ * Synchronous backends reach the queue depth with one thread per
+ * outstanding I/O (like fio's psync with numjobs). io_uring keeps that many
+ * requests in flight from a single thread. Reports IOPS, bandwidth and
+ * latency percentiles per (pattern, backend).
+ *
+ * Usage: velox_iobench [--file=PATH] [--size-mb=1024] [--block-size=4096]
+ *                      [--queue-depth=1] [--duration=5]
+ *                      [--pattern=all|randread|randwrite|seqread|seqwrite]
+ *                      [--backend=all|buffered|direct|mmap|io_uring]
+ */
+
+#include "bench_common.hpp"
+
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <velox/metrics/metrics.hpp>
+
+#if defined(VELOX_HAVE_LIBURING)
+#include <liburing.h>
+#endif
+
+namespace velox::bench {
+namespace {
+/// @brief Alignment required by O_DIRECT on common devices
+constexpr size_t DIRECT_IO_ALIGNMENT = 4096;
+
+enum class IoPattern : uint8_t {
+  RANDOM_READ = 0,
+  RANDOM_WRITE = 1,
+  SEQUENTIAL_READ = 2,
+  SEQUENTIAL_WRITE = 3
+};
+
+enum class IoBackend : uint8_t {
+  BUFFERED = 0,
+  DIRECT = 1,
+  MMAP = 2,
+  IO_URING = 3
+};
+
+constexpr std::array ALL_PATTERNS = {
+    IoPattern::RANDOM_READ, IoPattern::RANDOM_WRITE,
+    IoPattern::SEQUENTIAL_READ, IoPattern::SEQUENTIAL_WRITE};
+
+constexpr std::array ALL_BACKENDS = {IoBackend::BUFFERED, IoBackend::DIRECT,
+                                     IoBackend::MMAP, IoBackend::IO_URING};
+
+constexpr std::string_view to_string(IoPattern pattern) noexcept {
+  switch (pattern) {
+  case IoPattern::RANDOM_READ:
+    return "randread";
+  case IoPattern::RANDOM_WRITE:
+    return "randwrite";
+  case IoPattern::SEQUENTIAL_READ:
+    return "seqread";
+  case IoPattern::SEQUENTIAL_WRITE:
+    return "seqwrite";
+  }
+
+  return "unknown";
+}
+
+constexpr std::string_view to_string(IoBackend backend) noexcept {
+  switch (backend) {
+  case IoBackend::BUFFERED:
+    return "buffered";
+  case IoBackend::DIRECT:
+    return "direct";
+  case IoBackend::MMAP:
+    return "mmap";
+  case IoBackend::IO_URING:
+    return "io_uring";
+  }
+
+  return "unknown";
+}
+
+constexpr bool is_write(IoPattern pattern) noexcept {
+  return pattern == IoPattern::RANDOM_WRITE ||
+         pattern == IoPattern::SEQUENTIAL_WRITE;
+}
+
+constexpr bool is_random(IoPattern pattern) noexcept {
+  return pattern == IoPattern::RANDOM_READ ||
+         pattern == IoPattern::RANDOM_WRITE;
+}
+
+/// @brief Command-line options
+struct IoOptions {
+  std::filesystem::path file;
+  uint64_t size_mb{1024};
+  size_t block_size{storage::config::PAGE_SIZE};
+  size_t queue_depth{1};
+  std::chrono::seconds duration{5};
+  std::vector<IoPattern> patterns{ALL_PATTERNS.begin(), ALL_PATTERNS.end()};
+  std::vector<IoBackend> backends{ALL_BACKENDS.begin(), ALL_BACKENDS.end()};
+
+  [[nodiscard]] uint64_t blocks() const noexcept {
+    return size_mb * 1024 * 1024 / block_size;
+  }
+};
+
+template <typename T> bool parse_number(std::string_view text, T &out) {
+  const auto *end = text.data() + text.size();
+  auto [ptr, ec] = std::from_chars(text.data(), end, out);
+  return ec == std::errc{} && ptr == end;
+}
+
+template <typename Enum, size_t N>
+bool parse_choice(std::string_view value, const std::array<Enum, N> &all,
+                  std::vector<Enum> &out) {
+  if (value == "all") {
+    out.assign(all.begin(), all.end());
+    return true;
+  }
+
+  for (auto choice : all) {
+    if (to_string(choice) == value) {
+      out = {choice};
+      return true;
+    }
+  }
+
+  return false;
+}
+
+std::optional<IoOptions> parse_options(int argc, char **argv) {
+  IoOptions options;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    const auto eq = arg.find('=');
+    const auto key = arg.substr(0, eq);
+    const auto value =
+        eq == std::string_view::npos ? std::string_view{} : arg.substr(eq + 1);
+
+    uint64_t number = 0;
+    bool ok = true;
+
+    if (key == "--file") {
+      options.file = std::string(value);
+      ok = !value.empty();
+    } else if (key == "--pattern") {
+      ok = parse_choice(value, ALL_PATTERNS, options.patterns);
+    } else if (key == "--backend") {
+      ok = parse_choice(value, ALL_BACKENDS, options.backends);
+    } else if (parse_number(value, number) && number > 0) {
+      if (key == "--size-mb") {
+        options.size_mb = number;
+      } else if (key == "--block-size" && number % DIRECT_IO_ALIGNMENT == 0) {
+        options.block_size = number;
+      } else if (key == "--queue-depth") {
+        options.queue_depth = number;
+      } else if (key == "--duration") {
+        options.duration = std::chrono::seconds(number);
+      } else {
+        ok = false;
+      }
+    } else {
+      ok = false;
+    }
+
+    if (!ok) {
+      std::cerr
+          << "invalid argument: " << arg << "\n"
+          << "usage: velox_iobench [--file=PATH] [--size-mb=N] "
+             "[--block-size=BYTES]\n"
+             "                     [--queue-depth=N] [--duration=SECONDS]\n"
+             "                     [--pattern=all|randread|randwrite|"
+             "seqread|seqwrite]\n"
+             "                     [--backend=all|buffered|direct|mmap|"
+             "io_uring]\n";
+      return std::nullopt;
+    }
+  }
+
+  return options;
+}
+
+/// @brief File descriptor closed on destruction
+class FileHandle {
+public:
+  FileHandle(const std::filesystem::path &path, int flags)
+      : m_fd(::open(path.c_str(), flags, 0644)) {}
+  ~FileHandle() {
+    if (m_fd >= 0) {
+      ::close(m_fd);
+    }
+  }
+
+  FileHandle(const FileHandle &) = delete;
+  FileHandle &operator=(const FileHandle &) = delete;
+
+  [[nodiscard]] int get() const noexcept { return m_fd; }
+  [[nodiscard]] bool is_open() const noexcept { return m_fd >= 0; }
+
+private:
+  int m_fd;
+};
+
+/// @brief Read-write shared mapping of a file
+class FileMapping {
+public:
+  FileMapping(int fd, size_t size)
+      : m_size(size), m_data(::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                                    MAP_SHARED, fd, 0)) {}
+  ~FileMapping() {
+    if (m_data != MAP_FAILED) {
+      ::munmap(m_data, m_size);
+    }
+  }
+
+  FileMapping(const FileMapping &) = delete;
+  FileMapping &operator=(const FileMapping &) = delete;
+
+  [[nodiscard]] bool is_valid() const noexcept { return m_data != MAP_FAILED; }
+  [[nodiscard]] uint8_t *data() const noexcept {
+    return static_cast<uint8_t *>(m_data);
+  }
+
+private:
+  size_t m_size;
+  void *m_data;
+};
+
+/// @brief Create the test file filled with non-zero data
+bool prepare_file(const IoOptions &options) {
+  FileHandle file(options.file, O_CREAT | O_WRONLY | O_TRUNC);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  const auto chunk = make_payload(1024 * 1024);
+  for (uint64_t mb = 0; mb < options.size_mb; ++mb) {
+    if (::write(file.get(), chunk.data(), chunk.size()) !=
+        static_cast<ssize_t>(chunk.size())) {
+      return false;
+    }
+  }
+
+  return ::fsync(file.get()) == 0;
+}
+
+/// @brief Chooses block offsets for a pattern
+class OffsetGenerator {
+public:
+  OffsetGenerator(const IoOptions &options, IoPattern pattern,
+                  std::atomic<uint64_t> &cursor, uint64_t seed)
+      : m_blocks(options.blocks()), m_block_size(options.block_size),
+        m_random(is_random(pattern)), m_cursor(cursor), m_rng(seed) {}
+
+  [[nodiscard]] uint64_t next() {
+    const auto block =
+        m_random ? m_rng() % m_blocks
+                 : m_cursor.fetch_add(1, std::memory_order_relaxed) % m_blocks;
+    return block * m_block_size;
+  }
+
+private:
+  uint64_t m_blocks;
+  size_t m_block_size;
+  bool m_random;
+  std::atomic<uint64_t> &m_cursor;
+  std::mt19937_64 m_rng;
+};
+
+/// @brief Outcome of one (pattern, backend) run
+struct IoResult {
+  uint64_t operations{0};
+  uint64_t errors{0};
+  double seconds{0.0};
+  metrics::HistogramSnapshot latency;
+};
+
+/// @brief Synchronous backends: one thread per outstanding I/O
+IoResult run_sync(const IoOptions &options, IoPattern pattern,
+                  IoBackend backend) {
+  IoResult result;
+  const int flags = O_RDWR | (backend == IoBackend::DIRECT ? O_DIRECT : 0);
+  FileHandle file(options.file, flags);
+  if (!file.is_open()) {
+    result.errors = 1;
+    return result;
+  }
+
+  std::unique_ptr<FileMapping> mapping;
+  if (backend == IoBackend::MMAP) {
+    mapping = std::make_unique<FileMapping>(file.get(),
+                                            options.blocks() *
+                                                options.block_size);
+    if (!mapping->is_valid()) {
+      result.errors = 1;
+      return result;
+    }
+  } else if (backend == IoBackend::BUFFERED) {
+    // Best effort: start reads from a cold page cache
+    ::posix_fadvise(file.get(), 0, 0, POSIX_FADV_DONTNEED);
+  }
+
+  metrics::LatencyHistogram latency;
+  std::atomic<uint64_t> cursor{0};
+  std::atomic<uint64_t> operations{0};
+  std::atomic<uint64_t> errors{0};
+  std::atomic<bool> stop{false};
+  const bool write = is_write(pattern);
+
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < options.queue_depth; ++t) {
+    workers.emplace_back([&, t] {
+      auto buffer = memory::make_aligned_array<uint8_t>(options.block_size,
+                                                        DIRECT_IO_ALIGNMENT);
+      std::memset(buffer.get(), static_cast<int>(t + 1), options.block_size);
+      OffsetGenerator offsets(options, pattern, cursor, t + 1);
+      const auto bytes = static_cast<ssize_t>(options.block_size);
+      uint64_t local_ops = 0;
+      uint64_t local_errors = 0;
+
+      while (!stop.load(std::memory_order_relaxed)) {
+        const auto offset = offsets.next();
+        const auto start = Clock::now();
+
+        bool ok = true;
+        if (mapping) {
+          auto *page = mapping->data() + offset;
+          write ? std::memcpy(page, buffer.get(), options.block_size)
+                : std::memcpy(buffer.get(), page, options.block_size);
+        } else {
+          const auto off = static_cast<off_t>(offset);
+          ok = (write ? ::pwrite(file.get(), buffer.get(), options.block_size,
+                                 off)
+                      : ::pread(file.get(), buffer.get(), options.block_size,
+                                off)) == bytes;
+        }
+
+        latency.record(Clock::now() - start);
+        ++local_ops;
+        local_errors += ok ? 0 : 1;
+      }
+
+      operations.fetch_add(local_ops, std::memory_order_relaxed);
+      errors.fetch_add(local_errors, std::memory_order_relaxed);
+    });
+  }
+
+  const auto start = Clock::now();
+  std::this_thread::sleep_for(options.duration);
+  stop.store(true, std::memory_order_relaxed);
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  result.operations = operations.load();
+  result.errors = errors.load();
+  result.latency = latency.snapshot();
+  return result;
+}
+
+#if defined(VELOX_HAVE_LIBURING)
+/// @brief io_uring backend: queue_depth requests in flight from one thread
+IoResult run_io_uring(const IoOptions &options, IoPattern pattern) {
+  IoResult result;
+  FileHandle file(options.file, O_RDWR | O_DIRECT);
+  io_uring ring;
+  if (!file.is_open() ||
+      io_uring_queue_init(static_cast<unsigned>(options.queue_depth), &ring,
+                          0) < 0) {
+    result.errors = 1;
+    return result;
+  }
+
+  struct Request {
+    memory::aligned_unique_ptr<uint8_t[]> buffer;
+    TimePoint submitted;
+  };
+
+  std::vector<Request> requests(options.queue_depth);
+  for (auto &request : requests) {
+    request.buffer = memory::make_aligned_array<uint8_t>(options.block_size,
+                                                         DIRECT_IO_ALIGNMENT);
+    std::memset(request.buffer.get(), 0x5a, options.block_size);
+  }
+
+  metrics::LatencyHistogram latency;
+  std::atomic<uint64_t> cursor{0};
+  OffsetGenerator offsets(options, pattern, cursor, 1);
+  const bool write = is_write(pattern);
+
+  const auto submit = [&](Request &request) {
+    auto *sqe = io_uring_get_sqe(&ring);
+    const auto offset = offsets.next();
+    if (write) {
+      io_uring_prep_write(sqe, file.get(), request.buffer.get(),
+                          static_cast<unsigned>(options.block_size), offset);
+    } else {
+      io_uring_prep_read(sqe, file.get(), request.buffer.get(),
+                         static_cast<unsigned>(options.block_size), offset);
+    }
+    io_uring_sqe_set_data(sqe, &request);
+    request.submitted = Clock::now();
+  };
+
+  for (auto &request : requests) {
+    submit(request);
+  }
+  io_uring_submit(&ring);
+
+  const auto start = Clock::now();
+  const auto deadline = start + options.duration;
+  size_t in_flight = requests.size();
+
+  while (in_flight > 0) {
+    io_uring_cqe *cqe = nullptr;
+    if (io_uring_wait_cqe(&ring, &cqe) < 0) {
+      ++result.errors;
+      break;
+    }
+
+    auto *request = static_cast<Request *>(io_uring_cqe_get_data(cqe));
+    latency.record(Clock::now() - request->submitted);
+    ++result.operations;
+    result.errors +=
+        cqe->res == static_cast<int>(options.block_size) ? 0 : 1;
+    io_uring_cqe_seen(&ring, cqe);
+
+    if (Clock::now() < deadline) {
+      submit(*request);
+      io_uring_submit(&ring);
+    } else {
+      --in_flight;
+    }
+  }
+
+  result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  result.latency = latency.snapshot();
+  io_uring_queue_exit(&ring);
+  return result;
+}
+#endif
+
+void print_result(IoPattern pattern, IoBackend backend, const IoOptions &opts,
+                  const IoResult &result) {
+  const double iops = static_cast<double>(result.operations) / result.seconds;
+  const auto micros = [&](double q) {
+    return static_cast<double>(result.latency.percentile(q)) / 1000.0;
+  };
+
+  fmt::print("{:<10} {:<9} {:>12.0f} {:>10.1f} {:>9.1f} {:>9.1f} {:>9.1f} "
+             "{:>9.1f} {:>10.1f}",
+             to_string(pattern), to_string(backend), iops,
+             iops * static_cast<double>(opts.block_size) / (1024.0 * 1024.0),
+             result.latency.mean() / 1000.0, micros(0.50), micros(0.99),
+             micros(0.999), static_cast<double>(result.latency.max) / 1000.0);
+  if (result.errors > 0) {
+    fmt::print("  ({} errors)", result.errors);
+  }
+  fmt::print("\n");
+}
+
+int run(IoOptions options) {
+  std::optional<TempDirectory> scratch;
+  if (options.file.empty()) {
+    scratch.emplace("velox_iobench");
+    options.file = scratch->path() / "iobench.dat";
+  }
+
+  if (!prepare_file(options)) {
+    std::cerr << "failed to prepare " << options.file << "\n";
+    return 1;
+  }
+
+  fmt::print("VeloxDB I/O benchmark: {} ({} MiB), {} B blocks, queue depth "
+             "{}, {} s per run\n",
+             options.file.string(), options.size_mb, options.block_size,
+             options.queue_depth, options.duration.count());
+  fmt::print("{:<10} {:<9} {:>12} {:>10} {:>9} {:>9} {:>9} {:>9} {:>10}\n",
+             "pattern", "backend", "iops", "MiB/s", "mean_us", "p50_us",
+             "p99_us", "p999_us", "max_us");
+
+  for (auto pattern : options.patterns) {
+    for (auto backend : options.backends) {
+      if (backend == IoBackend::IO_URING) {
+#if defined(VELOX_HAVE_LIBURING)
+        print_result(pattern, backend, options,
+                     run_io_uring(options, pattern));
+#else
+        fmt::print("{:<10} {:<9} (not built with liburing)\n",
+                   to_string(pattern), to_string(backend));
+#endif
+        continue;
+      }
+
+      print_result(pattern, backend, options,
+                   run_sync(options, pattern, backend));
+    }
+  }
+
+  return 0;
+}
+} // namespace
+} // namespace velox::bench
+
+int main(int argc, char **argv) {
+  auto options = velox::bench::parse_options(argc, argv);
+  if (!options) {
+    return 1;
+  }
+
+  return velox::bench::run(std::move(*options));
+}
@@ -0,0 +1,222 @@
+/**
+ * @file key_generators.hpp
+ * @author Carlos Salguero
+ * @brief Key distributions for workload drivers (YCSB conventions)
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string_view>
+
+namespace velox::bench {
+/// @brief Request key distributions
+enum class KeyDistribution : uint8_t {
+  UNIFORM = 0,   ///< Every key equally likely
+  ZIPFIAN = 1,   ///< Scrambled Zipfian: popular keys spread over the keys
+  LATEST = 2,    ///< Zipfian skewed towards the most recently inserted keys
+  HOTSPOT = 3,   ///< Fixed fraction of operations hit a fixed key fraction
+  SINGLE_KEY = 4 ///< Every operation hits the same key (worst contention)
+};
+
+/// @brief Convert KeyDistribution to string
+[[nodiscard]] constexpr std::string_view
+to_string(KeyDistribution distribution) noexcept {
+  switch (distribution) {
+  case KeyDistribution::UNIFORM:
+    return "uniform";
+  case KeyDistribution::ZIPFIAN:
+    return "zipfian";
+  case KeyDistribution::LATEST:
+    return "latest";
+  case KeyDistribution::HOTSPOT:
+    return "hotspot";
+  case KeyDistribution::SINGLE_KEY:
+    return "single";
+  }
+
+  return "unknown";
+}
+
+/**
+ * @brief Parse a KeyDistribution name
+ *
+ * @param name Distribution name as produced by to_string
+ * @return Distribution, or nullopt if unknown
+ */
+[[nodiscard]] inline std::optional<KeyDistribution>
+parse_key_distribution(std::string_view name) noexcept {
+  for (auto distribution :
+       {KeyDistribution::UNIFORM, KeyDistribution::ZIPFIAN,
+        KeyDistribution::LATEST, KeyDistribution::HOTSPOT,
+        KeyDistribution::SINGLE_KEY}) {
+    if (to_string(distribution) == name) {
+      return distribution;
+    }
+  }
+
+  return std::nullopt;
+}
+
+/// @brief 64-bit FNV-1a over the bytes of an integer
+[[nodiscard]] constexpr uint64_t fnv_hash64(uint64_t value) noexcept {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (int i = 0; i < 8; ++i) {
+    hash ^= value & 0xff;
+    hash *= 0x100000001b3ULL;
+    value >>= 8;
+  }
+
+  return hash;
+}
+
+/**
+ * @brief Zipfian generator over [0, items) (Gray et al., "Quickly
+ *        Generating Billion-Record Synthetic Databases")
+ *
+ * @note Immutable after construction; callers supply the random engine,
+ *       so one instance can be shared by all threads.
+ */
+class ZipfianGenerator {
+public:
+  /// @brief YCSB's default skew
+  static constexpr double DEFAULT_THETA = 0.99;
+
+  /**
+   * @brief Precompute the distribution constants
+   *
+   * @param items Number of items (must be > 0)
+   * @param theta Skew parameter in (0, 1)
+   */
+  explicit ZipfianGenerator(uint64_t items, double theta = DEFAULT_THETA)
+      : m_items(items), m_theta(theta), m_zeta_n(zeta(items, theta)),
+        m_alpha(1.0 / (1.0 - theta)) {
+    const double zeta_2 = zeta(2, theta);
+    m_eta = (1.0 - std::pow(2.0 / static_cast<double>(items), 1.0 - theta)) /
+            (1.0 - zeta_2 / m_zeta_n);
+  }
+
+  /**
+   * @brief Draw a rank; 0 is the most popular item
+   *
+   * @param rng Random engine
+   * @return Rank in [0, items)
+   */
+  template <typename Engine>
+  [[nodiscard]] uint64_t next(Engine &rng) const noexcept {
+    const double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    const double uz = u * m_zeta_n;
+
+    if (uz < 1.0) {
+      return 0;
+    }
+
+    if (uz < 1.0 + std::pow(0.5, m_theta)) {
+      return 1;
+    }
+
+    const auto rank = static_cast<uint64_t>(
+        static_cast<double>(m_items) *
+        std::pow(m_eta * u - m_eta + 1.0, m_alpha));
+    return std::min(rank, m_items - 1);
+  }
+
+  /// @brief Get the number of items
+  [[nodiscard]] uint64_t items() const noexcept { return m_items; }
+
+private:
+  static double zeta(uint64_t n, double theta) noexcept {
+    double sum = 0.0;
+    for (uint64_t i = 1; i <= n; ++i) {
+      sum += 1.0 / std::pow(static_cast<double>(i), theta);
+    }
+
+    return sum;
+  }
+
+  uint64_t m_items;
+  double m_theta;
+  double m_zeta_n;
+  double m_alpha;
+  double m_eta{0.0};
+};
+
+/**
+ * @brief Chooses existing keys according to a KeyDistribution
+ *
+ * @note Keys are dense integers in [0, key_count). The key count may grow
+ *       as inserts are acknowledged; the Zipfian constants are computed
+ *       once for the initial count and ranks are folded into the current
+ *       range, which is what YCSB does for its scrambled generator.
+ */
+class KeyChooser {
+public:
+  /// @brief Fraction of keys forming the hot set
+  static constexpr double HOTSPOT_DATA_FRACTION = 0.2;
+
+  /// @brief Fraction of operations directed at the hot set
+  static constexpr double HOTSPOT_OPERATION_FRACTION = 0.8;
+
+  /**
+   * @brief Create a chooser
+   *
+   * @param distribution Key distribution
+   * @param initial_keys Number of keys loaded before the run (must be > 0)
+   */
+  KeyChooser(KeyDistribution distribution, uint64_t initial_keys)
+      : m_distribution(distribution), m_zipfian(initial_keys) {}
+
+  /**
+   * @brief Choose a key
+   *
+   * @param rng Random engine
+   * @param key_count Keys currently available (>= 1)
+   * @return Key in [0, key_count)
+   */
+  template <typename Engine>
+  [[nodiscard]] uint64_t next(Engine &rng, uint64_t key_count) const noexcept {
+    switch (m_distribution) {
+    case KeyDistribution::UNIFORM:
+      return rng() % key_count;
+    case KeyDistribution::ZIPFIAN:
+      return fnv_hash64(m_zipfian.next(rng)) % key_count;
+    case KeyDistribution::LATEST:
+      return key_count - 1 - std::min(m_zipfian.next(rng), key_count - 1);
+    case KeyDistribution::HOTSPOT: {
+      const auto hot_keys = std::max<uint64_t>(
+          1, static_cast<uint64_t>(static_cast<double>(key_count) *
+                                   HOTSPOT_DATA_FRACTION));
+      const double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+      if (u < HOTSPOT_OPERATION_FRACTION || hot_keys == key_count) {
+        return rng() % hot_keys;
+      }
+      return hot_keys + rng() % (key_count - hot_keys);
+    }
+    case KeyDistribution::SINGLE_KEY:
+      return 0;
+    }
+
+    return 0;
+  }
+
+  /// @brief Get the distribution
+  [[nodiscard]] KeyDistribution distribution() const noexcept {
+    return m_distribution;
+  }
+
+private:
+  KeyDistribution m_distribution;
+  ZipfianGenerator m_zipfian;
+};
+
+} // namespace velox::bench
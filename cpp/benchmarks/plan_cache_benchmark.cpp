@@ -0,0 +1,136 @@
+/**
+ * @file plan_cache_benchmark.cpp
+ * @author Carlos Salguero
+ * @brief Benchmarks for planning a join with and without the PlanCache
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "bench_common.hpp"
+
+#include <velox/query/plan_cache.hpp>
+#include <velox/query/statistics.hpp>
+
+namespace velox::bench {
+namespace {
+using dtypes::TypeId;
+
+/// @brief Rows per relation; planning cost does not depend on it
+constexpr size_t ROWS = 4 * query::config::VECTOR_SIZE;
+
+/**
+ * @brief n-way join over analyzed tables with one predicate per relation
+ *
+ * @note Relation i joins i + 1, and even i also joins i + 2, so the graph
+ *       has cycles and DPccp has many connected subgraphs to enumerate.
+ */
+query::JoinQuery make_query(size_t relations) {
+  const query::Schema schema{{"id", TypeId::BIGINT},
+                             {"next", TypeId::BIGINT},
+                             {"skip", TypeId::BIGINT},
+                             {"value", TypeId::INTEGER}};
+  std::mt19937_64 rng(113);
+  query::JoinQuery query;
+  for (size_t r = 0; r < relations; ++r) {
+    auto table = std::make_shared<query::ColumnarTable>(schema);
+    const size_t rows = ROWS >> (rng() % 4);
+    for (size_t i = 0; i < rows; ++i) {
+      (void)table->append_row(dtypes::Row(
+          {static_cast<int64_t>(i), static_cast<int64_t>(rng() % rows),
+           static_cast<int64_t>(rng() % (rows / 4)),
+           static_cast<int32_t>(rng() % 1000)}));
+    }
+    query.relations.push_back({fmt::format("t{}", r),
+                               table,
+                               {{3, query::CompareOp::LT, int32_t{500}}},
+                               {},
+                               query::analyze(*table)});
+  }
+  for (size_t r = 0; r + 1 < relations; ++r) {
+    query.joins.push_back({r, 1, r + 1, 0});
+    if (r % 2 == 0 && r + 2 < relations) {
+      query.joins.push_back({r, 2, r + 2, 0});
+    }
+  }
+  query.output = {{0, 0}, {relations - 1, 3}};
+
+  return query;
+}
+} // namespace
+
+/// Args: relations. Full optimization: join enumeration plus plan build
+static void BM_Optimize(benchmark::State &state) {
+  const auto query = make_query(static_cast<size_t>(state.range(0)));
+  const query::QueryOptimizer optimizer;
+  PerfReport perf(state);
+
+  for (auto _ : state) {
+    auto plan = optimizer.optimize(query);
+    benchmark::DoNotOptimize(plan);
+  }
+}
+
+/// Args: relations. Cache hit: fingerprint, lookup, plan build
+static void BM_PlanCacheHit(benchmark::State &state) {
+  auto query = make_query(static_cast<size_t>(state.range(0)));
+  query::PlanCache cache;
+  (void)cache.plan(query);
+
+  int32_t literal = 0;
+  PerfReport perf(state);
+
+  for (auto _ : state) {
+    query.relations[0].predicates[0].constant = literal++ % 1000;
+    auto plan = cache.plan(query);
+    benchmark::DoNotOptimize(plan);
+  }
+  state.counters["hit_rate"] = benchmark::Counter(
+      static_cast<double>(cache.statistics().hits) /
+      static_cast<double>(cache.statistics().hits +
+                          cache.statistics().misses));
+}
+
+/// Args: relations. Prepared statement: bind, lookup, plan build
+static void BM_PreparedBind(benchmark::State &state) {
+  auto query = make_query(static_cast<size_t>(state.range(0)));
+  query::PreparedStatement statement(std::make_shared<query::PlanCache>(),
+                                     std::move(query));
+  std::vector<dtypes::Value> parameters(statement.parameter_count(),
+                                        int32_t{500});
+  (void)statement.bind(parameters);
+
+  int32_t literal = 0;
+  PerfReport perf(state);
+
+  for (auto _ : state) {
+    parameters[0] = literal++ % 1000;
+    auto plan = statement.bind(parameters);
+    benchmark::DoNotOptimize(plan);
+  }
+}
+
+BENCHMARK(BM_Optimize)
+    ->ArgName("relations")
+    ->Arg(4)
+    ->Arg(7)
+    ->Arg(10)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PlanCacheHit)
+    ->ArgName("relations")
+    ->Arg(4)
+    ->Arg(7)
+    ->Arg(10)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PreparedBind)
+    ->ArgName("relations")
+    ->Arg(4)
+    ->Arg(7)
+    ->Arg(10)
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace velox::bench
+
+BENCHMARK_MAIN();
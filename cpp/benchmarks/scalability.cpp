@@ -0,0 +1,339 @@
+/**
+ * @file scalability.cpp
+ * @author Carlos Salguero
+ * @brief Thread-scalability sweep for StorageEngine point operations
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * For each operation (read, write, mixed) and access pattern (uniform,
+ * zipfian, single hot key) the driver runs 1, 2, 4, ... up to
+ * --max-threads threads for --duration seconds each. It reports total
+ * throughput, speedup over one thread, parallel efficiency and the spread
+ * of per-thread throughput. With --latch-profile, page latch contention
+ * is reported for each point, showing where scaling stops.
+ *
+ * Usage: velox_scalability [--max-threads=N] [--duration=3]
+ *                          [--records=100000] [--record-size=256]
+ *                          [--pool-pages=N] [--no-wal] [--latch-profile]
+ *                          [--csv=PATH]
+ */
+
+#include "bench_common.hpp"
+#include "key_generators.hpp"
+
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <velox/metrics/latch.hpp>
+#include <velox/metrics/metrics.hpp>
+
+namespace velox::bench {
+namespace {
+/// @brief Operation mixes swept by the driver
+enum class OperationMix : uint8_t { READ = 0, WRITE = 1, MIXED = 2 };
+
+constexpr std::array OPERATION_MIXES = {OperationMix::READ, OperationMix::WRITE,
+                                        OperationMix::MIXED};
+
+constexpr std::array ACCESS_PATTERNS = {KeyDistribution::UNIFORM,
+                                        KeyDistribution::ZIPFIAN,
+                                        KeyDistribution::SINGLE_KEY};
+
+/// @brief Read fraction of the mixed workload
+constexpr double MIXED_READ_FRACTION = 0.9;
+
+constexpr std::string_view to_string(OperationMix mix) noexcept {
+  switch (mix) {
+  case OperationMix::READ:
+    return "read";
+  case OperationMix::WRITE:
+    return "write";
+  case OperationMix::MIXED:
+    return "mixed";
+  }
+
+  return "unknown";
+}
+
+/// @brief Command-line options
+struct SweepOptions {
+  size_t max_threads{std::max<size_t>(1, std::thread::hardware_concurrency())};
+  std::chrono::seconds duration{3};
+  uint64_t records{100000};
+  size_t record_size{256};
+  size_t pool_pages{storage::config::DEFAULT_BUFFER_POOL_SIZE};
+  bool enable_wal{true};
+  bool latch_profile{false};
+  std::string csv_path;
+};
+
+template <typename T> bool parse_number(std::string_view text, T &out) {
+  const auto *end = text.data() + text.size();
+  auto [ptr, ec] = std::from_chars(text.data(), end, out);
+  return ec == std::errc{} && ptr == end;
+}
+
+std::optional<SweepOptions> parse_options(int argc, char **argv) {
+  SweepOptions options;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    const auto eq = arg.find('=');
+    const auto key = arg.substr(0, eq);
+    const auto value =
+        eq == std::string_view::npos ? std::string_view{} : arg.substr(eq + 1);
+
+    uint64_t number = 0;
+    bool ok = true;
+
+    if (key == "--no-wal") {
+      options.enable_wal = false;
+    } else if (key == "--latch-profile") {
+      options.latch_profile = true;
+    } else if (key == "--csv") {
+      options.csv_path = std::string(value);
+      ok = !value.empty();
+    } else if (parse_number(value, number) && number > 0) {
+      if (key == "--max-threads") {
+        options.max_threads = number;
+      } else if (key == "--duration") {
+        options.duration = std::chrono::seconds(number);
+      } else if (key == "--records") {
+        options.records = number;
+      } else if (key == "--record-size" &&
+                 number <= storage::config::MAX_RECORD_SIZE) {
+        options.record_size = number;
+      } else if (key == "--pool-pages") {
+        options.pool_pages = number;
+      } else {
+        ok = false;
+      }
+    } else {
+      ok = false;
+    }
+
+    if (!ok) {
+      std::cerr << "invalid argument: " << arg << "\n"
+                << "usage: velox_scalability [--max-threads=N] "
+                   "[--duration=SECONDS]\n"
+                   "                         [--records=N] "
+                   "[--record-size=BYTES]\n"
+                   "                         [--pool-pages=N] [--no-wal] "
+                   "[--latch-profile]\n"
+                   "                         [--csv=PATH]\n";
+      return std::nullopt;
+    }
+  }
+
+  return options;
+}
+
+/// @brief Thread counts 1, 2, 4, ... plus max_threads itself
+std::vector<size_t> thread_counts(size_t max_threads) {
+  std::vector<size_t> counts;
+  for (size_t n = 1; n < max_threads; n *= 2) {
+    counts.push_back(n);
+  }
+  counts.push_back(max_threads);
+
+  return counts;
+}
+
+/// @brief Result of one (mix, pattern, threads) point
+struct SweepPoint {
+  OperationMix mix;
+  KeyDistribution pattern;
+  size_t threads{0};
+  double throughput{0.0};       ///< Operations per second, all threads
+  double min_thread{0.0};       ///< Slowest thread, ops/s
+  double max_thread{0.0};       ///< Fastest thread, ops/s
+  uint64_t p99_ns{0};           ///< 99th percentile operation latency
+  uint64_t errors{0};           ///< Failed operations
+  double latch_contention{0.0}; ///< Page latch contention ratio
+  uint64_t latch_wait_ns{0};    ///< Page latch wait time
+};
+
+/// @brief Per-thread counter on its own cache line
+struct alignas(64) ThreadCounter {
+  uint64_t operations{0};
+  uint64_t errors{0};
+};
+
+SweepPoint run_point(storage::StorageEngine &engine,
+                     const std::vector<storage::RecordId> &ids,
+                     const SweepOptions &options, OperationMix mix,
+                     KeyDistribution pattern, size_t threads) {
+  const KeyChooser chooser(pattern, ids.size());
+  metrics::LatencyHistogram latency;
+  std::vector<ThreadCounter> counters(threads);
+  std::atomic<bool> stop{false};
+
+  metrics::reset_latch_stats();
+
+  std::vector<std::thread> workers;
+  workers.reserve(threads);
+  for (size_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      std::mt19937_64 rng(t + 1);
+      const auto payload = make_payload(options.record_size, t);
+      auto &counter = counters[t];
+
+      while (!stop.load(std::memory_order_relaxed)) {
+        const auto id = ids[chooser.next(rng, ids.size())];
+        const bool write =
+            mix == OperationMix::WRITE ||
+            (mix == OperationMix::MIXED &&
+             std::uniform_real_distribution<double>(0.0, 1.0)(rng) >=
+                 MIXED_READ_FRACTION);
+
+        const auto start = Clock::now();
+        const bool ok =
+            write ? engine.update_record(BENCH_TABLE, id, payload).has_value()
+                  : engine.get_record(BENCH_TABLE, id).has_value();
+        latency.record(Clock::now() - start);
+
+        ++counter.operations;
+        counter.errors += ok ? 0 : 1;
+      }
+    });
+  }
+
+  const auto start = Clock::now();
+  std::this_thread::sleep_for(options.duration);
+  stop.store(true, std::memory_order_relaxed);
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  const double elapsed =
+      std::chrono::duration<double>(Clock::now() - start).count();
+
+  SweepPoint point{mix, pattern, threads};
+  point.min_thread = std::numeric_limits<double>::max();
+  for (const auto &counter : counters) {
+    const double rate = static_cast<double>(counter.operations) / elapsed;
+    point.throughput += rate;
+    point.min_thread = std::min(point.min_thread, rate);
+    point.max_thread = std::max(point.max_thread, rate);
+    point.errors += counter.errors;
+  }
+  point.p99_ns = latency.snapshot().percentile(0.99);
+
+  for (const auto &latch : metrics::latch_snapshot()) {
+    if (latch.name == metrics::latch_names::PAGE) {
+      point.latch_contention = latch.contention_ratio();
+      point.latch_wait_ns = latch.wait_ns;
+    }
+  }
+
+  return point;
+}
+
+void print_curve(const std::vector<SweepPoint> &curve, bool latch_profile) {
+  const auto &first = curve.front();
+  fmt::print("\n== {} / {} ==\n", to_string(first.mix),
+             to_string(first.pattern));
+  fmt::print("{:>8} {:>14} {:>9} {:>11} {:>14} {:>14} {:>14} {:>10}",
+             "threads", "ops/s", "speedup", "efficiency", "ops/s/thread",
+             "min/thread", "max/thread", "p99_us");
+  if (latch_profile) {
+    fmt::print(" {:>11} {:>12}", "latch_cont%", "latch_wait_ms");
+  }
+  fmt::print("\n");
+
+  for (const auto &point : curve) {
+    const double speedup = point.throughput / first.throughput;
+    fmt::print("{:>8} {:>14.0f} {:>9.2f} {:>10.1f}% {:>14.0f} {:>14.0f} "
+               "{:>14.0f} {:>10.1f}",
+               point.threads, point.throughput, speedup,
+               100.0 * speedup / static_cast<double>(point.threads),
+               point.throughput / static_cast<double>(point.threads),
+               point.min_thread, point.max_thread,
+               static_cast<double>(point.p99_ns) / 1000.0);
+    if (latch_profile) {
+      fmt::print(" {:>11.2f} {:>12.1f}", 100.0 * point.latch_contention,
+                 static_cast<double>(point.latch_wait_ns) / 1e6);
+    }
+    if (point.errors > 0) {
+      fmt::print("  ({} errors)", point.errors);
+    }
+    fmt::print("\n");
+  }
+}
+
+void write_csv(const std::string &path,
+               const std::vector<std::vector<SweepPoint>> &curves) {
+  std::ofstream out(path);
+  out << "mix,pattern,threads,ops_per_sec,speedup,min_thread_ops,"
+         "max_thread_ops,p99_ns,errors,latch_contention,latch_wait_ns\n";
+
+  for (const auto &curve : curves) {
+    for (const auto &point : curve) {
+      out << fmt::format("{},{},{},{:.1f},{:.3f},{:.1f},{:.1f},{},{},{:.4f},"
+                         "{}\n",
+                         to_string(point.mix), to_string(point.pattern),
+                         point.threads, point.throughput,
+                         point.throughput / curve.front().throughput,
+                         point.min_thread, point.max_thread, point.p99_ns,
+                         point.errors, point.latch_contention,
+                         point.latch_wait_ns);
+    }
+  }
+}
+
+int run(const SweepOptions &options) {
+  auto env = EngineEnvironment::create(options.pool_pages, options.enable_wal);
+  if (!env || !env->engine->create_table(BENCH_TABLE)) {
+    std::cerr << "failed to initialize storage engine\n";
+    return 1;
+  }
+
+  std::vector<storage::RecordId> ids;
+  ids.reserve(options.records);
+  const auto payload = make_payload(options.record_size);
+  for (uint64_t i = 0; i < options.records; ++i) {
+    auto id = env->engine->insert_record(BENCH_TABLE, payload);
+    if (!id) {
+      std::cerr << "load phase failed\n";
+      return 1;
+    }
+    ids.push_back(*id);
+  }
+
+  metrics::set_latch_profiling(options.latch_profile);
+  fmt::print("VeloxDB scalability sweep: {} records, {} B records, "
+             "{} pool pages, WAL {}, {} s per point\n",
+             options.records, options.record_size, options.pool_pages,
+             options.enable_wal ? "on" : "off", options.duration.count());
+
+  std::vector<std::vector<SweepPoint>> curves;
+  for (auto mix : OPERATION_MIXES) {
+    for (auto pattern : ACCESS_PATTERNS) {
+      auto &curve = curves.emplace_back();
+      for (auto threads : thread_counts(options.max_threads)) {
+        curve.push_back(
+            run_point(*env->engine, ids, options, mix, pattern, threads));
+      }
+      print_curve(curve, options.latch_profile);
+    }
+  }
+
+  if (!options.csv_path.empty()) {
+    write_csv(options.csv_path, curves);
+  }
+
+  return 0;
+}
+} // namespace
+} // namespace velox::bench
+
+int main(int argc, char **argv) {
+  auto options = velox::bench::parse_options(argc, argv);
+  if (!options) {
+    return 1;
+  }
+
+  return velox::bench::run(*options);
+}
@@ -0,0 +1,377 @@
+/**
+ * @file storage_benchmark.cpp
+ * @author Carlos Salguero
+ * @brief Benchmarks for StorageEngine record and page operations
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "bench_common.hpp"
+
+namespace velox::bench {
+namespace {
+/// @brief Records loaded before read/update benchmarks
+constexpr size_t PRELOAD_RECORDS = 20000;
+
+/// @brief Records each thread deletes before refilling
+constexpr size_t DELETE_BATCH = 4096;
+
+/// @brief Pages allocated before deallocating them in bulk
+constexpr size_t ALLOCATE_BATCH = 4096;
+
+/// @brief Working set of the page-miss benchmark relative to the pool
+constexpr size_t MISS_WORKING_SET_FACTOR = 4;
+
+/// @brief Engine and preloaded data shared by all benchmark threads
+struct SharedState {
+  std::unique_ptr<EngineEnvironment> env;
+  std::vector<storage::RecordId> record_ids;
+  std::vector<storage::PageId> page_ids;
+  const char *error{nullptr}; ///< First setup failure, if any
+};
+
+std::unique_ptr<SharedState> shared;
+
+/**
+ * @brief Report a setup failure from inside the timing loop
+ *
+ * @note Setup runs on thread 0 before the start barrier, so the other
+ *       threads only see its outcome once the loop has started. Returning
+ *       before the loop instead would leave them waiting at the barrier.
+ */
+bool setup_failed(benchmark::State &state) {
+  if (shared->error == nullptr) {
+    return false;
+  }
+
+  state.SkipWithError(shared->error);
+  return true;
+}
+
+/// @brief Set up the shared engine on thread 0 (runs before the barrier)
+void setup_engine(benchmark::State &state, size_t pool_pages) {
+  if (state.thread_index() != 0) {
+    return;
+  }
+
+  shared = std::make_unique<SharedState>();
+  shared->env = EngineEnvironment::create(pool_pages);
+  if (!shared->env) {
+    shared->error = "Failed to initialize storage engine";
+    return;
+  }
+
+  if (!shared->env->engine->create_table(BENCH_TABLE)) {
+    shared->error = "Failed to create benchmark table";
+  }
+}
+
+/// @brief Load records for read/update benchmarks
+void preload_records(benchmark::State &state, size_t record_size) {
+  if (state.thread_index() != 0 || shared->error != nullptr) {
+    return;
+  }
+
+  const auto payload = make_payload(record_size);
+  shared->record_ids.reserve(PRELOAD_RECORDS);
+
+  for (size_t i = 0; i < PRELOAD_RECORDS; ++i) {
+    auto id = shared->env->engine->insert_record(BENCH_TABLE, payload);
+    if (!id) {
+      shared->error = "Failed to preload records";
+      return;
+    }
+
+    shared->record_ids.push_back(*id);
+  }
+}
+
+/// @brief Allocate pages for page-fetch benchmarks
+void preload_pages(benchmark::State &state, size_t count) {
+  if (state.thread_index() != 0 || shared->error != nullptr) {
+    return;
+  }
+
+  shared->page_ids.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    auto id = shared->env->engine->allocate_page();
+    if (!id) {
+      shared->error = "Failed to allocate pages";
+      return;
+    }
+
+    shared->page_ids.push_back(*id);
+  }
+}
+
+/// @brief Release the shared engine on thread 0 (runs after the barrier)
+void teardown(benchmark::State &state) {
+  if (state.thread_index() == 0) {
+    shared.reset();
+  }
+}
+
+void set_record_labels(benchmark::State &state, size_t record_size) {
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(record_size));
+}
+} // namespace
+
+/// Args: record size (bytes), buffer pool size (pages)
+static void BM_InsertRecord(benchmark::State &state) {
+  const auto record_size = static_cast<size_t>(state.range(0));
+  const auto pool_pages = static_cast<size_t>(state.range(1));
+  setup_engine(state, pool_pages);
+
+  const auto payload = make_payload(record_size, state.thread_index());
+  PerfReport perf(state);
+
+  for (auto _ : state) {
+    if (setup_failed(state)) {
+      break;
+    }
+
+    auto id = shared->env->engine->insert_record(BENCH_TABLE, payload);
+    if (!id) {
+      state.SkipWithError("insert_record failed");
+      break;
+    }
+
+    benchmark::DoNotOptimize(id);
+  }
+
+  set_record_labels(state, record_size);
+  teardown(state);
+}
+
+/// Args: record size (bytes), buffer pool size (pages)
+static void BM_GetRecord(benchmark::State &state) {
+  const auto record_size = static_cast<size_t>(state.range(0));
+  const auto pool_pages = static_cast<size_t>(state.range(1));
+  setup_engine(state, pool_pages);
+  preload_records(state, record_size);
+
+  std::mt19937_64 rng(state.thread_index());
+  PerfReport perf(state);
+
+  for (auto _ : state) {
+    if (setup_failed(state)) {
+      break;
+    }
+
+    const auto &ids = shared->record_ids;
+    auto record =
+        shared->env->engine->get_record(BENCH_TABLE, ids[rng() % ids.size()]);
+    if (!record) {
+      state.SkipWithError("get_record failed");
+      break;
+    }
+
+    benchmark::DoNotOptimize(record->data.data());
+  }
+
+  set_record_labels(state, record_size);
+  teardown(state);
+}
+
+/// Args: record size (bytes), buffer pool size (pages)
+static void BM_UpdateRecord(benchmark::State &state) {
+  const auto record_size = static_cast<size_t>(state.range(0));
+  const auto pool_pages = static_cast<size_t>(state.range(1));
+  setup_engine(state, pool_pages);
+  preload_records(state, record_size);
+
+  const auto payload = make_payload(record_size, state.thread_index() + 1);
+  std::mt19937_64 rng(state.thread_index());
+  PerfReport perf(state);
+
+  for (auto _ : state) {
+    if (setup_failed(state)) {
+      break;
+    }
+
+    const auto &ids = shared->record_ids;
+    auto result = shared->env->engine->update_record(
+        BENCH_TABLE, ids[rng() % ids.size()], payload);
+    if (!result) {
+      state.SkipWithError("update_record failed");
+      break;
+    }
+  }
+
+  set_record_labels(state, record_size);
+  teardown(state);
+}
+
+/// Args: record size (bytes), buffer pool size (pages)
+static void BM_DeleteRecord(benchmark::State &state) {
+  const auto record_size = static_cast<size_t>(state.range(0));
+  const auto pool_pages = static_cast<size_t>(state.range(1));
+  setup_engine(state, pool_pages);
+
+  // Each thread deletes only records it inserted, refilling off the clock
+  const auto payload = make_payload(record_size, state.thread_index());
+  std::vector<storage::RecordId> ids;
+  ids.reserve(DELETE_BATCH);
+  PerfReport perf(state);
+
+  for (auto _ : state) {
+    if (setup_failed(state)) {
+      break;
+    }
+
+    if (ids.empty()) {
+      state.PauseTiming();
+      for (size_t i = 0; i < DELETE_BATCH; ++i) {
+        auto id = shared->env->engine->insert_record(BENCH_TABLE, payload);
+        if (id) {
+          ids.push_back(*id);
+        }
+      }
+      state.ResumeTiming();
+
+      if (ids.empty()) {
+        state.SkipWithError("Failed to refill records");
+        break;
+      }
+    }
+
+    auto result = shared->env->engine->delete_record(BENCH_TABLE, ids.back());
+    ids.pop_back();
+    if (!result) {
+      state.SkipWithError("delete_record failed");
+      break;
+    }
+  }
+
+  set_record_labels(state, record_size);
+  teardown(state);
+}
+
+/// Args: buffer pool size (pages); working set fits in the pool
+static void BM_GetPageHit(benchmark::State &state) {
+  const auto pool_pages = static_cast<size_t>(state.range(0));
+  const auto working_set = std::max<size_t>(pool_pages / 2, 1);
+  setup_engine(state, pool_pages);
+  preload_pages(state, working_set);
+
+  std::mt19937_64 rng(state.thread_index());
+  PerfReport perf(state);
+
+  for (auto _ : state) {
+    if (setup_failed(state)) {
+      break;
+    }
+
+    const auto &pages = shared->page_ids;
+    auto page = shared->env->engine->get_page(pages[rng() % pages.size()]);
+    if (!page) {
+      state.SkipWithError("get_page failed");
+      break;
+    }
+
+    benchmark::DoNotOptimize(page->get());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  teardown(state);
+}
+
+/// Args: buffer pool size (pages); cyclic scan over 4x the pool
+static void BM_GetPageMiss(benchmark::State &state) {
+  const auto pool_pages = static_cast<size_t>(state.range(0));
+  setup_engine(state, pool_pages);
+  preload_pages(state, pool_pages * MISS_WORKING_SET_FACTOR);
+
+  // A cyclic scan larger than the pool defeats LRU-style replacement
+  size_t cursor = static_cast<size_t>(state.thread_index()) * pool_pages;
+  PerfReport perf(state);
+
+  for (auto _ : state) {
+    if (setup_failed(state)) {
+      break;
+    }
+
+    const auto &pages = shared->page_ids;
+    auto page = shared->env->engine->get_page(pages[cursor++ % pages.size()]);
+    if (!page) {
+      state.SkipWithError("get_page failed");
+      break;
+    }
+
+    benchmark::DoNotOptimize(page->get());
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(storage::config::PAGE_SIZE));
+  teardown(state);
+}
+
+/// Args: buffer pool size (pages)
+static void BM_AllocatePage(benchmark::State &state) {
+  const auto pool_pages = static_cast<size_t>(state.range(0));
+  setup_engine(state, pool_pages);
+
+  std::vector<storage::PageId> allocated;
+  allocated.reserve(ALLOCATE_BATCH);
+  PerfReport perf(state);
+
+  for (auto _ : state) {
+    if (setup_failed(state)) {
+      break;
+    }
+
+    auto id = shared->env->engine->allocate_page();
+    if (!id) {
+      state.SkipWithError("allocate_page failed");
+      break;
+    }
+
+    allocated.push_back(*id);
+    if (allocated.size() == ALLOCATE_BATCH) {
+      state.PauseTiming();
+      for (auto page_id : allocated) {
+        (void)shared->env->engine->deallocate_page(page_id);
+      }
+      allocated.clear();
+      state.ResumeTiming();
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  teardown(state);
+}
+
+namespace {
+void record_args(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"record_size", "pool_pages"})
+      ->ArgsProduct({{64, 512, 2048}, {64, 1024, 16384}})
+      ->ThreadRange(1, 8)
+      ->UseRealTime();
+}
+
+void page_args(benchmark::internal::Benchmark *b) {
+  b->ArgName("pool_pages")
+      ->RangeMultiplier(16)
+      ->Range(64, 16384)
+      ->ThreadRange(1, 8)
+      ->UseRealTime();
+}
+} // namespace
+
+BENCHMARK(BM_InsertRecord)->Apply(record_args);
+BENCHMARK(BM_GetRecord)->Apply(record_args);
+BENCHMARK(BM_UpdateRecord)->Apply(record_args);
+BENCHMARK(BM_DeleteRecord)->Apply(record_args);
+BENCHMARK(BM_GetPageHit)->Apply(page_args);
+BENCHMARK(BM_GetPageMiss)->Apply(page_args);
+BENCHMARK(BM_AllocatePage)->Apply(page_args);
+
+} // namespace velox::bench
+
+BENCHMARK_MAIN();
@@ -0,0 +1,735 @@
+/**
+ * @file tpcc.cpp
+ * @author Carlos Salguero
+ * @brief TPC-C-like OLTP benchmark (NewOrder/Payment) for StorageEngine
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Loads warehouses, districts, customers, items and stock with TPC-C
+ * cardinalities, then runs terminals issuing NewOrder and Payment
+ * transactions in the TPC-C 45:43 ratio. Each transaction runs between
+ * begin_transaction and commit_transaction. Engine errors roll it back
+ * and count as aborts. The 1% of NewOrders with an invalid item roll
+ * back by design and count separately.
+ *
+ * This is not a compliant TPC-C implementation: there are no keying or
+ * think times, Payment always selects the customer by id, and
+ * Delivery, OrderStatus and StockLevel are omitted.
+ *
+ * Usage: velox_tpcc [--warehouses=1] [--threads=1] [--duration=30]
+ *                   [--warmup=5] [--pool-pages=N] [--no-wal] [--seed=42]
+ */
+
+#include "bench_common.hpp"
+
+#include <charconv>
+#include <iostream>
+#include <thread>
+#include <velox/dtypes.hpp>
+#include <velox/metrics/metrics.hpp>
+
+namespace velox::bench {
+namespace {
+using dtypes::Decimal;
+using dtypes::Row;
+using dtypes::Value;
+
+/// @brief TPC-C cardinalities
+namespace tpcc_config {
+constexpr uint32_t DISTRICTS_PER_WAREHOUSE = 10;
+constexpr uint32_t CUSTOMERS_PER_DISTRICT = 3000;
+constexpr uint32_t ITEMS = 100000;
+constexpr uint32_t INITIAL_ORDERS_PER_DISTRICT = 3000;
+constexpr uint32_t MIN_ORDER_LINES = 5;
+constexpr uint32_t MAX_ORDER_LINES = 15;
+constexpr double NEW_ORDER_WEIGHT = 45.0;
+constexpr double PAYMENT_WEIGHT = 43.0;
+constexpr uint8_t MONEY_PRECISION = 12;
+constexpr uint8_t MONEY_SCALE = 2;
+} // namespace tpcc_config
+
+/// @brief Benchmark tables
+namespace tables {
+constexpr std::string_view WAREHOUSE = "warehouse";
+constexpr std::string_view DISTRICT = "district";
+constexpr std::string_view CUSTOMER = "customer";
+constexpr std::string_view HISTORY = "history";
+constexpr std::string_view ITEM = "item";
+constexpr std::string_view STOCK = "stock";
+constexpr std::string_view ORDERS = "orders";
+constexpr std::string_view NEW_ORDER = "new_order";
+constexpr std::string_view ORDER_LINE = "order_line";
+
+constexpr std::array ALL = {WAREHOUSE, DISTRICT, CUSTOMER,
+                            HISTORY,   ITEM,     STOCK,
+                            ORDERS,    NEW_ORDER, ORDER_LINE};
+} // namespace tables
+
+/// @brief Column positions of the rows the transactions modify
+namespace columns {
+constexpr size_t W_TAX = 2;
+constexpr size_t W_YTD = 3;
+constexpr size_t D_TAX = 3;
+constexpr size_t D_YTD = 4;
+constexpr size_t D_NEXT_O_ID = 5;
+constexpr size_t C_DISCOUNT = 5;
+constexpr size_t C_BALANCE = 6;
+constexpr size_t C_YTD_PAYMENT = 7;
+constexpr size_t C_PAYMENT_CNT = 8;
+constexpr size_t I_PRICE = 2;
+constexpr size_t S_QUANTITY = 2;
+constexpr size_t S_YTD = 3;
+constexpr size_t S_ORDER_CNT = 4;
+constexpr size_t S_REMOTE_CNT = 5;
+} // namespace columns
+
+/// @brief Transaction types
+enum class TxnType : uint8_t { NEW_ORDER = 0, PAYMENT = 1 };
+
+constexpr size_t TXN_TYPE_COUNT = 2;
+
+constexpr std::string_view to_string(TxnType type) noexcept {
+  switch (type) {
+  case TxnType::NEW_ORDER:
+    return "NewOrder";
+  case TxnType::PAYMENT:
+    return "Payment";
+  }
+
+  return "Unknown";
+}
+
+/// @brief Transaction outcome
+enum class TxnOutcome : uint8_t { COMMITTED, ABORTED, USER_ROLLBACK };
+
+/// @brief Command-line options
+struct TpccOptions {
+  uint32_t warehouses{1};
+  size_t threads{1};
+  std::chrono::seconds duration{30};
+  std::chrono::seconds warmup{5};
+  size_t pool_pages{storage::config::DEFAULT_BUFFER_POOL_SIZE};
+  bool enable_wal{true};
+  uint64_t seed{42};
+};
+
+template <typename T> bool parse_number(std::string_view text, T &out) {
+  const auto *end = text.data() + text.size();
+  auto [ptr, ec] = std::from_chars(text.data(), end, out);
+  return ec == std::errc{} && ptr == end;
+}
+
+std::optional<TpccOptions> parse_options(int argc, char **argv) {
+  TpccOptions options;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    const auto eq = arg.find('=');
+    const auto key = arg.substr(0, eq);
+    const auto value =
+        eq == std::string_view::npos ? std::string_view{} : arg.substr(eq + 1);
+
+    uint64_t number = 0;
+    bool ok = true;
+
+    if (key == "--no-wal") {
+      options.enable_wal = false;
+    } else if (parse_number(value, number)) {
+      if (key == "--warehouses" && number > 0) {
+        options.warehouses = static_cast<uint32_t>(number);
+      } else if (key == "--threads" && number > 0) {
+        options.threads = number;
+      } else if (key == "--duration" && number > 0) {
+        options.duration = std::chrono::seconds(number);
+      } else if (key == "--warmup") {
+        options.warmup = std::chrono::seconds(number);
+      } else if (key == "--pool-pages" && number > 0) {
+        options.pool_pages = number;
+      } else if (key == "--seed") {
+        options.seed = number;
+      } else {
+        ok = false;
+      }
+    } else {
+      ok = false;
+    }
+
+    if (!ok) {
+      std::cerr << "invalid argument: " << arg << "\n"
+                << "usage: velox_tpcc [--warehouses=N] [--threads=N]\n"
+                   "                  [--duration=SECONDS] [--warmup=SECONDS]\n"
+                   "                  [--pool-pages=N] [--no-wal] [--seed=N]\n";
+      return std::nullopt;
+    }
+  }
+
+  return options;
+}
+
+/// @brief Random helpers following TPC-C clause 2.1.6 and 4.3.2
+class TpccRandom {
+public:
+  TpccRandom(uint64_t seed, uint32_t c_id, uint32_t ol_i_id)
+      : m_rng(seed), m_c_id(c_id), m_ol_i_id(ol_i_id) {}
+
+  uint32_t uniform(uint32_t min, uint32_t max) {
+    return min + static_cast<uint32_t>(m_rng() % (max - min + 1));
+  }
+
+  uint32_t nurand(uint32_t a, uint32_t c, uint32_t min, uint32_t max) {
+    return (((uniform(0, a) | uniform(min, max)) + c) % (max - min + 1)) + min;
+  }
+
+  uint32_t customer_id() {
+    return nurand(1023, m_c_id, 1, tpcc_config::CUSTOMERS_PER_DISTRICT);
+  }
+
+  uint32_t item_id() { return nurand(8191, m_ol_i_id, 1, tpcc_config::ITEMS); }
+
+  std::string astring(uint32_t min, uint32_t max) {
+    static constexpr std::string_view ALPHABET =
+        "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    std::string result(uniform(min, max), ' ');
+    for (auto &c : result) {
+      c = ALPHABET[m_rng() % ALPHABET.size()];
+    }
+
+    return result;
+  }
+
+  Decimal money(uint32_t min_cents, uint32_t max_cents) {
+    return Decimal(uniform(min_cents, max_cents), tpcc_config::MONEY_PRECISION,
+                   tpcc_config::MONEY_SCALE);
+  }
+
+private:
+  std::mt19937_64 m_rng;
+  uint32_t m_c_id;
+  uint32_t m_ol_i_id;
+};
+
+Decimal add_money(const Decimal &a, int64_t cents) {
+  return Decimal(a.value + cents, tpcc_config::MONEY_PRECISION,
+                 tpcc_config::MONEY_SCALE);
+}
+
+/// @brief Record ids of the fixed-size tables, addressed by TPC-C keys
+struct TpccKeys {
+  std::vector<storage::RecordId> warehouse;
+  std::vector<storage::RecordId> district;
+  std::vector<storage::RecordId> customer;
+  std::vector<storage::RecordId> item;
+  std::vector<storage::RecordId> stock;
+
+  explicit TpccKeys(uint32_t warehouses)
+      : warehouse(warehouses),
+        district(warehouses * tpcc_config::DISTRICTS_PER_WAREHOUSE),
+        customer(district.size() * tpcc_config::CUSTOMERS_PER_DISTRICT),
+        item(tpcc_config::ITEMS),
+        stock(static_cast<size_t>(warehouses) * tpcc_config::ITEMS) {}
+
+  /// Warehouse ids are 0-based; district, customer and item ids 1-based
+  static size_t district_index(uint32_t w, uint32_t d) {
+    return w * tpcc_config::DISTRICTS_PER_WAREHOUSE + (d - 1);
+  }
+
+  static size_t customer_index(uint32_t w, uint32_t d, uint32_t c) {
+    return district_index(w, d) * tpcc_config::CUSTOMERS_PER_DISTRICT +
+           (c - 1);
+  }
+
+  static size_t stock_index(uint32_t w, uint32_t i) {
+    return static_cast<size_t>(w) * tpcc_config::ITEMS + (i - 1);
+  }
+};
+
+/// @brief Per-transaction-type results
+struct TxnStats {
+  metrics::LatencyHistogram latency;
+  std::atomic<uint64_t> committed{0};
+  std::atomic<uint64_t> aborted{0};
+  std::atomic<uint64_t> user_rollbacks{0};
+};
+
+/// @brief Row access through the engine, surfacing the first error
+class TxnContext {
+public:
+  explicit TxnContext(storage::StorageEngine &engine) : m_engine(engine) {}
+
+  [[nodiscard]] std::optional<Row> read(std::string_view table,
+                                        storage::RecordId id) {
+    auto record = m_engine.get_record(table, id);
+    if (!record) {
+      m_failed = true;
+      return std::nullopt;
+    }
+
+    auto row = Row::deserialize(record->data);
+    m_failed |= !row.has_value();
+    return row;
+  }
+
+  void write(std::string_view table, storage::RecordId id, const Row &row) {
+    m_failed |= !m_engine.update_record(table, id, row.serialize());
+  }
+
+  void insert(std::string_view table, const Row &row) {
+    m_failed |= !m_engine.insert_record(table, row.serialize());
+  }
+
+  [[nodiscard]] bool failed() const noexcept { return m_failed; }
+
+private:
+  storage::StorageEngine &m_engine;
+  bool m_failed{false};
+};
+
+/// @brief State shared by loader and terminals
+struct TpccState {
+  const TpccOptions &options;
+  storage::StorageEngine &engine;
+  TpccKeys keys;
+  uint32_t c_id_constant;
+  uint32_t ol_i_id_constant;
+  std::array<TxnStats, TXN_TYPE_COUNT> stats;
+  std::atomic<bool> recording{false};
+  std::atomic<bool> stop{false};
+
+  TpccState(const TpccOptions &opts, storage::StorageEngine &eng)
+      : options(opts), engine(eng), keys(opts.warehouses),
+        c_id_constant(static_cast<uint32_t>(opts.seed % 1024)),
+        ol_i_id_constant(static_cast<uint32_t>((opts.seed * 7) % 8192)) {}
+};
+
+bool load_items(TpccState &state) {
+  TpccRandom random(state.options.seed, 0, 0);
+
+  for (uint32_t i = 1; i <= tpcc_config::ITEMS; ++i) {
+    Row row({static_cast<int32_t>(i), random.astring(14, 24),
+             random.money(100, 10000), random.astring(26, 50)});
+    auto id = state.engine.insert_record(tables::ITEM, row.serialize());
+    if (!id) {
+      return false;
+    }
+
+    state.keys.item[i - 1] = *id;
+  }
+
+  return true;
+}
+
+bool load_warehouse(TpccState &state, uint32_t w) {
+  auto &engine = state.engine;
+  TpccRandom random(state.options.seed + w + 1, 0, 0);
+  const auto insert = [&](std::string_view table,
+                          const Row &row) -> std::optional<storage::RecordId> {
+    auto id = engine.insert_record(table, row.serialize());
+    return id ? std::optional(*id) : std::nullopt;
+  };
+
+  auto warehouse =
+      insert(tables::WAREHOUSE,
+             Row({static_cast<int32_t>(w), random.astring(6, 10),
+                  random.money(0, 2000), Decimal(30000000, 12, 2),
+                  random.astring(50, 70)}));
+  if (!warehouse) {
+    return false;
+  }
+  state.keys.warehouse[w] = *warehouse;
+
+  for (uint32_t i = 1; i <= tpcc_config::ITEMS; ++i) {
+    auto stock = insert(
+        tables::STOCK,
+        Row({static_cast<int32_t>(w), static_cast<int32_t>(i),
+             static_cast<int32_t>(random.uniform(10, 100)), int32_t{0},
+             int32_t{0}, int32_t{0}, random.astring(240, 240),
+             random.astring(26, 50)}));
+    if (!stock) {
+      return false;
+    }
+    state.keys.stock[TpccKeys::stock_index(w, i)] = *stock;
+  }
+
+  for (uint32_t d = 1; d <= tpcc_config::DISTRICTS_PER_WAREHOUSE; ++d) {
+    auto district = insert(
+        tables::DISTRICT,
+        Row({static_cast<int32_t>(w), static_cast<int32_t>(d),
+             random.astring(6, 10), random.money(0, 2000),
+             Decimal(3000000, 12, 2),
+             static_cast<int32_t>(tpcc_config::INITIAL_ORDERS_PER_DISTRICT + 1),
+             random.astring(50, 70)}));
+    if (!district) {
+      return false;
+    }
+    state.keys.district[TpccKeys::district_index(w, d)] = *district;
+
+    for (uint32_t c = 1; c <= tpcc_config::CUSTOMERS_PER_DISTRICT; ++c) {
+      auto customer =
+          insert(tables::CUSTOMER,
+                 Row({static_cast<int32_t>(w), static_cast<int32_t>(d),
+                      static_cast<int32_t>(c), random.astring(8, 16),
+                      random.astring(8, 16), random.money(0, 5000),
+                      Decimal(-1000, 12, 2), Decimal(1000, 12, 2), int32_t{1},
+                      random.astring(300, 500)}));
+      if (!customer) {
+        return false;
+      }
+      state.keys.customer[TpccKeys::customer_index(w, d, c)] = *customer;
+    }
+  }
+
+  return true;
+}
+
+bool load(TpccState &state) {
+  for (auto table : tables::ALL) {
+    if (!state.engine.create_table(table)) {
+      return false;
+    }
+  }
+
+  if (!load_items(state)) {
+    return false;
+  }
+
+  std::atomic<uint32_t> next_warehouse{0};
+  std::atomic<bool> failed{false};
+  std::vector<std::thread> loaders;
+
+  const auto loader_count =
+      std::min<size_t>(state.options.threads, state.options.warehouses);
+  for (size_t t = 0; t < loader_count; ++t) {
+    loaders.emplace_back([&] {
+      for (auto w = next_warehouse.fetch_add(1); w < state.options.warehouses;
+           w = next_warehouse.fetch_add(1)) {
+        if (!load_warehouse(state, w)) {
+          failed.store(true);
+          return;
+        }
+      }
+    });
+  }
+
+  for (auto &loader : loaders) {
+    loader.join();
+  }
+
+  return !failed.load();
+}
+
+/// @brief One terminal bound to a home warehouse
+class Terminal {
+public:
+  Terminal(TpccState &state, size_t index)
+      : m_state(state),
+        m_random(state.options.seed * 1000003 + index, state.c_id_constant,
+                 state.ol_i_id_constant),
+        m_home_warehouse(static_cast<uint32_t>(index) %
+                         state.options.warehouses) {}
+
+  void run() {
+    constexpr double NEW_ORDER_SHARE =
+        tpcc_config::NEW_ORDER_WEIGHT /
+        (tpcc_config::NEW_ORDER_WEIGHT + tpcc_config::PAYMENT_WEIGHT);
+
+    while (!m_state.stop.load(std::memory_order_relaxed)) {
+      const auto type = m_random.uniform(0, 9999) < NEW_ORDER_SHARE * 10000
+                            ? TxnType::NEW_ORDER
+                            : TxnType::PAYMENT;
+
+      const auto start = Clock::now();
+      const auto outcome = execute(type);
+      const auto elapsed = Clock::now() - start;
+
+      if (!m_state.recording.load(std::memory_order_relaxed)) {
+        continue;
+      }
+
+      auto &stats = m_state.stats[static_cast<size_t>(type)];
+      switch (outcome) {
+      case TxnOutcome::COMMITTED:
+        stats.latency.record(elapsed);
+        stats.committed.fetch_add(1, std::memory_order_relaxed);
+        break;
+      case TxnOutcome::ABORTED:
+        stats.aborted.fetch_add(1, std::memory_order_relaxed);
+        break;
+      case TxnOutcome::USER_ROLLBACK:
+        stats.user_rollbacks.fetch_add(1, std::memory_order_relaxed);
+        break;
+      }
+    }
+  }
+
+private:
+  TxnOutcome execute(TxnType type) {
+    auto txn = m_state.engine.begin_transaction();
+    if (!txn) {
+      return TxnOutcome::ABORTED;
+    }
+
+    TxnContext ctx(m_state.engine);
+    const bool user_rollback =
+        type == TxnType::NEW_ORDER ? new_order(ctx) : payment(ctx);
+
+    if (ctx.failed() || user_rollback) {
+      (void)m_state.engine.rollback_transaction(*txn);
+      return ctx.failed() ? TxnOutcome::ABORTED : TxnOutcome::USER_ROLLBACK;
+    }
+
+    return m_state.engine.commit_transaction(*txn) ? TxnOutcome::COMMITTED
+                                                   : TxnOutcome::ABORTED;
+  }
+
+  uint32_t other_warehouse() {
+    const auto warehouses = m_state.options.warehouses;
+    if (warehouses == 1) {
+      return m_home_warehouse;
+    }
+
+    const auto w = m_random.uniform(0, warehouses - 2);
+    return w >= m_home_warehouse ? w + 1 : w;
+  }
+
+  /// @brief TPC-C 2.4; returns true when the transaction must roll back
+  bool new_order(TxnContext &ctx) {
+    const auto &keys = m_state.keys;
+    const auto w = m_home_warehouse;
+    const auto d = m_random.uniform(1, tpcc_config::DISTRICTS_PER_WAREHOUSE);
+    const auto c = m_random.customer_id();
+    const auto line_count = m_random.uniform(tpcc_config::MIN_ORDER_LINES,
+                                             tpcc_config::MAX_ORDER_LINES);
+    const bool invalid_item = m_random.uniform(1, 100) == 1;
+
+    auto warehouse = ctx.read(tables::WAREHOUSE, keys.warehouse[w]);
+    const auto district_id = keys.district[TpccKeys::district_index(w, d)];
+    auto district = ctx.read(tables::DISTRICT, district_id);
+    const auto customer_id = keys.customer[TpccKeys::customer_index(w, d, c)];
+    auto customer = ctx.read(tables::CUSTOMER, customer_id);
+    if (!warehouse || !district || !customer) {
+      return false;
+    }
+
+    const auto order_id = std::get<int32_t>((*district)[columns::D_NEXT_O_ID]);
+    district->set(columns::D_NEXT_O_ID, order_id + 1);
+    ctx.write(tables::DISTRICT, district_id, *district);
+
+    bool all_local = true;
+    std::vector<std::pair<uint32_t, uint32_t>> lines; // (item, supply w)
+    lines.reserve(line_count);
+    for (uint32_t l = 0; l < line_count; ++l) {
+      const bool remote = m_random.uniform(1, 100) == 1;
+      const auto supply = remote ? other_warehouse() : w;
+      all_local &= supply == w;
+      lines.emplace_back(m_random.item_id(), supply);
+    }
+
+    const auto entry = dtypes::Timestamp::now();
+    ctx.insert(tables::ORDERS,
+               Row({static_cast<int32_t>(w), static_cast<int32_t>(d), order_id,
+                    static_cast<int32_t>(c), entry,
+                    static_cast<int32_t>(line_count), all_local}));
+    ctx.insert(tables::NEW_ORDER,
+               Row({static_cast<int32_t>(w), static_cast<int32_t>(d),
+                    order_id}));
+
+    for (uint32_t l = 0; l < line_count; ++l) {
+      // The last line of a rolled-back order references an unused item
+      if (invalid_item && l + 1 == line_count) {
+        return true;
+      }
+
+      const auto [i, supply] = lines[l];
+      auto item = ctx.read(tables::ITEM, keys.item[i - 1]);
+      const auto stock_id = keys.stock[TpccKeys::stock_index(supply, i)];
+      auto stock = ctx.read(tables::STOCK, stock_id);
+      if (!item || !stock) {
+        return false;
+      }
+
+      const auto quantity = static_cast<int32_t>(m_random.uniform(1, 10));
+      auto s_quantity = std::get<int32_t>((*stock)[columns::S_QUANTITY]);
+      s_quantity = s_quantity >= quantity + 10 ? s_quantity - quantity
+                                               : s_quantity - quantity + 91;
+      stock->set(columns::S_QUANTITY, s_quantity);
+      stock->set(columns::S_YTD,
+                 std::get<int32_t>((*stock)[columns::S_YTD]) + quantity);
+      stock->set(columns::S_ORDER_CNT,
+                 std::get<int32_t>((*stock)[columns::S_ORDER_CNT]) + 1);
+      if (supply != w) {
+        stock->set(columns::S_REMOTE_CNT,
+                   std::get<int32_t>((*stock)[columns::S_REMOTE_CNT]) + 1);
+      }
+      ctx.write(tables::STOCK, stock_id, *stock);
+
+      const auto price = std::get<Decimal>((*item)[columns::I_PRICE]);
+      ctx.insert(tables::ORDER_LINE,
+                 Row({static_cast<int32_t>(w), static_cast<int32_t>(d),
+                      order_id, static_cast<int32_t>(l + 1),
+                      static_cast<int32_t>(i), static_cast<int32_t>(supply),
+                      quantity,
+                      Decimal(price.value * quantity,
+                              tpcc_config::MONEY_PRECISION,
+                              tpcc_config::MONEY_SCALE),
+                      m_random.astring(24, 24)}));
+    }
+
+    return false;
+  }
+
+  /// @brief TPC-C 2.5 (customer selected by id); never rolls back
+  bool payment(TxnContext &ctx) {
+    const auto &keys = m_state.keys;
+    const auto w = m_home_warehouse;
+    const auto d = m_random.uniform(1, tpcc_config::DISTRICTS_PER_WAREHOUSE);
+    const bool remote = m_random.uniform(1, 100) > 85;
+    const auto c_w = remote ? other_warehouse() : w;
+    const auto c_d =
+        remote ? m_random.uniform(1, tpcc_config::DISTRICTS_PER_WAREHOUSE) : d;
+    const auto c = m_random.customer_id();
+    const auto amount = static_cast<int64_t>(m_random.uniform(100, 500000));
+
+    auto warehouse = ctx.read(tables::WAREHOUSE, keys.warehouse[w]);
+    if (!warehouse) {
+      return false;
+    }
+    warehouse->set(columns::W_YTD,
+                   add_money(std::get<Decimal>((*warehouse)[columns::W_YTD]),
+                             amount));
+    ctx.write(tables::WAREHOUSE, keys.warehouse[w], *warehouse);
+
+    const auto district_id = keys.district[TpccKeys::district_index(w, d)];
+    auto district = ctx.read(tables::DISTRICT, district_id);
+    if (!district) {
+      return false;
+    }
+    district->set(columns::D_YTD,
+                  add_money(std::get<Decimal>((*district)[columns::D_YTD]),
+                            amount));
+    ctx.write(tables::DISTRICT, district_id, *district);
+
+    const auto customer_id =
+        keys.customer[TpccKeys::customer_index(c_w, c_d, c)];
+    auto customer = ctx.read(tables::CUSTOMER, customer_id);
+    if (!customer) {
+      return false;
+    }
+    customer->set(
+        columns::C_BALANCE,
+        add_money(std::get<Decimal>((*customer)[columns::C_BALANCE]), -amount));
+    customer->set(
+        columns::C_YTD_PAYMENT,
+        add_money(std::get<Decimal>((*customer)[columns::C_YTD_PAYMENT]),
+                  amount));
+    customer->set(columns::C_PAYMENT_CNT,
+                  std::get<int32_t>((*customer)[columns::C_PAYMENT_CNT]) + 1);
+    ctx.write(tables::CUSTOMER, customer_id, *customer);
+
+    ctx.insert(tables::HISTORY,
+               Row({static_cast<int32_t>(c), static_cast<int32_t>(c_d),
+                    static_cast<int32_t>(c_w), static_cast<int32_t>(d),
+                    static_cast<int32_t>(w), dtypes::Timestamp::now(),
+                    Decimal(amount, tpcc_config::MONEY_PRECISION,
+                            tpcc_config::MONEY_SCALE),
+                    m_random.astring(12, 24)}));
+
+    return false;
+  }
+
+  TpccState &m_state;
+  TpccRandom m_random;
+  uint32_t m_home_warehouse;
+};
+
+void report(const TpccState &state, std::chrono::nanoseconds load_time,
+            std::chrono::nanoseconds run_time) {
+  const auto &options = state.options;
+  const double run_seconds = std::chrono::duration<double>(run_time).count();
+
+  fmt::print("VeloxDB TPC-C-like: {} warehouses, {} terminals, {} pool pages, "
+             "WAL {}\n",
+             options.warehouses, options.threads, options.pool_pages,
+             options.enable_wal ? "on" : "off");
+  fmt::print("[LOAD] {:.2f} s\n",
+             std::chrono::duration<double>(load_time).count());
+
+  const auto &new_order = state.stats[static_cast<size_t>(TxnType::NEW_ORDER)];
+  fmt::print("[RUN] {:.2f} s, tpmC {:.0f}\n", run_seconds,
+             static_cast<double>(new_order.committed.load()) * 60.0 /
+                 run_seconds);
+  fmt::print("{:<10} {:>10} {:>10} {:>10} {:>8} {:>10} {:>10} {:>10} {:>10}\n",
+             "txn", "committed", "aborted", "rollbacks", "abort%", "tps",
+             "p50_ms", "p95_ms", "p99_ms");
+
+  for (size_t i = 0; i < TXN_TYPE_COUNT; ++i) {
+    const auto &stats = state.stats[i];
+    const auto committed = stats.committed.load();
+    const auto aborted = stats.aborted.load();
+    const auto attempts = committed + aborted + stats.user_rollbacks.load();
+    const auto latency = stats.latency.snapshot();
+    const auto millis = [&](double q) {
+      return static_cast<double>(latency.percentile(q)) / 1e6;
+    };
+
+    fmt::print("{:<10} {:>10} {:>10} {:>10} {:>8.2f} {:>10.1f} {:>10.2f} "
+               "{:>10.2f} {:>10.2f}\n",
+               to_string(static_cast<TxnType>(i)), committed, aborted,
+               stats.user_rollbacks.load(),
+               attempts > 0 ? 100.0 * static_cast<double>(aborted) /
+                                  static_cast<double>(attempts)
+                            : 0.0,
+               static_cast<double>(committed) / run_seconds, millis(0.50),
+               millis(0.95), millis(0.99));
+  }
+}
+
+int run(const TpccOptions &options) {
+  auto env = EngineEnvironment::create(options.pool_pages, options.enable_wal);
+  if (!env) {
+    std::cerr << "failed to initialize storage engine\n";
+    return 1;
+  }
+
+  TpccState state(options, *env->engine);
+
+  const auto load_start = Clock::now();
+  if (!load(state)) {
+    std::cerr << "load phase failed\n";
+    return 1;
+  }
+  const auto load_time = Clock::now() - load_start;
+
+  std::vector<std::thread> terminals;
+  for (size_t t = 0; t < options.threads; ++t) {
+    terminals.emplace_back([&state, t] { Terminal(state, t).run(); });
+  }
+
+  std::this_thread::sleep_for(options.warmup);
+  state.recording.store(true, std::memory_order_relaxed);
+  const auto run_start = Clock::now();
+
+  std::this_thread::sleep_for(options.duration);
+  state.recording.store(false, std::memory_order_relaxed);
+  const auto run_time = Clock::now() - run_start;
+  state.stop.store(true, std::memory_order_relaxed);
+
+  for (auto &terminal : terminals) {
+    terminal.join();
+  }
+
+  report(state, load_time, run_time);
+  return 0;
+}
+} // namespace
+} // namespace velox::bench
+
+int main(int argc, char **argv) {
+  auto options = velox::bench::parse_options(argc, argv);
+  if (!options) {
+    return 1;
+  }
+
+  return velox::bench::run(*options);
+}
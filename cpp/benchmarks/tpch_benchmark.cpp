@@ -0,0 +1,328 @@
+/**
+ * @file tpch_benchmark.cpp
+ * @author Carlos Salguero
+ * @brief TPC-H-like scan, filter, aggregate and join benchmarks
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * The scale factor is read from VELOX_TPCH_SCALE (default 0.01). The
+ * database is generated once per process into in-memory columnar tables
+ * and each query runs as an operator plan through the QueryProcessor.
+ * Bytes processed count the column buffers the plan's scans read, so
+ * GB/s reflects the columns a query touches rather than whole rows.
+ */
+
+#include "tpch_data.hpp"
+
+#include <cstdlib>
+#include <velox/query/query_processor.hpp>
+
+namespace velox::bench {
+namespace {
+using namespace tpch;
+using query::AggregateFunction;
+using query::ArithmeticOp;
+using query::CompareOp;
+
+constexpr double DEFAULT_SCALE_FACTOR = 0.01;
+
+double env_double(const char *name, double fallback) {
+  const char *value = std::getenv(name);
+  return value ? std::strtod(value, nullptr) : fallback;
+}
+
+const Database *database() {
+  static const auto db =
+      Database::load(env_double("VELOX_TPCH_SCALE", DEFAULT_SCALE_FACTOR));
+  return db.get();
+}
+
+/**
+ * @brief Scanned table together with the columns a plan reads from it
+ */
+struct ScanInput {
+  std::shared_ptr<query::ColumnarTable> table;
+  std::vector<size_t> columns;
+
+  /// @brief Create the scan operator
+  [[nodiscard]] query::OperatorPtr scan() const {
+    return std::make_unique<query::TableScan>(table, columns);
+  }
+
+  /// @brief Bytes held by the scanned columns
+  [[nodiscard]] uint64_t bytes() const {
+    uint64_t total = 0;
+    for (size_t c = 0; c < table->chunk_count(); ++c) {
+      for (auto column : columns) {
+        total += table->chunk(c).column(column).memory_usage();
+      }
+    }
+    return total;
+  }
+};
+
+/// @brief Decimal literal in the money type
+query::ExpressionPtr money_literal(int64_t cents) {
+  return query::expr::literal(money(cents));
+}
+
+/// @brief extendedprice * (1 - discount) over a schema with both columns
+query::ExpressionPtr discounted_price(const query::Schema &schema,
+                                      std::string_view price,
+                                      std::string_view discount) {
+  return *query::expr::arithmetic(
+      ArithmeticOp::MUL, *query::expr::column(schema, price),
+      *query::expr::arithmetic(ArithmeticOp::SUB, money_literal(100),
+                               *query::expr::column(schema, discount)));
+}
+
+/**
+ * @brief Run a plan per iteration, reporting rows and bytes scanned
+ *
+ * @param state Benchmark state
+ * @param plan Plan to run; reset by the processor before each execution
+ * @param inputs Scans feeding the plan, for bytes and rows processed
+ */
+void run_plan(benchmark::State &state, query::QueryPlan &plan,
+              const std::vector<ScanInput> &inputs) {
+  uint64_t bytes = 0;
+  uint64_t rows = 0;
+  for (const auto &input : inputs) {
+    bytes += input.bytes();
+    rows += input.table->row_count();
+  }
+
+  query::QueryProcessor processor;
+  size_t output_rows = 0;
+  PerfReport perf(state);
+
+  for (auto _ : state) {
+    auto result = processor.execute(plan, [&](const query::DataChunk &chunk) {
+      output_rows += chunk.size();
+      return true;
+    });
+    if (!result) {
+      state.SkipWithError("Query failed");
+      break;
+    }
+  }
+
+  state.counters["output_rows"] =
+      state.iterations() == 0
+          ? 0.0
+          : static_cast<double>(output_rows) /
+                static_cast<double>(state.iterations());
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * rows));
+  state.counters["scale_factor"] =
+      env_double("VELOX_TPCH_SCALE", DEFAULT_SCALE_FACTOR);
+}
+
+/// @brief Load the database, skipping the benchmark if that fails
+const Database *load_or_skip(benchmark::State &state) {
+  const auto *db = database();
+  if (!db) {
+    state.SkipWithError("Failed to load TPC-H database");
+  }
+  return db;
+}
+} // namespace
+
+/// Lineitem scan of the Q1 columns; the baseline for every other query
+static void BM_TpchScanLineitem(benchmark::State &state) {
+  const auto *db = load_or_skip(state);
+  if (!db) {
+    return;
+  }
+
+  const ScanInput input{db->lineitem,
+                        {lineitem::ORDERKEY, lineitem::QUANTITY,
+                         lineitem::EXTENDEDPRICE, lineitem::DISCOUNT,
+                         lineitem::TAX, lineitem::RETURNFLAG,
+                         lineitem::LINESTATUS, lineitem::SHIPDATE}};
+  query::QueryPlan plan(input.scan());
+  run_plan(state, plan, {input});
+}
+
+/// Q6: selective filter with a single sum
+static void BM_TpchQ6(benchmark::State &state) {
+  const auto *db = load_or_skip(state);
+  if (!db) {
+    return;
+  }
+
+  const ScanInput input{db->lineitem,
+                        {lineitem::SHIPDATE, lineitem::DISCOUNT,
+                         lineitem::QUANTITY, lineitem::EXTENDEDPRICE}};
+  auto scan = input.scan();
+  const auto schema = scan->schema();
+
+  auto ship = *query::expr::column(schema, "l_shipdate");
+  auto discount = *query::expr::column(schema, "l_discount");
+  auto predicate = *query::expr::conjunction(
+      query::ConjunctionOp::AND,
+      {*query::expr::compare(CompareOp::GE, ship,
+                             query::expr::literal(date(1994, 1, 1))),
+       *query::expr::compare(CompareOp::LT, ship,
+                             query::expr::literal(date(1995, 1, 1))),
+       *query::expr::between(discount, money_literal(5), money_literal(7)),
+       *query::expr::compare(CompareOp::LT,
+                             *query::expr::column(schema, "l_quantity"),
+                             money_literal(2400))});
+  auto filter =
+      std::make_unique<query::Filter>(std::move(scan), std::move(predicate));
+
+  auto revenue = *query::expr::arithmetic(
+      ArithmeticOp::MUL, *query::expr::column(schema, "l_extendedprice"),
+      discount);
+  auto project = std::make_unique<query::Projection>(
+      std::move(filter), std::vector<query::ExpressionPtr>{revenue},
+      std::vector<std::string>{"revenue"});
+
+  query::QueryPlan plan(std::make_unique<query::HashAggregate>(
+      std::move(project), std::vector<size_t>{},
+      std::vector<query::AggregateSpec>{
+          {AggregateFunction::SUM, 0, "revenue"}}));
+  run_plan(state, plan, {input});
+}
+
+/// Q1: low-cardinality group-by with several aggregates
+static void BM_TpchQ1(benchmark::State &state) {
+  const auto *db = load_or_skip(state);
+  if (!db) {
+    return;
+  }
+
+  const ScanInput input{db->lineitem,
+                        {lineitem::RETURNFLAG, lineitem::LINESTATUS,
+                         lineitem::QUANTITY, lineitem::EXTENDEDPRICE,
+                         lineitem::DISCOUNT, lineitem::TAX,
+                         lineitem::SHIPDATE}};
+  auto scan = input.scan();
+  const auto schema = scan->schema();
+
+  auto filter = std::make_unique<query::Filter>(
+      std::move(scan),
+      *query::expr::compare(
+          CompareOp::LE, *query::expr::column(schema, "l_shipdate"),
+          query::expr::literal(date(1998, 12, 1) - 90)));
+
+  auto disc_price =
+      discounted_price(schema, "l_extendedprice", "l_discount");
+  auto charge = *query::expr::arithmetic(
+      ArithmeticOp::MUL, disc_price,
+      *query::expr::arithmetic(ArithmeticOp::ADD, money_literal(100),
+                               *query::expr::column(schema, "l_tax")));
+  auto project = std::make_unique<query::Projection>(
+      std::move(filter),
+      std::vector<query::ExpressionPtr>{
+          *query::expr::column(schema, "l_returnflag"),
+          *query::expr::column(schema, "l_linestatus"),
+          *query::expr::column(schema, "l_quantity"),
+          *query::expr::column(schema, "l_extendedprice"),
+          disc_price, charge, *query::expr::column(schema, "l_discount")},
+      std::vector<std::string>{"l_returnflag", "l_linestatus", "l_quantity",
+                               "l_extendedprice", "disc_price", "charge",
+                               "l_discount"});
+
+  auto aggregate = std::make_unique<query::HashAggregate>(
+      std::move(project), std::vector<size_t>{0, 1},
+      std::vector<query::AggregateSpec>{
+          {AggregateFunction::SUM, 2, "sum_qty"},
+          {AggregateFunction::SUM, 3, "sum_base_price"},
+          {AggregateFunction::SUM, 4, "sum_disc_price"},
+          {AggregateFunction::SUM, 5, "sum_charge"},
+          {AggregateFunction::AVG, 2, "avg_qty"},
+          {AggregateFunction::AVG, 3, "avg_price"},
+          {AggregateFunction::AVG, 6, "avg_disc"},
+          {AggregateFunction::COUNT_STAR, 0, "count_order"}});
+
+  query::QueryPlan plan(std::make_unique<query::Sort>(
+      std::move(aggregate),
+      std::vector<query::SortKey>{{0, true, false}, {1, true, false}}));
+  run_plan(state, plan, {input});
+}
+
+/// Q3: customer-orders-lineitem hash join with top-10 revenue
+static void BM_TpchQ3(benchmark::State &state) {
+  const auto *db = load_or_skip(state);
+  if (!db) {
+    return;
+  }
+
+  const auto pivot = query::expr::literal(date(1995, 3, 15));
+
+  const ScanInput customer_input{db->customer,
+                            {customer::CUSTKEY, customer::MKTSEGMENT}};
+  auto customer_scan = customer_input.scan();
+  const auto customer_schema = customer_scan->schema();
+  auto building = std::make_unique<query::Filter>(
+      std::move(customer_scan),
+      *query::expr::compare(
+          CompareOp::EQ,
+          *query::expr::column(customer_schema, "c_mktsegment"),
+          query::expr::literal(std::string("BUILDING"))));
+
+  const ScanInput order_input{db->orders,
+                         {orders::ORDERKEY, orders::CUSTKEY,
+                          orders::ORDERDATE, orders::SHIPPRIORITY}};
+  auto order_scan = order_input.scan();
+  const auto order_schema = order_scan->schema();
+  auto early_orders = std::make_unique<query::Filter>(
+      std::move(order_scan),
+      *query::expr::compare(CompareOp::LT,
+                            *query::expr::column(order_schema, "o_orderdate"),
+                            pivot));
+
+  // orders(o_orderkey, o_custkey, o_orderdate, o_shippriority) + customer
+  auto customer_orders = std::make_unique<query::HashJoin>(
+      std::move(early_orders), std::move(building), std::vector<size_t>{1},
+      std::vector<size_t>{0});
+
+  const ScanInput lineitem_input{db->lineitem,
+                            {lineitem::ORDERKEY, lineitem::EXTENDEDPRICE,
+                             lineitem::DISCOUNT, lineitem::SHIPDATE}};
+  auto lineitem_scan = lineitem_input.scan();
+  const auto lineitem_schema = lineitem_scan->schema();
+  auto late_lines = std::make_unique<query::Filter>(
+      std::move(lineitem_scan),
+      *query::expr::compare(
+          CompareOp::GT, *query::expr::column(lineitem_schema, "l_shipdate"),
+          pivot));
+
+  auto join = std::make_unique<query::HashJoin>(
+      std::move(late_lines), std::move(customer_orders),
+      std::vector<size_t>{0}, std::vector<size_t>{0});
+  const auto join_schema = join->schema();
+
+  auto project = std::make_unique<query::Projection>(
+      std::move(join),
+      std::vector<query::ExpressionPtr>{
+          *query::expr::column(join_schema, "l_orderkey"),
+          *query::expr::column(join_schema, "o_orderdate"),
+          *query::expr::column(join_schema, "o_shippriority"),
+          discounted_price(join_schema, "l_extendedprice", "l_discount")},
+      std::vector<std::string>{"l_orderkey", "o_orderdate",
+                               "o_shippriority", "revenue"});
+
+  auto aggregate = std::make_unique<query::HashAggregate>(
+      std::move(project), std::vector<size_t>{0, 1, 2},
+      std::vector<query::AggregateSpec>{
+          {AggregateFunction::SUM, 3, "revenue"}});
+
+  query::QueryPlan plan(std::make_unique<query::TopN>(
+      std::move(aggregate),
+      std::vector<query::SortKey>{{3, false, false}, {1, true, false}}, 10));
+  run_plan(state, plan, {customer_input, order_input, lineitem_input});
+}
+
+BENCHMARK(BM_TpchScanLineitem)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_TpchQ6)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_TpchQ1)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_TpchQ3)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // namespace velox::bench
+
+BENCHMARK_MAIN();
@@ -0,0 +1,492 @@
+/**
+ * @file tpch_data.hpp
+ * @author Carlos Salguero
+ * @brief Deterministic TPC-H-like data generator and columnar loader
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "bench_common.hpp"
+
+#include <functional>
+#include <velox/dtypes.hpp>
+#include <velox/query/vector.hpp>
+
+namespace velox::bench::tpch {
+using dtypes::Date;
+using dtypes::Decimal;
+using dtypes::Row;
+
+/// @brief Cardinalities at scale factor 1 (TPC-H 4.2.5)
+namespace config {
+constexpr uint64_t SUPPLIERS_PER_SF = 10000;
+constexpr uint64_t PARTS_PER_SF = 200000;
+constexpr uint64_t CUSTOMERS_PER_SF = 150000;
+constexpr uint64_t ORDERS_PER_SF = 1500000;
+constexpr uint32_t NATIONS = 25;
+constexpr uint32_t REGIONS = 5;
+constexpr uint32_t MAX_LINES_PER_ORDER = 7;
+constexpr uint8_t MONEY_PRECISION = 15;
+constexpr uint8_t MONEY_SCALE = 2;
+} // namespace config
+
+/// @brief Column positions (TPC-H 1.4.1 order)
+namespace lineitem {
+constexpr size_t ORDERKEY = 0;
+constexpr size_t PARTKEY = 1;
+constexpr size_t SUPPKEY = 2;
+constexpr size_t LINENUMBER = 3;
+constexpr size_t QUANTITY = 4;
+constexpr size_t EXTENDEDPRICE = 5;
+constexpr size_t DISCOUNT = 6;
+constexpr size_t TAX = 7;
+constexpr size_t RETURNFLAG = 8;
+constexpr size_t LINESTATUS = 9;
+constexpr size_t SHIPDATE = 10;
+constexpr size_t COMMITDATE = 11;
+constexpr size_t RECEIPTDATE = 12;
+constexpr size_t SHIPINSTRUCT = 13;
+constexpr size_t SHIPMODE = 14;
+constexpr size_t COMMENT = 15;
+} // namespace lineitem
+
+namespace orders {
+constexpr size_t ORDERKEY = 0;
+constexpr size_t CUSTKEY = 1;
+constexpr size_t ORDERSTATUS = 2;
+constexpr size_t TOTALPRICE = 3;
+constexpr size_t ORDERDATE = 4;
+constexpr size_t ORDERPRIORITY = 5;
+constexpr size_t CLERK = 6;
+constexpr size_t SHIPPRIORITY = 7;
+constexpr size_t COMMENT = 8;
+} // namespace orders
+
+namespace customer {
+constexpr size_t CUSTKEY = 0;
+constexpr size_t NAME = 1;
+constexpr size_t ADDRESS = 2;
+constexpr size_t NATIONKEY = 3;
+constexpr size_t PHONE = 4;
+constexpr size_t ACCTBAL = 5;
+constexpr size_t MKTSEGMENT = 6;
+constexpr size_t COMMENT = 7;
+} // namespace customer
+
+namespace part {
+constexpr size_t PARTKEY = 0;
+constexpr size_t NAME = 1;
+constexpr size_t MFGR = 2;
+constexpr size_t BRAND = 3;
+constexpr size_t TYPE = 4;
+constexpr size_t SIZE = 5;
+constexpr size_t CONTAINER = 6;
+constexpr size_t RETAILPRICE = 7;
+constexpr size_t COMMENT = 8;
+} // namespace part
+
+/// @brief Market segments (TPC-H 4.2.2.13)
+constexpr std::array<std::string_view, 5> SEGMENTS = {
+    "AUTOMOBILE", "BUILDING", "FURNITURE", "HOUSEHOLD", "MACHINERY"};
+
+constexpr std::array<std::string_view, 5> PRIORITIES = {
+    "1-URGENT", "2-HIGH", "3-MEDIUM", "4-NOT SPECIFIED", "5-LOW"};
+
+constexpr std::array<std::string_view, 4> INSTRUCTIONS = {
+    "DELIVER IN PERSON", "COLLECT COD", "NONE", "TAKE BACK RETURN"};
+
+constexpr std::array<std::string_view, 7> SHIP_MODES = {
+    "REG AIR", "AIR", "RAIL", "SHIP", "TRUCK", "MAIL", "FOB"};
+
+constexpr std::array<std::string_view, 5> REGION_NAMES = {
+    "AFRICA", "AMERICA", "ASIA", "EUROPE", "MIDDLE EAST"};
+
+/**
+ * @brief Date from a proleptic Gregorian year, month and day
+ *
+ * @note Computed inline (days-from-civil) so the generator does not depend
+ *       on the dtypes date conversions.
+ */
+[[nodiscard]] inline Date date(int year, int month, int day) {
+  year -= month <= 2 ? 1 : 0;
+  const int era = (year >= 0 ? year : year - 399) / 400;
+  const int year_of_era = year - era * 400;
+  const int day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  const int day_of_era =
+      year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+
+  return Date(era * 146097 + day_of_era - 719468);
+}
+
+/// @brief Date helpers shared by generator and queries
+[[nodiscard]] inline Date start_date() { return date(1992, 1, 1); }
+[[nodiscard]] inline Date current_date() { return date(1995, 6, 17); }
+[[nodiscard]] inline Date end_date() { return date(1998, 12, 31); }
+
+[[nodiscard]] inline Decimal money(int64_t cents) {
+  return Decimal(cents, config::MONEY_PRECISION, config::MONEY_SCALE);
+}
+
+/// @brief Schemas matching the rows the Generator produces
+namespace schemas {
+using dtypes::TypeId;
+using dtypes::TypeInfo;
+
+[[nodiscard]] inline TypeInfo money_type() {
+  return TypeInfo(TypeId::DECIMAL, config::MONEY_PRECISION,
+                  config::MONEY_SCALE);
+}
+
+[[nodiscard]] inline query::Schema region() {
+  return {{"r_regionkey", TypeId::INTEGER},
+          {"r_name", TypeId::VARCHAR},
+          {"r_comment", TypeId::VARCHAR}};
+}
+
+[[nodiscard]] inline query::Schema nation() {
+  return {{"n_nationkey", TypeId::INTEGER},
+          {"n_name", TypeId::VARCHAR},
+          {"n_regionkey", TypeId::INTEGER},
+          {"n_comment", TypeId::VARCHAR}};
+}
+
+[[nodiscard]] inline query::Schema supplier() {
+  return {{"s_suppkey", TypeId::BIGINT},   {"s_name", TypeId::VARCHAR},
+          {"s_address", TypeId::VARCHAR},  {"s_nationkey", TypeId::INTEGER},
+          {"s_phone", TypeId::VARCHAR},    {"s_acctbal", money_type()},
+          {"s_comment", TypeId::VARCHAR}};
+}
+
+[[nodiscard]] inline query::Schema part() {
+  return {{"p_partkey", TypeId::BIGINT},     {"p_name", TypeId::VARCHAR},
+          {"p_mfgr", TypeId::VARCHAR},       {"p_brand", TypeId::VARCHAR},
+          {"p_type", TypeId::VARCHAR},       {"p_size", TypeId::INTEGER},
+          {"p_container", TypeId::VARCHAR},  {"p_retailprice", money_type()},
+          {"p_comment", TypeId::VARCHAR}};
+}
+
+[[nodiscard]] inline query::Schema customer() {
+  return {{"c_custkey", TypeId::BIGINT},     {"c_name", TypeId::VARCHAR},
+          {"c_address", TypeId::VARCHAR},    {"c_nationkey", TypeId::INTEGER},
+          {"c_phone", TypeId::VARCHAR},      {"c_acctbal", money_type()},
+          {"c_mktsegment", TypeId::VARCHAR}, {"c_comment", TypeId::VARCHAR}};
+}
+
+[[nodiscard]] inline query::Schema orders() {
+  return {{"o_orderkey", TypeId::BIGINT},
+          {"o_custkey", TypeId::BIGINT},
+          {"o_orderstatus", TypeId::VARCHAR},
+          {"o_totalprice", money_type()},
+          {"o_orderdate", TypeId::DATE},
+          {"o_orderpriority", TypeId::VARCHAR},
+          {"o_clerk", TypeId::VARCHAR},
+          {"o_shippriority", TypeId::INTEGER},
+          {"o_comment", TypeId::VARCHAR}};
+}
+
+[[nodiscard]] inline query::Schema lineitem() {
+  return {{"l_orderkey", TypeId::BIGINT},
+          {"l_partkey", TypeId::BIGINT},
+          {"l_suppkey", TypeId::BIGINT},
+          {"l_linenumber", TypeId::INTEGER},
+          {"l_quantity", money_type()},
+          {"l_extendedprice", money_type()},
+          {"l_discount", money_type()},
+          {"l_tax", money_type()},
+          {"l_returnflag", TypeId::VARCHAR},
+          {"l_linestatus", TypeId::VARCHAR},
+          {"l_shipdate", TypeId::DATE},
+          {"l_commitdate", TypeId::DATE},
+          {"l_receiptdate", TypeId::DATE},
+          {"l_shipinstruct", TypeId::VARCHAR},
+          {"l_shipmode", TypeId::VARCHAR},
+          {"l_comment", TypeId::VARCHAR}};
+}
+} // namespace schemas
+
+/// @brief Callback receiving each generated row
+using RowSink = std::function<bool(const Row &)>;
+
+/**
+ * @brief Deterministic TPC-H-like row generator
+ *
+ * @note Each table draws from its own seeded stream, so the output of one
+ *       table does not depend on whether others were generated. Keys are
+ *       dense (1..N) rather than dbgen's sparse order keys. Text columns
+ *       are random words of the spec's length, not the dbgen grammar.
+ */
+class Generator {
+public:
+  /**
+   * @brief Create a generator
+   *
+   * @param scale_factor TPC-H scale factor (1.0 ~ 6M lineitems)
+   * @param seed Base seed
+   */
+  explicit Generator(double scale_factor, uint64_t seed = 19920101)
+      : m_scale_factor(scale_factor), m_seed(seed) {}
+
+  [[nodiscard]] uint64_t supplier_count() const {
+    return scaled(config::SUPPLIERS_PER_SF);
+  }
+  [[nodiscard]] uint64_t part_count() const {
+    return scaled(config::PARTS_PER_SF);
+  }
+  [[nodiscard]] uint64_t customer_count() const {
+    return scaled(config::CUSTOMERS_PER_SF);
+  }
+  [[nodiscard]] uint64_t order_count() const {
+    return scaled(config::ORDERS_PER_SF);
+  }
+
+  bool regions(const RowSink &sink) const {
+    auto rng = stream(1);
+    for (uint32_t r = 0; r < config::REGIONS; ++r) {
+      if (!sink(Row({static_cast<int32_t>(r), std::string(REGION_NAMES[r]),
+                     text(rng, 31, 115)}))) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool nations(const RowSink &sink) const {
+    auto rng = stream(2);
+    for (uint32_t n = 0; n < config::NATIONS; ++n) {
+      if (!sink(Row({static_cast<int32_t>(n), fmt::format("NATION{:02}", n),
+                     static_cast<int32_t>(n % config::REGIONS),
+                     text(rng, 31, 114)}))) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool suppliers(const RowSink &sink) const {
+    auto rng = stream(3);
+    for (uint64_t s = 1; s <= supplier_count(); ++s) {
+      if (!sink(Row({static_cast<int64_t>(s),
+                     fmt::format("Supplier#{:09}", s), text(rng, 10, 40),
+                     nation(rng), phone(rng),
+                     money(uniform(rng, -99999, 999999)),
+                     text(rng, 25, 100)}))) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool parts(const RowSink &sink) const {
+    auto rng = stream(4);
+    for (uint64_t p = 1; p <= part_count(); ++p) {
+      const auto mfgr = uniform(rng, 1, 5);
+      if (!sink(Row({static_cast<int64_t>(p), text(rng, 20, 55),
+                     fmt::format("Manufacturer#{}", mfgr),
+                     fmt::format("Brand#{}{}", mfgr, uniform(rng, 1, 5)),
+                     text(rng, 15, 25),
+                     static_cast<int32_t>(uniform(rng, 1, 50)),
+                     text(rng, 7, 10), money(retail_price_cents(p)),
+                     text(rng, 5, 22)}))) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool customers(const RowSink &sink) const {
+    auto rng = stream(5);
+    for (uint64_t c = 1; c <= customer_count(); ++c) {
+      if (!sink(Row({static_cast<int64_t>(c),
+                     fmt::format("Customer#{:09}", c), text(rng, 10, 40),
+                     nation(rng), phone(rng),
+                     money(uniform(rng, -99999, 999999)),
+                     std::string(SEGMENTS[uniform(rng, 0, 4)]),
+                     text(rng, 29, 116)}))) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Generate orders and their line items together
+   *
+   * @param order_sink Receives orders rows
+   * @param lineitem_sink Receives lineitem rows
+   * @return false if a sink stopped generation
+   */
+  bool orders_and_lineitems(const RowSink &order_sink,
+                            const RowSink &lineitem_sink) const {
+    auto rng = stream(6);
+    const auto last_order_date = end_date() - 151;
+    const auto order_days = last_order_date - start_date();
+
+    for (uint64_t o = 1; o <= order_count(); ++o) {
+      const auto order_date =
+          start_date() + static_cast<int>(uniform(rng, 0, order_days));
+      const auto lines = uniform(rng, 1, config::MAX_LINES_PER_ORDER);
+
+      int64_t total_cents = 0;
+      size_t shipped = 0;
+      for (int64_t l = 1; l <= lines; ++l) {
+        const auto part_key = static_cast<uint64_t>(
+            uniform(rng, 1, static_cast<int64_t>(part_count())));
+        const auto quantity = uniform(rng, 1, 50);
+        const auto price_cents = quantity * retail_price_cents(part_key);
+        const auto discount = uniform(rng, 0, 10);
+        const auto tax = uniform(rng, 0, 8);
+        const auto ship_date =
+            order_date + static_cast<int>(uniform(rng, 1, 121));
+        const auto commit_date =
+            order_date + static_cast<int>(uniform(rng, 30, 90));
+        const auto receipt_date =
+            ship_date + static_cast<int>(uniform(rng, 1, 30));
+
+        const bool returned = receipt_date <= current_date();
+        const bool open = ship_date > current_date();
+        shipped += open ? 0 : 1;
+        total_cents += price_cents * (100 - discount) * (100 + tax) / 10000;
+
+        if (!lineitem_sink(Row(
+                {static_cast<int64_t>(o), static_cast<int64_t>(part_key),
+                 static_cast<int64_t>(
+                     uniform(rng, 1, static_cast<int64_t>(supplier_count()))),
+                 static_cast<int32_t>(l), money(quantity * 100),
+                 money(price_cents), money(discount), money(tax),
+                 std::string(returned ? (rng() & 1 ? "R" : "A") : "N"),
+                 std::string(open ? "O" : "F"), ship_date, commit_date,
+                 receipt_date,
+                 std::string(INSTRUCTIONS[uniform(rng, 0, 3)]),
+                 std::string(SHIP_MODES[uniform(rng, 0, 6)]),
+                 text(rng, 10, 43)}))) {
+          return false;
+        }
+      }
+
+      const char *status = shipped == 0                             ? "O"
+                           : shipped == static_cast<size_t>(lines) ? "F"
+                                                                   : "P";
+      if (!order_sink(Row(
+              {static_cast<int64_t>(o),
+               static_cast<int64_t>(
+                   uniform(rng, 1, static_cast<int64_t>(customer_count()))),
+               std::string(status), money(total_cents), order_date,
+               std::string(PRIORITIES[uniform(rng, 0, 4)]),
+               fmt::format("Clerk#{:09}", uniform(rng, 1, 1000)), int32_t{0},
+               text(rng, 19, 78)}))) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+private:
+  [[nodiscard]] uint64_t scaled(uint64_t per_sf) const {
+    return std::max<uint64_t>(
+        1, static_cast<uint64_t>(static_cast<double>(per_sf) * m_scale_factor));
+  }
+
+  [[nodiscard]] std::mt19937_64 stream(uint64_t table) const {
+    return std::mt19937_64(m_seed * 1000003 + table);
+  }
+
+  static int64_t uniform(std::mt19937_64 &rng, int64_t min, int64_t max) {
+    const auto range = static_cast<uint64_t>(max - min + 1);
+    return min + static_cast<int64_t>(rng() % range);
+  }
+
+  /// @brief Part retail price in cents (TPC-H 4.2.3)
+  static int64_t retail_price_cents(uint64_t part_key) {
+    const auto key = static_cast<int64_t>(part_key);
+    return 90000 + ((key / 10) % 20001) + 100 * (key % 1000);
+  }
+
+  static int32_t nation(std::mt19937_64 &rng) {
+    return static_cast<int32_t>(uniform(rng, 0, config::NATIONS - 1));
+  }
+
+  static std::string phone(std::mt19937_64 &rng) {
+    return fmt::format("{}-{}-{}-{}", uniform(rng, 10, 34),
+                       uniform(rng, 100, 999), uniform(rng, 100, 999),
+                       uniform(rng, 1000, 9999));
+  }
+
+  static std::string text(std::mt19937_64 &rng, size_t min, size_t max) {
+    static constexpr std::string_view ALPHABET =
+        "abcdefghijklmnopqrstuvwxyz       ";
+    std::string result(static_cast<size_t>(uniform(
+                           rng, static_cast<int64_t>(min),
+                           static_cast<int64_t>(max))),
+                       ' ');
+    for (auto &c : result) {
+      c = ALPHABET[rng() % ALPHABET.size()];
+    }
+
+    return result;
+  }
+
+  double m_scale_factor;
+  uint64_t m_seed;
+};
+
+/// @brief TPC-H-like database held in in-memory columnar tables
+struct Database {
+  std::shared_ptr<query::ColumnarTable> region;
+  std::shared_ptr<query::ColumnarTable> nation;
+  std::shared_ptr<query::ColumnarTable> supplier;
+  std::shared_ptr<query::ColumnarTable> part;
+  std::shared_ptr<query::ColumnarTable> customer;
+  std::shared_ptr<query::ColumnarTable> orders;
+  std::shared_ptr<query::ColumnarTable> lineitem;
+
+  /**
+   * @brief Generate and load a database
+   *
+   * @param scale_factor TPC-H scale factor
+   * @return Database, or nullptr if a row did not fit its table's schema
+   */
+  [[nodiscard]] static std::unique_ptr<Database> load(double scale_factor) {
+    auto db = std::make_unique<Database>();
+    db->region = std::make_shared<query::ColumnarTable>(schemas::region());
+    db->nation = std::make_shared<query::ColumnarTable>(schemas::nation());
+    db->supplier =
+        std::make_shared<query::ColumnarTable>(schemas::supplier());
+    db->part = std::make_shared<query::ColumnarTable>(schemas::part());
+    db->customer =
+        std::make_shared<query::ColumnarTable>(schemas::customer());
+    db->orders = std::make_shared<query::ColumnarTable>(schemas::orders());
+    db->lineitem =
+        std::make_shared<query::ColumnarTable>(schemas::lineitem());
+
+    const auto sink = [](query::ColumnarTable &table) {
+      return [&table](const Row &row) {
+        return table.append_row(row).has_value();
+      };
+    };
+
+    const Generator generator(scale_factor);
+    const bool ok =
+        generator.regions(sink(*db->region)) &&
+        generator.nations(sink(*db->nation)) &&
+        generator.suppliers(sink(*db->supplier)) &&
+        generator.parts(sink(*db->part)) &&
+        generator.customers(sink(*db->customer)) &&
+        generator.orders_and_lineitems(sink(*db->orders),
+                                       sink(*db->lineitem));
+
+    return ok ? std::move(db) : nullptr;
+  }
+};
+
+} // namespace velox::bench::tpch
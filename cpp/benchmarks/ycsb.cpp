@@ -0,0 +1,536 @@
+/**
+ * @file ycsb.cpp
+ * @author Carlos Salguero
+ * @brief YCSB-style workload driver for StorageEngine
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Runs the YCSB core workloads A-F against a fresh StorageEngine:
+ *
+ *   A  50% read, 50% update                  (zipfian)
+ *   B  95% read,  5% update                  (zipfian)
+ *   C 100% read                              (zipfian)
+ *   D  95% read,  5% insert                  (latest)
+ *   E  95% scan,  5% insert                  (zipfian)
+ *   F  50% read, 50% read-modify-write       (zipfian)
+ *
+ * Usage: velox_ycsb [--workload=a] [--records=100000] [--threads=1]
+ *                   [--duration=10] [--warmup=0] [--distribution=...]
+ *                   [--record-size=1000] [--pool-pages=1000]
+ *                   [--max-scan=100] [--no-wal] [--seed=42]
+ *                   [--json=results.json]
+ */
+
+#include "bench_common.hpp"
+#include "key_generators.hpp"
+
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <velox/metrics/metrics.hpp>
+
+namespace velox::bench {
+namespace {
+/// @brief Operations issued by the driver
+enum class Operation : uint8_t {
+  READ = 0,
+  UPDATE = 1,
+  INSERT = 2,
+  SCAN = 3,
+  READ_MODIFY_WRITE = 4
+};
+
+constexpr size_t OPERATION_COUNT = 5;
+
+constexpr std::string_view to_string(Operation op) noexcept {
+  switch (op) {
+  case Operation::READ:
+    return "READ";
+  case Operation::UPDATE:
+    return "UPDATE";
+  case Operation::INSERT:
+    return "INSERT";
+  case Operation::SCAN:
+    return "SCAN";
+  case Operation::READ_MODIFY_WRITE:
+    return "READ_MODIFY_WRITE";
+  }
+
+  return "UNKNOWN";
+}
+
+/// @brief Operation mix and key distribution of a workload
+struct WorkloadSpec {
+  char name{'a'};
+  std::array<double, OPERATION_COUNT> proportions{};
+  KeyDistribution distribution{KeyDistribution::ZIPFIAN};
+};
+
+std::optional<WorkloadSpec> workload_preset(char name) {
+  WorkloadSpec spec;
+  spec.name = name;
+  auto &p = spec.proportions;
+
+  switch (name) {
+  case 'a':
+    p = {0.50, 0.50, 0.0, 0.0, 0.0};
+    break;
+  case 'b':
+    p = {0.95, 0.05, 0.0, 0.0, 0.0};
+    break;
+  case 'c':
+    p = {1.0, 0.0, 0.0, 0.0, 0.0};
+    break;
+  case 'd':
+    p = {0.95, 0.0, 0.05, 0.0, 0.0};
+    spec.distribution = KeyDistribution::LATEST;
+    break;
+  case 'e':
+    p = {0.0, 0.0, 0.05, 0.95, 0.0};
+    break;
+  case 'f':
+    p = {0.50, 0.0, 0.0, 0.0, 0.50};
+    break;
+  default:
+    return std::nullopt;
+  }
+
+  return spec;
+}
+
+/// @brief Command-line options
+struct DriverOptions {
+  WorkloadSpec workload{*workload_preset('a')};
+  uint64_t records{100000};
+  size_t threads{1};
+  std::chrono::seconds duration{10};
+  std::chrono::seconds warmup{0};
+  size_t record_size{1000};
+  size_t pool_pages{storage::config::DEFAULT_BUFFER_POOL_SIZE};
+  size_t max_scan{100};
+  bool enable_wal{true};
+  uint64_t seed{42};
+  std::string json_path;
+};
+
+void print_usage() {
+  std::cerr
+      << "usage: velox_ycsb [--workload=a|b|c|d|e|f] [--records=N]\n"
+         "                  [--threads=N] [--duration=SECONDS]\n"
+         "                  [--warmup=SECONDS]\n"
+         "                  [--distribution=uniform|zipfian|latest|hotspot|\n"
+         "                                  single]\n"
+         "                  [--record-size=BYTES] [--pool-pages=N]\n"
+         "                  [--max-scan=N] [--no-wal] [--seed=N]\n"
+         "                  [--json=PATH]\n";
+}
+
+template <typename T> bool parse_number(std::string_view text, T &out) {
+  const auto *end = text.data() + text.size();
+  auto [ptr, ec] = std::from_chars(text.data(), end, out);
+  return ec == std::errc{} && ptr == end;
+}
+
+std::optional<DriverOptions> parse_options(int argc, char **argv) {
+  DriverOptions options;
+  std::optional<KeyDistribution> distribution;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    const auto eq = arg.find('=');
+    const auto key = arg.substr(0, eq);
+    const auto value =
+        eq == std::string_view::npos ? std::string_view{} : arg.substr(eq + 1);
+
+    uint64_t number = 0;
+    bool ok = true;
+
+    if (key == "--workload") {
+      auto preset =
+          value.size() == 1 ? workload_preset(value[0]) : std::nullopt;
+      ok = preset.has_value();
+      if (ok) {
+        options.workload = *preset;
+      }
+    } else if (key == "--distribution") {
+      distribution = parse_key_distribution(value);
+      ok = distribution.has_value();
+    } else if (key == "--no-wal") {
+      options.enable_wal = false;
+    } else if (key == "--json") {
+      options.json_path = std::string(value);
+      ok = !value.empty();
+    } else if (parse_number(value, number)) {
+      if (key == "--records" && number > 0) {
+        options.records = number;
+      } else if (key == "--threads" && number > 0) {
+        options.threads = number;
+      } else if (key == "--duration" && number > 0) {
+        options.duration = std::chrono::seconds(number);
+      } else if (key == "--warmup") {
+        options.warmup = std::chrono::seconds(number);
+      } else if (key == "--record-size" && number > 0 &&
+                 number <= storage::config::MAX_RECORD_SIZE) {
+        options.record_size = number;
+      } else if (key == "--pool-pages" && number > 0) {
+        options.pool_pages = number;
+      } else if (key == "--max-scan" && number > 0) {
+        options.max_scan = number;
+      } else if (key == "--seed") {
+        options.seed = number;
+      } else {
+        ok = false;
+      }
+    } else {
+      ok = false;
+    }
+
+    if (!ok) {
+      std::cerr << "invalid argument: " << arg << "\n";
+      return std::nullopt;
+    }
+  }
+
+  if (distribution) {
+    options.workload.distribution = *distribution;
+  }
+
+  return options;
+}
+
+/**
+ * @brief Maps dense YCSB keys to the record ids assigned by the engine
+ *
+ * @note Capacity is fixed up front so inserts never reallocate. A key is
+ *       visible once its record id is published; readers that pick a key
+ *       whose insert is still in flight retry within the loaded range.
+ */
+class KeySpace {
+public:
+  KeySpace(uint64_t loaded, uint64_t capacity)
+      : m_ids(capacity), m_loaded(loaded), m_next(loaded) {}
+
+  [[nodiscard]] uint64_t loaded() const noexcept { return m_loaded; }
+
+  [[nodiscard]] uint64_t key_count() const noexcept {
+    return std::min<uint64_t>(m_next.load(std::memory_order_acquire),
+                              m_ids.size());
+  }
+
+  /// @brief Claim the next key for an insert, or nullopt when full
+  [[nodiscard]] std::optional<uint64_t> claim() noexcept {
+    const auto key = m_next.fetch_add(1, std::memory_order_acq_rel);
+    return key < m_ids.size() ? std::optional<uint64_t>(key) : std::nullopt;
+  }
+
+  void publish(uint64_t key, storage::RecordId id) noexcept {
+    m_ids[key].store(id, std::memory_order_release);
+  }
+
+  /// @brief Get the record id of a key (INVALID_RECORD_ID while in flight)
+  [[nodiscard]] storage::RecordId lookup(uint64_t key) const noexcept {
+    return key < m_ids.size() ? m_ids[key].load(std::memory_order_acquire)
+                              : storage::config::INVALID_RECORD_ID;
+  }
+
+private:
+  std::vector<std::atomic<storage::RecordId>> m_ids;
+  uint64_t m_loaded;
+  std::atomic<uint64_t> m_next;
+};
+
+/// @brief Per-operation results
+struct OperationStats {
+  metrics::LatencyHistogram latency;
+  std::atomic<uint64_t> errors{0};
+};
+
+/// @brief State shared by driver threads
+struct RunState {
+  const DriverOptions &options;
+  storage::StorageEngine &engine;
+  KeySpace keys;
+  KeyChooser chooser;
+  std::array<OperationStats, OPERATION_COUNT> stats;
+  std::atomic<bool> recording{false};
+  std::atomic<bool> stop{false};
+
+  RunState(const DriverOptions &opts, storage::StorageEngine &eng)
+      : options(opts), engine(eng), keys(opts.records, opts.records * 2),
+        chooser(opts.workload.distribution, opts.records) {}
+};
+
+/// @brief One worker thread issuing operations until stopped
+class Worker {
+public:
+  Worker(RunState &state, size_t index)
+      : m_state(state), m_rng(state.options.seed + index + 1),
+        m_payload(make_payload(state.options.record_size, index)) {}
+
+  void run() {
+    while (!m_state.stop.load(std::memory_order_relaxed)) {
+      const auto op = choose_operation();
+      const auto start = Clock::now();
+      const bool ok = execute(op);
+      const auto elapsed = Clock::now() - start;
+
+      if (m_state.recording.load(std::memory_order_relaxed)) {
+        auto &stats = m_state.stats[static_cast<size_t>(op)];
+        stats.latency.record(elapsed);
+        if (!ok) {
+          stats.errors.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    }
+  }
+
+private:
+  Operation choose_operation() {
+    const auto &proportions = m_state.options.workload.proportions;
+    double u = std::uniform_real_distribution<double>(0.0, 1.0)(m_rng);
+    for (size_t i = 0; i < OPERATION_COUNT; ++i) {
+      if (u < proportions[i]) {
+        return static_cast<Operation>(i);
+      }
+      u -= proportions[i];
+    }
+
+    return Operation::READ;
+  }
+
+  storage::RecordId choose_record() {
+    const auto key = m_state.chooser.next(m_rng, m_state.keys.key_count());
+    auto id = m_state.keys.lookup(key);
+    if (id == storage::config::INVALID_RECORD_ID) {
+      id = m_state.keys.lookup(key % m_state.keys.loaded());
+    }
+
+    return id;
+  }
+
+  bool execute(Operation op) {
+    auto &engine = m_state.engine;
+
+    switch (op) {
+    case Operation::READ:
+      return engine.get_record(BENCH_TABLE, choose_record()).has_value();
+    case Operation::UPDATE:
+      return engine.update_record(BENCH_TABLE, choose_record(), m_payload)
+          .has_value();
+    case Operation::INSERT: {
+      auto key = m_state.keys.claim();
+      if (!key) {
+        return false;
+      }
+
+      auto id = engine.insert_record(BENCH_TABLE, m_payload);
+      if (!id) {
+        return false;
+      }
+
+      m_state.keys.publish(*key, *id);
+      return true;
+    }
+    case Operation::SCAN:
+      return scan();
+    case Operation::READ_MODIFY_WRITE: {
+      const auto id = choose_record();
+      auto record = engine.get_record(BENCH_TABLE, id);
+      if (!record) {
+        return false;
+      }
+
+      record->data[0] ^= 0xff;
+      return engine.update_record(BENCH_TABLE, id, record->data).has_value();
+    }
+    }
+
+    return false;
+  }
+
+  /// @note StorageEngine has no range scan yet; a scan reads consecutive
+  ///       keys starting at the chosen one, as YCSB's ordered tables do.
+  bool scan() {
+    const auto count = m_state.keys.key_count();
+    const auto start = m_state.chooser.next(m_rng, count);
+    const auto length = 1 + m_rng() % m_state.options.max_scan;
+
+    for (uint64_t key = start; key < std::min(start + length, count); ++key) {
+      const auto id = m_state.keys.lookup(key);
+      if (id == storage::config::INVALID_RECORD_ID) {
+        continue;
+      }
+
+      if (!m_state.engine.get_record(BENCH_TABLE, id)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  RunState &m_state;
+  std::mt19937_64 m_rng;
+  std::vector<uint8_t> m_payload;
+};
+
+/// @brief Insert the initial records using all threads
+bool load(RunState &state) {
+  std::atomic<bool> failed{false};
+  std::vector<std::thread> threads;
+
+  for (size_t t = 0; t < state.options.threads; ++t) {
+    threads.emplace_back([&, t] {
+      const auto payload = make_payload(state.options.record_size, t);
+      for (uint64_t key = t; key < state.options.records;
+           key += state.options.threads) {
+        auto id = state.engine.insert_record(BENCH_TABLE, payload);
+        if (!id) {
+          failed.store(true, std::memory_order_relaxed);
+          return;
+        }
+
+        state.keys.publish(key, *id);
+      }
+    });
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  return !failed.load();
+}
+
+double seconds(std::chrono::nanoseconds duration) {
+  return std::chrono::duration<double>(duration).count();
+}
+
+double micros(uint64_t nanos) { return static_cast<double>(nanos) / 1000.0; }
+
+void report(const RunState &state, std::chrono::nanoseconds load_time,
+            std::chrono::nanoseconds run_time) {
+  const auto &options = state.options;
+  fmt::print("VeloxDB YCSB workload {} ({}), {} threads, {} records, "
+             "{} B records, {} pool pages, WAL {}\n",
+             options.workload.name, to_string(options.workload.distribution),
+             options.threads, options.records, options.record_size,
+             options.pool_pages, options.enable_wal ? "on" : "off");
+  fmt::print("[LOAD] {} records in {:.2f} s ({:.0f} ops/s)\n", options.records,
+             seconds(load_time),
+             static_cast<double>(options.records) / seconds(load_time));
+
+  uint64_t total = 0;
+  std::array<metrics::HistogramSnapshot, OPERATION_COUNT> snapshots;
+  for (size_t i = 0; i < OPERATION_COUNT; ++i) {
+    snapshots[i] = state.stats[i].latency.snapshot();
+    total += snapshots[i].count;
+  }
+
+  fmt::print("[RUN] {} operations in {:.2f} s ({:.0f} ops/s)\n", total,
+             seconds(run_time),
+             static_cast<double>(total) / seconds(run_time));
+  fmt::print("{:<18} {:>10} {:>8} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10}\n",
+             "operation", "count", "errors", "mean_us", "p50_us", "p95_us",
+             "p99_us", "p999_us", "max_us");
+
+  for (size_t i = 0; i < OPERATION_COUNT; ++i) {
+    const auto &s = snapshots[i];
+    if (s.count == 0) {
+      continue;
+    }
+
+    fmt::print("{:<18} {:>10} {:>8} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f} "
+               "{:>10.1f} {:>10.1f}\n",
+               to_string(static_cast<Operation>(i)), s.count,
+               state.stats[i].errors.load(), s.mean() / 1000.0,
+               micros(s.percentile(0.50)), micros(s.percentile(0.95)),
+               micros(s.percentile(0.99)), micros(s.percentile(0.999)),
+               micros(s.max));
+  }
+
+  if (options.json_path.empty()) {
+    return;
+  }
+
+  std::ofstream out(options.json_path);
+  out << fmt::format(
+      R"({{"workload":"{}","distribution":"{}","threads":{},"records":{},)"
+      R"("record_size":{},"pool_pages":{},"wal":{},"run_seconds":{:.3f},)"
+      R"("throughput":{:.1f},"operations":[)",
+      options.workload.name, to_string(options.workload.distribution),
+      options.threads, options.records, options.record_size,
+      options.pool_pages, options.enable_wal, seconds(run_time),
+      static_cast<double>(total) / seconds(run_time));
+
+  bool first = true;
+  for (size_t i = 0; i < OPERATION_COUNT; ++i) {
+    const auto &s = snapshots[i];
+    if (s.count == 0) {
+      continue;
+    }
+
+    out << fmt::format(
+        R"({}{{"name":"{}","count":{},"errors":{},"mean_ns":{:.1f},)"
+        R"("p50_ns":{},"p95_ns":{},"p99_ns":{},"p999_ns":{},"max_ns":{}}})",
+        first ? "" : ",", to_string(static_cast<Operation>(i)), s.count,
+        state.stats[i].errors.load(), s.mean(), s.percentile(0.50),
+        s.percentile(0.95), s.percentile(0.99), s.percentile(0.999), s.max);
+    first = false;
+  }
+
+  out << "]}\n";
+}
+
+int run(const DriverOptions &options) {
+  auto env = EngineEnvironment::create(options.pool_pages, options.enable_wal);
+  if (!env || !env->engine->create_table(BENCH_TABLE)) {
+    std::cerr << "failed to initialize storage engine\n";
+    return 1;
+  }
+
+  RunState state(options, *env->engine);
+
+  const auto load_start = Clock::now();
+  if (!load(state)) {
+    std::cerr << "load phase failed\n";
+    return 1;
+  }
+  const auto load_time = Clock::now() - load_start;
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < options.threads; ++t) {
+    threads.emplace_back([&state, t] { Worker(state, t).run(); });
+  }
+
+  std::this_thread::sleep_for(options.warmup);
+  state.recording.store(true, std::memory_order_relaxed);
+  const auto run_start = Clock::now();
+
+  std::this_thread::sleep_for(options.duration);
+  state.recording.store(false, std::memory_order_relaxed);
+  const auto run_time = Clock::now() - run_start;
+  state.stop.store(true, std::memory_order_relaxed);
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  report(state, load_time, run_time);
+  return 0;
+}
+} // namespace
+} // namespace velox::bench
+
+int main(int argc, char **argv) {
+  auto options = velox::bench::parse_options(argc, argv);
+  if (!options) {
+    velox::bench::print_usage();
+    return 1;
+  }
+
+  return velox::bench::run(*options);
+}
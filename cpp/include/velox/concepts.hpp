@@ -331,4 +331,4 @@ concept DatabaseValue = requires {
 #define VELOX_REQUIRE_PAGE(T)                                                  \
   static_assert(velox::concepts::Page<T>, #T " must be a page type")
 #define VELOX_REQUIRE_THREAD_SAFE(T)                                           \
-  static_assert(velox::concepts::ThreadSafe<T>, #T " must be thread-safe")
\ No newline at end of file
+  static_assert(velox::concepts::ThreadSafe<T>, #T " must be thread-safe")
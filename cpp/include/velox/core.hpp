@@ -174,6 +174,7 @@ enum class ErrorCode : uint32_t {
   SEMANTIC_ERROR = 302,
   TYPE_MISMATCH = 303,
   CONSTRAINT_VIOLATION = 304,
+  NUMERIC_OVERFLOW = 305,
 
   // Network errors (400-499)
   NETWORK_ERROR = 400,
@@ -239,6 +240,8 @@ enum class ErrorCode : uint32_t {
     return "TYPE_MISMATCH";
   case ErrorCode::CONSTRAINT_VIOLATION:
     return "CONSTRAINT_VIOLATION";
+  case ErrorCode::NUMERIC_OVERFLOW:
+    return "NUMERIC_OVERFLOW";
   case ErrorCode::NETWORK_ERROR:
     return "NETWORK_ERROR";
   case ErrorCode::CONNECTION_FAILED:
@@ -282,14 +285,20 @@ template <typename T> [[nodiscard]] constexpr Result<T> error(ErrorCode code) {
 /// @brief Logging utilities
 namespace log {
 
+/// @brief Level used until initialize() or set_level() chooses another
+constexpr spdlog::level::level_enum DEFAULT_LEVEL = spdlog::level::info;
+
+/// @brief Message pattern used when initialize() is not given one
+constexpr std::string_view DEFAULT_PATTERN =
+    "[%Y-%m-%d %H:%M:%S.%e] [%n] [%l] %v";
+
 /// @brief Get logger for a component
 [[nodiscard]] std::shared_ptr<spdlog::logger>
 get_logger(const std::string &name);
 
 /// @brief Initialize logging system
-void initialize(
-    spdlog::level::level_enum level = spdlog::level::info,
-    const std::string &pattern = "[%Y-%m-%d %H:%M:%S.%e] [%n] [%l] %v");
+void initialize(spdlog::level::level_enum level = DEFAULT_LEVEL,
+                const std::string &pattern = std::string(DEFAULT_PATTERN));
 
 /// @brief Set global log level
 void set_level(spdlog::level::level_enum level);
@@ -380,7 +389,7 @@ struct SystemConfig {
   bool enable_wal = true;
   bool enable_checksums = true;
   bool enable_compression = false;
-  spdlog::level::level_enum log_level = spdlog::level::info;
+  spdlog::level::level_enum log_level = log::DEFAULT_LEVEL;
 
   /// @brief Validate configuration
   [[nodiscard]] bool validate() const noexcept;
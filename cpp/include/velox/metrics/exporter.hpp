@@ -0,0 +1,148 @@
+/**
+ * @file exporter.hpp
+ * @author Carlos Salguero
+ * @brief Prometheus text exposition and local scrape endpoint
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <velox/core.hpp>
+#include <velox/metrics/latch.hpp>
+#include <velox/metrics/metrics.hpp>
+#include <velox/storage/storage_engine.hpp>
+
+namespace velox::metrics {
+/**
+ * @brief Render a metrics snapshot in Prometheus text format
+ *
+ * @param snapshot Snapshot to render
+ * @return Exposition text
+ * @note Histograms named *_ns are exported as summaries in seconds
+ *       (p50/p90/p99/p999 plus _sum and _count)
+ */
+[[nodiscard]] std::string to_prometheus(const MetricsSnapshot &snapshot);
+
+/**
+ * @brief Render storage statistics in Prometheus text format
+ *
+ * @param stats Statistics to render
+ * @return Exposition text
+ */
+[[nodiscard]] std::string
+to_prometheus(const storage::StorageStatistics &stats);
+
+/**
+ * @brief Render latch contention statistics in Prometheus text format
+ *
+ * @param latches Latch snapshots to render
+ * @return Exposition text
+ */
+[[nodiscard]] std::string
+to_prometheus(std::span<const LatchSnapshot> latches);
+
+/// @brief Configuration for the metrics exporter
+struct ExporterConfig {
+  bool enable_server{true};               ///< Serve the scrape endpoint
+  std::string bind_address{"127.0.0.1"};  ///< 127.0.0.1, ::1 or localhost
+  uint16_t port{9464};                    ///< TCP port, 0 picks a free one
+  std::filesystem::path unix_socket_path; ///< Serve on a UDS instead of TCP
+  std::filesystem::path dump_file;        ///< Periodic dump target
+  std::chrono::seconds dump_interval{0};  ///< Dump period, 0 disables
+
+  /// @brief Validate configuration
+  /// @return true if configuration is valid
+  /// @note A TCP endpoint must bind to loopback; other addresses are rejected
+  [[nodiscard]] bool is_valid() const noexcept;
+};
+
+/// @brief Callback supplying current storage statistics
+using StatisticsProvider = std::function<storage::StorageStatistics()>;
+
+/**
+ * @brief Serves metrics over HTTP and dumps them to a file periodically
+ *
+ * @note Serving runs on its own thread. Rendering only reads atomics from
+ *       the registry, so scrapes never block instrumented hot paths.
+ */
+class MetricsExporter {
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param config Exporter configuration
+   * @param registry Registry to export
+   */
+  explicit MetricsExporter(ExporterConfig config,
+                           MetricsRegistry &registry = global_registry());
+
+  /// @brief Destructor (stops the exporter)
+  ~MetricsExporter();
+
+  /// @brief Non-copyable, non-movable
+  MetricsExporter(const MetricsExporter &) = delete;
+  MetricsExporter &operator=(const MetricsExporter &) = delete;
+  MetricsExporter(MetricsExporter &&) = delete;
+  MetricsExporter &operator=(MetricsExporter &&) = delete;
+
+  /**
+   * @brief Attach a storage statistics source
+   *
+   * @param provider Callback invoked on each render
+   * @note Must be called before start()
+   */
+  void set_statistics_provider(StatisticsProvider provider);
+
+  /**
+   * @brief Bind the endpoint and start the background threads
+   * @return Result indicating success or error
+   */
+  [[nodiscard]] error::VoidResult start();
+
+  /// @brief Stop serving and dumping
+  void stop();
+
+  /**
+   * @brief Check if the exporter is running
+   * @return true if started and not stopped
+   */
+  [[nodiscard]] bool is_running() const noexcept;
+
+  /**
+   * @brief Render every exported metric
+   * @return Prometheus exposition text
+   */
+  [[nodiscard]] std::string render() const;
+
+  /**
+   * @brief Write the rendered metrics to a file atomically
+   *
+   * @param file Output file path
+   * @return Result indicating success or error
+   */
+  [[nodiscard]] error::VoidResult
+  dump(const std::filesystem::path &file) const;
+
+  /**
+   * @brief Get the bound TCP port (useful when configured with port 0)
+   * @return Port, or 0 when not serving over TCP
+   */
+  [[nodiscard]] uint16_t bound_port() const noexcept;
+
+private:
+  class Impl;
+  std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace velox::metrics
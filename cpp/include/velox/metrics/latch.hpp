@@ -0,0 +1,327 @@
+/**
+ * @file latch.hpp
+ * @author Carlos Salguero
+ * @brief Instrumented latches and latch contention profiler
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <velox/concepts.hpp>
+#include <velox/core.hpp>
+#include <velox/metrics/metrics.hpp>
+#include <velox/metrics/trace.hpp>
+
+namespace velox::metrics {
+namespace config {
+/// @brief Slots in the per-latch-class contended key table
+constexpr size_t LATCH_KEY_SLOTS = 1024;
+
+/// @brief Linear probe limit before a key is folded into the overflow slot
+constexpr size_t LATCH_KEY_PROBES = 8;
+
+/// @brief Default number of keys reported per latch class
+constexpr size_t LATCH_TOP_KEYS = 16;
+} // namespace config
+
+/// @brief Well-known latch class names
+namespace latch_names {
+constexpr std::string_view PAGE = "page";
+constexpr std::string_view PLAN_CACHE = "plan_cache";
+} // namespace latch_names
+
+namespace detail {
+/// @brief Runtime switch for latch profiling (off by default)
+inline std::atomic<bool> g_latch_profiling{false};
+} // namespace detail
+
+/**
+ * @brief Check if latch profiling is enabled
+ * @return true if instrumented latches record statistics
+ */
+[[nodiscard]] inline bool is_latch_profiling_enabled() noexcept {
+  return detail::g_latch_profiling.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Enable or disable latch profiling at runtime
+ *
+ * @param enabled New profiling state
+ */
+inline void set_latch_profiling(bool enabled) noexcept {
+  detail::g_latch_profiling.store(enabled, std::memory_order_relaxed);
+}
+
+/// @brief Contention attributed to one latch key (e.g. a PageId)
+struct LatchKeySample {
+  uint64_t key{0};       ///< Key, or 0 for keys that did not fit the table
+  uint64_t contended{0}; ///< Acquisitions that had to wait
+  uint64_t wait_ns{0};   ///< Total time spent waiting
+};
+
+/// @brief Point-in-time statistics of one latch class
+struct LatchSnapshot {
+  std::string name;
+  uint64_t acquisitions{0}; ///< Acquisitions while profiling was enabled
+  uint64_t contended{0};    ///< Acquisitions that had to wait
+  uint64_t wait_ns{0};      ///< Total time spent waiting
+  HistogramSnapshot wait;   ///< Distribution of contended wait times
+  std::vector<LatchKeySample> top_keys; ///< Keys sorted by wait time
+
+  /**
+   * @brief Get the fraction of acquisitions that had to wait
+   * @return Contention ratio (0.0 - 1.0)
+   */
+  [[nodiscard]] double contention_ratio() const noexcept {
+    return acquisitions > 0 ? static_cast<double>(contended) / acquisitions
+                            : 0.0;
+  }
+};
+
+/**
+ * @brief Contention statistics shared by every latch of one class
+ *
+ * @note Contended keys are tracked in a fixed open-addressing table whose
+ *       slots are claimed with a CAS, so recording never allocates or locks.
+ */
+class LatchStats {
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param name Latch class name
+   */
+  explicit LatchStats(std::string_view name);
+
+  /// @brief Destructor
+  ~LatchStats();
+
+  VELOX_NON_COPYABLE_NON_MOVABLE(LatchStats)
+
+  /// @brief Record an uncontended acquisition
+  void record_acquire() noexcept { m_acquisitions.add(); }
+
+  /**
+   * @brief Record an acquisition that had to wait
+   *
+   * @param key Latch key (e.g. PageId), 0 if unknown
+   * @param wait_ns Time spent waiting
+   */
+  void record_contended(uint64_t key, uint64_t wait_ns) noexcept;
+
+  /**
+   * @brief Snapshot the statistics
+   *
+   * @param top_n Number of keys to report
+   * @return Latch snapshot
+   */
+  [[nodiscard]] LatchSnapshot
+  snapshot(size_t top_n = config::LATCH_TOP_KEYS) const;
+
+  /// @brief Reset all statistics
+  void reset() noexcept;
+
+  /**
+   * @brief Get the latch class name
+   * @return Name
+   */
+  [[nodiscard]] const std::string &name() const noexcept { return m_name; }
+
+private:
+  struct KeySlot;
+
+  std::string m_name;
+  Counter m_acquisitions;
+  Counter m_contended;
+  Counter m_wait_ns;
+  LatencyHistogram m_wait;
+  std::unique_ptr<KeySlot[]> m_keys;
+};
+
+/**
+ * @brief Get or create the statistics of a latch class
+ *
+ * @param name Latch class name
+ * @return Stable reference to the class statistics
+ */
+[[nodiscard]] LatchStats &latch_stats(std::string_view name);
+
+/**
+ * @brief Get the statistics shared by all page latches
+ * @return Reference to the "page" latch class
+ */
+[[nodiscard]] LatchStats &page_latch_stats();
+
+/**
+ * @brief Snapshot every latch class
+ *
+ * @param top_n Number of keys to report per class
+ * @return Snapshots sorted by total wait time, highest first
+ */
+[[nodiscard]] std::vector<LatchSnapshot>
+latch_snapshot(size_t top_n = config::LATCH_TOP_KEYS);
+
+/// @brief Reset every latch class
+void reset_latch_stats();
+
+namespace detail {
+/**
+ * @brief Acquire a latch, timing the wait if the fast path fails
+ *
+ * @param stats Class statistics
+ * @param key Latch key
+ * @param try_acquire Non-blocking acquisition
+ * @param acquire Blocking acquisition
+ */
+template <typename TryFn, typename LockFn>
+void profiled_acquire(LatchStats &stats, uint64_t key, TryFn &&try_acquire,
+                      LockFn &&acquire) {
+  if (!is_latch_profiling_enabled()) {
+    acquire();
+    return;
+  }
+
+  stats.record_acquire();
+  if (try_acquire()) {
+    return;
+  }
+
+  const auto start = Clock::now();
+  acquire();
+  const auto wait = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      Clock::now() - start);
+
+  stats.record_contended(key, static_cast<uint64_t>(wait.count()));
+  if (auto *trace = active_trace()) {
+    trace->add_span(TracePhase::LATCH_WAIT, start, wait);
+  }
+}
+} // namespace detail
+
+/**
+ * @brief std::mutex replacement that records contention
+ */
+class InstrumentedMutex {
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param stats Statistics of the latch class this mutex belongs to
+   */
+  explicit InstrumentedMutex(LatchStats &stats) noexcept : m_stats(&stats) {}
+
+  VELOX_NON_COPYABLE_NON_MOVABLE(InstrumentedMutex)
+
+  /// @brief Acquire exclusively
+  void lock() { lock(0); }
+
+  /**
+   * @brief Acquire exclusively, attributing contention to a key
+   *
+   * @param key Latch key
+   */
+  void lock(uint64_t key) {
+    detail::profiled_acquire(
+        *m_stats, key, [this] { return m_mutex.try_lock(); },
+        [this] { m_mutex.lock(); });
+  }
+
+  /**
+   * @brief Try to acquire exclusively without blocking
+   * @return true if acquired
+   */
+  [[nodiscard]] bool try_lock() { return m_mutex.try_lock(); }
+
+  /// @brief Release
+  void unlock() { m_mutex.unlock(); }
+
+private:
+  std::mutex m_mutex;
+  LatchStats *m_stats;
+};
+
+/**
+ * @brief std::shared_mutex replacement that records contention
+ */
+class InstrumentedSharedMutex {
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param stats Statistics of the latch class this latch belongs to
+   */
+  explicit InstrumentedSharedMutex(LatchStats &stats) noexcept
+      : m_stats(&stats) {}
+
+  VELOX_NON_COPYABLE_NON_MOVABLE(InstrumentedSharedMutex)
+
+  /// @brief Acquire exclusively
+  void lock() { lock(0); }
+
+  /**
+   * @brief Acquire exclusively, attributing contention to a key
+   *
+   * @param key Latch key
+   */
+  void lock(uint64_t key) {
+    detail::profiled_acquire(
+        *m_stats, key, [this] { return m_mutex.try_lock(); },
+        [this] { m_mutex.lock(); });
+  }
+
+  /**
+   * @brief Try to acquire exclusively without blocking
+   * @return true if acquired
+   */
+  [[nodiscard]] bool try_lock() { return m_mutex.try_lock(); }
+
+  /// @brief Release exclusive ownership
+  void unlock() { m_mutex.unlock(); }
+
+  /// @brief Acquire shared
+  void lock_shared() { lock_shared(0); }
+
+  /**
+   * @brief Acquire shared, attributing contention to a key
+   *
+   * @param key Latch key
+   */
+  void lock_shared(uint64_t key) {
+    detail::profiled_acquire(
+        *m_stats, key, [this] { return m_mutex.try_lock_shared(); },
+        [this] { m_mutex.lock_shared(); });
+  }
+
+  /**
+   * @brief Try to acquire shared without blocking
+   * @return true if acquired
+   */
+  [[nodiscard]] bool try_lock_shared() { return m_mutex.try_lock_shared(); }
+
+  /// @brief Release shared ownership
+  void unlock_shared() { m_mutex.unlock_shared(); }
+
+private:
+  std::shared_mutex m_mutex;
+  LatchStats *m_stats;
+};
+
+static_assert(concepts::Lock<InstrumentedMutex>,
+              "InstrumentedMutex must satisfy Lock");
+static_assert(concepts::Lock<InstrumentedSharedMutex>,
+              "InstrumentedSharedMutex must satisfy Lock");
+
+} // namespace velox::metrics
@@ -0,0 +1,496 @@
+/**
+ * @file metrics.hpp
+ * @author Carlos Salguero
+ * @brief Lock-free metrics registry with sharded counters and HDR-style
+ *        latency histograms
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <velox/concepts.hpp>
+#include <velox/core.hpp>
+
+namespace velox::metrics {
+/// @brief Constants for metric storage layout
+namespace config {
+/// @brief Number of cache-line-sized shards per counter
+constexpr size_t COUNTER_SHARDS = 16;
+
+/// @brief Number of bucket arrays per histogram
+constexpr size_t HISTOGRAM_SHARDS = 4;
+
+/// @brief Linear sub-buckets per power of two (2^5 = 32, ~3% error)
+constexpr uint32_t HISTOGRAM_SUB_BUCKET_BITS = 5;
+
+/// @brief Largest tracked magnitude; larger values land in the last bucket
+constexpr uint32_t HISTOGRAM_MAX_MAGNITUDE = 40;
+} // namespace config
+
+namespace detail {
+/// @brief Global switch checked by scoped timers before reading the clock
+inline std::atomic<bool> g_enabled{true};
+
+/**
+ * @brief Get the shard slot of the calling thread
+ *
+ * @return Stable per-thread index, assigned round-robin on first use
+ */
+[[nodiscard]] inline size_t thread_shard() noexcept {
+  static std::atomic<size_t> next{0};
+  thread_local const size_t shard =
+      next.fetch_add(1, std::memory_order_relaxed);
+
+  return shard;
+}
+} // namespace detail
+
+/**
+ * @brief Check if metric collection is enabled
+ * @return true if scoped timers should record
+ */
+[[nodiscard]] inline bool is_enabled() noexcept {
+  return detail::g_enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Enable or disable metric collection at runtime
+ *
+ * @param enabled New collection state
+ */
+inline void set_enabled(bool enabled) noexcept {
+  detail::g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Monotonic counter split across cache-line-aligned shards
+ *
+ * @note Writers touch only their own shard, so concurrent increments never
+ *       bounce a shared cache line. Reads sum all shards.
+ */
+class Counter {
+public:
+  Counter() = default;
+  VELOX_NON_COPYABLE_NON_MOVABLE(Counter)
+
+  /**
+   * @brief Increment the counter
+   *
+   * @param delta Amount to add
+   */
+  void add(uint64_t delta = 1) noexcept {
+    m_shards[detail::thread_shard() % config::COUNTER_SHARDS].value.fetch_add(
+        delta, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Get the current counter value
+   * @return Sum of all shards
+   */
+  [[nodiscard]] uint64_t value() const noexcept;
+
+  /// @brief Reset the counter to zero
+  void reset() noexcept;
+
+private:
+  struct VELOX_CACHE_ALIGNED Shard {
+    std::atomic<uint64_t> value{0};
+  };
+
+  std::array<Shard, config::COUNTER_SHARDS> m_shards;
+};
+
+/**
+ * @brief Point-in-time value that can go up and down
+ */
+class Gauge {
+public:
+  Gauge() = default;
+  VELOX_NON_COPYABLE_NON_MOVABLE(Gauge)
+
+  /**
+   * @brief Set the gauge value
+   *
+   * @param value New value
+   */
+  void set(double value) noexcept {
+    m_value.store(value, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Add to the gauge value
+   *
+   * @param delta Amount to add (may be negative)
+   */
+  void add(double delta) noexcept {
+    m_value.fetch_add(delta, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Get the current gauge value
+   * @return Current value
+   */
+  [[nodiscard]] double value() const noexcept {
+    return m_value.load(std::memory_order_relaxed);
+  }
+
+private:
+  VELOX_CACHE_ALIGNED std::atomic<double> m_value{0.0};
+};
+
+/**
+ * @brief Merged, immutable view of a histogram
+ */
+struct HistogramSnapshot {
+  std::vector<uint64_t> buckets; ///< Count per bucket index
+  uint64_t count{0};             ///< Number of recorded values
+  uint64_t sum{0};               ///< Sum of recorded values
+  uint64_t min{0};               ///< Smallest recorded value
+  uint64_t max{0};               ///< Largest recorded value
+
+  /**
+   * @brief Merge another snapshot into this one
+   *
+   * @param other Snapshot to merge
+   */
+  void merge(const HistogramSnapshot &other);
+
+  /**
+   * @brief Get the value at a quantile
+   *
+   * @param quantile Quantile in [0.0, 1.0] (e.g. 0.99 for p99)
+   * @return Highest value equivalent to the quantile's bucket, clamped to max
+   */
+  [[nodiscard]] uint64_t percentile(double quantile) const noexcept;
+
+  /**
+   * @brief Get the arithmetic mean
+   * @return Mean of recorded values, or 0.0 if empty
+   */
+  [[nodiscard]] double mean() const noexcept {
+    return count > 0 ? static_cast<double>(sum) / count : 0.0;
+  }
+};
+
+/**
+ * @brief Log-linear latency histogram in the style of HdrHistogram
+ *
+ * @note Values are bucketed by power of two and then linearly into
+ *       2^HISTOGRAM_SUB_BUCKET_BITS sub-buckets, giving a bounded relative
+ *       error. Bucket layout is fixed, so merging is a plain element-wise sum.
+ *       Values are expected in nanoseconds.
+ */
+class LatencyHistogram {
+public:
+  static constexpr uint32_t SUB_BUCKET_BITS = config::HISTOGRAM_SUB_BUCKET_BITS;
+  static constexpr uint64_t SUB_BUCKET_COUNT = uint64_t{1} << SUB_BUCKET_BITS;
+  static constexpr size_t BUCKET_COUNT =
+      (config::HISTOGRAM_MAX_MAGNITUDE - SUB_BUCKET_BITS + 2) *
+      SUB_BUCKET_COUNT;
+
+  LatencyHistogram() = default;
+  VELOX_NON_COPYABLE_NON_MOVABLE(LatencyHistogram)
+
+  /**
+   * @brief Map a value to its bucket index
+   *
+   * @param value Value to map
+   * @return Bucket index in [0, BUCKET_COUNT)
+   */
+  [[nodiscard]] static constexpr size_t bucket_index(uint64_t value) noexcept {
+    if (value < SUB_BUCKET_COUNT) {
+      return static_cast<size_t>(value);
+    }
+
+    const uint32_t magnitude = std::bit_width(value) - 1;
+    if (magnitude > config::HISTOGRAM_MAX_MAGNITUDE) {
+      return BUCKET_COUNT - 1;
+    }
+
+    const uint32_t shift = magnitude - SUB_BUCKET_BITS;
+    return static_cast<size_t>(((shift + 1) << SUB_BUCKET_BITS) +
+                               ((value >> shift) & (SUB_BUCKET_COUNT - 1)));
+  }
+
+  /**
+   * @brief Get the smallest value mapped to a bucket
+   *
+   * @param index Bucket index
+   * @return Inclusive lower bound
+   */
+  [[nodiscard]] static constexpr uint64_t
+  bucket_lower_bound(size_t index) noexcept {
+    if (index < SUB_BUCKET_COUNT) {
+      return index;
+    }
+
+    const uint64_t shift = (index >> SUB_BUCKET_BITS) - 1;
+    const uint64_t sub = index & (SUB_BUCKET_COUNT - 1);
+    return (SUB_BUCKET_COUNT + sub) << shift;
+  }
+
+  /**
+   * @brief Get the largest value mapped to a bucket
+   *
+   * @param index Bucket index
+   * @return Inclusive upper bound
+   */
+  [[nodiscard]] static constexpr uint64_t
+  bucket_upper_bound(size_t index) noexcept {
+    if (index < SUB_BUCKET_COUNT) {
+      return index;
+    }
+
+    const uint64_t shift = (index >> SUB_BUCKET_BITS) - 1;
+    return bucket_lower_bound(index) + (uint64_t{1} << shift) - 1;
+  }
+
+  /**
+   * @brief Record a value
+   *
+   * @param value Value to record (nanoseconds for latencies)
+   */
+  void record(uint64_t value) noexcept {
+    auto &shard =
+        m_shards[detail::thread_shard() % config::HISTOGRAM_SHARDS];
+
+    shard.buckets[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(value, std::memory_order_relaxed);
+
+    auto current_min = shard.min.load(std::memory_order_relaxed);
+    while (value < current_min &&
+           !shard.min.compare_exchange_weak(current_min, value,
+                                            std::memory_order_relaxed)) {
+    }
+
+    auto current_max = shard.max.load(std::memory_order_relaxed);
+    while (value > current_max &&
+           !shard.max.compare_exchange_weak(current_max, value,
+                                            std::memory_order_relaxed)) {
+    }
+  }
+
+  /**
+   * @brief Record a duration
+   *
+   * @param duration Duration to record, stored as nanoseconds
+   */
+  template <concepts::Duration D> void record(D duration) noexcept {
+    auto nanos =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    record(static_cast<uint64_t>(nanos > 0 ? nanos : 0));
+  }
+
+  /**
+   * @brief Merge all shards into a snapshot
+   * @return Snapshot of the current contents
+   */
+  [[nodiscard]] HistogramSnapshot snapshot() const;
+
+  /// @brief Reset all buckets to zero
+  void reset() noexcept;
+
+private:
+  struct VELOX_CACHE_ALIGNED Shard {
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets{};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> min{UINT64_MAX};
+    std::atomic<uint64_t> max{0};
+  };
+
+  std::array<Shard, config::HISTOGRAM_SHARDS> m_shards;
+};
+
+static_assert(LatencyHistogram::bucket_index(
+                  LatencyHistogram::bucket_lower_bound(
+                      LatencyHistogram::BUCKET_COUNT - 1)) ==
+                  LatencyHistogram::BUCKET_COUNT - 1,
+              "Histogram bucket layout is inconsistent");
+
+/// @brief Named counter value
+struct CounterSample {
+  std::string name;
+  uint64_t value{0};
+};
+
+/// @brief Named gauge value
+struct GaugeSample {
+  std::string name;
+  double value{0.0};
+};
+
+/// @brief Named histogram snapshot
+struct HistogramSample {
+  std::string name;
+  HistogramSnapshot data;
+};
+
+/// @brief Point-in-time copy of every registered metric
+struct MetricsSnapshot {
+  SystemTimePoint taken_at;
+  std::vector<CounterSample> counters;
+  std::vector<GaugeSample> gauges;
+  std::vector<HistogramSample> histograms;
+
+  /**
+   * @brief Find a histogram by name
+   *
+   * @param name Metric name
+   * @return Pointer to the sample, or nullptr if not present
+   */
+  [[nodiscard]] const HistogramSample *
+  find_histogram(std::string_view name) const noexcept;
+};
+
+/**
+ * @brief Registry of named metrics
+ *
+ * @note Lookup takes a shared lock, so hot paths should resolve handles once
+ *       (get_counter/get_histogram) and keep the returned reference; metric
+ *       objects are never moved or destroyed while the registry lives.
+ */
+class MetricsRegistry {
+public:
+  MetricsRegistry() = default;
+  VELOX_NON_COPYABLE_NON_MOVABLE(MetricsRegistry)
+
+  /**
+   * @brief Get or create a counter
+   *
+   * @param name Metric name
+   * @return Stable reference to the counter
+   */
+  [[nodiscard]] Counter &get_counter(std::string_view name);
+
+  /**
+   * @brief Get or create a gauge
+   *
+   * @param name Metric name
+   * @return Stable reference to the gauge
+   */
+  [[nodiscard]] Gauge &get_gauge(std::string_view name);
+
+  /**
+   * @brief Get or create a histogram
+   *
+   * @param name Metric name
+   * @return Stable reference to the histogram
+   */
+  [[nodiscard]] LatencyHistogram &get_histogram(std::string_view name);
+
+  // concepts::MetricsCollector interface
+  /**
+   * @brief Add to a counter by name
+   *
+   * @param name Metric name
+   * @param value Non-negative amount to add (fraction is truncated)
+   */
+  void counter(std::string_view name, double value);
+
+  /**
+   * @brief Set a gauge by name
+   *
+   * @param name Metric name
+   * @param value New value
+   */
+  void gauge(std::string_view name, double value);
+
+  /**
+   * @brief Record a histogram value by name
+   *
+   * @param name Metric name
+   * @param value Value to record (nanoseconds for latencies)
+   */
+  void histogram(std::string_view name, double value);
+
+  /**
+   * @brief Snapshot every registered metric
+   * @return Metrics snapshot sorted by name
+   */
+  [[nodiscard]] MetricsSnapshot get_metrics() const;
+
+  /// @brief Reset every registered metric to zero
+  void reset();
+
+private:
+  template <typename T>
+  using MetricMap = std::map<std::string, std::unique_ptr<T>, std::less<>>;
+
+  template <typename T>
+  T &get_or_create(MetricMap<T> &metrics, std::string_view name);
+
+  mutable std::shared_mutex m_mutex;
+  MetricMap<Counter> m_counters;
+  MetricMap<Gauge> m_gauges;
+  MetricMap<LatencyHistogram> m_histograms;
+};
+
+static_assert(concepts::MetricsCollector<MetricsRegistry>,
+              "MetricsRegistry must satisfy MetricsCollector");
+
+/**
+ * @brief Get the process-wide metrics registry
+ * @return Reference to the global registry
+ */
+[[nodiscard]] MetricsRegistry &global_registry();
+
+/**
+ * @brief RAII timer recording elapsed time into a histogram
+ *
+ * @note Does not read the clock when collection is disabled
+ */
+class ScopedLatency {
+public:
+  /**
+   * @brief Start timing
+   *
+   * @param histogram Histogram receiving the elapsed nanoseconds
+   */
+  explicit ScopedLatency(LatencyHistogram &histogram) noexcept
+      : m_histogram(is_enabled() ? &histogram : nullptr) {
+    if (m_histogram) {
+      m_start = Clock::now();
+    }
+  }
+
+  /// @brief Stop timing and record
+  ~ScopedLatency() {
+    if (m_histogram) {
+      m_histogram->record(Clock::now() - m_start);
+    }
+  }
+
+  VELOX_NON_COPYABLE_NON_MOVABLE(ScopedLatency)
+
+private:
+  LatencyHistogram *m_histogram;
+  TimePoint m_start{};
+};
+
+/// @brief Well-known metric names
+namespace names {
+constexpr std::string_view QUERY_EXECUTE = "velox_query_execute_ns";
+constexpr std::string_view QUERY_ROWS = "velox_query_rows";
+constexpr std::string_view QUERY_SPILL_BYTES = "velox_query_spill_bytes";
+constexpr std::string_view QUERY_CHUNKS_SKIPPED =
+    "velox_query_chunks_skipped";
+} // namespace names
+
+} // namespace velox::metrics
@@ -0,0 +1,216 @@
+/**
+ * @file perf_counters.hpp
+ * @author Carlos Salguero
+ * @brief Per-thread hardware performance counters via perf_event_open
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+#include <velox/core.hpp>
+
+namespace velox::metrics {
+/// @brief Hardware events sampled by PerfCounters
+enum class PerfEvent : uint8_t {
+  CYCLES = 0,        ///< CPU cycles
+  INSTRUCTIONS = 1,  ///< Retired instructions
+  LLC_MISSES = 2,    ///< Last-level cache misses
+  BRANCH_MISSES = 3, ///< Mispredicted branches
+  DTLB_MISSES = 4    ///< Data TLB read misses
+};
+
+/// @brief Number of PerfEvent values
+constexpr size_t PERF_EVENT_COUNT = 5;
+
+/// @brief Convert PerfEvent to string
+[[nodiscard]] constexpr std::string_view to_string(PerfEvent event) noexcept {
+  switch (event) {
+  case PerfEvent::CYCLES:
+    return "cycles";
+  case PerfEvent::INSTRUCTIONS:
+    return "instructions";
+  case PerfEvent::LLC_MISSES:
+    return "llc_misses";
+  case PerfEvent::BRANCH_MISSES:
+    return "branch_misses";
+  case PerfEvent::DTLB_MISSES:
+    return "dtlb_misses";
+  }
+
+  return "unknown";
+}
+
+/**
+ * @brief Counter values for a set of hardware events
+ *
+ * @note Events the kernel or CPU does not support are absent from
+ *       valid_mask and read as zero.
+ */
+struct PerfSample {
+  std::array<uint64_t, PERF_EVENT_COUNT> values{};
+  uint8_t valid_mask{0};
+
+  /**
+   * @brief Check if an event was captured
+   *
+   * @param event Event to check
+   * @return true if the value is meaningful
+   */
+  [[nodiscard]] constexpr bool has(PerfEvent event) const noexcept {
+    return (valid_mask >> static_cast<uint8_t>(event)) & 1;
+  }
+
+  /**
+   * @brief Get an event value
+   *
+   * @param event Event to read
+   * @return Counter value (0 if not captured)
+   */
+  [[nodiscard]] constexpr uint64_t get(PerfEvent event) const noexcept {
+    return values[static_cast<size_t>(event)];
+  }
+
+  /**
+   * @brief Get instructions per cycle
+   * @return IPC, or 0.0 if cycles or instructions were not captured
+   */
+  [[nodiscard]] constexpr double ipc() const noexcept {
+    if (!has(PerfEvent::CYCLES) || !has(PerfEvent::INSTRUCTIONS) ||
+        get(PerfEvent::CYCLES) == 0) {
+      return 0.0;
+    }
+
+    return static_cast<double>(get(PerfEvent::INSTRUCTIONS)) /
+           static_cast<double>(get(PerfEvent::CYCLES));
+  }
+
+  /// @brief Difference between two cumulative readings
+  [[nodiscard]] constexpr PerfSample
+  operator-(const PerfSample &start) const noexcept {
+    PerfSample delta;
+    delta.valid_mask = valid_mask & start.valid_mask;
+    for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+      delta.values[i] =
+          values[i] >= start.values[i] ? values[i] - start.values[i] : 0;
+    }
+
+    return delta;
+  }
+
+  /// @brief Accumulate another sample
+  constexpr PerfSample &operator+=(const PerfSample &other) noexcept {
+    valid_mask |= other.valid_mask;
+    for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+      values[i] += other.values[i];
+    }
+
+    return *this;
+  }
+};
+
+/**
+ * @brief Group of hardware counters bound to the constructing thread
+ *
+ * @note Opens one perf_event group (excluding kernel and hypervisor time)
+ *       for the calling thread. Values are scaled when the kernel
+ *       multiplexes counters. On non-Linux systems, or when
+ *       perf_event_paranoid forbids access, is_available() returns false.
+ */
+class PerfCounters {
+public:
+  /// @brief Open and enable the counters for the calling thread
+  PerfCounters();
+
+  /// @brief Close the counters
+  ~PerfCounters();
+
+  VELOX_NON_COPYABLE_NON_MOVABLE(PerfCounters)
+
+  /**
+   * @brief Check if at least one counter could be opened
+   * @return true if readings are meaningful
+   */
+  [[nodiscard]] bool is_available() const noexcept { return m_leader_fd >= 0; }
+
+  /**
+   * @brief Read the cumulative counter values
+   * @return Current values (empty sample if unavailable)
+   */
+  [[nodiscard]] PerfSample read() const noexcept;
+
+private:
+  int m_leader_fd{-1};
+  std::array<int, PERF_EVENT_COUNT> m_fds;
+  std::array<uint8_t, PERF_EVENT_COUNT> m_group_order{}; ///< Read index
+  size_t m_group_size{0};
+};
+
+namespace detail {
+/// @brief Runtime switch for attaching perf counters to traces
+inline std::atomic<bool> g_perf_sampling{false};
+} // namespace detail
+
+/**
+ * @brief Check if traces capture hardware counters
+ * @return true if perf sampling is enabled
+ */
+[[nodiscard]] inline bool is_perf_sampling_enabled() noexcept {
+  return detail::g_perf_sampling.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Enable or disable hardware counters on sampled traces
+ *
+ * @param enabled New sampling state
+ */
+inline void set_perf_sampling(bool enabled) noexcept {
+  detail::g_perf_sampling.store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Get the counters of the calling thread, opening them on first use
+ * @return Thread's counters, or nullptr if unavailable
+ */
+[[nodiscard]] const PerfCounters *thread_perf_counters();
+
+/**
+ * @brief RAII scope accumulating counter deltas into a sample
+ */
+class PerfScope {
+public:
+  /**
+   * @brief Start measuring on the calling thread
+   *
+   * @param out Sample receiving the delta on destruction
+   */
+  explicit PerfScope(PerfSample &out)
+      : m_out(out), m_counters(thread_perf_counters()) {
+    if (m_counters) {
+      m_start = m_counters->read();
+    }
+  }
+
+  /// @brief Stop measuring and accumulate
+  ~PerfScope() {
+    if (m_counters) {
+      m_out += m_counters->read() - m_start;
+    }
+  }
+
+  VELOX_NON_COPYABLE_NON_MOVABLE(PerfScope)
+
+private:
+  PerfSample &m_out;
+  const PerfCounters *m_counters;
+  PerfSample m_start;
+};
+
+} // namespace velox::metrics
@@ -0,0 +1,374 @@
+/**
+ * @file trace.hpp
+ * @author Carlos Salguero
+ * @brief Sampled per-operation latency breakdown tracing
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <velox/core.hpp>
+#include <velox/metrics/perf_counters.hpp>
+
+namespace velox::metrics {
+/// @brief Phases an operation's elapsed time is attributed to
+enum class TracePhase : uint8_t {
+  CATALOG_LOOKUP = 0, ///< Table/catalog resolution
+  BUFFER_HIT = 1,     ///< Page found in the buffer pool
+  BUFFER_MISS = 2,    ///< Buffer pool miss handling (excluding I/O)
+  IO_WAIT = 3,        ///< Waiting on page reads or writes
+  LATCH_WAIT = 4,     ///< Waiting to acquire a page or engine latch
+  WAL_WAIT = 5,       ///< Waiting to append to the write-ahead log
+  FSYNC = 6           ///< Waiting on fsync/fdatasync
+};
+
+/// @brief Number of TracePhase values
+constexpr size_t TRACE_PHASE_COUNT = 7;
+
+/// @brief Convert TracePhase to string
+[[nodiscard]] constexpr std::string_view to_string(TracePhase phase) noexcept {
+  switch (phase) {
+  case TracePhase::CATALOG_LOOKUP:
+    return "catalog_lookup";
+  case TracePhase::BUFFER_HIT:
+    return "buffer_hit";
+  case TracePhase::BUFFER_MISS:
+    return "buffer_miss";
+  case TracePhase::IO_WAIT:
+    return "io_wait";
+  case TracePhase::LATCH_WAIT:
+    return "latch_wait";
+  case TracePhase::WAL_WAIT:
+    return "wal_wait";
+  case TracePhase::FSYNC:
+    return "fsync";
+  }
+
+  return "unknown";
+}
+
+namespace config {
+/// @brief Number of traces kept by the global ring buffer
+constexpr size_t TRACE_RING_CAPACITY = 4096;
+
+/// @brief Maximum individual phase spans kept per trace
+constexpr size_t TRACE_MAX_SPANS = 32;
+
+/// @brief Default sampling: trace 1 in N operations per thread
+constexpr uint32_t DEFAULT_TRACE_SAMPLE_RATE = 1024;
+} // namespace config
+
+/// @brief One timed interval inside a traced operation
+struct TraceSpan {
+  TracePhase phase;
+  uint64_t start_ns;    ///< Offset from the operation start
+  uint64_t duration_ns; ///< Span length
+};
+
+/**
+ * @brief Latency breakdown of a single sampled operation
+ *
+ * @note Trivially copyable so the ring buffer can publish it with a seqlock.
+ *       The operation name must point to storage with static duration.
+ */
+struct OperationTrace {
+  std::string_view operation;
+  uint64_t thread_index{0}; ///< Stable per-thread index
+  uint64_t start_ns{0};     ///< Start, relative to trace_epoch()
+  uint64_t duration_ns{0};  ///< Total elapsed time
+  std::array<uint64_t, TRACE_PHASE_COUNT> phase_ns{};
+  std::array<TraceSpan, config::TRACE_MAX_SPANS> spans{};
+  uint32_t span_count{0};
+  uint32_t dropped_spans{0}; ///< Spans beyond TRACE_MAX_SPANS (still summed)
+  PerfSample perf;           ///< Hardware counters, if perf sampling is on
+
+  /**
+   * @brief Get time spent in a phase
+   *
+   * @param phase Phase to query
+   * @return Accumulated nanoseconds
+   */
+  [[nodiscard]] uint64_t phase_time(TracePhase phase) const noexcept {
+    return phase_ns[static_cast<size_t>(phase)];
+  }
+
+  /**
+   * @brief Get time not attributed to any phase (CPU work)
+   * @return Unattributed nanoseconds
+   */
+  [[nodiscard]] uint64_t unattributed_ns() const noexcept;
+
+  /**
+   * @brief Attribute time to a phase
+   *
+   * @param phase Phase to charge
+   * @param start Span start
+   * @param duration Span length, including nested spans
+   * @param nested Part of duration already charged to nested spans
+   *
+   * @note Only the exclusive time (duration - nested) is added to the phase,
+   *       so the breakdown never double counts. The full duration is charged
+   *       as nested time to the enclosing PhaseScope, if any.
+   */
+  void add_span(TracePhase phase, TimePoint start,
+                std::chrono::nanoseconds duration,
+                std::chrono::nanoseconds nested =
+                    std::chrono::nanoseconds::zero()) noexcept;
+};
+
+static_assert(std::is_trivially_copyable_v<OperationTrace>,
+              "OperationTrace must be trivially copyable");
+
+/**
+ * @brief Fixed-capacity, lock-free ring of completed traces
+ *
+ * @note Writers claim slots with a fetch_add and publish through a per-slot
+ *       sequence number, overwriting the oldest entries. Readers never block
+ *       writers and skip slots that are mid-write.
+ */
+class TraceRing {
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param capacity Number of slots
+   */
+  explicit TraceRing(size_t capacity = config::TRACE_RING_CAPACITY);
+
+  /// @brief Destructor
+  ~TraceRing();
+
+  VELOX_NON_COPYABLE_NON_MOVABLE(TraceRing)
+
+  /**
+   * @brief Publish a completed trace
+   *
+   * @param trace Trace to copy into the ring
+   */
+  void push(const OperationTrace &trace) noexcept;
+
+  /**
+   * @brief Copy the currently published traces
+   * @return Traces ordered by start time
+   */
+  [[nodiscard]] std::vector<OperationTrace> snapshot() const;
+
+  /// @brief Discard every published trace
+  void clear() noexcept;
+
+  /**
+   * @brief Get the ring capacity
+   * @return Number of slots
+   */
+  [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+
+  /**
+   * @brief Get the number of traces ever pushed
+   * @return Push count, including overwritten traces
+   */
+  [[nodiscard]] uint64_t total_pushed() const noexcept {
+    return m_head.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Get the number of traces dropped due to slot collisions
+   * @return Drop count
+   */
+  [[nodiscard]] uint64_t dropped() const noexcept {
+    return m_dropped.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct Slot;
+
+  size_t m_capacity;
+  std::unique_ptr<Slot[]> m_slots;
+  VELOX_CACHE_ALIGNED std::atomic<uint64_t> m_head{0};
+  VELOX_CACHE_ALIGNED std::atomic<uint64_t> m_dropped{0};
+};
+
+/**
+ * @brief Get the process-wide trace ring
+ * @return Reference to the global ring
+ */
+[[nodiscard]] TraceRing &global_trace_ring();
+
+/**
+ * @brief Get the steady-clock origin used for trace timestamps
+ * @return Time point of first use
+ */
+[[nodiscard]] TimePoint trace_epoch() noexcept;
+
+/**
+ * @brief Set the trace sampling rate
+ *
+ * @param one_in_n Trace one in N operations per thread (0 disables tracing)
+ */
+void set_trace_sample_rate(uint32_t one_in_n) noexcept;
+
+/**
+ * @brief Get the trace sampling rate
+ * @return Current rate (0 when tracing is disabled)
+ */
+[[nodiscard]] uint32_t trace_sample_rate() noexcept;
+
+namespace detail {
+/// @brief Trace of the operation running on this thread, if sampled
+inline thread_local OperationTrace *t_active_trace = nullptr;
+
+/// @brief Nesting depth of TraceScope on this thread
+inline thread_local uint32_t t_scope_depth = 0;
+
+/// @brief Nested-time accumulator of the innermost open PhaseScope
+inline thread_local int64_t *t_phase_nested_ns = nullptr;
+
+/// @brief Operations left on this thread before the next sample
+inline thread_local uint32_t t_sample_countdown = 0;
+
+/// @brief Global sampling rate (one in N, 0 disables)
+inline std::atomic<uint32_t> g_sample_rate{config::DEFAULT_TRACE_SAMPLE_RATE};
+
+/**
+ * @brief Decide whether the next operation on this thread is sampled
+ * @return true if the operation should be traced
+ */
+[[nodiscard]] inline bool should_sample() noexcept {
+  if (t_sample_countdown > 1) {
+    --t_sample_countdown;
+    return false;
+  }
+
+  t_sample_countdown = g_sample_rate.load(std::memory_order_relaxed);
+  return t_sample_countdown != 0;
+}
+} // namespace detail
+
+/**
+ * @brief Get the trace of the current operation
+ * @return Active trace, or nullptr if the operation is not sampled
+ */
+[[nodiscard]] inline OperationTrace *active_trace() noexcept {
+  return detail::t_active_trace;
+}
+
+/**
+ * @brief RAII scope tracing one top-level operation
+ *
+ * @note Only the outermost scope on a thread decides sampling; nested
+ *       scopes fold into it. Unsampled operations cost a few thread-local
+ *       increments; the trace itself lives in a per-thread buffer.
+ */
+class TraceScope {
+public:
+  /**
+   * @brief Start tracing if this operation is sampled
+   *
+   * @param operation Operation name (string literal)
+   */
+  explicit TraceScope(std::string_view operation) noexcept {
+    if (detail::t_scope_depth++ == 0 && detail::should_sample()) {
+      begin(operation);
+    }
+  }
+
+  /// @brief Finish the trace and publish it to the global ring
+  ~TraceScope() {
+    --detail::t_scope_depth;
+    if (m_owner) {
+      finish();
+    }
+  }
+
+  VELOX_NON_COPYABLE_NON_MOVABLE(TraceScope)
+
+  /**
+   * @brief Check if this scope is recording
+   * @return true if sampled
+   */
+  [[nodiscard]] bool is_sampled() const noexcept { return m_owner; }
+
+private:
+  void begin(std::string_view operation) noexcept;
+  void finish() noexcept;
+
+  TimePoint m_start{};
+  bool m_owner{false};
+};
+
+/**
+ * @brief RAII scope charging its lifetime to a phase of the active trace
+ *
+ * @note A no-op (no clock reads) when the operation is not sampled. Scopes
+ *       nest: the phase is charged only the time not spent in inner scopes,
+ *       so an IO_WAIT inside a BUFFER_MISS is counted once.
+ */
+class PhaseScope {
+public:
+  /**
+   * @brief Start timing a phase
+   *
+   * @param phase Phase to charge
+   */
+  explicit PhaseScope(TracePhase phase) noexcept
+      : m_trace(active_trace()), m_phase(phase) {
+    if (m_trace) {
+      m_parent_nested_ns = detail::t_phase_nested_ns;
+      detail::t_phase_nested_ns = &m_nested_ns;
+      m_start = Clock::now();
+    }
+  }
+
+  /// @brief Stop timing and charge the phase its exclusive time
+  ~PhaseScope() {
+    if (m_trace) {
+      const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          Clock::now() - m_start);
+      detail::t_phase_nested_ns = m_parent_nested_ns;
+      m_trace->add_span(m_phase, m_start, elapsed,
+                        std::chrono::nanoseconds(m_nested_ns));
+    }
+  }
+
+  VELOX_NON_COPYABLE_NON_MOVABLE(PhaseScope)
+
+private:
+  OperationTrace *m_trace;
+  TracePhase m_phase;
+  TimePoint m_start{};
+  int64_t m_nested_ns{0};
+  int64_t *m_parent_nested_ns{nullptr};
+};
+
+/**
+ * @brief Render traces in the Chrome trace event format
+ *
+ * @param traces Traces to render
+ * @return JSON document loadable by chrome://tracing and Perfetto
+ */
+[[nodiscard]] std::string
+to_chrome_trace_json(std::span<const OperationTrace> traces);
+
+/**
+ * @brief Dump the global trace ring as Chrome trace JSON
+ *
+ * @param file Output file path
+ * @return Result indicating success or error
+ */
+[[nodiscard]] error::VoidResult
+dump_chrome_trace(const std::filesystem::path &file);
+
+} // namespace velox::metrics
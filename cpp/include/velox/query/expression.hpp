@@ -0,0 +1,655 @@
+/**
+ * @file expression.hpp
+ * @author Carlos Salguero
+ * @brief Vectorized scalar expressions evaluated over DataChunks
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <velox/core.hpp>
+#include <velox/dtypes.hpp>
+#include <velox/query/vector.hpp>
+
+namespace velox::query {
+/// @brief Expression node kinds
+enum class ExpressionKind : uint8_t {
+  COLUMN_REF = 0,  ///< Input column
+  CONSTANT = 1,    ///< Literal value
+  COMPARISON = 2,  ///< Binary comparison producing BOOLEAN
+  ARITHMETIC = 3,  ///< Binary arithmetic
+  CONJUNCTION = 4, ///< AND / OR over BOOLEAN children
+  NOT = 5,         ///< Logical negation
+  IS_NULL = 6,     ///< IS [NOT] NULL test
+  BETWEEN = 7,     ///< Inclusive range test against constants
+  IN_LIST = 8,     ///< Membership in a list of constants
+  LIKE = 9         ///< LIKE / ILIKE against a constant pattern
+};
+
+/// @brief Comparison operators
+enum class CompareOp : uint8_t {
+  EQ = 0,
+  NE = 1,
+  LT = 2,
+  LE = 3,
+  GT = 4,
+  GE = 5
+};
+
+/// @brief Arithmetic operators
+enum class ArithmeticOp : uint8_t { ADD = 0, SUB = 1, MUL = 2, DIV = 3 };
+
+/// @brief Conjunction operators
+enum class ConjunctionOp : uint8_t { AND = 0, OR = 1 };
+
+/// @brief LIKE patterns with string kernels: a literal anchored by %
+enum class StringMatch : uint8_t {
+  EQUALS = 0,  ///< 'abc'
+  PREFIX = 1,  ///< 'abc%'
+  SUFFIX = 2,  ///< '%abc'
+  CONTAINS = 3 ///< '%abc%'
+};
+
+/// @brief Convert CompareOp to its SQL spelling
+[[nodiscard]] constexpr std::string_view to_string(CompareOp op) noexcept {
+  switch (op) {
+  case CompareOp::EQ:
+    return "=";
+  case CompareOp::NE:
+    return "<>";
+  case CompareOp::LT:
+    return "<";
+  case CompareOp::LE:
+    return "<=";
+  case CompareOp::GT:
+    return ">";
+  case CompareOp::GE:
+    return ">=";
+  }
+  return "?";
+}
+
+/// @brief Convert ArithmeticOp to its SQL spelling
+[[nodiscard]] constexpr std::string_view to_string(ArithmeticOp op) noexcept {
+  switch (op) {
+  case ArithmeticOp::ADD:
+    return "+";
+  case ArithmeticOp::SUB:
+    return "-";
+  case ArithmeticOp::MUL:
+    return "*";
+  case ArithmeticOp::DIV:
+    return "/";
+  }
+  return "?";
+}
+
+/// @brief Convert ConjunctionOp to its SQL spelling
+[[nodiscard]] constexpr std::string_view
+to_string(ConjunctionOp op) noexcept {
+  return op == ConjunctionOp::AND ? "AND" : "OR";
+}
+
+/// @brief Convert StringMatch to string
+[[nodiscard]] constexpr std::string_view to_string(StringMatch match) noexcept {
+  switch (match) {
+  case StringMatch::EQUALS:
+    return "equals";
+  case StringMatch::PREFIX:
+    return "prefix";
+  case StringMatch::SUFFIX:
+    return "suffix";
+  case StringMatch::CONTAINS:
+    return "contains";
+  }
+  return "unknown";
+}
+
+/// @brief Operator giving the same result with the operands swapped
+[[nodiscard]] constexpr CompareOp mirror(CompareOp op) noexcept {
+  switch (op) {
+  case CompareOp::LT:
+    return CompareOp::GT;
+  case CompareOp::LE:
+    return CompareOp::GE;
+  case CompareOp::GT:
+    return CompareOp::LT;
+  case CompareOp::GE:
+    return CompareOp::LE;
+  default:
+    return op;
+  }
+}
+
+/**
+ * @brief Type both operands are converted to before a binary operation
+ *
+ * @param a Left type
+ * @param b Right type
+ * @return Common type, or nullopt if the types cannot be combined.
+ *         Strings widen to VARCHAR, integers to BIGINT, any floating
+ *         operand to DOUBLE, and integers with DECIMAL to DECIMAL at the
+ *         larger scale. NULL combines with anything.
+ */
+[[nodiscard]] std::optional<dtypes::TypeInfo>
+common_type(const dtypes::TypeInfo &a, const dtypes::TypeInfo &b);
+
+/**
+ * @brief Convert a vector to another type
+ *
+ * @param input Source vector
+ * @param target Target type
+ * @param output Receives input.size() converted rows; NULLs stay NULL
+ * @return Success, or TYPE_MISMATCH if no conversion exists
+ */
+[[nodiscard]] error::VoidResult cast(const ColumnVector &input,
+                                     const dtypes::TypeInfo &target,
+                                     ColumnVector &output);
+
+/**
+ * @brief Render a value as a SQL literal
+ *
+ * @param value Value to render
+ * @return Literal text used by to_string() and EXPLAIN, e.g. 'it''s',
+ *         DATE '1998-09-02' or X'00ff'
+ */
+[[nodiscard]] std::string format_literal(const dtypes::Value &value);
+
+/**
+ * @brief Scalar expression evaluated a chunk at a time
+ *
+ * @note Expressions are immutable once built and may be shared by several
+ *       plans and evaluated from several threads at once.
+ */
+class Expression {
+public:
+  virtual ~Expression() = default;
+
+  /// @brief Get the node kind
+  [[nodiscard]] ExpressionKind kind() const noexcept { return m_kind; }
+
+  /// @brief Get the result type
+  [[nodiscard]] const dtypes::TypeInfo &type() const noexcept {
+    return m_type;
+  }
+
+  /**
+   * @brief Evaluate over every row of a chunk
+   *
+   * @param input Input rows
+   * @param result Reset to type() and filled with input.size() rows
+   * @return Success or error code
+   */
+  [[nodiscard]] virtual error::VoidResult
+  evaluate(const DataChunk &input, ColumnVector &result) const = 0;
+
+  /// @brief Render as SQL-like text
+  [[nodiscard]] virtual std::string to_string() const = 0;
+
+protected:
+  Expression(ExpressionKind kind, dtypes::TypeInfo type)
+      : m_kind(kind), m_type(type) {}
+
+private:
+  ExpressionKind m_kind;
+  dtypes::TypeInfo m_type;
+};
+
+/// @brief Shared handle to an immutable expression
+using ExpressionPtr = std::shared_ptr<const Expression>;
+
+/// @brief Reference to an input column by position
+class ColumnRef final : public Expression {
+public:
+  ColumnRef(size_t index, std::string name, dtypes::TypeInfo type)
+      : Expression(ExpressionKind::COLUMN_REF, type), m_index(index),
+        m_name(std::move(name)) {}
+
+  [[nodiscard]] error::VoidResult
+  evaluate(const DataChunk &input, ColumnVector &result) const override;
+  [[nodiscard]] std::string to_string() const override;
+
+  /// @brief Get the input column position
+  [[nodiscard]] size_t index() const noexcept { return m_index; }
+
+  /// @brief Get the column name
+  [[nodiscard]] const std::string &name() const noexcept { return m_name; }
+
+private:
+  size_t m_index;
+  std::string m_name;
+};
+
+/// @brief Literal value
+class Constant final : public Expression {
+public:
+  /**
+   * @brief Create a literal
+   *
+   * @param value Value
+   * @param type Result type; value must be convertible to it
+   */
+  Constant(dtypes::Value value, dtypes::TypeInfo type);
+
+  [[nodiscard]] error::VoidResult
+  evaluate(const DataChunk &input, ColumnVector &result) const override;
+  [[nodiscard]] std::string to_string() const override;
+
+  /// @brief Get the value
+  [[nodiscard]] const dtypes::Value &value() const noexcept {
+    return m_value;
+  }
+
+  /// @brief Get the value as a one-row vector of type()
+  [[nodiscard]] const ColumnVector &vector() const noexcept {
+    return m_vector;
+  }
+
+private:
+  dtypes::Value m_value;
+  ColumnVector m_vector;
+};
+
+/// @brief Binary comparison; NULL if either side is NULL
+class Comparison final : public Expression {
+public:
+  Comparison(CompareOp op, ExpressionPtr left, ExpressionPtr right,
+             dtypes::TypeInfo operand_type);
+
+  [[nodiscard]] error::VoidResult
+  evaluate(const DataChunk &input, ColumnVector &result) const override;
+  [[nodiscard]] std::string to_string() const override;
+
+  /// @brief Get the operator
+  [[nodiscard]] CompareOp op() const noexcept { return m_op; }
+
+  /// @brief Get the left operand
+  [[nodiscard]] const ExpressionPtr &left() const noexcept { return m_left; }
+
+  /// @brief Get the right operand
+  [[nodiscard]] const ExpressionPtr &right() const noexcept {
+    return m_right;
+  }
+
+  /// @brief Get the type both operands are converted to
+  [[nodiscard]] const dtypes::TypeInfo &operand_type() const noexcept {
+    return m_operand_type;
+  }
+
+  /// @brief Get the right-hand literal converted to operand_type(), if any
+  [[nodiscard]] const ColumnVector *scalar() const noexcept {
+    return m_scalar ? &*m_scalar : nullptr;
+  }
+
+private:
+  CompareOp m_op;
+  ExpressionPtr m_left;
+  ExpressionPtr m_right;
+  dtypes::TypeInfo m_operand_type;
+  /// Right-hand literal pre-converted to m_operand_type, if any
+  std::optional<ColumnVector> m_scalar;
+};
+
+/// @brief Binary arithmetic; NULL if either side is NULL or on x / 0
+class Arithmetic final : public Expression {
+public:
+  Arithmetic(ArithmeticOp op, ExpressionPtr left, ExpressionPtr right,
+             dtypes::TypeInfo result_type, dtypes::TypeInfo left_type,
+             dtypes::TypeInfo right_type);
+
+  [[nodiscard]] error::VoidResult
+  evaluate(const DataChunk &input, ColumnVector &result) const override;
+  [[nodiscard]] std::string to_string() const override;
+
+  /// @brief Get the operator
+  [[nodiscard]] ArithmeticOp op() const noexcept { return m_op; }
+
+  /// @brief Get the left operand
+  [[nodiscard]] const ExpressionPtr &left() const noexcept { return m_left; }
+
+  /// @brief Get the right operand
+  [[nodiscard]] const ExpressionPtr &right() const noexcept {
+    return m_right;
+  }
+
+private:
+  ArithmeticOp m_op;
+  ExpressionPtr m_left;
+  ExpressionPtr m_right;
+  dtypes::TypeInfo m_left_type;  ///< Left operand after conversion
+  dtypes::TypeInfo m_right_type; ///< Right operand after conversion
+};
+
+/// @brief AND / OR with SQL three-valued logic
+class Conjunction final : public Expression {
+public:
+  Conjunction(ConjunctionOp op, std::vector<ExpressionPtr> children);
+
+  [[nodiscard]] error::VoidResult
+  evaluate(const DataChunk &input, ColumnVector &result) const override;
+  [[nodiscard]] std::string to_string() const override;
+
+  /// @brief Get the operator
+  [[nodiscard]] ConjunctionOp op() const noexcept { return m_op; }
+
+  /// @brief Get the operands
+  [[nodiscard]] const std::vector<ExpressionPtr> &children() const noexcept {
+    return m_children;
+  }
+
+private:
+  ConjunctionOp m_op;
+  std::vector<ExpressionPtr> m_children;
+};
+
+/// @brief Logical NOT; NULL stays NULL
+class Not final : public Expression {
+public:
+  explicit Not(ExpressionPtr child);
+
+  [[nodiscard]] error::VoidResult
+  evaluate(const DataChunk &input, ColumnVector &result) const override;
+  [[nodiscard]] std::string to_string() const override;
+
+  /// @brief Get the operand
+  [[nodiscard]] const ExpressionPtr &child() const noexcept {
+    return m_child;
+  }
+
+private:
+  ExpressionPtr m_child;
+};
+
+/// @brief IS NULL / IS NOT NULL; never NULL itself
+class IsNull final : public Expression {
+public:
+  IsNull(ExpressionPtr child, bool negated);
+
+  [[nodiscard]] error::VoidResult
+  evaluate(const DataChunk &input, ColumnVector &result) const override;
+  [[nodiscard]] std::string to_string() const override;
+
+  /// @brief Get the operand
+  [[nodiscard]] const ExpressionPtr &child() const noexcept {
+    return m_child;
+  }
+
+  /// @brief Check whether this is IS NOT NULL
+  [[nodiscard]] bool negated() const noexcept { return m_negated; }
+
+private:
+  ExpressionPtr m_child;
+  bool m_negated;
+};
+
+/// @brief low <= child <= high with constant bounds
+class Between final : public Expression {
+public:
+  /**
+   * @brief Create a range test
+   *
+   * @param child Tested expression
+   * @param low Inclusive lower bound; a Constant convertible to
+   *            operand_type
+   * @param high Inclusive upper bound; a Constant convertible to
+   *             operand_type
+   * @param operand_type Type the child and bounds are compared in
+   */
+  Between(ExpressionPtr child, ExpressionPtr low, ExpressionPtr high,
+          dtypes::TypeInfo operand_type);
+
+  [[nodiscard]] error::VoidResult
+  evaluate(const DataChunk &input, ColumnVector &result) const override;
+  [[nodiscard]] std::string to_string() const override;
+
+  /// @brief Get the tested expression
+  [[nodiscard]] const ExpressionPtr &child() const noexcept {
+    return m_child;
+  }
+
+  /// @brief Get the type the child and bounds are compared in
+  [[nodiscard]] const dtypes::TypeInfo &operand_type() const noexcept {
+    return m_operand_type;
+  }
+
+  /// @brief Get the lower bound as a one-row vector of operand_type()
+  [[nodiscard]] const ColumnVector &low() const noexcept { return m_low; }
+
+  /// @brief Get the upper bound as a one-row vector of operand_type()
+  [[nodiscard]] const ColumnVector &high() const noexcept { return m_high; }
+
+private:
+  ExpressionPtr m_child;
+  ExpressionPtr m_lower;
+  ExpressionPtr m_upper;
+  dtypes::TypeInfo m_operand_type;
+  ColumnVector m_low;
+  ColumnVector m_high;
+};
+
+/// @brief child IN (v1, v2, ...) with SQL NULL semantics
+class InList final : public Expression {
+public:
+  /**
+   * @brief Create a membership test
+   *
+   * @param child Tested expression
+   * @param values Candidates, each convertible to operand_type
+   * @param operand_type Type the child and candidates are compared in
+   */
+  InList(ExpressionPtr child, std::vector<dtypes::Value> values,
+         dtypes::TypeInfo operand_type);
+
+  [[nodiscard]] error::VoidResult
+  evaluate(const DataChunk &input, ColumnVector &result) const override;
+  [[nodiscard]] std::string to_string() const override;
+
+  /// @brief Get the tested expression
+  [[nodiscard]] const ExpressionPtr &child() const noexcept {
+    return m_child;
+  }
+
+  /// @brief Get the type the child and candidates are compared in
+  [[nodiscard]] const dtypes::TypeInfo &operand_type() const noexcept {
+    return m_operand_type;
+  }
+
+  /// @brief Get the distinct non-NULL candidates, sorted ascending
+  [[nodiscard]] const ColumnVector &list() const noexcept { return m_list; }
+
+  /// @brief Check whether a candidate is NULL (non-matches are then NULL)
+  [[nodiscard]] bool has_null() const noexcept { return m_has_null; }
+
+private:
+  ExpressionPtr m_child;
+  dtypes::TypeInfo m_operand_type;
+  std::vector<dtypes::Value> m_values;
+  ColumnVector m_list;
+  bool m_has_null{false};
+};
+
+/// @brief child [I]LIKE 'pattern'; NULL if the child is NULL
+class Like final : public Expression {
+public:
+  /**
+   * @brief Create a pattern match
+   *
+   * @param child String expression
+   * @param pattern % matches any run of bytes, _ exactly one, and a
+   *                backslash makes the next character literal
+   * @param ignore_case Match with ASCII case folding (ILIKE)
+   */
+  Like(ExpressionPtr child, std::string pattern, bool ignore_case);
+
+  [[nodiscard]] error::VoidResult
+  evaluate(const DataChunk &input, ColumnVector &result) const override;
+  [[nodiscard]] std::string to_string() const override;
+
+  /// @brief Get the tested expression
+  [[nodiscard]] const ExpressionPtr &child() const noexcept {
+    return m_child;
+  }
+
+  /// @brief Get the pattern as written
+  [[nodiscard]] const std::string &pattern() const noexcept {
+    return m_pattern;
+  }
+
+  /// @brief Check whether this is ILIKE
+  [[nodiscard]] bool ignore_case() const noexcept { return m_ignore_case; }
+
+  /// @brief Get the kernel shape, if the pattern is a literal with %
+  ///        only at its ends
+  [[nodiscard]] std::optional<StringMatch> shape() const noexcept {
+    return m_shape;
+  }
+
+  /// @brief Get the unescaped literal between the end wildcards of a
+  ///        shaped pattern
+  [[nodiscard]] std::string_view literal() const noexcept {
+    return m_literal;
+  }
+
+private:
+  ExpressionPtr m_child;
+  std::string m_pattern;
+  bool m_ignore_case;
+  std::optional<StringMatch> m_shape;
+  std::string m_literal;
+};
+
+/**
+ * @brief Type-checked expression builders
+ *
+ * @note These are the only way plans should create expressions: they
+ *       resolve result types and reject ill-typed trees up front, so
+ *       evaluate() never has to.
+ */
+namespace expr {
+/**
+ * @brief Reference a column by position
+ *
+ * @param schema Input schema
+ * @param index Column position
+ * @return Expression, or INVALID_ARGUMENT if out of range
+ */
+[[nodiscard]] error::Result<ExpressionPtr> column(const Schema &schema,
+                                                  size_t index);
+
+/**
+ * @brief Reference a column by name
+ *
+ * @param schema Input schema
+ * @param name Column name
+ * @return Expression, or SEMANTIC_ERROR if no column has that name
+ */
+[[nodiscard]] error::Result<ExpressionPtr> column(const Schema &schema,
+                                                  std::string_view name);
+
+/**
+ * @brief Create a literal of the value's own type
+ *
+ * @param value Value
+ */
+[[nodiscard]] ExpressionPtr literal(dtypes::Value value);
+
+/**
+ * @brief Create a literal of an explicit type
+ *
+ * @param value Value
+ * @param type Literal type
+ * @return Expression, or TYPE_MISMATCH if the value does not convert
+ */
+[[nodiscard]] error::Result<ExpressionPtr> literal(dtypes::Value value,
+                                                   dtypes::TypeInfo type);
+
+/**
+ * @brief Compare two expressions
+ *
+ * @return Expression, or TYPE_MISMATCH if the operands have no common type
+ */
+[[nodiscard]] error::Result<ExpressionPtr>
+compare(CompareOp op, ExpressionPtr left, ExpressionPtr right);
+
+/**
+ * @brief Combine two numeric expressions
+ *
+ * @return Expression, or TYPE_MISMATCH for non-numeric operands. Integer
+ *         operands give BIGINT, floating ones DOUBLE; DECIMAL keeps its
+ *         scale for + and -, adds scales for *, and / gives DOUBLE.
+ */
+[[nodiscard]] error::Result<ExpressionPtr>
+arithmetic(ArithmeticOp op, ExpressionPtr left, ExpressionPtr right);
+
+/**
+ * @brief AND / OR over BOOLEAN expressions
+ *
+ * @return Expression, or INVALID_ARGUMENT without children and
+ *         TYPE_MISMATCH for a non-BOOLEAN child
+ */
+[[nodiscard]] error::Result<ExpressionPtr>
+conjunction(ConjunctionOp op, std::vector<ExpressionPtr> children);
+
+/**
+ * @brief Negate a BOOLEAN expression
+ *
+ * @return Expression, or TYPE_MISMATCH for a non-BOOLEAN child
+ */
+[[nodiscard]] error::Result<ExpressionPtr> negate(ExpressionPtr child);
+
+/**
+ * @brief Inclusive range test
+ *
+ * @param child Tested expression
+ * @param low Lower bound
+ * @param high Upper bound
+ * @return Between node for non-NULL literal bounds, otherwise the
+ *         equivalent (child >= low AND child <= high); TYPE_MISMATCH if
+ *         the operands have no common type
+ */
+[[nodiscard]] error::Result<ExpressionPtr>
+between(ExpressionPtr child, ExpressionPtr low, ExpressionPtr high);
+
+/**
+ * @brief Membership test against literals
+ *
+ * @param child Tested expression
+ * @param values Candidates
+ * @return Expression, or INVALID_ARGUMENT for an empty list and
+ *         TYPE_MISMATCH if a candidate has no common type with child
+ */
+[[nodiscard]] error::Result<ExpressionPtr>
+in_list(ExpressionPtr child, std::vector<dtypes::Value> values);
+
+/**
+ * @brief Match a string expression against a LIKE pattern
+ *
+ * @param child String operand
+ * @param pattern LIKE pattern
+ * @param ignore_case Build ILIKE (ASCII case folding); without wildcards
+ *                    this is case-insensitive equality
+ * @return Expression, or TYPE_MISMATCH for a non-string child
+ */
+[[nodiscard]] error::Result<ExpressionPtr>
+like(ExpressionPtr child, std::string pattern, bool ignore_case = false);
+
+/**
+ * @brief Test for NULL
+ *
+ * @param child Operand
+ * @param negated Build IS NOT NULL instead
+ */
+[[nodiscard]] ExpressionPtr is_null(ExpressionPtr child,
+                                    bool negated = false);
+} // namespace expr
+
+} // namespace velox::query
@@ -0,0 +1,276 @@
+/**
+ * @file kernels.hpp
+ * @author Carlos Salguero
+ * @brief Runtime-dispatched SIMD filter kernels producing bitmaps and
+ *        selection vectors
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <velox/query/expression.hpp>
+#include <velox/query/vector.hpp>
+
+namespace velox::query::kernels {
+/// @brief Longest IN list compared with one broadcast per element
+constexpr size_t IN_LIST_SIMD_LIMIT = 16;
+
+/// @brief Instruction set a kernel runs with
+enum class SimdLevel : uint8_t {
+  SCALAR = 0, ///< Portable C++ loops
+  AVX2 = 1,   ///< 256-bit compares + movemask
+  AVX512 = 2  ///< 512-bit compares into mask registers (F + BW)
+};
+
+/// @brief Convert SimdLevel to string
+[[nodiscard]] constexpr std::string_view to_string(SimdLevel level) noexcept {
+  switch (level) {
+  case SimdLevel::SCALAR:
+    return "scalar";
+  case SimdLevel::AVX2:
+    return "avx2";
+  case SimdLevel::AVX512:
+    return "avx512";
+  }
+  return "unknown";
+}
+
+/// @brief Get the best level the CPU and OS support (detected once)
+[[nodiscard]] SimdLevel detected_simd_level() noexcept;
+
+/// @brief Get the level kernels currently dispatch to
+[[nodiscard]] SimdLevel simd_level() noexcept;
+
+/**
+ * @brief Cap the level kernels dispatch to
+ *
+ * @param level Requested level; clamped to detected_simd_level()
+ * @return Level actually in effect
+ * @note Process-wide; meant for benchmarks and A/B comparisons.
+ */
+SimdLevel set_simd_level(SimdLevel level) noexcept;
+
+/**
+ * @brief Value types with SIMD filter kernels
+ *
+ * @note DATE and TIMESTAMP columns are filtered through their physical
+ *       int32_t / int64_t representation, DECIMAL through its scaled int64.
+ */
+template <typename T>
+concept FilterValue =
+    std::same_as<T, int8_t> || std::same_as<T, int16_t> ||
+    std::same_as<T, int32_t> || std::same_as<T, int64_t> ||
+    std::same_as<T, float> || std::same_as<T, double>;
+
+/// @brief Get the number of 64-bit words holding one bit per row
+[[nodiscard]] constexpr size_t bitmap_words(size_t rows) noexcept {
+  return (rows + 63) / 64;
+}
+
+/**
+ * @brief Set bit i of the bitmap iff values[i] op value
+ *
+ * @param values Input values
+ * @param op Comparison operator
+ * @param value Right-hand constant
+ * @param bitmap Output, bitmap_words(values.size()) words; bits past the
+ *               last row are cleared
+ * @note Floating-point comparisons follow IEEE semantics: NaN only
+ *       satisfies <>.
+ */
+template <FilterValue T>
+void compare(std::span<const T> values, CompareOp op, T value,
+             uint64_t *bitmap) noexcept;
+
+/**
+ * @brief Set bit i of the bitmap iff low <= values[i] <= high
+ *
+ * @param values Input values
+ * @param low Inclusive lower bound
+ * @param high Inclusive upper bound
+ * @param bitmap Output, bitmap_words(values.size()) words
+ */
+template <FilterValue T>
+void between(std::span<const T> values, T low, T high,
+             uint64_t *bitmap) noexcept;
+
+/**
+ * @brief Set bit i of the bitmap iff values[i] equals an element of list
+ *
+ * @param values Input values
+ * @param list Candidate values sorted ascending; lists of up to
+ *             IN_LIST_SIMD_LIMIT values are compared with broadcasts,
+ *             longer ones by binary search
+ * @param bitmap Output, bitmap_words(values.size()) words
+ */
+template <FilterValue T>
+void in_list(std::span<const T> values, std::span<const T> list,
+             uint64_t *bitmap) noexcept;
+
+/**
+ * @brief Compact a bitmap into the indices of its set bits
+ *
+ * @param bitmap Input bitmap
+ * @param rows Number of rows the bitmap covers
+ * @param selection Output, room for rows indices
+ * @return Number of selected rows
+ */
+size_t to_selection(const uint64_t *bitmap, size_t rows,
+                    uint32_t *selection) noexcept;
+
+/**
+ * @brief AND two bitmaps word by word
+ *
+ * @param bitmap In/out bitmap
+ * @param other Bitmap ANDed into bitmap
+ * @param words Number of words
+ */
+void bitmap_and(uint64_t *bitmap, const uint64_t *other,
+                size_t words) noexcept;
+
+/**
+ * @brief Select the rows for which values[i] op value
+ *
+ * @param values Input values
+ * @param op Comparison operator
+ * @param value Right-hand constant
+ * @param selection Output, room for values.size() indices
+ * @return Number of selected rows
+ */
+template <FilterValue T>
+size_t select_compare(std::span<const T> values, CompareOp op, T value,
+                      uint32_t *selection) noexcept;
+
+/**
+ * @brief Select the rows for which low <= values[i] <= high
+ *
+ * @return Number of selected rows written to selection
+ */
+template <FilterValue T>
+size_t select_between(std::span<const T> values, T low, T high,
+                      uint32_t *selection) noexcept;
+
+/**
+ * @brief Select the rows whose value is an element of a sorted list
+ *
+ * @return Number of selected rows written to selection
+ */
+template <FilterValue T>
+size_t select_in(std::span<const T> values, std::span<const T> list,
+                 uint32_t *selection) noexcept;
+
+/**
+ * @brief Check whether a column has SIMD filter kernels
+ *
+ * @param type Physical type of the column
+ */
+[[nodiscard]] constexpr bool supports(PhysicalType type) noexcept {
+  return type != PhysicalType::BOOL && type != PhysicalType::VARLEN;
+}
+
+/**
+ * @brief Compare a column against the first row of a one-row vector
+ *
+ * @param column Column with a supported physical type, or a VARLEN
+ *               column for = and <>
+ * @param op Comparison operator
+ * @param scalar Constant of the column's physical type
+ * @param bitmap Output, bitmap_words(column.size()) words; NULL rows and
+ *               a NULL constant select nothing
+ */
+void compare(const ColumnVector &column, CompareOp op,
+             const ColumnVector &scalar, uint64_t *bitmap) noexcept;
+
+/**
+ * @brief Range-test a column against the first rows of two vectors
+ *
+ * @param column Column with a supported physical type
+ * @param low Inclusive lower bound of the column's physical type
+ * @param high Inclusive upper bound of the column's physical type
+ * @param bitmap Output; NULL rows or a NULL bound select nothing
+ */
+void between(const ColumnVector &column, const ColumnVector &low,
+             const ColumnVector &high, uint64_t *bitmap) noexcept;
+
+/**
+ * @brief Test a column for membership in a list of constants
+ *
+ * @param column Column with a supported physical type
+ * @param list Non-NULL constants of the column's physical type, sorted
+ *             ascending
+ * @param bitmap Output; NULL rows select nothing
+ */
+void in_list(const ColumnVector &column, const ColumnVector &list,
+             uint64_t *bitmap) noexcept;
+
+/**
+ * @brief Convert a bitmap to a BOOLEAN vector (one byte per row)
+ *
+ * @param bitmap Input bitmap
+ * @param rows Number of rows
+ * @param output Reset to BOOLEAN with rows non-NULL values
+ */
+void bitmap_to_mask(const uint64_t *bitmap, size_t rows,
+                    ColumnVector &output);
+
+/**
+ * @brief Convert the TRUE, non-NULL rows of a BOOLEAN vector to a bitmap
+ *
+ * @param mask BOOLEAN vector
+ * @param bitmap Output, bitmap_words(mask.size()) words
+ */
+void mask_to_bitmap(const ColumnVector &mask, uint64_t *bitmap) noexcept;
+
+// String kernels
+
+/**
+ * @brief Set bit i of the bitmap iff string i matches a pattern
+ *
+ * @param offsets Heap offsets, one more than the number of strings;
+ *                string i is heap[offsets[i], offsets[i + 1])
+ * @param heap Value bytes
+ * @param shape Predicate shape
+ * @param pattern Literal between the wildcards, without escapes
+ * @param ignore_case Compare with ASCII case folding
+ * @param bitmap Output, bitmap_words(offsets.size() - 1) words
+ * @note EQUALS, PREFIX and SUFFIX test the lengths of a register of rows
+ *       per compare and only read the bytes of rows that pass. CONTAINS
+ *       scans the whole heap for the pattern's first and last bytes and
+ *       maps hits back to rows, so short strings cost no per-row setup.
+ *       Case folding covers ASCII letters only.
+ */
+void match(std::span<const uint32_t> offsets, std::span<const char> heap,
+           StringMatch shape, std::string_view pattern, bool ignore_case,
+           uint64_t *bitmap) noexcept;
+
+/**
+ * @brief Select the strings matching a pattern
+ *
+ * @param selection Output, room for offsets.size() - 1 indices
+ * @return Number of selected rows
+ */
+size_t select_match(std::span<const uint32_t> offsets,
+                    std::span<const char> heap, StringMatch shape,
+                    std::string_view pattern, bool ignore_case,
+                    uint32_t *selection) noexcept;
+
+/**
+ * @brief Match a VARLEN column against a pattern
+ *
+ * @param column Variable-length column
+ * @param bitmap Output, bitmap_words(column.size()) words; NULL rows
+ *               select nothing
+ */
+void match(const ColumnVector &column, StringMatch shape,
+           std::string_view pattern, bool ignore_case,
+           uint64_t *bitmap) noexcept;
+
+} // namespace velox::query::kernels
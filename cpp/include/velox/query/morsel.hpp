@@ -0,0 +1,189 @@
+/**
+ * @file morsel.hpp
+ * @author Carlos Salguero
+ * @brief Morsel-driven parallel execution of scan pipelines
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+#include <velox/core.hpp>
+#include <velox/query/operators.hpp>
+#include <velox/query/vector.hpp>
+
+namespace velox::query {
+/// @brief Chunks per morsel when MorselOptions leave it at 0
+constexpr size_t DEFAULT_MORSEL_CHUNKS = 16;
+
+/// @brief Output chunks MorselGather buffers per thread when MorselOptions
+///        leave queue_chunks at 0
+constexpr size_t DEFAULT_GATHER_CHUNKS_PER_THREAD = 4;
+
+/// @brief Range [first, end) of ColumnarTable chunks
+struct Morsel {
+  size_t first{0};
+  size_t end{0};
+};
+
+/**
+ * @brief Get the number of NUMA nodes
+ *
+ * @return Nodes listed under /sys/devices/system/node; 1 if unknown
+ */
+[[nodiscard]] size_t numa_node_count() noexcept;
+
+/**
+ * @brief Get the NUMA node of the CPU running the caller
+ *
+ * @return Node index; 0 if unknown
+ */
+[[nodiscard]] size_t current_numa_node() noexcept;
+
+/**
+ * @brief Hands out the chunks of a table as morsels, to whichever worker
+ *        asks next
+ *
+ * @note The table is cut into one contiguous stripe per NUMA node.
+ *       Workers claim morsels from their home stripe first and steal from
+ *       the others once it is drained, so no worker idles while morsels
+ *       remain. Claims are one atomic add. Thread-safe.
+ */
+class MorselQueue {
+public:
+  /**
+   * @brief Create a queue over chunks [0, chunks)
+   *
+   * @param chunks Chunks to hand out
+   * @param morsel_chunks Chunks per morsel; 0 selects DEFAULT_MORSEL_CHUNKS
+   * @param stripes Home stripes, normally numa_node_count()
+   */
+  MorselQueue(size_t chunks, size_t morsel_chunks, size_t stripes);
+
+  /**
+   * @brief Claim the next morsel
+   *
+   * @param home Preferred stripe; taken modulo stripes()
+   * @return Morsel, or nullopt once every chunk was handed out
+   */
+  [[nodiscard]] std::optional<Morsel> next(size_t home) noexcept;
+
+  /// @brief Hand out nothing more, e.g. after a worker failed
+  void close() noexcept;
+
+  /// @brief Get the number of stripes
+  [[nodiscard]] size_t stripes() const noexcept { return m_stripe_count; }
+
+private:
+  struct alignas(64) Stripe {
+    std::atomic<size_t> next{0};
+    size_t end{0};
+  };
+
+  std::unique_ptr<Stripe[]> m_stripes;
+  size_t m_stripe_count;
+  size_t m_morsel_chunks;
+};
+
+/**
+ * @brief Builds one worker's pipeline on top of its scan
+ *
+ * @note Called once per worker, concurrently; the scan reads morsels.
+ */
+using PipelineFactory =
+    std::function<error::Result<OperatorPtr>(OperatorPtr scan)>;
+
+/**
+ * @brief Receives the output chunks of a worker's pipeline
+ *
+ * @note Called concurrently from different workers; worker identifies
+ *       the caller, in [0, threads). The chunk may be moved from.
+ */
+using PipelineSink =
+    std::function<error::VoidResult(size_t worker, DataChunk &chunk)>;
+
+/// @brief Tuning knobs of run_morsels()
+struct MorselOptions {
+  size_t threads{0};       ///< Threads including the caller; 0 = whole pool
+  size_t morsel_chunks{0}; ///< Chunks per morsel; 0 = DEFAULT_MORSEL_CHUNKS
+  size_t queue_chunks{0};  ///< MorselGather output buffer; 0 = 4 per thread
+};
+
+/**
+ * @brief Run a scan pipeline over a table on the shared WorkerPool
+ *
+ * @param table Source table
+ * @param projection Columns to scan; empty reads all
+ * @param build Pipeline factory
+ * @param sink Output consumer
+ * @param options Tuning knobs
+ * @return Success, or the first error of a pipeline or the sink
+ * @note Every worker builds its own pipeline and pulls it until its scan
+ *       runs out of morsels, so streaming operators finish each morsel
+ *       before the next is claimed. A worker that joins late, e.g.
+ *       because another query holds the pool, simply gets fewer morsels.
+ */
+[[nodiscard]] error::VoidResult
+run_morsels(std::shared_ptr<const ColumnarTable> table,
+            std::vector<size_t> projection, const PipelineFactory &build,
+            const PipelineSink &sink, MorselOptions options = {});
+
+/**
+ * @brief Operator running a scan pipeline with run_morsels() and
+ *        returning its output
+ *
+ * @note The first next() starts run_morsels() on a driver thread whose
+ *       workers hand their chunks to a queue of at most queue_chunks
+ *       chunks; a worker finding it full waits for next() to drain it.
+ *       Memory is thus bounded by the queue plus one chunk per worker,
+ *       however far the consumer lags. Row order is not deterministic,
+ *       and chunks produced before a pipeline error may already have been
+ *       returned. reset() and destruction stop the workers. EXPLAIN shows
+ *       a prototype pipeline built over a plain TableScan.
+ */
+class MorselGather final : public Operator {
+public:
+  /**
+   * @brief Create a gather
+   *
+   * @param table Source table
+   * @param projection Columns to scan; empty reads all
+   * @param build Pipeline factory
+   * @param options Tuning knobs
+   */
+  MorselGather(std::shared_ptr<const ColumnarTable> table,
+               std::vector<size_t> projection, PipelineFactory build,
+               MorselOptions options = {});
+  ~MorselGather() override;
+
+  [[nodiscard]] error::Result<bool> next(DataChunk &output) override;
+  void reset() override;
+  [[nodiscard]] std::string name() const override;
+  [[nodiscard]] std::vector<const Operator *> children() const override;
+
+private:
+  class Stream;
+
+  MorselGather(error::Result<OperatorPtr> prototype,
+               std::shared_ptr<const ColumnarTable> table,
+               std::vector<size_t> projection, PipelineFactory build,
+               MorselOptions options);
+
+  std::shared_ptr<const ColumnarTable> m_table;
+  std::vector<size_t> m_projection;
+  PipelineFactory m_build;
+  MorselOptions m_options;
+  OperatorPtr m_prototype;
+  std::optional<error::ErrorCode> m_error; ///< The factory failed
+  std::unique_ptr<Stream> m_stream;        ///< Running or finished workers
+};
+
+} // namespace velox::query
@@ -0,0 +1,893 @@
+/**
+ * @file operators.hpp
+ * @author Carlos Salguero
+ * @brief Pull-based vectorized physical operators
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <velox/core.hpp>
+#include <velox/dtypes.hpp>
+#include <velox/query/expression.hpp>
+#include <velox/query/vector.hpp>
+
+namespace velox::storage {
+class StorageEngine;
+} // namespace velox::storage
+
+namespace velox::query {
+/**
+ * @brief Physical operator producing DataChunks on demand
+ *
+ * @note Operators form a tree; the consumer calls next() on the root and
+ *       each operator pulls from its children. A chunk holds at most
+ *       config::VECTOR_SIZE rows. Operators are single-threaded and own
+ *       their children.
+ */
+class Operator {
+public:
+  virtual ~Operator() = default;
+  VELOX_NON_COPYABLE_NON_MOVABLE(Operator)
+
+  /// @brief Get the output schema
+  [[nodiscard]] const Schema &schema() const noexcept { return m_schema; }
+
+  /**
+   * @brief Produce the next batch of rows
+   *
+   * @param output Cleared and filled with 1 to VECTOR_SIZE rows
+   * @return true if rows were produced, false once exhausted (output is
+   *         then empty), or an error code
+   */
+  [[nodiscard]] virtual error::Result<bool> next(DataChunk &output) = 0;
+
+  /// @brief Rewind so the next call to next() starts over
+  virtual void reset() = 0;
+
+  /// @brief Get a one-line description for EXPLAIN
+  [[nodiscard]] virtual std::string name() const = 0;
+
+  /// @brief Get the input operators
+  [[nodiscard]] virtual std::vector<const Operator *> children() const {
+    return {};
+  }
+
+protected:
+  explicit Operator(Schema schema) : m_schema(std::move(schema)) {}
+
+  /// @brief Clear output, re-laying it out first if it has another schema
+  void prepare(DataChunk &output) const;
+
+private:
+  Schema m_schema;
+};
+
+/// @brief Owning handle to an operator tree
+using OperatorPtr = std::unique_ptr<Operator>;
+
+/**
+ * @brief Render an operator tree, one operator per line
+ *
+ * @param root Root operator
+ * @return Indented plan text
+ */
+[[nodiscard]] std::string explain(const Operator &root);
+
+/**
+ * @brief Scan projection entry selecting the row id instead of a column
+ *
+ * @note The row id is a BIGINT column named ROW_ID_NAME: the row's index
+ *       in a ColumnarTable, or its RecordId for a RecordScan. Scans that
+ *       only read the columns filters and joins need can carry it along,
+ *       and a Materialize or RecordFetch above them fetches the remaining
+ *       columns for the rows that survive.
+ */
+constexpr size_t ROW_ID_COLUMN = SIZE_MAX;
+
+/// @brief Name of the row id column
+constexpr std::string_view ROW_ID_NAME = "$row_id";
+
+namespace detail {
+/**
+ * @brief Schema of a scan projection
+ *
+ * @note ROW_ID_COLUMN becomes a BIGINT "$row_id" column; columns out of
+ *       range get a placeholder so the scan can report them on next().
+ */
+[[nodiscard]] Schema scan_schema(const Schema &schema,
+                                 const std::vector<size_t> &columns);
+
+/// @brief Projection of every column of a schema, in order
+[[nodiscard]] std::vector<size_t> all_columns(const Schema &schema);
+
+/// @brief Child schema followed by the fetched columns
+[[nodiscard]] Schema fetch_schema(const Schema &child, const Schema &stored,
+                                  const std::vector<size_t> &columns);
+
+/// @brief Check that a child column can hold row ids
+[[nodiscard]] bool valid_row_id(const DataChunk &input,
+                                size_t row_id) noexcept;
+
+/// @brief Comma-separated names of fetched columns, for name()
+[[nodiscard]] std::string fetch_columns(const Schema &stored,
+                                        const std::vector<size_t> &columns);
+} // namespace detail
+
+class TopNBound;
+class MorselQueue;
+class PartitionBuffer;
+
+/// @brief Scan of an in-memory ColumnarTable
+class TableScan final : public Operator {
+public:
+  /**
+   * @brief Create a scan
+   *
+   * @param table Source table
+   * @param projection Columns to read, in output order, ROW_ID_COLUMN
+   *                   included; empty reads all
+   */
+  explicit TableScan(std::shared_ptr<const ColumnarTable> table,
+                     std::vector<size_t> projection = {});
+
+  /**
+   * @brief Skip chunks that a TopN above the scan would reject
+   *
+   * @param bound Threshold published by the TopN
+   * @param column Table column holding the TopN's first key
+   * @note Chunks are tested against their zone map before being read.
+   */
+  void set_bound(std::shared_ptr<const TopNBound> bound, size_t column);
+
+  /**
+   * @brief Read only the morsels claimed from a queue shared with other
+   *        scans of the table
+   *
+   * @param morsels Queue over the table's chunks
+   * @param home Preferred stripe, normally current_numa_node()
+   * @note The queue is consumed once: after reset() the scan only sees
+   *       morsels that are still unclaimed.
+   */
+  void set_morsels(std::shared_ptr<MorselQueue> morsels, size_t home);
+
+  [[nodiscard]] error::Result<bool> next(DataChunk &output) override;
+  void reset() override { m_next_chunk = m_end_chunk = 0; }
+  [[nodiscard]] std::string name() const override;
+
+private:
+  /// @brief Move to the next chunk to read; false at the end
+  [[nodiscard]] bool advance();
+
+  std::shared_ptr<const ColumnarTable> m_table;
+  std::vector<size_t> m_projection;
+  size_t m_next_chunk{0};
+  size_t m_end_chunk{0}; ///< End of the current morsel
+  std::shared_ptr<const TopNBound> m_bound;
+  size_t m_bound_column{0};
+  std::shared_ptr<MorselQueue> m_morsels;
+  size_t m_home{0};
+};
+
+/// @brief Predicate "column op constant" on one relation of a query
+struct ScanPredicate {
+  size_t column{0};       ///< Column of the relation
+  CompareOp op{CompareOp::EQ};
+  dtypes::Value constant; ///< Must convert to the column's type
+};
+
+/**
+ * @brief Scan of StorageEngine records holding serialized dtypes::Rows
+ *
+ * @note Reads the given record ids in order; ids that no longer exist are
+ *       skipped. Every record is fetched and deserialized whole, since
+ *       the serialized Row has no per-column access, and only the
+ *       projected columns are copied to the output.
+ */
+class RecordScan final : public Operator {
+public:
+  /**
+   * @brief Create a scan
+   *
+   * @param engine Storage engine; must outlive the operator
+   * @param table Table name
+   * @param record_ids Records to read
+   * @param schema Layout of the stored rows
+   * @param projection Columns to return, in output order, ROW_ID_COLUMN
+   *                   included; empty returns all
+   */
+  RecordScan(storage::StorageEngine &engine, std::string table,
+             std::vector<RecordId> record_ids, Schema schema,
+             std::vector<size_t> projection = {});
+
+  [[nodiscard]] error::Result<bool> next(DataChunk &output) override;
+  void reset() override { m_position = 0; }
+  [[nodiscard]] std::string name() const override;
+
+private:
+  storage::StorageEngine &m_engine;
+  std::string m_table;
+  std::vector<RecordId> m_record_ids;
+  Schema m_stored;
+  std::vector<size_t> m_projection;
+  size_t m_position{0};
+};
+
+/**
+ * @brief Scan of the ColumnarTable rows an index lookup returns
+ *
+ * @note The lookup runs on the first next() after construction or
+ *       reset(), so a plan re-reads the index on every execution. Row ids
+ *       are sorted first, and runs of consecutive ids are copied as
+ *       ranges, so output follows table order rather than index order.
+ */
+class IndexScan final : public Operator {
+public:
+  /// @brief Produces the row ids of the matching table rows
+  using Lookup = std::function<error::Result<std::vector<size_t>>()>;
+
+  /**
+   * @brief Create an index scan
+   *
+   * @param table Source table
+   * @param description Index condition for EXPLAIN
+   * @param lookup Index lookup
+   * @param projection Columns to read, in output order; empty reads all
+   */
+  IndexScan(std::shared_ptr<const ColumnarTable> table,
+            std::string description, Lookup lookup,
+            std::vector<size_t> projection = {});
+
+  [[nodiscard]] error::Result<bool> next(DataChunk &output) override;
+  void reset() override;
+  [[nodiscard]] std::string name() const override;
+
+private:
+  std::shared_ptr<const ColumnarTable> m_table;
+  std::string m_description;
+  Lookup m_lookup;
+  std::vector<size_t> m_projection;
+  std::vector<size_t> m_row_ids;
+  size_t m_position{0};
+  bool m_looked_up{false};
+};
+
+/**
+ * @brief Late materialization: append ColumnarTable columns to the rows
+ *        of a child, looked up by row id
+ *
+ * @note The child carries the row id of a TableScan over the same table,
+ *       so wide columns are copied only for rows that survived the filters
+ *       and joins in between. Runs of consecutive row ids are copied as
+ *       ranges. A NULL row id, e.g. from an outer join, yields NULLs.
+ */
+class Materialize final : public Operator {
+public:
+  /**
+   * @brief Create a materialization
+   *
+   * @param child Input carrying row ids
+   * @param row_id Child column holding the row id
+   * @param table Table the row ids refer to
+   * @param columns Table columns to append, in output order
+   */
+  Materialize(OperatorPtr child, size_t row_id,
+              std::shared_ptr<const ColumnarTable> table,
+              std::vector<size_t> columns);
+
+  [[nodiscard]] error::Result<bool> next(DataChunk &output) override;
+  void reset() override { m_child->reset(); }
+  [[nodiscard]] std::string name() const override;
+  [[nodiscard]] std::vector<const Operator *> children() const override {
+    return {m_child.get()};
+  }
+
+private:
+  OperatorPtr m_child;
+  size_t m_row_id;
+  std::shared_ptr<const ColumnarTable> m_table;
+  std::vector<size_t> m_columns;
+  DataChunk m_input;
+};
+
+/**
+ * @brief Late materialization: append columns of StorageEngine records to
+ *        the rows of a child, looked up by RecordId
+ *
+ * @note The RecordScan counterpart of Materialize. Each surviving record
+ *       is read and deserialized whole once, and only the requested
+ *       columns are copied to the output. A NULL row id yields NULLs; a
+ *       record that no longer exists is an error.
+ */
+class RecordFetch final : public Operator {
+public:
+  /**
+   * @brief Create a fetch
+   *
+   * @param child Input carrying RecordIds
+   * @param row_id Child column holding the RecordId
+   * @param engine Storage engine
+   * @param table Table name
+   * @param schema Layout of the stored rows
+   * @param columns Stored columns to append, in output order
+   */
+  RecordFetch(OperatorPtr child, size_t row_id, storage::StorageEngine &engine,
+              std::string table, Schema schema, std::vector<size_t> columns);
+
+  [[nodiscard]] error::Result<bool> next(DataChunk &output) override;
+  void reset() override { m_child->reset(); }
+  [[nodiscard]] std::string name() const override;
+  [[nodiscard]] std::vector<const Operator *> children() const override {
+    return {m_child.get()};
+  }
+
+private:
+  OperatorPtr m_child;
+  size_t m_row_id;
+  storage::StorageEngine &m_engine;
+  std::string m_table;
+  Schema m_stored;
+  std::vector<size_t> m_columns;
+  DataChunk m_input;
+};
+
+/**
+ * @brief Keeps the rows for which a BOOLEAN predicate is TRUE
+ *
+ * @note The predicate is split into its AND terms. Terms comparing a
+ *       column with constants (=, <>, <, <=, >, >=, BETWEEN, IN) on an
+ *       integer, floating, DATE, TIMESTAMP or DECIMAL column, and string
+ *       terms (=, <>, and [I]LIKE with % only at the ends), run as SIMD
+ *       kernels straight off the column; the rest are evaluated as
+ *       expressions. Term bitmaps are ANDed and compacted into a
+ *       selection vector, and the remaining terms are skipped once no
+ *       row survives.
+ */
+class Filter final : public Operator {
+public:
+  Filter(OperatorPtr child, ExpressionPtr predicate);
+
+  [[nodiscard]] error::Result<bool> next(DataChunk &output) override;
+  void reset() override { m_child->reset(); }
+  [[nodiscard]] std::string name() const override;
+  [[nodiscard]] std::vector<const Operator *> children() const override {
+    return {m_child.get()};
+  }
+
+private:
+  OperatorPtr m_child;
+  ExpressionPtr m_predicate;
+  std::vector<const Expression *> m_kernel_terms;   ///< Run as kernels
+  std::vector<const Expression *> m_residual_terms; ///< Run as expressions
+  DataChunk m_input;
+  ColumnVector m_mask;
+  std::vector<uint64_t> m_bitmap;
+  std::vector<uint64_t> m_term_bitmap;
+  std::vector<uint32_t> m_selection;
+};
+
+/// @brief Computes one output column per expression
+class Projection final : public Operator {
+public:
+  /**
+   * @brief Create a projection
+   *
+   * @param child Input operator
+   * @param expressions Output expressions over the child's schema
+   * @param names Output column names; missing entries use to_string()
+   */
+  Projection(OperatorPtr child, std::vector<ExpressionPtr> expressions,
+             std::vector<std::string> names = {});
+
+  [[nodiscard]] error::Result<bool> next(DataChunk &output) override;
+  void reset() override { m_child->reset(); }
+  [[nodiscard]] std::string name() const override;
+  [[nodiscard]] std::vector<const Operator *> children() const override {
+    return {m_child.get()};
+  }
+
+private:
+  OperatorPtr m_child;
+  std::vector<ExpressionPtr> m_expressions;
+  DataChunk m_input;
+};
+
+/// @brief Aggregate functions
+enum class AggregateFunction : uint8_t {
+  COUNT_STAR = 0, ///< Number of rows
+  COUNT = 1,      ///< Number of non-NULL values
+  SUM = 2,        ///< Sum; BIGINT for integers, DOUBLE for floating
+  MIN = 3,        ///< Smallest value
+  MAX = 4,        ///< Largest value
+  AVG = 5         ///< Mean as DOUBLE
+};
+
+/// @brief Convert AggregateFunction to its SQL spelling
+[[nodiscard]] constexpr std::string_view
+to_string(AggregateFunction function) noexcept {
+  switch (function) {
+  case AggregateFunction::COUNT_STAR:
+  case AggregateFunction::COUNT:
+    return "COUNT";
+  case AggregateFunction::SUM:
+    return "SUM";
+  case AggregateFunction::MIN:
+    return "MIN";
+  case AggregateFunction::MAX:
+    return "MAX";
+  case AggregateFunction::AVG:
+    return "AVG";
+  }
+  return "UNKNOWN";
+}
+
+/// @brief One aggregate computed by HashAggregate
+struct AggregateSpec {
+  AggregateFunction function{AggregateFunction::COUNT_STAR};
+  size_t column{0};  ///< Input column; ignored by COUNT_STAR
+  std::string name;  ///< Output column name; empty derives one
+};
+
+/**
+ * @brief Result type of an aggregate
+ *
+ * @param function Aggregate function
+ * @param input Input column type (ignored by COUNT_STAR)
+ * @return Result type, or nullopt if the function does not apply
+ */
+[[nodiscard]] std::optional<dtypes::TypeInfo>
+aggregate_type(AggregateFunction function, const dtypes::TypeInfo &input);
+
+/**
+ * @brief Hash aggregation: GROUP BY columns plus aggregates
+ *
+ * @note Output is the group columns followed by one column per aggregate.
+ *       Groups live in an open-addressing table keyed by a vectorized
+ *       hash of the group columns; aggregate states are typed arrays
+ *       indexed by group id. Without group columns exactly one row is
+ *       produced, even for empty input. An integral SUM or AVG whose sum
+ *       leaves int64 fails with NUMERIC_OVERFLOW.
+ */
+class HashAggregate final : public Operator {
+public:
+  HashAggregate(OperatorPtr child, std::vector<size_t> group_by,
+                std::vector<AggregateSpec> aggregates);
+  ~HashAggregate() override;
+
+  [[nodiscard]] error::Result<bool> next(DataChunk &output) override;
+  void reset() override;
+  [[nodiscard]] std::string name() const override;
+  [[nodiscard]] std::vector<const Operator *> children() const override {
+    return {m_child.get()};
+  }
+
+private:
+  class State;
+
+  OperatorPtr m_child;
+  std::vector<size_t> m_group_by;
+  std::vector<AggregateSpec> m_aggregates;
+  std::unique_ptr<State> m_state;
+};
+
+/// @brief Tuning knobs of a ParallelHashAggregate
+struct ParallelAggregateOptions {
+  size_t threads{0};       ///< Threads including the caller; 0 = whole pool
+  size_t memory_budget{0}; ///< Bytes of partial aggregates, and
+                           ///< separately of pending output, held in
+                           ///< memory; 0 never spills
+  std::filesystem::path spill_directory; ///< Empty = system temp directory
+  uint8_t partition_bits{0}; ///< log2 of the partition count; 0 = default
+};
+
+/**
+ * @brief Hash aggregation that pre-aggregates on every thread and merges
+ *        partition by partition
+ *
+ * @note Same semantics and output schema as HashAggregate; output order is
+ *       unspecified. Input chunks are claimed by the WorkerPool threads,
+ *       each folding them into its own small group table. A table that
+ *       outgrows the cache is flushed as partial aggregates, scattered by
+ *       the high bits of the group hash into 2^partition_bits partitions;
+ *       the largest partitions are spilled to disk whenever the budget is
+ *       exceeded. Each partition is then merged into its final groups
+ *       independently, several at a time; one larger than its share of
+ *       the budget is first split again on the next hash bits, recursively.
+ *       A single integral group column is compared as int64 instead of
+ *       through the generic key compare.
+ */
+class ParallelHashAggregate final : public Operator {
+public:
+  ParallelHashAggregate(OperatorPtr child, std::vector<size_t> group_by,
+                        std::vector<AggregateSpec> aggregates,
+                        ParallelAggregateOptions options = {});
+  ~ParallelHashAggregate() override;
+
+  [[nodiscard]] error::Result<bool> next(DataChunk &output) override;
+  void reset() override;
+  [[nodiscard]] std::string name() const override;
+  [[nodiscard]] std::vector<const Operator *> children() const override {
+    return {m_child.get()};
+  }
+
+private:
+  class State;
+
+  /// @brief Pre-aggregate the whole input into the partitions
+  [[nodiscard]] error::VoidResult partition_input();
+
+  /// @brief Flush a thread's table into the partitions
+  [[nodiscard]] error::VoidResult flush_local(size_t thread);
+
+  /// @brief Spill the largest partitions until the budget holds
+  [[nodiscard]] error::VoidResult enforce_budget();
+
+  /**
+   * @brief Merge a partition into its final groups
+   *
+   * @param partition Partial aggregates sharing their top hash_bits bits
+   * @param hash_bits Hash bits the partition was routed on
+   * @param global Emit the global group even without rows
+   * @param budget Bytes the merge may hold in memory; 0 = unlimited. A
+   *               larger partition is split on the next hash bits first.
+   * @param output Receives the groups, spilled past the budget
+   */
+  [[nodiscard]] error::VoidResult
+  merge_partition(PartitionBuffer partition, unsigned hash_bits, bool global,
+                  size_t budget, PartitionBuffer &output);
+
+  /// @brief Scatter a partition into pieces by its next hash bits
+  [[nodiscard]] error::VoidResult
+  split_partition(PartitionBuffer &partition, unsigned hash_bits,
+                  size_t budget, std::vector<PartitionBuffer> &pieces);
+
+  OperatorPtr m_child;
+  std::vector<size_t> m_group_by;
+  std::vector<AggregateSpec> m_aggregates;
+  ParallelAggregateOptions m_options;
+  std::unique_ptr<State> m_state;
+};
+
+/// @brief Join variants
+enum class JoinType : uint8_t {
+  INNER = 0, ///< Matching pairs
+  LEFT = 1,  ///< Matching pairs plus unmatched probe rows with NULLs
+  SEMI = 2,  ///< Probe rows with at least one match
+  ANTI = 3   ///< Probe rows without a match
+};
+
+/// @brief Convert JoinType to string
+[[nodiscard]] constexpr std::string_view to_string(JoinType type) noexcept {
+  switch (type) {
+  case JoinType::INNER:
+    return "INNER";
+  case JoinType::LEFT:
+    return "LEFT";
+  case JoinType::SEMI:
+    return "SEMI";
+  case JoinType::ANTI:
+    return "ANTI";
+  }
+  return "UNKNOWN";
+}
+
+/**
+ * @brief Equi-join that builds a hash table on one input and streams the
+ *        other through it
+ *
+ * @note Output is the probe columns followed by the build columns (probe
+ *       columns only for SEMI and ANTI). NULL keys never match. Key
+ *       columns must have the same type family on both sides.
+ */
+class HashJoin final : public Operator {
+public:
+  HashJoin(OperatorPtr probe, OperatorPtr build,
+           std::vector<size_t> probe_keys, std::vector<size_t> build_keys,
+           JoinType type = JoinType::INNER);
+  ~HashJoin() override;
+
+  [[nodiscard]] error::Result<bool> next(DataChunk &output) override;
+  void reset() override;
+  [[nodiscard]] std::string name() const override;
+  [[nodiscard]] std::vector<const Operator *> children() const override {
+    return {m_probe.get(), m_build.get()};
+  }
+
+private:
+  class State;
+
+  OperatorPtr m_probe;
+  OperatorPtr m_build;
+  std::vector<size_t> m_probe_keys;
+  std::vector<size_t> m_build_keys;
+  JoinType m_type;
+  std::unique_ptr<State> m_state;
+};
+
+/// @brief Tuning knobs of a RadixHashJoin
+struct RadixJoinOptions {
+  size_t threads{0};       ///< Threads including the caller; 0 = whole pool
+  size_t memory_budget{0}; ///< Bytes of partitioned input, and separately
+                           ///< of pending output, held in memory; 0 never
+                           ///< spills
+  std::filesystem::path spill_directory; ///< Empty = system temp directory
+  uint8_t partition_bits{0}; ///< log2 of the partition count; 0 = default
+};
+
+/**
+ * @brief Parallel equi-join over radix-partitioned inputs
+ *
+ * @note Same semantics and output schema as HashJoin; output order is
+ *       unspecified. Both inputs are scattered on the WorkerPool by the
+ *       high bits of their key hash into 2^partition_bits partitions, and
+ *       the largest partitions are spilled to disk whenever the budget is
+ *       exceeded. Partitions are then joined independently, several at a
+ *       time: a partition is split again on the next hash bits until each
+ *       piece's open-addressing table (8 bytes per slot) fits in the L2
+ *       cache, probe rows are grouped the same way, and each probe
+ *       prefetches the slot of a row a few positions ahead.
+ */
+class RadixHashJoin final : public Operator {
+public:
+  RadixHashJoin(OperatorPtr probe, OperatorPtr build,
+                std::vector<size_t> probe_keys, std::vector<size_t> build_keys,
+                JoinType type = JoinType::INNER,
+                RadixJoinOptions options = {});
+  ~RadixHashJoin() override;
+
+  [[nodiscard]] error::Result<bool> next(DataChunk &output) override;
+  void reset() override;
+  [[nodiscard]] std::string name() const override;
+  [[nodiscard]] std::vector<const Operator *> children() const override {
+    return {m_probe.get(), m_build.get()};
+  }
+
+private:
+  class State;
+
+  /// @brief Route every row of one input to its partition
+  [[nodiscard]] error::VoidResult partition_input(Operator &input, bool build);
+
+  /// @brief Spill the largest partitions until the budget holds
+  [[nodiscard]] error::VoidResult enforce_budget();
+
+  /**
+   * @brief Join partition p
+   *
+   * @param p Partition to join
+   * @param output Receives the joined rows
+   * @param output_budget Bytes of output kept in memory before it spills;
+   *                      0 never spills
+   */
+  [[nodiscard]] error::VoidResult
+  join_partition(size_t p, PartitionBuffer &output, size_t output_budget);
+
+  OperatorPtr m_probe;
+  OperatorPtr m_build;
+  std::vector<size_t> m_probe_keys;
+  std::vector<size_t> m_build_keys;
+  JoinType m_type;
+  RadixJoinOptions m_options;
+  std::unique_ptr<State> m_state;
+};
+
+/// @brief One ORDER BY term
+struct SortKey {
+  size_t column{0};
+  bool ascending{true};
+  bool nulls_first{false};
+};
+
+/**
+ * @brief Running threshold of a TopN, for scans below it to skip chunks
+ *        none of whose rows can enter the result
+ *
+ * @note Holds the order_prefixes() value, in the key's direction, of the
+ *       worst row kept once the TopN's heap is full; it only ever moves
+ *       towards better rows. Safe to read while the TopN publishes.
+ */
+class TopNBound {
+public:
+  /**
+   * @brief Create an unset bound
+   *
+   * @param key First sort key of the TopN
+   */
+  explicit TopNBound(SortKey key) noexcept : m_key(key) {}
+
+  /// @brief Get the sort key the threshold applies to
+  [[nodiscard]] const SortKey &key() const noexcept { return m_key; }
+
+  /// @brief Set the threshold to the prefix of the worst kept row
+  void publish(uint64_t prefix) noexcept {
+    m_prefix.store(prefix, std::memory_order_relaxed);
+    m_set.store(true, std::memory_order_release);
+  }
+
+  /// @brief Forget the threshold
+  void reset() noexcept { m_set.store(false, std::memory_order_relaxed); }
+
+  /**
+   * @brief Check whether every row of a chunk sorts after the threshold
+   *
+   * @param zone Zone map of the key column
+   * @note Strictly after: rows tying with the threshold may still enter
+   *       on later keys. NULL keys sorted first are never excluded.
+   */
+  [[nodiscard]] bool excludes(const ZoneMap &zone) const noexcept {
+    if (!m_set.load(std::memory_order_acquire) ||
+        (zone.nulls > 0 && m_key.nulls_first)) {
+      return false;
+    }
+    if (zone.values == 0) {
+      return true;
+    }
+
+    const uint64_t best = m_key.ascending ? zone.min : ~zone.max;
+    return best > m_prefix.load(std::memory_order_relaxed);
+  }
+
+private:
+  SortKey m_key;
+  std::atomic<uint64_t> m_prefix{0};
+  std::atomic<bool> m_set{false};
+};
+
+/**
+ * @brief Fully materializing ORDER BY (stable)
+ *
+ * @note Rows are radix sorted on a normalized 64-bit prefix of the first
+ *       key (NULLs set aside), and only rows with equal prefixes are
+ *       compared on the full keys.
+ */
+class Sort final : public Operator {
+public:
+  Sort(OperatorPtr child, std::vector<SortKey> keys);
+
+  [[nodiscard]] error::Result<bool> next(DataChunk &output) override;
+  void reset() override;
+  [[nodiscard]] std::string name() const override;
+  [[nodiscard]] std::vector<const Operator *> children() const override {
+    return {m_child.get()};
+  }
+
+private:
+  [[nodiscard]] error::VoidResult materialize();
+
+  OperatorPtr m_child;
+  std::vector<SortKey> m_keys;
+  std::vector<DataChunk> m_chunks;
+  std::vector<uint64_t> m_order; ///< (chunk << 32 | row) in output order
+  size_t m_emitted{0};
+  bool m_sorted{false};
+};
+
+/**
+ * @brief ORDER BY ... LIMIT keeping only the best limit + offset rows
+ *
+ * @note Same output as Sort followed by Limit. Rows go through a bounded
+ *       max-heap whose top, the worst row kept, is a running threshold:
+ *       once the heap is full, rows whose first-key prefix sorts after it
+ *       are rejected without a full comparison, and the threshold is
+ *       published to the TopNBound, if any, for scans to skip chunks.
+ */
+class TopN final : public Operator {
+public:
+  /**
+   * @brief Create a Top-N
+   *
+   * @param child Input operator
+   * @param keys Sort keys
+   * @param limit Rows to return
+   * @param offset Leading rows to skip
+   * @param bound Threshold to publish; ignored unless made for keys[0]
+   */
+  TopN(OperatorPtr child, std::vector<SortKey> keys, size_t limit,
+       size_t offset = 0, std::shared_ptr<TopNBound> bound = nullptr);
+  ~TopN() override;
+
+  [[nodiscard]] error::Result<bool> next(DataChunk &output) override;
+  void reset() override;
+  [[nodiscard]] std::string name() const override;
+  [[nodiscard]] std::vector<const Operator *> children() const override {
+    return {m_child.get()};
+  }
+
+private:
+  class State;
+
+  /// @brief Pull the whole input through the heap
+  [[nodiscard]] error::VoidResult materialize();
+
+  OperatorPtr m_child;
+  std::vector<SortKey> m_keys;
+  size_t m_limit;
+  size_t m_offset;
+  std::shared_ptr<TopNBound> m_bound;
+  std::unique_ptr<State> m_state;
+};
+
+/// @brief Tuning knobs of an ExternalSort
+struct ExternalSortOptions {
+  size_t threads{0};       ///< Threads including the caller; 0 = whole pool
+  size_t memory_budget{0}; ///< Bytes of input and sorted runs held in
+                           ///< memory; 0 never spills
+  std::filesystem::path spill_directory; ///< Empty = system temp directory
+};
+
+/**
+ * @brief ORDER BY that sorts runs in parallel and merges them, spilling
+ *        runs to disk under memory pressure
+ *
+ * @note Same output as Sort, including stability. Input is cut into runs
+ *       of up to 128K rows that are sorted on the WorkerPool like Sort
+ *       does and stored with their key prefix; the largest runs are
+ *       spilled whenever the budget is exceeded. Runs are merged by a
+ *       loser tree comparing prefixes first, at most 64 at a time: more
+ *       runs first go through parallel intermediate merge passes.
+ */
+class ExternalSort final : public Operator {
+public:
+  ExternalSort(OperatorPtr child, std::vector<SortKey> keys,
+               ExternalSortOptions options = {});
+  ~ExternalSort() override;
+
+  [[nodiscard]] error::Result<bool> next(DataChunk &output) override;
+  void reset() override;
+  [[nodiscard]] std::string name() const override;
+  [[nodiscard]] std::vector<const Operator *> children() const override {
+    return {m_child.get()};
+  }
+
+private:
+  class State;
+
+  /// @brief Cut the input into sorted runs
+  [[nodiscard]] error::VoidResult generate_runs();
+
+  /// @brief Spill the largest runs until the budget holds
+  [[nodiscard]] error::VoidResult enforce_budget();
+
+  /// @brief Merge groups of runs until one merge can take them all
+  [[nodiscard]] error::VoidResult reduce_runs();
+
+  OperatorPtr m_child;
+  std::vector<SortKey> m_keys;
+  ExternalSortOptions m_options;
+  std::unique_ptr<State> m_state;
+};
+
+/// @brief LIMIT / OFFSET
+class Limit final : public Operator {
+public:
+  Limit(OperatorPtr child, size_t limit, size_t offset = 0);
+
+  [[nodiscard]] error::Result<bool> next(DataChunk &output) override;
+  void reset() override;
+  [[nodiscard]] std::string name() const override;
+  [[nodiscard]] std::vector<const Operator *> children() const override {
+    return {m_child.get()};
+  }
+
+private:
+  OperatorPtr m_child;
+  size_t m_limit;
+  size_t m_offset;
+  size_t m_skipped{0};
+  size_t m_produced{0};
+  DataChunk m_input;
+};
+
+} // namespace velox::query
@@ -0,0 +1,167 @@
+/**
+ * @file optimizer.hpp
+ * @author Carlos Salguero
+ * @brief Cost-based optimizer for select-project-join queries
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <velox/core.hpp>
+#include <velox/query/operators.hpp>
+#include <velox/query/query_processor.hpp>
+#include <velox/query/statistics.hpp>
+#include <velox/query/vector.hpp>
+
+namespace velox::query {
+/// @brief Secondary index usable as an access path
+struct IndexSpec {
+  /// @brief Produces the row ids of the rows where column op constant
+  using Lookup = std::function<error::Result<std::vector<size_t>>(
+      CompareOp op, const dtypes::Value &constant)>;
+
+  std::string name;
+  size_t column{0};    ///< Indexed table column
+  bool unique{false};  ///< At most one row per value
+  bool ordered{true};  ///< Answers <, <=, >, >= as well as =
+  Lookup lookup;
+};
+
+/// @brief Base table of a query, with its local predicates
+struct RelationSpec {
+  std::string name; ///< Alias, prefixed to output column names
+  std::shared_ptr<const ColumnarTable> table;
+  std::vector<ScanPredicate> predicates; ///< ANDed
+  std::vector<IndexSpec> indexes;
+  std::optional<TableStatistics> statistics; ///< Unset = zone_statistics()
+};
+
+/// @brief Equality between columns of two relations
+struct JoinEdge {
+  size_t left{0};  ///< Relation index
+  size_t left_column{0};
+  size_t right{0}; ///< Relation index
+  size_t right_column{0};
+};
+
+/// @brief Output column of a query
+struct OutputColumn {
+  size_t relation{0};
+  size_t column{0};
+};
+
+/// @brief Inner equi-join of base tables
+struct JoinQuery {
+  std::vector<RelationSpec> relations;
+  std::vector<JoinEdge> joins;
+  std::vector<OutputColumn> output; ///< Empty = every column, in order
+};
+
+/**
+ * @brief Join order of a query, independent of its literal values
+ *
+ * @note A bushy tree over relation indices; each inner node joins its two
+ *       children on the join edges between them.
+ */
+struct JoinOrder {
+  /// @brief Child index of a leaf
+  static constexpr size_t LEAF = SIZE_MAX;
+
+  struct Node {
+    size_t relation{0}; ///< Relation index; leaves only
+    size_t left{LEAF};  ///< Index of the left child node
+    size_t right{LEAF}; ///< Index of the right child node
+  };
+
+  std::vector<Node> nodes; ///< Children before parents; the root is last
+};
+
+/// @brief Tuning knobs of the QueryOptimizer
+struct OptimizerOptions {
+  size_t dp_limit{12}; ///< Largest join enumerated exhaustively; bigger
+                       ///< ones are ordered greedily
+  double random_access_cost{4.0}; ///< Cost of an index row vs a scan row
+  double hash_build_cost{2.0};    ///< Cost of a build row vs a probe row
+};
+
+/**
+ * @brief Cost-based optimizer turning a JoinQuery into a QueryPlan
+ *
+ * @note Cardinalities come from the column statistics: equality uses
+ *       the most common values, else spreads the remaining rows over the
+ *       remaining distinct values; ranges use the histogram, else
+ *       interpolate between min and max; and a join keeps 1/max(distinct)
+ *       of the cross product of its sides, with textbook defaults where
+ *       statistics are unknown. Each
+ *       relation is read by a TableScan, or by an IndexScan when an
+ *       indexed predicate is cheaper, and filtered by its remaining
+ *       predicates. Join orders are enumerated with DPccp over the
+ *       connected subgraphs of the join graph, falling back to greedy
+ *       ordering above OptimizerOptions::dp_limit relations; each join is
+ *       a HashJoin that builds on its smaller side. Cross products are
+ *       not planned.
+ */
+class QueryOptimizer {
+public:
+  explicit QueryOptimizer(OptimizerOptions options = {})
+      : m_options(options) {}
+
+  /**
+   * @brief Plan a query
+   *
+   * @param query Query to plan
+   * @return Plan with its estimates, or INVALID_ARGUMENT for a malformed
+   *         query, NOT_IMPLEMENTED for a disconnected join graph and
+   *         TYPE_MISMATCH for a predicate constant of the wrong type
+   */
+  [[nodiscard]] error::Result<QueryPlan>
+  optimize(const JoinQuery &query) const;
+
+  /**
+   * @brief Plan a query along a join order chosen earlier
+   *
+   * @param query Query to plan
+   * @param order Join order, e.g. from order() for a query differing
+   *              only in its literals
+   * @return Plan with its estimates, or the errors of optimize(), or
+   *         INVALID_ARGUMENT unless the order joins every relation once
+   *         and only along join edges
+   * @note Skips join enumeration; access paths, build sides and estimates
+   *       still follow the query's literals and statistics.
+   */
+  [[nodiscard]] error::Result<QueryPlan>
+  optimize(const JoinQuery &query, const JoinOrder &order) const;
+
+  /**
+   * @brief Choose the join order of a query without building its plan
+   *
+   * @param query Query to order
+   * @return Cheapest join order, or the errors of optimize()
+   */
+  [[nodiscard]] error::Result<JoinOrder> order(const JoinQuery &query) const;
+
+  /**
+   * @brief Estimate the fraction of a table's rows satisfying a predicate
+   *
+   * @param statistics Table statistics
+   * @param predicate Predicate on the table
+   * @return Selectivity in [0, 1]
+   */
+  [[nodiscard]] static double
+  selectivity(const TableStatistics &statistics,
+              const ScanPredicate &predicate);
+
+private:
+  OptimizerOptions m_options;
+};
+
+} // namespace velox::query
@@ -0,0 +1,194 @@
+/**
+ * @file partition.hpp
+ * @author Carlos Salguero
+ * @brief Hash partitioning of DataChunks for parallel, spilling operators
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+#include <velox/core.hpp>
+#include <velox/query/spill.hpp>
+#include <velox/query/vector.hpp>
+#include <velox/query/worker_pool.hpp>
+
+namespace velox::query {
+/// @brief Partition count exponent when an operator's options leave it at 0
+constexpr uint8_t DEFAULT_PARTITION_BITS = 6;
+
+/// @brief Largest partition count exponent accepted from options
+constexpr uint8_t MAX_PARTITION_BITS = 10;
+
+/**
+ * @brief Resolve a partition count exponent from operator options
+ *
+ * @param bits Requested exponent; 0 selects DEFAULT_PARTITION_BITS
+ * @return Exponent in [1, MAX_PARTITION_BITS]
+ */
+[[nodiscard]] constexpr unsigned partition_bits(uint8_t bits) noexcept {
+  return bits == 0 ? DEFAULT_PARTITION_BITS
+                   : (bits > MAX_PARTITION_BITS ? MAX_PARTITION_BITS : bits);
+}
+
+/**
+ * @brief Get the partition of a hash
+ *
+ * @note Partitions take the high bits, leaving the low bits for hash
+ *       table slots.
+ */
+[[nodiscard]] constexpr size_t partition_of(uint64_t hash,
+                                            unsigned bits) noexcept {
+  return bits == 0 ? 0 : hash >> (64 - bits);
+}
+
+/**
+ * @brief Append a trailing "$hash" BIGINT column to a schema
+ *
+ * @note Partitioned rows carry their hash so later passes need not
+ *       rehash them.
+ */
+[[nodiscard]] Schema with_hash_column(const Schema &schema);
+
+/// @brief Get the trailing hash column of a with_hash_column() chunk
+[[nodiscard]] inline const uint64_t *
+hash_column(const DataChunk &chunk) noexcept {
+  return chunk.column(chunk.column_count() - 1).data<uint64_t>();
+}
+
+/**
+ * @brief Counting-sort rows by a group of hash bits
+ *
+ * @param hashes Row hashes
+ * @param skip Rows to leave out (e.g. NULL keys); may be empty
+ * @param shift Right shift that brings the group to the low bits
+ * @param bits Group width; 0 puts every row in group 0
+ * @param order Output, selected rows grouped by value
+ * @param bounds Output, 2^bits + 1 group boundaries into order
+ */
+void radix_order(std::span<const uint64_t> hashes,
+                 std::span<const uint8_t> skip, unsigned shift, unsigned bits,
+                 std::vector<uint32_t> &order, std::vector<uint32_t> &bounds);
+
+/**
+ * @brief Rows routed to one partition, in memory until spilled
+ *
+ * @note Rows are packed into chunks of VECTOR_SIZE rows plus one partly
+ *       filled tail. After spill(), full chunks go straight to a SpillFile
+ *       and only the tail stays resident. Not thread-safe.
+ */
+class PartitionBuffer {
+public:
+  /**
+   * @brief Create an empty partition
+   *
+   * @param layout Layout of the stored rows
+   */
+  explicit PartitionBuffer(Schema layout) : m_layout(std::move(layout)) {}
+
+  /// @brief Get the layout of the stored rows
+  [[nodiscard]] const Schema &layout() const noexcept { return m_layout; }
+
+  /**
+   * @brief Append selected rows of a chunk
+   *
+   * @param source Chunk holding every layout column, or every column but
+   *               the last if hashes is given
+   * @param rows Row indices in source
+   * @param hashes Values of the last column, indexed like source rows;
+   *               empty if source has it
+   * @return Success, or the SpillFile error
+   */
+  [[nodiscard]] error::VoidResult append(const DataChunk &source,
+                                         std::span<const uint32_t> rows,
+                                         std::span<const uint64_t> hashes = {});
+
+  /**
+   * @brief Append every row of a chunk
+   *
+   * @param chunk Chunk holding every layout column
+   * @return Success, or the SpillFile error
+   * @note A full chunk arriving while the tail is empty is kept as is.
+   */
+  [[nodiscard]] error::VoidResult append_chunk(DataChunk chunk);
+
+  /**
+   * @brief Move the resident full chunks to disk, and keep later ones there
+   *
+   * @param directory Spill directory; empty uses the system temp directory
+   * @return Success, or the SpillFile error
+   */
+  [[nodiscard]] error::VoidResult
+  spill(const std::filesystem::path &directory);
+
+  /**
+   * @brief Read the next chunk, resident ones first, then spilled ones,
+   *        then the tail
+   *
+   * @param chunk Receives the chunk
+   * @return true if a chunk was read, false at the end, or the SpillFile
+   *         error
+   * @note Consumes the partition: resident chunks are moved out, so every
+   *       chunk is returned once and nothing may be appended afterwards.
+   */
+  [[nodiscard]] error::Result<bool> read(DataChunk &chunk);
+
+  /// @brief Get the number of rows appended
+  [[nodiscard]] size_t rows() const noexcept { return m_rows; }
+
+  /// @brief Check whether any chunk went to disk
+  [[nodiscard]] bool spilled() const noexcept { return m_spill != nullptr; }
+
+  /// @brief Get the bytes of resident full chunks, which spill() frees
+  [[nodiscard]] size_t spillable_bytes() const noexcept { return m_bytes; }
+
+  /// @brief Get the bytes held in memory
+  [[nodiscard]] size_t resident_bytes() const noexcept {
+    return m_bytes + m_tail.memory_usage();
+  }
+
+  /// @brief Get the bytes held in memory or on disk
+  [[nodiscard]] size_t total_bytes() const noexcept {
+    return resident_bytes() + (m_spill ? m_spill->bytes_written() : 0);
+  }
+
+private:
+  [[nodiscard]] error::VoidResult seal_tail();
+
+  Schema m_layout;
+  std::vector<DataChunk> m_chunks;
+  DataChunk m_tail;
+  std::unique_ptr<SpillFile> m_spill;
+  size_t m_rows{0};
+  size_t m_bytes{0}; ///< Resident bytes of m_chunks
+
+  size_t m_read_position{0};
+  bool m_rewound{false};
+  bool m_tail_read{false};
+};
+
+/**
+ * @brief Spill the partitions with the most spillable bytes until enough
+ *        memory is freed
+ *
+ * @param partitions Candidates
+ * @param bytes Bytes to free
+ * @param directory Spill directory; empty uses the system temp directory
+ * @param pool Pool running the writes
+ * @param threads Most threads to use, caller included
+ * @return Success, or the first SpillFile error
+ * @note Largest first: fewest files for the bytes freed.
+ */
+[[nodiscard]] error::VoidResult
+spill_largest(std::span<PartitionBuffer *const> partitions, size_t bytes,
+              const std::filesystem::path &directory, WorkerPool &pool,
+              size_t threads);
+
+} // namespace velox::query
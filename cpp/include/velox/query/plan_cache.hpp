@@ -0,0 +1,208 @@
+/**
+ * @file plan_cache.hpp
+ * @author Carlos Salguero
+ * @brief Plan cache and prepared statements for repeated queries
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include <velox/concepts.hpp>
+#include <velox/core.hpp>
+#include <velox/metrics/latch.hpp>
+#include <velox/query/optimizer.hpp>
+
+namespace velox::query {
+/// @brief Normalized form of a JoinQuery, with its literals parameterized
+struct QueryFingerprint {
+  uint64_t hash{0};
+  std::vector<uint64_t> tokens; ///< Normalized query; compared on hash hits
+
+  bool operator==(const QueryFingerprint &) const = default;
+};
+
+/**
+ * @brief Fingerprint a query
+ *
+ * @param query Query
+ * @return Fingerprint
+ * @note Predicate constants are left out and predicates are ordered by
+ *       column and operator, so queries differing only in their literals
+ *       or in the order of their predicates share a fingerprint. Tables
+ *       enter by ColumnarTable::id() and schema, so a table allocated
+ *       where a freed one lived never matches the freed one's plans.
+ */
+[[nodiscard]] QueryFingerprint fingerprint(const JoinQuery &query);
+
+/// @brief What a cached plan was optimized against, per relation
+struct PlanStamp {
+  uint64_t table{0};              ///< ColumnarTable::id(); 0 = none
+  uint64_t statistics_version{0}; ///< TableStatistics::version
+  size_t rows{0};                 ///< Table row count
+};
+
+/// @brief Entry of a PlanCache
+struct CachedPlan {
+  QueryFingerprint fingerprint;
+  JoinOrder order;
+  std::vector<PlanStamp> stamps; ///< Per relation
+};
+
+/// @brief Tuning knobs of the PlanCache
+struct PlanCacheOptions {
+  size_t capacity{256}; ///< Cached plans; least recently used go first
+  double replan_growth{2.0}; ///< Row count factor a relation without
+                             ///< versioned statistics may grow or shrink
+                             ///< by before its plans are re-optimized
+};
+
+/// @brief Counters of a PlanCache
+struct PlanCacheStatistics {
+  uint64_t hits{0};
+  uint64_t misses{0};
+  uint64_t invalidations{0}; ///< Entries dropped as stale
+};
+
+/**
+ * @brief LRU cache of optimized plans keyed by query fingerprint
+ *
+ * @note Caches the join order, whose enumeration dominates planning from
+ *       about seven relations on (see plan_cache_benchmark); a hit
+ *       re-derives access paths, build sides and estimates for the query's
+ *       own literals and builds fresh operators along the cached order.
+ *       An entry goes stale once a relation's statistics version
+ *       changes or, for unversioned statistics, its row count drifts past
+ *       PlanCacheOptions::replan_growth. Schema changes need no tracking:
+ *       the schema is part of the fingerprint. Thread-safe.
+ */
+class PlanCache {
+public:
+  using Key = uint64_t; ///< QueryFingerprint::hash
+  using Value = std::shared_ptr<const CachedPlan>;
+
+  explicit PlanCache(PlanCacheOptions options = {},
+                     OptimizerOptions optimizer = {});
+
+  /**
+   * @brief Plan a query, reusing the cached plan of its fingerprint
+   *
+   * @param query Query to plan
+   * @return Plan, or the errors of QueryOptimizer::optimize()
+   */
+  [[nodiscard]] error::Result<QueryPlan> plan(const JoinQuery &query);
+
+  /**
+   * @brief Plan a query whose fingerprint is already known
+   *
+   * @param query Query to plan
+   * @param fingerprint fingerprint(query)
+   * @return Plan, or the errors of QueryOptimizer::optimize()
+   */
+  [[nodiscard]] error::Result<QueryPlan>
+  plan(const JoinQuery &query, const QueryFingerprint &fingerprint);
+
+  /**
+   * @brief Drop every plan reading a table, e.g. before it is replaced
+   *
+   * @param table Table
+   */
+  void invalidate(const ColumnarTable &table);
+
+  // concepts::Cache interface
+
+  /// @brief Get an entry and mark it most recently used; nullptr if absent
+  [[nodiscard]] Value get(const Key &key);
+
+  /// @brief Insert or replace an entry, evicting the least recently used
+  void put(const Key &key, const Value &value);
+
+  /// @brief Remove an entry if present
+  void evict(const Key &key);
+
+  /// @brief Remove every entry
+  void clear();
+
+  /// @brief Get the number of entries
+  [[nodiscard]] size_t size() const;
+
+  /// @brief Get the maximum number of entries
+  [[nodiscard]] size_t capacity() const noexcept {
+    return m_options.capacity;
+  }
+
+  /// @brief Get the hit, miss and invalidation counters
+  [[nodiscard]] PlanCacheStatistics statistics() const;
+
+private:
+  using Entries = std::list<std::pair<Key, Value>>;
+
+  /// @brief Check that an entry still fits the query's tables
+  [[nodiscard]] bool fresh(const CachedPlan &entry,
+                           const JoinQuery &query) const;
+
+  /// @brief Remove an entry; the caller holds m_mutex
+  void erase(Entries::iterator entry);
+
+  PlanCacheOptions m_options;
+  QueryOptimizer m_optimizer;
+  mutable metrics::InstrumentedMutex m_mutex{
+      metrics::latch_stats(metrics::latch_names::PLAN_CACHE)};
+  Entries m_entries; ///< Most recently used first
+  std::unordered_map<Key, Entries::iterator> m_index;
+  PlanCacheStatistics m_statistics;
+};
+
+static_assert(concepts::Cache<PlanCache, PlanCache::Key, PlanCache::Value>,
+              "PlanCache must satisfy the Cache concept");
+
+/**
+ * @brief Query whose predicate constants are parameters
+ *
+ * @note The fingerprint is computed once, when the statement is prepared;
+ *       binding only substitutes the constants and consults the cache.
+ *       A statement belongs to one thread at a time; the cache is shared.
+ */
+class PreparedStatement {
+public:
+  /**
+   * @brief Prepare a query
+   *
+   * @param cache Cache shared by the statements of a service
+   * @param query Query; its predicate constants are placeholders
+   */
+  PreparedStatement(std::shared_ptr<PlanCache> cache, JoinQuery query);
+
+  /// @brief Get the number of parameters: one per predicate
+  [[nodiscard]] size_t parameter_count() const noexcept;
+
+  /**
+   * @brief Substitute the parameters and plan the query
+   *
+   * @param parameters One constant per predicate, relation by relation in
+   *                   predicate order
+   * @return Plan, INVALID_ARGUMENT for the wrong number of parameters, or
+   *         the errors of QueryOptimizer::optimize()
+   */
+  [[nodiscard]] error::Result<QueryPlan>
+  bind(std::span<const dtypes::Value> parameters);
+
+  /// @brief Get the query with the constants of the last bind()
+  [[nodiscard]] const JoinQuery &query() const noexcept { return m_query; }
+
+private:
+  std::shared_ptr<PlanCache> m_cache;
+  JoinQuery m_query;
+  QueryFingerprint m_fingerprint;
+};
+
+} // namespace velox::query
@@ -0,0 +1,119 @@
+/**
+ * @file query_processor.hpp
+ * @author Carlos Salguero
+ * @brief Query plans and the vectorized execution driver
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+#include <velox/core.hpp>
+#include <velox/query/operators.hpp>
+#include <velox/query/vector.hpp>
+
+namespace velox::query {
+/**
+ * @brief Executable physical plan
+ *
+ * @note Owns the operator tree. A plan can be executed repeatedly; every
+ *       execution rewinds the tree first.
+ */
+struct QueryPlan {
+  OperatorPtr root;
+  double estimated_rows{0}; ///< Optimizer estimate; 0 for hand-built plans
+  double estimated_cost{0}; ///< Optimizer estimate; 0 for hand-built plans
+
+  QueryPlan() = default;
+  explicit QueryPlan(OperatorPtr plan_root) : root(std::move(plan_root)) {}
+
+  /// @brief Get the output schema
+  [[nodiscard]] const Schema &schema() const noexcept {
+    return root->schema();
+  }
+
+  /// @brief Render the operator tree, one operator per line
+  [[nodiscard]] std::string explain() const {
+    return root ? query::explain(*root) : std::string{};
+  }
+};
+
+/// @brief Fully materialized query output
+struct QueryResult {
+  Schema schema;
+  std::vector<DataChunk> chunks;
+
+  /// @brief Get the total number of rows
+  [[nodiscard]] size_t row_count() const noexcept {
+    size_t rows = 0;
+    for (const auto &chunk : chunks) {
+      rows += chunk.size();
+    }
+    return rows;
+  }
+
+  /**
+   * @brief Get a row as dynamically typed values
+   *
+   * @param index Row index in [0, row_count())
+   */
+  [[nodiscard]] dtypes::Row row(size_t index) const;
+};
+
+/// @brief Counters of the most recent execution
+struct QueryStatistics {
+  uint64_t rows{0};   ///< Rows produced by the root operator
+  uint64_t chunks{0}; ///< Chunks produced by the root operator
+  std::chrono::nanoseconds elapsed{0};
+};
+
+/**
+ * @brief Drives operator trees to completion
+ *
+ * @note Pulls chunks from the plan root until it is exhausted. Execution
+ *       time and row counts are also published to the global metrics
+ *       registry (metrics::names::QUERY_EXECUTE / QUERY_ROWS).
+ */
+class QueryProcessor {
+public:
+  /// @brief Receives each output chunk; return false to stop early
+  using ChunkSink = std::function<bool(const DataChunk &)>;
+
+  QueryProcessor() = default;
+
+  /**
+   * @brief Execute a plan and collect its output
+   *
+   * @param plan Plan to run
+   * @return Result rows, or INVALID_ARGUMENT for an empty plan or the
+   *         first operator error
+   */
+  [[nodiscard]] error::Result<QueryResult> execute(QueryPlan &plan);
+
+  /**
+   * @brief Execute a plan, streaming its output
+   *
+   * @param plan Plan to run
+   * @param sink Chunk consumer; the chunk is only valid during the call
+   * @return Success or the first operator error
+   */
+  [[nodiscard]] error::VoidResult execute(QueryPlan &plan,
+                                          const ChunkSink &sink);
+
+  /// @brief Get the statistics of the most recent execution
+  [[nodiscard]] const QueryStatistics &last_statistics() const noexcept {
+    return m_statistics;
+  }
+
+private:
+  QueryStatistics m_statistics;
+};
+
+} // namespace velox::query
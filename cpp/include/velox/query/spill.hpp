@@ -0,0 +1,101 @@
+/**
+ * @file spill.hpp
+ * @author Carlos Salguero
+ * @brief Temporary files that hold DataChunks evicted from memory
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+#include <velox/core.hpp>
+#include <velox/query/vector.hpp>
+
+namespace velox::query {
+/**
+ * @brief Append-only file of DataChunks with one schema
+ *
+ * @note The file is unlinked as soon as it is created, so it never
+ *       outlives the process. Writes are buffered and chunks are read
+ *       back in write order, 1 MiB at a time with the following MiB
+ *       prefetched by the kernel in the background. Columns are stored
+ *       as raw buffers: values, then validity words if the column has
+ *       NULLs, then offsets and heap bytes for variable-length columns.
+ */
+class SpillFile {
+public:
+  ~SpillFile();
+  VELOX_NON_COPYABLE_NON_MOVABLE(SpillFile)
+
+  /**
+   * @brief Create an empty spill file
+   *
+   * @param directory Directory for the file; empty uses the system
+   *                  temporary directory
+   * @param schema Layout of every chunk written
+   * @return File, or IO_ERROR
+   */
+  [[nodiscard]] static error::Result<std::unique_ptr<SpillFile>>
+  create(const std::filesystem::path &directory, Schema schema);
+
+  /// @brief Get the chunk layout
+  [[nodiscard]] const Schema &schema() const noexcept { return m_schema; }
+
+  /**
+   * @brief Append a chunk
+   *
+   * @param chunk Chunk matching schema()
+   * @return Success, or IO_ERROR / DISK_FULL
+   */
+  [[nodiscard]] error::VoidResult write(const DataChunk &chunk);
+
+  /**
+   * @brief Flush buffered writes and restart reading at the first chunk
+   *
+   * @return Success, or IO_ERROR / DISK_FULL
+   */
+  [[nodiscard]] error::VoidResult rewind();
+
+  /**
+   * @brief Read the next chunk
+   *
+   * @param chunk Re-laid out for schema() if needed and filled
+   * @return true if a chunk was read, false at the end, or CORRUPTION /
+   *         IO_ERROR
+   * @note Call rewind() after the last write.
+   */
+  [[nodiscard]] error::Result<bool> read(DataChunk &chunk);
+
+  /// @brief Get the number of chunks written
+  [[nodiscard]] size_t chunk_count() const noexcept { return m_chunks; }
+
+  /// @brief Get the number of rows written
+  [[nodiscard]] size_t row_count() const noexcept { return m_rows; }
+
+  /// @brief Get the bytes written, including buffered ones
+  [[nodiscard]] size_t bytes_written() const noexcept { return m_bytes; }
+
+private:
+  SpillFile(int fd, Schema schema);
+
+  [[nodiscard]] error::VoidResult flush();
+  [[nodiscard]] error::VoidResult read_exact(void *buffer, size_t size);
+
+  int m_fd;
+  Schema m_schema;
+  std::vector<char> m_buffer;      ///< Pending writes
+  std::vector<char> m_read_buffer; ///< Bytes read ahead
+  size_t m_read_position{0};       ///< Next unread byte in m_read_buffer
+  size_t m_read_offset{0};         ///< File offset after m_read_buffer
+  size_t m_chunks{0};
+  size_t m_rows{0};
+  size_t m_bytes{0};
+};
+
+} // namespace velox::query
@@ -0,0 +1,239 @@
+/**
+ * @file statistics.hpp
+ * @author Carlos Salguero
+ * @brief Table statistics for the optimizer and the ANALYZE collector
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <optional>
+#include <span>
+#include <vector>
+#include <velox/core.hpp>
+#include <velox/dtypes.hpp>
+#include <velox/query/vector.hpp>
+
+namespace velox::query {
+/// @brief Value occurring often enough to be estimated on its own
+struct MostCommonValue {
+  uint64_t hash{0};             ///< ColumnVector::hash() of the value
+  std::optional<double> number; ///< Numeric value, for range predicates
+  double frequency{0};          ///< Fraction of all rows
+};
+
+/// @brief Statistics of one column, as far as they are known
+struct ColumnStatistics {
+  dtypes::TypeInfo type{dtypes::TypeId::NULL_TYPE}; ///< NULL_TYPE = unknown
+  double distinct{0};      ///< Distinct non-NULL values; 0 = unknown
+  double null_fraction{0}; ///< Fraction of NULL rows
+  std::optional<double> min; ///< Smallest value of a numeric column
+  std::optional<double> max; ///< Largest value of a numeric column
+
+  /// @brief Equi-depth bucket bounds of the non-NULL values outside
+  ///        most_common; empty = no histogram
+  std::vector<double> histogram;
+  std::vector<MostCommonValue> most_common; ///< Most frequent first
+};
+
+/// @brief Statistics of a table
+struct TableStatistics {
+  double rows{0};
+  uint64_t version{0}; ///< Unique per refresh of a collector; 0 = unversioned
+  std::vector<ColumnStatistics> columns; ///< Per table column
+};
+
+/**
+ * @brief Derive the statistics a table's zone maps give for free
+ *
+ * @param table Table
+ * @return Row count and NULL fractions; distinct counts and ranges are
+ *         left unknown
+ */
+[[nodiscard]] TableStatistics zone_statistics(const ColumnarTable &table);
+
+/// @brief A constant as the statistics of a column see it
+struct StatisticsKey {
+  uint64_t hash{0};             ///< Matches MostCommonValue::hash
+  std::optional<double> number; ///< Comparable with min, max, histogram
+};
+
+/**
+ * @brief Convert a constant to a column's type for a statistics lookup
+ *
+ * @param type Column type; NULL_TYPE converts numerics to DOUBLE
+ * @param value Constant
+ * @return Key, or nullopt for NULL or a value that does not convert
+ */
+[[nodiscard]] std::optional<StatisticsKey>
+statistics_key(const dtypes::TypeInfo &type, const dtypes::Value &value);
+
+/**
+ * @brief HyperLogLog sketch of the number of distinct hashes
+ *
+ * @note 2^precision one-byte registers; the standard error is about
+ *       1.04 / sqrt(2^precision), 1.6% at the default. Small counts use
+ *       linear counting. Sketches of the same precision merge losslessly.
+ */
+class HyperLogLog {
+public:
+  /// @brief Precision when none is given
+  static constexpr uint8_t DEFAULT_PRECISION = 12;
+
+  /**
+   * @brief Create an empty sketch
+   *
+   * @param precision log2 of the register count, clamped to [4, 16]
+   */
+  explicit HyperLogLog(uint8_t precision = DEFAULT_PRECISION);
+
+  /**
+   * @brief Restore a sketch from its registers
+   *
+   * @param registers Registers as returned by registers()
+   * @return Sketch, or nullopt unless the size is a valid register count
+   */
+  [[nodiscard]] static std::optional<HyperLogLog>
+  from_registers(std::span<const uint8_t> registers);
+
+  /// @brief Add a well-mixed 64-bit hash
+  void add(uint64_t hash) noexcept;
+
+  /// @brief Fold in another sketch of the same precision
+  void merge(const HyperLogLog &other) noexcept;
+
+  /// @brief Estimate the number of distinct hashes added
+  [[nodiscard]] double estimate() const noexcept;
+
+  /// @brief Get the precision
+  [[nodiscard]] uint8_t precision() const noexcept { return m_precision; }
+
+  /// @brief Get the registers
+  [[nodiscard]] std::span<const uint8_t> registers() const noexcept {
+    return m_registers;
+  }
+
+private:
+  uint8_t m_precision;
+  std::vector<uint8_t> m_registers;
+};
+
+/// @brief Tuning knobs of the StatisticsCollector
+struct AnalyzeOptions {
+  size_t sample_chunks{32};      ///< Chunks sampled for histograms and MCVs
+  size_t histogram_buckets{100}; ///< Per numeric column
+  size_t most_common{20};        ///< Most common values kept per column
+  uint8_t sketch_precision{HyperLogLog::DEFAULT_PRECISION};
+  uint64_t seed{0x9e3779b97f4a7c15}; ///< Chunk sampling seed
+};
+
+/**
+ * @brief Collects TableStatistics for a ColumnarTable (ANALYZE)
+ *
+ * @note Distinct counts come from one HyperLogLog sketch per column;
+ *       NULL fractions, min and max are exact. All of these see every
+ *       row. Histograms and most common values come from a block sample:
+ *       a reservoir of whole chunks, plus the partial last chunk. refresh()
+ *       only reads rows appended since the previous call, so keeping
+ *       statistics current as a table grows costs one hash per new value
+ *       plus a rebuild from the sample. The collector's state serializes,
+ *       so refreshes can continue after a restart.
+ */
+class StatisticsCollector {
+public:
+  explicit StatisticsCollector(AnalyzeOptions options = {});
+
+  /**
+   * @brief Fold in the rows appended since the last refresh and rebuild
+   *        the statistics
+   *
+   * @param table Table; must only have grown since the last refresh,
+   *              otherwise collection starts over
+   * @return Updated statistics
+   */
+  [[nodiscard]] const TableStatistics &refresh(const ColumnarTable &table);
+
+  /// @brief Get the statistics of the last refresh
+  [[nodiscard]] const TableStatistics &statistics() const noexcept {
+    return m_statistics;
+  }
+
+  /// @brief Get the number of rows folded in so far
+  [[nodiscard]] size_t analyzed_rows() const noexcept { return m_rows; }
+
+  /// @brief Serialize the collector, statistics included
+  [[nodiscard]] std::vector<uint8_t> serialize() const;
+
+  /**
+   * @brief Restore a collector
+   *
+   * @param bytes Output of serialize()
+   * @return Collector, or CORRUPTION for malformed input
+   */
+  [[nodiscard]] static error::Result<StatisticsCollector>
+  deserialize(std::span<const uint8_t> bytes);
+
+private:
+  /// @brief Offer the chunks that filled up since the last refresh to the
+  ///        sample reservoir
+  void sample_chunks(size_t full_chunks);
+
+  /// @brief Rebuild the statistics from the sketches and the sample
+  void rebuild(const ColumnarTable &table);
+
+  AnalyzeOptions m_options;
+  size_t m_rows{0};
+  size_t m_offered{0};           ///< Chunks offered to the reservoir
+  std::vector<size_t> m_sample;  ///< Reservoir of chunk indices
+  std::vector<HyperLogLog> m_sketches; ///< Per column
+  std::vector<uint64_t> m_nulls;       ///< Per column
+  std::vector<std::optional<double>> m_min; ///< Per numeric column
+  std::vector<std::optional<double>> m_max; ///< Per numeric column
+  TableStatistics m_statistics;
+};
+
+/**
+ * @brief Collect the statistics of a table from scratch
+ *
+ * @param table Table
+ * @param options Tuning knobs
+ * @return Statistics
+ */
+[[nodiscard]] TableStatistics analyze(const ColumnarTable &table,
+                                      AnalyzeOptions options = {});
+
+/**
+ * @brief Get the number of METADATA pages a payload occupies
+ *
+ * @param bytes Payload size
+ */
+[[nodiscard]] size_t metadata_pages(size_t bytes) noexcept;
+
+/**
+ * @brief Store a payload, e.g. a serialized StatisticsCollector, in a
+ *        chain of METADATA pages
+ *
+ * @param payload Bytes to store
+ * @param pages metadata_pages(payload.size()) pages, in chain order
+ * @return Success, or INVALID_ARGUMENT for the wrong number of pages
+ * @note Pages are retyped as METADATA, linked through next_page and
+ *       prev_page, checksummed and marked dirty.
+ */
+[[nodiscard]] error::VoidResult
+write_metadata(std::span<const uint8_t> payload,
+               std::span<storage::Page *const> pages);
+
+/**
+ * @brief Read a payload stored by write_metadata()
+ *
+ * @param pages The chain, in order
+ * @return Payload, or CORRUPTION if a page is not part of a valid chain
+ */
+[[nodiscard]] error::Result<std::vector<uint8_t>>
+read_metadata(std::span<const storage::Page *const> pages);
+
+} // namespace velox::query
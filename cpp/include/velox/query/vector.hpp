@@ -0,0 +1,667 @@
+/**
+ * @file vector.hpp
+ * @author Carlos Salguero
+ * @brief Columnar vectors and data chunks for vectorized query execution
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <velox/core.hpp>
+#include <velox/dtypes.hpp>
+
+namespace velox::query {
+/// @brief Execution engine constants
+namespace config {
+/// @brief Rows processed per operator call
+constexpr size_t VECTOR_SIZE = 1024;
+
+/// @brief Precision of DECIMALs produced by the engine (fits in int64)
+constexpr uint8_t DECIMAL_PRECISION = 18;
+
+/// @brief Largest byte heap of a variable-length vector (32-bit offsets)
+constexpr size_t MAX_HEAP_BYTES = std::numeric_limits<uint32_t>::max();
+} // namespace config
+
+/// @brief Output schema of an operator, one entry per column
+using Schema = std::vector<dtypes::ColumnInfo>;
+
+/// @brief In-memory representation of a column's values
+enum class PhysicalType : uint8_t {
+  BOOL = 0,   ///< One byte per value, 0 or 1
+  INT8 = 1,   ///< int8_t
+  INT16 = 2,  ///< int16_t
+  INT32 = 3,  ///< int32_t (also DATE as days since epoch)
+  INT64 = 4,  ///< int64_t (also DECIMAL, TIME, TIMESTAMP, INTERVAL)
+  FLOAT = 5,  ///< float
+  DOUBLE = 6, ///< double
+  VARLEN = 7  ///< Offsets into a byte heap (strings, BLOB, UUID, ...)
+};
+
+/**
+ * @brief Map a logical type to its physical representation
+ *
+ * @param type_id Logical type
+ * @return Physical type; DECIMAL is stored as its scaled integer and
+ *         nested or custom types as their serialized bytes
+ */
+[[nodiscard]] constexpr PhysicalType physical_type(dtypes::TypeId type_id) {
+  using dtypes::TypeId;
+
+  switch (type_id) {
+  case TypeId::NULL_TYPE:
+  case TypeId::BOOLEAN:
+    return PhysicalType::BOOL;
+  case TypeId::TINYINT:
+    return PhysicalType::INT8;
+  case TypeId::SMALLINT:
+    return PhysicalType::INT16;
+  case TypeId::INTEGER:
+  case TypeId::DATE:
+    return PhysicalType::INT32;
+  case TypeId::BIGINT:
+  case TypeId::DECIMAL:
+  case TypeId::TIME:
+  case TypeId::TIMESTAMP:
+  case TypeId::INTERVAL:
+    return PhysicalType::INT64;
+  case TypeId::REAL:
+    return PhysicalType::FLOAT;
+  case TypeId::DOUBLE:
+    return PhysicalType::DOUBLE;
+  default:
+    return PhysicalType::VARLEN;
+  }
+}
+
+/// @brief Get the width in bytes of a fixed-width physical type
+[[nodiscard]] constexpr size_t physical_width(PhysicalType type) noexcept {
+  switch (type) {
+  case PhysicalType::BOOL:
+  case PhysicalType::INT8:
+    return 1;
+  case PhysicalType::INT16:
+    return 2;
+  case PhysicalType::INT32:
+  case PhysicalType::FLOAT:
+    return 4;
+  case PhysicalType::INT64:
+  case PhysicalType::DOUBLE:
+    return 8;
+  case PhysicalType::VARLEN:
+    return 0;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Get the multiplier of a DECIMAL scale
+ *
+ * @param scale Digits after the decimal point (0-18)
+ * @return 10^scale
+ */
+[[nodiscard]] constexpr int64_t scale_factor(uint8_t scale) noexcept {
+  int64_t factor = 1;
+  for (uint8_t i = 0; i < scale; ++i) {
+    factor *= 10;
+  }
+
+  return factor;
+}
+
+/// @brief Check whether values of a physical type widen losslessly to int64
+[[nodiscard]] constexpr bool is_integral(PhysicalType type) noexcept {
+  return type <= PhysicalType::INT64;
+}
+
+/**
+ * @brief Invoke a callable with the C++ type of a fixed-width physical type
+ *
+ * @param type Physical type (must not be VARLEN)
+ * @param fn Callable receiving std::type_identity<T>
+ * @return Result of the callable
+ */
+template <typename Fn>
+decltype(auto) dispatch_fixed(PhysicalType type, Fn &&fn) {
+  switch (type) {
+  case PhysicalType::BOOL:
+    return fn(std::type_identity<uint8_t>{});
+  case PhysicalType::INT8:
+    return fn(std::type_identity<int8_t>{});
+  case PhysicalType::INT16:
+    return fn(std::type_identity<int16_t>{});
+  case PhysicalType::INT32:
+    return fn(std::type_identity<int32_t>{});
+  case PhysicalType::FLOAT:
+    return fn(std::type_identity<float>{});
+  case PhysicalType::DOUBLE:
+    return fn(std::type_identity<double>{});
+  case PhysicalType::INT64:
+  case PhysicalType::VARLEN:
+    break;
+  }
+
+  assert(type == PhysicalType::INT64);
+  return fn(std::type_identity<int64_t>{});
+}
+
+/**
+ * @brief Infer the logical type of a value
+ *
+ * @param value Value
+ * @return Type info; DECIMAL carries the value's precision and scale
+ */
+[[nodiscard]] dtypes::TypeInfo type_of(const dtypes::Value &value);
+
+/// @brief Check whether two types share a representation and meaning
+[[nodiscard]] bool same_type(const dtypes::TypeInfo &a,
+                             const dtypes::TypeInfo &b) noexcept;
+
+/**
+ * @brief A column of up to capacity() values in columnar layout
+ *
+ * @note Fixed-width values live in one contiguous buffer, so kernels run
+ *       as tight loops over data<T>(). Variable-length values are stored
+ *       as 32-bit offsets into a byte heap of at most MAX_HEAP_BYTES;
+ *       vectors that accumulate without bound check heap_fits() before
+ *       appending. Validity is a bitmask (1 = valid);
+ *       the value slot of a NULL row is unspecified. The vector grows on
+ *       append, so the same type also backs hash tables and sort buffers.
+ */
+class ColumnVector {
+public:
+  /**
+   * @brief Create an empty vector
+   *
+   * @param type Logical type of the values
+   * @param capacity Rows to reserve up front
+   */
+  explicit ColumnVector(dtypes::TypeInfo type = dtypes::TypeInfo{},
+                        size_t capacity = config::VECTOR_SIZE);
+
+  /// @brief Get the logical type
+  [[nodiscard]] const dtypes::TypeInfo &type() const noexcept {
+    return m_type;
+  }
+
+  /// @brief Get the physical type
+  [[nodiscard]] PhysicalType physical() const noexcept { return m_physical; }
+
+  /// @brief Get the number of rows
+  [[nodiscard]] size_t size() const noexcept { return m_size; }
+
+  /// @brief Check if the vector has no rows
+  [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+  /// @brief Get the number of rows storable without reallocation
+  [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+
+  /**
+   * @brief Drop all rows and change the logical type
+   *
+   * @param type New logical type
+   */
+  void reset(const dtypes::TypeInfo &type);
+
+  /// @brief Drop all rows, keeping the allocation
+  void clear() noexcept;
+
+  /**
+   * @brief Ensure room for at least capacity rows
+   *
+   * @param capacity Row count
+   */
+  void reserve(size_t capacity);
+
+  /**
+   * @brief Set the row count
+   *
+   * @param size New row count. Growing is only allowed for fixed-width
+   *             vectors; added rows are valid with unspecified values.
+   * @note Lets kernels write data<T>() directly instead of appending.
+   */
+  void resize(size_t size);
+
+  /// @brief Get the fixed-width value buffer
+  template <typename T> [[nodiscard]] T *data() noexcept {
+    return reinterpret_cast<T *>(m_data.data());
+  }
+
+  /// @brief Get the fixed-width value buffer
+  template <typename T> [[nodiscard]] const T *data() const noexcept {
+    return reinterpret_cast<const T *>(m_data.data());
+  }
+
+  /// @brief Check whether a row is non-NULL
+  [[nodiscard]] bool is_valid(size_t row) const noexcept {
+    return (m_validity[row / 64] >> (row % 64)) & 1;
+  }
+
+  /// @brief Mark a row NULL or non-NULL
+  void set_valid(size_t row, bool valid) noexcept {
+    const uint64_t bit = uint64_t{1} << (row % 64);
+    if (valid) {
+      m_validity[row / 64] |= bit;
+    } else {
+      m_validity[row / 64] &= ~bit;
+      m_may_have_nulls = true;
+    }
+  }
+
+  /// @brief Check whether any row may be NULL (false means none is)
+  [[nodiscard]] bool may_have_nulls() const noexcept {
+    return m_may_have_nulls;
+  }
+
+  /// @brief Get the validity bitmask, 64 rows per word
+  [[nodiscard]] const uint64_t *validity() const noexcept {
+    return m_validity.data();
+  }
+
+  /**
+   * @brief Copy the validity of another vector of the same size
+   *
+   * @param other Source vector
+   */
+  void copy_validity(const ColumnVector &other) noexcept;
+
+  /**
+   * @brief AND the validity of another vector of the same size into this one
+   *
+   * @param other Source vector
+   */
+  void intersect_validity(const ColumnVector &other) noexcept;
+
+  /// @brief Get the bytes of a variable-length value
+  [[nodiscard]] std::string_view string_at(size_t row) const noexcept {
+    return {m_heap.data() + m_offsets[row],
+            m_offsets[row + 1] - m_offsets[row]};
+  }
+
+  /// @brief Get the heap offsets of a variable-length vector, size() + 1
+  [[nodiscard]] std::span<const uint32_t> offsets() const noexcept {
+    return {m_offsets.data(), m_size + 1};
+  }
+
+  /// @brief Get the byte heap of a variable-length vector
+  [[nodiscard]] std::span<const char> heap() const noexcept {
+    return {m_heap.data(), m_heap.size()};
+  }
+
+  /**
+   * @brief Check that more heap bytes stay addressable by the offsets
+   *
+   * @param bytes Bytes to be appended
+   * @return true if the heap would not exceed MAX_HEAP_BYTES
+   */
+  [[nodiscard]] bool heap_fits(size_t bytes) const noexcept {
+    return bytes <= config::MAX_HEAP_BYTES - m_heap.size();
+  }
+
+  /// @brief Append a fixed-width value
+  template <typename T> void append(T value) {
+    if (m_size == m_capacity) {
+      reserve(m_capacity * 2);
+    }
+    // Rows past m_size are always marked valid
+    data<T>()[m_size++] = value;
+  }
+
+  /**
+   * @brief Append a variable-length value
+   *
+   * @pre heap_fits(value.size())
+   */
+  void append_string(std::string_view value);
+
+  /// @brief Append a NULL
+  void append_null();
+
+  /**
+   * @brief Append a dynamically typed value, converting numeric values
+   *
+   * @param value Value to append
+   * @return Success, TYPE_MISMATCH if the value does not fit the type, or
+   *         OUT_OF_MEMORY if it would overflow the heap
+   */
+  [[nodiscard]] error::VoidResult append_value(const dtypes::Value &value);
+
+  /**
+   * @brief Get a row as a dynamically typed value
+   *
+   * @param row Row index
+   * @return Value; nullptr for NULL
+   */
+  [[nodiscard]] dtypes::Value value_at(size_t row) const;
+
+  /**
+   * @brief Append one row of a vector with the same physical type
+   *
+   * @param source Source vector
+   * @param row Row in the source
+   */
+  void append_from(const ColumnVector &source, size_t row);
+
+  /**
+   * @brief Append the selected rows of a vector with the same physical type
+   *
+   * @param source Source vector
+   * @param rows Row indices in the source
+   */
+  void append_selected(const ColumnVector &source,
+                       std::span<const uint32_t> rows);
+
+  /**
+   * @brief Append a contiguous row range of a vector with the same
+   *        physical type
+   *
+   * @param source Source vector
+   * @param offset First source row
+   * @param count Number of rows
+   */
+  void append_range(const ColumnVector &source, size_t offset, size_t count);
+
+  /**
+   * @brief Compare two rows for equality; NULL equals NULL
+   *
+   * @note Integral physical types compare by value across widths, so a
+   *       BIGINT column can be matched against an INTEGER column.
+   */
+  [[nodiscard]] bool equals(size_t row, const ColumnVector &other,
+                            size_t other_row) const noexcept;
+
+  /**
+   * @brief Order two non-NULL rows
+   *
+   * @return Negative, zero or positive like strcmp
+   */
+  [[nodiscard]] int compare(size_t row, const ColumnVector &other,
+                            size_t other_row) const noexcept;
+
+  /**
+   * @brief Hash every row into hashes[0, size())
+   *
+   * @param hashes Output, one hash per row
+   * @param combine Mix into the existing hashes instead of overwriting
+   * @note Consistent with equals(): equal rows hash equally, including
+   *       integral rows of different widths.
+   */
+  void hash(std::span<uint64_t> hashes, bool combine) const noexcept;
+
+  /// @brief Get the bytes held by the vector's buffers
+  [[nodiscard]] size_t memory_usage() const noexcept;
+
+private:
+  void grow_validity(size_t capacity);
+
+  dtypes::TypeInfo m_type;
+  PhysicalType m_physical;
+  size_t m_size{0};
+  size_t m_capacity{0};
+  std::vector<uint8_t> m_data;      ///< Fixed-width values
+  std::vector<uint64_t> m_validity; ///< 1 bit per row, 1 = valid
+  std::vector<uint32_t> m_offsets;  ///< VARLEN: m_size + 1 heap offsets
+  std::vector<char> m_heap;         ///< VARLEN: value bytes
+  bool m_may_have_nulls{false};
+};
+
+/**
+ * @brief A batch of rows stored as one ColumnVector per column
+ *
+ * @note Operators exchange DataChunks of at most config::VECTOR_SIZE rows.
+ */
+class DataChunk {
+public:
+  DataChunk() = default;
+
+  /**
+   * @brief Create an empty chunk with one column per schema entry
+   *
+   * @param schema Column layout
+   * @param capacity Rows to reserve per column
+   */
+  explicit DataChunk(const Schema &schema,
+                     size_t capacity = config::VECTOR_SIZE);
+
+  /**
+   * @brief Replace the columns with empty ones matching a schema
+   *
+   * @param schema Column layout
+   * @param capacity Rows to reserve per column
+   */
+  void initialize(const Schema &schema,
+                  size_t capacity = config::VECTOR_SIZE);
+
+  /**
+   * @brief Check whether the columns match a schema's types
+   *
+   * @param schema Column layout
+   */
+  [[nodiscard]] bool matches(const Schema &schema) const noexcept;
+
+  /// @brief Get the number of rows
+  [[nodiscard]] size_t size() const noexcept { return m_size; }
+
+  /// @brief Check if the chunk has no rows
+  [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+  /// @brief Get the number of columns
+  [[nodiscard]] size_t column_count() const noexcept {
+    return m_columns.size();
+  }
+
+  /// @brief Get a column
+  [[nodiscard]] ColumnVector &column(size_t index) noexcept {
+    return m_columns[index];
+  }
+
+  /// @brief Get a column
+  [[nodiscard]] const ColumnVector &column(size_t index) const noexcept {
+    return m_columns[index];
+  }
+
+  /**
+   * @brief Set the row count after writing the columns directly
+   *
+   * @param size Row count; every column must hold this many rows
+   */
+  void set_size(size_t size) noexcept { m_size = size; }
+
+  /// @brief Drop all rows, keeping the columns and their allocations
+  void clear() noexcept;
+
+  /**
+   * @brief Append one row of a chunk with the same layout
+   *
+   * @param source Source chunk
+   * @param row Row in the source
+   */
+  void append_row(const DataChunk &source, size_t row);
+
+  /**
+   * @brief Append the selected rows of a chunk with the same layout
+   *
+   * @param source Source chunk
+   * @param rows Row indices in the source
+   */
+  void append_selected(const DataChunk &source,
+                       std::span<const uint32_t> rows);
+
+  /**
+   * @brief Append a contiguous row range of a chunk with the same layout
+   *
+   * @param source Source chunk
+   * @param offset First source row
+   * @param count Number of rows
+   */
+  void append_range(const DataChunk &source, size_t offset, size_t count);
+
+  /**
+   * @brief Check that a row range of a chunk with the same layout can be
+   *        appended without overflowing a variable-length heap
+   *
+   * @param source Source chunk
+   * @param offset First source row
+   * @param count Number of rows
+   */
+  [[nodiscard]] bool range_fits(const DataChunk &source, size_t offset,
+                                size_t count) const noexcept;
+
+  /**
+   * @brief Append a row of dynamically typed values
+   *
+   * @param row Row with one value per column
+   * @return Success, or INVALID_ARGUMENT / TYPE_MISMATCH / OUT_OF_MEMORY;
+   *         on error the chunk is unchanged
+   */
+  [[nodiscard]] error::VoidResult append_row(const dtypes::Row &row);
+
+  /**
+   * @brief Get a row as dynamically typed values
+   *
+   * @param row Row index
+   */
+  [[nodiscard]] dtypes::Row row(size_t row) const;
+
+  /// @brief Get the bytes held by the chunk's columns
+  [[nodiscard]] size_t memory_usage() const noexcept;
+
+private:
+  std::vector<ColumnVector> m_columns;
+  size_t m_size{0};
+};
+
+/**
+ * @brief Encode values so that unsigned order is value order
+ *
+ * @param column Source column; NULL rows get unspecified prefixes
+ * @param first First row to encode
+ * @param count Rows to encode
+ * @param ascending Direction; descending inverts every bit
+ * @param prefixes Output, one per row
+ * @note Fixed-width values are encoded exactly: integers with the sign
+ *       bit flipped, floating values by their IEEE bits with negatives
+ *       inverted (-0.0 as +0.0, NaN after +inf). Strings keep their
+ *       first 8 bytes, big-endian and zero padded, so equal prefixes do
+ *       not imply equal strings.
+ */
+void order_prefixes(const ColumnVector &column, size_t first, size_t count,
+                    bool ascending, uint64_t *prefixes);
+
+/// @brief Check whether equal order_prefixes() imply equal values
+[[nodiscard]] constexpr bool exact_prefixes(PhysicalType type) noexcept {
+  return type != PhysicalType::VARLEN;
+}
+
+/**
+ * @brief Value range of one column in one ColumnarTable chunk
+ *
+ * @note Bounds are ascending order_prefixes(), so for strings they only
+ *       bracket the values.
+ */
+struct ZoneMap {
+  uint64_t min{UINT64_MAX}; ///< Smallest prefix of a non-NULL value
+  uint64_t max{0};          ///< Largest prefix of a non-NULL value
+  size_t values{0};         ///< Non-NULL rows
+  size_t nulls{0};          ///< NULL rows
+};
+
+/**
+ * @brief Immutable-after-load table held as a sequence of DataChunks
+ *
+ * @note Source for TableScan. Safe to read from many threads once loaded.
+ *       Every table, copies included, gets an id() no other table in the
+ *       process has had, so caches can key on it where a reused address
+ *       would alias a freed table.
+ */
+class ColumnarTable {
+public:
+  /**
+   * @brief Create an empty table
+   *
+   * @param schema Column layout
+   */
+  explicit ColumnarTable(Schema schema);
+
+  /// @brief Copy the contents under a new id
+  ColumnarTable(const ColumnarTable &other);
+  ColumnarTable &operator=(const ColumnarTable &other);
+  ColumnarTable(ColumnarTable &&) noexcept = default;
+  ColumnarTable &operator=(ColumnarTable &&) noexcept = default;
+  ~ColumnarTable() = default;
+
+  /// @brief Get the process-unique id; never 0
+  [[nodiscard]] uint64_t id() const noexcept { return m_id; }
+
+  /// @brief Get the schema
+  [[nodiscard]] const Schema &schema() const noexcept { return m_schema; }
+
+  /// @brief Get the total number of rows
+  [[nodiscard]] size_t row_count() const noexcept { return m_row_count; }
+
+  /// @brief Get the number of chunks
+  [[nodiscard]] size_t chunk_count() const noexcept {
+    return m_chunks.size();
+  }
+
+  /// @brief Get a chunk; every chunk but the last holds VECTOR_SIZE rows
+  [[nodiscard]] const DataChunk &chunk(size_t index) const noexcept {
+    return m_chunks[index];
+  }
+
+  /**
+   * @brief Append a row
+   *
+   * @param row Row with one value per column
+   * @return Success, or INVALID_ARGUMENT / TYPE_MISMATCH / OUT_OF_MEMORY
+   */
+  [[nodiscard]] error::VoidResult append_row(const dtypes::Row &row);
+
+  /**
+   * @brief Append every row of a chunk with the same layout
+   *
+   * @param chunk Source chunk
+   * @return Success, or INVALID_ARGUMENT if the layout differs
+   */
+  [[nodiscard]] error::VoidResult append_chunk(const DataChunk &chunk);
+
+  /**
+   * @brief Get the zone map of a column in a chunk
+   *
+   * @param chunk Chunk index
+   * @param column Column index
+   * @note Kept up to date by the append functions.
+   */
+  [[nodiscard]] const ZoneMap &zone(size_t chunk,
+                                    size_t column) const noexcept {
+    return m_zones[chunk * m_schema.size() + column];
+  }
+
+  /// @brief Get the bytes held by the table
+  [[nodiscard]] size_t memory_usage() const noexcept;
+
+private:
+  DataChunk &tail();
+  void extend_zones(size_t chunk, size_t first, size_t count);
+
+  uint64_t m_id;
+  Schema m_schema;
+  std::vector<DataChunk> m_chunks;
+  std::vector<ZoneMap> m_zones; ///< Chunk-major, one per column
+  size_t m_row_count{0};
+};
+
+} // namespace velox::query
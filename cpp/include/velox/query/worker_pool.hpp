@@ -0,0 +1,82 @@
+/**
+ * @file worker_pool.hpp
+ * @author Carlos Salguero
+ * @brief Shared worker threads for intra-query parallelism
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <velox/core.hpp>
+
+namespace velox::query {
+/**
+ * @brief Fixed set of threads that run index-parallel loops
+ *
+ * @note The calling thread always works on its own loop, so a loop makes
+ *       progress even when every worker is busy and nested loops cannot
+ *       deadlock. Operators share one pool (shared()) rather than
+ *       spawning threads per query.
+ */
+class WorkerPool {
+public:
+  /**
+   * @brief Start the workers
+   *
+   * @param workers Threads besides the callers; 0 runs every loop inline
+   */
+  explicit WorkerPool(size_t workers);
+  ~WorkerPool();
+  VELOX_NON_COPYABLE_NON_MOVABLE(WorkerPool)
+
+  /// @brief Get the number of worker threads
+  [[nodiscard]] size_t size() const noexcept { return m_threads.size(); }
+
+  /**
+   * @brief Get the most threads a loop can run on, callers included
+   */
+  [[nodiscard]] size_t concurrency() const noexcept { return size() + 1; }
+
+  /**
+   * @brief Call fn(i) for every i in [0, count) and wait for all calls
+   *
+   * @param count Number of iterations
+   * @param fn Loop body; must not throw. Iterations run in any order and
+   *           concurrently with each other.
+   * @param max_threads Most threads to use, caller included; 0 uses all
+   */
+  void parallel_for(size_t count, const std::function<void(size_t)> &fn,
+                    size_t max_threads = 0);
+
+  /**
+   * @brief Get the process-wide pool
+   *
+   * @note Created on first use with config::global_config().worker_threads
+   *       threads in total, the caller counting as one.
+   */
+  [[nodiscard]] static WorkerPool &shared();
+
+private:
+  struct Loop;
+
+  void work();
+
+  std::vector<std::thread> m_threads;
+  std::deque<std::shared_ptr<Loop>> m_queue; ///< Loops wanting helpers
+  std::mutex m_mutex;
+  std::condition_variable m_ready;
+  bool m_stopping{false};
+};
+
+} // namespace velox::query
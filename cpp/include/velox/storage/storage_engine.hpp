@@ -25,6 +25,7 @@
 #include <string_view>
 #include <tl/expected.hpp>
 #include <vector>
+#include <velox/metrics/latch.hpp>
 
 namespace velox::storage {
 // Forward declarations
@@ -158,6 +159,9 @@ static_assert(sizeof(PageHeader) == config::PAGE_HEADER_SIZE,
  */
 class Page {
 public:
+  /// @brief Latch type guarding page contents
+  using latch_type = metrics::InstrumentedSharedMutex;
+
   /**
    * @brief Constructor
    *
@@ -240,7 +244,8 @@ public:
    * @brief Unpin page from memory
    */
   void unpin() noexcept {
-    auto count = m_pin_count.fetch_sub(1, std::memory_order_acq_rel);
+    [[maybe_unused]] auto count =
+        m_pin_count.fetch_sub(1, std::memory_order_acq_rel);
     assert(count > 0 && "Cannot unpin unpinned page");
   }
 
@@ -276,17 +281,23 @@ public:
   /**
    * @brief Get the shared lock for reading
    * @return Shared lock guard
+   * @note Contention is attributed to this page's ID when latch profiling
+   *       is enabled
    */
-  [[nodiscard]] std::shared_lock<std::shared_mutex> read_lock() const {
-    return std::shared_lock<std::shared_mutex>(m_mutex);
+  [[nodiscard]] std::shared_lock<latch_type> read_lock() const {
+    m_mutex.lock_shared(id());
+    return std::shared_lock<latch_type>(m_mutex, std::adopt_lock);
   }
 
   /**
    * @brief Get the exclusive lock for writing
    * @return Unique lock guard
+   * @note Contention is attributed to this page's ID when latch profiling
+   *       is enabled
    */
-  [[nodiscard]] std::unique_lock<std::shared_mutex> write_lock() const {
-    return std::unique_lock<std::shared_mutex>(m_mutex);
+  [[nodiscard]] std::unique_lock<latch_type> write_lock() const {
+    m_mutex.lock(id());
+    return std::unique_lock<latch_type>(m_mutex, std::adopt_lock);
   }
 
 private:
@@ -294,7 +305,7 @@ private:
   std::array<uint8_t, config::PAGE_DATA_SIZE> m_data;
   std::atomic<bool> m_dirty{false};
   std::atomic<int32_t> m_pin_count{0};
-  mutable std::shared_mutex m_mutex;
+  mutable latch_type m_mutex{metrics::page_latch_stats()};
   Timestamp m_last_accessed;
   Timestamp m_last_modified;
 
@@ -46,6 +46,22 @@ template <typename... Args>
   return seed;
 }
 
+/**
+ * @brief Finalizer of MurmurHash3, a cheap full-avalanche 64-bit mix
+ *
+ * @param value Value to mix
+ * @return Mixed value; every input bit affects every output bit
+ */
+[[nodiscard]] constexpr uint64_t mix64(uint64_t value) noexcept {
+  value ^= value >> 33;
+  value *= 0xff51afd7ed558ccdULL;
+  value ^= value >> 33;
+  value *= 0xc4ceb9fe1a85ec53ULL;
+  value ^= value >> 33;
+
+  return value;
+}
+
 /// @brief FNV-1a hash function
 [[nodiscard]] uint32_t fnv1a_32(std::span<const uint8_t> data) noexcept;
 [[nodiscard]] uint64_t fnv1a_64(std::span<const uint8_t> data) noexcept;
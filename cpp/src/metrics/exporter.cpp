@@ -0,0 +1,504 @@
+#include <arpa/inet.h>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <velox/metrics/exporter.hpp>
+
+namespace velox::metrics {
+namespace {
+constexpr std::string_view NANOS_SUFFIX = "_ns";
+constexpr std::array<double, 4> SUMMARY_QUANTILES = {0.5, 0.9, 0.99, 0.999};
+constexpr int ACCEPT_POLL_MS = 200;
+constexpr size_t MAX_REQUEST_SIZE = 8192;
+
+/// @brief Check if an address names the loopback interface
+bool is_loopback_address(std::string_view address) noexcept {
+  return address == "127.0.0.1" || address == "::1" || address == "localhost";
+}
+
+/// @brief Replace characters Prometheus does not allow in metric names
+std::string sanitize_name(std::string_view name) {
+  std::string sanitized(name);
+  for (size_t i = 0; i < sanitized.size(); ++i) {
+    const char c = sanitized[i];
+    const bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                       c == '_' || c == ':' || (i > 0 && c >= '0' && c <= '9');
+    if (!valid) {
+      sanitized[i] = '_';
+    }
+  }
+
+  return sanitized;
+}
+
+/// @brief Append a single-sample metric family
+void append_sample(std::string &out, std::string_view name,
+                   std::string_view type, std::string_view help,
+                   double value) {
+  out += fmt::format("# HELP {} {}\n# TYPE {} {}\n{} {}\n", name, help, name,
+                     type, name, value);
+}
+
+/// @brief Send a whole buffer, retrying on short writes
+bool send_all(int fd, std::string_view data) {
+  while (!data.empty()) {
+    const auto written = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      return false;
+    }
+
+    data.remove_prefix(static_cast<size_t>(written));
+  }
+
+  return true;
+}
+} // namespace
+
+std::string to_prometheus(const MetricsSnapshot &snapshot) {
+  std::string out;
+
+  for (const auto &counter : snapshot.counters) {
+    const auto name = sanitize_name(counter.name) + "_total";
+    out += fmt::format("# TYPE {} counter\n{} {}\n", name, name,
+                       counter.value);
+  }
+
+  for (const auto &gauge : snapshot.gauges) {
+    const auto name = sanitize_name(gauge.name);
+    out += fmt::format("# TYPE {} gauge\n{} {}\n", name, name, gauge.value);
+  }
+
+  for (const auto &histogram : snapshot.histograms) {
+    std::string_view raw_name = histogram.name;
+    double scale = 1.0;
+
+    if (raw_name.ends_with(NANOS_SUFFIX)) {
+      raw_name.remove_suffix(NANOS_SUFFIX.size());
+      scale = 1e-9;
+    }
+
+    auto name = sanitize_name(raw_name);
+    if (scale != 1.0) {
+      name += "_seconds";
+    }
+
+    const auto &data = histogram.data;
+    out += fmt::format("# TYPE {} summary\n", name);
+    for (auto quantile : SUMMARY_QUANTILES) {
+      out += fmt::format("{}{{quantile=\"{}\"}} {}\n", name, quantile,
+                         static_cast<double>(data.percentile(quantile)) *
+                             scale);
+    }
+    out += fmt::format("{}_sum {}\n{}_count {}\n", name,
+                       static_cast<double>(data.sum) * scale, name,
+                       data.count);
+  }
+
+  return out;
+}
+
+std::string to_prometheus(const storage::StorageStatistics &stats) {
+  std::string out;
+
+  append_sample(out, "velox_storage_stats_pages", "gauge",
+                "Total number of pages",
+                static_cast<double>(stats.total_pages));
+  append_sample(out, "velox_storage_stats_free_pages", "gauge",
+                "Number of free pages", static_cast<double>(stats.free_pages));
+  append_sample(out, "velox_storage_stats_buffer_hits_total", "counter",
+                "Buffer pool cache hits",
+                static_cast<double>(stats.buffer_hits));
+  append_sample(out, "velox_storage_stats_buffer_misses_total", "counter",
+                "Buffer pool cache misses",
+                static_cast<double>(stats.buffer_misses));
+  append_sample(out, "velox_storage_stats_disk_reads_total", "counter",
+                "Number of disk reads", static_cast<double>(stats.disk_reads));
+  append_sample(out, "velox_storage_stats_disk_writes_total", "counter",
+                "Number of disk writes",
+                static_cast<double>(stats.disk_writes));
+  append_sample(out, "velox_storage_stats_records_inserted_total", "counter",
+                "Number of records inserted",
+                static_cast<double>(stats.records_inserted));
+  append_sample(out, "velox_storage_stats_records_updated_total", "counter",
+                "Number of records updated",
+                static_cast<double>(stats.records_updated));
+  append_sample(out, "velox_storage_stats_records_deleted_total", "counter",
+                "Number of records deleted",
+                static_cast<double>(stats.records_deleted));
+  append_sample(out, "velox_storage_stats_cache_hit_ratio", "gauge",
+                "Buffer pool cache hit ratio", stats.cache_hit_ratio);
+
+  return out;
+}
+
+std::string to_prometheus(std::span<const LatchSnapshot> latches) {
+  if (latches.empty()) {
+    return {};
+  }
+
+  std::string out;
+  out += "# TYPE velox_latch_acquisitions_total counter\n";
+  for (const auto &latch : latches) {
+    out += fmt::format("velox_latch_acquisitions_total{{latch=\"{}\"}} {}\n",
+                       latch.name, latch.acquisitions);
+  }
+
+  out += "# TYPE velox_latch_contended_total counter\n";
+  for (const auto &latch : latches) {
+    out += fmt::format("velox_latch_contended_total{{latch=\"{}\"}} {}\n",
+                       latch.name, latch.contended);
+  }
+
+  out += "# TYPE velox_latch_wait_seconds_total counter\n";
+  for (const auto &latch : latches) {
+    out += fmt::format("velox_latch_wait_seconds_total{{latch=\"{}\"}} {}\n",
+                       latch.name, static_cast<double>(latch.wait_ns) * 1e-9);
+  }
+
+  out += "# TYPE velox_latch_key_wait_seconds_total counter\n";
+  for (const auto &latch : latches) {
+    for (const auto &key : latch.top_keys) {
+      out += fmt::format(
+          "velox_latch_key_wait_seconds_total{{latch=\"{}\",key=\"{}\"}} {}\n",
+          latch.name, key.key, static_cast<double>(key.wait_ns) * 1e-9);
+    }
+  }
+
+  return out;
+}
+
+bool ExporterConfig::is_valid() const noexcept {
+  if (dump_interval.count() < 0) {
+    return false;
+  }
+
+  if (dump_interval.count() > 0 && dump_file.empty()) {
+    return false;
+  }
+
+  if (!unix_socket_path.empty()) {
+    return unix_socket_path.native().size() < sizeof(sockaddr_un::sun_path);
+  }
+
+  return !enable_server || is_loopback_address(bind_address);
+}
+
+class MetricsExporter::Impl {
+public:
+  Impl(ExporterConfig config, MetricsRegistry &registry)
+      : m_config(std::move(config)), m_registry(registry),
+        m_logger(log::get_logger("metrics")) {}
+
+  ~Impl() { stop(); }
+
+  error::VoidResult start() {
+    if (m_running.load(std::memory_order_acquire)) {
+      return error::ok();
+    }
+
+    if (!m_config.is_valid()) {
+      return error::error<void>(error::ErrorCode::INVALID_ARGUMENT);
+    }
+
+    if (m_config.enable_server) {
+      auto bound = m_config.unix_socket_path.empty() ? bind_tcp()
+                                                     : bind_unix();
+      if (!bound) {
+        return bound;
+      }
+    }
+
+    m_stopping = false;
+    m_running.store(true, std::memory_order_release);
+
+    if (m_listen_fd >= 0) {
+      m_server_thread = std::thread([this] { serve(); });
+    }
+
+    if (m_config.dump_interval.count() > 0) {
+      m_dump_thread = std::thread([this] { dump_loop(); });
+    }
+
+    return error::ok();
+  }
+
+  void stop() {
+    if (!m_running.exchange(false, std::memory_order_acq_rel)) {
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_stop_mutex);
+      m_stopping = true;
+    }
+    m_stop_cv.notify_all();
+
+    if (m_server_thread.joinable()) {
+      m_server_thread.join();
+    }
+
+    if (m_dump_thread.joinable()) {
+      m_dump_thread.join();
+    }
+
+    if (m_listen_fd >= 0) {
+      ::close(m_listen_fd);
+      m_listen_fd = -1;
+    }
+
+    if (!m_config.unix_socket_path.empty()) {
+      std::error_code ec;
+      std::filesystem::remove(m_config.unix_socket_path, ec);
+    }
+
+    m_bound_port = 0;
+  }
+
+  std::string render() const {
+    auto text = to_prometheus(m_registry.get_metrics());
+
+    if (m_provider) {
+      auto stats = m_provider();
+      stats.update_cache_hit_ratio();
+      text += to_prometheus(stats);
+    }
+
+    const auto latches = latch_snapshot();
+    text += to_prometheus(std::span<const LatchSnapshot>(latches));
+
+    return text;
+  }
+
+  error::VoidResult dump(const std::filesystem::path &file) const {
+    auto temp = file;
+    temp += ".tmp";
+
+    {
+      std::ofstream outfile(temp, std::ios::trunc);
+      if (!outfile) {
+        return error::error<void>(error::ErrorCode::IO_ERROR);
+      }
+
+      outfile << render();
+      if (!outfile) {
+        return error::error<void>(error::ErrorCode::IO_ERROR);
+      }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp, file, ec);
+    if (ec) {
+      return error::error<void>(error::ErrorCode::IO_ERROR);
+    }
+
+    return error::ok();
+  }
+
+  ExporterConfig m_config;
+  MetricsRegistry &m_registry;
+  StatisticsProvider m_provider;
+  std::shared_ptr<spdlog::logger> m_logger;
+  std::atomic<bool> m_running{false};
+  uint16_t m_bound_port{0};
+
+private:
+  error::VoidResult bind_tcp() {
+    const bool ipv6 = m_config.bind_address == "::1";
+    m_listen_fd =
+        ::socket(ipv6 ? AF_INET6 : AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (m_listen_fd < 0) {
+      return error::error<void>(error::ErrorCode::NETWORK_ERROR);
+    }
+
+    int reuse = 1;
+    ::setsockopt(m_listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_storage storage{};
+    socklen_t len = 0;
+    if (ipv6) {
+      auto *addr = reinterpret_cast<sockaddr_in6 *>(&storage);
+      addr->sin6_family = AF_INET6;
+      addr->sin6_port = htons(m_config.port);
+      addr->sin6_addr = in6addr_loopback;
+      len = sizeof(sockaddr_in6);
+    } else {
+      auto *addr = reinterpret_cast<sockaddr_in *>(&storage);
+      addr->sin_family = AF_INET;
+      addr->sin_port = htons(m_config.port);
+      addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      len = sizeof(sockaddr_in);
+    }
+
+    auto *addr = reinterpret_cast<sockaddr *>(&storage);
+    if (::bind(m_listen_fd, addr, len) != 0 ||
+        ::listen(m_listen_fd, SOMAXCONN) != 0) {
+      m_logger->error("Metrics endpoint failed to bind {}:{}: {}",
+                      m_config.bind_address, m_config.port,
+                      std::strerror(errno));
+      close_listener();
+      return error::error<void>(error::ErrorCode::NETWORK_ERROR);
+    }
+
+    ::getsockname(m_listen_fd, addr, &len);
+    m_bound_port =
+        ipv6 ? ntohs(reinterpret_cast<sockaddr_in6 *>(&storage)->sin6_port)
+             : ntohs(reinterpret_cast<sockaddr_in *>(&storage)->sin_port);
+
+    m_logger->info("Serving metrics on http://{}:{}/metrics",
+                   m_config.bind_address, m_bound_port);
+    return error::ok();
+  }
+
+  error::VoidResult bind_unix() {
+    m_listen_fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (m_listen_fd < 0) {
+      return error::error<void>(error::ErrorCode::NETWORK_ERROR);
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(m_config.unix_socket_path, ec);
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    const auto &path = m_config.unix_socket_path.native();
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+    if (::bind(m_listen_fd, reinterpret_cast<sockaddr *>(&addr),
+               sizeof(addr)) != 0 ||
+        ::listen(m_listen_fd, SOMAXCONN) != 0) {
+      m_logger->error("Metrics endpoint failed to bind {}: {}", path,
+                      std::strerror(errno));
+      close_listener();
+      return error::error<void>(error::ErrorCode::NETWORK_ERROR);
+    }
+
+    m_logger->info("Serving metrics on unix:{}", path);
+    return error::ok();
+  }
+
+  void close_listener() {
+    ::close(m_listen_fd);
+    m_listen_fd = -1;
+  }
+
+  void serve() {
+    pollfd pfd{m_listen_fd, POLLIN, 0};
+
+    while (m_running.load(std::memory_order_acquire)) {
+      const int ready = ::poll(&pfd, 1, ACCEPT_POLL_MS);
+      if (ready <= 0) {
+        continue;
+      }
+
+      const int client = ::accept4(m_listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+      if (client < 0) {
+        continue;
+      }
+
+      handle_client(client);
+      ::close(client);
+    }
+  }
+
+  void handle_client(int client) {
+    timeval timeout{1, 0};
+    ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    std::string request;
+    char buffer[1024];
+    while (request.size() < MAX_REQUEST_SIZE &&
+           request.find("\r\n\r\n") == std::string::npos) {
+      const auto received = ::recv(client, buffer, sizeof(buffer), 0);
+      if (received <= 0) {
+        break;
+      }
+
+      request.append(buffer, static_cast<size_t>(received));
+    }
+
+    const bool is_get = request.starts_with("GET ");
+    const auto target_end = request.find(' ', 4);
+    const auto target =
+        is_get && target_end != std::string::npos
+            ? std::string_view(request).substr(4, target_end - 4)
+            : std::string_view{};
+
+    if (target == "/metrics" || target == "/") {
+      const auto body = render();
+      send_all(client,
+               fmt::format("HTTP/1.1 200 OK\r\n"
+                           "Content-Type: text/plain; version=0.0.4\r\n"
+                           "Content-Length: {}\r\n"
+                           "Connection: close\r\n\r\n",
+                           body.size()));
+      send_all(client, body);
+    } else {
+      send_all(client, "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n"
+                       "Connection: close\r\n\r\n");
+    }
+  }
+
+  void dump_loop() {
+    std::unique_lock<std::mutex> lock(m_stop_mutex);
+
+    while (!m_stop_cv.wait_for(lock, m_config.dump_interval,
+                               [this] { return m_stopping; })) {
+      lock.unlock();
+      if (auto result = dump(m_config.dump_file); !result) {
+        m_logger->warn("Failed to dump metrics to {}: {}",
+                       m_config.dump_file.string(), result.error());
+      }
+      lock.lock();
+    }
+  }
+
+  int m_listen_fd{-1};
+  std::thread m_server_thread;
+  std::thread m_dump_thread;
+  std::mutex m_stop_mutex;
+  std::condition_variable m_stop_cv;
+  bool m_stopping{false};
+};
+
+MetricsExporter::MetricsExporter(ExporterConfig config,
+                                 MetricsRegistry &registry)
+    : m_impl(std::make_unique<Impl>(std::move(config), registry)) {}
+
+MetricsExporter::~MetricsExporter() = default;
+
+void MetricsExporter::set_statistics_provider(StatisticsProvider provider) {
+  m_impl->m_provider = std::move(provider);
+}
+
+error::VoidResult MetricsExporter::start() { return m_impl->start(); }
+
+void MetricsExporter::stop() { m_impl->stop(); }
+
+bool MetricsExporter::is_running() const noexcept {
+  return m_impl->m_running.load(std::memory_order_acquire);
+}
+
+std::string MetricsExporter::render() const { return m_impl->render(); }
+
+error::VoidResult
+MetricsExporter::dump(const std::filesystem::path &file) const {
+  return m_impl->dump(file);
+}
+
+uint16_t MetricsExporter::bound_port() const noexcept {
+  return m_impl->m_bound_port;
+}
+} // namespace velox::metrics
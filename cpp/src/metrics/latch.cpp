@@ -0,0 +1,149 @@
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <velox/metrics/latch.hpp>
+
+namespace velox::metrics {
+namespace {
+std::mutex latch_registry_mutex;
+std::map<std::string, std::unique_ptr<LatchStats>, std::less<>>
+    latch_registry;
+} // namespace
+
+struct LatchStats::KeySlot {
+  std::atomic<uint64_t> key{0};
+  std::atomic<uint64_t> contended{0};
+  std::atomic<uint64_t> wait_ns{0};
+};
+
+LatchStats::LatchStats(std::string_view name)
+    : m_name(name),
+      m_keys(std::make_unique<KeySlot[]>(config::LATCH_KEY_SLOTS + 1)) {}
+
+LatchStats::~LatchStats() = default;
+
+void LatchStats::record_contended(uint64_t key, uint64_t wait_ns) noexcept {
+  m_contended.add();
+  m_wait_ns.add(wait_ns);
+  m_wait.record(wait_ns);
+
+  // Slot LATCH_KEY_SLOTS collects unknown keys and probe overflow
+  KeySlot *target = &m_keys[config::LATCH_KEY_SLOTS];
+
+  if (key != 0) {
+    auto index = static_cast<size_t>((key * 0x9e3779b97f4a7c15ULL) >> 32) %
+                 config::LATCH_KEY_SLOTS;
+
+    for (size_t probe = 0; probe < config::LATCH_KEY_PROBES; ++probe) {
+      auto &slot = m_keys[(index + probe) % config::LATCH_KEY_SLOTS];
+
+      auto current = slot.key.load(std::memory_order_relaxed);
+      if (current == 0 &&
+          slot.key.compare_exchange_strong(current, key,
+                                           std::memory_order_relaxed)) {
+        current = key;
+      }
+
+      if (current == key) {
+        target = &slot;
+        break;
+      }
+    }
+  }
+
+  target->contended.fetch_add(1, std::memory_order_relaxed);
+  target->wait_ns.fetch_add(wait_ns, std::memory_order_relaxed);
+}
+
+LatchSnapshot LatchStats::snapshot(size_t top_n) const {
+  LatchSnapshot result;
+  result.name = m_name;
+  result.acquisitions = m_acquisitions.value();
+  result.contended = m_contended.value();
+  result.wait_ns = m_wait_ns.value();
+  result.wait = m_wait.snapshot();
+
+  for (size_t i = 0; i <= config::LATCH_KEY_SLOTS; ++i) {
+    const auto &slot = m_keys[i];
+    const auto contended = slot.contended.load(std::memory_order_relaxed);
+    if (contended == 0) {
+      continue;
+    }
+
+    result.top_keys.push_back({
+        i < config::LATCH_KEY_SLOTS ? slot.key.load(std::memory_order_relaxed)
+                                    : 0,
+        contended,
+        slot.wait_ns.load(std::memory_order_relaxed),
+    });
+  }
+
+  const auto keep = std::min(top_n, result.top_keys.size());
+  std::partial_sort(result.top_keys.begin(), result.top_keys.begin() + keep,
+                    result.top_keys.end(), [](const auto &a, const auto &b) {
+                      return a.wait_ns > b.wait_ns;
+                    });
+  result.top_keys.resize(keep);
+
+  return result;
+}
+
+void LatchStats::reset() noexcept {
+  m_acquisitions.reset();
+  m_contended.reset();
+  m_wait_ns.reset();
+  m_wait.reset();
+
+  for (size_t i = 0; i <= config::LATCH_KEY_SLOTS; ++i) {
+    m_keys[i].key.store(0, std::memory_order_relaxed);
+    m_keys[i].contended.store(0, std::memory_order_relaxed);
+    m_keys[i].wait_ns.store(0, std::memory_order_relaxed);
+  }
+}
+
+LatchStats &latch_stats(std::string_view name) {
+  std::lock_guard<std::mutex> lock(latch_registry_mutex);
+
+  auto it = latch_registry.find(name);
+  if (it != latch_registry.end()) {
+    return *it->second;
+  }
+
+  auto stats = std::make_unique<LatchStats>(name);
+  auto &ref = *stats;
+  latch_registry.emplace(std::string(name), std::move(stats));
+
+  return ref;
+}
+
+LatchStats &page_latch_stats() {
+  static LatchStats &stats = latch_stats(latch_names::PAGE);
+  return stats;
+}
+
+std::vector<LatchSnapshot> latch_snapshot(size_t top_n) {
+  std::vector<LatchSnapshot> snapshots;
+
+  {
+    std::lock_guard<std::mutex> lock(latch_registry_mutex);
+    snapshots.reserve(latch_registry.size());
+
+    for (const auto &[name, stats] : latch_registry) {
+      snapshots.push_back(stats->snapshot(top_n));
+    }
+  }
+
+  std::sort(snapshots.begin(), snapshots.end(),
+            [](const auto &a, const auto &b) { return a.wait_ns > b.wait_ns; });
+
+  return snapshots;
+}
+
+void reset_latch_stats() {
+  std::lock_guard<std::mutex> lock(latch_registry_mutex);
+
+  for (auto &[name, stats] : latch_registry) {
+    stats->reset();
+  }
+}
+} // namespace velox::metrics
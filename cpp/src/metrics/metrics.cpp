@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <velox/metrics/metrics.hpp>
+
+namespace velox::metrics {
+uint64_t Counter::value() const noexcept {
+  uint64_t total = 0;
+  for (const auto &shard : m_shards) {
+    total += shard.value.load(std::memory_order_relaxed);
+  }
+
+  return total;
+}
+
+void Counter::reset() noexcept {
+  for (auto &shard : m_shards) {
+    shard.value.store(0, std::memory_order_relaxed);
+  }
+}
+
+void HistogramSnapshot::merge(const HistogramSnapshot &other) {
+  if (other.count == 0) {
+    return;
+  }
+
+  if (buckets.size() < other.buckets.size()) {
+    buckets.resize(other.buckets.size(), 0);
+  }
+
+  for (size_t i = 0; i < other.buckets.size(); ++i) {
+    buckets[i] += other.buckets[i];
+  }
+
+  min = count > 0 ? std::min(min, other.min) : other.min;
+  max = std::max(max, other.max);
+  count += other.count;
+  sum += other.sum;
+}
+
+uint64_t HistogramSnapshot::percentile(double quantile) const noexcept {
+  if (count == 0) {
+    return 0;
+  }
+
+  quantile = std::clamp(quantile, 0.0, 1.0);
+  auto target = static_cast<uint64_t>(
+      std::ceil(quantile * static_cast<double>(count)));
+  target = std::max<uint64_t>(target, 1);
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    seen += buckets[i];
+    if (seen >= target) {
+      return std::clamp(LatencyHistogram::bucket_upper_bound(i), min, max);
+    }
+  }
+
+  return max;
+}
+
+HistogramSnapshot LatencyHistogram::snapshot() const {
+  HistogramSnapshot result;
+  result.buckets.assign(BUCKET_COUNT, 0);
+  result.min = UINT64_MAX;
+
+  for (const auto &shard : m_shards) {
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+      result.buckets[i] += shard.buckets[i].load(std::memory_order_relaxed);
+    }
+
+    result.count += shard.count.load(std::memory_order_relaxed);
+    result.sum += shard.sum.load(std::memory_order_relaxed);
+    result.min = std::min(result.min, shard.min.load(std::memory_order_relaxed));
+    result.max = std::max(result.max, shard.max.load(std::memory_order_relaxed));
+  }
+
+  if (result.count == 0) {
+    result.min = 0;
+  }
+
+  return result;
+}
+
+void LatencyHistogram::reset() noexcept {
+  for (auto &shard : m_shards) {
+    for (auto &bucket : shard.buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+
+    shard.count.store(0, std::memory_order_relaxed);
+    shard.sum.store(0, std::memory_order_relaxed);
+    shard.min.store(UINT64_MAX, std::memory_order_relaxed);
+    shard.max.store(0, std::memory_order_relaxed);
+  }
+}
+
+const HistogramSample *
+MetricsSnapshot::find_histogram(std::string_view name) const noexcept {
+  auto it = std::find_if(histograms.begin(), histograms.end(),
+                         [name](const auto &h) { return h.name == name; });
+
+  return it != histograms.end() ? &*it : nullptr;
+}
+
+template <typename T>
+T &MetricsRegistry::get_or_create(MetricMap<T> &metrics,
+                                  std::string_view name) {
+  {
+    std::shared_lock lock(m_mutex);
+    auto it = metrics.find(name);
+    if (it != metrics.end()) {
+      return *it->second;
+    }
+  }
+
+  std::unique_lock lock(m_mutex);
+  auto [it, inserted] = metrics.try_emplace(std::string(name), nullptr);
+  if (inserted) {
+    it->second = std::make_unique<T>();
+  }
+
+  return *it->second;
+}
+
+Counter &MetricsRegistry::get_counter(std::string_view name) {
+  return get_or_create(m_counters, name);
+}
+
+Gauge &MetricsRegistry::get_gauge(std::string_view name) {
+  return get_or_create(m_gauges, name);
+}
+
+LatencyHistogram &MetricsRegistry::get_histogram(std::string_view name) {
+  return get_or_create(m_histograms, name);
+}
+
+void MetricsRegistry::counter(std::string_view name, double value) {
+  if (value > 0.0) {
+    get_counter(name).add(static_cast<uint64_t>(value));
+  }
+}
+
+void MetricsRegistry::gauge(std::string_view name, double value) {
+  get_gauge(name).set(value);
+}
+
+void MetricsRegistry::histogram(std::string_view name, double value) {
+  get_histogram(name).record(static_cast<uint64_t>(std::max(value, 0.0)));
+}
+
+MetricsSnapshot MetricsRegistry::get_metrics() const {
+  MetricsSnapshot snapshot;
+  snapshot.taken_at = std::chrono::system_clock::now();
+
+  // Metric objects are never removed, so the lock only guards the maps while
+  // the atomics are read; writers on the hot path are never blocked.
+  std::shared_lock lock(m_mutex);
+
+  snapshot.counters.reserve(m_counters.size());
+  for (const auto &[name, counter] : m_counters) {
+    snapshot.counters.push_back({name, counter->value()});
+  }
+
+  snapshot.gauges.reserve(m_gauges.size());
+  for (const auto &[name, gauge] : m_gauges) {
+    snapshot.gauges.push_back({name, gauge->value()});
+  }
+
+  snapshot.histograms.reserve(m_histograms.size());
+  for (const auto &[name, histogram] : m_histograms) {
+    snapshot.histograms.push_back({name, histogram->snapshot()});
+  }
+
+  return snapshot;
+}
+
+void MetricsRegistry::reset() {
+  std::shared_lock lock(m_mutex);
+
+  for (auto &[name, counter] : m_counters) {
+    counter->reset();
+  }
+
+  for (auto &[name, gauge] : m_gauges) {
+    gauge->set(0.0);
+  }
+
+  for (auto &[name, histogram] : m_histograms) {
+    histogram->reset();
+  }
+}
+
+MetricsRegistry &global_registry() {
+  static MetricsRegistry registry;
+  return registry;
+}
+} // namespace velox::metrics
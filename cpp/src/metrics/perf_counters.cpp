@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <memory>
+#include <velox/metrics/perf_counters.hpp>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace velox::metrics {
+#if defined(__linux__)
+namespace {
+/// @brief perf_event_attr type/config pair for an event
+struct EventSpec {
+  uint32_t type;
+  uint64_t config;
+};
+
+constexpr std::array<EventSpec, PERF_EVENT_COUNT> EVENT_SPECS = {{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE,
+     PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+}};
+
+int open_event(const EventSpec &spec, int group_fd) {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = spec.type;
+  attr.config = spec.config;
+  attr.disabled = group_fd < 0 ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                     PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  return static_cast<int>(
+      ::syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+} // namespace
+
+PerfCounters::PerfCounters() {
+  m_fds.fill(-1);
+
+  for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+    const int fd = open_event(EVENT_SPECS[i], m_leader_fd);
+    if (fd < 0) {
+      continue;
+    }
+
+    if (m_leader_fd < 0) {
+      m_leader_fd = fd;
+    }
+
+    m_fds[i] = fd;
+    m_group_order[m_group_size++] = static_cast<uint8_t>(i);
+  }
+
+  if (m_leader_fd >= 0) {
+    ::ioctl(m_leader_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ::ioctl(m_leader_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+}
+
+PerfCounters::~PerfCounters() {
+  for (int fd : m_fds) {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+}
+
+PerfSample PerfCounters::read() const noexcept {
+  PerfSample sample;
+  if (m_leader_fd < 0) {
+    return sample;
+  }
+
+  // Layout for PERF_FORMAT_GROUP: nr, time_enabled, time_running, values[nr]
+  std::array<uint64_t, 3 + PERF_EVENT_COUNT> buffer{};
+  const auto bytes = ::read(m_leader_fd, buffer.data(), sizeof(buffer));
+  if (bytes < static_cast<ssize_t>(3 * sizeof(uint64_t))) {
+    return sample;
+  }
+
+  const auto count = std::min<uint64_t>(buffer[0], m_group_size);
+  const auto enabled = buffer[1];
+  const auto running = buffer[2];
+  if (running == 0) {
+    // The group was never scheduled on a PMU; the zero values are not counts
+    return sample;
+  }
+
+  const double scale =
+      running < enabled
+          ? static_cast<double>(enabled) / static_cast<double>(running)
+          : 1.0;
+
+  for (size_t i = 0; i < count; ++i) {
+    const auto event = m_group_order[i];
+    sample.values[event] =
+        static_cast<uint64_t>(static_cast<double>(buffer[3 + i]) * scale);
+    sample.valid_mask |= static_cast<uint8_t>(1u << event);
+  }
+
+  return sample;
+}
+#else
+PerfCounters::PerfCounters() { m_fds.fill(-1); }
+
+PerfCounters::~PerfCounters() = default;
+
+PerfSample PerfCounters::read() const noexcept { return {}; }
+#endif
+
+const PerfCounters *thread_perf_counters() {
+  thread_local const auto counters = std::make_unique<PerfCounters>();
+  return counters->is_available() ? counters.get() : nullptr;
+}
+} // namespace velox::metrics
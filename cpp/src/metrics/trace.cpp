@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <velox/metrics/metrics.hpp>
+#include <velox/metrics/trace.hpp>
+
+namespace velox::metrics {
+namespace {
+thread_local OperationTrace t_trace_buffer;
+thread_local const PerfCounters *t_perf_counters = nullptr;
+thread_local PerfSample t_perf_start;
+
+/// @brief Escape a string for embedding in a JSON string literal
+std::string json_escape(std::string_view text) {
+  std::string escaped;
+  escaped.reserve(text.size());
+
+  for (char c : text) {
+    switch (c) {
+    case '"':
+      escaped += "\\\"";
+      break;
+    case '\\':
+      escaped += "\\\\";
+      break;
+    case '\n':
+      escaped += "\\n";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        escaped += fmt::format("\\u{:04x}", static_cast<unsigned>(c));
+      } else {
+        escaped += c;
+      }
+    }
+  }
+
+  return escaped;
+}
+
+/// @brief Convert nanoseconds to the microsecond unit Chrome expects
+double to_micros(uint64_t nanos) noexcept {
+  return static_cast<double>(nanos) / 1000.0;
+}
+} // namespace
+
+uint64_t OperationTrace::unattributed_ns() const noexcept {
+  uint64_t attributed = 0;
+  for (auto ns : phase_ns) {
+    attributed += ns;
+  }
+
+  return duration_ns > attributed ? duration_ns - attributed : 0;
+}
+
+void OperationTrace::add_span(TracePhase phase, TimePoint start,
+                              std::chrono::nanoseconds duration,
+                              std::chrono::nanoseconds nested) noexcept {
+  const auto total = std::max<int64_t>(duration.count(), 0);
+  const auto nanos = static_cast<uint64_t>(total);
+  phase_ns[static_cast<size_t>(phase)] +=
+      static_cast<uint64_t>(std::max<int64_t>(total - nested.count(), 0));
+
+  if (detail::t_phase_nested_ns) {
+    *detail::t_phase_nested_ns += total;
+  }
+
+  if (span_count >= spans.size()) {
+    ++dropped_spans;
+    return;
+  }
+
+  const auto offset = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          start - trace_epoch())
+                          .count() -
+                      static_cast<int64_t>(start_ns);
+  spans[span_count++] = TraceSpan{
+      phase,
+      static_cast<uint64_t>(std::max<int64_t>(offset, 0)),
+      nanos,
+  };
+}
+
+struct TraceRing::Slot {
+  /// Even when stable (2 * (position + 1)), odd while being written
+  std::atomic<uint64_t> sequence{0};
+  OperationTrace trace;
+};
+
+TraceRing::TraceRing(size_t capacity)
+    : m_capacity(std::max<size_t>(capacity, 1)),
+      m_slots(std::make_unique<Slot[]>(m_capacity)) {}
+
+TraceRing::~TraceRing() = default;
+
+void TraceRing::push(const OperationTrace &trace) noexcept {
+  const auto position = m_head.fetch_add(1, std::memory_order_relaxed);
+  auto &slot = m_slots[position % m_capacity];
+
+  auto expected = slot.sequence.load(std::memory_order_relaxed);
+  if ((expected & 1) != 0 ||
+      !slot.sequence.compare_exchange_strong(expected, expected | 1,
+                                             std::memory_order_acquire)) {
+    // Another writer lapped the ring onto this slot; drop rather than wait
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(&slot.trace, &trace, sizeof(OperationTrace));
+  slot.sequence.store(2 * (position + 1), std::memory_order_release);
+}
+
+std::vector<OperationTrace> TraceRing::snapshot() const {
+  std::vector<OperationTrace> traces;
+  traces.reserve(m_capacity);
+
+  OperationTrace copy;
+  for (size_t i = 0; i < m_capacity; ++i) {
+    const auto &slot = m_slots[i];
+
+    const auto before = slot.sequence.load(std::memory_order_acquire);
+    if (before == 0 || (before & 1) != 0) {
+      continue;
+    }
+
+    std::memcpy(&copy, &slot.trace, sizeof(OperationTrace));
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (slot.sequence.load(std::memory_order_relaxed) == before) {
+      traces.push_back(copy);
+    }
+  }
+
+  std::sort(traces.begin(), traces.end(), [](const auto &a, const auto &b) {
+    return a.start_ns < b.start_ns;
+  });
+
+  return traces;
+}
+
+void TraceRing::clear() noexcept {
+  for (size_t i = 0; i < m_capacity; ++i) {
+    auto expected = m_slots[i].sequence.load(std::memory_order_relaxed);
+    if ((expected & 1) == 0) {
+      m_slots[i].sequence.compare_exchange_strong(expected, 0,
+                                                  std::memory_order_relaxed);
+    }
+  }
+}
+
+TraceRing &global_trace_ring() {
+  static TraceRing ring;
+  return ring;
+}
+
+TimePoint trace_epoch() noexcept {
+  static const TimePoint epoch = Clock::now();
+  return epoch;
+}
+
+void set_trace_sample_rate(uint32_t one_in_n) noexcept {
+  detail::g_sample_rate.store(one_in_n, std::memory_order_relaxed);
+}
+
+uint32_t trace_sample_rate() noexcept {
+  return detail::g_sample_rate.load(std::memory_order_relaxed);
+}
+
+void TraceScope::begin(std::string_view operation) noexcept {
+  const auto epoch = trace_epoch();
+  m_start = Clock::now();
+
+  auto &trace = t_trace_buffer;
+  trace.operation = operation;
+  trace.thread_index = detail::thread_shard();
+  trace.start_ns = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(m_start - epoch)
+          .count());
+  trace.duration_ns = 0;
+  trace.phase_ns.fill(0);
+  trace.span_count = 0;
+  trace.dropped_spans = 0;
+  trace.perf = PerfSample{};
+  detail::t_phase_nested_ns = nullptr;
+
+  t_perf_counters = is_perf_sampling_enabled() ? thread_perf_counters()
+                                               : nullptr;
+  if (t_perf_counters) {
+    t_perf_start = t_perf_counters->read();
+  }
+
+  detail::t_active_trace = &trace;
+  m_owner = true;
+}
+
+void TraceScope::finish() noexcept {
+  auto &trace = t_trace_buffer;
+  if (t_perf_counters) {
+    trace.perf = t_perf_counters->read() - t_perf_start;
+  }
+
+  trace.duration_ns = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                           m_start)
+          .count());
+
+  detail::t_active_trace = nullptr;
+  global_trace_ring().push(trace);
+}
+
+std::string to_chrome_trace_json(std::span<const OperationTrace> traces) {
+  std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+
+  auto append_event = [&](std::string event) {
+    if (!first) {
+      json += ',';
+    }
+
+    json += event;
+    first = false;
+  };
+
+  for (const auto &trace : traces) {
+    std::string args;
+    for (size_t p = 0; p < TRACE_PHASE_COUNT; ++p) {
+      args += fmt::format("\"{}_us\":{:.3f},",
+                          to_string(static_cast<TracePhase>(p)),
+                          to_micros(trace.phase_ns[p]));
+    }
+    args += fmt::format("\"unattributed_us\":{:.3f},\"dropped_spans\":{}",
+                        to_micros(trace.unattributed_ns()),
+                        trace.dropped_spans);
+    for (size_t e = 0; e < PERF_EVENT_COUNT; ++e) {
+      const auto event = static_cast<PerfEvent>(e);
+      if (trace.perf.has(event)) {
+        args += fmt::format(",\"{}\":{}", to_string(event),
+                            trace.perf.get(event));
+      }
+    }
+    if (trace.perf.ipc() > 0.0) {
+      args += fmt::format(",\"ipc\":{:.3f}", trace.perf.ipc());
+    }
+
+    append_event(fmt::format(
+        "{{\"name\":\"{}\",\"cat\":\"operation\",\"ph\":\"X\",\"ts\":{:.3f},"
+        "\"dur\":{:.3f},\"pid\":1,\"tid\":{},\"args\":{{{}}}}}",
+        json_escape(trace.operation), to_micros(trace.start_ns),
+        to_micros(trace.duration_ns), trace.thread_index, args));
+
+    for (uint32_t s = 0; s < trace.span_count; ++s) {
+      const auto &span = trace.spans[s];
+      append_event(fmt::format(
+          "{{\"name\":\"{}\",\"cat\":\"phase\",\"ph\":\"X\",\"ts\":{:.3f},"
+          "\"dur\":{:.3f},\"pid\":1,\"tid\":{}}}",
+          to_string(span.phase), to_micros(trace.start_ns + span.start_ns),
+          to_micros(span.duration_ns), trace.thread_index));
+    }
+  }
+
+  json += "]}";
+  return json;
+}
+
+error::VoidResult dump_chrome_trace(const std::filesystem::path &file) {
+  const auto traces = global_trace_ring().snapshot();
+
+  std::ofstream outfile(file, std::ios::trunc);
+  if (!outfile) {
+    return error::error<void>(error::ErrorCode::IO_ERROR);
+  }
+
+  outfile << to_chrome_trace_json(traces);
+  if (!outfile) {
+    return error::error<void>(error::ErrorCode::IO_ERROR);
+  }
+
+  return error::ok();
+}
+} // namespace velox::metrics
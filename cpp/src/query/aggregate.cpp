@@ -0,0 +1,1365 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <iterator>
+#include <mutex>
+#include <velox/query/operators.hpp>
+#include <velox/query/partition.hpp>
+#include <velox/query/worker_pool.hpp>
+
+namespace velox::query {
+namespace {
+using dtypes::TypeId;
+using dtypes::TypeInfo;
+
+constexpr uint32_t EMPTY_SLOT = 0;
+
+/// @brief Initial slot count of the group table (power of two)
+constexpr size_t INITIAL_SLOTS = 1024;
+
+Schema aggregate_schema(const Schema &input,
+                        const std::vector<size_t> &group_by,
+                        const std::vector<AggregateSpec> &aggregates) {
+  Schema schema;
+  for (auto column : group_by) {
+    schema.push_back(column < input.size()
+                         ? input[column]
+                         : dtypes::ColumnInfo("?", TypeId::NULL_TYPE));
+  }
+
+  for (const auto &spec : aggregates) {
+    const bool resolved = spec.function == AggregateFunction::COUNT_STAR ||
+                          spec.column < input.size();
+    const TypeInfo input_type =
+        resolved && spec.function != AggregateFunction::COUNT_STAR
+            ? input[spec.column].type
+            : TypeInfo(TypeId::BIGINT);
+    auto name = spec.name;
+    if (name.empty()) {
+      name = spec.function == AggregateFunction::COUNT_STAR
+                 ? "count(*)"
+                 : fmt::format("{}({})", to_string(spec.function),
+                               resolved ? input[spec.column].name : "?");
+    }
+    // NULL_TYPE marks an unresolvable aggregate; next() reports it
+    schema.emplace_back(std::move(name),
+                        resolved ? aggregate_type(spec.function, input_type)
+                                       .value_or(TypeId::NULL_TYPE)
+                                 : TypeInfo(TypeId::NULL_TYPE));
+  }
+
+  return schema;
+}
+
+/**
+ * @brief Running state of one aggregate for every group
+ *
+ * @note Integral inputs (including DECIMAL and temporal types) accumulate
+ *       exactly in int64, floating inputs in double. counts[g] is the
+ *       number of values folded into group g, which also tells whether
+ *       SUM / MIN / MAX / AVG are still NULL. The state of a group can be
+ *       written out as partial columns (count, then the running value
+ *       unless counting) and merged into another accumulator. An integral
+ *       sum that leaves int64 sets overflowed instead of wrapping.
+ */
+struct Accumulator {
+  AggregateSpec spec;
+  TypeInfo input_type;
+  TypeInfo result_type;
+  std::vector<int64_t> counts;
+  std::vector<int64_t> integers;
+  std::vector<double> doubles;
+  std::vector<std::string> strings;
+  bool overflowed{false};
+
+  [[nodiscard]] PhysicalType input_physical() const noexcept {
+    return physical_type(input_type.type_id);
+  }
+
+  [[nodiscard]] bool counts_only() const noexcept {
+    return spec.function == AggregateFunction::COUNT_STAR ||
+           spec.function == AggregateFunction::COUNT;
+  }
+
+  void resize(size_t groups) {
+    counts.resize(groups, 0);
+    if (counts_only()) {
+      return;
+    }
+
+    const auto physical = input_physical();
+    if (physical == PhysicalType::VARLEN) {
+      strings.resize(groups);
+    } else if (is_integral(physical)) {
+      integers.resize(groups, 0);
+    } else {
+      doubles.resize(groups, 0.0);
+    }
+  }
+
+  /// @brief Add to a running sum, flagging int64 overflow
+  template <typename Acc> void add(Acc &sum, Acc value) noexcept {
+    if constexpr (std::is_integral_v<Acc>) {
+      overflowed |= __builtin_add_overflow(sum, value, &sum);
+    } else {
+      sum += value;
+    }
+  }
+
+  /// @brief Drop every group, keeping the allocations
+  void clear() noexcept {
+    counts.clear();
+    integers.clear();
+    doubles.clear();
+    strings.clear();
+  }
+
+  [[nodiscard]] size_t memory_usage() const noexcept {
+    size_t bytes = (counts.capacity() + integers.capacity()) *
+                       sizeof(int64_t) +
+                   doubles.capacity() * sizeof(double) +
+                   strings.capacity() * sizeof(std::string);
+    for (const auto &value : strings) {
+      bytes += value.capacity();
+    }
+    return bytes;
+  }
+
+  void update(const ColumnVector &input, const uint32_t *groups, size_t n) {
+    if (spec.function == AggregateFunction::COUNT_STAR) {
+      for (size_t i = 0; i < n; ++i) {
+        ++counts[groups[i]];
+      }
+      return;
+    }
+
+    if (spec.function == AggregateFunction::COUNT) {
+      for (size_t i = 0; i < n; ++i) {
+        counts[groups[i]] += input.is_valid(i) ? 1 : 0;
+      }
+      return;
+    }
+
+    if (input.physical() == PhysicalType::VARLEN) {
+      const bool is_min = spec.function == AggregateFunction::MIN;
+      for (size_t i = 0; i < n; ++i) {
+        if (!input.is_valid(i)) {
+          continue;
+        }
+        const auto g = groups[i];
+        const auto value = input.string_at(i);
+        if (counts[g]++ == 0 || (is_min ? value < strings[g]
+                                        : value > strings[g])) {
+          strings[g].assign(value);
+        }
+      }
+      return;
+    }
+
+    dispatch_fixed(input.physical(), [&](auto tag) {
+      using T = typename decltype(tag)::type;
+      if constexpr (std::is_floating_point_v<T>) {
+        fold<T>(input, groups, n, doubles);
+      } else {
+        fold<T>(input, groups, n, integers);
+      }
+    });
+  }
+
+  template <typename T, typename Acc>
+  void fold(const ColumnVector &input, const uint32_t *groups, size_t n,
+            std::vector<Acc> &state) {
+    const T *values = input.data<T>();
+    const bool nulls = input.may_have_nulls();
+
+    switch (spec.function) {
+    case AggregateFunction::SUM:
+    case AggregateFunction::AVG:
+      for (size_t i = 0; i < n; ++i) {
+        if (nulls && !input.is_valid(i)) {
+          continue;
+        }
+        add(state[groups[i]], static_cast<Acc>(values[i]));
+        ++counts[groups[i]];
+      }
+      break;
+    case AggregateFunction::MIN:
+    case AggregateFunction::MAX: {
+      const bool is_min = spec.function == AggregateFunction::MIN;
+      for (size_t i = 0; i < n; ++i) {
+        if (nulls && !input.is_valid(i)) {
+          continue;
+        }
+        const auto g = groups[i];
+        const auto value = static_cast<Acc>(values[i]);
+        if (counts[g]++ == 0 ||
+            (is_min ? value < state[g] : value > state[g])) {
+          state[g] = value;
+        }
+      }
+      break;
+    }
+    default:
+      break;
+    }
+  }
+
+  /**
+   * @brief Fold every row into group 0
+   *
+   * @note Global aggregates reduce in locals rather than through the
+   *       group id scatter, so the loops carry no memory dependency.
+   */
+  void update_all(const ColumnVector &input, size_t n) {
+    if (spec.function == AggregateFunction::COUNT_STAR) {
+      counts[0] += static_cast<int64_t>(n);
+      return;
+    }
+
+    if (spec.function == AggregateFunction::COUNT) {
+      counts[0] += static_cast<int64_t>(valid_count(input, n));
+      return;
+    }
+
+    if (input.physical() == PhysicalType::VARLEN) {
+      const bool is_min = spec.function == AggregateFunction::MIN;
+      for (size_t i = 0; i < n; ++i) {
+        if (!input.is_valid(i)) {
+          continue;
+        }
+        const auto value = input.string_at(i);
+        if (counts[0]++ == 0 || (is_min ? value < strings[0]
+                                        : value > strings[0])) {
+          strings[0].assign(value);
+        }
+      }
+      return;
+    }
+
+    dispatch_fixed(input.physical(), [&](auto tag) {
+      using T = typename decltype(tag)::type;
+      if constexpr (std::is_floating_point_v<T>) {
+        reduce<T>(input, n, doubles[0]);
+      } else {
+        reduce<T>(input, n, integers[0]);
+      }
+    });
+  }
+
+  [[nodiscard]] static size_t valid_count(const ColumnVector &input,
+                                          size_t n) noexcept {
+    if (!input.may_have_nulls()) {
+      return n;
+    }
+
+    size_t valid = 0;
+    const uint64_t *words = input.validity();
+    for (size_t w = 0; w * 64 < n; ++w) {
+      const size_t bits = std::min<size_t>(64, n - w * 64);
+      const uint64_t mask = bits == 64 ? ~uint64_t{0}
+                                       : (uint64_t{1} << bits) - 1;
+      valid += static_cast<size_t>(std::popcount(words[w] & mask));
+    }
+    return valid;
+  }
+
+  template <typename T, typename Acc>
+  void reduce(const ColumnVector &input, size_t n, Acc &state) {
+    const T *values = input.data<T>();
+    const bool nulls = input.may_have_nulls();
+
+    switch (spec.function) {
+    case AggregateFunction::SUM:
+    case AggregateFunction::AVG: {
+      Acc sum{};
+      if (!nulls) {
+        for (size_t i = 0; i < n; ++i) {
+          add(sum, static_cast<Acc>(values[i]));
+        }
+      } else {
+        for (size_t i = 0; i < n; ++i) {
+          add(sum, input.is_valid(i) ? static_cast<Acc>(values[i]) : Acc{});
+        }
+      }
+      add(state, sum);
+      counts[0] += static_cast<int64_t>(valid_count(input, n));
+      break;
+    }
+    case AggregateFunction::MIN:
+    case AggregateFunction::MAX: {
+      const bool is_min = spec.function == AggregateFunction::MIN;
+      size_t i = 0;
+      while (i < n && nulls && !input.is_valid(i)) {
+        ++i;
+      }
+      if (i == n) {
+        break;
+      }
+
+      auto best = static_cast<Acc>(values[i]);
+      if (!nulls) {
+        if (is_min) {
+          for (++i; i < n; ++i) {
+            best = std::min(best, static_cast<Acc>(values[i]));
+          }
+        } else {
+          for (++i; i < n; ++i) {
+            best = std::max(best, static_cast<Acc>(values[i]));
+          }
+        }
+      } else {
+        for (++i; i < n; ++i) {
+          if (input.is_valid(i)) {
+            const auto value = static_cast<Acc>(values[i]);
+            best = is_min ? std::min(best, value) : std::max(best, value);
+          }
+        }
+      }
+
+      if (counts[0] == 0 || (is_min ? best < state : best > state)) {
+        state = best;
+      }
+      counts[0] += static_cast<int64_t>(valid_count(input, n));
+      break;
+    }
+    default:
+      break;
+    }
+  }
+
+  /// @brief Type of the running value column of a partial state
+  [[nodiscard]] TypeInfo state_type() const {
+    const auto physical = input_physical();
+    if (physical == PhysicalType::VARLEN) {
+      return input_type;
+    }
+    return is_integral(physical) ? TypeInfo(TypeId::BIGINT)
+                                 : TypeInfo(TypeId::DOUBLE);
+  }
+
+  /// @brief Append the partial state columns to a layout
+  void state_schema(Schema &layout) const {
+    layout.emplace_back("$count", TypeInfo(TypeId::BIGINT));
+    if (!counts_only()) {
+      layout.emplace_back("$value", state_type());
+    }
+  }
+
+  /**
+   * @brief Write the state of groups [first, first + n) as partial columns
+   *
+   * @param out Chunk with a state_schema() layout at column
+   * @return Column after this accumulator's state
+   */
+  size_t emit_state(size_t first, size_t n, DataChunk &out,
+                    size_t column) const {
+    auto &count = out.column(column);
+    for (size_t g = first; g < first + n; ++g) {
+      count.append<int64_t>(counts[g]);
+    }
+    if (counts_only()) {
+      return column + 1;
+    }
+
+    auto &value = out.column(column + 1);
+    const auto physical = input_physical();
+    for (size_t g = first; g < first + n; ++g) {
+      if (physical == PhysicalType::VARLEN) {
+        value.append_string(strings[g]);
+      } else if (is_integral(physical)) {
+        value.append<int64_t>(integers[g]);
+      } else {
+        value.append<double>(doubles[g]);
+      }
+    }
+    return column + 2;
+  }
+
+  /**
+   * @brief Merge partial states written by emit_state()
+   *
+   * @param partial Chunk holding the states at column
+   * @param groups Target group of every partial row
+   * @param n Number of partial rows
+   * @return Column after this accumulator's state
+   */
+  size_t merge(const DataChunk &partial, size_t column, const uint32_t *groups,
+               size_t n) {
+    const int64_t *partial_counts = partial.column(column).data<int64_t>();
+    if (counts_only()) {
+      for (size_t i = 0; i < n; ++i) {
+        counts[groups[i]] += partial_counts[i];
+      }
+      return column + 1;
+    }
+
+    const auto &value = partial.column(column + 1);
+    const auto physical = input_physical();
+    if (physical == PhysicalType::VARLEN) {
+      const bool is_min = spec.function == AggregateFunction::MIN;
+      for (size_t i = 0; i < n; ++i) {
+        const auto g = groups[i];
+        if (partial_counts[i] == 0) {
+          continue;
+        }
+        const auto candidate = value.string_at(i);
+        if (counts[g] == 0 || (is_min ? candidate < strings[g]
+                                      : candidate > strings[g])) {
+          strings[g].assign(candidate);
+        }
+        counts[g] += partial_counts[i];
+      }
+    } else if (is_integral(physical)) {
+      merge_values(value.data<int64_t>(), partial_counts, groups, n, integers);
+    } else {
+      merge_values(value.data<double>(), partial_counts, groups, n, doubles);
+    }
+    return column + 2;
+  }
+
+  template <typename Acc>
+  void merge_values(const Acc *values, const int64_t *partial_counts,
+                    const uint32_t *groups, size_t n,
+                    std::vector<Acc> &state) {
+    if (spec.function == AggregateFunction::SUM ||
+        spec.function == AggregateFunction::AVG) {
+      for (size_t i = 0; i < n; ++i) {
+        add(state[groups[i]], values[i]);
+        counts[groups[i]] += partial_counts[i];
+      }
+      return;
+    }
+
+    const bool is_min = spec.function == AggregateFunction::MIN;
+    for (size_t i = 0; i < n; ++i) {
+      const auto g = groups[i];
+      if (partial_counts[i] == 0) {
+        continue;
+      }
+      if (counts[g] == 0 ||
+          (is_min ? values[i] < state[g] : values[i] > state[g])) {
+        state[g] = values[i];
+      }
+      counts[g] += partial_counts[i];
+    }
+  }
+
+  void emit(size_t group, ColumnVector &out) const {
+    switch (spec.function) {
+    case AggregateFunction::COUNT_STAR:
+    case AggregateFunction::COUNT:
+      out.append<int64_t>(counts[group]);
+      return;
+    default:
+      break;
+    }
+
+    if (counts[group] == 0) {
+      out.append_null();
+      return;
+    }
+
+    const auto physical = input_physical();
+    if (spec.function == AggregateFunction::AVG) {
+      const double sum = is_integral(physical)
+                             ? static_cast<double>(integers[group])
+                             : doubles[group];
+      const auto divisor =
+          static_cast<double>(counts[group]) *
+          static_cast<double>(scale_factor(
+              input_type.type_id == TypeId::DECIMAL ? input_type.scale : 0));
+      out.append<double>(sum / divisor);
+    } else if (physical == PhysicalType::VARLEN) {
+      out.append_string(strings[group]);
+    } else {
+      dispatch_fixed(out.physical(), [&](auto tag) {
+        using T = typename decltype(tag)::type;
+        out.append<T>(is_integral(physical)
+                          ? static_cast<T>(integers[group])
+                          : static_cast<T>(doubles[group]));
+      });
+    }
+  }
+};
+} // namespace
+
+std::optional<TypeInfo> aggregate_type(AggregateFunction function,
+                                       const TypeInfo &input) {
+  const auto id = input.type_id;
+
+  switch (function) {
+  case AggregateFunction::COUNT_STAR:
+  case AggregateFunction::COUNT:
+    return TypeInfo(TypeId::BIGINT);
+  case AggregateFunction::SUM:
+    if (id == TypeId::DECIMAL) {
+      return TypeInfo(TypeId::DECIMAL, config::DECIMAL_PRECISION,
+                      input.scale);
+    }
+    if (id == TypeId::REAL || id == TypeId::DOUBLE) {
+      return TypeInfo(TypeId::DOUBLE);
+    }
+    if (dtypes::is_numeric(id)) {
+      return TypeInfo(TypeId::BIGINT);
+    }
+    return std::nullopt;
+  case AggregateFunction::AVG:
+    if (dtypes::is_numeric(id)) {
+      return TypeInfo(TypeId::DOUBLE);
+    }
+    return std::nullopt;
+  case AggregateFunction::MIN:
+  case AggregateFunction::MAX:
+    if (id == TypeId::NULL_TYPE) {
+      return std::nullopt;
+    }
+    return input;
+  }
+
+  return std::nullopt;
+}
+
+namespace {
+/// @brief Groups a thread-local table holds before it is flushed (~L2)
+constexpr size_t LOCAL_GROUPS = 16 * 1024;
+
+/// @brief Input chunks claimed per parallel pre-aggregation round, per thread
+constexpr size_t CHUNKS_PER_THREAD = 4;
+
+/// @brief Marker for a NULL group that does not exist yet
+constexpr uint32_t NO_GROUP = UINT32_MAX;
+
+/// @brief Hash bits a partition over budget is split on per level
+constexpr unsigned REPARTITION_BITS = 4;
+
+error::VoidResult validate_schema(const Schema &schema) {
+  for (const auto &column : schema) {
+    if (column.type.type_id == TypeId::NULL_TYPE) {
+      return error::error<void>(error::ErrorCode::SEMANTIC_ERROR);
+    }
+  }
+  return error::ok();
+}
+
+/// @brief Render "by a, b: COUNT(x), SUM(y)" for EXPLAIN
+std::string describe(const Schema &schema, size_t groups, size_t aggregates) {
+  std::string group_names;
+  for (size_t k = 0; k < groups; ++k) {
+    group_names += (k == 0 ? "" : ", ") + schema[k].name;
+  }
+
+  std::string aggregate_names;
+  for (size_t a = 0; a < aggregates; ++a) {
+    aggregate_names += (a == 0 ? "" : ", ") + schema[groups + a].name;
+  }
+
+  return group_names.empty()
+             ? aggregate_names
+             : fmt::format("by {}: {}", group_names, aggregate_names);
+}
+
+/**
+ * @brief Groups of an aggregation and their accumulators
+ *
+ * @note Groups live in an open-addressing table of group id + 1 keyed by
+ *       a vectorized hash of the group columns. A single integral group
+ *       column is also kept as a flat int64 array and compared directly,
+ *       with its NULL group held outside the table. The table folds input
+ *       rows (consume) or partial states of another table (merge, see
+ *       emit_partial).
+ */
+class GroupTable {
+public:
+  GroupTable(const Schema &input, const std::vector<size_t> &group_by,
+             const std::vector<AggregateSpec> &aggregates)
+      : m_group_by(group_by), m_slots(INITIAL_SLOTS, EMPTY_SLOT) {
+    Schema key_schema;
+    for (auto column : group_by) {
+      key_schema.push_back(input[column]);
+    }
+    m_keys.initialize(key_schema);
+    m_int_key = group_by.size() == 1 &&
+                is_integral(physical_type(key_schema[0].type.type_id));
+
+    for (const auto &spec : aggregates) {
+      auto &accumulator = m_accumulators.emplace_back();
+      accumulator.spec = spec;
+      if (spec.function != AggregateFunction::COUNT_STAR) {
+        accumulator.input_type = input[spec.column].type;
+      }
+      accumulator.result_type =
+          *aggregate_type(spec.function, accumulator.input_type);
+    }
+
+    add_global_group();
+  }
+
+  /// @brief Get the number of groups
+  [[nodiscard]] size_t size() const noexcept { return m_group_count; }
+
+  /// @brief Get the group hashes, by group id
+  [[nodiscard]] std::span<const uint64_t> hashes() const noexcept {
+    return m_group_hashes;
+  }
+
+  /// @brief Get the layout written by emit_partial()
+  [[nodiscard]] Schema partial_layout() const {
+    Schema layout;
+    for (size_t k = 0; k < m_keys.column_count(); ++k) {
+      layout.emplace_back(fmt::format("$key{}", k), m_keys.column(k).type());
+    }
+    for (const auto &accumulator : m_accumulators) {
+      accumulator.state_schema(layout);
+    }
+    return with_hash_column(layout);
+  }
+
+  /**
+   * @brief Fold one input chunk into the groups
+   *
+   * @return Success, NUMERIC_OVERFLOW once an integral sum leaves int64, or
+   *         OUT_OF_MEMORY once the group keys outgrow a string heap
+   */
+  [[nodiscard]] error::VoidResult consume(const DataChunk &input) {
+    const size_t n = input.size();
+    if (m_group_by.empty()) {
+      for (auto &accumulator : m_accumulators) {
+        accumulator.update_all(aggregate_input(accumulator, input), n);
+      }
+      return check_overflow();
+    }
+
+    m_hashes.resize(n);
+    m_key_columns.clear();
+    for (size_t k = 0; k < m_group_by.size(); ++k) {
+      const auto &column = input.column(m_group_by[k]);
+      column.hash(m_hashes, k > 0);
+      m_key_columns.push_back(&column);
+    }
+    if (auto room = check_key_heap(); !room) {
+      return room;
+    }
+    assign_groups(m_hashes.data(), n);
+
+    for (auto &accumulator : m_accumulators) {
+      accumulator.resize(m_group_count);
+      accumulator.update(aggregate_input(accumulator, input),
+                         m_group_ids.data(), n);
+    }
+    return check_overflow();
+  }
+
+  /**
+   * @brief Fold a chunk of emit_partial() rows into the groups
+   *
+   * @return Success, NUMERIC_OVERFLOW once an integral sum leaves int64, or
+   *         OUT_OF_MEMORY once the group keys outgrow a string heap
+   */
+  [[nodiscard]] error::VoidResult merge(const DataChunk &partial) {
+    const size_t n = partial.size();
+    if (m_group_by.empty()) {
+      m_group_ids.assign(n, 0);
+    } else {
+      m_key_columns.clear();
+      for (size_t k = 0; k < m_group_by.size(); ++k) {
+        m_key_columns.push_back(&partial.column(k));
+      }
+      if (auto room = check_key_heap(); !room) {
+        return room;
+      }
+      assign_groups(hash_column(partial), n);
+    }
+
+    size_t column = m_group_by.size();
+    for (auto &accumulator : m_accumulators) {
+      accumulator.resize(m_group_count);
+      column = accumulator.merge(partial, column, m_group_ids.data(), n);
+    }
+    return check_overflow();
+  }
+
+  /**
+   * @brief Append the final rows of groups [first, first + n)
+   *
+   * @param output Chunk with the aggregate's output layout
+   */
+  void emit(size_t first, size_t n, DataChunk &output) const {
+    const size_t keys = m_group_by.size();
+    for (size_t k = 0; k < keys; ++k) {
+      output.column(k).append_range(m_keys.column(k), first, n);
+    }
+    for (size_t a = 0; a < m_accumulators.size(); ++a) {
+      auto &column = output.column(keys + a);
+      for (size_t g = first; g < first + n; ++g) {
+        m_accumulators[a].emit(g, column);
+      }
+    }
+    output.set_size(output.size() + n);
+  }
+
+  /**
+   * @brief Append every group as a partial state row
+   *
+   * @param output Chunk with the partial_layout()
+   */
+  void emit_partial(DataChunk &output) const {
+    const size_t keys = m_group_by.size();
+    for (size_t k = 0; k < keys; ++k) {
+      output.column(k).append_range(m_keys.column(k), 0, m_group_count);
+    }
+    size_t column = keys;
+    for (const auto &accumulator : m_accumulators) {
+      column = accumulator.emit_state(0, m_group_count, output, column);
+    }
+    auto &hashes = output.column(column);
+    for (auto hash : m_group_hashes) {
+      hashes.append<uint64_t>(hash);
+    }
+    output.set_size(output.size() + m_group_count);
+  }
+
+  /// @brief Drop every group, keeping the allocations
+  void clear() {
+    m_keys.clear();
+    m_group_hashes.clear();
+    m_int_keys.clear();
+    std::fill(m_slots.begin(), m_slots.end(), EMPTY_SLOT);
+    m_group_count = 0;
+    m_null_group = NO_GROUP;
+    for (auto &accumulator : m_accumulators) {
+      accumulator.clear();
+    }
+    add_global_group();
+  }
+
+  /// @brief Get the bytes held by the table
+  [[nodiscard]] size_t memory_usage() const noexcept {
+    size_t bytes = m_keys.memory_usage() +
+                   m_group_hashes.capacity() * sizeof(uint64_t) +
+                   m_int_keys.capacity() * sizeof(int64_t) +
+                   m_slots.capacity() * sizeof(uint32_t);
+    for (const auto &accumulator : m_accumulators) {
+      bytes += accumulator.memory_usage();
+    }
+    return bytes;
+  }
+
+private:
+  [[nodiscard]] error::VoidResult check_overflow() const {
+    for (const auto &accumulator : m_accumulators) {
+      if (accumulator.overflowed) {
+        return error::error<void>(error::ErrorCode::NUMERIC_OVERFLOW);
+      }
+    }
+    return error::ok();
+  }
+
+  /// @brief New groups copy their keys into m_keys, whose heaps are 32-bit
+  [[nodiscard]] error::VoidResult check_key_heap() const {
+    for (size_t k = 0; k < m_key_columns.size(); ++k) {
+      if (!m_keys.column(k).heap_fits(m_key_columns[k]->heap().size())) {
+        return error::error<void>(error::ErrorCode::OUT_OF_MEMORY);
+      }
+    }
+    return error::ok();
+  }
+
+  /// @brief A global aggregate has exactly one group, present even without
+  ///        input
+  void add_global_group() {
+    if (m_group_by.empty()) {
+      add_group(0);
+      for (auto &accumulator : m_accumulators) {
+        accumulator.resize(m_group_count);
+      }
+    }
+  }
+
+  const ColumnVector &aggregate_input(const Accumulator &accumulator,
+                                      const DataChunk &input) const {
+    return accumulator.spec.function == AggregateFunction::COUNT_STAR
+               ? m_empty
+               : input.column(accumulator.spec.column);
+  }
+
+  /// @brief Map rows of m_key_columns to group ids, adding new groups
+  void assign_groups(const uint64_t *hashes, size_t n) {
+    m_group_ids.resize(n);
+    if (m_int_key) {
+      const auto &column = *m_key_columns[0];
+      dispatch_fixed(column.physical(), [&](auto tag) {
+        using T = typename decltype(tag)::type;
+        assign_int_groups(column.data<T>(), column, hashes, n);
+      });
+    } else {
+      for (size_t i = 0; i < n; ++i) {
+        const auto hash = hashes[i];
+        const auto mask = m_slots.size() - 1;
+        for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+          const auto entry = m_slots[slot];
+          if (entry == EMPTY_SLOT) {
+            m_slots[slot] = static_cast<uint32_t>(m_group_count + 1);
+            m_group_ids[i] = static_cast<uint32_t>(m_group_count);
+            add_group(hash);
+            for (size_t k = 0; k < m_key_columns.size(); ++k) {
+              m_keys.column(k).append_from(*m_key_columns[k], i);
+            }
+            break;
+          }
+
+          const auto group = entry - 1;
+          if (m_group_hashes[group] == hash && keys_equal(group, i)) {
+            m_group_ids[i] = group;
+            break;
+          }
+        }
+
+        if (m_group_count * 2 > m_slots.size()) {
+          grow();
+        }
+      }
+    }
+    m_keys.set_size(m_group_count);
+  }
+
+  template <typename T>
+  void assign_int_groups(const T *values, const ColumnVector &column,
+                         const uint64_t *hashes, size_t n) {
+    const bool nulls = column.may_have_nulls();
+    for (size_t i = 0; i < n; ++i) {
+      if (nulls && !column.is_valid(i)) {
+        if (m_null_group == NO_GROUP) {
+          m_null_group = static_cast<uint32_t>(m_group_count);
+          m_int_keys.push_back(0);
+          add_group(hashes[i]);
+          m_keys.column(0).append_null();
+        }
+        m_group_ids[i] = m_null_group;
+        continue;
+      }
+
+      const auto key = static_cast<int64_t>(values[i]);
+      const auto mask = m_slots.size() - 1;
+      for (size_t slot = hashes[i] & mask;; slot = (slot + 1) & mask) {
+        const auto entry = m_slots[slot];
+        if (entry == EMPTY_SLOT) {
+          m_slots[slot] = static_cast<uint32_t>(m_group_count + 1);
+          m_group_ids[i] = static_cast<uint32_t>(m_group_count);
+          m_int_keys.push_back(key);
+          add_group(hashes[i]);
+          m_keys.column(0).append_from(column, i);
+          break;
+        }
+        if (m_int_keys[entry - 1] == key) {
+          m_group_ids[i] = entry - 1;
+          break;
+        }
+      }
+
+      if (m_group_count * 2 > m_slots.size()) {
+        grow();
+      }
+    }
+  }
+
+  [[nodiscard]] bool keys_equal(size_t group, size_t row) const noexcept {
+    for (size_t k = 0; k < m_key_columns.size(); ++k) {
+      if (!m_keys.column(k).equals(group, *m_key_columns[k], row)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  void add_group(uint64_t hash) {
+    m_group_hashes.push_back(hash);
+    ++m_group_count;
+  }
+
+  void grow() {
+    std::vector<uint32_t> slots(m_slots.size() * 2, EMPTY_SLOT);
+    const size_t mask = slots.size() - 1;
+    for (size_t group = 0; group < m_group_count; ++group) {
+      if (group == m_null_group) {
+        continue;
+      }
+      size_t slot = m_group_hashes[group] & mask;
+      while (slots[slot] != EMPTY_SLOT) {
+        slot = (slot + 1) & mask;
+      }
+      slots[slot] = static_cast<uint32_t>(group + 1);
+    }
+    m_slots = std::move(slots);
+  }
+
+  std::vector<size_t> m_group_by;
+  DataChunk m_keys; ///< One row per group: the group column values
+  std::vector<uint64_t> m_group_hashes;
+  std::vector<uint32_t> m_slots; ///< Group id + 1, or EMPTY_SLOT
+  size_t m_group_count{0};
+  bool m_int_key{false};
+  std::vector<int64_t> m_int_keys; ///< Single integral key, by group id
+  uint32_t m_null_group{NO_GROUP}; ///< Group of NULL single integral keys
+  std::vector<Accumulator> m_accumulators;
+  std::vector<const ColumnVector *> m_key_columns;
+  std::vector<uint64_t> m_hashes;
+  std::vector<uint32_t> m_group_ids;
+  ColumnVector m_empty;
+};
+
+error::VoidResult first_error(const std::vector<error::VoidResult> &results) {
+  for (const auto &result : results) {
+    if (!result) {
+      return result;
+    }
+  }
+  return error::ok();
+}
+} // namespace
+
+/// @brief Group table and emit cursor of a HashAggregate
+class HashAggregate::State {
+public:
+  State(const Schema &input, const std::vector<size_t> &group_by,
+        const std::vector<AggregateSpec> &aggregates)
+      : table(input, group_by, aggregates) {}
+
+  /// @brief Emit the next batch of groups; false once all are out
+  bool emit(DataChunk &output) {
+    if (emitted >= table.size()) {
+      return false;
+    }
+
+    const auto count = std::min(config::VECTOR_SIZE, table.size() - emitted);
+    table.emit(emitted, count, output);
+    emitted += count;
+
+    return true;
+  }
+
+  GroupTable table;
+  size_t emitted{0};
+  bool consumed{false};
+};
+
+HashAggregate::HashAggregate(OperatorPtr child, std::vector<size_t> group_by,
+                             std::vector<AggregateSpec> aggregates)
+    : Operator(aggregate_schema(child->schema(), group_by, aggregates)),
+      m_child(std::move(child)), m_group_by(std::move(group_by)),
+      m_aggregates(std::move(aggregates)) {}
+
+HashAggregate::~HashAggregate() = default;
+
+error::Result<bool> HashAggregate::next(DataChunk &output) {
+  if (!m_state) {
+    if (auto valid = validate_schema(schema()); !valid) {
+      return tl::unexpected(valid.error());
+    }
+    m_state = std::make_unique<State>(m_child->schema(), m_group_by,
+                                      m_aggregates);
+  }
+
+  if (!m_state->consumed) {
+    DataChunk input;
+    while (true) {
+      auto more = m_child->next(input);
+      if (!more) {
+        return tl::unexpected(more.error());
+      }
+      if (!*more) {
+        break;
+      }
+      if (auto status = m_state->table.consume(input); !status) {
+        return tl::unexpected(status.error());
+      }
+    }
+    m_state->consumed = true;
+  }
+
+  prepare(output);
+  return m_state->emit(output);
+}
+
+void HashAggregate::reset() {
+  m_child->reset();
+  m_state.reset();
+}
+
+std::string HashAggregate::name() const {
+  return fmt::format("HashAggregate({})",
+                     describe(schema(), m_group_by.size(),
+                              m_aggregates.size()));
+}
+
+// ParallelHashAggregate
+
+/**
+ * @brief Thread-local tables, partitions of partial states and the output
+ *        of the current wave
+ *
+ * @note locals[t] is only touched by WorkerPool iteration t. Partitions
+ *       are filled concurrently by flushes, one lock each, and merged
+ *       without locks since partition p only ever becomes group set p.
+ *       Each partition of a wave writes its own output partition, which
+ *       next() then streams chunk by chunk.
+ */
+class ParallelHashAggregate::State {
+public:
+  WorkerPool &pool = WorkerPool::shared();
+  size_t threads{1};
+  unsigned partition_bits{DEFAULT_PARTITION_BITS};
+
+  struct Local {
+    GroupTable table;
+    DataChunk partial;
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> bounds;
+  };
+  std::vector<std::unique_ptr<Local>> locals;
+  Schema partial_layout;
+  std::vector<PartitionBuffer> partitions;
+  std::vector<std::mutex> locks;
+
+  size_t next_partition{0};
+  std::vector<PartitionBuffer> output; ///< Groups of the current wave
+  size_t output_position{0};           ///< Output partition being read
+
+  [[nodiscard]] size_t resident_bytes() const noexcept {
+    size_t bytes = 0;
+    for (const auto &local : locals) {
+      bytes += local->table.memory_usage() + local->partial.memory_usage();
+    }
+    for (const auto &partition : partitions) {
+      bytes += partition.resident_bytes();
+    }
+    return bytes;
+  }
+};
+
+ParallelHashAggregate::ParallelHashAggregate(
+    OperatorPtr child, std::vector<size_t> group_by,
+    std::vector<AggregateSpec> aggregates, ParallelAggregateOptions options)
+    : Operator(aggregate_schema(child->schema(), group_by, aggregates)),
+      m_child(std::move(child)), m_group_by(std::move(group_by)),
+      m_aggregates(std::move(aggregates)), m_options(std::move(options)) {}
+
+ParallelHashAggregate::~ParallelHashAggregate() = default;
+
+error::VoidResult ParallelHashAggregate::flush_local(size_t thread) {
+  auto &s = *m_state;
+  auto &local = *s.locals[thread];
+  if (local.table.size() == 0) {
+    return error::ok();
+  }
+
+  if (local.partial.column_count() == 0) {
+    local.partial.initialize(s.partial_layout, LOCAL_GROUPS);
+  }
+  local.partial.clear();
+  local.table.emit_partial(local.partial);
+  radix_order(local.table.hashes(), {}, 64 - s.partition_bits,
+              s.partition_bits, local.order, local.bounds);
+
+  for (size_t p = 0; p < s.partitions.size(); ++p) {
+    const auto rows = std::span(local.order).subspan(
+        local.bounds[p], local.bounds[p + 1] - local.bounds[p]);
+    if (rows.empty()) {
+      continue;
+    }
+    std::lock_guard<std::mutex> lock(s.locks[p]);
+    if (auto status = s.partitions[p].append(local.partial, rows); !status) {
+      return status;
+    }
+  }
+  local.table.clear();
+
+  return error::ok();
+}
+
+error::VoidResult ParallelHashAggregate::enforce_budget() {
+  auto &s = *m_state;
+  const size_t budget = m_options.memory_budget;
+  const size_t resident = s.resident_bytes();
+  if (budget == 0 || resident <= budget) {
+    return error::ok();
+  }
+
+  std::vector<PartitionBuffer *> partitions;
+  for (auto &partition : s.partitions) {
+    partitions.push_back(&partition);
+  }
+  return spill_largest(partitions, resident - budget,
+                       m_options.spill_directory, s.pool, s.threads);
+}
+
+error::VoidResult ParallelHashAggregate::partition_input() {
+  auto &s = *m_state;
+  std::vector<DataChunk> batch(s.threads * CHUNKS_PER_THREAD);
+  std::vector<error::VoidResult> results(s.threads, error::ok());
+  bool exhausted = false;
+  while (!exhausted) {
+    size_t filled = 0;
+    while (filled < batch.size()) {
+      auto more = m_child->next(batch[filled]);
+      if (!more) {
+        return tl::unexpected(more.error());
+      }
+      if (!*more) {
+        exhausted = true;
+        break;
+      }
+      ++filled;
+    }
+
+    // Chunks are claimed one at a time, so fast threads take more
+    std::atomic<size_t> next_chunk{0};
+    s.pool.parallel_for(
+        s.threads,
+        [&](size_t t) {
+          auto &table = s.locals[t]->table;
+          for (size_t i = next_chunk.fetch_add(1); i < filled;
+               i = next_chunk.fetch_add(1)) {
+            results[t] = table.consume(batch[i]);
+            if (!results[t]) {
+              return;
+            }
+            if (table.size() >= LOCAL_GROUPS) {
+              results[t] = flush_local(t);
+              if (!results[t]) {
+                return;
+              }
+            }
+          }
+        },
+        s.threads);
+    if (auto status = first_error(results); !status) {
+      return status;
+    }
+
+    if (auto status = enforce_budget(); !status) {
+      return status;
+    }
+  }
+
+  s.pool.parallel_for(
+      s.threads, [&](size_t t) { results[t] = flush_local(t); }, s.threads);
+  if (auto status = first_error(results); !status) {
+    return status;
+  }
+  s.locals.clear();
+
+  return enforce_budget();
+}
+
+error::VoidResult ParallelHashAggregate::split_partition(
+    PartitionBuffer &partition, unsigned hash_bits, size_t budget,
+    std::vector<PartitionBuffer> &pieces) {
+  auto &s = *m_state;
+  const unsigned bits = std::min(REPARTITION_BITS, 64 - hash_bits);
+  for (size_t i = 0; i < (size_t{1} << bits); ++i) {
+    pieces.emplace_back(s.partial_layout);
+  }
+  std::vector<PartitionBuffer *> candidates;
+  for (auto &piece : pieces) {
+    candidates.push_back(&piece);
+  }
+
+  DataChunk chunk;
+  std::vector<uint32_t> order;
+  std::vector<uint32_t> bounds;
+  while (true) {
+    auto more = partition.read(chunk);
+    if (!more) {
+      return tl::unexpected(more.error());
+    }
+    if (!*more) {
+      return error::ok();
+    }
+
+    radix_order({hash_column(chunk), chunk.size()}, {}, 64 - hash_bits - bits,
+                bits, order, bounds);
+    size_t resident = 0;
+    for (size_t i = 0; i < pieces.size(); ++i) {
+      const auto rows =
+          std::span(order).subspan(bounds[i], bounds[i + 1] - bounds[i]);
+      if (!rows.empty()) {
+        if (auto status = pieces[i].append(chunk, rows); !status) {
+          return status;
+        }
+      }
+      resident += pieces[i].resident_bytes();
+    }
+    if (resident > budget) {
+      if (auto status =
+              spill_largest(candidates, resident - budget,
+                            m_options.spill_directory, s.pool, 1);
+          !status) {
+        return status;
+      }
+    }
+  }
+}
+
+error::VoidResult ParallelHashAggregate::merge_partition(
+    PartitionBuffer partition, unsigned hash_bits, bool global, size_t budget,
+    PartitionBuffer &output) {
+  if (partition.rows() == 0 && !global) {
+    return error::ok();
+  }
+
+  // Too large to merge at once: split on the next hash bits and recurse
+  if (budget != 0 && partition.total_bytes() > budget &&
+      partition.rows() > config::VECTOR_SIZE && hash_bits < 64) {
+    std::vector<PartitionBuffer> pieces;
+    if (auto status = split_partition(partition, hash_bits, budget, pieces);
+        !status) {
+      return status;
+    }
+    const unsigned bits = std::min(REPARTITION_BITS, 64 - hash_bits);
+    for (size_t i = 0; i < pieces.size(); ++i) {
+      // A piece that got every row will not split better on later bits
+      // (one group, or colliding hashes), so merge it as is
+      const unsigned used =
+          pieces[i].rows() == partition.rows() ? 64 : hash_bits + bits;
+      if (auto status = merge_partition(std::move(pieces[i]), used,
+                                        global && i == 0, budget, output);
+          !status) {
+        return status;
+      }
+    }
+    return error::ok();
+  }
+
+  GroupTable table(m_child->schema(), m_group_by, m_aggregates);
+  DataChunk chunk;
+  while (true) {
+    auto more = partition.read(chunk);
+    if (!more) {
+      return tl::unexpected(more.error());
+    }
+    if (!*more) {
+      break;
+    }
+    if (auto status = table.merge(chunk); !status) {
+      return status;
+    }
+  }
+
+  for (size_t first = 0; first < table.size(); first += config::VECTOR_SIZE) {
+    DataChunk out(schema());
+    table.emit(first, std::min(config::VECTOR_SIZE, table.size() - first),
+               out);
+    if (auto status = output.append_chunk(std::move(out)); !status) {
+      return status;
+    }
+    if (budget != 0 && output.spillable_bytes() > budget) {
+      if (auto status = output.spill(m_options.spill_directory); !status) {
+        return status;
+      }
+    }
+  }
+
+  return error::ok();
+}
+
+error::Result<bool> ParallelHashAggregate::next(DataChunk &output) {
+  if (!m_state) {
+    if (auto valid = validate_schema(schema()); !valid) {
+      return tl::unexpected(valid.error());
+    }
+
+    m_state = std::make_unique<State>();
+    auto &s = *m_state;
+    s.threads = m_options.threads == 0
+                    ? s.pool.concurrency()
+                    : std::min(m_options.threads, s.pool.concurrency());
+    s.partition_bits = partition_bits(m_options.partition_bits);
+    for (size_t t = 0; t < s.threads; ++t) {
+      s.locals.push_back(std::make_unique<State::Local>(State::Local{
+          GroupTable(m_child->schema(), m_group_by, m_aggregates), {}, {},
+          {}}));
+    }
+    s.partial_layout = s.locals[0]->table.partial_layout();
+    const size_t partitions = size_t{1} << s.partition_bits;
+    for (size_t p = 0; p < partitions; ++p) {
+      s.partitions.emplace_back(s.partial_layout);
+    }
+    s.locks = std::vector<std::mutex>(partitions);
+
+    if (auto status = partition_input(); !status) {
+      m_state.reset();
+      return tl::unexpected(status.error());
+    }
+  }
+
+  auto &s = *m_state;
+  prepare(output);
+  while (true) {
+    if (s.output_position < s.output.size()) {
+      auto more = s.output[s.output_position].read(output);
+      if (!more) {
+        return tl::unexpected(more.error());
+      }
+      if (*more) {
+        return true;
+      }
+      ++s.output_position;
+      continue;
+    }
+    s.output.clear();
+    s.output_position = 0;
+    if (s.next_partition == s.partitions.size()) {
+      return false;
+    }
+
+    // A wave of partitions whose partial states fit the budget together
+    const size_t first = s.next_partition;
+    size_t bytes = 0;
+    while (s.next_partition < s.partitions.size() &&
+           s.next_partition - first < s.threads) {
+      const size_t needed = s.partitions[s.next_partition].total_bytes();
+      if (m_options.memory_budget != 0 && s.next_partition > first &&
+          bytes + needed > m_options.memory_budget) {
+        break;
+      }
+      bytes += needed;
+      ++s.next_partition;
+    }
+
+    // The global group always hashes to 0, so partition 0 emits it
+    const size_t count = s.next_partition - first;
+    const size_t budget = m_options.memory_budget / count;
+    for (size_t i = 0; i < count; ++i) {
+      s.output.emplace_back(schema());
+    }
+    std::vector<error::VoidResult> results(count, error::ok());
+    s.pool.parallel_for(
+        count,
+        [&](size_t i) {
+          const size_t p = first + i;
+          results[i] = merge_partition(std::move(s.partitions[p]),
+                                       s.partition_bits,
+                                       m_group_by.empty() && p == 0, budget,
+                                       s.output[i]);
+        },
+        s.threads);
+    if (auto status = first_error(results); !status) {
+      return tl::unexpected(status.error());
+    }
+  }
+}
+
+void ParallelHashAggregate::reset() {
+  m_child->reset();
+  m_state.reset();
+}
+
+std::string ParallelHashAggregate::name() const {
+  return fmt::format("ParallelHashAggregate({}, partitions={})",
+                     describe(schema(), m_group_by.size(),
+                              m_aggregates.size()),
+                     size_t{1} << partition_bits(m_options.partition_bits));
+}
+
+} // namespace velox::query
@@ -0,0 +1,1242 @@
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <velox/query/expression.hpp>
+#include <velox/query/kernels.hpp>
+
+namespace velox::query {
+namespace {
+using dtypes::TypeId;
+using dtypes::TypeInfo;
+
+bool is_integer(TypeId id) noexcept {
+  return id >= TypeId::TINYINT && id <= TypeId::BIGINT;
+}
+
+bool is_floating(TypeId id) noexcept {
+  return id == TypeId::REAL || id == TypeId::DOUBLE;
+}
+
+/// @brief Quote a string literal, doubling embedded quotes
+std::string quote(std::string_view text) {
+  std::string quoted = "'";
+  for (char c : text) {
+    quoted += c;
+    if (c == '\'') {
+      quoted += c;
+    }
+  }
+
+  return quoted + "'";
+}
+
+std::string format_decimal(int64_t value, uint8_t scale) {
+  if (scale == 0) {
+    return fmt::format("{}", value);
+  }
+
+  const auto factor = scale_factor(scale);
+  const auto magnitude = value < 0 ? -static_cast<uint64_t>(value)
+                                   : static_cast<uint64_t>(value);
+  return fmt::format("{}{}.{:0{}}", value < 0 ? "-" : "",
+                     magnitude / static_cast<uint64_t>(factor),
+                     magnitude % static_cast<uint64_t>(factor), scale);
+}
+
+/// @brief YYYY-MM-DD of a day count since 1970-01-01 (proleptic Gregorian)
+std::string format_date(int64_t days) {
+  days += 719468;
+  const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+  const int64_t day_of_era = days - era * 146097;
+  const int64_t year_of_era =
+      (day_of_era - day_of_era / 1460 + day_of_era / 36524 -
+       day_of_era / 146096) /
+      365;
+  const int64_t day_of_year =
+      day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+  const int64_t mp = (5 * day_of_year + 2) / 153;
+  const int64_t day = day_of_year - (153 * mp + 2) / 5 + 1;
+  const int64_t month = mp < 10 ? mp + 3 : mp - 9;
+  const int64_t year = year_of_era + era * 400 + (month <= 2 ? 1 : 0);
+
+  return fmt::format("{:04}-{:02}-{:02}", year, month, day);
+}
+
+/// @brief HH:MM:SS[.ffffff] of a microsecond count since midnight
+std::string format_time(int64_t micros) {
+  const auto seconds = micros / 1'000'000;
+  const auto fraction = micros % 1'000'000;
+  auto text = fmt::format("{:02}:{:02}:{:02}", seconds / 3600,
+                          seconds / 60 % 60, seconds % 60);
+  if (fraction != 0) {
+    text += fmt::format(".{:06}", fraction);
+  }
+
+  return text;
+}
+
+uint8_t scale_of(const TypeInfo &type) noexcept {
+  return type.type_id == TypeId::DECIMAL ? type.scale : 0;
+}
+
+TypeInfo decimal_type(uint8_t scale) {
+  return TypeInfo(TypeId::DECIMAL, config::DECIMAL_PRECISION, scale);
+}
+
+template <typename Out, typename Fn>
+void convert(const ColumnVector &input, ColumnVector &output, Fn fn) {
+  Out *out = output.data<Out>();
+  dispatch_fixed(input.physical(), [&](auto tag) {
+    using In = typename decltype(tag)::type;
+    const In *in = input.data<In>();
+    for (size_t i = 0; i < input.size(); ++i) {
+      out[i] = fn(in[i]);
+    }
+  });
+}
+
+/// @brief Invoke fn with the function object implementing op
+template <typename Fn> decltype(auto) with_compare(CompareOp op, Fn &&fn) {
+  switch (op) {
+  case CompareOp::EQ:
+    return fn(std::equal_to<>{});
+  case CompareOp::NE:
+    return fn(std::not_equal_to<>{});
+  case CompareOp::LT:
+    return fn(std::less<>{});
+  case CompareOp::LE:
+    return fn(std::less_equal<>{});
+  case CompareOp::GT:
+    return fn(std::greater<>{});
+  case CompareOp::GE:
+    break;
+  }
+
+  return fn(std::greater_equal<>{});
+}
+
+/**
+ * @brief Compare every row of a vector against the first row of another
+ *
+ * @note The hot filter shape (column op literal): a branch-free loop the
+ *       compiler auto-vectorizes.
+ */
+void compare_scalar(const ColumnVector &left, const ColumnVector &scalar,
+                    CompareOp op, uint8_t *out) {
+  const size_t n = left.size();
+
+  with_compare(op, [&](auto cmp) {
+    if (left.physical() == PhysicalType::VARLEN) {
+      const auto value = scalar.string_at(0);
+      for (size_t i = 0; i < n; ++i) {
+        out[i] = cmp(left.string_at(i), value);
+      }
+      return;
+    }
+
+    dispatch_fixed(left.physical(), [&](auto tag) {
+      using T = typename decltype(tag)::type;
+      const T *in = left.data<T>();
+      const T value = scalar.data<T>()[0];
+      for (size_t i = 0; i < n; ++i) {
+        out[i] = cmp(in[i], value);
+      }
+    });
+  });
+}
+
+void compare_vectors(const ColumnVector &left, const ColumnVector &right,
+                     CompareOp op, uint8_t *out) {
+  const size_t n = left.size();
+
+  with_compare(op, [&](auto cmp) {
+    if (left.physical() == PhysicalType::VARLEN) {
+      for (size_t i = 0; i < n; ++i) {
+        out[i] = cmp(left.string_at(i), right.string_at(i));
+      }
+      return;
+    }
+
+    dispatch_fixed(left.physical(), [&](auto tag) {
+      using T = typename decltype(tag)::type;
+      const T *a = left.data<T>();
+      const T *b = right.data<T>();
+      for (size_t i = 0; i < n; ++i) {
+        out[i] = cmp(a[i], b[i]);
+      }
+    });
+  });
+}
+
+/**
+ * @brief Evaluate a child and convert it to a target type
+ *
+ * @param child Child expression
+ * @param input Input rows
+ * @param target Type the caller's kernel expects
+ * @param scratch Holds the child's own result when it is computed
+ * @param converted Holds the converted result when a cast is needed
+ * @return Vector with the rows: an input column for a matching ColumnRef,
+ *         otherwise scratch or converted
+ */
+error::Result<const ColumnVector *>
+evaluate_as(const Expression &child, const DataChunk &input,
+            const TypeInfo &target, ColumnVector &scratch,
+            ColumnVector &converted) {
+  const ColumnVector *raw = &scratch;
+
+  if (child.kind() == ExpressionKind::COLUMN_REF) {
+    raw = &input.column(static_cast<const ColumnRef &>(child).index());
+  } else if (auto evaluated = child.evaluate(input, scratch); !evaluated) {
+    return tl::unexpected(evaluated.error());
+  }
+
+  if (same_type(raw->type(), target)) {
+    return raw;
+  }
+
+  if (auto casted = cast(*raw, target, converted); !casted) {
+    return tl::unexpected(casted.error());
+  }
+
+  return &converted;
+}
+
+/**
+ * @brief Convert a one-row vector to another type
+ *
+ * @return Converted row; NULL if the value does not convert
+ */
+ColumnVector convert_row(const ColumnVector &row, const TypeInfo &target) {
+  ColumnVector converted(target, 1);
+  if (!cast(row, target, converted)) {
+    converted.reset(target);
+    converted.append_null();
+  }
+
+  return converted;
+}
+
+/**
+ * @brief Check whether an integer literal fits an integer column's width
+ *
+ * @note Lets comparisons run in the column's own width instead of
+ *       widening every row to BIGINT.
+ */
+bool fits_integer_column(const TypeInfo &column, const ColumnVector &literal) {
+  if (!is_integer(column.type_id) || !is_integer(literal.type().type_id) ||
+      !literal.is_valid(0)) {
+    return false;
+  }
+
+  const auto value = dispatch_fixed(literal.physical(), [&](auto tag) {
+    using T = typename decltype(tag)::type;
+    return static_cast<int64_t>(literal.data<T>()[0]);
+  });
+  return dispatch_fixed(physical_type(column.type_id), [&](auto tag) {
+    using T = typename decltype(tag)::type;
+    if constexpr (std::is_integral_v<T>) {
+      return std::in_range<T>(value);
+    } else {
+      return false;
+    }
+  });
+}
+
+bool is_nan(const ColumnVector &vector, size_t row) noexcept {
+  switch (vector.physical()) {
+  case PhysicalType::FLOAT:
+    return std::isnan(vector.data<float>()[row]);
+  case PhysicalType::DOUBLE:
+    return std::isnan(vector.data<double>()[row]);
+  default:
+    return false;
+  }
+}
+
+constexpr char fold_case(char c) noexcept {
+  return c >= 'A' && c <= 'Z' ? static_cast<char>(c | 0x20) : c;
+}
+
+/**
+ * @brief Match a string against a LIKE pattern
+ *
+ * @note Greedy with backtracking to the last %, which is enough since a
+ *       later % can absorb anything an earlier one would have.
+ */
+bool like_match(std::string_view text, std::string_view pattern,
+                bool ignore_case) noexcept {
+  size_t t = 0;
+  size_t p = 0;
+  size_t star = std::string_view::npos;
+  size_t star_text = 0;
+
+  while (t < text.size()) {
+    if (p < pattern.size() && pattern[p] == '%') {
+      star = ++p;
+      star_text = t;
+      continue;
+    }
+    if (p < pattern.size()) {
+      char expected = pattern[p];
+      size_t width = 1;
+      if (expected == '\\' && p + 1 < pattern.size()) {
+        expected = pattern[p + 1];
+        width = 2;
+      }
+      const bool any = pattern[p] == '_';
+      if (any || (ignore_case ? fold_case(expected) == fold_case(text[t])
+                              : expected == text[t])) {
+        p += width;
+        ++t;
+        continue;
+      }
+    }
+    if (star == std::string_view::npos) {
+      return false;
+    }
+    p = star;
+    t = ++star_text;
+  }
+
+  while (p < pattern.size() && pattern[p] == '%') {
+    ++p;
+  }
+  return p == pattern.size();
+}
+
+/**
+ * @brief Reduce a LIKE pattern to a kernel shape
+ *
+ * @param pattern LIKE pattern
+ * @param literal Receives the unescaped text between the end wildcards
+ * @return Shape, or nullopt if a wildcard sits inside the literal
+ */
+std::optional<StringMatch> like_shape(std::string_view pattern,
+                                      std::string &literal) {
+  bool leading = false;
+  bool trailing = false;
+  literal.clear();
+
+  for (size_t p = 0; p < pattern.size(); ++p) {
+    const char c = pattern[p];
+    if (c == '%') {
+      if (literal.empty() && !trailing) {
+        leading = true;
+      } else {
+        trailing = true;
+      }
+      continue;
+    }
+    if (trailing || c == '_') {
+      return std::nullopt;
+    }
+    literal += c == '\\' && p + 1 < pattern.size() ? pattern[++p] : c;
+  }
+
+  if (literal.empty()) {
+    // Only wildcards: '' is equality with the empty string, '%' anything
+    return leading ? StringMatch::CONTAINS : StringMatch::EQUALS;
+  }
+  if (leading && trailing) {
+    return StringMatch::CONTAINS;
+  }
+  if (leading) {
+    return StringMatch::SUFFIX;
+  }
+
+  return trailing ? StringMatch::PREFIX : StringMatch::EQUALS;
+}
+
+/// @brief Two's-complement wrapping arithmetic (signed overflow is UB)
+int64_t wrap(uint64_t value) noexcept { return static_cast<int64_t>(value); }
+} // namespace
+
+std::optional<TypeInfo> common_type(const TypeInfo &a, const TypeInfo &b) {
+  if (a.type_id == TypeId::NULL_TYPE) {
+    return b;
+  }
+  if (b.type_id == TypeId::NULL_TYPE) {
+    return a;
+  }
+
+  if (dtypes::is_string(a.type_id) && dtypes::is_string(b.type_id)) {
+    return TypeInfo(TypeId::VARCHAR, std::max(a.max_length, b.max_length));
+  }
+
+  if (a.type_id == b.type_id && a.type_id != TypeId::DECIMAL) {
+    return a;
+  }
+
+  if (!dtypes::is_numeric(a.type_id) || !dtypes::is_numeric(b.type_id)) {
+    return std::nullopt;
+  }
+
+  if (is_floating(a.type_id) || is_floating(b.type_id)) {
+    return TypeInfo(TypeId::DOUBLE);
+  }
+
+  if (a.type_id == TypeId::DECIMAL || b.type_id == TypeId::DECIMAL) {
+    return decimal_type(std::max(scale_of(a), scale_of(b)));
+  }
+
+  return TypeInfo(TypeId::BIGINT);
+}
+
+error::VoidResult cast(const ColumnVector &input, const TypeInfo &target,
+                       ColumnVector &output) {
+  const auto source = input.type().type_id;
+  output.reset(target);
+
+  if (same_type(input.type(), target)) {
+    output.append_range(input, 0, input.size());
+    return error::ok();
+  }
+
+  if (source == TypeId::NULL_TYPE) {
+    for (size_t i = 0; i < input.size(); ++i) {
+      output.append_null();
+    }
+    return error::ok();
+  }
+
+  if (!dtypes::is_numeric(source) || !dtypes::is_numeric(target.type_id)) {
+    return error::error<void>(error::ErrorCode::TYPE_MISMATCH);
+  }
+
+  output.resize(input.size());
+  const auto from_scale = scale_of(input.type());
+  const auto from_factor = static_cast<double>(scale_factor(from_scale));
+
+  dispatch_fixed(output.physical(), [&](auto tag) {
+    using Out = typename decltype(tag)::type;
+
+    if (target.type_id == TypeId::DECIMAL) {
+      const auto to_factor = scale_factor(target.scale);
+      if (is_floating(source)) {
+        convert<int64_t>(input, output, [&](auto v) {
+          return static_cast<int64_t>(
+              std::llround(static_cast<double>(v) * to_factor));
+        });
+      } else if (target.scale >= from_scale) {
+        const auto factor = scale_factor(target.scale - from_scale);
+        convert<int64_t>(input, output, [&](auto v) {
+          return wrap(static_cast<uint64_t>(v) * factor);
+        });
+      } else {
+        const auto factor = scale_factor(from_scale - target.scale);
+        convert<int64_t>(input, output, [&](auto v) {
+          return static_cast<int64_t>(v) / factor;
+        });
+      }
+    } else if constexpr (std::is_floating_point_v<Out>) {
+      convert<Out>(input, output, [&](auto v) {
+        return static_cast<Out>(static_cast<double>(v) / from_factor);
+      });
+    } else {
+      const auto factor = scale_factor(from_scale);
+      convert<Out>(input, output, [&](auto v) {
+        return static_cast<Out>(v / static_cast<decltype(v)>(factor));
+      });
+    }
+  });
+  output.copy_validity(input);
+
+  return error::ok();
+}
+
+std::string format_literal(const dtypes::Value &value) {
+  return std::visit(
+      [](const auto &v) -> std::string {
+        using V = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<V, std::nullptr_t>) {
+          return "NULL";
+        } else if constexpr (std::is_same_v<V, bool>) {
+          return v ? "TRUE" : "FALSE";
+        } else if constexpr (std::is_integral_v<V>) {
+          return fmt::format("{}", static_cast<int64_t>(v));
+        } else if constexpr (std::is_floating_point_v<V>) {
+          return fmt::format("{}", v);
+        } else if constexpr (std::is_same_v<V, dtypes::Decimal>) {
+          return format_decimal(v.value, v.scale);
+        } else if constexpr (std::is_same_v<V, std::string>) {
+          return quote(v);
+        } else if constexpr (std::is_same_v<V, std::vector<uint8_t>>) {
+          std::string hex = "X'";
+          for (auto byte : v) {
+            hex += fmt::format("{:02x}", byte);
+          }
+          return hex + "'";
+        } else if constexpr (std::is_same_v<V, dtypes::Date>) {
+          return "DATE '" + format_date(v.days_since_epoch) + "'";
+        } else if constexpr (std::is_same_v<V, dtypes::Time>) {
+          return "TIME '" + format_time(v.microseconds_since_midnight) + "'";
+        } else if constexpr (std::is_same_v<V, dtypes::Timestamp>) {
+          constexpr int64_t micros_per_day = 86'400'000'000;
+          auto days = v.microseconds_since_epoch / micros_per_day;
+          auto micros = v.microseconds_since_epoch % micros_per_day;
+          if (micros < 0) {
+            --days;
+            micros += micros_per_day;
+          }
+          return "TIMESTAMP '" + format_date(days) + " " +
+                 format_time(micros) + "'";
+        } else {
+          std::string text;
+          for (size_t i = 0; i < v.bytes.size(); ++i) {
+            text += (i == 4 || i == 6 || i == 8 || i == 10) ? "-" : "";
+            text += fmt::format("{:02x}", v.bytes[i]);
+          }
+          return "UUID '" + text + "'";
+        }
+      },
+      value);
+}
+
+// ColumnRef
+
+error::VoidResult ColumnRef::evaluate(const DataChunk &input,
+                                      ColumnVector &result) const {
+  result.reset(type());
+  result.append_range(input.column(m_index), 0, input.size());
+
+  return error::ok();
+}
+
+std::string ColumnRef::to_string() const {
+  return m_name.empty() ? fmt::format("#{}", m_index) : m_name;
+}
+
+// Constant
+
+Constant::Constant(dtypes::Value value, TypeInfo type)
+    : Expression(ExpressionKind::CONSTANT, type), m_value(std::move(value)),
+      m_vector(type, 1) {
+  if (!m_vector.append_value(m_value)) {
+    m_vector.append_null();
+  }
+}
+
+error::VoidResult Constant::evaluate(const DataChunk &input,
+                                     ColumnVector &result) const {
+  const size_t n = input.size();
+  result.reset(type());
+
+  if (!m_vector.is_valid(0)) {
+    for (size_t i = 0; i < n; ++i) {
+      result.append_null();
+    }
+  } else if (m_vector.physical() == PhysicalType::VARLEN) {
+    const auto value = m_vector.string_at(0);
+    for (size_t i = 0; i < n; ++i) {
+      result.append_string(value);
+    }
+  } else {
+    result.resize(n);
+    dispatch_fixed(m_vector.physical(), [&](auto tag) {
+      using T = typename decltype(tag)::type;
+      std::fill_n(result.data<T>(), n, m_vector.data<T>()[0]);
+    });
+  }
+
+  return error::ok();
+}
+
+std::string Constant::to_string() const {
+  return format_literal(m_value);
+}
+
+// Comparison
+
+Comparison::Comparison(CompareOp op, ExpressionPtr left, ExpressionPtr right,
+                       TypeInfo operand_type)
+    : Expression(ExpressionKind::COMPARISON, TypeInfo(TypeId::BOOLEAN)),
+      m_op(op), m_left(std::move(left)), m_right(std::move(right)),
+      m_operand_type(operand_type) {
+  if (m_right->kind() == ExpressionKind::CONSTANT) {
+    ColumnVector converted(m_operand_type, 1);
+    const auto &literal = static_cast<const Constant &>(*m_right);
+    if (cast(literal.vector(), m_operand_type, converted)) {
+      m_scalar = std::move(converted);
+    }
+  }
+}
+
+error::VoidResult Comparison::evaluate(const DataChunk &input,
+                                       ColumnVector &result) const {
+  ColumnVector scratch(m_operand_type, 1);
+  ColumnVector converted(m_operand_type, 1);
+  auto left = evaluate_as(*m_left, input, m_operand_type, scratch, converted);
+  if (!left) {
+    return tl::unexpected(left.error());
+  }
+
+  result.reset(type());
+  result.resize(input.size());
+  auto *out = result.data<uint8_t>();
+
+  if (m_scalar) {
+    compare_scalar(**left, *m_scalar, m_op, out);
+    result.copy_validity(**left);
+    if (!m_scalar->is_valid(0)) {
+      for (size_t i = 0; i < input.size(); ++i) {
+        result.set_valid(i, false);
+      }
+    }
+    return error::ok();
+  }
+
+  ColumnVector right_scratch(m_operand_type, 1);
+  ColumnVector right_converted(m_operand_type, 1);
+  auto right = evaluate_as(*m_right, input, m_operand_type, right_scratch,
+                           right_converted);
+  if (!right) {
+    return tl::unexpected(right.error());
+  }
+
+  compare_vectors(**left, **right, m_op, out);
+  result.copy_validity(**left);
+  result.intersect_validity(**right);
+
+  return error::ok();
+}
+
+std::string Comparison::to_string() const {
+  return fmt::format("({} {} {})", m_left->to_string(),
+                     query::to_string(m_op), m_right->to_string());
+}
+
+// Arithmetic
+
+Arithmetic::Arithmetic(ArithmeticOp op, ExpressionPtr left,
+                       ExpressionPtr right, TypeInfo result_type,
+                       TypeInfo left_type, TypeInfo right_type)
+    : Expression(ExpressionKind::ARITHMETIC, result_type), m_op(op),
+      m_left(std::move(left)), m_right(std::move(right)),
+      m_left_type(left_type), m_right_type(right_type) {}
+
+error::VoidResult Arithmetic::evaluate(const DataChunk &input,
+                                       ColumnVector &result) const {
+  ColumnVector left_scratch(m_left_type, 1);
+  ColumnVector left_converted(m_left_type, 1);
+  auto left = evaluate_as(*m_left, input, m_left_type, left_scratch,
+                          left_converted);
+  if (!left) {
+    return tl::unexpected(left.error());
+  }
+
+  ColumnVector right_scratch(m_right_type, 1);
+  ColumnVector right_converted(m_right_type, 1);
+  auto right = evaluate_as(*m_right, input, m_right_type, right_scratch,
+                           right_converted);
+  if (!right) {
+    return tl::unexpected(right.error());
+  }
+
+  const size_t n = input.size();
+  result.reset(type());
+  result.resize(n);
+  result.copy_validity(**left);
+  result.intersect_validity(**right);
+
+  if (type().type_id == TypeId::DOUBLE) {
+    const double *a = (*left)->data<double>();
+    const double *b = (*right)->data<double>();
+    double *out = result.data<double>();
+
+    switch (m_op) {
+    case ArithmeticOp::ADD:
+      std::transform(a, a + n, b, out, std::plus<>{});
+      break;
+    case ArithmeticOp::SUB:
+      std::transform(a, a + n, b, out, std::minus<>{});
+      break;
+    case ArithmeticOp::MUL:
+      std::transform(a, a + n, b, out, std::multiplies<>{});
+      break;
+    case ArithmeticOp::DIV:
+      for (size_t i = 0; i < n; ++i) {
+        out[i] = b[i] == 0.0 ? 0.0 : a[i] / b[i];
+        if (b[i] == 0.0) {
+          result.set_valid(i, false);
+        }
+      }
+      break;
+    }
+    return error::ok();
+  }
+
+  // BIGINT and DECIMAL share the int64 representation
+  const int64_t *a = (*left)->data<int64_t>();
+  const int64_t *b = (*right)->data<int64_t>();
+  int64_t *out = result.data<int64_t>();
+
+  switch (m_op) {
+  case ArithmeticOp::ADD:
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = wrap(static_cast<uint64_t>(a[i]) + static_cast<uint64_t>(b[i]));
+    }
+    break;
+  case ArithmeticOp::SUB:
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = wrap(static_cast<uint64_t>(a[i]) - static_cast<uint64_t>(b[i]));
+    }
+    break;
+  case ArithmeticOp::MUL:
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = wrap(static_cast<uint64_t>(a[i]) * static_cast<uint64_t>(b[i]));
+    }
+    break;
+  case ArithmeticOp::DIV:
+    for (size_t i = 0; i < n; ++i) {
+      if (b[i] == 0) {
+        out[i] = 0;
+        result.set_valid(i, false);
+      } else {
+        out[i] = b[i] == -1 ? wrap(0 - static_cast<uint64_t>(a[i]))
+                            : a[i] / b[i];
+      }
+    }
+    break;
+  }
+
+  return error::ok();
+}
+
+std::string Arithmetic::to_string() const {
+  return fmt::format("({} {} {})", m_left->to_string(),
+                     query::to_string(m_op), m_right->to_string());
+}
+
+// Conjunction
+
+Conjunction::Conjunction(ConjunctionOp op, std::vector<ExpressionPtr> children)
+    : Expression(ExpressionKind::CONJUNCTION, TypeInfo(TypeId::BOOLEAN)),
+      m_op(op), m_children(std::move(children)) {}
+
+error::VoidResult Conjunction::evaluate(const DataChunk &input,
+                                        ColumnVector &result) const {
+  if (auto first = m_children.front()->evaluate(input, result); !first) {
+    return first;
+  }
+
+  const bool is_and = m_op == ConjunctionOp::AND;
+  const size_t n = input.size();
+  ColumnVector operand(type(), n);
+
+  for (size_t c = 1; c < m_children.size(); ++c) {
+    if (auto next = m_children[c]->evaluate(input, operand); !next) {
+      return next;
+    }
+
+    uint8_t *out = result.data<uint8_t>();
+    const uint8_t *in = operand.data<uint8_t>();
+
+    if (!result.may_have_nulls() && !operand.may_have_nulls()) {
+      for (size_t i = 0; i < n; ++i) {
+        out[i] = is_and ? (out[i] & in[i]) : (out[i] | in[i]);
+      }
+      continue;
+    }
+
+    // Three-valued logic: FALSE dominates AND, TRUE dominates OR
+    const uint8_t dominant = is_and ? 0 : 1;
+    for (size_t i = 0; i < n; ++i) {
+      const bool left_valid = result.is_valid(i);
+      const bool right_valid = operand.is_valid(i);
+
+      if ((left_valid && out[i] == dominant) ||
+          (right_valid && in[i] == dominant)) {
+        out[i] = dominant;
+        result.set_valid(i, true);
+      } else if (left_valid && right_valid) {
+        out[i] = 1 - dominant;
+      } else {
+        result.set_valid(i, false);
+      }
+    }
+  }
+
+  return error::ok();
+}
+
+std::string Conjunction::to_string() const {
+  std::string text = "(";
+  for (size_t i = 0; i < m_children.size(); ++i) {
+    if (i > 0) {
+      text += fmt::format(" {} ", query::to_string(m_op));
+    }
+    text += m_children[i]->to_string();
+  }
+
+  return text + ")";
+}
+
+// Not
+
+Not::Not(ExpressionPtr child)
+    : Expression(ExpressionKind::NOT, TypeInfo(TypeId::BOOLEAN)),
+      m_child(std::move(child)) {}
+
+error::VoidResult Not::evaluate(const DataChunk &input,
+                                ColumnVector &result) const {
+  if (auto evaluated = m_child->evaluate(input, result); !evaluated) {
+    return evaluated;
+  }
+
+  uint8_t *out = result.data<uint8_t>();
+  for (size_t i = 0; i < result.size(); ++i) {
+    out[i] ^= 1;
+  }
+
+  return error::ok();
+}
+
+std::string Not::to_string() const {
+  return fmt::format("(NOT {})", m_child->to_string());
+}
+
+// IsNull
+
+IsNull::IsNull(ExpressionPtr child, bool negated)
+    : Expression(ExpressionKind::IS_NULL, TypeInfo(TypeId::BOOLEAN)),
+      m_child(std::move(child)), m_negated(negated) {}
+
+error::VoidResult IsNull::evaluate(const DataChunk &input,
+                                   ColumnVector &result) const {
+  ColumnVector scratch(m_child->type(), 1);
+  ColumnVector unused(m_child->type(), 1);
+  auto operand =
+      evaluate_as(*m_child, input, m_child->type(), scratch, unused);
+  if (!operand) {
+    return tl::unexpected(operand.error());
+  }
+
+  result.reset(type());
+  result.resize(input.size());
+  uint8_t *out = result.data<uint8_t>();
+  for (size_t i = 0; i < input.size(); ++i) {
+    out[i] = (*operand)->is_valid(i) == m_negated;
+  }
+
+  return error::ok();
+}
+
+std::string IsNull::to_string() const {
+  return fmt::format("({} IS {}NULL)", m_child->to_string(),
+                     m_negated ? "NOT " : "");
+}
+
+// Between
+
+Between::Between(ExpressionPtr child, ExpressionPtr low, ExpressionPtr high,
+                 TypeInfo operand_type)
+    : Expression(ExpressionKind::BETWEEN, TypeInfo(TypeId::BOOLEAN)),
+      m_child(std::move(child)), m_lower(std::move(low)),
+      m_upper(std::move(high)), m_operand_type(operand_type),
+      m_low(convert_row(static_cast<const Constant &>(*m_lower).vector(),
+                        m_operand_type)),
+      m_high(convert_row(static_cast<const Constant &>(*m_upper).vector(),
+                         m_operand_type)) {}
+
+error::VoidResult Between::evaluate(const DataChunk &input,
+                                    ColumnVector &result) const {
+  ColumnVector scratch(m_operand_type, 1);
+  ColumnVector converted(m_operand_type, 1);
+  auto operand =
+      evaluate_as(*m_child, input, m_operand_type, scratch, converted);
+  if (!operand) {
+    return tl::unexpected(operand.error());
+  }
+
+  const auto &values = **operand;
+  const size_t n = input.size();
+  if (kernels::supports(values.physical())) {
+    std::vector<uint64_t> bitmap(kernels::bitmap_words(n));
+    kernels::between(values, m_low, m_high, bitmap.data());
+    kernels::bitmap_to_mask(bitmap.data(), n, result);
+  } else {
+    result.reset(type());
+    result.resize(n);
+    uint8_t *out = result.data<uint8_t>();
+    const bool bounded = m_low.is_valid(0) && m_high.is_valid(0);
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = bounded && values.compare(i, m_low, 0) >= 0 &&
+               values.compare(i, m_high, 0) <= 0;
+    }
+  }
+  result.copy_validity(values);
+
+  return error::ok();
+}
+
+std::string Between::to_string() const {
+  return fmt::format("({} BETWEEN {} AND {})", m_child->to_string(),
+                     m_lower->to_string(), m_upper->to_string());
+}
+
+// InList
+
+InList::InList(ExpressionPtr child, std::vector<dtypes::Value> values,
+               TypeInfo operand_type)
+    : Expression(ExpressionKind::IN_LIST, TypeInfo(TypeId::BOOLEAN)),
+      m_child(std::move(child)), m_operand_type(operand_type),
+      m_values(std::move(values)), m_list(operand_type, m_values.size()) {
+  ColumnVector candidates(m_operand_type, m_values.size());
+  for (const auto &value : m_values) {
+    ColumnVector raw(type_of(value), 1);
+    if (!raw.append_value(value)) {
+      raw.append_null();
+    }
+
+    const auto converted = convert_row(raw, m_operand_type);
+    if (!converted.is_valid(0)) {
+      m_has_null = true;
+    } else if (!is_nan(converted, 0)) {
+      // NaN equals nothing, and would break the ordering below
+      candidates.append_from(converted, 0);
+    }
+  }
+
+  // Sorted and distinct, as the binary-search kernels expect
+  std::vector<uint32_t> order(candidates.size());
+  std::iota(order.begin(), order.end(), uint32_t{0});
+  std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return candidates.compare(a, candidates, b) < 0;
+  });
+  for (const auto index : order) {
+    if (m_list.empty() ||
+        !m_list.equals(m_list.size() - 1, candidates, index)) {
+      m_list.append_from(candidates, index);
+    }
+  }
+}
+
+error::VoidResult InList::evaluate(const DataChunk &input,
+                                   ColumnVector &result) const {
+  ColumnVector scratch(m_operand_type, 1);
+  ColumnVector converted(m_operand_type, 1);
+  auto operand =
+      evaluate_as(*m_child, input, m_operand_type, scratch, converted);
+  if (!operand) {
+    return tl::unexpected(operand.error());
+  }
+
+  const auto &values = **operand;
+  const size_t n = input.size();
+  if (kernels::supports(values.physical())) {
+    std::vector<uint64_t> bitmap(kernels::bitmap_words(n));
+    kernels::in_list(values, m_list, bitmap.data());
+    kernels::bitmap_to_mask(bitmap.data(), n, result);
+  } else {
+    result.reset(type());
+    result.resize(n);
+    uint8_t *out = result.data<uint8_t>();
+    for (size_t i = 0; i < n; ++i) {
+      size_t low = 0;
+      size_t high = m_list.size();
+      bool found = false;
+      while (low < high && !found) {
+        const size_t mid = low + (high - low) / 2;
+        const int order = values.compare(i, m_list, mid);
+        found = order == 0;
+        if (order < 0) {
+          high = mid;
+        } else {
+          low = mid + 1;
+        }
+      }
+      out[i] = found;
+    }
+  }
+  result.copy_validity(values);
+
+  // x IN (..., NULL) is NULL rather than FALSE when nothing matches
+  if (m_has_null) {
+    const uint8_t *out = result.data<uint8_t>();
+    for (size_t i = 0; i < n; ++i) {
+      if (out[i] == 0) {
+        result.set_valid(i, false);
+      }
+    }
+  }
+
+  return error::ok();
+}
+
+std::string InList::to_string() const {
+  std::string values;
+  for (const auto &value : m_values) {
+    values += values.empty() ? "" : ", ";
+    values += format_literal(value);
+  }
+
+  return fmt::format("({} IN ({}))", m_child->to_string(), values);
+}
+
+// Like
+
+Like::Like(ExpressionPtr child, std::string pattern, bool ignore_case)
+    : Expression(ExpressionKind::LIKE, TypeInfo(TypeId::BOOLEAN)),
+      m_child(std::move(child)), m_pattern(std::move(pattern)),
+      m_ignore_case(ignore_case) {
+  m_shape = like_shape(m_pattern, m_literal);
+}
+
+error::VoidResult Like::evaluate(const DataChunk &input,
+                                 ColumnVector &result) const {
+  ColumnVector scratch(m_child->type(), 1);
+  ColumnVector unused(m_child->type(), 1);
+  auto operand =
+      evaluate_as(*m_child, input, m_child->type(), scratch, unused);
+  if (!operand) {
+    return tl::unexpected(operand.error());
+  }
+
+  const auto &values = **operand;
+  const size_t n = input.size();
+  if (m_shape) {
+    std::vector<uint64_t> bitmap(kernels::bitmap_words(n));
+    kernels::match(values, *m_shape, m_literal, m_ignore_case, bitmap.data());
+    kernels::bitmap_to_mask(bitmap.data(), n, result);
+  } else {
+    result.reset(type());
+    result.resize(n);
+    uint8_t *out = result.data<uint8_t>();
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = like_match(values.string_at(i), m_pattern, m_ignore_case);
+    }
+  }
+  result.copy_validity(values);
+
+  return error::ok();
+}
+
+std::string Like::to_string() const {
+  return fmt::format("({} {} {})", m_child->to_string(),
+                     m_ignore_case ? "ILIKE" : "LIKE",
+                     quote(m_pattern));
+}
+
+// Builders
+
+namespace expr {
+error::Result<ExpressionPtr> column(const Schema &schema, size_t index) {
+  if (index >= schema.size()) {
+    return error::error<ExpressionPtr>(error::ErrorCode::INVALID_ARGUMENT);
+  }
+
+  return std::make_shared<ColumnRef>(index, schema[index].name,
+                                     schema[index].type);
+}
+
+error::Result<ExpressionPtr> column(const Schema &schema,
+                                    std::string_view name) {
+  for (size_t i = 0; i < schema.size(); ++i) {
+    if (schema[i].name == name) {
+      return column(schema, i);
+    }
+  }
+
+  return error::error<ExpressionPtr>(error::ErrorCode::SEMANTIC_ERROR);
+}
+
+ExpressionPtr literal(dtypes::Value value) {
+  auto type = type_of(value);
+  return std::make_shared<Constant>(std::move(value), type);
+}
+
+error::Result<ExpressionPtr> literal(dtypes::Value value, TypeInfo type) {
+  ColumnVector probe(type, 1);
+  if (!probe.append_value(value)) {
+    return error::error<ExpressionPtr>(error::ErrorCode::TYPE_MISMATCH);
+  }
+
+  return std::make_shared<Constant>(std::move(value), type);
+}
+
+error::Result<ExpressionPtr> compare(CompareOp op, ExpressionPtr left,
+                                     ExpressionPtr right) {
+  if (!left || !right) {
+    return error::error<ExpressionPtr>(error::ErrorCode::INVALID_ARGUMENT);
+  }
+
+  // Keep literals on the right so evaluation takes the scalar path
+  if (left->kind() == ExpressionKind::CONSTANT &&
+      right->kind() != ExpressionKind::CONSTANT) {
+    std::swap(left, right);
+    op = mirror(op);
+  }
+
+  auto operand_type = common_type(left->type(), right->type());
+  if (!operand_type) {
+    return error::error<ExpressionPtr>(error::ErrorCode::TYPE_MISMATCH);
+  }
+
+  if (right->kind() == ExpressionKind::CONSTANT &&
+      fits_integer_column(left->type(),
+                          static_cast<const Constant &>(*right).vector())) {
+    operand_type = left->type();
+  }
+
+  return std::make_shared<Comparison>(op, std::move(left), std::move(right),
+                                      *operand_type);
+}
+
+error::Result<ExpressionPtr> arithmetic(ArithmeticOp op, ExpressionPtr left,
+                                        ExpressionPtr right) {
+  if (!left || !right) {
+    return error::error<ExpressionPtr>(error::ErrorCode::INVALID_ARGUMENT);
+  }
+
+  const auto &a = left->type();
+  const auto &b = right->type();
+  if (!dtypes::is_numeric(a.type_id) || !dtypes::is_numeric(b.type_id)) {
+    return error::error<ExpressionPtr>(error::ErrorCode::TYPE_MISMATCH);
+  }
+
+  TypeInfo result(TypeId::BIGINT);
+  TypeInfo left_type(TypeId::BIGINT);
+  TypeInfo right_type(TypeId::BIGINT);
+  const bool decimal =
+      a.type_id == TypeId::DECIMAL || b.type_id == TypeId::DECIMAL;
+
+  if (is_floating(a.type_id) || is_floating(b.type_id) ||
+      (decimal && op == ArithmeticOp::DIV)) {
+    result = left_type = right_type = TypeInfo(TypeId::DOUBLE);
+  } else if (decimal && op == ArithmeticOp::MUL) {
+    const auto scale = scale_of(a) + scale_of(b);
+    if (scale > config::DECIMAL_PRECISION) {
+      return error::error<ExpressionPtr>(error::ErrorCode::TYPE_MISMATCH);
+    }
+    left_type = decimal_type(scale_of(a));
+    right_type = decimal_type(scale_of(b));
+    result = decimal_type(static_cast<uint8_t>(scale));
+  } else if (decimal) {
+    result = left_type = right_type =
+        decimal_type(std::max(scale_of(a), scale_of(b)));
+  }
+
+  return std::make_shared<Arithmetic>(op, std::move(left), std::move(right),
+                                      result, left_type, right_type);
+}
+
+error::Result<ExpressionPtr> conjunction(ConjunctionOp op,
+                                         std::vector<ExpressionPtr> children) {
+  if (children.empty()) {
+    return error::error<ExpressionPtr>(error::ErrorCode::INVALID_ARGUMENT);
+  }
+
+  for (const auto &child : children) {
+    if (!child || child->type().type_id != TypeId::BOOLEAN) {
+      return error::error<ExpressionPtr>(error::ErrorCode::TYPE_MISMATCH);
+    }
+  }
+
+  if (children.size() == 1) {
+    return children.front();
+  }
+
+  return std::make_shared<Conjunction>(op, std::move(children));
+}
+
+error::Result<ExpressionPtr> negate(ExpressionPtr child) {
+  if (!child || child->type().type_id != TypeId::BOOLEAN) {
+    return error::error<ExpressionPtr>(error::ErrorCode::TYPE_MISMATCH);
+  }
+
+  return std::make_shared<Not>(std::move(child));
+}
+
+error::Result<ExpressionPtr> between(ExpressionPtr child, ExpressionPtr low,
+                                     ExpressionPtr high) {
+  if (!child || !low || !high) {
+    return error::error<ExpressionPtr>(error::ErrorCode::INVALID_ARGUMENT);
+  }
+
+  auto is_literal = [](const ExpressionPtr &bound) {
+    return bound->kind() == ExpressionKind::CONSTANT &&
+           static_cast<const Constant &>(*bound).vector().is_valid(0);
+  };
+  if (!is_literal(low) || !is_literal(high)) {
+    auto lower = compare(CompareOp::GE, child, std::move(low));
+    if (!lower) {
+      return lower;
+    }
+    auto upper = compare(CompareOp::LE, child, std::move(high));
+    if (!upper) {
+      return upper;
+    }
+    return conjunction(ConjunctionOp::AND, {*lower, *upper});
+  }
+
+  auto operand_type = common_type(child->type(), low->type());
+  if (operand_type) {
+    operand_type = common_type(*operand_type, high->type());
+  }
+  if (!operand_type) {
+    return error::error<ExpressionPtr>(error::ErrorCode::TYPE_MISMATCH);
+  }
+
+  if (fits_integer_column(child->type(),
+                          static_cast<const Constant &>(*low).vector()) &&
+      fits_integer_column(child->type(),
+                          static_cast<const Constant &>(*high).vector())) {
+    operand_type = child->type();
+  }
+
+  return std::make_shared<Between>(std::move(child), std::move(low),
+                                   std::move(high), *operand_type);
+}
+
+error::Result<ExpressionPtr> in_list(ExpressionPtr child,
+                                     std::vector<dtypes::Value> values) {
+  if (!child || values.empty()) {
+    return error::error<ExpressionPtr>(error::ErrorCode::INVALID_ARGUMENT);
+  }
+
+  std::optional<TypeInfo> operand_type = child->type();
+  bool narrow = is_integer(child->type().type_id);
+  for (const auto &value : values) {
+    ColumnVector literal(type_of(value), 1);
+    if (!literal.append_value(value)) {
+      return error::error<ExpressionPtr>(error::ErrorCode::TYPE_MISMATCH);
+    }
+
+    operand_type = common_type(*operand_type, literal.type());
+    if (!operand_type) {
+      return error::error<ExpressionPtr>(error::ErrorCode::TYPE_MISMATCH);
+    }
+    narrow = narrow && (!literal.is_valid(0) ||
+                        fits_integer_column(child->type(), literal));
+  }
+
+  if (narrow) {
+    operand_type = child->type();
+  }
+
+  return std::make_shared<InList>(std::move(child), std::move(values),
+                                  *operand_type);
+}
+
+error::Result<ExpressionPtr> like(ExpressionPtr child, std::string pattern,
+                                  bool ignore_case) {
+  if (!child) {
+    return error::error<ExpressionPtr>(error::ErrorCode::INVALID_ARGUMENT);
+  }
+  if (!dtypes::is_string(child->type().type_id)) {
+    return error::error<ExpressionPtr>(error::ErrorCode::TYPE_MISMATCH);
+  }
+
+  return std::make_shared<Like>(std::move(child), std::move(pattern),
+                                ignore_case);
+}
+
+ExpressionPtr is_null(ExpressionPtr child, bool negated) {
+  return std::make_shared<IsNull>(std::move(child), negated);
+}
+} // namespace expr
+
+} // namespace velox::query
@@ -0,0 +1,899 @@
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <limits>
+#include <velox/query/operators.hpp>
+#include <velox/query/partition.hpp>
+#include <velox/query/worker_pool.hpp>
+
+namespace velox::query {
+namespace {
+using dtypes::TypeId;
+
+/// @brief Build-side marker for an unmatched LEFT JOIN probe row
+constexpr uint32_t NO_MATCH = UINT32_MAX;
+
+Schema join_schema(const Schema &probe, const Schema &build, JoinType type) {
+  Schema schema = probe;
+  if (type == JoinType::INNER || type == JoinType::LEFT) {
+    schema.insert(schema.end(), build.begin(), build.end());
+  }
+
+  return schema;
+}
+
+bool is_integer(TypeId id) noexcept {
+  return id >= TypeId::TINYINT && id <= TypeId::BIGINT;
+}
+
+/// @brief Key types whose equal values hash equally (see ColumnVector::hash)
+bool join_compatible(const dtypes::TypeInfo &a, const dtypes::TypeInfo &b) {
+  return same_type(a, b) || (is_integer(a.type_id) && is_integer(b.type_id));
+}
+
+error::VoidResult validate_keys(const Schema &probe, const Schema &build,
+                                const std::vector<size_t> &probe_keys,
+                                const std::vector<size_t> &build_keys) {
+  if (probe_keys.empty() || probe_keys.size() != build_keys.size()) {
+    return error::error<void>(error::ErrorCode::INVALID_ARGUMENT);
+  }
+  for (size_t k = 0; k < probe_keys.size(); ++k) {
+    if (probe_keys[k] >= probe.size() || build_keys[k] >= build.size()) {
+      return error::error<void>(error::ErrorCode::INVALID_ARGUMENT);
+    }
+    if (!join_compatible(probe[probe_keys[k]].type,
+                         build[build_keys[k]].type)) {
+      return error::error<void>(error::ErrorCode::TYPE_MISMATCH);
+    }
+  }
+
+  return error::ok();
+}
+
+/// @brief Render "a = b AND c = d" for EXPLAIN
+std::string join_condition(const Schema &probe, const Schema &build,
+                           const std::vector<size_t> &probe_keys,
+                           const std::vector<size_t> &build_keys) {
+  std::string condition;
+  for (size_t k = 0; k < probe_keys.size() && k < build_keys.size(); ++k) {
+    const auto probe_name = probe_keys[k] < probe.size()
+                                ? probe[probe_keys[k]].name
+                                : std::string("?");
+    const auto build_name = build_keys[k] < build.size()
+                                ? build[build_keys[k]].name
+                                : std::string("?");
+    condition += fmt::format("{}{} = {}", k == 0 ? "" : " AND ", probe_name,
+                             build_name);
+  }
+
+  return condition;
+}
+} // namespace
+
+/**
+ * @brief Build table and probe cursor of a HashJoin
+ *
+ * @note The build side is one growable DataChunk. Buckets chain build
+ *       rows through a next array (row + 1, 0 terminates), which keeps
+ *       the table two flat arrays regardless of key types. Both row ids
+ *       and string heap offsets are 32-bit, so a build side past either
+ *       limit fails with OUT_OF_MEMORY instead of wrapping.
+ */
+class HashJoin::State {
+public:
+  DataChunk build;
+  std::vector<uint64_t> build_hashes;
+  std::vector<uint32_t> heads;
+  std::vector<uint32_t> chain_next;
+  uint64_t mask{0};
+
+  DataChunk probe;
+  std::vector<uint64_t> probe_hashes;
+  std::vector<uint8_t> probe_null_key;
+  size_t probe_row{0};
+  uint32_t chain{0};
+  bool row_started{false};
+  bool row_matched{false};
+  bool probe_active{false};
+
+  std::vector<uint32_t> probe_selection;
+  std::vector<uint32_t> build_selection;
+};
+
+HashJoin::HashJoin(OperatorPtr probe, OperatorPtr build,
+                   std::vector<size_t> probe_keys,
+                   std::vector<size_t> build_keys, JoinType type)
+    : Operator(join_schema(probe->schema(), build->schema(), type)),
+      m_probe(std::move(probe)), m_build(std::move(build)),
+      m_probe_keys(std::move(probe_keys)),
+      m_build_keys(std::move(build_keys)), m_type(type) {}
+
+HashJoin::~HashJoin() = default;
+
+namespace {
+void hash_keys(const DataChunk &chunk, const std::vector<size_t> &keys,
+               std::vector<uint64_t> &hashes,
+               std::vector<uint8_t> &null_key) {
+  hashes.resize(chunk.size());
+  null_key.assign(chunk.size(), 0);
+
+  for (size_t k = 0; k < keys.size(); ++k) {
+    const auto &column = chunk.column(keys[k]);
+    column.hash(hashes, k > 0);
+    if (column.may_have_nulls()) {
+      for (size_t i = 0; i < chunk.size(); ++i) {
+        null_key[i] |= static_cast<uint8_t>(!column.is_valid(i));
+      }
+    }
+  }
+}
+} // namespace
+
+error::Result<bool> HashJoin::next(DataChunk &output) {
+  if (!m_state) {
+    if (auto valid = validate_keys(m_probe->schema(), m_build->schema(),
+                                   m_probe_keys, m_build_keys);
+        !valid) {
+      return tl::unexpected(valid.error());
+    }
+
+    auto state = std::make_unique<State>();
+    state->build.initialize(m_build->schema());
+
+    DataChunk input;
+    while (true) {
+      auto more = m_build->next(input);
+      if (!more) {
+        return tl::unexpected(more.error());
+      }
+      if (!*more) {
+        break;
+      }
+      // Chains index rows and strings with 32 bits
+      if (!state->build.range_fits(input, 0, input.size()) ||
+          state->build.size() + input.size() >=
+              std::numeric_limits<uint32_t>::max()) {
+        return error::error<bool>(error::ErrorCode::OUT_OF_MEMORY);
+      }
+      state->build.append_range(input, 0, input.size());
+    }
+
+    const size_t rows = state->build.size();
+    std::vector<uint8_t> null_key;
+    hash_keys(state->build, m_build_keys, state->build_hashes, null_key);
+
+    const size_t buckets = std::bit_ceil(std::max<size_t>(rows * 2, 16));
+    state->mask = buckets - 1;
+    state->heads.assign(buckets, 0);
+    state->chain_next.assign(rows, 0);
+    // Insert in reverse so each chain lists build rows in input order
+    for (size_t row = rows; row-- > 0;) {
+      if (null_key[row]) {
+        continue;
+      }
+      auto &head = state->heads[state->build_hashes[row] & state->mask];
+      state->chain_next[row] = head;
+      head = static_cast<uint32_t>(row + 1);
+    }
+    m_state = std::move(state);
+  }
+
+  auto &s = *m_state;
+  prepare(output);
+
+  // No build rows: INNER and SEMI produce nothing, so skip the probe side
+  if (s.build.empty() &&
+      (m_type == JoinType::INNER || m_type == JoinType::SEMI)) {
+    return false;
+  }
+
+  const size_t probe_columns = m_probe->schema().size();
+  auto keys_equal = [&](size_t probe_row, size_t build_row) {
+    for (size_t k = 0; k < m_probe_keys.size(); ++k) {
+      if (s.probe.column(m_probe_keys[k]).compare(
+              probe_row, s.build.column(m_build_keys[k]), build_row) != 0) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  auto flush = [&]() {
+    const auto &probe_rows = s.probe_selection;
+    const auto &build_rows = s.build_selection;
+    for (size_t c = 0; c < probe_columns; ++c) {
+      output.column(c).append_selected(s.probe.column(c), probe_rows);
+    }
+
+    if (m_type == JoinType::INNER || m_type == JoinType::LEFT) {
+      const bool padded = std::find(build_rows.begin(), build_rows.end(),
+                                    NO_MATCH) != build_rows.end();
+      for (size_t c = 0; c < s.build.column_count(); ++c) {
+        auto &column = output.column(probe_columns + c);
+        if (!padded) {
+          column.append_selected(s.build.column(c), build_rows);
+          continue;
+        }
+        for (auto row : build_rows) {
+          if (row == NO_MATCH) {
+            column.append_null();
+          } else {
+            column.append_from(s.build.column(c), row);
+          }
+        }
+      }
+    }
+    output.set_size(probe_rows.size());
+    s.probe_selection.clear();
+    s.build_selection.clear();
+  };
+
+  while (true) {
+    if (!s.probe_active) {
+      auto more = m_probe->next(s.probe);
+      if (!more || !*more) {
+        return more;
+      }
+      hash_keys(s.probe, m_probe_keys, s.probe_hashes, s.probe_null_key);
+      s.probe_row = 0;
+      s.row_started = false;
+      s.probe_active = true;
+    }
+
+    const bool semi = m_type == JoinType::SEMI || m_type == JoinType::ANTI;
+    for (; s.probe_row < s.probe.size(); ++s.probe_row) {
+      const auto row = s.probe_row;
+      const auto hash = s.probe_hashes[row];
+
+      if (!s.row_started) {
+        s.chain = s.probe_null_key[row] ? 0 : s.heads[hash & s.mask];
+        s.row_matched = false;
+        s.row_started = true;
+      }
+
+      while (s.chain != 0) {
+        const uint32_t candidate = s.chain - 1;
+        if (s.build_hashes[candidate] == hash && keys_equal(row, candidate)) {
+          if (semi) {
+            s.row_matched = true;
+            break;
+          }
+          if (s.probe_selection.size() == config::VECTOR_SIZE) {
+            flush();
+            return true;
+          }
+          s.probe_selection.push_back(static_cast<uint32_t>(row));
+          s.build_selection.push_back(candidate);
+          s.row_matched = true;
+        }
+        s.chain = s.chain_next[candidate];
+      }
+
+      const bool emit_probe_only =
+          (m_type == JoinType::SEMI && s.row_matched) ||
+          (m_type == JoinType::ANTI && !s.row_matched) ||
+          (m_type == JoinType::LEFT && !s.row_matched);
+      if (emit_probe_only) {
+        if (s.probe_selection.size() == config::VECTOR_SIZE) {
+          flush();
+          return true;
+        }
+        s.probe_selection.push_back(static_cast<uint32_t>(row));
+        s.build_selection.push_back(NO_MATCH);
+      }
+      s.chain = 0;
+      s.row_started = false;
+    }
+
+    // Selections index into this probe chunk, so flush before the next one
+    s.probe_active = false;
+    if (!s.probe_selection.empty()) {
+      flush();
+      return true;
+    }
+  }
+}
+
+void HashJoin::reset() {
+  m_probe->reset();
+  m_build->reset();
+  m_state.reset();
+}
+
+std::string HashJoin::name() const {
+  return fmt::format("HashJoin({}: {})", to_string(m_type),
+                     join_condition(m_probe->schema(), m_build->schema(),
+                                    m_probe_keys, m_build_keys));
+}
+
+// RadixHashJoin
+
+namespace {
+/// @brief Bytes of hash table that should stay resident in L2
+constexpr size_t CACHE_TABLE_BYTES = 256 * 1024;
+
+/// @brief Most second-pass partitions per partition
+constexpr uint8_t MAX_SUB_BITS = 12;
+
+/// @brief Probe rows between a slot prefetch and its lookup
+constexpr size_t PREFETCH_DISTANCE = 16;
+
+/// @brief Input chunks routed per parallel partitioning round, per thread
+constexpr size_t CHUNKS_PER_THREAD = 4;
+
+/// @brief Probe chunks regrouped by second-pass partition at a time
+constexpr size_t PROBE_BATCH_CHUNKS = 64;
+
+/// @brief Slot value of an unused table entry
+constexpr uint32_t EMPTY_ROW = UINT32_MAX;
+
+/// @brief Open-addressing table entry: hash bits and build row
+struct Slot {
+  uint32_t tag;
+  uint32_t row;
+};
+
+/// @brief Build rows per table at 50% load within CACHE_TABLE_BYTES
+constexpr size_t CACHE_ROWS = CACHE_TABLE_BYTES / sizeof(Slot) / 2;
+
+/// @brief Hash bits compared before the keys; disjoint from partition bits
+uint32_t slot_tag(uint64_t hash) noexcept {
+  return static_cast<uint32_t>(hash >> 16);
+}
+
+/// @brief Rows of one input chunk ordered by destination partition
+struct Route {
+  std::vector<uint64_t> hashes;
+  std::vector<uint8_t> null_key;
+  std::vector<uint32_t> order;   ///< Rows grouped by partition
+  std::vector<uint32_t> bounds;  ///< Partition p is order[bounds[p], [p+1])
+  std::vector<uint32_t> nulls;   ///< Rows with a NULL key
+};
+
+/**
+ * @brief Appends joined rows to an output partition
+ *
+ * @note Selections index into one probe chunk, so flush() must run before
+ *       the probe chunk changes. Once the partition holds more than the
+ *       budget it is spilled, and later chunks go straight to disk.
+ */
+class JoinEmitter {
+public:
+  JoinEmitter(const Schema &schema, size_t probe_columns, JoinType type,
+              PartitionBuffer &output, size_t budget,
+              const std::filesystem::path &spill_directory)
+      : m_schema(schema), m_probe_columns(probe_columns), m_type(type),
+        m_output(output), m_budget(budget),
+        m_spill_directory(spill_directory) {}
+
+  /// @brief Get the first error of appending to or spilling the output
+  [[nodiscard]] const error::VoidResult &status() const noexcept {
+    return m_status;
+  }
+
+  [[nodiscard]] bool full() const noexcept {
+    return m_probe_rows.size() == config::VECTOR_SIZE;
+  }
+
+  void add(uint32_t probe_row, uint32_t build_row) {
+    m_probe_rows.push_back(probe_row);
+    m_build_rows.push_back(build_row);
+  }
+
+  void flush(const DataChunk &probe, const DataChunk *build) {
+    if (m_probe_rows.empty()) {
+      return;
+    }
+
+    DataChunk chunk(m_schema);
+    for (size_t c = 0; c < m_probe_columns; ++c) {
+      chunk.column(c).append_selected(probe.column(c), m_probe_rows);
+    }
+    if (m_type == JoinType::INNER || m_type == JoinType::LEFT) {
+      const size_t build_columns = m_schema.size() - m_probe_columns;
+      const bool padded =
+          build == nullptr || std::find(m_build_rows.begin(), m_build_rows.end(),
+                                        NO_MATCH) != m_build_rows.end();
+      for (size_t c = 0; c < build_columns; ++c) {
+        auto &column = chunk.column(m_probe_columns + c);
+        if (!padded) {
+          column.append_selected(build->column(c), m_build_rows);
+          continue;
+        }
+        for (auto row : m_build_rows) {
+          if (row == NO_MATCH) {
+            column.append_null();
+          } else {
+            column.append_from(build->column(c), row);
+          }
+        }
+      }
+    }
+    chunk.set_size(m_probe_rows.size());
+    m_probe_rows.clear();
+    m_build_rows.clear();
+    if (!m_status) {
+      return;
+    }
+    m_status = m_output.append_chunk(std::move(chunk));
+    if (m_status && m_budget != 0 && m_output.spillable_bytes() > m_budget) {
+      m_status = m_output.spill(m_spill_directory);
+    }
+  }
+
+private:
+  const Schema &m_schema;
+  size_t m_probe_columns;
+  JoinType m_type;
+  PartitionBuffer &m_output;
+  size_t m_budget;
+  const std::filesystem::path &m_spill_directory;
+  error::VoidResult m_status = error::ok();
+  std::vector<uint32_t> m_probe_rows;
+  std::vector<uint32_t> m_build_rows;
+};
+} // namespace
+
+/**
+ * @brief Partitions of both inputs and the output of the current wave
+ *
+ * @note Partition p of the build side only ever joins partition p of the
+ *       probe side, so a wave of partitions needs no synchronization
+ *       beyond the WorkerPool loop. Each partition of the wave writes its
+ *       own output partition, which next() then streams chunk by chunk.
+ */
+class RadixHashJoin::State {
+public:
+  WorkerPool &pool = WorkerPool::shared();
+  size_t threads{1};
+  unsigned partition_bits{DEFAULT_PARTITION_BITS};
+  std::vector<PartitionBuffer> build;
+  std::vector<PartitionBuffer> probe;
+  std::vector<DataChunk> null_keys; ///< LEFT/ANTI probe rows with a NULL key
+
+  size_t next_partition{0};
+  bool null_keys_emitted{false};
+  std::vector<PartitionBuffer> output; ///< Joined rows of the current wave
+  size_t output_position{0};           ///< Output partition being read
+
+  [[nodiscard]] size_t resident_bytes() const noexcept {
+    size_t bytes = 0;
+    for (size_t p = 0; p < build.size(); ++p) {
+      bytes += build[p].resident_bytes() + probe[p].resident_bytes();
+    }
+    return bytes;
+  }
+};
+
+RadixHashJoin::RadixHashJoin(OperatorPtr probe, OperatorPtr build,
+                             std::vector<size_t> probe_keys,
+                             std::vector<size_t> build_keys, JoinType type,
+                             RadixJoinOptions options)
+    : Operator(join_schema(probe->schema(), build->schema(), type)),
+      m_probe(std::move(probe)), m_build(std::move(build)),
+      m_probe_keys(std::move(probe_keys)),
+      m_build_keys(std::move(build_keys)), m_type(type),
+      m_options(std::move(options)) {}
+
+RadixHashJoin::~RadixHashJoin() = default;
+
+namespace {
+error::VoidResult first_error(const std::vector<error::VoidResult> &results) {
+  for (const auto &result : results) {
+    if (!result) {
+      return result;
+    }
+  }
+  return error::ok();
+}
+} // namespace
+
+error::VoidResult RadixHashJoin::enforce_budget() {
+  auto &s = *m_state;
+  const size_t budget = m_options.memory_budget;
+  const size_t resident = s.resident_bytes();
+  if (budget == 0 || resident <= budget) {
+    return error::ok();
+  }
+
+  std::vector<PartitionBuffer *> partitions;
+  for (size_t p = 0; p < s.build.size(); ++p) {
+    partitions.push_back(&s.build[p]);
+    partitions.push_back(&s.probe[p]);
+  }
+  return spill_largest(partitions, resident - budget,
+                       m_options.spill_directory, s.pool, s.threads);
+}
+
+error::VoidResult RadixHashJoin::partition_input(Operator &input, bool build) {
+  auto &s = *m_state;
+  const auto &keys = build ? m_build_keys : m_probe_keys;
+  auto &partitions = build ? s.build : s.probe;
+  // NULL keys never match: drop them unless the probe row is still output
+  const bool keep_null_keys =
+      !build && (m_type == JoinType::LEFT || m_type == JoinType::ANTI);
+
+  std::vector<DataChunk> batch(s.threads * CHUNKS_PER_THREAD);
+  std::vector<Route> routes(batch.size());
+  std::vector<error::VoidResult> results(partitions.size(), error::ok());
+  bool exhausted = false;
+  while (!exhausted) {
+    size_t filled = 0;
+    while (filled < batch.size()) {
+      auto more = input.next(batch[filled]);
+      if (!more) {
+        return tl::unexpected(more.error());
+      }
+      if (!*more) {
+        exhausted = true;
+        break;
+      }
+      ++filled;
+    }
+
+    s.pool.parallel_for(
+        filled,
+        [&](size_t i) {
+          auto &route = routes[i];
+          hash_keys(batch[i], keys, route.hashes, route.null_key);
+          radix_order(route.hashes, route.null_key, 64 - s.partition_bits,
+                      s.partition_bits, route.order, route.bounds);
+          route.nulls.clear();
+          if (keep_null_keys) {
+            for (size_t row = 0; row < route.null_key.size(); ++row) {
+              if (route.null_key[row]) {
+                route.nulls.push_back(static_cast<uint32_t>(row));
+              }
+            }
+          }
+        },
+        s.threads);
+
+    s.pool.parallel_for(
+        partitions.size(),
+        [&](size_t p) {
+          for (size_t i = 0; i < filled && results[p]; ++i) {
+            const auto &route = routes[i];
+            results[p] = partitions[p].append(
+                batch[i],
+                std::span(route.order)
+                    .subspan(route.bounds[p],
+                             route.bounds[p + 1] - route.bounds[p]),
+                route.hashes);
+          }
+        },
+        s.threads);
+    if (auto status = first_error(results); !status) {
+      return status;
+    }
+
+    for (size_t i = 0; i < filled; ++i) {
+      if (routes[i].nulls.empty()) {
+        continue;
+      }
+      s.null_keys.emplace_back(input.schema());
+      s.null_keys.back().append_selected(batch[i], routes[i].nulls);
+    }
+
+    if (auto status = enforce_budget(); !status) {
+      return status;
+    }
+  }
+
+  return error::ok();
+}
+
+error::VoidResult RadixHashJoin::join_partition(size_t p,
+                                                PartitionBuffer &output,
+                                                size_t output_budget) {
+  auto &s = *m_state;
+  const bool semi = m_type == JoinType::SEMI || m_type == JoinType::ANTI;
+  PartitionBuffer build = std::move(s.build[p]);
+  PartitionBuffer probe = std::move(s.probe[p]);
+  if (probe.rows() == 0 ||
+      (build.rows() == 0 &&
+       (m_type == JoinType::INNER || m_type == JoinType::SEMI))) {
+    return error::ok();
+  }
+
+  // Second pass: split so that every table fits CACHE_TABLE_BYTES
+  unsigned sub_bits = 0;
+  while (sub_bits < MAX_SUB_BITS && (build.rows() >> sub_bits) > CACHE_ROWS) {
+    ++sub_bits;
+  }
+  const unsigned sub_shift = 64 - s.partition_bits - sub_bits;
+  const size_t subs = size_t{1} << sub_bits;
+
+  std::vector<DataChunk> build_subs(subs);
+  for (auto &sub : build_subs) {
+    sub.initialize(build.layout(), 0);
+  }
+  {
+    DataChunk chunk;
+    std::vector<uint32_t> order;
+    std::vector<uint32_t> bounds;
+    while (true) {
+      auto more = build.read(chunk);
+      if (!more) {
+        return tl::unexpected(more.error());
+      }
+      if (!*more) {
+        break;
+      }
+      // Conservative: each sub-partition could receive the whole chunk
+      for (const auto &sub : build_subs) {
+        if (!sub.range_fits(chunk, 0, chunk.size())) {
+          return error::error<void>(error::ErrorCode::OUT_OF_MEMORY);
+        }
+      }
+      if (subs == 1) {
+        build_subs[0].append_range(chunk, 0, chunk.size());
+        continue;
+      }
+      radix_order({hash_column(chunk), chunk.size()}, {}, sub_shift, sub_bits,
+                  order, bounds);
+      for (size_t sub = 0; sub < subs; ++sub) {
+        build_subs[sub].append_selected(
+            chunk, std::span(order).subspan(bounds[sub],
+                                            bounds[sub + 1] - bounds[sub]));
+      }
+    }
+  }
+
+  // One table per sub-partition, laid out back to back
+  std::vector<size_t> table_offsets(subs + 1, 0);
+  for (size_t sub = 0; sub < subs; ++sub) {
+    table_offsets[sub + 1] =
+        table_offsets[sub] +
+        std::bit_ceil(std::max<size_t>(build_subs[sub].size() * 2, 16));
+  }
+  std::vector<Slot> slots(table_offsets[subs], Slot{0, EMPTY_ROW});
+  for (size_t sub = 0; sub < subs; ++sub) {
+    Slot *table = slots.data() + table_offsets[sub];
+    const uint64_t mask = table_offsets[sub + 1] - table_offsets[sub] - 1;
+    const uint64_t *hashes = hash_column(build_subs[sub]);
+    for (size_t row = 0; row < build_subs[sub].size(); ++row) {
+      uint64_t slot = hashes[row] & mask;
+      while (table[slot].row != EMPTY_ROW) {
+        slot = (slot + 1) & mask;
+      }
+      table[slot] = {slot_tag(hashes[row]), static_cast<uint32_t>(row)};
+    }
+  }
+
+  const size_t probe_columns = m_probe->schema().size();
+  JoinEmitter emitter(schema(), probe_columns, m_type, output, output_budget,
+                      m_options.spill_directory);
+  auto probe_chunk = [&](const DataChunk &chunk, size_t sub) {
+    const DataChunk &table_rows = build_subs[sub];
+    const Slot *table = slots.data() + table_offsets[sub];
+    const uint64_t mask = table_offsets[sub + 1] - table_offsets[sub] - 1;
+    const uint64_t *hashes = hash_column(chunk);
+    const size_t rows = chunk.size();
+
+    auto keys_equal = [&](size_t probe_row, size_t build_row) {
+      for (size_t k = 0; k < m_probe_keys.size(); ++k) {
+        if (chunk.column(m_probe_keys[k])
+                .compare(probe_row, table_rows.column(m_build_keys[k]),
+                         build_row) != 0) {
+          return false;
+        }
+      }
+      return true;
+    };
+
+    for (size_t row = 0; row < rows; ++row) {
+      if (row + PREFETCH_DISTANCE < rows) {
+        __builtin_prefetch(&table[hashes[row + PREFETCH_DISTANCE] & mask]);
+      }
+
+      const uint32_t tag = slot_tag(hashes[row]);
+      bool matched = false;
+      for (uint64_t slot = hashes[row] & mask; table[slot].row != EMPTY_ROW;
+           slot = (slot + 1) & mask) {
+        if (table[slot].tag != tag || !keys_equal(row, table[slot].row)) {
+          continue;
+        }
+        matched = true;
+        if (semi) {
+          break;
+        }
+        if (emitter.full()) {
+          emitter.flush(chunk, &table_rows);
+        }
+        emitter.add(static_cast<uint32_t>(row), table[slot].row);
+      }
+
+      const bool emit_probe_only = (m_type == JoinType::SEMI && matched) ||
+                                   (m_type != JoinType::SEMI &&
+                                    m_type != JoinType::INNER && !matched);
+      if (emit_probe_only) {
+        if (emitter.full()) {
+          emitter.flush(chunk, &table_rows);
+        }
+        emitter.add(static_cast<uint32_t>(row), NO_MATCH);
+      }
+    }
+    emitter.flush(chunk, &table_rows);
+  };
+
+  // Probe in batches regrouped by sub-partition, so each table stays hot
+  std::vector<DataChunk> probe_subs(subs);
+  for (auto &sub : probe_subs) {
+    sub.initialize(probe.layout(), 0);
+  }
+  DataChunk chunk;
+  std::vector<uint32_t> order;
+  std::vector<uint32_t> bounds;
+  bool exhausted = false;
+  while (!exhausted) {
+    size_t batched = 0;
+    for (auto &sub : probe_subs) {
+      sub.clear();
+    }
+    while (batched < PROBE_BATCH_CHUNKS) {
+      auto more = probe.read(chunk);
+      if (!more) {
+        return tl::unexpected(more.error());
+      }
+      if (!*more) {
+        exhausted = true;
+        break;
+      }
+      if (subs == 1) {
+        probe_chunk(chunk, 0);
+        continue;
+      }
+      radix_order({hash_column(chunk), chunk.size()}, {}, sub_shift, sub_bits,
+                  order, bounds);
+      for (size_t sub = 0; sub < subs; ++sub) {
+        probe_subs[sub].append_selected(
+            chunk, std::span(order).subspan(bounds[sub],
+                                            bounds[sub + 1] - bounds[sub]));
+      }
+      ++batched;
+    }
+
+    for (size_t sub = 0; sub < subs && batched > 0; ++sub) {
+      if (!probe_subs[sub].empty()) {
+        probe_chunk(probe_subs[sub], sub);
+      }
+    }
+    if (!emitter.status()) {
+      break;
+    }
+  }
+
+  return emitter.status();
+}
+
+error::Result<bool> RadixHashJoin::next(DataChunk &output) {
+  if (!m_state) {
+    if (auto valid = validate_keys(m_probe->schema(), m_build->schema(),
+                                   m_probe_keys, m_build_keys);
+        !valid) {
+      return tl::unexpected(valid.error());
+    }
+
+    m_state = std::make_unique<State>();
+    auto &s = *m_state;
+    s.threads = m_options.threads == 0
+                    ? s.pool.concurrency()
+                    : std::min(m_options.threads, s.pool.concurrency());
+    s.partition_bits = partition_bits(m_options.partition_bits);
+    const auto build_layout = with_hash_column(m_build->schema());
+    const auto probe_layout = with_hash_column(m_probe->schema());
+    for (size_t p = 0; p < (size_t{1} << s.partition_bits); ++p) {
+      s.build.emplace_back(build_layout);
+      s.probe.emplace_back(probe_layout);
+    }
+
+    if (auto status = partition_input(*m_build, true); !status) {
+      m_state.reset();
+      return tl::unexpected(status.error());
+    }
+
+    // No build rows: INNER and SEMI produce nothing, so skip the probe side
+    const bool empty_build =
+        std::all_of(s.build.begin(), s.build.end(),
+                    [](const PartitionBuffer &p) { return p.rows() == 0; });
+    if (empty_build &&
+        (m_type == JoinType::INNER || m_type == JoinType::SEMI)) {
+      s.next_partition = s.build.size();
+      s.null_keys_emitted = true;
+    } else if (auto status = partition_input(*m_probe, false); !status) {
+      m_state.reset();
+      return tl::unexpected(status.error());
+    }
+  }
+
+  auto &s = *m_state;
+  prepare(output);
+  while (true) {
+    if (s.output_position < s.output.size()) {
+      auto more = s.output[s.output_position].read(output);
+      if (!more) {
+        return tl::unexpected(more.error());
+      }
+      if (*more) {
+        return true;
+      }
+      ++s.output_position;
+      continue;
+    }
+    s.output.clear();
+    s.output_position = 0;
+
+    if (s.next_partition < s.build.size()) {
+      // A wave of partitions whose build sides fit the budget together
+      const size_t first = s.next_partition;
+      size_t bytes = 0;
+      while (s.next_partition < s.build.size() &&
+             s.next_partition - first < s.threads) {
+        const size_t needed = s.build[s.next_partition].total_bytes();
+        if (m_options.memory_budget != 0 && s.next_partition > first &&
+            bytes + needed > m_options.memory_budget) {
+          break;
+        }
+        bytes += needed;
+        ++s.next_partition;
+      }
+
+      // The wave's outputs share the budget too
+      const size_t count = s.next_partition - first;
+      const size_t output_budget = m_options.memory_budget / count;
+      for (size_t i = 0; i < count; ++i) {
+        s.output.emplace_back(schema());
+      }
+      std::vector<error::VoidResult> results(count, error::ok());
+      s.pool.parallel_for(
+          count,
+          [&](size_t i) {
+            results[i] = join_partition(first + i, s.output[i], output_budget);
+          },
+          s.threads);
+      if (auto status = first_error(results); !status) {
+        return tl::unexpected(status.error());
+      }
+      continue;
+    }
+
+    if (!s.null_keys_emitted) {
+      s.null_keys_emitted = true;
+      s.output.emplace_back(schema());
+      JoinEmitter emitter(schema(), m_probe->schema().size(), m_type,
+                          s.output.back(), m_options.memory_budget,
+                          m_options.spill_directory);
+      for (const auto &chunk : s.null_keys) {
+        for (size_t row = 0; row < chunk.size(); ++row) {
+          emitter.add(static_cast<uint32_t>(row), NO_MATCH);
+        }
+        emitter.flush(chunk, nullptr);
+      }
+      s.null_keys.clear();
+      if (!emitter.status()) {
+        return tl::unexpected(emitter.status().error());
+      }
+      continue;
+    }
+
+    return false;
+  }
+}
+
+void RadixHashJoin::reset() {
+  m_probe->reset();
+  m_build->reset();
+  m_state.reset();
+}
+
+std::string RadixHashJoin::name() const {
+  const unsigned bits = partition_bits(m_options.partition_bits);
+  return fmt::format("RadixHashJoin({}: {}, partitions={})",
+                     to_string(m_type),
+                     join_condition(m_probe->schema(), m_build->schema(),
+                                    m_probe_keys, m_build_keys),
+                     size_t{1} << bits);
+}
+
+} // namespace velox::query
@@ -0,0 +1,902 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <functional>
+#include <type_traits>
+#include <velox/query/kernels.hpp>
+
+#if (defined(__GNUC__) || defined(__clang__)) &&                              \
+    (defined(__x86_64__) || defined(__i386__))
+#define VELOX_KERNELS_X86 1
+#include <immintrin.h>
+
+#define VELOX_TARGET_AVX2 __attribute__((target("avx2")))
+#define VELOX_TARGET_AVX512                                                    \
+  __attribute__((target("avx512f,avx512bw,avx512vl,avx2")))
+#endif
+
+namespace velox::query::kernels {
+namespace {
+SimdLevel detect_simd_level() noexcept {
+#ifdef VELOX_KERNELS_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+    return SimdLevel::AVX512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::AVX2;
+  }
+#endif
+  return SimdLevel::SCALAR;
+}
+
+std::atomic<SimdLevel> &active_level() noexcept {
+  static std::atomic<SimdLevel> level{detected_simd_level()};
+  return level;
+}
+
+/// @brief Bits covering the first lanes of a mask
+constexpr uint64_t lane_mask(size_t lanes) noexcept {
+  return lanes >= 64 ? ~uint64_t{0} : (uint64_t{1} << lanes) - 1;
+}
+
+/// @brief Invoke fn with std::integral_constant<CompareOp, op>
+template <typename Fn> void with_compare_op(CompareOp op, Fn &&fn) {
+  switch (op) {
+  case CompareOp::EQ:
+    return fn(std::integral_constant<CompareOp, CompareOp::EQ>{});
+  case CompareOp::NE:
+    return fn(std::integral_constant<CompareOp, CompareOp::NE>{});
+  case CompareOp::LT:
+    return fn(std::integral_constant<CompareOp, CompareOp::LT>{});
+  case CompareOp::LE:
+    return fn(std::integral_constant<CompareOp, CompareOp::LE>{});
+  case CompareOp::GT:
+    return fn(std::integral_constant<CompareOp, CompareOp::GT>{});
+  case CompareOp::GE:
+    return fn(std::integral_constant<CompareOp, CompareOp::GE>{});
+  }
+}
+
+template <CompareOp Op, typename T> constexpr bool apply(T a, T b) noexcept {
+  if constexpr (Op == CompareOp::EQ) {
+    return a == b;
+  } else if constexpr (Op == CompareOp::NE) {
+    return a != b;
+  } else if constexpr (Op == CompareOp::LT) {
+    return a < b;
+  } else if constexpr (Op == CompareOp::LE) {
+    return a <= b;
+  } else if constexpr (Op == CompareOp::GT) {
+    return a > b;
+  } else {
+    return a >= b;
+  }
+}
+
+/**
+ * @brief Fill bitmap words [first_word, bitmap_words(n)) one row at a time
+ *
+ * @note Used for the whole input at SimdLevel::SCALAR and for the partial
+ *       trailing word otherwise. Bits past row n are cleared.
+ */
+template <typename T, typename Pred>
+void scalar_words(const T *values, size_t first_word, size_t n,
+                  uint64_t *bitmap, Pred pred) noexcept {
+  for (size_t w = first_word; w < bitmap_words(n); ++w) {
+    const size_t base = w * 64;
+    const size_t count = std::min<size_t>(64, n - base);
+    uint64_t bits = 0;
+    for (size_t j = 0; j < count; ++j) {
+      bits |= static_cast<uint64_t>(pred(values[base + j])) << j;
+    }
+    bitmap[w] = bits;
+  }
+}
+
+#ifdef VELOX_KERNELS_X86
+// AVX2: compares produce all-ones lanes that movemask packs into bits.
+// Integer types only have == and signed >, so the other operators are
+// derived from those two.
+
+template <typename T> struct Avx2;
+
+template <typename Self> struct Avx2Integer {
+  template <CompareOp Op>
+  VELOX_TARGET_AVX2 static uint64_t cmp(__m256i a, __m256i b) noexcept {
+    constexpr uint64_t all = lane_mask(Self::LANES);
+    if constexpr (Op == CompareOp::EQ) {
+      return Self::eq(a, b);
+    } else if constexpr (Op == CompareOp::NE) {
+      return ~Self::eq(a, b) & all;
+    } else if constexpr (Op == CompareOp::LT) {
+      return Self::gt(b, a);
+    } else if constexpr (Op == CompareOp::LE) {
+      return ~Self::gt(a, b) & all;
+    } else if constexpr (Op == CompareOp::GT) {
+      return Self::gt(a, b);
+    } else {
+      return ~Self::gt(b, a) & all;
+    }
+  }
+};
+
+template <> struct Avx2<int8_t> : Avx2Integer<Avx2<int8_t>> {
+  using Reg = __m256i;
+  static constexpr size_t LANES = 32;
+
+  VELOX_TARGET_AVX2 static Reg load(const int8_t *p) noexcept {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  VELOX_TARGET_AVX2 static Reg set1(int8_t v) noexcept {
+    return _mm256_set1_epi8(v);
+  }
+  VELOX_TARGET_AVX2 static uint64_t eq(Reg a, Reg b) noexcept {
+    return static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+  }
+  VELOX_TARGET_AVX2 static uint64_t gt(Reg a, Reg b) noexcept {
+    return static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpgt_epi8(a, b)));
+  }
+};
+
+template <> struct Avx2<int16_t> : Avx2Integer<Avx2<int16_t>> {
+  using Reg = __m256i;
+  static constexpr size_t LANES = 16;
+
+  VELOX_TARGET_AVX2 static Reg load(const int16_t *p) noexcept {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  VELOX_TARGET_AVX2 static Reg set1(int16_t v) noexcept {
+    return _mm256_set1_epi16(v);
+  }
+  /// Narrow 16-bit lane masks to bytes; packs interleaves the 128-bit
+  /// halves, so lanes 0-7 land in bits 0-7 and lanes 8-15 in bits 16-23
+  VELOX_TARGET_AVX2 static uint64_t bits(Reg mask) noexcept {
+    const auto packed = static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_packs_epi16(mask, mask)));
+    return (packed & 0xFF) | ((packed >> 8) & 0xFF00);
+  }
+  VELOX_TARGET_AVX2 static uint64_t eq(Reg a, Reg b) noexcept {
+    return bits(_mm256_cmpeq_epi16(a, b));
+  }
+  VELOX_TARGET_AVX2 static uint64_t gt(Reg a, Reg b) noexcept {
+    return bits(_mm256_cmpgt_epi16(a, b));
+  }
+};
+
+template <> struct Avx2<int32_t> : Avx2Integer<Avx2<int32_t>> {
+  using Reg = __m256i;
+  static constexpr size_t LANES = 8;
+
+  VELOX_TARGET_AVX2 static Reg load(const int32_t *p) noexcept {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  VELOX_TARGET_AVX2 static Reg set1(int32_t v) noexcept {
+    return _mm256_set1_epi32(v);
+  }
+  VELOX_TARGET_AVX2 static uint64_t eq(Reg a, Reg b) noexcept {
+    return static_cast<uint32_t>(
+        _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))));
+  }
+  VELOX_TARGET_AVX2 static uint64_t gt(Reg a, Reg b) noexcept {
+    return static_cast<uint32_t>(
+        _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(a, b))));
+  }
+};
+
+template <> struct Avx2<int64_t> : Avx2Integer<Avx2<int64_t>> {
+  using Reg = __m256i;
+  static constexpr size_t LANES = 4;
+
+  VELOX_TARGET_AVX2 static Reg load(const int64_t *p) noexcept {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  VELOX_TARGET_AVX2 static Reg set1(int64_t v) noexcept {
+    return _mm256_set1_epi64x(v);
+  }
+  VELOX_TARGET_AVX2 static uint64_t eq(Reg a, Reg b) noexcept {
+    return static_cast<uint32_t>(
+        _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b))));
+  }
+  VELOX_TARGET_AVX2 static uint64_t gt(Reg a, Reg b) noexcept {
+    return static_cast<uint32_t>(
+        _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(a, b))));
+  }
+};
+
+/// @brief Ordered (NaN fails) predicates, except <> which NaN satisfies
+constexpr int float_predicate(CompareOp op) noexcept {
+  switch (op) {
+  case CompareOp::EQ:
+    return _CMP_EQ_OQ;
+  case CompareOp::NE:
+    return _CMP_NEQ_UQ;
+  case CompareOp::LT:
+    return _CMP_LT_OQ;
+  case CompareOp::LE:
+    return _CMP_LE_OQ;
+  case CompareOp::GT:
+    return _CMP_GT_OQ;
+  case CompareOp::GE:
+    break;
+  }
+  return _CMP_GE_OQ;
+}
+
+template <> struct Avx2<float> {
+  using Reg = __m256;
+  static constexpr size_t LANES = 8;
+
+  VELOX_TARGET_AVX2 static Reg load(const float *p) noexcept {
+    return _mm256_loadu_ps(p);
+  }
+  VELOX_TARGET_AVX2 static Reg set1(float v) noexcept {
+    return _mm256_set1_ps(v);
+  }
+  template <CompareOp Op>
+  VELOX_TARGET_AVX2 static uint64_t cmp(Reg a, Reg b) noexcept {
+    constexpr int PREDICATE = float_predicate(Op);
+    return static_cast<uint32_t>(
+        _mm256_movemask_ps(_mm256_cmp_ps(a, b, PREDICATE)));
+  }
+};
+
+template <> struct Avx2<double> {
+  using Reg = __m256d;
+  static constexpr size_t LANES = 4;
+
+  VELOX_TARGET_AVX2 static Reg load(const double *p) noexcept {
+    return _mm256_loadu_pd(p);
+  }
+  VELOX_TARGET_AVX2 static Reg set1(double v) noexcept {
+    return _mm256_set1_pd(v);
+  }
+  template <CompareOp Op>
+  VELOX_TARGET_AVX2 static uint64_t cmp(Reg a, Reg b) noexcept {
+    constexpr int PREDICATE = float_predicate(Op);
+    return static_cast<uint32_t>(
+        _mm256_movemask_pd(_mm256_cmp_pd(a, b, PREDICATE)));
+  }
+};
+
+/// @brief Full 64-row words of a bitmap, built with AVX2
+template <typename T> struct Avx2Loops {
+  using V = Avx2<T>;
+
+  template <CompareOp Op>
+  VELOX_TARGET_AVX2 static void compare(const T *values, size_t words,
+                                        T value, uint64_t *bitmap) noexcept {
+    const auto rhs = V::set1(value);
+    for (size_t w = 0; w < words; ++w) {
+      uint64_t bits = 0;
+      for (size_t j = 0; j < 64; j += V::LANES) {
+        bits |= V::template cmp<Op>(V::load(values + w * 64 + j), rhs) << j;
+      }
+      bitmap[w] = bits;
+    }
+  }
+
+  VELOX_TARGET_AVX2 static void between(const T *values, size_t words,
+                                        T low, T high,
+                                        uint64_t *bitmap) noexcept {
+    const auto lo = V::set1(low);
+    const auto hi = V::set1(high);
+    for (size_t w = 0; w < words; ++w) {
+      uint64_t bits = 0;
+      for (size_t j = 0; j < 64; j += V::LANES) {
+        const auto x = V::load(values + w * 64 + j);
+        bits |= (V::template cmp<CompareOp::GE>(x, lo) &
+                 V::template cmp<CompareOp::LE>(x, hi))
+                << j;
+      }
+      bitmap[w] = bits;
+    }
+  }
+
+  VELOX_TARGET_AVX2 static void in_list(const T *values, size_t words,
+                                        const T *list, size_t count,
+                                        uint64_t *bitmap) noexcept {
+    typename V::Reg needles[IN_LIST_SIMD_LIMIT];
+    for (size_t k = 0; k < count; ++k) {
+      needles[k] = V::set1(list[k]);
+    }
+    for (size_t w = 0; w < words; ++w) {
+      uint64_t bits = 0;
+      for (size_t j = 0; j < 64; j += V::LANES) {
+        const auto x = V::load(values + w * 64 + j);
+        uint64_t lanes = 0;
+        for (size_t k = 0; k < count; ++k) {
+          lanes |= V::template cmp<CompareOp::EQ>(x, needles[k]);
+        }
+        bits |= lanes << j;
+      }
+      bitmap[w] = bits;
+    }
+  }
+};
+
+// AVX-512: compares write mask registers directly, for every operator.
+
+constexpr int int_predicate(CompareOp op) noexcept {
+  switch (op) {
+  case CompareOp::EQ:
+    return _MM_CMPINT_EQ;
+  case CompareOp::NE:
+    return _MM_CMPINT_NE;
+  case CompareOp::LT:
+    return _MM_CMPINT_LT;
+  case CompareOp::LE:
+    return _MM_CMPINT_LE;
+  case CompareOp::GT:
+    return _MM_CMPINT_NLE;
+  case CompareOp::GE:
+    break;
+  }
+  return _MM_CMPINT_NLT;
+}
+
+template <typename T> struct Avx512;
+
+template <> struct Avx512<int8_t> {
+  using Reg = __m512i;
+  static constexpr size_t LANES = 64;
+
+  VELOX_TARGET_AVX512 static Reg load(const int8_t *p) noexcept {
+    return _mm512_loadu_si512(p);
+  }
+  VELOX_TARGET_AVX512 static Reg set1(int8_t v) noexcept {
+    return _mm512_set1_epi8(v);
+  }
+  template <CompareOp Op>
+  VELOX_TARGET_AVX512 static uint64_t cmp(Reg a, Reg b) noexcept {
+    constexpr int PREDICATE = int_predicate(Op);
+    return _mm512_cmp_epi8_mask(a, b, PREDICATE);
+  }
+};
+
+template <> struct Avx512<int16_t> {
+  using Reg = __m512i;
+  static constexpr size_t LANES = 32;
+
+  VELOX_TARGET_AVX512 static Reg load(const int16_t *p) noexcept {
+    return _mm512_loadu_si512(p);
+  }
+  VELOX_TARGET_AVX512 static Reg set1(int16_t v) noexcept {
+    return _mm512_set1_epi16(v);
+  }
+  template <CompareOp Op>
+  VELOX_TARGET_AVX512 static uint64_t cmp(Reg a, Reg b) noexcept {
+    constexpr int PREDICATE = int_predicate(Op);
+    return _mm512_cmp_epi16_mask(a, b, PREDICATE);
+  }
+};
+
+template <> struct Avx512<int32_t> {
+  using Reg = __m512i;
+  static constexpr size_t LANES = 16;
+
+  VELOX_TARGET_AVX512 static Reg load(const int32_t *p) noexcept {
+    return _mm512_loadu_si512(p);
+  }
+  VELOX_TARGET_AVX512 static Reg set1(int32_t v) noexcept {
+    return _mm512_set1_epi32(v);
+  }
+  template <CompareOp Op>
+  VELOX_TARGET_AVX512 static uint64_t cmp(Reg a, Reg b) noexcept {
+    constexpr int PREDICATE = int_predicate(Op);
+    return _mm512_cmp_epi32_mask(a, b, PREDICATE);
+  }
+};
+
+template <> struct Avx512<int64_t> {
+  using Reg = __m512i;
+  static constexpr size_t LANES = 8;
+
+  VELOX_TARGET_AVX512 static Reg load(const int64_t *p) noexcept {
+    return _mm512_loadu_si512(p);
+  }
+  VELOX_TARGET_AVX512 static Reg set1(int64_t v) noexcept {
+    return _mm512_set1_epi64(v);
+  }
+  template <CompareOp Op>
+  VELOX_TARGET_AVX512 static uint64_t cmp(Reg a, Reg b) noexcept {
+    constexpr int PREDICATE = int_predicate(Op);
+    return _mm512_cmp_epi64_mask(a, b, PREDICATE);
+  }
+};
+
+template <> struct Avx512<float> {
+  using Reg = __m512;
+  static constexpr size_t LANES = 16;
+
+  VELOX_TARGET_AVX512 static Reg load(const float *p) noexcept {
+    return _mm512_loadu_ps(p);
+  }
+  VELOX_TARGET_AVX512 static Reg set1(float v) noexcept {
+    return _mm512_set1_ps(v);
+  }
+  template <CompareOp Op>
+  VELOX_TARGET_AVX512 static uint64_t cmp(Reg a, Reg b) noexcept {
+    constexpr int PREDICATE = float_predicate(Op);
+    return _mm512_cmp_ps_mask(a, b, PREDICATE);
+  }
+};
+
+template <> struct Avx512<double> {
+  using Reg = __m512d;
+  static constexpr size_t LANES = 8;
+
+  VELOX_TARGET_AVX512 static Reg load(const double *p) noexcept {
+    return _mm512_loadu_pd(p);
+  }
+  VELOX_TARGET_AVX512 static Reg set1(double v) noexcept {
+    return _mm512_set1_pd(v);
+  }
+  template <CompareOp Op>
+  VELOX_TARGET_AVX512 static uint64_t cmp(Reg a, Reg b) noexcept {
+    constexpr int PREDICATE = float_predicate(Op);
+    return _mm512_cmp_pd_mask(a, b, PREDICATE);
+  }
+};
+
+/// @brief Full 64-row words of a bitmap, built with AVX-512
+template <typename T> struct Avx512Loops {
+  using V = Avx512<T>;
+
+  template <CompareOp Op>
+  VELOX_TARGET_AVX512 static void compare(const T *values, size_t words,
+                                          T value,
+                                          uint64_t *bitmap) noexcept {
+    const auto rhs = V::set1(value);
+    for (size_t w = 0; w < words; ++w) {
+      uint64_t bits = 0;
+      for (size_t j = 0; j < 64; j += V::LANES) {
+        bits |= V::template cmp<Op>(V::load(values + w * 64 + j), rhs) << j;
+      }
+      bitmap[w] = bits;
+    }
+  }
+
+  VELOX_TARGET_AVX512 static void between(const T *values, size_t words,
+                                          T low, T high,
+                                          uint64_t *bitmap) noexcept {
+    const auto lo = V::set1(low);
+    const auto hi = V::set1(high);
+    for (size_t w = 0; w < words; ++w) {
+      uint64_t bits = 0;
+      for (size_t j = 0; j < 64; j += V::LANES) {
+        const auto x = V::load(values + w * 64 + j);
+        bits |= (V::template cmp<CompareOp::GE>(x, lo) &
+                 V::template cmp<CompareOp::LE>(x, hi))
+                << j;
+      }
+      bitmap[w] = bits;
+    }
+  }
+
+  VELOX_TARGET_AVX512 static void in_list(const T *values, size_t words,
+                                          const T *list, size_t count,
+                                          uint64_t *bitmap) noexcept {
+    typename V::Reg needles[IN_LIST_SIMD_LIMIT];
+    for (size_t k = 0; k < count; ++k) {
+      needles[k] = V::set1(list[k]);
+    }
+    for (size_t w = 0; w < words; ++w) {
+      uint64_t bits = 0;
+      for (size_t j = 0; j < 64; j += V::LANES) {
+        const auto x = V::load(values + w * 64 + j);
+        uint64_t lanes = 0;
+        for (size_t k = 0; k < count; ++k) {
+          lanes |= V::template cmp<CompareOp::EQ>(x, needles[k]);
+        }
+        bits |= lanes << j;
+      }
+      bitmap[w] = bits;
+    }
+  }
+};
+
+/// @brief Indices of the set bits of every byte value, packed one per byte
+constexpr std::array<uint64_t, 256> SELECTION_TABLE = [] {
+  std::array<uint64_t, 256> table{};
+  for (size_t mask = 0; mask < 256; ++mask) {
+    size_t count = 0;
+    for (uint64_t bit = 0; bit < 8; ++bit) {
+      if (mask & (size_t{1} << bit)) {
+        table[mask] |= bit << (8 * count++);
+      }
+    }
+  }
+  return table;
+}();
+
+/**
+ * @brief Compact full bitmap words into row indices, 8 rows per step
+ *
+ * @note Writes 8 indices per step and advances by the popcount, so up to
+ *       7 slots past the result are scratch; they stay within words * 64.
+ */
+VELOX_TARGET_AVX2 size_t avx2_to_selection(const uint64_t *bitmap,
+                                           size_t words,
+                                           uint32_t *selection) noexcept {
+  size_t selected = 0;
+  for (size_t w = 0; w < words; ++w) {
+    const uint64_t bits = bitmap[w];
+    for (size_t k = 0; k < 8 && (bits >> (8 * k)) != 0; ++k) {
+      const auto mask = static_cast<uint8_t>(bits >> (8 * k));
+      const auto offsets = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(
+          static_cast<int64_t>(SELECTION_TABLE[mask])));
+      const auto base = _mm256_set1_epi32(static_cast<int>(w * 64 + 8 * k));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(selection + selected),
+                          _mm256_add_epi32(offsets, base));
+      selected += std::popcount(mask);
+    }
+  }
+
+  return selected;
+}
+
+/// @brief Compact full bitmap words with vpcompressd, 16 rows per step
+VELOX_TARGET_AVX512 size_t avx512_to_selection(const uint64_t *bitmap,
+                                               size_t words,
+                                               uint32_t *selection) noexcept {
+  const auto lanes = _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5,
+                                      4, 3, 2, 1, 0);
+  size_t selected = 0;
+  for (size_t w = 0; w < words; ++w) {
+    const uint64_t bits = bitmap[w];
+    for (size_t k = 0; k < 4 && (bits >> (16 * k)) != 0; ++k) {
+      const auto mask = static_cast<__mmask16>(bits >> (16 * k));
+      const auto rows = _mm512_add_epi32(
+          lanes, _mm512_set1_epi32(static_cast<int>(w * 64 + 16 * k)));
+      // Compress in a register then store: faster than compress-to-memory
+      _mm512_storeu_si512(selection + selected,
+                          _mm512_maskz_compress_epi32(mask, rows));
+      selected += std::popcount(static_cast<uint32_t>(mask));
+    }
+  }
+
+  return selected;
+}
+#endif
+
+/**
+ * @brief Run the SIMD loops of the active level over the full words
+ *
+ * @return Number of words written; the caller finishes the rest
+ */
+template <typename Avx2Fn, typename Avx512Fn>
+size_t simd_words(size_t n, Avx2Fn &&avx2, Avx512Fn &&avx512) {
+  const size_t words = n / 64;
+#ifdef VELOX_KERNELS_X86
+  switch (simd_level()) {
+  case SimdLevel::AVX512:
+    avx512(words);
+    return words;
+  case SimdLevel::AVX2:
+    avx2(words);
+    return words;
+  case SimdLevel::SCALAR:
+    break;
+  }
+#else
+  (void)words;
+  (void)avx2;
+  (void)avx512;
+#endif
+  return 0;
+}
+
+template <typename Fill>
+size_t select_with(size_t n, uint32_t *selection, Fill &&fill) {
+  // One bitmap block per VECTOR_SIZE rows keeps the scratch on the stack
+  constexpr size_t BLOCK = config::VECTOR_SIZE;
+  uint64_t bitmap[bitmap_words(BLOCK)];
+  size_t selected = 0;
+
+  for (size_t offset = 0; offset < n; offset += BLOCK) {
+    const size_t count = std::min(BLOCK, n - offset);
+    fill(offset, count, bitmap);
+    const size_t block_selected =
+        to_selection(bitmap, count, selection + selected);
+    for (size_t i = selected; i < selected + block_selected; ++i) {
+      selection[i] += static_cast<uint32_t>(offset);
+    }
+    selected += block_selected;
+  }
+
+  return selected;
+}
+
+/// @brief Clear every bit of a bitmap covering rows rows
+void clear_bitmap(uint64_t *bitmap, size_t rows) noexcept {
+  std::fill(bitmap, bitmap + bitmap_words(rows), uint64_t{0});
+}
+} // namespace
+
+SimdLevel detected_simd_level() noexcept {
+  static const SimdLevel level = detect_simd_level();
+  return level;
+}
+
+SimdLevel simd_level() noexcept {
+  return active_level().load(std::memory_order_relaxed);
+}
+
+SimdLevel set_simd_level(SimdLevel level) noexcept {
+  const auto effective = std::min(level, detected_simd_level());
+  active_level().store(effective, std::memory_order_relaxed);
+
+  return effective;
+}
+
+template <FilterValue T>
+void compare(std::span<const T> values, CompareOp op, T value,
+             uint64_t *bitmap) noexcept {
+  const T *data = values.data();
+  const size_t n = values.size();
+
+  with_compare_op(op, [&](auto tag) {
+    constexpr CompareOp Op = decltype(tag)::value;
+    const size_t done = simd_words(
+        n,
+        [&](size_t words) {
+#ifdef VELOX_KERNELS_X86
+          Avx2Loops<T>::template compare<Op>(data, words, value, bitmap);
+#endif
+        },
+        [&](size_t words) {
+#ifdef VELOX_KERNELS_X86
+          Avx512Loops<T>::template compare<Op>(data, words, value, bitmap);
+#endif
+        });
+    scalar_words(data, done, n, bitmap,
+                 [value](T x) { return apply<Op>(x, value); });
+  });
+}
+
+template <FilterValue T>
+void between(std::span<const T> values, T low, T high,
+             uint64_t *bitmap) noexcept {
+  const T *data = values.data();
+  const size_t n = values.size();
+
+  const size_t done = simd_words(
+      n,
+      [&](size_t words) {
+#ifdef VELOX_KERNELS_X86
+        Avx2Loops<T>::between(data, words, low, high, bitmap);
+#endif
+      },
+      [&](size_t words) {
+#ifdef VELOX_KERNELS_X86
+        Avx512Loops<T>::between(data, words, low, high, bitmap);
+#endif
+      });
+  scalar_words(data, done, n, bitmap,
+               [low, high](T x) { return low <= x && x <= high; });
+}
+
+template <FilterValue T>
+void in_list(std::span<const T> values, std::span<const T> list,
+             uint64_t *bitmap) noexcept {
+  const T *data = values.data();
+  const size_t n = values.size();
+
+  if (list.empty()) {
+    clear_bitmap(bitmap, n);
+    return;
+  }
+
+  size_t done = 0;
+  if (list.size() <= IN_LIST_SIMD_LIMIT) {
+    done = simd_words(
+        n,
+        [&](size_t words) {
+#ifdef VELOX_KERNELS_X86
+          Avx2Loops<T>::in_list(data, words, list.data(), list.size(),
+                                bitmap);
+#endif
+        },
+        [&](size_t words) {
+#ifdef VELOX_KERNELS_X86
+          Avx512Loops<T>::in_list(data, words, list.data(), list.size(),
+                                  bitmap);
+#endif
+        });
+  }
+
+  // Out-of-range values skip the search entirely
+  const T first = list.front();
+  const T last = list.back();
+  scalar_words(data, done, n, bitmap, [&](T x) {
+    return first <= x && x <= last &&
+           std::binary_search(list.begin(), list.end(), x);
+  });
+}
+
+size_t to_selection(const uint64_t *bitmap, size_t rows,
+                    uint32_t *selection) noexcept {
+  size_t selected = 0;
+  size_t done = 0;
+
+#ifdef VELOX_KERNELS_X86
+  switch (simd_level()) {
+  case SimdLevel::AVX512:
+    done = rows / 64;
+    selected = avx512_to_selection(bitmap, done, selection);
+    break;
+  case SimdLevel::AVX2:
+    done = rows / 64;
+    selected = avx2_to_selection(bitmap, done, selection);
+    break;
+  case SimdLevel::SCALAR:
+    break;
+  }
+#endif
+
+  for (size_t w = done; w < bitmap_words(rows); ++w) {
+    uint64_t bits = bitmap[w] & lane_mask(rows - w * 64);
+    const auto base = static_cast<uint32_t>(w * 64);
+    while (bits != 0) {
+      selection[selected++] = base + std::countr_zero(bits);
+      bits &= bits - 1;
+    }
+  }
+
+  return selected;
+}
+
+void bitmap_and(uint64_t *bitmap, const uint64_t *other,
+                size_t words) noexcept {
+  for (size_t w = 0; w < words; ++w) {
+    bitmap[w] &= other[w];
+  }
+}
+
+template <FilterValue T>
+size_t select_compare(std::span<const T> values, CompareOp op, T value,
+                      uint32_t *selection) noexcept {
+  return select_with(
+      values.size(), selection,
+      [&](size_t offset, size_t count, uint64_t *bitmap) {
+        compare<T>(values.subspan(offset, count), op, value, bitmap);
+      });
+}
+
+template <FilterValue T>
+size_t select_between(std::span<const T> values, T low, T high,
+                      uint32_t *selection) noexcept {
+  return select_with(
+      values.size(), selection,
+      [&](size_t offset, size_t count, uint64_t *bitmap) {
+        between<T>(values.subspan(offset, count), low, high, bitmap);
+      });
+}
+
+template <FilterValue T>
+size_t select_in(std::span<const T> values, std::span<const T> list,
+                 uint32_t *selection) noexcept {
+  return select_with(
+      values.size(), selection,
+      [&](size_t offset, size_t count, uint64_t *bitmap) {
+        in_list<T>(values.subspan(offset, count), list, bitmap);
+      });
+}
+
+// Column-level entry points
+
+void compare(const ColumnVector &column, CompareOp op,
+             const ColumnVector &scalar, uint64_t *bitmap) noexcept {
+  const size_t n = column.size();
+  if (!scalar.is_valid(0)) {
+    clear_bitmap(bitmap, n);
+    return;
+  }
+
+  if (column.physical() == PhysicalType::VARLEN) {
+    match(column, StringMatch::EQUALS, scalar.string_at(0), false, bitmap);
+    if (op == CompareOp::NE) {
+      for (size_t w = 0; w < bitmap_words(n); ++w) {
+        bitmap[w] = ~bitmap[w] & lane_mask(n - w * 64);
+      }
+      if (column.may_have_nulls()) {
+        bitmap_and(bitmap, column.validity(), bitmap_words(n));
+      }
+    }
+    return;
+  }
+
+  dispatch_fixed(column.physical(), [&](auto tag) {
+    using T = typename decltype(tag)::type;
+    if constexpr (FilterValue<T>) {
+      compare<T>({column.data<T>(), n}, op, scalar.data<T>()[0], bitmap);
+    }
+  });
+  if (column.may_have_nulls()) {
+    bitmap_and(bitmap, column.validity(), bitmap_words(n));
+  }
+}
+
+void between(const ColumnVector &column, const ColumnVector &low,
+             const ColumnVector &high, uint64_t *bitmap) noexcept {
+  const size_t n = column.size();
+  if (!low.is_valid(0) || !high.is_valid(0)) {
+    clear_bitmap(bitmap, n);
+    return;
+  }
+
+  dispatch_fixed(column.physical(), [&](auto tag) {
+    using T = typename decltype(tag)::type;
+    if constexpr (FilterValue<T>) {
+      between<T>({column.data<T>(), n}, low.data<T>()[0], high.data<T>()[0],
+                 bitmap);
+    }
+  });
+  if (column.may_have_nulls()) {
+    bitmap_and(bitmap, column.validity(), bitmap_words(n));
+  }
+}
+
+void in_list(const ColumnVector &column, const ColumnVector &list,
+             uint64_t *bitmap) noexcept {
+  const size_t n = column.size();
+
+  dispatch_fixed(column.physical(), [&](auto tag) {
+    using T = typename decltype(tag)::type;
+    if constexpr (FilterValue<T>) {
+      in_list<T>({column.data<T>(), n}, {list.data<T>(), list.size()},
+                 bitmap);
+    }
+  });
+  if (column.may_have_nulls()) {
+    bitmap_and(bitmap, column.validity(), bitmap_words(n));
+  }
+}
+
+void bitmap_to_mask(const uint64_t *bitmap, size_t rows,
+                    ColumnVector &output) {
+  output.reset(dtypes::TypeInfo(dtypes::TypeId::BOOLEAN));
+  output.resize(rows);
+
+  uint8_t *out = output.data<uint8_t>();
+  for (size_t i = 0; i < rows; ++i) {
+    out[i] = (bitmap[i / 64] >> (i % 64)) & 1;
+  }
+}
+
+void mask_to_bitmap(const ColumnVector &mask, uint64_t *bitmap) noexcept {
+  const size_t n = mask.size();
+  scalar_words(mask.data<uint8_t>(), 0, n, bitmap,
+               [](uint8_t x) { return x != 0; });
+  if (mask.may_have_nulls()) {
+    bitmap_and(bitmap, mask.validity(), bitmap_words(n));
+  }
+}
+
+#define VELOX_INSTANTIATE_FILTER_KERNELS(T)                                    \
+  template void compare<T>(std::span<const T>, CompareOp, T,                   \
+                           uint64_t *) noexcept;                               \
+  template void between<T>(std::span<const T>, T, T, uint64_t *) noexcept;     \
+  template void in_list<T>(std::span<const T>, std::span<const T>,             \
+                           uint64_t *) noexcept;                               \
+  template size_t select_compare<T>(std::span<const T>, CompareOp, T,          \
+                                    uint32_t *) noexcept;                      \
+  template size_t select_between<T>(std::span<const T>, T, T,                  \
+                                    uint32_t *) noexcept;                      \
+  template size_t select_in<T>(std::span<const T>, std::span<const T>,         \
+                               uint32_t *) noexcept;
+
+VELOX_INSTANTIATE_FILTER_KERNELS(int8_t)
+VELOX_INSTANTIATE_FILTER_KERNELS(int16_t)
+VELOX_INSTANTIATE_FILTER_KERNELS(int32_t)
+VELOX_INSTANTIATE_FILTER_KERNELS(int64_t)
+VELOX_INSTANTIATE_FILTER_KERNELS(float)
+VELOX_INSTANTIATE_FILTER_KERNELS(double)
+
+#undef VELOX_INSTANTIATE_FILTER_KERNELS
+
+} // namespace velox::query::kernels
@@ -0,0 +1,324 @@
+#include <algorithm>
+#include <charconv>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <sched.h>
+#include <string>
+#include <thread>
+#include <velox/query/morsel.hpp>
+#include <velox/query/worker_pool.hpp>
+
+namespace velox::query {
+namespace {
+/// @brief Parse the index of a "node<N>" sysfs entry
+std::optional<size_t> node_index(const std::filesystem::path &path) {
+  const auto name = path.filename().string();
+  if (!name.starts_with("node") || name.size() == 4) {
+    return std::nullopt;
+  }
+
+  size_t index = 0;
+  const auto *end = name.data() + name.size();
+  const auto [parsed, error] = std::from_chars(name.data() + 4, end, index);
+  if (error != std::errc() || parsed != end) {
+    return std::nullopt;
+  }
+  return index;
+}
+} // namespace
+
+size_t numa_node_count() noexcept {
+  static const size_t count = [] {
+    size_t nodes = 0;
+    std::error_code error;
+    for (std::filesystem::directory_iterator it("/sys/devices/system/node",
+                                                error),
+         end;
+         !error && it != end; it.increment(error)) {
+      if (node_index(it->path())) {
+        ++nodes;
+      }
+    }
+    return std::max<size_t>(nodes, 1);
+  }();
+
+  return count;
+}
+
+size_t current_numa_node() noexcept {
+  if (numa_node_count() == 1) {
+    return 0;
+  }
+
+  const int cpu = ::sched_getcpu();
+  if (cpu < 0) {
+    return 0;
+  }
+
+  // Each cpu<N> directory links to its node as node<M>
+  std::error_code error;
+  for (std::filesystem::directory_iterator
+           it("/sys/devices/system/cpu/cpu" + std::to_string(cpu), error),
+       end;
+       !error && it != end; it.increment(error)) {
+    if (auto node = node_index(it->path())) {
+      return *node;
+    }
+  }
+  return 0;
+}
+
+// MorselQueue
+
+MorselQueue::MorselQueue(size_t chunks, size_t morsel_chunks, size_t stripes)
+    : m_stripe_count(std::max<size_t>(stripes, 1)),
+      m_morsel_chunks(morsel_chunks == 0 ? DEFAULT_MORSEL_CHUNKS
+                                         : morsel_chunks) {
+  // Stripe boundaries fall on morsel boundaries
+  const size_t morsels = (chunks + m_morsel_chunks - 1) / m_morsel_chunks;
+  m_stripes = std::make_unique<Stripe[]>(m_stripe_count);
+  for (size_t s = 0; s < m_stripe_count; ++s) {
+    m_stripes[s].next.store(
+        std::min(chunks, s * morsels / m_stripe_count * m_morsel_chunks),
+        std::memory_order_relaxed);
+    m_stripes[s].end = std::min(
+        chunks, (s + 1) * morsels / m_stripe_count * m_morsel_chunks);
+  }
+}
+
+std::optional<Morsel> MorselQueue::next(size_t home) noexcept {
+  for (size_t i = 0; i < m_stripe_count; ++i) {
+    auto &stripe = m_stripes[(home + i) % m_stripe_count];
+    if (stripe.next.load(std::memory_order_relaxed) >= stripe.end) {
+      continue;
+    }
+
+    const size_t first =
+        stripe.next.fetch_add(m_morsel_chunks, std::memory_order_relaxed);
+    if (first < stripe.end) {
+      return Morsel{first, std::min(first + m_morsel_chunks, stripe.end)};
+    }
+  }
+
+  return std::nullopt;
+}
+
+void MorselQueue::close() noexcept {
+  for (size_t s = 0; s < m_stripe_count; ++s) {
+    m_stripes[s].next.store(m_stripes[s].end, std::memory_order_relaxed);
+  }
+}
+
+error::VoidResult run_morsels(std::shared_ptr<const ColumnarTable> table,
+                              std::vector<size_t> projection,
+                              const PipelineFactory &build,
+                              const PipelineSink &sink,
+                              MorselOptions options) {
+  auto &pool = WorkerPool::shared();
+  const size_t threads =
+      options.threads == 0 ? pool.concurrency()
+                           : std::min(options.threads, pool.concurrency());
+  auto morsels = std::make_shared<MorselQueue>(
+      table->chunk_count(), options.morsel_chunks, numa_node_count());
+
+  std::vector<error::VoidResult> results(threads, error::ok());
+  pool.parallel_for(
+      threads,
+      [&](size_t worker) {
+        auto &result = results[worker];
+        auto scan = std::make_unique<TableScan>(table, projection);
+        scan->set_morsels(morsels, current_numa_node());
+        auto pipeline = build(std::move(scan));
+        if (!pipeline) {
+          result = tl::unexpected(pipeline.error());
+          morsels->close();
+          return;
+        }
+
+        DataChunk chunk;
+        while (true) {
+          auto more = (*pipeline)->next(chunk);
+          if (!more) {
+            result = tl::unexpected(more.error());
+          } else if (*more) {
+            result = sink(worker, chunk);
+          }
+          if (!result) {
+            morsels->close();
+          }
+          if (!result || !*more) {
+            return;
+          }
+        }
+      },
+      threads);
+
+  for (const auto &result : results) {
+    if (!result) {
+      return result;
+    }
+  }
+  return error::ok();
+}
+
+// MorselGather
+
+/**
+ * @brief Bounded queue between the run_morsels() workers and next()
+ *
+ * @note The driver thread only waits in run_morsels(); the caller of a
+ *       parallel_for always works on its own loop, so the scan progresses
+ *       even while every pool thread is busy. Once closed, push() fails,
+ *       which makes the workers stop claiming morsels.
+ */
+class MorselGather::Stream {
+public:
+  explicit Stream(size_t capacity)
+      : m_capacity(std::max<size_t>(capacity, 1)) {}
+
+  /// @brief Stop the workers and wait for the driver
+  ~Stream() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_closed = true;
+    }
+    m_not_full.notify_all();
+    if (m_driver.joinable()) {
+      m_driver.join();
+    }
+  }
+
+  VELOX_NON_COPYABLE_NON_MOVABLE(Stream)
+
+  /**
+   * @brief Start the driver thread
+   *
+   * @param run Runs the workers, feeding the given sink
+   */
+  void start(std::function<error::VoidResult(const PipelineSink &)> run) {
+    m_driver = std::thread([this, run = std::move(run)] {
+      auto status = run([this](size_t, DataChunk &chunk) {
+        return push(chunk);
+      });
+
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_status = status;
+      m_finished = true;
+      m_not_empty.notify_all();
+    });
+  }
+
+  /**
+   * @brief Take the next chunk, waiting for the workers if needed
+   *
+   * @return true with a chunk, false once the workers finished, or their
+   *         first error
+   */
+  [[nodiscard]] error::Result<bool> pop(DataChunk &output) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_not_empty.wait(lock, [&] { return m_finished || !m_chunks.empty(); });
+    if (m_finished && !m_status) {
+      return tl::unexpected(m_status.error());
+    }
+    if (m_chunks.empty()) {
+      return false;
+    }
+
+    output = std::move(m_chunks.front());
+    m_chunks.pop_front();
+    lock.unlock();
+    m_not_full.notify_one();
+    return true;
+  }
+
+private:
+  error::VoidResult push(DataChunk &chunk) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_not_full.wait(lock,
+                    [&] { return m_closed || m_chunks.size() < m_capacity; });
+    if (m_closed) {
+      return error::error<void>(error::ErrorCode::QUERY_ERROR);
+    }
+
+    m_chunks.push_back(std::move(chunk));
+    lock.unlock();
+    m_not_empty.notify_one();
+    return error::ok();
+  }
+
+  const size_t m_capacity;
+  std::mutex m_mutex;
+  std::condition_variable m_not_full;
+  std::condition_variable m_not_empty;
+  std::deque<DataChunk> m_chunks;
+  error::VoidResult m_status{error::ok()};
+  bool m_finished{false};
+  bool m_closed{false};
+  std::thread m_driver;
+};
+
+MorselGather::MorselGather(std::shared_ptr<const ColumnarTable> table,
+                           std::vector<size_t> projection,
+                           PipelineFactory build, MorselOptions options)
+    : MorselGather(build(std::make_unique<TableScan>(table, projection)),
+                   table, projection, build, options) {}
+
+MorselGather::MorselGather(error::Result<OperatorPtr> prototype,
+                           std::shared_ptr<const ColumnarTable> table,
+                           std::vector<size_t> projection,
+                           PipelineFactory build, MorselOptions options)
+    : Operator(prototype ? (*prototype)->schema() : Schema{}),
+      m_table(std::move(table)), m_projection(std::move(projection)),
+      m_build(std::move(build)), m_options(options) {
+  if (prototype) {
+    m_prototype = std::move(*prototype);
+  } else {
+    m_error = prototype.error();
+  }
+}
+
+MorselGather::~MorselGather() = default;
+
+error::Result<bool> MorselGather::next(DataChunk &output) {
+  if (m_error) {
+    return error::error<bool>(*m_error);
+  }
+
+  if (!m_stream) {
+    const size_t threads = std::min(
+        m_options.threads == 0 ? WorkerPool::shared().concurrency()
+                               : m_options.threads,
+        WorkerPool::shared().concurrency());
+    m_stream = std::make_unique<Stream>(
+        m_options.queue_chunks == 0
+            ? threads * DEFAULT_GATHER_CHUNKS_PER_THREAD
+            : m_options.queue_chunks);
+    m_stream->start([this](const PipelineSink &sink) {
+      return run_morsels(m_table, m_projection, m_build, sink, m_options);
+    });
+  }
+
+  prepare(output);
+  return m_stream->pop(output);
+}
+
+void MorselGather::reset() { m_stream.reset(); }
+
+std::string MorselGather::name() const {
+  const size_t morsel_chunks = m_options.morsel_chunks == 0
+                                   ? DEFAULT_MORSEL_CHUNKS
+                                   : m_options.morsel_chunks;
+  return fmt::format("MorselGather(morsels of {} rows, {} NUMA nodes)",
+                     morsel_chunks * config::VECTOR_SIZE, numa_node_count());
+}
+
+std::vector<const Operator *> MorselGather::children() const {
+  if (!m_prototype) {
+    return {};
+  }
+  return {m_prototype.get()};
+}
+
+} // namespace velox::query
@@ -0,0 +1,626 @@
+#include <algorithm>
+#include <numeric>
+#include <velox/metrics/metrics.hpp>
+#include <velox/query/kernels.hpp>
+#include <velox/query/morsel.hpp>
+#include <velox/query/operators.hpp>
+
+namespace velox::query {
+namespace detail {
+Schema scan_schema(const Schema &schema, const std::vector<size_t> &columns) {
+  Schema projected;
+  projected.reserve(columns.size());
+  for (auto column : columns) {
+    if (column == ROW_ID_COLUMN) {
+      projected.emplace_back(std::string(ROW_ID_NAME),
+                             dtypes::TypeId::BIGINT);
+    } else if (column < schema.size()) {
+      projected.push_back(schema[column]);
+    } else {
+      projected.emplace_back("?", dtypes::TypeId::NULL_TYPE);
+    }
+  }
+
+  return projected;
+}
+
+std::vector<size_t> all_columns(const Schema &schema) {
+  std::vector<size_t> columns(schema.size());
+  std::iota(columns.begin(), columns.end(), size_t{0});
+
+  return columns;
+}
+
+Schema fetch_schema(const Schema &child, const Schema &stored,
+                    const std::vector<size_t> &columns) {
+  Schema schema = child;
+  for (auto &column : scan_schema(stored, columns)) {
+    schema.push_back(std::move(column));
+  }
+
+  return schema;
+}
+
+bool valid_row_id(const DataChunk &input, size_t row_id) noexcept {
+  return row_id < input.column_count() &&
+         input.column(row_id).physical() == PhysicalType::INT64;
+}
+
+std::string fetch_columns(const Schema &stored,
+                          const std::vector<size_t> &columns) {
+  std::string names;
+  for (auto column : columns) {
+    const auto &name = column < stored.size() ? stored[column].name : "?";
+    names += names.empty() ? name : ", " + name;
+  }
+
+  return names;
+}
+} // namespace detail
+
+namespace {
+Schema expression_schema(const std::vector<ExpressionPtr> &expressions,
+                         const std::vector<std::string> &names) {
+  Schema schema;
+  schema.reserve(expressions.size());
+  for (size_t i = 0; i < expressions.size(); ++i) {
+    schema.emplace_back(i < names.size() && !names[i].empty()
+                            ? names[i]
+                            : expressions[i]->to_string(),
+                        expressions[i]->type());
+  }
+
+  return schema;
+}
+
+/// @brief Collect the AND terms of a predicate
+void split_conjuncts(const Expression &predicate,
+                     std::vector<const Expression *> &terms) {
+  if (predicate.kind() == ExpressionKind::CONJUNCTION) {
+    const auto &conjunction = static_cast<const Conjunction &>(predicate);
+    if (conjunction.op() == ConjunctionOp::AND) {
+      for (const auto &child : conjunction.children()) {
+        split_conjuncts(*child, terms);
+      }
+      return;
+    }
+  }
+
+  terms.push_back(&predicate);
+}
+
+/// @brief Check whether an operand is an input column already in the
+///        type the term compares in, with a filter kernel for it
+bool is_kernel_operand(const Expression &operand,
+                       const dtypes::TypeInfo &operand_type) {
+  return operand.kind() == ExpressionKind::COLUMN_REF &&
+         same_type(operand.type(), operand_type) &&
+         kernels::supports(physical_type(operand_type.type_id));
+}
+
+/// @brief Check whether an operand is an input string column
+bool is_string_operand(const Expression &operand,
+                       const dtypes::TypeInfo &operand_type) {
+  return operand.kind() == ExpressionKind::COLUMN_REF &&
+         same_type(operand.type(), operand_type) &&
+         physical_type(operand_type.type_id) == PhysicalType::VARLEN;
+}
+
+bool is_kernel_term(const Expression &term) {
+  switch (term.kind()) {
+  case ExpressionKind::COMPARISON: {
+    const auto &comparison = static_cast<const Comparison &>(term);
+    if (comparison.scalar() == nullptr) {
+      return false;
+    }
+    if (comparison.op() == CompareOp::EQ || comparison.op() == CompareOp::NE) {
+      return is_string_operand(*comparison.left(),
+                               comparison.operand_type()) ||
+             is_kernel_operand(*comparison.left(), comparison.operand_type());
+    }
+    return is_kernel_operand(*comparison.left(), comparison.operand_type());
+  }
+  case ExpressionKind::BETWEEN: {
+    const auto &between = static_cast<const Between &>(term);
+    return is_kernel_operand(*between.child(), between.operand_type());
+  }
+  case ExpressionKind::IN_LIST: {
+    const auto &in_list = static_cast<const InList &>(term);
+    return !in_list.has_null() &&
+           is_kernel_operand(*in_list.child(), in_list.operand_type());
+  }
+  case ExpressionKind::LIKE: {
+    const auto &like = static_cast<const Like &>(term);
+    return like.shape().has_value() &&
+           is_string_operand(*like.child(), like.child()->type());
+  }
+  default:
+    return false;
+  }
+}
+
+const ColumnVector &operand_column(const DataChunk &input,
+                                   const Expression &operand) {
+  return input.column(static_cast<const ColumnRef &>(operand).index());
+}
+
+/// @brief Run a term accepted by is_kernel_term() into a bitmap
+void run_kernel_term(const Expression &term, const DataChunk &input,
+                     uint64_t *bitmap) {
+  switch (term.kind()) {
+  case ExpressionKind::COMPARISON: {
+    const auto &comparison = static_cast<const Comparison &>(term);
+    kernels::compare(operand_column(input, *comparison.left()),
+                     comparison.op(), *comparison.scalar(), bitmap);
+    break;
+  }
+  case ExpressionKind::BETWEEN: {
+    const auto &between = static_cast<const Between &>(term);
+    kernels::between(operand_column(input, *between.child()), between.low(),
+                     between.high(), bitmap);
+    break;
+  }
+  case ExpressionKind::IN_LIST: {
+    const auto &in_list = static_cast<const InList &>(term);
+    kernels::in_list(operand_column(input, *in_list.child()), in_list.list(),
+                     bitmap);
+    break;
+  }
+  default: {
+    const auto &like = static_cast<const Like &>(term);
+    kernels::match(operand_column(input, *like.child()), *like.shape(),
+                   like.literal(), like.ignore_case(), bitmap);
+    break;
+  }
+  }
+}
+
+bool none_set(const std::vector<uint64_t> &bitmap) noexcept {
+  return std::all_of(bitmap.begin(), bitmap.end(),
+                     [](uint64_t word) { return word == 0; });
+}
+
+void explain_into(const Operator &op, size_t depth, std::string &out) {
+  out.append(depth * 2, ' ');
+  out += op.name();
+  out += '\n';
+  for (const auto *child : op.children()) {
+    explain_into(*child, depth + 1, out);
+  }
+}
+} // namespace
+
+void Operator::prepare(DataChunk &output) const {
+  if (output.matches(m_schema)) {
+    output.clear();
+  } else {
+    output.initialize(m_schema);
+  }
+}
+
+std::string explain(const Operator &root) {
+  std::string out;
+  explain_into(root, 0, out);
+
+  return out;
+}
+
+// TableScan
+
+TableScan::TableScan(std::shared_ptr<const ColumnarTable> table,
+                     std::vector<size_t> projection)
+    : Operator(detail::scan_schema(
+          table->schema(), projection.empty()
+                               ? detail::all_columns(table->schema())
+                               : projection)),
+      m_table(std::move(table)),
+      m_projection(projection.empty()
+                       ? detail::all_columns(m_table->schema())
+                       : std::move(projection)) {}
+
+void TableScan::set_bound(std::shared_ptr<const TopNBound> bound,
+                          size_t column) {
+  m_bound = std::move(bound);
+  m_bound_column = column;
+}
+
+void TableScan::set_morsels(std::shared_ptr<MorselQueue> morsels,
+                            size_t home) {
+  m_morsels = std::move(morsels);
+  m_home = home;
+  m_next_chunk = m_end_chunk = 0;
+}
+
+bool TableScan::advance() {
+  size_t skipped = 0;
+  while (true) {
+    if (m_next_chunk >= m_end_chunk) {
+      if (!m_morsels) {
+        if (m_end_chunk == m_table->chunk_count()) {
+          break;
+        }
+        m_end_chunk = m_table->chunk_count();
+        continue;
+      }
+      auto morsel = m_morsels->next(m_home);
+      if (!morsel) {
+        break;
+      }
+      m_next_chunk = morsel->first;
+      m_end_chunk = morsel->end;
+      continue;
+    }
+
+    if (!m_bound || m_bound_column >= m_table->schema().size() ||
+        !m_bound->excludes(m_table->zone(m_next_chunk, m_bound_column))) {
+      break;
+    }
+    ++m_next_chunk;
+    ++skipped;
+  }
+
+  if (skipped > 0) {
+    static auto &skipped_chunks = metrics::global_registry().get_counter(
+        metrics::names::QUERY_CHUNKS_SKIPPED);
+    skipped_chunks.add(skipped);
+  }
+  return m_next_chunk < m_end_chunk;
+}
+
+error::Result<bool> TableScan::next(DataChunk &output) {
+  prepare(output);
+  if (!advance()) {
+    return false;
+  }
+
+  // Every chunk but the last is full, so row ids follow the chunk index
+  const auto first = static_cast<int64_t>(m_next_chunk * config::VECTOR_SIZE);
+  const auto &chunk = m_table->chunk(m_next_chunk++);
+  for (size_t i = 0; i < m_projection.size(); ++i) {
+    auto &column = output.column(i);
+    if (m_projection[i] == ROW_ID_COLUMN) {
+      for (size_t row = 0; row < chunk.size(); ++row) {
+        column.append<int64_t>(first + static_cast<int64_t>(row));
+      }
+      continue;
+    }
+    column.append_range(chunk.column(m_projection[i]), 0, chunk.size());
+  }
+  output.set_size(chunk.size());
+
+  return true;
+}
+
+std::string TableScan::name() const {
+  std::string columns;
+  for (const auto &column : schema()) {
+    columns += columns.empty() ? column.name : ", " + column.name;
+  }
+
+  if (m_bound) {
+    return fmt::format("TableScan({} rows: {}; TopN bound on {})",
+                       m_table->row_count(), columns,
+                       m_bound_column < m_table->schema().size()
+                           ? m_table->schema()[m_bound_column].name
+                           : "?");
+  }
+  return fmt::format("TableScan({} rows: {})", m_table->row_count(),
+                     columns);
+}
+
+// IndexScan
+
+IndexScan::IndexScan(std::shared_ptr<const ColumnarTable> table,
+                     std::string description, Lookup lookup,
+                     std::vector<size_t> projection)
+    : Operator(detail::scan_schema(
+          table->schema(), projection.empty()
+                               ? detail::all_columns(table->schema())
+                               : projection)),
+      m_table(std::move(table)), m_description(std::move(description)),
+      m_lookup(std::move(lookup)),
+      m_projection(projection.empty()
+                       ? detail::all_columns(m_table->schema())
+                       : std::move(projection)) {}
+
+error::Result<bool> IndexScan::next(DataChunk &output) {
+  prepare(output);
+  if (!m_looked_up) {
+    auto row_ids = m_lookup();
+    if (!row_ids) {
+      return tl::unexpected(row_ids.error());
+    }
+    m_row_ids = std::move(*row_ids);
+    std::sort(m_row_ids.begin(), m_row_ids.end());
+    if (!m_row_ids.empty() && m_row_ids.back() >= m_table->row_count()) {
+      return error::error<bool>(error::ErrorCode::INVALID_ARGUMENT);
+    }
+    for (auto column : m_projection) {
+      if (column >= m_table->schema().size() && column != ROW_ID_COLUMN) {
+        return error::error<bool>(error::ErrorCode::INVALID_ARGUMENT);
+      }
+    }
+    m_position = 0;
+    m_looked_up = true;
+  }
+
+  const size_t end =
+      std::min(m_row_ids.size(), m_position + config::VECTOR_SIZE);
+  if (m_position == end) {
+    return false;
+  }
+
+  for (size_t i = 0; i < m_projection.size(); ++i) {
+    auto &column = output.column(i);
+    if (m_projection[i] == ROW_ID_COLUMN) {
+      for (size_t row = m_position; row < end; ++row) {
+        column.append<int64_t>(static_cast<int64_t>(m_row_ids[row]));
+      }
+      continue;
+    }
+
+    size_t row = m_position;
+    while (row < end) {
+      const size_t id = m_row_ids[row];
+      const size_t offset = id % config::VECTOR_SIZE;
+      size_t count = 1;
+      while (row + count < end && offset + count < config::VECTOR_SIZE &&
+             m_row_ids[row + count] == id + count) {
+        ++count;
+      }
+      column.append_range(
+          m_table->chunk(id / config::VECTOR_SIZE).column(m_projection[i]),
+          offset, count);
+      row += count;
+    }
+  }
+  output.set_size(end - m_position);
+  m_position = end;
+
+  return true;
+}
+
+void IndexScan::reset() {
+  m_row_ids.clear();
+  m_position = 0;
+  m_looked_up = false;
+}
+
+std::string IndexScan::name() const {
+  std::string columns;
+  for (const auto &column : schema()) {
+    columns += columns.empty() ? column.name : ", " + column.name;
+  }
+
+  return fmt::format("IndexScan({} rows: {}; {})", m_table->row_count(),
+                     columns, m_description);
+}
+
+// Materialize
+
+Materialize::Materialize(OperatorPtr child, size_t row_id,
+                         std::shared_ptr<const ColumnarTable> table,
+                         std::vector<size_t> columns)
+    : Operator(
+          detail::fetch_schema(child->schema(), table->schema(), columns)),
+      m_child(std::move(child)), m_row_id(row_id), m_table(std::move(table)),
+      m_columns(std::move(columns)) {}
+
+error::Result<bool> Materialize::next(DataChunk &output) {
+  prepare(output);
+  auto more = m_child->next(m_input);
+  if (!more || !*more) {
+    return more;
+  }
+
+  const size_t rows = m_input.size();
+  if (!detail::valid_row_id(m_input, m_row_id)) {
+    return error::error<bool>(error::ErrorCode::INVALID_ARGUMENT);
+  }
+  const auto &ids = m_input.column(m_row_id);
+  for (size_t row = 0; row < rows; ++row) {
+    if (ids.is_valid(row) &&
+        static_cast<uint64_t>(ids.data<int64_t>()[row]) >=
+            m_table->row_count()) {
+      return error::error<bool>(error::ErrorCode::INVALID_ARGUMENT);
+    }
+  }
+  for (auto column : m_columns) {
+    if (column >= m_table->schema().size()) {
+      return error::error<bool>(error::ErrorCode::INVALID_ARGUMENT);
+    }
+  }
+
+  const size_t width = m_input.column_count();
+  for (size_t c = 0; c < width; ++c) {
+    output.column(c).append_range(m_input.column(c), 0, rows);
+  }
+
+  // Copy runs of consecutive row ids within one table chunk as ranges
+  for (size_t i = 0; i < m_columns.size(); ++i) {
+    auto &target = output.column(width + i);
+    size_t row = 0;
+    while (row < rows) {
+      if (!ids.is_valid(row)) {
+        target.append_null();
+        ++row;
+        continue;
+      }
+
+      const auto id = static_cast<size_t>(ids.data<int64_t>()[row]);
+      const size_t chunk = id / config::VECTOR_SIZE;
+      const size_t offset = id % config::VECTOR_SIZE;
+      size_t count = 1;
+      while (row + count < rows && offset + count < config::VECTOR_SIZE &&
+             ids.is_valid(row + count) &&
+             static_cast<size_t>(ids.data<int64_t>()[row + count]) ==
+                 id + count) {
+        ++count;
+      }
+      target.append_range(m_table->chunk(chunk).column(m_columns[i]), offset,
+                          count);
+      row += count;
+    }
+  }
+  output.set_size(rows);
+
+  return true;
+}
+
+std::string Materialize::name() const {
+  return fmt::format("Materialize({} by {})",
+                     detail::fetch_columns(m_table->schema(), m_columns),
+                     m_child->schema().size() > m_row_id
+                         ? m_child->schema()[m_row_id].name
+                         : "?");
+}
+
+// Filter
+
+Filter::Filter(OperatorPtr child, ExpressionPtr predicate)
+    : Operator(child->schema()), m_child(std::move(child)),
+      m_predicate(std::move(predicate)),
+      m_mask(dtypes::TypeInfo(dtypes::TypeId::BOOLEAN)) {
+  std::vector<const Expression *> terms;
+  split_conjuncts(*m_predicate, terms);
+  for (const auto *term : terms) {
+    (is_kernel_term(*term) ? m_kernel_terms : m_residual_terms)
+        .push_back(term);
+  }
+}
+
+error::Result<bool> Filter::next(DataChunk &output) {
+  if (m_predicate->type().type_id != dtypes::TypeId::BOOLEAN) {
+    return error::error<bool>(error::ErrorCode::TYPE_MISMATCH);
+  }
+
+  prepare(output);
+  while (true) {
+    auto more = m_child->next(m_input);
+    if (!more || !*more) {
+      return more;
+    }
+
+    const size_t n = m_input.size();
+    const size_t words = kernels::bitmap_words(n);
+    m_bitmap.assign(words, ~uint64_t{0});
+    m_term_bitmap.resize(words);
+
+    // Kernel terms first: they are cheap and may empty the chunk early
+    for (const auto *term : m_kernel_terms) {
+      run_kernel_term(*term, m_input, m_term_bitmap.data());
+      kernels::bitmap_and(m_bitmap.data(), m_term_bitmap.data(), words);
+    }
+    for (const auto *term : m_residual_terms) {
+      if (none_set(m_bitmap)) {
+        break;
+      }
+      if (auto evaluated = term->evaluate(m_input, m_mask); !evaluated) {
+        return tl::unexpected(evaluated.error());
+      }
+      kernels::mask_to_bitmap(m_mask, m_term_bitmap.data());
+      kernels::bitmap_and(m_bitmap.data(), m_term_bitmap.data(), words);
+    }
+
+    m_selection.resize(n);
+    const size_t selected =
+        kernels::to_selection(m_bitmap.data(), n, m_selection.data());
+    if (selected == n) {
+      std::swap(output, m_input);
+      return true;
+    }
+    if (selected > 0) {
+      output.append_selected(m_input, {m_selection.data(), selected});
+      return true;
+    }
+  }
+}
+
+std::string Filter::name() const {
+  return fmt::format("Filter({})", m_predicate->to_string());
+}
+
+// Projection
+
+Projection::Projection(OperatorPtr child,
+                       std::vector<ExpressionPtr> expressions,
+                       std::vector<std::string> names)
+    : Operator(expression_schema(expressions, names)),
+      m_child(std::move(child)), m_expressions(std::move(expressions)) {}
+
+error::Result<bool> Projection::next(DataChunk &output) {
+  prepare(output);
+
+  auto more = m_child->next(m_input);
+  if (!more || !*more) {
+    return more;
+  }
+
+  for (size_t i = 0; i < m_expressions.size(); ++i) {
+    auto evaluated = m_expressions[i]->evaluate(m_input, output.column(i));
+    if (!evaluated) {
+      return tl::unexpected(evaluated.error());
+    }
+  }
+  output.set_size(m_input.size());
+
+  return true;
+}
+
+std::string Projection::name() const {
+  std::string columns;
+  for (size_t i = 0; i < m_expressions.size(); ++i) {
+    const auto text = m_expressions[i]->to_string();
+    const auto &name = schema()[i].name;
+    columns += fmt::format("{}{}{}", i == 0 ? "" : ", ", text,
+                           name == text ? "" : " AS " + name);
+  }
+
+  return fmt::format("Projection({})", columns);
+}
+
+// Limit
+
+Limit::Limit(OperatorPtr child, size_t limit, size_t offset)
+    : Operator(child->schema()), m_child(std::move(child)), m_limit(limit),
+      m_offset(offset) {}
+
+error::Result<bool> Limit::next(DataChunk &output) {
+  prepare(output);
+
+  while (m_produced < m_limit) {
+    auto more = m_child->next(m_input);
+    if (!more || !*more) {
+      return more;
+    }
+
+    size_t start = 0;
+    if (m_skipped < m_offset) {
+      start = std::min(m_input.size(), m_offset - m_skipped);
+      m_skipped += start;
+      if (start == m_input.size()) {
+        continue;
+      }
+    }
+
+    const auto count = std::min(m_input.size() - start, m_limit - m_produced);
+    output.append_range(m_input, start, count);
+    m_produced += count;
+    return true;
+  }
+
+  return false;
+}
+
+void Limit::reset() {
+  m_child->reset();
+  m_skipped = 0;
+  m_produced = 0;
+}
+
+std::string Limit::name() const {
+  return m_offset == 0 ? fmt::format("Limit({})", m_limit)
+                       : fmt::format("Limit({} OFFSET {})", m_limit, m_offset);
+}
+
+} // namespace velox::query
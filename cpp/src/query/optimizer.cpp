@@ -0,0 +1,854 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <unordered_map>
+#include <velox/query/optimizer.hpp>
+
+namespace velox::query {
+namespace {
+/// @brief Selectivity of = without a distinct count
+constexpr double DEFAULT_EQUALITY = 0.1;
+
+/// @brief Selectivity of a range without min and max
+constexpr double DEFAULT_RANGE = 1.0 / 3.0;
+
+/// @brief Relations a bitset join enumeration can hold
+constexpr size_t MAX_RELATIONS = 64;
+
+using RelationSet = uint64_t;
+
+bool is_range(CompareOp op) noexcept {
+  return op == CompareOp::LT || op == CompareOp::LE || op == CompareOp::GT ||
+         op == CompareOp::GE;
+}
+
+/// @brief Check value op constant for a range operator
+bool satisfies(double value, CompareOp op, double constant) noexcept {
+  switch (op) {
+  case CompareOp::LT:
+    return value < constant;
+  case CompareOp::LE:
+    return value <= constant;
+  case CompareOp::GT:
+    return value > constant;
+  case CompareOp::GE:
+    return value >= constant;
+  default:
+    return false;
+  }
+}
+
+/// @brief Fraction of an equi-depth histogram's values below a constant
+double histogram_below(const std::vector<double> &bounds, double constant) {
+  if (constant <= bounds.front()) {
+    return 0;
+  }
+  if (constant >= bounds.back()) {
+    return 1;
+  }
+
+  const auto upper = std::upper_bound(bounds.begin(), bounds.end(), constant);
+  const auto bucket = static_cast<size_t>(upper - bounds.begin()) - 1;
+  const double low = bounds[bucket];
+  const double high = bounds[bucket + 1];
+  const double within = high > low ? (constant - low) / (high - low) : 1;
+
+  return (static_cast<double>(bucket) + within) /
+         static_cast<double>(bounds.size() - 1);
+}
+
+/// @brief Per-relation inputs of the cost model
+struct Relation {
+  const RelationSpec *spec{nullptr};
+  TableStatistics statistics;
+  double rows{0};            ///< After the local predicates
+  double access_cost{0};     ///< Of the cheapest access path
+  std::optional<size_t> index; ///< Index of that path; nullopt = scan
+  size_t index_predicate{0};   ///< Predicate the index answers
+  std::vector<size_t> columns; ///< Table columns the plan reads
+};
+
+/// @brief Best plan found for a set of relations
+struct Node {
+  double rows{0};
+  double cost{0};
+  RelationSet left{0}; ///< 0 for a single relation
+  RelationSet right{0};
+};
+
+/// @brief Operator with the (relation, column) of each output column
+struct Built {
+  OperatorPtr root;
+  std::vector<OutputColumn> layout;
+};
+
+class Planner {
+public:
+  Planner(const JoinQuery &query, const OptimizerOptions &options)
+      : m_query(query), m_options(options) {}
+
+  /// @brief Enumerate join orders and build the cheapest plan
+  error::Result<QueryPlan> plan();
+
+  /// @brief Build the plan of a given join order
+  error::Result<QueryPlan> plan(const JoinOrder &order);
+
+  /// @brief Enumerate join orders and return the cheapest
+  error::Result<JoinOrder> order();
+
+private:
+  error::VoidResult validate() const;
+  error::VoidResult prepare();
+  void enumerate();
+  error::VoidResult adopt(const JoinOrder &order);
+  void extract(RelationSet set, JoinOrder &order) const;
+  RelationSet all() const noexcept;
+  error::Result<QueryPlan> finish();
+  void cost_relation(size_t r);
+  double distinct(const JoinEdge &edge, bool left) const;
+  double cardinality(RelationSet set);
+  void consider(RelationSet left, RelationSet right);
+  RelationSet neighbors(RelationSet set, RelationSet excluded) const;
+  void enumerate_dpccp();
+  void enumerate_csg(RelationSet set, RelationSet excluded);
+  void emit_csg(RelationSet set);
+  void enumerate_cmp(RelationSet left, RelationSet right,
+                     RelationSet excluded);
+  void enumerate_greedy();
+  error::Result<Built> build_relation(size_t r) const;
+  error::Result<Built> build(RelationSet set) const;
+
+  const JoinQuery &m_query;
+  const OptimizerOptions &m_options;
+  std::vector<Relation> m_relations;
+  std::vector<RelationSet> m_adjacent; ///< Join graph
+  std::vector<size_t> m_order;  ///< Enumeration position -> relation
+  std::vector<size_t> m_rank;   ///< Relation -> enumeration position
+  std::unordered_map<RelationSet, Node> m_best;
+  std::unordered_map<RelationSet, double> m_cardinality;
+};
+
+error::VoidResult Planner::validate() const {
+  const auto &relations = m_query.relations;
+  if (relations.empty() || relations.size() > MAX_RELATIONS) {
+    return error::error<void>(error::ErrorCode::INVALID_ARGUMENT);
+  }
+
+  for (const auto &relation : relations) {
+    if (!relation.table) {
+      return error::error<void>(error::ErrorCode::INVALID_ARGUMENT);
+    }
+    const size_t width = relation.table->schema().size();
+    for (const auto &predicate : relation.predicates) {
+      if (predicate.column >= width) {
+        return error::error<void>(error::ErrorCode::INVALID_ARGUMENT);
+      }
+    }
+    for (const auto &index : relation.indexes) {
+      if (index.column >= width || !index.lookup) {
+        return error::error<void>(error::ErrorCode::INVALID_ARGUMENT);
+      }
+    }
+  }
+
+  for (const auto &edge : m_query.joins) {
+    if (edge.left >= relations.size() || edge.right >= relations.size() ||
+        edge.left == edge.right ||
+        edge.left_column >= relations[edge.left].table->schema().size() ||
+        edge.right_column >= relations[edge.right].table->schema().size()) {
+      return error::error<void>(error::ErrorCode::INVALID_ARGUMENT);
+    }
+  }
+
+  for (const auto &output : m_query.output) {
+    if (output.relation >= relations.size() ||
+        output.column >= relations[output.relation].table->schema().size()) {
+      return error::error<void>(error::ErrorCode::INVALID_ARGUMENT);
+    }
+  }
+
+  return error::ok();
+}
+
+void Planner::cost_relation(size_t r) {
+  auto &relation = m_relations[r];
+  const auto &spec = *relation.spec;
+  const auto &statistics = relation.statistics;
+
+  double rows = statistics.rows;
+  for (const auto &predicate : spec.predicates) {
+    rows *= QueryOptimizer::selectivity(statistics, predicate);
+  }
+  relation.rows = rows;
+  relation.access_cost = statistics.rows;
+
+  // An index beats the scan when few enough rows match its predicate
+  const double probe = std::log2(statistics.rows + 2);
+  for (size_t i = 0; i < spec.indexes.size(); ++i) {
+    const auto &index = spec.indexes[i];
+    for (size_t p = 0; p < spec.predicates.size(); ++p) {
+      const auto &predicate = spec.predicates[p];
+      if (predicate.column != index.column ||
+          std::holds_alternative<std::nullptr_t>(predicate.constant) ||
+          !(predicate.op == CompareOp::EQ ||
+            (index.ordered && is_range(predicate.op)))) {
+        continue;
+      }
+
+      double matches =
+          statistics.rows * QueryOptimizer::selectivity(statistics, predicate);
+      if (index.unique && predicate.op == CompareOp::EQ) {
+        matches = std::min(matches, 1.0);
+      }
+      const double cost = probe + matches * m_options.random_access_cost;
+      if (cost < relation.access_cost) {
+        relation.access_cost = cost;
+        relation.index = i;
+        relation.index_predicate = p;
+      }
+    }
+  }
+
+  // Read only the columns predicates, joins and the output refer to
+  std::vector<bool> used(spec.table->schema().size(), false);
+  for (const auto &predicate : spec.predicates) {
+    used[predicate.column] = true;
+  }
+  for (const auto &edge : m_query.joins) {
+    if (edge.left == r) {
+      used[edge.left_column] = true;
+    }
+    if (edge.right == r) {
+      used[edge.right_column] = true;
+    }
+  }
+  for (const auto &output : m_query.output) {
+    if (output.relation == r) {
+      used[output.column] = true;
+    }
+  }
+  for (size_t c = 0; c < used.size(); ++c) {
+    if (used[c] || m_query.output.empty()) {
+      relation.columns.push_back(c);
+    }
+  }
+}
+
+double Planner::distinct(const JoinEdge &edge, bool left) const {
+  const auto &relation = m_relations[left ? edge.left : edge.right];
+  const auto &columns = relation.statistics.columns;
+  const size_t column = left ? edge.left_column : edge.right_column;
+
+  // Filtering cannot leave more distinct values than rows
+  double values = relation.rows;
+  if (column < columns.size() && columns[column].distinct > 0) {
+    values = std::min(values, columns[column].distinct);
+  }
+  return std::max(values, 1.0);
+}
+
+double Planner::cardinality(RelationSet set) {
+  if (auto it = m_cardinality.find(set); it != m_cardinality.end()) {
+    return it->second;
+  }
+
+  double rows = 1;
+  for (auto rest = set; rest != 0; rest &= rest - 1) {
+    rows *= m_relations[m_order[std::countr_zero(rest)]].rows;
+  }
+  for (const auto &edge : m_query.joins) {
+    const RelationSet ends = (RelationSet{1} << m_rank[edge.left]) |
+                             (RelationSet{1} << m_rank[edge.right]);
+    if ((set & ends) != ends) {
+      continue;
+    }
+
+    const auto &left = m_relations[edge.left].statistics.columns;
+    const auto &right = m_relations[edge.right].statistics.columns;
+    const double non_null =
+        (edge.left_column < left.size()
+             ? 1 - left[edge.left_column].null_fraction
+             : 1) *
+        (edge.right_column < right.size()
+             ? 1 - right[edge.right_column].null_fraction
+             : 1);
+    rows *= non_null / std::max(distinct(edge, true), distinct(edge, false));
+  }
+
+  m_cardinality.emplace(set, rows);
+  return rows;
+}
+
+void Planner::consider(RelationSet left, RelationSet right) {
+  const auto l = m_best.find(left);
+  const auto r = m_best.find(right);
+  if (l == m_best.end() || r == m_best.end()) {
+    return;
+  }
+
+  const double small = std::min(l->second.rows, r->second.rows);
+  const double large = std::max(l->second.rows, r->second.rows);
+  const double rows = cardinality(left | right);
+  const double cost = l->second.cost + r->second.cost +
+                      small * m_options.hash_build_cost + large + rows;
+
+  auto [it, inserted] = m_best.try_emplace(left | right);
+  if (inserted || cost < it->second.cost) {
+    it->second = Node{rows, cost, left, right};
+  }
+}
+
+RelationSet Planner::neighbors(RelationSet set,
+                               RelationSet excluded) const {
+  RelationSet adjacent = 0;
+  for (auto rest = set; rest != 0; rest &= rest - 1) {
+    adjacent |= m_adjacent[std::countr_zero(rest)];
+  }
+
+  return adjacent & ~set & ~excluded;
+}
+
+/// @note Moerkotte & Neumann's DPccp: every connected subgraph is paired
+///       with every connected complement adjacent to it exactly once, in
+///       an order that completes both sides before their union. That
+///       order relies on subsets of a neighborhood being visited in
+///       increasing order.
+void Planner::enumerate_dpccp() {
+  const size_t n = m_order.size();
+  for (size_t i = n; i-- > 0;) {
+    const RelationSet start = RelationSet{1} << i;
+    const RelationSet lower = (start << 1) - 1;
+    emit_csg(start);
+    enumerate_csg(start, lower);
+  }
+}
+
+void Planner::enumerate_csg(RelationSet set, RelationSet excluded) {
+  const RelationSet adjacent = neighbors(set, excluded);
+  if (adjacent == 0) {
+    return;
+  }
+
+  for (RelationSet subset = adjacent & (~adjacent + 1); subset != 0;
+       subset = (subset - adjacent) & adjacent) {
+    emit_csg(set | subset);
+  }
+  for (RelationSet subset = adjacent & (~adjacent + 1); subset != 0;
+       subset = (subset - adjacent) & adjacent) {
+    enumerate_csg(set | subset, excluded | adjacent);
+  }
+}
+
+void Planner::emit_csg(RelationSet set) {
+  const RelationSet lowest = set & (~set + 1);
+  const RelationSet excluded = set | (lowest - 1) | lowest;
+  const RelationSet adjacent = neighbors(set, excluded);
+
+  // Complements start at each neighbor, highest first
+  for (size_t i = m_order.size(); i-- > 0;) {
+    const RelationSet start = RelationSet{1} << i;
+    if ((adjacent & start) == 0) {
+      continue;
+    }
+    consider(set, start);
+    enumerate_cmp(set, start, excluded | (adjacent & ((start << 1) - 1)));
+  }
+}
+
+void Planner::enumerate_cmp(RelationSet left, RelationSet right,
+                            RelationSet excluded) {
+  const RelationSet adjacent = neighbors(right, excluded);
+  if (adjacent == 0) {
+    return;
+  }
+
+  for (RelationSet subset = adjacent & (~adjacent + 1); subset != 0;
+       subset = (subset - adjacent) & adjacent) {
+    consider(left, right | subset);
+  }
+  for (RelationSet subset = adjacent & (~adjacent + 1); subset != 0;
+       subset = (subset - adjacent) & adjacent) {
+    enumerate_cmp(left, right | subset, excluded | adjacent);
+  }
+}
+
+/// @note Greedy operator ordering: repeatedly join the two connected
+///       plans with the smallest result.
+void Planner::enumerate_greedy() {
+  std::vector<RelationSet> plans;
+  for (size_t i = 0; i < m_order.size(); ++i) {
+    plans.push_back(RelationSet{1} << i);
+  }
+
+  while (plans.size() > 1) {
+    size_t best_left = 0;
+    size_t best_right = 0;
+    double best_rows = 0;
+    bool found = false;
+    for (size_t i = 0; i < plans.size(); ++i) {
+      for (size_t j = i + 1; j < plans.size(); ++j) {
+        if (neighbors(plans[i], 0) & plans[j]) {
+          const double rows = cardinality(plans[i] | plans[j]);
+          if (!found || rows < best_rows) {
+            best_left = i;
+            best_right = j;
+            best_rows = rows;
+            found = true;
+          }
+        }
+      }
+    }
+    if (!found) {
+      return;
+    }
+
+    consider(plans[best_left], plans[best_right]);
+    plans[best_left] |= plans[best_right];
+    plans.erase(plans.begin() + static_cast<ptrdiff_t>(best_right));
+  }
+}
+
+error::Result<Built> Planner::build_relation(size_t r) const {
+  const auto &relation = m_relations[r];
+  const auto &spec = *relation.spec;
+  const auto &schema = spec.table->schema();
+
+  Built built;
+  for (auto column : relation.columns) {
+    built.layout.push_back({r, column});
+  }
+
+  if (relation.index) {
+    const auto &index = spec.indexes[*relation.index];
+    const auto &predicate = spec.predicates[relation.index_predicate];
+    built.root = std::make_unique<IndexScan>(
+        spec.table,
+        fmt::format("{} {} {}", index.name, to_string(predicate.op),
+                    format_literal(predicate.constant)),
+        [lookup = index.lookup, predicate] {
+          return lookup(predicate.op, predicate.constant);
+        },
+        relation.columns);
+  } else {
+    built.root = std::make_unique<TableScan>(spec.table, relation.columns);
+  }
+
+  std::vector<ExpressionPtr> terms;
+  for (size_t p = 0; p < spec.predicates.size(); ++p) {
+    if (relation.index && p == relation.index_predicate) {
+      continue;
+    }
+
+    const auto &predicate = spec.predicates[p];
+    const auto position = static_cast<size_t>(
+        std::find(relation.columns.begin(), relation.columns.end(),
+                  predicate.column) -
+        relation.columns.begin());
+    auto column = expr::column(built.root->schema(), position);
+    if (!column) {
+      return tl::unexpected(column.error());
+    }
+    auto constant =
+        expr::literal(predicate.constant, schema[predicate.column].type);
+    if (!constant) {
+      return tl::unexpected(constant.error());
+    }
+    auto term =
+        expr::compare(predicate.op, std::move(*column), std::move(*constant));
+    if (!term) {
+      return tl::unexpected(term.error());
+    }
+    terms.push_back(std::move(*term));
+  }
+
+  if (terms.size() == 1) {
+    built.root = std::make_unique<Filter>(std::move(built.root),
+                                          std::move(terms.front()));
+  } else if (terms.size() > 1) {
+    auto predicate = expr::conjunction(ConjunctionOp::AND, std::move(terms));
+    if (!predicate) {
+      return tl::unexpected(predicate.error());
+    }
+    built.root = std::make_unique<Filter>(std::move(built.root),
+                                          std::move(*predicate));
+  }
+
+  return built;
+}
+
+error::Result<Built> Planner::build(RelationSet set) const {
+  const auto &node = m_best.at(set);
+  if (node.left == 0) {
+    return build_relation(m_order[std::countr_zero(set)]);
+  }
+
+  auto left = build(node.left);
+  if (!left) {
+    return left;
+  }
+  auto right = build(node.right);
+  if (!right) {
+    return right;
+  }
+
+  // Build the hash table on the smaller side
+  const bool left_builds = m_best.at(node.left).rows <
+                           m_best.at(node.right).rows;
+  auto &probe = left_builds ? *right : *left;
+  auto &build_side = left_builds ? *left : *right;
+  const RelationSet probe_set = left_builds ? node.right : node.left;
+
+  auto position = [](const std::vector<OutputColumn> &layout, size_t relation,
+                     size_t column) {
+    return static_cast<size_t>(
+        std::find_if(layout.begin(), layout.end(),
+                     [&](const OutputColumn &output) {
+                       return output.relation == relation &&
+                              output.column == column;
+                     }) -
+        layout.begin());
+  };
+
+  std::vector<size_t> probe_keys;
+  std::vector<size_t> build_keys;
+  for (const auto &edge : m_query.joins) {
+    const RelationSet left_bit = RelationSet{1} << m_rank[edge.left];
+    const RelationSet right_bit = RelationSet{1} << m_rank[edge.right];
+    if ((set & left_bit) == 0 || (set & right_bit) == 0 ||
+        ((probe_set & left_bit) != 0) == ((probe_set & right_bit) != 0)) {
+      continue;
+    }
+
+    const bool left_probes = (probe_set & left_bit) != 0;
+    const OutputColumn probe_key{left_probes ? edge.left : edge.right,
+                                 left_probes ? edge.left_column
+                                             : edge.right_column};
+    const OutputColumn build_key{left_probes ? edge.right : edge.left,
+                                 left_probes ? edge.right_column
+                                             : edge.left_column};
+    probe_keys.push_back(
+        position(probe.layout, probe_key.relation, probe_key.column));
+    build_keys.push_back(
+        position(build_side.layout, build_key.relation, build_key.column));
+  }
+
+  Built joined;
+  joined.layout = probe.layout;
+  joined.layout.insert(joined.layout.end(), build_side.layout.begin(),
+                       build_side.layout.end());
+  joined.root = std::make_unique<HashJoin>(
+      std::move(probe.root), std::move(build_side.root),
+      std::move(probe_keys), std::move(build_keys));
+
+  return joined;
+}
+
+error::VoidResult Planner::prepare() {
+  if (auto valid = validate(); !valid) {
+    return valid;
+  }
+
+  const size_t n = m_query.relations.size();
+  m_adjacent.assign(n, 0);
+  std::vector<std::vector<size_t>> graph(n);
+  for (const auto &edge : m_query.joins) {
+    graph[edge.left].push_back(edge.right);
+    graph[edge.right].push_back(edge.left);
+  }
+
+  // DPccp expects relations numbered in breadth-first order
+  m_rank.assign(n, SIZE_MAX);
+  m_rank[0] = 0;
+  m_order.push_back(0);
+  for (size_t head = 0; head < m_order.size(); ++head) {
+    for (auto next : graph[m_order[head]]) {
+      if (m_rank[next] == SIZE_MAX) {
+        m_rank[next] = m_order.size();
+        m_order.push_back(next);
+      }
+    }
+  }
+  if (m_order.size() != n) {
+    return error::error<void>(error::ErrorCode::NOT_IMPLEMENTED);
+  }
+  for (const auto &edge : m_query.joins) {
+    m_adjacent[m_rank[edge.left]] |= RelationSet{1} << m_rank[edge.right];
+    m_adjacent[m_rank[edge.right]] |= RelationSet{1} << m_rank[edge.left];
+  }
+
+  m_relations.resize(n);
+  for (size_t r = 0; r < n; ++r) {
+    auto &relation = m_relations[r];
+    relation.spec = &m_query.relations[r];
+    relation.statistics = relation.spec->statistics
+                              ? *relation.spec->statistics
+                              : zone_statistics(*relation.spec->table);
+    cost_relation(r);
+    m_best[RelationSet{1} << m_rank[r]] =
+        Node{relation.rows, relation.access_cost, 0, 0};
+  }
+
+  return error::ok();
+}
+
+void Planner::enumerate() {
+  if (m_query.relations.size() <= m_options.dp_limit) {
+    enumerate_dpccp();
+  } else {
+    enumerate_greedy();
+  }
+}
+
+/// @note Costs the given tree as enumeration would have, so estimates and
+///       build sides follow the current statistics and literals.
+error::VoidResult Planner::adopt(const JoinOrder &order) {
+  const size_t n = m_query.relations.size();
+  if (order.nodes.size() != 2 * n - 1) {
+    return error::error<void>(error::ErrorCode::INVALID_ARGUMENT);
+  }
+
+  std::vector<RelationSet> sets(order.nodes.size(), 0);
+  RelationSet leaves = 0;
+  for (size_t i = 0; i < order.nodes.size(); ++i) {
+    const auto &node = order.nodes[i];
+    if (node.left == JoinOrder::LEAF || node.right == JoinOrder::LEAF) {
+      if (node.left != node.right || node.relation >= n) {
+        return error::error<void>(error::ErrorCode::INVALID_ARGUMENT);
+      }
+      sets[i] = RelationSet{1} << m_rank[node.relation];
+      if ((leaves & sets[i]) != 0) {
+        return error::error<void>(error::ErrorCode::INVALID_ARGUMENT);
+      }
+      leaves |= sets[i];
+      continue;
+    }
+
+    // Children come first, are disjoint and share a join edge
+    if (node.left >= i || node.right >= i) {
+      return error::error<void>(error::ErrorCode::INVALID_ARGUMENT);
+    }
+    const RelationSet left = sets[node.left];
+    const RelationSet right = sets[node.right];
+    if ((left & right) != 0 || (neighbors(left, 0) & right) == 0 ||
+        m_best.contains(left | right)) {
+      return error::error<void>(error::ErrorCode::INVALID_ARGUMENT);
+    }
+    consider(left, right);
+    sets[i] = left | right;
+  }
+
+  if (sets.back() != all()) {
+    return error::error<void>(error::ErrorCode::INVALID_ARGUMENT);
+  }
+  return error::ok();
+}
+
+void Planner::extract(RelationSet set, JoinOrder &order) const {
+  const auto &node = m_best.at(set);
+  if (node.left == 0) {
+    order.nodes.push_back({m_order[std::countr_zero(set)], JoinOrder::LEAF,
+                           JoinOrder::LEAF});
+    return;
+  }
+
+  extract(node.left, order);
+  const size_t left = order.nodes.size() - 1;
+  extract(node.right, order);
+  const size_t right = order.nodes.size() - 1;
+  order.nodes.push_back({0, left, right});
+}
+
+RelationSet Planner::all() const noexcept {
+  const size_t n = m_query.relations.size();
+  return n == MAX_RELATIONS ? ~RelationSet{0} : (RelationSet{1} << n) - 1;
+}
+
+error::Result<QueryPlan> Planner::plan() {
+  if (auto prepared = prepare(); !prepared) {
+    return tl::unexpected(prepared.error());
+  }
+  enumerate();
+
+  return finish();
+}
+
+error::Result<QueryPlan> Planner::plan(const JoinOrder &order) {
+  if (auto prepared = prepare(); !prepared) {
+    return tl::unexpected(prepared.error());
+  }
+  if (auto adopted = adopt(order); !adopted) {
+    return tl::unexpected(adopted.error());
+  }
+
+  return finish();
+}
+
+error::Result<JoinOrder> Planner::order() {
+  if (auto prepared = prepare(); !prepared) {
+    return tl::unexpected(prepared.error());
+  }
+  enumerate();
+  if (!m_best.contains(all())) {
+    return error::error<JoinOrder>(error::ErrorCode::INTERNAL_ERROR);
+  }
+
+  JoinOrder order;
+  order.nodes.reserve(2 * m_query.relations.size() - 1);
+  extract(all(), order);
+  return order;
+}
+
+error::Result<QueryPlan> Planner::finish() {
+  const size_t n = m_query.relations.size();
+  if (!m_best.contains(all())) {
+    return error::error<QueryPlan>(error::ErrorCode::INTERNAL_ERROR);
+  }
+  auto built = build(all());
+  if (!built) {
+    return tl::unexpected(built.error());
+  }
+
+  // Restore the requested column order
+  auto output = m_query.output;
+  if (output.empty()) {
+    for (size_t r = 0; r < n; ++r) {
+      for (size_t c = 0; c < m_query.relations[r].table->schema().size();
+           ++c) {
+        output.push_back({r, c});
+      }
+    }
+  }
+
+  std::vector<ExpressionPtr> expressions;
+  std::vector<std::string> names;
+  for (const auto &column : output) {
+    const auto position = static_cast<size_t>(
+        std::find_if(built->layout.begin(), built->layout.end(),
+                     [&](const OutputColumn &candidate) {
+                       return candidate.relation == column.relation &&
+                              candidate.column == column.column;
+                     }) -
+        built->layout.begin());
+    auto reference = expr::column(built->root->schema(), position);
+    if (!reference) {
+      return tl::unexpected(reference.error());
+    }
+    expressions.push_back(std::move(*reference));
+
+    const auto &relation = m_query.relations[column.relation];
+    const auto &name = relation.table->schema()[column.column].name;
+    names.push_back(relation.name.empty() ? name
+                                          : relation.name + "." + name);
+  }
+
+  const auto &best = m_best.at(all());
+  QueryPlan plan(std::make_unique<Projection>(
+      std::move(built->root), std::move(expressions), std::move(names)));
+  plan.estimated_rows = best.rows;
+  plan.estimated_cost = best.cost;
+
+  return plan;
+}
+} // namespace
+
+double QueryOptimizer::selectivity(const TableStatistics &statistics,
+                                   const ScanPredicate &predicate) {
+  if (std::holds_alternative<std::nullptr_t>(predicate.constant)) {
+    return 0;
+  }
+
+  static const ColumnStatistics unknown;
+  const auto &column = predicate.column < statistics.columns.size()
+                           ? statistics.columns[predicate.column]
+                           : unknown;
+  const auto key = statistics_key(column.type, predicate.constant);
+
+  // Most common values are estimated exactly, the rest share what is left
+  const double non_null = 1 - column.null_fraction;
+  double common = 0;
+  for (const auto &value : column.most_common) {
+    common += value.frequency;
+  }
+  const double rest = std::max(non_null - common, 0.0);
+
+  auto equality = [&] {
+    if (key) {
+      for (const auto &value : column.most_common) {
+        if (value.hash == key->hash) {
+          return value.frequency;
+        }
+      }
+    }
+    if (column.distinct > 0) {
+      return rest / std::max(column.distinct -
+                                 static_cast<double>(column.most_common.size()),
+                             1.0);
+    }
+    return DEFAULT_EQUALITY * non_null;
+  };
+
+  double fraction = DEFAULT_RANGE * non_null;
+  switch (predicate.op) {
+  case CompareOp::EQ:
+    fraction = equality();
+    break;
+  case CompareOp::NE:
+    fraction = non_null - equality();
+    break;
+  case CompareOp::LT:
+  case CompareOp::LE:
+  case CompareOp::GT:
+  case CompareOp::GE: {
+    if (!key || !key->number) {
+      break;
+    }
+    const double value = *key->number;
+    const bool less = predicate.op == CompareOp::LT ||
+                      predicate.op == CompareOp::LE;
+
+    if (column.histogram.size() >= 2) {
+      const double below = histogram_below(column.histogram, value);
+      fraction = rest * (less ? below : 1 - below);
+      for (const auto &common_value : column.most_common) {
+        if (common_value.number &&
+            satisfies(*common_value.number, predicate.op, value)) {
+          fraction += common_value.frequency;
+        }
+      }
+      break;
+    }
+
+    if (!column.min || !column.max) {
+      break;
+    }
+    if (*column.max <= *column.min) {
+      fraction = satisfies(*column.min, predicate.op, value) ? non_null : 0;
+      break;
+    }
+    const double below = std::clamp(
+        (value - *column.min) / (*column.max - *column.min), 0.0, 1.0);
+    fraction = non_null * (less ? below : 1 - below);
+    break;
+  }
+  }
+
+  return std::clamp(fraction, 0.0, 1.0);
+}
+
+error::Result<QueryPlan>
+QueryOptimizer::optimize(const JoinQuery &query) const {
+  return Planner(query, m_options).plan();
+}
+
+error::Result<QueryPlan>
+QueryOptimizer::optimize(const JoinQuery &query,
+                         const JoinOrder &order) const {
+  return Planner(query, m_options).plan(order);
+}
+
+error::Result<JoinOrder>
+QueryOptimizer::order(const JoinQuery &query) const {
+  return Planner(query, m_options).order();
+}
+
+} // namespace velox::query
@@ -0,0 +1,183 @@
+#include <algorithm>
+#include <numeric>
+#include <velox/query/partition.hpp>
+
+namespace velox::query {
+Schema with_hash_column(const Schema &schema) {
+  Schema layout = schema;
+  layout.emplace_back("$hash", dtypes::TypeInfo(dtypes::TypeId::BIGINT));
+  return layout;
+}
+
+void radix_order(std::span<const uint64_t> hashes,
+                 std::span<const uint8_t> skip, unsigned shift, unsigned bits,
+                 std::vector<uint32_t> &order,
+                 std::vector<uint32_t> &bounds) {
+  const size_t groups = size_t{1} << bits;
+  const uint64_t mask = groups - 1;
+  auto group = [&](size_t row) {
+    return bits == 0 ? 0 : (hashes[row] >> shift) & mask;
+  };
+
+  bounds.assign(groups + 1, 0);
+  for (size_t row = 0; row < hashes.size(); ++row) {
+    if (skip.empty() || !skip[row]) {
+      ++bounds[group(row) + 1];
+    }
+  }
+  for (size_t g = 0; g < groups; ++g) {
+    bounds[g + 1] += bounds[g];
+  }
+
+  order.resize(bounds[groups]);
+  std::vector<uint32_t> cursor(bounds.begin(), bounds.end() - 1);
+  for (size_t row = 0; row < hashes.size(); ++row) {
+    if (skip.empty() || !skip[row]) {
+      order[cursor[group(row)]++] = static_cast<uint32_t>(row);
+    }
+  }
+}
+
+// PartitionBuffer
+
+error::VoidResult PartitionBuffer::append(const DataChunk &source,
+                                          std::span<const uint32_t> rows,
+                                          std::span<const uint64_t> hashes) {
+  const size_t copied = hashes.empty() ? m_layout.size() : m_layout.size() - 1;
+  while (!rows.empty()) {
+    if (m_tail.column_count() == 0) {
+      m_tail.initialize(m_layout);
+    }
+
+    const auto slice = rows.first(
+        std::min(rows.size(), config::VECTOR_SIZE - m_tail.size()));
+    for (size_t c = 0; c < copied; ++c) {
+      m_tail.column(c).append_selected(source.column(c), slice);
+    }
+    if (!hashes.empty()) {
+      auto &hash = m_tail.column(copied);
+      for (auto row : slice) {
+        hash.append<uint64_t>(hashes[row]);
+      }
+    }
+    m_tail.set_size(m_tail.size() + slice.size());
+    m_rows += slice.size();
+    rows = rows.subspan(slice.size());
+
+    if (m_tail.size() == config::VECTOR_SIZE) {
+      if (auto sealed = seal_tail(); !sealed) {
+        return sealed;
+      }
+    }
+  }
+
+  return error::ok();
+}
+
+error::VoidResult PartitionBuffer::append_chunk(DataChunk chunk) {
+  if (m_tail.empty() && chunk.size() == config::VECTOR_SIZE) {
+    m_tail = std::move(chunk);
+    m_rows += config::VECTOR_SIZE;
+    return seal_tail();
+  }
+
+  std::vector<uint32_t> rows(chunk.size());
+  std::iota(rows.begin(), rows.end(), 0);
+  return append(chunk, rows);
+}
+
+error::VoidResult PartitionBuffer::seal_tail() {
+  if (m_spill) {
+    auto written = m_spill->write(m_tail);
+    m_tail.clear();
+    return written;
+  }
+
+  m_bytes += m_tail.memory_usage();
+  m_chunks.push_back(std::move(m_tail));
+  m_tail = DataChunk();
+  return error::ok();
+}
+
+error::VoidResult PartitionBuffer::spill(const std::filesystem::path &directory) {
+  if (!m_spill) {
+    auto file = SpillFile::create(directory, m_layout);
+    if (!file) {
+      return tl::unexpected(file.error());
+    }
+    m_spill = std::move(*file);
+  }
+
+  for (const auto &chunk : m_chunks) {
+    if (auto written = m_spill->write(chunk); !written) {
+      return written;
+    }
+  }
+  m_chunks.clear();
+  m_chunks.shrink_to_fit();
+  m_bytes = 0;
+
+  return error::ok();
+}
+
+error::Result<bool> PartitionBuffer::read(DataChunk &chunk) {
+  if (m_read_position < m_chunks.size()) {
+    chunk = std::move(m_chunks[m_read_position++]);
+    return true;
+  }
+  if (m_spill) {
+    if (!m_rewound) {
+      if (auto status = m_spill->rewind(); !status) {
+        return tl::unexpected(status.error());
+      }
+      m_rewound = true;
+    }
+    auto more = m_spill->read(chunk);
+    if (!more || *more) {
+      return more;
+    }
+  }
+  if (!m_tail_read && !m_tail.empty()) {
+    m_tail_read = true;
+    chunk = std::move(m_tail);
+    return true;
+  }
+
+  return false;
+}
+
+error::VoidResult spill_largest(std::span<PartitionBuffer *const> partitions,
+                                size_t bytes,
+                                const std::filesystem::path &directory,
+                                WorkerPool &pool, size_t threads) {
+  std::vector<PartitionBuffer *> candidates(partitions.begin(),
+                                            partitions.end());
+  std::sort(candidates.begin(), candidates.end(),
+            [](const PartitionBuffer *a, const PartitionBuffer *b) {
+              return a->spillable_bytes() > b->spillable_bytes();
+            });
+
+  std::vector<PartitionBuffer *> victims;
+  size_t freed = 0;
+  for (auto *candidate : candidates) {
+    if (freed >= bytes || candidate->spillable_bytes() == 0) {
+      break;
+    }
+    freed += candidate->spillable_bytes();
+    victims.push_back(candidate);
+  }
+
+  std::vector<error::VoidResult> results(victims.size(), error::ok());
+  pool.parallel_for(
+      victims.size(),
+      [&](size_t v) { results[v] = victims[v]->spill(directory); }, threads);
+
+  for (const auto &result : results) {
+    if (!result) {
+      return result;
+    }
+  }
+  return error::ok();
+}
+
+} // namespace velox::query
@@ -0,0 +1,286 @@
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <velox/query/plan_cache.hpp>
+#include <velox/utils/hash.hpp>
+
+namespace velox::query {
+namespace {
+uint64_t hash_string(const std::string &value) {
+  return std::hash<std::string>{}(value);
+}
+
+void put_schema(std::vector<uint64_t> &tokens, const Schema &schema) {
+  tokens.push_back(schema.size());
+  for (const auto &column : schema) {
+    tokens.push_back(hash_string(column.name));
+    tokens.push_back(static_cast<uint64_t>(column.type.type_id));
+    tokens.push_back(column.type.max_length);
+    tokens.push_back(column.type.precision);
+    tokens.push_back(column.type.scale);
+  }
+}
+
+uint64_t table_id(const RelationSpec &relation) noexcept {
+  return relation.table ? relation.table->id() : 0;
+}
+
+std::vector<PlanStamp> stamps(const JoinQuery &query) {
+  std::vector<PlanStamp> result;
+  result.reserve(query.relations.size());
+  for (const auto &relation : query.relations) {
+    result.push_back(
+        {table_id(relation),
+         relation.statistics ? relation.statistics->version : 0,
+         relation.table ? relation.table->row_count() : 0});
+  }
+
+  return result;
+}
+} // namespace
+
+QueryFingerprint fingerprint(const JoinQuery &query) {
+  QueryFingerprint result;
+  auto &tokens = result.tokens;
+
+  tokens.push_back(query.relations.size());
+  for (const auto &relation : query.relations) {
+    tokens.push_back(hash_string(relation.name));
+    tokens.push_back(table_id(relation));
+    if (relation.table) {
+      put_schema(tokens, relation.table->schema());
+    }
+    tokens.push_back(relation.statistics.has_value());
+
+    // Constants are parameters; only the shape of each predicate counts
+    std::vector<std::pair<size_t, CompareOp>> predicates;
+    for (const auto &predicate : relation.predicates) {
+      predicates.emplace_back(predicate.column, predicate.op);
+    }
+    std::sort(predicates.begin(), predicates.end());
+    tokens.push_back(predicates.size());
+    for (const auto &[column, op] : predicates) {
+      tokens.push_back(column);
+      tokens.push_back(static_cast<uint64_t>(op));
+    }
+
+    tokens.push_back(relation.indexes.size());
+    for (const auto &index : relation.indexes) {
+      tokens.push_back(hash_string(index.name));
+      tokens.push_back(index.column);
+      tokens.push_back(index.unique);
+      tokens.push_back(index.ordered);
+    }
+  }
+
+  // a.x = b.y and b.y = a.x are the same edge
+  std::vector<std::array<size_t, 4>> joins;
+  for (const auto &edge : query.joins) {
+    std::array<size_t, 4> join{edge.left, edge.left_column, edge.right,
+                               edge.right_column};
+    if (std::pair(join[2], join[3]) < std::pair(join[0], join[1])) {
+      std::swap(join[0], join[2]);
+      std::swap(join[1], join[3]);
+    }
+    joins.push_back(join);
+  }
+  std::sort(joins.begin(), joins.end());
+  tokens.push_back(joins.size());
+  for (const auto &join : joins) {
+    tokens.insert(tokens.end(), join.begin(), join.end());
+  }
+
+  tokens.push_back(query.output.size());
+  for (const auto &output : query.output) {
+    tokens.push_back(output.relation);
+    tokens.push_back(output.column);
+  }
+
+  size_t hash = 0;
+  for (auto token : tokens) {
+    utils::hash::hash_combine(hash, token);
+  }
+  result.hash = hash;
+
+  return result;
+}
+
+// PlanCache
+
+PlanCache::PlanCache(PlanCacheOptions options, OptimizerOptions optimizer)
+    : m_options(options), m_optimizer(optimizer) {}
+
+error::Result<QueryPlan> PlanCache::plan(const JoinQuery &query) {
+  return plan(query, fingerprint(query));
+}
+
+error::Result<QueryPlan>
+PlanCache::plan(const JoinQuery &query, const QueryFingerprint &fingerprint) {
+  Value cached;
+  {
+    std::lock_guard<metrics::InstrumentedMutex> lock(m_mutex);
+    if (auto it = m_index.find(fingerprint.hash); it != m_index.end()) {
+      const auto &entry = *it->second->second;
+      if (entry.fingerprint == fingerprint && fresh(entry, query)) {
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        cached = it->second->second;
+      } else {
+        // Stale, or a hash collision that takes over the slot
+        erase(it->second);
+        ++m_statistics.invalidations;
+      }
+    }
+    ++(cached ? m_statistics.hits : m_statistics.misses);
+  }
+  if (cached) {
+    return m_optimizer.optimize(query, cached->order);
+  }
+
+  // Plan outside the lock; a concurrent miss on the same key only
+  // duplicates work
+  auto order = m_optimizer.order(query);
+  if (!order) {
+    return tl::unexpected(order.error());
+  }
+  auto entry = std::make_shared<CachedPlan>(
+      CachedPlan{fingerprint, std::move(*order), stamps(query)});
+  put(fingerprint.hash, entry);
+
+  return m_optimizer.optimize(query, entry->order);
+}
+
+bool PlanCache::fresh(const CachedPlan &entry, const JoinQuery &query) const {
+  if (entry.stamps.size() != query.relations.size()) {
+    return false;
+  }
+
+  for (size_t r = 0; r < query.relations.size(); ++r) {
+    const auto &relation = query.relations[r];
+    const auto &stamp = entry.stamps[r];
+    const uint64_t version =
+        relation.statistics ? relation.statistics->version : 0;
+    if (stamp.table != table_id(relation) ||
+        stamp.statistics_version != version) {
+      return false;
+    }
+
+    // Without a statistics version, the row count is all there is to go by
+    if (version == 0) {
+      const auto planned = static_cast<double>(stamp.rows);
+      const auto rows = static_cast<double>(relation.table->row_count());
+      if (rows > planned * m_options.replan_growth ||
+          planned > rows * m_options.replan_growth) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+void PlanCache::invalidate(const ColumnarTable &table) {
+  std::lock_guard<metrics::InstrumentedMutex> lock(m_mutex);
+  for (auto it = m_entries.begin(); it != m_entries.end();) {
+    const auto &plan_stamps = it->second->stamps;
+    const bool reads = std::any_of(
+        plan_stamps.begin(), plan_stamps.end(),
+        [&](const PlanStamp &stamp) { return stamp.table == table.id(); });
+    auto next = std::next(it);
+    if (reads) {
+      erase(it);
+      ++m_statistics.invalidations;
+    }
+    it = next;
+  }
+}
+
+PlanCache::Value PlanCache::get(const Key &key) {
+  std::lock_guard<metrics::InstrumentedMutex> lock(m_mutex);
+  auto it = m_index.find(key);
+  if (it == m_index.end()) {
+    return nullptr;
+  }
+
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second->second;
+}
+
+void PlanCache::put(const Key &key, const Value &value) {
+  std::lock_guard<metrics::InstrumentedMutex> lock(m_mutex);
+  if (m_options.capacity == 0 || !value) {
+    return;
+  }
+
+  if (auto it = m_index.find(key); it != m_index.end()) {
+    it->second->second = value;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return;
+  }
+  while (m_entries.size() >= m_options.capacity) {
+    erase(std::prev(m_entries.end()));
+  }
+  m_entries.emplace_front(key, value);
+  m_index.emplace(key, m_entries.begin());
+}
+
+void PlanCache::evict(const Key &key) {
+  std::lock_guard<metrics::InstrumentedMutex> lock(m_mutex);
+  if (auto it = m_index.find(key); it != m_index.end()) {
+    erase(it->second);
+  }
+}
+
+void PlanCache::clear() {
+  std::lock_guard<metrics::InstrumentedMutex> lock(m_mutex);
+  m_entries.clear();
+  m_index.clear();
+}
+
+size_t PlanCache::size() const {
+  std::lock_guard<metrics::InstrumentedMutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+PlanCacheStatistics PlanCache::statistics() const {
+  std::lock_guard<metrics::InstrumentedMutex> lock(m_mutex);
+  return m_statistics;
+}
+
+void PlanCache::erase(Entries::iterator entry) {
+  m_index.erase(entry->first);
+  m_entries.erase(entry);
+}
+
+// PreparedStatement
+
+PreparedStatement::PreparedStatement(std::shared_ptr<PlanCache> cache,
+                                     JoinQuery query)
+    : m_cache(std::move(cache)), m_query(std::move(query)),
+      m_fingerprint(fingerprint(m_query)) {}
+
+size_t PreparedStatement::parameter_count() const noexcept {
+  size_t count = 0;
+  for (const auto &relation : m_query.relations) {
+    count += relation.predicates.size();
+  }
+
+  return count;
+}
+
+error::Result<QueryPlan>
+PreparedStatement::bind(std::span<const dtypes::Value> parameters) {
+  if (parameters.size() != parameter_count()) {
+    return error::error<QueryPlan>(error::ErrorCode::INVALID_ARGUMENT);
+  }
+
+  auto parameter = parameters.begin();
+  for (auto &relation : m_query.relations) {
+    for (auto &predicate : relation.predicates) {
+      predicate.constant = *parameter++;
+    }
+  }
+
+  return m_cache->plan(m_query, m_fingerprint);
+}
+
+} // namespace velox::query
@@ -0,0 +1,78 @@
+#include <velox/metrics/metrics.hpp>
+#include <velox/metrics/trace.hpp>
+#include <velox/query/query_processor.hpp>
+
+namespace velox::query {
+dtypes::Row QueryResult::row(size_t index) const {
+  for (const auto &chunk : chunks) {
+    if (index < chunk.size()) {
+      return chunk.row(index);
+    }
+    index -= chunk.size();
+  }
+
+  return dtypes::Row{};
+}
+
+error::Result<QueryResult> QueryProcessor::execute(QueryPlan &plan) {
+  if (!plan.root) {
+    return error::error<QueryResult>(error::ErrorCode::INVALID_ARGUMENT);
+  }
+
+  QueryResult result;
+  result.schema = plan.schema();
+  auto executed = execute(plan, [&](const DataChunk &chunk) {
+    result.chunks.push_back(chunk);
+    return true;
+  });
+  if (!executed) {
+    return tl::unexpected(executed.error());
+  }
+
+  return result;
+}
+
+error::VoidResult QueryProcessor::execute(QueryPlan &plan,
+                                          const ChunkSink &sink) {
+  if (!plan.root) {
+    return error::error<void>(error::ErrorCode::INVALID_ARGUMENT);
+  }
+
+  static auto &latency =
+      metrics::global_registry().get_histogram(metrics::names::QUERY_EXECUTE);
+  static auto &rows =
+      metrics::global_registry().get_counter(metrics::names::QUERY_ROWS);
+
+  metrics::TraceScope trace("query_execute");
+  metrics::ScopedLatency timer(latency);
+
+  m_statistics = QueryStatistics{};
+  const auto start = Clock::now();
+  plan.root->reset();
+
+  DataChunk chunk;
+  error::VoidResult status = error::ok();
+  while (true) {
+    auto more = plan.root->next(chunk);
+    if (!more) {
+      status = tl::unexpected(more.error());
+      break;
+    }
+    if (!*more) {
+      break;
+    }
+
+    m_statistics.rows += chunk.size();
+    ++m_statistics.chunks;
+    if (!sink(chunk)) {
+      break;
+    }
+  }
+
+  m_statistics.elapsed = Clock::now() - start;
+  rows.add(m_statistics.rows);
+
+  return status;
+}
+
+} // namespace velox::query
@@ -0,0 +1,156 @@
+#include <velox/query/operators.hpp>
+#include <velox/storage/storage_engine.hpp>
+
+namespace velox::query {
+namespace {
+error::ErrorCode to_error_code(storage::StorageError error) noexcept {
+  switch (error) {
+  case storage::StorageError::IO_ERROR:
+    return error::ErrorCode::IO_ERROR;
+  case storage::StorageError::CORRUPTION:
+    return error::ErrorCode::CORRUPTION;
+  case storage::StorageError::TRANSACTION_ABORTED:
+    return error::ErrorCode::TRANSACTION_ABORTED;
+  default:
+    return error::ErrorCode::STORAGE_ERROR;
+  }
+}
+} // namespace
+
+// RecordScan
+
+RecordScan::RecordScan(storage::StorageEngine &engine, std::string table,
+                       std::vector<RecordId> record_ids, Schema schema,
+                       std::vector<size_t> projection)
+    : Operator(projection.empty() ? schema
+                                  : detail::scan_schema(schema, projection)),
+      m_engine(engine), m_table(std::move(table)),
+      m_record_ids(std::move(record_ids)), m_stored(std::move(schema)),
+      m_projection(projection.empty() ? detail::all_columns(m_stored)
+                                      : std::move(projection)) {}
+
+error::Result<bool> RecordScan::next(DataChunk &output) {
+  prepare(output);
+  for (auto column : m_projection) {
+    if (column >= m_stored.size() && column != ROW_ID_COLUMN) {
+      return error::error<bool>(error::ErrorCode::INVALID_ARGUMENT);
+    }
+  }
+
+  while (output.size() < config::VECTOR_SIZE &&
+         m_position < m_record_ids.size()) {
+    const auto id = m_record_ids[m_position++];
+    auto record = m_engine.get_record(m_table, id);
+    if (!record) {
+      if (record.error() == storage::StorageError::RECORD_NOT_FOUND) {
+        continue;
+      }
+      return error::error<bool>(to_error_code(record.error()));
+    }
+
+    auto row = dtypes::Row::deserialize(record->data);
+    if (!row) {
+      return error::error<bool>(error::ErrorCode::CORRUPTION);
+    }
+    if (row->size() != m_stored.size()) {
+      return error::error<bool>(error::ErrorCode::INVALID_ARGUMENT);
+    }
+    for (size_t i = 0; i < m_projection.size(); ++i) {
+      const size_t c = m_projection[i];
+      auto &column = output.column(i);
+      if (c == ROW_ID_COLUMN) {
+        column.append<int64_t>(static_cast<int64_t>(id));
+      } else if (auto appended = column.append_value((*row)[c]); !appended) {
+        return tl::unexpected(appended.error());
+      }
+    }
+    output.set_size(output.size() + 1);
+  }
+
+  return !output.empty();
+}
+
+std::string RecordScan::name() const {
+  std::string columns;
+  for (const auto &column : schema()) {
+    columns += columns.empty() ? column.name : ", " + column.name;
+  }
+
+  return fmt::format("RecordScan({}: {} records: {})", m_table,
+                     m_record_ids.size(), columns);
+}
+
+// RecordFetch
+
+RecordFetch::RecordFetch(OperatorPtr child, size_t row_id,
+                         storage::StorageEngine &engine, std::string table,
+                         Schema schema, std::vector<size_t> columns)
+    : Operator(detail::fetch_schema(child->schema(), schema, columns)),
+      m_child(std::move(child)), m_row_id(row_id), m_engine(engine),
+      m_table(std::move(table)), m_stored(std::move(schema)),
+      m_columns(std::move(columns)) {}
+
+error::Result<bool> RecordFetch::next(DataChunk &output) {
+  prepare(output);
+  auto more = m_child->next(m_input);
+  if (!more || !*more) {
+    return more;
+  }
+
+  const size_t rows = m_input.size();
+  if (!detail::valid_row_id(m_input, m_row_id)) {
+    return error::error<bool>(error::ErrorCode::INVALID_ARGUMENT);
+  }
+  for (auto column : m_columns) {
+    if (column >= m_stored.size()) {
+      return error::error<bool>(error::ErrorCode::INVALID_ARGUMENT);
+    }
+  }
+
+  const size_t width = m_input.column_count();
+  for (size_t c = 0; c < width; ++c) {
+    output.column(c).append_range(m_input.column(c), 0, rows);
+  }
+
+  const auto &ids = m_input.column(m_row_id);
+  for (size_t row = 0; row < rows; ++row) {
+    if (!ids.is_valid(row)) {
+      for (size_t i = 0; i < m_columns.size(); ++i) {
+        output.column(width + i).append_null();
+      }
+      continue;
+    }
+
+    auto record = m_engine.get_record(
+        m_table, static_cast<RecordId>(ids.data<int64_t>()[row]));
+    if (!record) {
+      return error::error<bool>(to_error_code(record.error()));
+    }
+    auto stored = dtypes::Row::deserialize(record->data);
+    if (!stored) {
+      return error::error<bool>(error::ErrorCode::CORRUPTION);
+    }
+    if (stored->size() != m_stored.size()) {
+      return error::error<bool>(error::ErrorCode::INVALID_ARGUMENT);
+    }
+    for (size_t i = 0; i < m_columns.size(); ++i) {
+      if (auto appended =
+              output.column(width + i).append_value((*stored)[m_columns[i]]);
+          !appended) {
+        return tl::unexpected(appended.error());
+      }
+    }
+  }
+  output.set_size(rows);
+
+  return true;
+}
+
+std::string RecordFetch::name() const {
+  return fmt::format("RecordFetch({}: {} by {})", m_table,
+                     detail::fetch_columns(m_stored, m_columns),
+                     m_child->schema().size() > m_row_id
+                         ? m_child->schema()[m_row_id].name
+                         : "?");
+}
+} // namespace velox::query
@@ -0,0 +1,939 @@
+#include <algorithm>
+#include <array>
+#include <velox/query/operators.hpp>
+#include <velox/query/partition.hpp>
+#include <velox/query/worker_pool.hpp>
+
+namespace velox::query {
+namespace {
+/// @brief Rows per sorted run of an ExternalSort
+constexpr size_t RUN_ROWS = 128 * 1024;
+
+/// @brief Runs merged at once; more runs take several passes
+constexpr size_t MERGE_FAN_IN = 64;
+
+/// @brief Rows below which a prefix sort compares instead of radix sorting
+constexpr size_t RADIX_MIN_ROWS = 256;
+
+/// @brief Row of a run with the normalized prefix of its first key
+struct SortEntry {
+  uint64_t prefix;
+  uint32_t chunk;
+  uint32_t row;
+};
+
+/**
+ * @brief Orders rows by a list of SortKeys
+ *
+ * @note Rows are given as (chunk, row, prefix). The first key is decided
+ *       by the prefixes when they differ, or outright when it is
+ *       fixed-width (the prefix is then exact).
+ */
+class RowOrder {
+public:
+  RowOrder(std::vector<SortKey> keys, const Schema &schema)
+      : m_keys(std::move(keys)),
+        m_exact(m_keys.empty() ||
+                exact_prefixes(
+                    physical_type(schema[m_keys[0].column].type.type_id))) {}
+
+  [[nodiscard]] const std::vector<SortKey> &keys() const noexcept {
+    return m_keys;
+  }
+
+  /// @brief Check whether equal prefixes mean equal first keys
+  [[nodiscard]] bool exact() const noexcept { return m_exact; }
+
+  /// @brief strcmp-like comparison on keys [first, end)
+  [[nodiscard]] int compare(const DataChunk &left, size_t left_row,
+                            const DataChunk &right, size_t right_row,
+                            size_t first) const noexcept {
+    for (size_t k = first; k < m_keys.size(); ++k) {
+      const auto &key = m_keys[k];
+      const auto &x = left.column(key.column);
+      const auto &y = right.column(key.column);
+      const bool x_valid = x.is_valid(left_row);
+      const bool y_valid = y.is_valid(right_row);
+
+      if (!x_valid || !y_valid) {
+        if (x_valid == y_valid) {
+          continue;
+        }
+        return key.nulls_first == !x_valid ? -1 : 1;
+      }
+
+      const int order = x.compare(left_row, y, right_row);
+      if (order != 0) {
+        return key.ascending ? order : -order;
+      }
+    }
+    return 0;
+  }
+
+  /// @brief strcmp-like comparison using the first key's prefixes
+  [[nodiscard]] int compare(const DataChunk &left, size_t left_row,
+                            uint64_t left_prefix, const DataChunk &right,
+                            size_t right_row,
+                            uint64_t right_prefix) const noexcept {
+    if (m_keys.empty()) {
+      return 0;
+    }
+
+    const auto &key = m_keys[0];
+    const bool x_valid = left.column(key.column).is_valid(left_row);
+    const bool y_valid = right.column(key.column).is_valid(right_row);
+    if (!x_valid || !y_valid) {
+      if (x_valid == y_valid) {
+        return compare(left, left_row, right, right_row, 1);
+      }
+      return key.nulls_first == !x_valid ? -1 : 1;
+    }
+
+    if (left_prefix != right_prefix) {
+      return left_prefix < right_prefix ? -1 : 1;
+    }
+    return compare(left, left_row, right, right_row, m_exact ? 1 : 0);
+  }
+
+private:
+  std::vector<SortKey> m_keys;
+  bool m_exact;
+};
+
+/// @brief Stable LSD radix sort on the prefixes, skipping constant bytes
+void radix_sort(std::span<SortEntry> entries,
+                std::vector<SortEntry> &scratch) {
+  const size_t n = entries.size();
+  std::vector<std::array<uint32_t, 256>> counts(8);
+  for (const auto &entry : entries) {
+    for (size_t pass = 0; pass < 8; ++pass) {
+      ++counts[pass][(entry.prefix >> (pass * 8)) & 0xff];
+    }
+  }
+
+  scratch.resize(n);
+  SortEntry *source = entries.data();
+  SortEntry *target = scratch.data();
+  for (size_t pass = 0; pass < 8; ++pass) {
+    auto &count = counts[pass];
+    const unsigned shift = pass * 8;
+    if (count[(source[0].prefix >> shift) & 0xff] == n) {
+      continue;
+    }
+
+    uint32_t offset = 0;
+    for (auto &bucket : count) {
+      offset += std::exchange(bucket, offset);
+    }
+    for (size_t i = 0; i < n; ++i) {
+      target[count[(source[i].prefix >> shift) & 0xff]++] = source[i];
+    }
+    std::swap(source, target);
+  }
+
+  if (source != entries.data()) {
+    std::copy(source, source + n, entries.data());
+  }
+}
+
+/**
+ * @brief Sort the rows of some chunks
+ *
+ * @param chunks Rows to sort
+ * @param order Key order
+ * @param entries Output, every row in sorted order (stable)
+ */
+void sort_rows(const std::vector<DataChunk> &chunks, const RowOrder &order,
+               std::vector<SortEntry> &entries) {
+  entries.clear();
+  const auto &keys = order.keys();
+  std::vector<uint64_t> prefixes;
+  for (size_t c = 0; c < chunks.size(); ++c) {
+    prefixes.assign(chunks[c].size(), 0);
+    if (!keys.empty()) {
+      order_prefixes(chunks[c].column(keys[0].column), 0, chunks[c].size(),
+                     keys[0].ascending, prefixes.data());
+    }
+    for (size_t r = 0; r < chunks[c].size(); ++r) {
+      entries.push_back({prefixes[r], static_cast<uint32_t>(c),
+                         static_cast<uint32_t>(r)});
+    }
+  }
+  if (keys.empty()) {
+    return;
+  }
+
+  auto less_from = [&](size_t first) {
+    return [&, first](const SortEntry &a, const SortEntry &b) {
+      return order.compare(chunks[a.chunk], a.row, chunks[b.chunk], b.row,
+                           first) < 0;
+    };
+  };
+
+  // NULL first keys go to one end in input order
+  const auto &key = keys[0];
+  auto is_null = [&](const SortEntry &entry) {
+    return !chunks[entry.chunk].column(key.column).is_valid(entry.row);
+  };
+  const auto middle =
+      key.nulls_first
+          ? std::stable_partition(entries.begin(), entries.end(), is_null)
+          : std::stable_partition(entries.begin(), entries.end(),
+                                  [&](const SortEntry &e) { return !is_null(e); });
+  const auto nulls_begin = key.nulls_first ? entries.begin() : middle;
+  const auto nulls_end = key.nulls_first ? middle : entries.end();
+  const auto values = key.nulls_first ? std::span(middle, entries.end())
+                                      : std::span(entries.begin(), middle);
+
+  if (keys.size() > 1) {
+    std::stable_sort(nulls_begin, nulls_end, less_from(1));
+  }
+
+  if (values.size() < RADIX_MIN_ROWS) {
+    std::stable_sort(values.begin(), values.end(),
+                     [&](const SortEntry &a, const SortEntry &b) {
+                       return order.compare(chunks[a.chunk], a.row, a.prefix,
+                                            chunks[b.chunk], b.row,
+                                            b.prefix) < 0;
+                     });
+    return;
+  }
+
+  std::vector<SortEntry> scratch;
+  radix_sort(values, scratch);
+
+  // Break prefix ties on the remaining (or, for strings, all) keys
+  if (order.exact() && keys.size() == 1) {
+    return;
+  }
+  const auto tie_break = less_from(order.exact() ? 1 : 0);
+  for (size_t i = 0; i < values.size();) {
+    size_t j = i + 1;
+    while (j < values.size() && values[j].prefix == values[i].prefix) {
+      ++j;
+    }
+    if (j - i > 1) {
+      std::stable_sort(values.begin() + i, values.begin() + j, tie_break);
+    }
+    i = j;
+  }
+}
+} // namespace
+
+Sort::Sort(OperatorPtr child, std::vector<SortKey> keys)
+    : Operator(child->schema()), m_child(std::move(child)),
+      m_keys(std::move(keys)) {}
+
+error::VoidResult Sort::materialize() {
+  for (const auto &key : m_keys) {
+    if (key.column >= schema().size()) {
+      return error::error<void>(error::ErrorCode::INVALID_ARGUMENT);
+    }
+  }
+
+  while (true) {
+    auto &chunk = m_chunks.emplace_back();
+    auto more = m_child->next(chunk);
+    if (!more) {
+      return tl::unexpected(more.error());
+    }
+    if (!*more) {
+      m_chunks.pop_back();
+      break;
+    }
+  }
+
+  std::vector<SortEntry> entries;
+  sort_rows(m_chunks, RowOrder(m_keys, schema()), entries);
+  m_order.reserve(entries.size());
+  for (const auto &entry : entries) {
+    m_order.push_back(static_cast<uint64_t>(entry.chunk) << 32 | entry.row);
+  }
+  m_sorted = true;
+
+  return error::ok();
+}
+
+error::Result<bool> Sort::next(DataChunk &output) {
+  if (!m_sorted) {
+    if (auto sorted = materialize(); !sorted) {
+      return tl::unexpected(sorted.error());
+    }
+  }
+
+  prepare(output);
+  const auto count =
+      std::min(config::VECTOR_SIZE, m_order.size() - m_emitted);
+  for (size_t i = m_emitted; i < m_emitted + count; ++i) {
+    output.append_row(m_chunks[m_order[i] >> 32], m_order[i] & UINT32_MAX);
+  }
+  m_emitted += count;
+
+  return count > 0;
+}
+
+void Sort::reset() {
+  m_child->reset();
+  m_chunks.clear();
+  m_order.clear();
+  m_emitted = 0;
+  m_sorted = false;
+}
+
+namespace {
+std::string describe_keys(const Schema &schema,
+                          const std::vector<SortKey> &keys) {
+  std::string text;
+  for (const auto &key : keys) {
+    text += fmt::format(
+        "{}{} {}{}", text.empty() ? "" : ", ",
+        key.column < schema.size() ? schema[key.column].name : "?",
+        key.ascending ? "ASC" : "DESC", key.nulls_first ? " NULLS FIRST" : "");
+  }
+  return text;
+}
+} // namespace
+
+std::string Sort::name() const {
+  return fmt::format("Sort({})", describe_keys(schema(), m_keys));
+}
+
+// TopN
+
+/**
+ * @brief Kept rows and the heap over them
+ *
+ * @note Replaced rows stay in the store until it holds twice the heap,
+ *       then the survivors are copied out.
+ */
+class TopN::State {
+public:
+  /// @brief Row in the heap
+  struct Entry {
+    uint64_t prefix;   ///< First-key prefix; unspecified if null
+    uint64_t sequence; ///< Input position, to keep ties stable
+    uint32_t chunk;
+    uint32_t row;
+    bool null; ///< First key is NULL
+  };
+
+  State(std::vector<SortKey> keys, const Schema &schema, size_t capacity)
+      : order(std::move(keys), schema), layout(schema), capacity(capacity) {}
+
+  RowOrder order;
+  Schema layout;
+  size_t capacity;
+  std::vector<DataChunk> rows;
+  size_t stored{0};
+  std::vector<Entry> heap; ///< Max-heap on before(): worst row on top
+  uint64_t sequence{0};
+  size_t emitted{0};
+  bool sorted{false};
+
+  /// @brief Check whether a sorts before b in the output
+  [[nodiscard]] bool before(const DataChunk &a_chunk, const Entry &a,
+                            const DataChunk &b_chunk,
+                            const Entry &b) const noexcept {
+    const int result =
+        order.compare(a_chunk, a.row, a.prefix, b_chunk, b.row, b.prefix);
+    return result != 0 ? result < 0 : a.sequence < b.sequence;
+  }
+
+  [[nodiscard]] bool before(const Entry &a, const Entry &b) const noexcept {
+    return before(rows[a.chunk], a, rows[b.chunk], b);
+  }
+
+  /// @brief Copy a row into the store, pointing entry at the copy
+  void store(const DataChunk &source, size_t row, Entry &entry) {
+    if (rows.empty() || rows.back().size() == config::VECTOR_SIZE) {
+      rows.emplace_back(layout);
+    }
+    entry.chunk = static_cast<uint32_t>(rows.size() - 1);
+    entry.row = static_cast<uint32_t>(rows.back().size());
+    rows.back().append_row(source, row);
+    ++stored;
+  }
+
+  /// @brief Drop replaced rows from the store
+  void compact() {
+    auto old = std::move(rows);
+    rows.clear();
+    stored = 0;
+    for (auto &entry : heap) {
+      store(old[entry.chunk], entry.row, entry);
+    }
+  }
+};
+
+TopN::TopN(OperatorPtr child, std::vector<SortKey> keys, size_t limit,
+           size_t offset, std::shared_ptr<TopNBound> bound)
+    : Operator(child->schema()), m_child(std::move(child)),
+      m_keys(std::move(keys)), m_limit(limit), m_offset(offset),
+      m_bound(std::move(bound)) {
+  if (m_bound && (m_keys.empty() || m_bound->key().column != m_keys[0].column ||
+                  m_bound->key().ascending != m_keys[0].ascending ||
+                  m_bound->key().nulls_first != m_keys[0].nulls_first)) {
+    m_bound.reset();
+  }
+}
+
+TopN::~TopN() = default;
+
+error::VoidResult TopN::materialize() {
+  for (const auto &key : m_keys) {
+    if (key.column >= schema().size()) {
+      return error::error<void>(error::ErrorCode::INVALID_ARGUMENT);
+    }
+  }
+
+  const size_t capacity =
+      m_limit > SIZE_MAX - m_offset ? SIZE_MAX : m_limit + m_offset;
+  m_state = std::make_unique<State>(m_keys, schema(), capacity);
+  auto &s = *m_state;
+  if (capacity == 0) {
+    s.sorted = true;
+    return error::ok();
+  }
+
+  auto before = [&s](const State::Entry &a, const State::Entry &b) {
+    return s.before(a, b);
+  };
+  const SortKey *first = m_keys.empty() ? nullptr : &m_keys[0];
+  const bool exact = s.order.exact() && m_keys.size() == 1;
+
+  DataChunk input;
+  std::vector<uint64_t> prefixes(config::VECTOR_SIZE);
+  while (true) {
+    // Without keys the first rows win, so a full heap ends the input
+    if (!first && s.heap.size() == capacity) {
+      break;
+    }
+
+    auto more = m_child->next(input);
+    if (!more) {
+      return tl::unexpected(more.error());
+    }
+    if (!*more) {
+      break;
+    }
+
+    const ColumnVector *key = first ? &input.column(first->column) : nullptr;
+    if (key) {
+      order_prefixes(*key, 0, input.size(), first->ascending,
+                     prefixes.data());
+    }
+
+    bool improved = false;
+    for (size_t row = 0; row < input.size(); ++row) {
+      State::Entry entry{key ? prefixes[row] : 0, s.sequence++, 0,
+                         static_cast<uint32_t>(row),
+                         key && !key->is_valid(row)};
+
+      if (s.heap.size() < capacity) {
+        s.store(input, row, entry);
+        s.heap.push_back(entry);
+        std::push_heap(s.heap.begin(), s.heap.end(), before);
+        improved = s.heap.size() == capacity;
+        continue;
+      }
+
+      // Later rows lose ties, so only a strictly better key may enter
+      const auto &top = s.heap.front();
+      if (!entry.null && !top.null &&
+          (entry.prefix > top.prefix ||
+           (exact && entry.prefix == top.prefix))) {
+        continue;
+      }
+      if (!s.before(input, entry, s.rows[top.chunk], top)) {
+        continue;
+      }
+
+      std::pop_heap(s.heap.begin(), s.heap.end(), before);
+      s.store(input, row, entry);
+      s.heap.back() = entry;
+      std::push_heap(s.heap.begin(), s.heap.end(), before);
+      improved = true;
+    }
+
+    if (s.stored > 2 * s.heap.size() + config::VECTOR_SIZE) {
+      s.compact();
+    }
+    if (improved && m_bound && !s.heap.front().null) {
+      m_bound->publish(s.heap.front().prefix);
+    }
+  }
+
+  std::sort_heap(s.heap.begin(), s.heap.end(), before);
+  s.emitted = m_offset;
+  s.sorted = true;
+
+  return error::ok();
+}
+
+error::Result<bool> TopN::next(DataChunk &output) {
+  if (!m_state || !m_state->sorted) {
+    if (auto sorted = materialize(); !sorted) {
+      m_state.reset();
+      return tl::unexpected(sorted.error());
+    }
+  }
+
+  auto &s = *m_state;
+  prepare(output);
+  const size_t begin = std::min(s.emitted, s.heap.size());
+  const size_t end = std::min(begin + config::VECTOR_SIZE, s.heap.size());
+  for (size_t i = begin; i < end; ++i) {
+    output.append_row(s.rows[s.heap[i].chunk], s.heap[i].row);
+  }
+  s.emitted = end;
+
+  return end > begin;
+}
+
+void TopN::reset() {
+  m_child->reset();
+  m_state.reset();
+  if (m_bound) {
+    m_bound->reset();
+  }
+}
+
+std::string TopN::name() const {
+  const auto keys = describe_keys(schema(), m_keys);
+  return m_offset == 0
+             ? fmt::format("TopN({} LIMIT {})", keys, m_limit)
+             : fmt::format("TopN({} LIMIT {} OFFSET {})", keys, m_limit,
+                           m_offset);
+}
+
+// ExternalSort
+
+namespace {
+/// @brief Run layout: the input columns plus the first key's prefix
+Schema run_layout(const Schema &schema) {
+  Schema layout = schema;
+  layout.emplace_back("$prefix", dtypes::TypeInfo(dtypes::TypeId::BIGINT));
+  return layout;
+}
+
+/**
+ * @brief Write sorted rows to a run, with their prefixes
+ *
+ * @param chunks Rows referenced by entries
+ * @param entries Rows in sorted order
+ * @param run Destination with the run_layout()
+ */
+error::VoidResult write_run(const std::vector<DataChunk> &chunks,
+                            std::span<const SortEntry> entries,
+                            PartitionBuffer &run) {
+  const auto &layout = run.layout();
+  const size_t columns = layout.size() - 1;
+  for (size_t first = 0; first < entries.size();
+       first += config::VECTOR_SIZE) {
+    const auto slice = entries.subspan(
+        first, std::min(config::VECTOR_SIZE, entries.size() - first));
+    DataChunk chunk(layout);
+    for (size_t c = 0; c < columns; ++c) {
+      auto &column = chunk.column(c);
+      for (const auto &entry : slice) {
+        column.append_from(chunks[entry.chunk].column(c), entry.row);
+      }
+    }
+    auto &prefixes = chunk.column(columns);
+    for (const auto &entry : slice) {
+      prefixes.append<uint64_t>(entry.prefix);
+    }
+    chunk.set_size(slice.size());
+
+    if (auto status = run.append_chunk(std::move(chunk)); !status) {
+      return status;
+    }
+  }
+
+  return error::ok();
+}
+
+/**
+ * @brief k-way merge of sorted runs through a loser tree
+ *
+ * @note m_tree[0] holds the winning run and m_tree[1, k) the loser of
+ *       each match, with run i as leaf k + i. Ties go to the lower run,
+ *       which keeps the merge stable when runs are in input order.
+ *       Consecutive rows won by the same run are copied as one range.
+ */
+class RunMerger {
+public:
+  RunMerger(std::vector<PartitionBuffer> runs, const RowOrder &order)
+      : m_order(order) {
+    for (auto &run : runs) {
+      m_cursors.push_back({std::move(run), DataChunk(), 0, false});
+    }
+  }
+
+  /// @brief Read the first chunk of every run and play the tournament
+  [[nodiscard]] error::VoidResult start() {
+    for (auto &cursor : m_cursors) {
+      if (auto status = load(cursor); !status) {
+        return status;
+      }
+    }
+
+    m_tree.assign(std::max<size_t>(m_cursors.size(), 1), 0);
+    if (!m_cursors.empty()) {
+      m_tree[0] = play(1);
+    }
+    return error::ok();
+  }
+
+  /**
+   * @brief Append up to limit rows in merged order
+   *
+   * @param output Chunk receiving the first columns of every run column
+   * @param columns Run columns to copy
+   * @param limit Most rows to append
+   * @return Rows appended; 0 once every run is exhausted
+   */
+  [[nodiscard]] error::Result<size_t> next(DataChunk &output, size_t columns,
+                                           size_t limit) {
+    size_t produced = 0;
+    while (produced < limit && !m_cursors.empty()) {
+      const size_t winner = m_tree[0];
+      auto &cursor = m_cursors[winner];
+      if (cursor.done) {
+        break;
+      }
+
+      const size_t start = cursor.row;
+      bool replayed = false;
+      while (true) {
+        ++cursor.row;
+        ++produced;
+        if (cursor.row == cursor.chunk.size() || produced == limit) {
+          break;
+        }
+        replay(winner);
+        if (m_tree[0] != winner) {
+          replayed = true;
+          break;
+        }
+      }
+
+      for (size_t c = 0; c < columns; ++c) {
+        output.column(c).append_range(cursor.chunk.column(c), start,
+                                      cursor.row - start);
+      }
+      output.set_size(output.size() + cursor.row - start);
+
+      if (!replayed) {
+        if (cursor.row == cursor.chunk.size()) {
+          if (auto status = load(cursor); !status) {
+            return tl::unexpected(status.error());
+          }
+        }
+        replay(winner);
+      }
+    }
+
+    return produced;
+  }
+
+private:
+  struct Cursor {
+    PartitionBuffer run;
+    DataChunk chunk;
+    size_t row;
+    bool done;
+  };
+
+  [[nodiscard]] error::VoidResult load(Cursor &cursor) {
+    cursor.row = 0;
+    while (true) {
+      auto more = cursor.run.read(cursor.chunk);
+      if (!more) {
+        return tl::unexpected(more.error());
+      }
+      if (!*more) {
+        cursor.done = true;
+        return error::ok();
+      }
+      if (!cursor.chunk.empty()) {
+        return error::ok();
+      }
+    }
+  }
+
+  [[nodiscard]] bool less(size_t a, size_t b) const noexcept {
+    const auto &x = m_cursors[a];
+    const auto &y = m_cursors[b];
+    if (x.done || y.done) {
+      return x.done == y.done ? a < b : y.done;
+    }
+
+    const size_t prefix = x.chunk.column_count() - 1;
+    const int order =
+        m_order.compare(x.chunk, x.row,
+                        x.chunk.column(prefix).data<uint64_t>()[x.row],
+                        y.chunk, y.row,
+                        y.chunk.column(prefix).data<uint64_t>()[y.row]);
+    return order != 0 ? order < 0 : a < b;
+  }
+
+  /// @brief Play the matches below node, returning its winner
+  size_t play(size_t node) {
+    const size_t k = m_cursors.size();
+    if (node >= k) {
+      return node - k;
+    }
+
+    const size_t left = play(2 * node);
+    const size_t right = play(2 * node + 1);
+    const bool left_wins = less(left, right);
+    m_tree[node] = left_wins ? right : left;
+    return left_wins ? left : right;
+  }
+
+  /// @brief Replay the matches of the previous winner after it advanced
+  void replay(size_t run) {
+    size_t winner = run;
+    for (size_t node = (run + m_cursors.size()) / 2; node >= 1; node /= 2) {
+      if (less(m_tree[node], winner)) {
+        std::swap(m_tree[node], winner);
+      }
+    }
+    m_tree[0] = winner;
+  }
+
+  const RowOrder &m_order;
+  std::vector<Cursor> m_cursors;
+  std::vector<size_t> m_tree;
+};
+
+error::VoidResult first_error(const std::vector<error::VoidResult> &results) {
+  for (const auto &result : results) {
+    if (!result) {
+      return result;
+    }
+  }
+  return error::ok();
+}
+} // namespace
+
+/**
+ * @brief Sorted runs, then the final merge
+ *
+ * @note Runs stay in input order, so ties between runs resolve to the
+ *       earlier input row.
+ */
+class ExternalSort::State {
+public:
+  State(std::vector<SortKey> keys, const Schema &schema)
+      : order(std::move(keys), schema), layout(run_layout(schema)) {}
+
+  WorkerPool &pool = WorkerPool::shared();
+  size_t threads{1};
+  RowOrder order;
+  Schema layout;
+  std::vector<PartitionBuffer> runs;
+  std::unique_ptr<RunMerger> merger;
+
+  [[nodiscard]] size_t resident_bytes() const noexcept {
+    size_t bytes = 0;
+    for (const auto &run : runs) {
+      bytes += run.resident_bytes();
+    }
+    return bytes;
+  }
+};
+
+ExternalSort::ExternalSort(OperatorPtr child, std::vector<SortKey> keys,
+                           ExternalSortOptions options)
+    : Operator(child->schema()), m_child(std::move(child)),
+      m_keys(std::move(keys)), m_options(std::move(options)) {}
+
+ExternalSort::~ExternalSort() = default;
+
+error::VoidResult ExternalSort::enforce_budget() {
+  auto &s = *m_state;
+  const size_t budget = m_options.memory_budget;
+  const size_t resident = s.resident_bytes();
+  if (budget == 0 || resident <= budget) {
+    return error::ok();
+  }
+
+  std::vector<PartitionBuffer *> runs;
+  for (auto &run : s.runs) {
+    runs.push_back(&run);
+  }
+  return spill_largest(runs, resident - budget, m_options.spill_directory,
+                       s.pool, s.threads);
+}
+
+error::VoidResult ExternalSort::generate_runs() {
+  auto &s = *m_state;
+  const size_t budget = m_options.memory_budget;
+  bool exhausted = false;
+  while (!exhausted) {
+    // Half the budget for input, leaving room for its sorted copy; at
+    // least one chunk, however small the budget
+    std::vector<DataChunk> batch;
+    size_t rows = 0;
+    size_t bytes = 0;
+    while (rows < s.threads * RUN_ROWS &&
+           (budget == 0 || batch.empty() || bytes < budget / 2)) {
+      DataChunk chunk;
+      auto more = m_child->next(chunk);
+      if (!more) {
+        return tl::unexpected(more.error());
+      }
+      if (!*more) {
+        exhausted = true;
+        break;
+      }
+      rows += chunk.size();
+      bytes += chunk.memory_usage();
+      batch.push_back(std::move(chunk));
+    }
+    if (batch.empty()) {
+      break;
+    }
+
+    // Contiguous slices of the batch, so runs stay in input order
+    const size_t count = std::min(batch.size(), s.threads);
+    std::vector<std::vector<DataChunk>> inputs(count);
+    for (size_t r = 0; r < count; ++r) {
+      const size_t first = r * batch.size() / count;
+      const size_t last = (r + 1) * batch.size() / count;
+      std::move(batch.begin() + first, batch.begin() + last,
+                std::back_inserter(inputs[r]));
+    }
+    batch.clear();
+
+    std::vector<PartitionBuffer> runs;
+    for (size_t r = 0; r < count; ++r) {
+      runs.emplace_back(s.layout);
+    }
+    std::vector<error::VoidResult> results(count, error::ok());
+    s.pool.parallel_for(
+        count,
+        [&](size_t r) {
+          std::vector<SortEntry> entries;
+          sort_rows(inputs[r], s.order, entries);
+          results[r] = write_run(inputs[r], entries, runs[r]);
+          inputs[r].clear();
+        },
+        s.threads);
+    if (auto status = first_error(results); !status) {
+      return status;
+    }
+
+    std::move(runs.begin(), runs.end(), std::back_inserter(s.runs));
+    if (auto status = enforce_budget(); !status) {
+      return status;
+    }
+  }
+
+  return error::ok();
+}
+
+error::VoidResult ExternalSort::reduce_runs() {
+  auto &s = *m_state;
+  while (s.runs.size() > MERGE_FAN_IN) {
+    const size_t groups = (s.runs.size() + MERGE_FAN_IN - 1) / MERGE_FAN_IN;
+    std::vector<PartitionBuffer> merged;
+    for (size_t g = 0; g < groups; ++g) {
+      merged.emplace_back(s.layout);
+    }
+
+    std::vector<error::VoidResult> results(groups, error::ok());
+    s.pool.parallel_for(
+        groups,
+        [&](size_t g) {
+          auto &result = results[g];
+          auto &target = merged[g];
+          if (m_options.memory_budget != 0) {
+            result = target.spill(m_options.spill_directory);
+            if (!result) {
+              return;
+            }
+          }
+
+          const size_t first = g * MERGE_FAN_IN;
+          const size_t last = std::min(first + MERGE_FAN_IN, s.runs.size());
+          RunMerger merger(
+              std::vector<PartitionBuffer>(
+                  std::make_move_iterator(s.runs.begin() + first),
+                  std::make_move_iterator(s.runs.begin() + last)),
+              s.order);
+          result = merger.start();
+          while (result) {
+            DataChunk chunk(s.layout);
+            auto rows = merger.next(chunk, s.layout.size(),
+                                    config::VECTOR_SIZE);
+            if (!rows) {
+              result = tl::unexpected(rows.error());
+            } else if (*rows == 0) {
+              break;
+            } else {
+              result = target.append_chunk(std::move(chunk));
+            }
+          }
+        },
+        s.threads);
+    if (auto status = first_error(results); !status) {
+      return status;
+    }
+
+    s.runs = std::move(merged);
+  }
+
+  return error::ok();
+}
+
+error::Result<bool> ExternalSort::next(DataChunk &output) {
+  if (!m_state) {
+    for (const auto &key : m_keys) {
+      if (key.column >= schema().size()) {
+        return error::error<bool>(error::ErrorCode::INVALID_ARGUMENT);
+      }
+    }
+
+    m_state = std::make_unique<State>(m_keys, schema());
+    auto &s = *m_state;
+    s.threads = m_options.threads == 0
+                    ? s.pool.concurrency()
+                    : std::min(m_options.threads, s.pool.concurrency());
+
+    auto status = generate_runs();
+    if (status) {
+      status = reduce_runs();
+    }
+    if (status) {
+      s.merger = std::make_unique<RunMerger>(std::move(s.runs), s.order);
+      s.runs.clear();
+      status = s.merger->start();
+    }
+    if (!status) {
+      m_state.reset();
+      return tl::unexpected(status.error());
+    }
+  }
+
+  prepare(output);
+  auto rows =
+      m_state->merger->next(output, schema().size(), config::VECTOR_SIZE);
+  if (!rows) {
+    return tl::unexpected(rows.error());
+  }
+  return *rows > 0;
+}
+
+void ExternalSort::reset() {
+  m_child->reset();
+  m_state.reset();
+}
+
+std::string ExternalSort::name() const {
+  return fmt::format("ExternalSort({})", describe_keys(schema(), m_keys));
+}
+
+} // namespace velox::query
@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+#include <velox/metrics/metrics.hpp>
+#include <velox/metrics/trace.hpp>
+#include <velox/query/spill.hpp>
+
+namespace velox::query {
+namespace {
+/// @brief Buffered bytes that trigger a write (and the read-ahead size)
+constexpr size_t IO_BUFFER_SIZE = 1 << 20;
+
+size_t validity_words(size_t rows) noexcept { return (rows + 63) / 64; }
+
+void put(std::vector<char> &buffer, const void *data, size_t size) {
+  const auto *bytes = static_cast<const char *>(data);
+  buffer.insert(buffer.end(), bytes, bytes + size);
+}
+
+template <typename T> void put_value(std::vector<char> &buffer, T value) {
+  put(buffer, &value, sizeof(T));
+}
+} // namespace
+
+SpillFile::SpillFile(int fd, Schema schema)
+    : m_fd(fd), m_schema(std::move(schema)) {
+  m_buffer.reserve(IO_BUFFER_SIZE);
+}
+
+SpillFile::~SpillFile() { ::close(m_fd); }
+
+error::Result<std::unique_ptr<SpillFile>>
+SpillFile::create(const std::filesystem::path &directory, Schema schema) {
+  std::error_code ec;
+  auto path = directory.empty() ? std::filesystem::temp_directory_path(ec)
+                                : directory;
+  if (ec) {
+    return error::error<std::unique_ptr<SpillFile>>(
+        error::ErrorCode::IO_ERROR);
+  }
+
+  auto name = (path / "velox-spill-XXXXXX").string();
+  const int fd = ::mkstemp(name.data());
+  if (fd < 0) {
+    return error::error<std::unique_ptr<SpillFile>>(
+        error::ErrorCode::IO_ERROR);
+  }
+  ::unlink(name.c_str());
+
+  return std::unique_ptr<SpillFile>(new SpillFile(fd, std::move(schema)));
+}
+
+error::VoidResult SpillFile::write(const DataChunk &chunk) {
+  const size_t rows = chunk.size();
+  const size_t before = m_buffer.size();
+  put_value<uint32_t>(m_buffer, static_cast<uint32_t>(rows));
+
+  for (size_t c = 0; c < m_schema.size(); ++c) {
+    const auto &column = chunk.column(c);
+    const bool nulls = column.may_have_nulls();
+    put_value<uint8_t>(m_buffer, nulls ? 1 : 0);
+    if (nulls) {
+      put(m_buffer, column.validity(),
+          validity_words(rows) * sizeof(uint64_t));
+    }
+
+    if (column.physical() != PhysicalType::VARLEN) {
+      put(m_buffer, column.data<uint8_t>(),
+          rows * physical_width(column.physical()));
+      continue;
+    }
+
+    // Offsets are rebased so the heap slice starts at zero
+    const auto offsets = column.offsets();
+    const uint32_t base = offsets[0];
+    for (auto offset : offsets) {
+      put_value<uint32_t>(m_buffer, offset - base);
+    }
+    put(m_buffer, column.heap().data() + base, offsets[rows] - base);
+  }
+
+  m_bytes += m_buffer.size() - before;
+  m_rows += rows;
+  ++m_chunks;
+  static auto &spilled =
+      metrics::global_registry().get_counter(metrics::names::QUERY_SPILL_BYTES);
+  spilled.add(m_buffer.size() - before);
+
+  return m_buffer.size() >= IO_BUFFER_SIZE ? flush() : error::ok();
+}
+
+error::VoidResult SpillFile::flush() {
+  const size_t end = m_bytes - m_buffer.size();
+  metrics::PhaseScope io(metrics::TracePhase::IO_WAIT);
+  size_t written = 0;
+  while (written < m_buffer.size()) {
+    const auto n =
+        ::pwrite(m_fd, m_buffer.data() + written, m_buffer.size() - written,
+                 static_cast<off_t>(end + written));
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return error::error<void>(errno == ENOSPC ? error::ErrorCode::DISK_FULL
+                                                : error::ErrorCode::IO_ERROR);
+    }
+    written += static_cast<size_t>(n);
+  }
+  m_buffer.clear();
+
+  return error::ok();
+}
+
+error::VoidResult SpillFile::rewind() {
+  m_read_buffer.clear();
+  m_read_position = 0;
+  m_read_offset = 0;
+
+  return flush();
+}
+
+error::VoidResult SpillFile::read_exact(void *buffer, size_t size) {
+  auto *out = static_cast<char *>(buffer);
+  while (size > 0) {
+    if (m_read_position == m_read_buffer.size()) {
+      m_read_buffer.resize(IO_BUFFER_SIZE);
+      metrics::PhaseScope io(metrics::TracePhase::IO_WAIT);
+      const auto n = ::pread(m_fd, m_read_buffer.data(), IO_BUFFER_SIZE,
+                             static_cast<off_t>(m_read_offset));
+      if (n < 0 && errno == EINTR) {
+        m_read_buffer.clear();
+        continue;
+      }
+      if (n <= 0) {
+        m_read_buffer.clear();
+        m_read_position = 0;
+        return error::error<void>(n < 0 ? error::ErrorCode::IO_ERROR
+                                        : error::ErrorCode::CORRUPTION);
+      }
+      m_read_buffer.resize(static_cast<size_t>(n));
+      m_read_position = 0;
+      m_read_offset += static_cast<size_t>(n);
+      // Let the kernel fetch the next block while this one is consumed
+      ::posix_fadvise(m_fd, static_cast<off_t>(m_read_offset), IO_BUFFER_SIZE,
+                      POSIX_FADV_WILLNEED);
+    }
+
+    const size_t take = std::min(size, m_read_buffer.size() - m_read_position);
+    std::memcpy(out, m_read_buffer.data() + m_read_position, take);
+    m_read_position += take;
+    out += take;
+    size -= take;
+  }
+
+  return error::ok();
+}
+
+error::Result<bool> SpillFile::read(DataChunk &chunk) {
+  if (!chunk.matches(m_schema)) {
+    chunk.initialize(m_schema);
+  } else {
+    chunk.clear();
+  }
+
+  const size_t consumed = m_read_offset - (m_read_buffer.size() -
+                                           m_read_position);
+  if (consumed == m_bytes) {
+    return false;
+  }
+
+  uint32_t rows = 0;
+  if (auto status = read_exact(&rows, sizeof(rows)); !status) {
+    return tl::unexpected(status.error());
+  }
+
+  std::vector<uint64_t> validity;
+  std::vector<uint32_t> offsets;
+  std::string heap;
+  for (size_t c = 0; c < m_schema.size(); ++c) {
+    auto &column = chunk.column(c);
+    uint8_t nulls = 0;
+    if (auto status = read_exact(&nulls, sizeof(nulls)); !status) {
+      return tl::unexpected(status.error());
+    }
+    if (nulls) {
+      validity.resize(validity_words(rows));
+      if (auto status =
+              read_exact(validity.data(), validity.size() * sizeof(uint64_t));
+          !status) {
+        return tl::unexpected(status.error());
+      }
+    }
+
+    if (column.physical() != PhysicalType::VARLEN) {
+      column.reserve(rows);
+      column.resize(rows);
+      if (auto status = read_exact(column.data<uint8_t>(),
+                                   rows * physical_width(column.physical()));
+          !status) {
+        return tl::unexpected(status.error());
+      }
+    } else {
+      offsets.resize(rows + 1);
+      if (auto status =
+              read_exact(offsets.data(), offsets.size() * sizeof(uint32_t));
+          !status) {
+        return tl::unexpected(status.error());
+      }
+      if (offsets[0] != 0 || !std::is_sorted(offsets.begin(), offsets.end())) {
+        return error::error<bool>(error::ErrorCode::CORRUPTION);
+      }
+      heap.resize(offsets[rows]);
+      if (auto status = read_exact(heap.data(), heap.size()); !status) {
+        return tl::unexpected(status.error());
+      }
+      for (size_t row = 0; row < rows; ++row) {
+        column.append_string(std::string_view(heap).substr(
+            offsets[row], offsets[row + 1] - offsets[row]));
+      }
+    }
+
+    if (nulls) {
+      for (size_t row = 0; row < rows; ++row) {
+        if (!((validity[row / 64] >> (row % 64)) & 1)) {
+          column.set_valid(row, false);
+        }
+      }
+    }
+  }
+  chunk.set_size(rows);
+
+  return true;
+}
+
+} // namespace velox::query
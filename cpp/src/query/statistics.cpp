@@ -0,0 +1,671 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+#include <velox/query/statistics.hpp>
+#include <velox/storage/storage_engine.hpp>
+#include <velox/utils/hash.hpp>
+
+namespace velox::query {
+namespace {
+constexpr uint8_t MIN_PRECISION = 4;
+constexpr uint8_t MAX_PRECISION = 16;
+
+/// @brief How much more often than average a most common value occurs
+constexpr double MOST_COMMON_FACTOR = 1.25;
+
+constexpr uint32_t COLLECTOR_MAGIC = 0x53545356; // "VSTS"
+constexpr uint32_t COLLECTOR_VERSION = 1;
+constexpr uint32_t METADATA_MAGIC = 0x4154454d; // "META"
+
+/// @brief Magic and payload length at the start of each METADATA page
+constexpr size_t METADATA_HEADER_SIZE = 2 * sizeof(uint32_t);
+constexpr size_t METADATA_CAPACITY =
+    storage::config::PAGE_DATA_SIZE - METADATA_HEADER_SIZE;
+
+/// @brief Hand out a TableStatistics::version no other statistics have
+uint64_t next_version() noexcept {
+  static std::atomic<uint64_t> version{0};
+  return version.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+/// @brief Numeric value of a row; nullopt for BOOL and VARLEN columns
+std::optional<double> number_at(const ColumnVector &column, size_t row) {
+  if (column.physical() == PhysicalType::BOOL ||
+      column.physical() == PhysicalType::VARLEN) {
+    return std::nullopt;
+  }
+
+  return dispatch_fixed(column.physical(), [&](auto tag) {
+    using T = typename decltype(tag)::type;
+    return static_cast<double>(column.data<T>()[row]);
+  });
+}
+
+void put(std::vector<uint8_t> &buffer, const void *data, size_t size) {
+  const auto *bytes = static_cast<const uint8_t *>(data);
+  buffer.insert(buffer.end(), bytes, bytes + size);
+}
+
+template <typename T> void put_value(std::vector<uint8_t> &buffer, T value) {
+  put(buffer, &value, sizeof(T));
+}
+
+void put_number(std::vector<uint8_t> &buffer,
+                const std::optional<double> &number) {
+  put_value<uint8_t>(buffer, number ? 1 : 0);
+  put_value<double>(buffer, number.value_or(0));
+}
+
+/// @brief Bounds-checked cursor over serialized bytes
+class Reader {
+public:
+  explicit Reader(std::span<const uint8_t> bytes) : m_bytes(bytes) {}
+
+  template <typename T> [[nodiscard]] bool get(T &value) noexcept {
+    if (m_bytes.size() - m_position < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, m_bytes.data() + m_position, sizeof(T));
+    m_position += sizeof(T);
+    return true;
+  }
+
+  [[nodiscard]] bool get_number(std::optional<double> &number) noexcept {
+    uint8_t present = 0;
+    double value = 0;
+    if (!get(present) || !get(value)) {
+      return false;
+    }
+    number = present ? std::optional<double>(value) : std::nullopt;
+    return true;
+  }
+
+  [[nodiscard]] std::optional<std::span<const uint8_t>>
+  take(size_t size) noexcept {
+    if (m_bytes.size() - m_position < size) {
+      return std::nullopt;
+    }
+    auto bytes = m_bytes.subspan(m_position, size);
+    m_position += size;
+    return bytes;
+  }
+
+  /// @brief Check that a count of items of a given size can still follow
+  [[nodiscard]] bool fits(uint64_t count, size_t size) const noexcept {
+    return count <= (m_bytes.size() - m_position) / size;
+  }
+
+  [[nodiscard]] bool done() const noexcept {
+    return m_position == m_bytes.size();
+  }
+
+private:
+  std::span<const uint8_t> m_bytes;
+  size_t m_position{0};
+};
+
+void put_column(std::vector<uint8_t> &buffer,
+                const ColumnStatistics &column) {
+  put_value<uint8_t>(buffer, static_cast<uint8_t>(column.type.type_id));
+  put_value<uint64_t>(buffer, column.type.max_length);
+  put_value<uint8_t>(buffer, column.type.precision);
+  put_value<uint8_t>(buffer, column.type.scale);
+  put_value<double>(buffer, column.distinct);
+  put_value<double>(buffer, column.null_fraction);
+  put_number(buffer, column.min);
+  put_number(buffer, column.max);
+
+  put_value<uint64_t>(buffer, column.histogram.size());
+  put(buffer, column.histogram.data(),
+      column.histogram.size() * sizeof(double));
+
+  put_value<uint64_t>(buffer, column.most_common.size());
+  for (const auto &value : column.most_common) {
+    put_value<uint64_t>(buffer, value.hash);
+    put_number(buffer, value.number);
+    put_value<double>(buffer, value.frequency);
+  }
+}
+
+bool get_column(Reader &reader, ColumnStatistics &column) {
+  uint8_t type_id = 0;
+  uint64_t max_length = 0;
+  if (!reader.get(type_id) || !reader.get(max_length) ||
+      !reader.get(column.type.precision) || !reader.get(column.type.scale) ||
+      !reader.get(column.distinct) || !reader.get(column.null_fraction) ||
+      !reader.get_number(column.min) || !reader.get_number(column.max)) {
+    return false;
+  }
+  column.type.type_id = static_cast<dtypes::TypeId>(type_id);
+  column.type.max_length = static_cast<size_t>(max_length);
+
+  uint64_t buckets = 0;
+  if (!reader.get(buckets) || !reader.fits(buckets, sizeof(double))) {
+    return false;
+  }
+  column.histogram.resize(buckets);
+  for (auto &bound : column.histogram) {
+    if (!reader.get(bound)) {
+      return false;
+    }
+  }
+
+  uint64_t common = 0;
+  if (!reader.get(common) || !reader.fits(common, 2 * sizeof(uint64_t))) {
+    return false;
+  }
+  column.most_common.resize(common);
+  for (auto &value : column.most_common) {
+    if (!reader.get(value.hash) || !reader.get_number(value.number) ||
+        !reader.get(value.frequency)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+} // namespace
+
+TableStatistics zone_statistics(const ColumnarTable &table) {
+  TableStatistics statistics;
+  statistics.rows = static_cast<double>(table.row_count());
+  statistics.columns.resize(table.schema().size());
+  for (size_t c = 0; c < table.schema().size(); ++c) {
+    statistics.columns[c].type = table.schema()[c].type;
+  }
+  if (table.row_count() == 0) {
+    return statistics;
+  }
+
+  for (size_t c = 0; c < table.schema().size(); ++c) {
+    uint64_t nulls = 0;
+    for (size_t chunk = 0; chunk < table.chunk_count(); ++chunk) {
+      nulls += table.zone(chunk, c).nulls;
+    }
+    statistics.columns[c].null_fraction =
+        static_cast<double>(nulls) / statistics.rows;
+  }
+
+  return statistics;
+}
+
+std::optional<StatisticsKey> statistics_key(const dtypes::TypeInfo &type,
+                                            const dtypes::Value &value) {
+  if (std::holds_alternative<std::nullptr_t>(value)) {
+    return std::nullopt;
+  }
+
+  ColumnVector converted(type.type_id == dtypes::TypeId::NULL_TYPE
+                             ? dtypes::TypeInfo(dtypes::TypeId::DOUBLE)
+                             : type,
+                         1);
+  if (!converted.append_value(value) || !converted.is_valid(0)) {
+    return std::nullopt;
+  }
+
+  uint64_t hash = 0;
+  converted.hash(std::span<uint64_t>(&hash, 1), false);
+  return StatisticsKey{hash, number_at(converted, 0)};
+}
+
+// HyperLogLog
+
+HyperLogLog::HyperLogLog(uint8_t precision)
+    : m_precision(std::clamp(precision, MIN_PRECISION, MAX_PRECISION)),
+      m_registers(size_t{1} << m_precision, 0) {}
+
+std::optional<HyperLogLog>
+HyperLogLog::from_registers(std::span<const uint8_t> registers) {
+  if (!std::has_single_bit(registers.size()) ||
+      registers.size() < (size_t{1} << MIN_PRECISION) ||
+      registers.size() > (size_t{1} << MAX_PRECISION)) {
+    return std::nullopt;
+  }
+
+  HyperLogLog sketch(
+      static_cast<uint8_t>(std::countr_zero(registers.size())));
+  std::copy(registers.begin(), registers.end(), sketch.m_registers.begin());
+  return sketch;
+}
+
+void HyperLogLog::add(uint64_t hash) noexcept {
+  // The high bits pick the register, the rest give the rank
+  const size_t index = hash >> (64 - m_precision);
+  const uint64_t rest = hash << m_precision;
+  const auto rank = static_cast<uint8_t>(
+      rest == 0 ? 64 - m_precision + 1 : std::countl_zero(rest) + 1);
+  m_registers[index] = std::max(m_registers[index], rank);
+}
+
+void HyperLogLog::merge(const HyperLogLog &other) noexcept {
+  if (other.m_precision != m_precision) {
+    return;
+  }
+
+  for (size_t i = 0; i < m_registers.size(); ++i) {
+    m_registers[i] = std::max(m_registers[i], other.m_registers[i]);
+  }
+}
+
+double HyperLogLog::estimate() const noexcept {
+  const auto m = static_cast<double>(m_registers.size());
+  double sum = 0;
+  size_t zeros = 0;
+  for (auto rank : m_registers) {
+    sum += std::ldexp(1.0, -static_cast<int>(rank));
+    zeros += rank == 0 ? 1 : 0;
+  }
+
+  const double alpha = m_precision == 4   ? 0.673
+                       : m_precision == 5 ? 0.697
+                       : m_precision == 6 ? 0.709
+                                          : 0.7213 / (1 + 1.079 / m);
+  const double raw = alpha * m * m / sum;
+  if (raw <= 2.5 * m && zeros > 0) {
+    return m * std::log(m / static_cast<double>(zeros));
+  }
+  return raw;
+}
+
+// StatisticsCollector
+
+StatisticsCollector::StatisticsCollector(AnalyzeOptions options)
+    : m_options(options) {}
+
+const TableStatistics &
+StatisticsCollector::refresh(const ColumnarTable &table) {
+  const size_t width = table.schema().size();
+  if (table.row_count() < m_rows || m_sketches.size() != width) {
+    m_rows = 0;
+    m_offered = 0;
+    m_sample.clear();
+    m_sketches.assign(width, HyperLogLog(m_options.sketch_precision));
+    m_nulls.assign(width, 0);
+    m_min.assign(width, std::nullopt);
+    m_max.assign(width, std::nullopt);
+  }
+
+  // Sketch only the rows appended since the last refresh
+  std::vector<uint64_t> hashes(config::VECTOR_SIZE);
+  while (m_rows < table.row_count()) {
+    const size_t index = m_rows / config::VECTOR_SIZE;
+    const size_t first = m_rows % config::VECTOR_SIZE;
+    const auto &chunk = table.chunk(index);
+    for (size_t c = 0; c < width; ++c) {
+      const auto &column = chunk.column(c);
+      column.hash(std::span<uint64_t>(hashes.data(), chunk.size()), false);
+      for (size_t row = first; row < chunk.size(); ++row) {
+        if (!column.is_valid(row)) {
+          ++m_nulls[c];
+          continue;
+        }
+        m_sketches[c].add(hashes[row]);
+        if (const auto number = number_at(column, row)) {
+          m_min[c] = std::min(m_min[c].value_or(*number), *number);
+          m_max[c] = std::max(m_max[c].value_or(*number), *number);
+        }
+      }
+    }
+    m_rows = index * config::VECTOR_SIZE + chunk.size();
+  }
+
+  sample_chunks(table.row_count() / config::VECTOR_SIZE);
+  rebuild(table);
+  return m_statistics;
+}
+
+/// @note Reservoir sampling over whole chunks; the slot a chunk may take
+///       is a hash of its index, so refreshes need no generator state.
+void StatisticsCollector::sample_chunks(size_t full_chunks) {
+  const size_t capacity = std::max<size_t>(m_options.sample_chunks, 1);
+  for (; m_offered < full_chunks; ++m_offered) {
+    if (m_sample.size() < capacity) {
+      m_sample.push_back(m_offered);
+      continue;
+    }
+    const size_t slot =
+        utils::hash::mix64(m_options.seed ^ m_offered) % (m_offered + 1);
+    if (slot < capacity) {
+      m_sample[slot] = m_offered;
+    }
+  }
+}
+
+void StatisticsCollector::rebuild(const ColumnarTable &table) {
+  const auto &schema = table.schema();
+  const double rows = static_cast<double>(table.row_count());
+
+  // The partial last chunk is never in the reservoir; always read it
+  auto chunks = m_sample;
+  if (table.row_count() % config::VECTOR_SIZE != 0) {
+    chunks.push_back(table.chunk_count() - 1);
+  }
+  size_t sampled_rows = 0;
+  for (auto index : chunks) {
+    sampled_rows += table.chunk(index).size();
+  }
+
+  struct Count {
+    size_t count{0};
+    std::optional<double> number;
+  };
+  std::unordered_map<uint64_t, Count> counts;
+  std::vector<std::pair<uint64_t, std::optional<double>>> values;
+  std::vector<uint64_t> hashes(config::VECTOR_SIZE);
+
+  m_statistics.rows = rows;
+  m_statistics.version = next_version();
+  m_statistics.columns.assign(schema.size(), ColumnStatistics{});
+  for (size_t c = 0; c < schema.size(); ++c) {
+    auto &column = m_statistics.columns[c];
+    column.type = schema[c].type;
+    if (rows == 0) {
+      continue;
+    }
+
+    const double nulls = static_cast<double>(m_nulls[c]);
+    column.null_fraction = nulls / rows;
+    column.distinct = std::min(m_sketches[c].estimate(), rows - nulls);
+    column.min = m_min[c];
+    column.max = m_max[c];
+
+    counts.clear();
+    values.clear();
+    for (auto index : chunks) {
+      const auto &source = table.chunk(index).column(c);
+      source.hash(std::span<uint64_t>(hashes.data(), source.size()), false);
+      for (size_t row = 0; row < source.size(); ++row) {
+        if (!source.is_valid(row)) {
+          continue;
+        }
+        auto number = number_at(source, row);
+        auto &count = counts[hashes[row]];
+        ++count.count;
+        count.number = number;
+        values.emplace_back(hashes[row], number);
+      }
+    }
+    if (values.empty()) {
+      continue;
+    }
+
+    // Values clearly more frequent than the average sampled value
+    const double average = static_cast<double>(values.size()) /
+                           static_cast<double>(counts.size());
+    std::vector<std::pair<uint64_t, Count>> common;
+    for (const auto &[hash, count] : counts) {
+      if (count.count >= 2 &&
+          static_cast<double>(count.count) > MOST_COMMON_FACTOR * average) {
+        common.emplace_back(hash, count);
+      }
+    }
+    std::sort(common.begin(), common.end(), [](const auto &a, const auto &b) {
+      return a.second.count != b.second.count
+                 ? a.second.count > b.second.count
+                 : a.first < b.first;
+    });
+    common.resize(std::min(common.size(), m_options.most_common));
+
+    std::unordered_set<uint64_t> common_hashes;
+    for (const auto &[hash, count] : common) {
+      column.most_common.push_back(
+          {hash, count.number,
+           static_cast<double>(count.count) /
+               static_cast<double>(sampled_rows)});
+      common_hashes.insert(hash);
+    }
+
+    // Equi-depth histogram over the remaining numeric values
+    std::vector<double> numbers;
+    for (const auto &[hash, number] : values) {
+      if (number && !common_hashes.contains(hash)) {
+        numbers.push_back(*number);
+      }
+    }
+    if (numbers.size() < 2 || m_options.histogram_buckets == 0) {
+      continue;
+    }
+    std::sort(numbers.begin(), numbers.end());
+    const size_t buckets =
+        std::min(m_options.histogram_buckets, numbers.size() - 1);
+    column.histogram.reserve(buckets + 1);
+    for (size_t b = 0; b <= buckets; ++b) {
+      column.histogram.push_back(numbers[b * (numbers.size() - 1) / buckets]);
+    }
+
+    // The outer buckets reach the exact extremes the sample may miss
+    if (column.min && column.max) {
+      auto &bounds = column.histogram;
+      bounds.front() = std::min(bounds.front(), *column.min);
+      bounds.back() = std::max(bounds.back(), *column.max);
+    }
+  }
+}
+
+std::vector<uint8_t> StatisticsCollector::serialize() const {
+  std::vector<uint8_t> buffer;
+  put_value<uint32_t>(buffer, COLLECTOR_MAGIC);
+  put_value<uint32_t>(buffer, COLLECTOR_VERSION);
+
+  put_value<uint64_t>(buffer, m_options.sample_chunks);
+  put_value<uint64_t>(buffer, m_options.histogram_buckets);
+  put_value<uint64_t>(buffer, m_options.most_common);
+  put_value<uint8_t>(buffer, m_options.sketch_precision);
+  put_value<uint64_t>(buffer, m_options.seed);
+
+  put_value<uint64_t>(buffer, m_rows);
+  put_value<uint64_t>(buffer, m_offered);
+  put_value<uint64_t>(buffer, m_sample.size());
+  for (auto index : m_sample) {
+    put_value<uint64_t>(buffer, index);
+  }
+
+  put_value<uint64_t>(buffer, m_sketches.size());
+  for (size_t c = 0; c < m_sketches.size(); ++c) {
+    put_value<uint64_t>(buffer, m_nulls[c]);
+    put_number(buffer, m_min[c]);
+    put_number(buffer, m_max[c]);
+    put_value<uint64_t>(buffer, m_sketches[c].registers().size());
+    put(buffer, m_sketches[c].registers().data(),
+        m_sketches[c].registers().size());
+  }
+
+  put_value<double>(buffer, m_statistics.rows);
+  put_value<uint64_t>(buffer, m_statistics.columns.size());
+  for (const auto &column : m_statistics.columns) {
+    put_column(buffer, column);
+  }
+
+  return buffer;
+}
+
+error::Result<StatisticsCollector>
+StatisticsCollector::deserialize(std::span<const uint8_t> bytes) {
+  auto corrupt = [] {
+    return error::error<StatisticsCollector>(error::ErrorCode::CORRUPTION);
+  };
+
+  Reader reader(bytes);
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  if (!reader.get(magic) || !reader.get(version) ||
+      magic != COLLECTOR_MAGIC || version != COLLECTOR_VERSION) {
+    return corrupt();
+  }
+
+  AnalyzeOptions options;
+  uint64_t sample_chunks = 0;
+  uint64_t histogram_buckets = 0;
+  uint64_t most_common = 0;
+  if (!reader.get(sample_chunks) || !reader.get(histogram_buckets) ||
+      !reader.get(most_common) || !reader.get(options.sketch_precision) ||
+      !reader.get(options.seed)) {
+    return corrupt();
+  }
+  options.sample_chunks = static_cast<size_t>(sample_chunks);
+  options.histogram_buckets = static_cast<size_t>(histogram_buckets);
+  options.most_common = static_cast<size_t>(most_common);
+
+  StatisticsCollector collector(options);
+  uint64_t rows = 0;
+  uint64_t offered = 0;
+  uint64_t sampled = 0;
+  if (!reader.get(rows) || !reader.get(offered) || !reader.get(sampled) ||
+      !reader.fits(sampled, sizeof(uint64_t))) {
+    return corrupt();
+  }
+  collector.m_rows = static_cast<size_t>(rows);
+  collector.m_offered = static_cast<size_t>(offered);
+  collector.m_sample.resize(sampled);
+  for (auto &index : collector.m_sample) {
+    uint64_t value = 0;
+    if (!reader.get(value) || value >= offered) {
+      return corrupt();
+    }
+    index = static_cast<size_t>(value);
+  }
+
+  uint64_t width = 0;
+  if (!reader.get(width) || !reader.fits(width, 2 * sizeof(uint64_t))) {
+    return corrupt();
+  }
+  collector.m_nulls.resize(width);
+  collector.m_min.resize(width);
+  collector.m_max.resize(width);
+  for (uint64_t c = 0; c < width; ++c) {
+    uint64_t size = 0;
+    if (!reader.get(collector.m_nulls[c]) ||
+        !reader.get_number(collector.m_min[c]) ||
+        !reader.get_number(collector.m_max[c]) || !reader.get(size)) {
+      return corrupt();
+    }
+    auto registers = reader.take(static_cast<size_t>(size));
+    auto sketch = registers ? HyperLogLog::from_registers(*registers)
+                            : std::nullopt;
+    if (!sketch) {
+      return corrupt();
+    }
+    collector.m_sketches.push_back(std::move(*sketch));
+  }
+
+  uint64_t columns = 0;
+  if (!reader.get(collector.m_statistics.rows) || !reader.get(columns) ||
+      !reader.fits(columns, sizeof(double))) {
+    return corrupt();
+  }
+  collector.m_statistics.columns.resize(columns);
+  for (auto &column : collector.m_statistics.columns) {
+    if (!get_column(reader, column)) {
+      return corrupt();
+    }
+  }
+  if (!reader.done()) {
+    return corrupt();
+  }
+  collector.m_statistics.version = next_version();
+
+  return collector;
+}
+
+TableStatistics analyze(const ColumnarTable &table, AnalyzeOptions options) {
+  StatisticsCollector collector(options);
+  return collector.refresh(table);
+}
+
+// METADATA pages
+
+size_t metadata_pages(size_t bytes) noexcept {
+  return std::max<size_t>(1, (bytes + METADATA_CAPACITY - 1) /
+                                 METADATA_CAPACITY);
+}
+
+error::VoidResult write_metadata(std::span<const uint8_t> payload,
+                                 std::span<storage::Page *const> pages) {
+  if (pages.size() != metadata_pages(payload.size()) ||
+      std::find(pages.begin(), pages.end(), nullptr) != pages.end()) {
+    return error::error<void>(error::ErrorCode::INVALID_ARGUMENT);
+  }
+
+  for (size_t i = 0; i < pages.size(); ++i) {
+    auto &page = *pages[i];
+    const auto lock = page.write_lock();
+    const size_t offset = i * METADATA_CAPACITY;
+    const auto length = static_cast<uint32_t>(
+        std::min(METADATA_CAPACITY, payload.size() - offset));
+
+    auto &header = page.header();
+    header.page_type = storage::PageType::METADATA;
+    header.next_page = i + 1 < pages.size() ? pages[i + 1]->id()
+                                            : storage::config::INVALID_PAGE_ID;
+    header.prev_page =
+        i > 0 ? pages[i - 1]->id() : storage::config::INVALID_PAGE_ID;
+    header.record_count = 0;
+    header.free_space_offset =
+        static_cast<uint32_t>(METADATA_HEADER_SIZE + length);
+    header.free_space_size = static_cast<uint32_t>(
+        storage::config::PAGE_DATA_SIZE - header.free_space_offset);
+
+    auto data = page.data();
+    std::memcpy(data.data(), &METADATA_MAGIC, sizeof(uint32_t));
+    std::memcpy(data.data() + sizeof(uint32_t), &length, sizeof(uint32_t));
+    std::memcpy(data.data() + METADATA_HEADER_SIZE, payload.data() + offset,
+                length);
+    std::fill(data.begin() + static_cast<ptrdiff_t>(header.free_space_offset),
+              data.end(), uint8_t{0});
+
+    header.update_checksum();
+    page.mark_dirty();
+  }
+
+  return error::ok();
+}
+
+error::Result<std::vector<uint8_t>>
+read_metadata(std::span<const storage::Page *const> pages) {
+  auto corrupt = [] {
+    return error::error<std::vector<uint8_t>>(error::ErrorCode::CORRUPTION);
+  };
+  if (pages.empty()) {
+    return corrupt();
+  }
+
+  std::vector<uint8_t> payload;
+  for (size_t i = 0; i < pages.size(); ++i) {
+    if (pages[i] == nullptr) {
+      return corrupt();
+    }
+    const auto &page = *pages[i];
+    const auto lock = page.read_lock();
+    const auto &header = page.header();
+    const auto next = i + 1 < pages.size() && pages[i + 1] != nullptr
+                          ? pages[i + 1]->id()
+                          : storage::config::INVALID_PAGE_ID;
+    const auto prev =
+        i > 0 ? pages[i - 1]->id() : storage::config::INVALID_PAGE_ID;
+    if (header.page_type != storage::PageType::METADATA ||
+        header.next_page != next || header.prev_page != prev ||
+        !header.verify_checksum()) {
+      return corrupt();
+    }
+
+    const auto data = page.data();
+    uint32_t magic = 0;
+    uint32_t length = 0;
+    std::memcpy(&magic, data.data(), sizeof(uint32_t));
+    std::memcpy(&length, data.data() + sizeof(uint32_t), sizeof(uint32_t));
+    if (magic != METADATA_MAGIC || length > METADATA_CAPACITY ||
+        (i + 1 < pages.size() && length != METADATA_CAPACITY)) {
+      return corrupt();
+    }
+    payload.insert(payload.end(), data.begin() + METADATA_HEADER_SIZE,
+                   data.begin() + METADATA_HEADER_SIZE + length);
+  }
+
+  return payload;
+}
+
+} // namespace velox::query
@@ -0,0 +1,424 @@
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <string>
+#include <velox/query/kernels.hpp>
+
+#if (defined(__GNUC__) || defined(__clang__)) &&                              \
+    (defined(__x86_64__) || defined(__i386__))
+#define VELOX_KERNELS_X86 1
+#include <immintrin.h>
+
+#define VELOX_TARGET_AVX2 __attribute__((target("avx2")))
+#define VELOX_TARGET_AVX512                                                    \
+  __attribute__((target("avx512f,avx512bw,avx512vl,avx2")))
+#endif
+
+namespace velox::query::kernels {
+namespace {
+constexpr char fold(char c) noexcept {
+  return c >= 'A' && c <= 'Z' ? static_cast<char>(c | 0x20) : c;
+}
+
+constexpr uint64_t lane_mask(size_t lanes) noexcept {
+  return lanes >= 64 ? ~uint64_t{0} : (uint64_t{1} << lanes) - 1;
+}
+
+void clear_bitmap(uint64_t *bitmap, size_t rows) noexcept {
+  std::fill(bitmap, bitmap + bitmap_words(rows), uint64_t{0});
+}
+
+void fill_bitmap(uint64_t *bitmap, size_t rows) noexcept {
+  std::fill(bitmap, bitmap + bitmap_words(rows), ~uint64_t{0});
+  if (rows % 64 != 0) {
+    bitmap[rows / 64] = lane_mask(rows % 64);
+  }
+}
+
+#ifdef VELOX_KERNELS_X86
+/// @brief Lowercase the ASCII letters of 32 bytes (bytes >= 0x80 compare
+///        as negative, so they never fall in 'A'..'Z')
+VELOX_TARGET_AVX2 __m256i avx2_fold(__m256i x) noexcept {
+  const auto upper =
+      _mm256_and_si256(_mm256_cmpgt_epi8(x, _mm256_set1_epi8('A' - 1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), x));
+  return _mm256_or_si256(x, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+
+VELOX_TARGET_AVX512 __m512i avx512_fold(__m512i x) noexcept {
+  const auto upper = _mm512_cmplt_epu8_mask(
+      _mm512_sub_epi8(x, _mm512_set1_epi8('A')), _mm512_set1_epi8(26));
+  return _mm512_mask_add_epi8(x, upper, x, _mm512_set1_epi8(0x20));
+}
+
+/// @brief Compare bytes with a lowercased pattern, 32 at a time
+VELOX_TARGET_AVX2 bool avx2_equal_folded(const char *text,
+                                         const char *lowered,
+                                         size_t n) noexcept {
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const auto a = avx2_fold(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + i)));
+    const auto b =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lowered + i));
+    if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)) != -1) {
+      return false;
+    }
+  }
+  for (; i < n; ++i) {
+    if (fold(text[i]) != lowered[i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * @brief Mark rows whose length passes, 64 rows per bitmap word
+ *
+ * @note Lengths are adjacent offset differences, so two unaligned loads
+ *       give eight of them. Unsigned max tests >= without a sign flip.
+ */
+VELOX_TARGET_AVX2 void avx2_lengths(const uint32_t *offsets, size_t words,
+                                    uint32_t length, bool exact,
+                                    uint64_t *bitmap) noexcept {
+  const auto target = _mm256_set1_epi32(static_cast<int>(length));
+  for (size_t w = 0; w < words; ++w) {
+    uint64_t bits = 0;
+    for (size_t j = 0; j < 64; j += 8) {
+      const uint32_t *p = offsets + w * 64 + j;
+      const auto lengths = _mm256_sub_epi32(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 1)),
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)));
+      const auto pass =
+          exact ? _mm256_cmpeq_epi32(lengths, target)
+                : _mm256_cmpeq_epi32(_mm256_max_epu32(lengths, target),
+                                     lengths);
+      bits |= static_cast<uint64_t>(static_cast<uint32_t>(
+                  _mm256_movemask_ps(_mm256_castsi256_ps(pass))))
+              << j;
+    }
+    bitmap[w] = bits;
+  }
+}
+
+VELOX_TARGET_AVX512 void avx512_lengths(const uint32_t *offsets,
+                                        size_t words, uint32_t length,
+                                        bool exact,
+                                        uint64_t *bitmap) noexcept {
+  const auto target = _mm512_set1_epi32(static_cast<int>(length));
+  for (size_t w = 0; w < words; ++w) {
+    uint64_t bits = 0;
+    for (size_t j = 0; j < 64; j += 16) {
+      const uint32_t *p = offsets + w * 64 + j;
+      const auto lengths =
+          _mm512_sub_epi32(_mm512_loadu_si512(p + 1), _mm512_loadu_si512(p));
+      const __mmask16 pass =
+          exact ? _mm512_cmpeq_epu32_mask(lengths, target)
+                : _mm512_cmpge_epu32_mask(lengths, target);
+      bits |= static_cast<uint64_t>(pass) << j;
+    }
+    bitmap[w] = bits;
+  }
+}
+
+/// @brief Positions among 32 whose first and last pattern bytes match
+struct Avx2Probe {
+  static constexpr size_t WIDTH = 32;
+
+  VELOX_TARGET_AVX2 static uint64_t find(const char *p, size_t last_offset,
+                                         char first, char last,
+                                         bool ignore_case) noexcept {
+    auto head = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    auto tail = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(p + last_offset));
+    if (ignore_case) {
+      head = avx2_fold(head);
+      tail = avx2_fold(tail);
+    }
+    const auto hits =
+        _mm256_and_si256(_mm256_cmpeq_epi8(head, _mm256_set1_epi8(first)),
+                         _mm256_cmpeq_epi8(tail, _mm256_set1_epi8(last)));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+  }
+};
+
+/// @brief Positions among 64 whose first and last pattern bytes match
+struct Avx512Probe {
+  static constexpr size_t WIDTH = 64;
+
+  VELOX_TARGET_AVX512 static uint64_t find(const char *p, size_t last_offset,
+                                           char first, char last,
+                                           bool ignore_case) noexcept {
+    auto head = _mm512_loadu_si512(p);
+    auto tail = _mm512_loadu_si512(p + last_offset);
+    if (ignore_case) {
+      head = avx512_fold(head);
+      tail = avx512_fold(tail);
+    }
+    return _mm512_cmpeq_epi8_mask(head, _mm512_set1_epi8(first)) &
+           _mm512_cmpeq_epi8_mask(tail, _mm512_set1_epi8(last));
+  }
+};
+#endif
+
+bool equal_bytes(const char *text, const char *pattern, size_t n,
+                 bool ignore_case) noexcept {
+  if (!ignore_case) {
+    return std::memcmp(text, pattern, n) == 0;
+  }
+
+#ifdef VELOX_KERNELS_X86
+  if (n >= 32 && simd_level() != SimdLevel::SCALAR) {
+    return avx2_equal_folded(text, pattern, n);
+  }
+#endif
+  for (size_t i = 0; i < n; ++i) {
+    if (fold(text[i]) != pattern[i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/// @brief Mark the rows of length == length (exact) or >= length
+void filter_lengths(std::span<const uint32_t> offsets, uint32_t length,
+                    bool exact, uint64_t *bitmap) noexcept {
+  const size_t n = offsets.size() - 1;
+  size_t done = 0;
+
+#ifdef VELOX_KERNELS_X86
+  switch (simd_level()) {
+  case SimdLevel::AVX512:
+    done = n / 64;
+    avx512_lengths(offsets.data(), done, length, exact, bitmap);
+    break;
+  case SimdLevel::AVX2:
+    done = n / 64;
+    avx2_lengths(offsets.data(), done, length, exact, bitmap);
+    break;
+  case SimdLevel::SCALAR:
+    break;
+  }
+#endif
+
+  for (size_t w = done; w < bitmap_words(n); ++w) {
+    const size_t base = w * 64;
+    const size_t count = std::min<size_t>(64, n - base);
+    uint64_t bits = 0;
+    for (size_t j = 0; j < count; ++j) {
+      const uint32_t size = offsets[base + j + 1] - offsets[base + j];
+      bits |= static_cast<uint64_t>(exact ? size == length : size >= length)
+              << j;
+    }
+    bitmap[w] = bits;
+  }
+}
+
+/// @brief Maps substring hits in the heap back to the rows holding them
+class ContainsScan {
+public:
+  ContainsScan(std::span<const uint32_t> offsets, const char *heap,
+               std::string_view pattern, bool ignore_case,
+               uint64_t *bitmap) noexcept
+      : m_offsets(offsets), m_heap(heap), m_pattern(pattern),
+        m_ignore_case(ignore_case), m_bitmap(bitmap) {}
+
+  /**
+   * @brief Verify a position whose first and last bytes match
+   *
+   * @param position Heap position, never below an earlier one
+   * @return Next position worth testing: past the row on a match or
+   *         when the pattern would straddle the row end
+   */
+  size_t verify(size_t position) noexcept {
+    while (m_offsets[m_row + 1] <= position) {
+      ++m_row;
+    }
+
+    const size_t row_end = m_offsets[m_row + 1];
+    if (position + m_pattern.size() > row_end) {
+      return row_end;
+    }
+    if (m_pattern.size() > 2 &&
+        !equal_bytes(m_heap + position + 1, m_pattern.data() + 1,
+                     m_pattern.size() - 2, m_ignore_case)) {
+      return position + 1;
+    }
+
+    m_bitmap[m_row / 64] |= uint64_t{1} << (m_row % 64);
+    return row_end;
+  }
+
+private:
+  std::span<const uint32_t> m_offsets;
+  const char *m_heap;
+  std::string_view m_pattern;
+  bool m_ignore_case;
+  uint64_t *m_bitmap;
+  size_t m_row{0};
+};
+
+#ifdef VELOX_KERNELS_X86
+/**
+ * @brief Scan full probe blocks of the heap
+ *
+ * @return First position not yet tested
+ * @note Only blocks whose both loads stay below end are scanned, so no
+ *       byte past the last row is read.
+ */
+template <typename Probe>
+size_t scan_blocks(const char *heap, size_t begin, size_t end,
+                   std::string_view pattern, bool ignore_case,
+                   ContainsScan &scan) noexcept {
+  const size_t last_offset = pattern.size() - 1;
+  const char first = pattern.front();
+  const char last = pattern.back();
+  size_t position = begin;
+
+  while (position + Probe::WIDTH + last_offset <= end) {
+    uint64_t hits =
+        Probe::find(heap + position, last_offset, first, last, ignore_case);
+    size_t next = position + Probe::WIDTH;
+    while (hits != 0) {
+      const size_t resume =
+          scan.verify(position + static_cast<size_t>(std::countr_zero(hits)));
+      if (resume >= position + Probe::WIDTH) {
+        next = resume;
+        break;
+      }
+      hits &= ~lane_mask(resume - position);
+    }
+    position = next;
+  }
+
+  return position;
+}
+#endif
+
+void match_contains(std::span<const uint32_t> offsets,
+                    std::span<const char> heap, std::string_view pattern,
+                    bool ignore_case, uint64_t *bitmap) noexcept {
+  const size_t n = offsets.size() - 1;
+  clear_bitmap(bitmap, n);
+
+  const size_t begin = offsets.front();
+  const size_t end = offsets.back();
+  if (end - begin < pattern.size()) {
+    return;
+  }
+
+  ContainsScan scan(offsets, heap.data(), pattern, ignore_case, bitmap);
+  size_t position = begin;
+#ifdef VELOX_KERNELS_X86
+  switch (simd_level()) {
+  case SimdLevel::AVX512:
+    position = scan_blocks<Avx512Probe>(heap.data(), begin, end, pattern,
+                                        ignore_case, scan);
+    break;
+  case SimdLevel::AVX2:
+    position = scan_blocks<Avx2Probe>(heap.data(), begin, end, pattern,
+                                      ignore_case, scan);
+    break;
+  case SimdLevel::SCALAR:
+    break;
+  }
+#endif
+
+  const size_t last_offset = pattern.size() - 1;
+  const char first = pattern.front();
+  const char last = pattern.back();
+  auto byte = [&](size_t i) {
+    return ignore_case ? fold(heap[i]) : heap[i];
+  };
+  while (position + last_offset < end) {
+    if (byte(position) == first && byte(position + last_offset) == last) {
+      position = scan.verify(position);
+    } else {
+      ++position;
+    }
+  }
+}
+} // namespace
+
+void match(std::span<const uint32_t> offsets, std::span<const char> heap,
+           StringMatch shape, std::string_view pattern, bool ignore_case,
+           uint64_t *bitmap) noexcept {
+  const size_t n = offsets.size() - 1;
+
+  std::string lowered;
+  if (ignore_case) {
+    lowered.resize(pattern.size());
+    std::transform(pattern.begin(), pattern.end(), lowered.begin(), fold);
+    pattern = lowered;
+  }
+
+  if (pattern.empty() && shape != StringMatch::EQUALS) {
+    fill_bitmap(bitmap, n);
+    return;
+  }
+  if (shape == StringMatch::CONTAINS) {
+    match_contains(offsets, heap, pattern, ignore_case, bitmap);
+    return;
+  }
+
+  const auto length = static_cast<uint32_t>(pattern.size());
+  filter_lengths(offsets, length, shape == StringMatch::EQUALS, bitmap);
+  if (pattern.empty()) {
+    return;
+  }
+
+  // Only rows of a fitting length reach the byte compare
+  for (size_t w = 0; w < bitmap_words(n); ++w) {
+    uint64_t bits = bitmap[w];
+    while (bits != 0) {
+      const size_t row = w * 64 + static_cast<size_t>(std::countr_zero(bits));
+      const size_t start = shape == StringMatch::SUFFIX
+                               ? offsets[row + 1] - length
+                               : offsets[row];
+      if (!equal_bytes(heap.data() + start, pattern.data(), length,
+                       ignore_case)) {
+        bitmap[w] &= ~(uint64_t{1} << (row % 64));
+      }
+      bits &= bits - 1;
+    }
+  }
+}
+
+size_t select_match(std::span<const uint32_t> offsets,
+                    std::span<const char> heap, StringMatch shape,
+                    std::string_view pattern, bool ignore_case,
+                    uint32_t *selection) noexcept {
+  // Offsets are absolute, so each block just views a slice of them
+  constexpr size_t BLOCK = config::VECTOR_SIZE;
+  uint64_t bitmap[bitmap_words(BLOCK)];
+  const size_t n = offsets.size() - 1;
+  size_t selected = 0;
+
+  for (size_t offset = 0; offset < n; offset += BLOCK) {
+    const size_t count = std::min(BLOCK, n - offset);
+    match(offsets.subspan(offset, count + 1), heap, shape, pattern,
+          ignore_case, bitmap);
+    const size_t block_selected =
+        to_selection(bitmap, count, selection + selected);
+    for (size_t i = selected; i < selected + block_selected; ++i) {
+      selection[i] += static_cast<uint32_t>(offset);
+    }
+    selected += block_selected;
+  }
+
+  return selected;
+}
+
+void match(const ColumnVector &column, StringMatch shape,
+           std::string_view pattern, bool ignore_case,
+           uint64_t *bitmap) noexcept {
+  match(column.offsets(), column.heap(), shape, pattern, ignore_case, bitmap);
+  if (column.may_have_nulls()) {
+    bitmap_and(bitmap, column.validity(), bitmap_words(column.size()));
+  }
+}
+
+} // namespace velox::query::kernels
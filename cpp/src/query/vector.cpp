@@ -0,0 +1,794 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <velox/query/vector.hpp>
+#include <velox/utils/hash.hpp>
+
+namespace velox::query {
+namespace {
+using utils::hash::mix64;
+
+constexpr uint64_t NULL_HASH = 0x2545f4914f6cdd1dULL;
+
+constexpr uint64_t combine_hash(uint64_t seed, uint64_t hash) noexcept {
+  return mix64(seed ^ (hash + 0x9e3779b97f4a7c15ULL + (seed << 6)));
+}
+
+int64_t int_at(const ColumnVector &vector, size_t row) noexcept {
+  return dispatch_fixed(vector.physical(), [&](auto tag) -> int64_t {
+    using T = typename decltype(tag)::type;
+    return static_cast<int64_t>(vector.data<T>()[row]);
+  });
+}
+
+double double_at(const ColumnVector &vector, size_t row) noexcept {
+  return dispatch_fixed(vector.physical(), [&](auto tag) -> double {
+    using T = typename decltype(tag)::type;
+    return static_cast<double>(vector.data<T>()[row]);
+  });
+}
+
+/// @note NaN sorts after every other value and equal to itself, the order
+///       order_prefixes() gives it.
+template <typename T> int three_way(T a, T b) noexcept {
+  if constexpr (std::is_floating_point_v<T>) {
+    const bool a_nan = std::isnan(a);
+    const bool b_nan = std::isnan(b);
+    if (a_nan || b_nan) {
+      return static_cast<int>(a_nan) - static_cast<int>(b_nan);
+    }
+  }
+  return a < b ? -1 : (b < a ? 1 : 0);
+}
+
+/// @brief Numeric payload of a Value, if it has one
+struct Numeric {
+  bool integral{true};
+  int64_t integer{0};
+  double floating{0.0};
+  uint8_t scale{0}; ///< Non-zero for DECIMAL payloads
+};
+
+std::optional<Numeric> numeric_of(const dtypes::Value &value) {
+  return std::visit(
+      [](const auto &v) -> std::optional<Numeric> {
+        using V = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<V, bool> || std::is_integral_v<V>) {
+          return Numeric{true, static_cast<int64_t>(v), 0.0, 0};
+        } else if constexpr (std::is_floating_point_v<V>) {
+          return Numeric{false, 0, static_cast<double>(v), 0};
+        } else if constexpr (std::is_same_v<V, dtypes::Decimal>) {
+          return Numeric{true, v.value, 0.0, v.scale};
+        } else {
+          return std::nullopt;
+        }
+      },
+      value);
+}
+
+int64_t rescale(int64_t value, uint8_t from, uint8_t to) noexcept {
+  return to >= from ? value * scale_factor(to - from)
+                    : value / scale_factor(from - to);
+}
+
+/// @brief Hand out a ColumnarTable id no other table has had
+uint64_t next_table_id() noexcept {
+  static std::atomic<uint64_t> id{0};
+  return id.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+} // namespace
+
+dtypes::TypeInfo type_of(const dtypes::Value &value) {
+  using dtypes::TypeId;
+
+  return std::visit(
+      [](const auto &v) -> dtypes::TypeInfo {
+        using V = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<V, std::nullptr_t>) {
+          return TypeId::NULL_TYPE;
+        } else if constexpr (std::is_same_v<V, bool>) {
+          return TypeId::BOOLEAN;
+        } else if constexpr (std::is_same_v<V, int8_t>) {
+          return TypeId::TINYINT;
+        } else if constexpr (std::is_same_v<V, int16_t>) {
+          return TypeId::SMALLINT;
+        } else if constexpr (std::is_same_v<V, int32_t>) {
+          return TypeId::INTEGER;
+        } else if constexpr (std::is_same_v<V, int64_t>) {
+          return TypeId::BIGINT;
+        } else if constexpr (std::is_same_v<V, float>) {
+          return TypeId::REAL;
+        } else if constexpr (std::is_same_v<V, double>) {
+          return TypeId::DOUBLE;
+        } else if constexpr (std::is_same_v<V, dtypes::Decimal>) {
+          return dtypes::TypeInfo(TypeId::DECIMAL, v.precision, v.scale);
+        } else if constexpr (std::is_same_v<V, std::string>) {
+          return TypeId::VARCHAR;
+        } else if constexpr (std::is_same_v<V, std::vector<uint8_t>>) {
+          return TypeId::BLOB;
+        } else if constexpr (std::is_same_v<V, dtypes::Date>) {
+          return TypeId::DATE;
+        } else if constexpr (std::is_same_v<V, dtypes::Time>) {
+          return TypeId::TIME;
+        } else if constexpr (std::is_same_v<V, dtypes::Timestamp>) {
+          return TypeId::TIMESTAMP;
+        } else {
+          return TypeId::UUID;
+        }
+      },
+      value);
+}
+
+bool same_type(const dtypes::TypeInfo &a,
+               const dtypes::TypeInfo &b) noexcept {
+  if (dtypes::is_string(a.type_id) && dtypes::is_string(b.type_id)) {
+    return true;
+  }
+
+  return a.type_id == b.type_id &&
+         (a.type_id != dtypes::TypeId::DECIMAL || a.scale == b.scale);
+}
+
+// ColumnVector
+
+ColumnVector::ColumnVector(dtypes::TypeInfo type, size_t capacity)
+    : m_type(type), m_physical(physical_type(type.type_id)) {
+  reserve(std::max<size_t>(capacity, 1));
+  if (m_physical == PhysicalType::VARLEN) {
+    m_offsets[0] = 0;
+  }
+}
+
+void ColumnVector::reset(const dtypes::TypeInfo &type) {
+  const auto physical = physical_type(type.type_id);
+  m_type = type;
+
+  if (physical != m_physical) {
+    m_physical = physical;
+    m_data.clear();
+    m_offsets.clear();
+    m_heap.clear();
+    const auto capacity = m_capacity;
+    m_capacity = 0;
+    reserve(capacity);
+  }
+  clear();
+}
+
+void ColumnVector::clear() noexcept {
+  if (m_may_have_nulls) {
+    std::fill(m_validity.begin(), m_validity.end(), ~uint64_t{0});
+    m_may_have_nulls = false;
+  }
+  if (m_physical == PhysicalType::VARLEN) {
+    m_heap.clear();
+    m_offsets[0] = 0;
+  }
+  m_size = 0;
+}
+
+void ColumnVector::reserve(size_t capacity) {
+  if (capacity <= m_capacity) {
+    return;
+  }
+
+  if (m_physical == PhysicalType::VARLEN) {
+    m_offsets.resize(capacity + 1);
+  } else {
+    m_data.resize(capacity * physical_width(m_physical));
+  }
+  grow_validity(capacity);
+  m_capacity = capacity;
+}
+
+void ColumnVector::grow_validity(size_t capacity) {
+  m_validity.resize((capacity + 63) / 64, ~uint64_t{0});
+}
+
+void ColumnVector::resize(size_t size) {
+  if (size <= m_size) {
+    for (size_t row = size; row < m_size; ++row) {
+      set_valid(row, true);
+    }
+    if (m_physical == PhysicalType::VARLEN) {
+      m_heap.resize(m_offsets[size]);
+    }
+    m_size = size;
+    return;
+  }
+
+  assert(m_physical != PhysicalType::VARLEN);
+  if (size > m_capacity) {
+    reserve(std::max(size, m_capacity * 2));
+  }
+  m_size = size;
+}
+
+void ColumnVector::copy_validity(const ColumnVector &other) noexcept {
+  if (!other.m_may_have_nulls) {
+    if (m_may_have_nulls) {
+      std::fill(m_validity.begin(), m_validity.end(), ~uint64_t{0});
+      m_may_have_nulls = false;
+    }
+    return;
+  }
+
+  m_may_have_nulls = true;
+  const size_t words = (m_size + 63) / 64;
+  std::copy_n(other.m_validity.begin(), words, m_validity.begin());
+}
+
+void ColumnVector::intersect_validity(const ColumnVector &other) noexcept {
+  if (!other.m_may_have_nulls) {
+    return;
+  }
+
+  const size_t words = (m_size + 63) / 64;
+  for (size_t i = 0; i < words; ++i) {
+    m_validity[i] &= other.m_validity[i];
+  }
+  m_may_have_nulls = true;
+}
+
+void ColumnVector::append_string(std::string_view value) {
+  assert(heap_fits(value.size()));
+  if (m_size == m_capacity) {
+    reserve(m_capacity * 2);
+  }
+
+  m_heap.insert(m_heap.end(), value.begin(), value.end());
+  m_offsets[++m_size] = static_cast<uint32_t>(m_heap.size());
+}
+
+void ColumnVector::append_null() {
+  if (m_size == m_capacity) {
+    reserve(m_capacity * 2);
+  }
+
+  if (m_physical == PhysicalType::VARLEN) {
+    m_offsets[m_size + 1] = m_offsets[m_size];
+  } else {
+    const auto width = physical_width(m_physical);
+    std::memset(m_data.data() + m_size * width, 0, width);
+  }
+  set_valid(m_size++, false);
+}
+
+error::VoidResult ColumnVector::append_value(const dtypes::Value &value) {
+  using dtypes::TypeId;
+
+  if (std::holds_alternative<std::nullptr_t>(value)) {
+    append_null();
+    return error::ok();
+  }
+
+  if (m_physical == PhysicalType::VARLEN) {
+    std::string_view bytes;
+    if (const auto *text = std::get_if<std::string>(&value)) {
+      bytes = *text;
+    } else if (const auto *blob = std::get_if<std::vector<uint8_t>>(&value)) {
+      bytes = {reinterpret_cast<const char *>(blob->data()), blob->size()};
+    } else if (const auto *uuid = std::get_if<dtypes::UUID>(&value)) {
+      bytes = {reinterpret_cast<const char *>(uuid->bytes.data()),
+               uuid->bytes.size()};
+    } else {
+      return error::error<void>(error::ErrorCode::TYPE_MISMATCH);
+    }
+
+    if (!heap_fits(bytes.size())) {
+      return error::error<void>(error::ErrorCode::OUT_OF_MEMORY);
+    }
+    append_string(bytes);
+    return error::ok();
+  }
+
+  switch (m_type.type_id) {
+  case TypeId::DATE:
+    if (const auto *date = std::get_if<dtypes::Date>(&value)) {
+      append<int32_t>(date->days_since_epoch);
+      return error::ok();
+    }
+    return error::error<void>(error::ErrorCode::TYPE_MISMATCH);
+  case TypeId::TIME:
+    if (const auto *time = std::get_if<dtypes::Time>(&value)) {
+      append<int64_t>(time->microseconds_since_midnight);
+      return error::ok();
+    }
+    return error::error<void>(error::ErrorCode::TYPE_MISMATCH);
+  case TypeId::TIMESTAMP:
+    if (const auto *ts = std::get_if<dtypes::Timestamp>(&value)) {
+      append<int64_t>(ts->microseconds_since_epoch);
+      return error::ok();
+    }
+    return error::error<void>(error::ErrorCode::TYPE_MISMATCH);
+  default:
+    break;
+  }
+
+  const auto numeric = numeric_of(value);
+  if (!numeric) {
+    return error::error<void>(error::ErrorCode::TYPE_MISMATCH);
+  }
+
+  if (m_type.type_id == TypeId::DECIMAL) {
+    append<int64_t>(numeric->integral
+                        ? rescale(numeric->integer, numeric->scale,
+                                  m_type.scale)
+                        : std::llround(numeric->floating *
+                                       static_cast<double>(
+                                           scale_factor(m_type.scale))));
+    return error::ok();
+  }
+
+  dispatch_fixed(m_physical, [&](auto tag) {
+    using T = typename decltype(tag)::type;
+    if (!numeric->integral) {
+      append<T>(static_cast<T>(numeric->floating));
+    } else if (numeric->scale > 0) {
+      append<T>(static_cast<T>(
+          static_cast<double>(numeric->integer) /
+          static_cast<double>(scale_factor(numeric->scale))));
+    } else {
+      append<T>(static_cast<T>(numeric->integer));
+    }
+  });
+
+  return error::ok();
+}
+
+dtypes::Value ColumnVector::value_at(size_t row) const {
+  using dtypes::TypeId;
+
+  if (!is_valid(row)) {
+    return nullptr;
+  }
+
+  switch (m_type.type_id) {
+  case TypeId::NULL_TYPE:
+    return nullptr;
+  case TypeId::BOOLEAN:
+    return data<uint8_t>()[row] != 0;
+  case TypeId::TINYINT:
+    return data<int8_t>()[row];
+  case TypeId::SMALLINT:
+    return data<int16_t>()[row];
+  case TypeId::INTEGER:
+    return data<int32_t>()[row];
+  case TypeId::BIGINT:
+  case TypeId::INTERVAL:
+    return data<int64_t>()[row];
+  case TypeId::REAL:
+    return data<float>()[row];
+  case TypeId::DOUBLE:
+    return data<double>()[row];
+  case TypeId::DECIMAL:
+    return dtypes::Decimal(data<int64_t>()[row], m_type.precision,
+                           m_type.scale);
+  case TypeId::DATE:
+    return dtypes::Date(data<int32_t>()[row]);
+  case TypeId::TIME:
+    return dtypes::Time(data<int64_t>()[row]);
+  case TypeId::TIMESTAMP:
+    return dtypes::Timestamp(data<int64_t>()[row]);
+  case TypeId::BLOB: {
+    const auto bytes = string_at(row);
+    return std::vector<uint8_t>(bytes.begin(), bytes.end());
+  }
+  case TypeId::UUID: {
+    std::array<uint8_t, 16> bytes{};
+    const auto stored = string_at(row);
+    std::memcpy(bytes.data(), stored.data(),
+                std::min(stored.size(), bytes.size()));
+    return dtypes::UUID(bytes);
+  }
+  default:
+    return std::string(string_at(row));
+  }
+}
+
+void ColumnVector::append_from(const ColumnVector &source, size_t row) {
+  assert(source.m_physical == m_physical);
+
+  if (!source.is_valid(row)) {
+    append_null();
+  } else if (m_physical == PhysicalType::VARLEN) {
+    append_string(source.string_at(row));
+  } else {
+    if (m_size == m_capacity) {
+      reserve(m_capacity * 2);
+    }
+    const auto width = physical_width(m_physical);
+    std::memcpy(m_data.data() + m_size * width,
+                source.m_data.data() + row * width, width);
+    ++m_size;
+  }
+}
+
+void ColumnVector::append_selected(const ColumnVector &source,
+                                   std::span<const uint32_t> rows) {
+  assert(source.m_physical == m_physical);
+
+  const size_t base = m_size;
+  reserve(std::max(base + rows.size(), m_capacity));
+
+  if (m_physical == PhysicalType::VARLEN) {
+    for (auto row : rows) {
+      append_string(source.string_at(row));
+    }
+  } else {
+    dispatch_fixed(m_physical, [&](auto tag) {
+      using T = typename decltype(tag)::type;
+      const T *in = source.data<T>();
+      T *out = data<T>() + base;
+      for (size_t i = 0; i < rows.size(); ++i) {
+        out[i] = in[rows[i]];
+      }
+    });
+    m_size = base + rows.size();
+  }
+
+  if (source.m_may_have_nulls) {
+    for (size_t i = 0; i < rows.size(); ++i) {
+      if (!source.is_valid(rows[i])) {
+        set_valid(base + i, false);
+      }
+    }
+  }
+}
+
+void ColumnVector::append_range(const ColumnVector &source, size_t offset,
+                                size_t count) {
+  assert(source.m_physical == m_physical);
+
+  const size_t base = m_size;
+  reserve(std::max(base + count, m_capacity));
+
+  if (m_physical == PhysicalType::VARLEN) {
+    const auto begin = source.m_offsets[offset];
+    const auto end = source.m_offsets[offset + count];
+    assert(heap_fits(end - begin));
+    const auto shift = static_cast<uint32_t>(m_heap.size()) - begin;
+    m_heap.insert(m_heap.end(), source.m_heap.begin() + begin,
+                  source.m_heap.begin() + end);
+    for (size_t i = 1; i <= count; ++i) {
+      m_offsets[base + i] = source.m_offsets[offset + i] + shift;
+    }
+  } else {
+    const auto width = physical_width(m_physical);
+    std::memcpy(m_data.data() + base * width,
+                source.m_data.data() + offset * width, count * width);
+  }
+  m_size = base + count;
+
+  if (source.m_may_have_nulls) {
+    for (size_t i = 0; i < count; ++i) {
+      if (!source.is_valid(offset + i)) {
+        set_valid(base + i, false);
+      }
+    }
+  }
+}
+
+bool ColumnVector::equals(size_t row, const ColumnVector &other,
+                          size_t other_row) const noexcept {
+  const bool valid = is_valid(row);
+  if (valid != other.is_valid(other_row)) {
+    return false;
+  }
+  if (!valid) {
+    return true;
+  }
+
+  return compare(row, other, other_row) == 0;
+}
+
+int ColumnVector::compare(size_t row, const ColumnVector &other,
+                          size_t other_row) const noexcept {
+  if (m_physical == PhysicalType::VARLEN) {
+    return string_at(row).compare(other.string_at(other_row));
+  }
+
+  if (m_physical == other.m_physical) {
+    return dispatch_fixed(m_physical, [&](auto tag) {
+      using T = typename decltype(tag)::type;
+      return three_way(data<T>()[row], other.data<T>()[other_row]);
+    });
+  }
+
+  if (is_integral(m_physical) && is_integral(other.m_physical)) {
+    return three_way(int_at(*this, row), int_at(other, other_row));
+  }
+
+  return three_way(double_at(*this, row), double_at(other, other_row));
+}
+
+void ColumnVector::hash(std::span<uint64_t> hashes,
+                        bool combine) const noexcept {
+  auto store = [&](size_t i, uint64_t hash) {
+    hashes[i] = combine ? combine_hash(hashes[i], hash) : hash;
+  };
+
+  if (m_physical == PhysicalType::VARLEN) {
+    const std::hash<std::string_view> hasher;
+    for (size_t i = 0; i < m_size; ++i) {
+      store(i, mix64(hasher(string_at(i))));
+    }
+  } else {
+    dispatch_fixed(m_physical, [&](auto tag) {
+      using T = typename decltype(tag)::type;
+      const T *values = data<T>();
+      for (size_t i = 0; i < m_size; ++i) {
+        if constexpr (std::is_floating_point_v<T>) {
+          // +0.0 and -0.0 compare equal, so they must hash equally
+          const double value = values[i] == T{0} ? 0.0 : values[i];
+          store(i, mix64(std::bit_cast<uint64_t>(value)));
+        } else {
+          store(i, mix64(static_cast<uint64_t>(
+                       static_cast<int64_t>(values[i]))));
+        }
+      }
+    });
+  }
+
+  if (m_may_have_nulls) {
+    for (size_t i = 0; i < m_size; ++i) {
+      if (!is_valid(i)) {
+        hashes[i] = combine ? combine_hash(hashes[i], NULL_HASH) : NULL_HASH;
+      }
+    }
+  }
+}
+
+size_t ColumnVector::memory_usage() const noexcept {
+  return m_data.capacity() + m_validity.capacity() * sizeof(uint64_t) +
+         m_offsets.capacity() * sizeof(uint32_t) + m_heap.capacity();
+}
+
+// DataChunk
+
+DataChunk::DataChunk(const Schema &schema, size_t capacity) {
+  initialize(schema, capacity);
+}
+
+void DataChunk::initialize(const Schema &schema, size_t capacity) {
+  m_columns.clear();
+  m_columns.reserve(schema.size());
+  for (const auto &column : schema) {
+    m_columns.emplace_back(column.type, capacity);
+  }
+  m_size = 0;
+}
+
+bool DataChunk::matches(const Schema &schema) const noexcept {
+  if (schema.size() != m_columns.size()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < schema.size(); ++i) {
+    if (!same_type(schema[i].type, m_columns[i].type())) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void DataChunk::clear() noexcept {
+  for (auto &column : m_columns) {
+    column.clear();
+  }
+  m_size = 0;
+}
+
+void DataChunk::append_row(const DataChunk &source, size_t row) {
+  for (size_t i = 0; i < m_columns.size(); ++i) {
+    m_columns[i].append_from(source.m_columns[i], row);
+  }
+  ++m_size;
+}
+
+void DataChunk::append_selected(const DataChunk &source,
+                                std::span<const uint32_t> rows) {
+  for (size_t i = 0; i < m_columns.size(); ++i) {
+    m_columns[i].append_selected(source.m_columns[i], rows);
+  }
+  m_size += rows.size();
+}
+
+void DataChunk::append_range(const DataChunk &source, size_t offset,
+                             size_t count) {
+  for (size_t i = 0; i < m_columns.size(); ++i) {
+    m_columns[i].append_range(source.m_columns[i], offset, count);
+  }
+  m_size += count;
+}
+
+bool DataChunk::range_fits(const DataChunk &source, size_t offset,
+                           size_t count) const noexcept {
+  for (size_t i = 0; i < m_columns.size(); ++i) {
+    const auto &column = source.m_columns[i];
+    if (column.physical() != PhysicalType::VARLEN) {
+      continue;
+    }
+
+    const auto offsets = column.offsets();
+    if (!m_columns[i].heap_fits(offsets[offset + count] - offsets[offset])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+error::VoidResult DataChunk::append_row(const dtypes::Row &row) {
+  if (row.size() != m_columns.size()) {
+    return error::error<void>(error::ErrorCode::INVALID_ARGUMENT);
+  }
+
+  for (size_t i = 0; i < m_columns.size(); ++i) {
+    if (auto appended = m_columns[i].append_value(row[i]); !appended) {
+      for (size_t j = 0; j < i; ++j) {
+        m_columns[j].resize(m_size);
+      }
+      return appended;
+    }
+  }
+  ++m_size;
+
+  return error::ok();
+}
+
+dtypes::Row DataChunk::row(size_t row) const {
+  dtypes::Row result(m_columns.size());
+  for (size_t i = 0; i < m_columns.size(); ++i) {
+    result.set(i, m_columns[i].value_at(row));
+  }
+
+  return result;
+}
+
+size_t DataChunk::memory_usage() const noexcept {
+  size_t bytes = 0;
+  for (const auto &column : m_columns) {
+    bytes += column.memory_usage();
+  }
+
+  return bytes;
+}
+
+void order_prefixes(const ColumnVector &column, size_t first, size_t count,
+                    bool ascending, uint64_t *prefixes) {
+  constexpr uint64_t SIGN = uint64_t{1} << 63;
+  const uint64_t flip = ascending ? 0 : ~uint64_t{0};
+
+  if (column.physical() == PhysicalType::VARLEN) {
+    for (size_t i = 0; i < count; ++i) {
+      const auto value = column.string_at(first + i);
+      uint64_t prefix = 0;
+      for (size_t b = 0; b < 8; ++b) {
+        prefix = prefix << 8 |
+                 (b < value.size() ? static_cast<uint8_t>(value[b]) : 0);
+      }
+      prefixes[i] = prefix ^ flip;
+    }
+    return;
+  }
+
+  dispatch_fixed(column.physical(), [&](auto tag) {
+    using T = typename decltype(tag)::type;
+    const T *values = column.data<T>() + first;
+    for (size_t i = 0; i < count; ++i) {
+      uint64_t prefix;
+      if constexpr (std::is_floating_point_v<T>) {
+        double value = values[i] == T{0} ? 0.0 : static_cast<double>(values[i]);
+        if (std::isnan(value)) {
+          value = std::numeric_limits<double>::quiet_NaN();
+        }
+        const auto bits = std::bit_cast<uint64_t>(value);
+        prefix = (bits & SIGN) ? ~bits : bits | SIGN;
+      } else {
+        prefix = static_cast<uint64_t>(static_cast<int64_t>(values[i])) ^ SIGN;
+      }
+      prefixes[i] = prefix ^ flip;
+    }
+  });
+}
+
+// ColumnarTable
+
+ColumnarTable::ColumnarTable(Schema schema)
+    : m_id(next_table_id()), m_schema(std::move(schema)) {}
+
+ColumnarTable::ColumnarTable(const ColumnarTable &other)
+    : m_id(next_table_id()), m_schema(other.m_schema),
+      m_chunks(other.m_chunks), m_zones(other.m_zones),
+      m_row_count(other.m_row_count) {}
+
+ColumnarTable &ColumnarTable::operator=(const ColumnarTable &other) {
+  if (this != &other) {
+    m_id = next_table_id();
+    m_schema = other.m_schema;
+    m_chunks = other.m_chunks;
+    m_zones = other.m_zones;
+    m_row_count = other.m_row_count;
+  }
+
+  return *this;
+}
+
+DataChunk &ColumnarTable::tail() {
+  if (m_chunks.empty() || m_chunks.back().size() == config::VECTOR_SIZE) {
+    m_chunks.emplace_back(m_schema);
+    m_zones.resize(m_zones.size() + m_schema.size());
+  }
+
+  return m_chunks.back();
+}
+
+void ColumnarTable::extend_zones(size_t chunk, size_t first, size_t count) {
+  uint64_t prefixes[config::VECTOR_SIZE];
+  const auto &source = m_chunks[chunk];
+  for (size_t c = 0; c < m_schema.size(); ++c) {
+    const auto &column = source.column(c);
+    auto &zone = m_zones[chunk * m_schema.size() + c];
+    order_prefixes(column, first, count, true, prefixes);
+    for (size_t i = 0; i < count; ++i) {
+      if (!column.is_valid(first + i)) {
+        ++zone.nulls;
+        continue;
+      }
+      ++zone.values;
+      zone.min = std::min(zone.min, prefixes[i]);
+      zone.max = std::max(zone.max, prefixes[i]);
+    }
+  }
+}
+
+error::VoidResult ColumnarTable::append_row(const dtypes::Row &row) {
+  auto &target = tail();
+  auto appended = target.append_row(row);
+  if (appended) {
+    ++m_row_count;
+    extend_zones(m_chunks.size() - 1, target.size() - 1, 1);
+  } else if (m_chunks.back().empty()) {
+    m_chunks.pop_back();
+    m_zones.resize(m_zones.size() - m_schema.size());
+  }
+
+  return appended;
+}
+
+error::VoidResult ColumnarTable::append_chunk(const DataChunk &chunk) {
+  if (!chunk.matches(m_schema)) {
+    return error::error<void>(error::ErrorCode::INVALID_ARGUMENT);
+  }
+
+  size_t offset = 0;
+  while (offset < chunk.size()) {
+    auto &target = tail();
+    const auto count =
+        std::min(chunk.size() - offset, config::VECTOR_SIZE - target.size());
+    const size_t first = target.size();
+    target.append_range(chunk, offset, count);
+    extend_zones(m_chunks.size() - 1, first, count);
+    offset += count;
+  }
+  m_row_count += chunk.size();
+
+  return error::ok();
+}
+
+size_t ColumnarTable::memory_usage() const noexcept {
+  size_t bytes = 0;
+  for (const auto &chunk : m_chunks) {
+    bytes += chunk.memory_usage();
+  }
+
+  return bytes;
+}
+
+} // namespace velox::query
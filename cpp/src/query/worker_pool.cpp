@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <atomic>
+#include <velox/query/worker_pool.hpp>
+
+namespace velox::query {
+/**
+ * @brief One parallel_for call
+ *
+ * @note Iterations are claimed from a shared counter, so fast threads
+ *       take more of them. helpers counts the workers that may still
+ *       join; the loop leaves the queue once it reaches zero.
+ */
+struct WorkerPool::Loop {
+  const std::function<void(size_t)> *fn{nullptr};
+  size_t count{0};
+  size_t helpers{0};
+  std::atomic<size_t> next{0};
+  std::atomic<size_t> done{0};
+
+  void run() {
+    size_t finished = 0;
+    for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+         i = next.fetch_add(1, std::memory_order_relaxed)) {
+      (*fn)(i);
+      ++finished;
+    }
+
+    if (finished > 0 &&
+        done.fetch_add(finished, std::memory_order_acq_rel) + finished ==
+            count) {
+      done.notify_all();
+    }
+  }
+};
+
+WorkerPool::WorkerPool(size_t workers) {
+  m_threads.reserve(workers);
+  for (size_t i = 0; i < workers; ++i) {
+    m_threads.emplace_back([this] { work(); });
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_ready.notify_all();
+
+  for (auto &thread : m_threads) {
+    thread.join();
+  }
+}
+
+void WorkerPool::work() {
+  while (true) {
+    std::shared_ptr<Loop> loop;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_ready.wait(lock, [&] { return m_stopping || !m_queue.empty(); });
+      if (m_stopping) {
+        return;
+      }
+
+      loop = m_queue.front();
+      if (--loop->helpers == 0) {
+        m_queue.pop_front();
+      }
+    }
+    loop->run();
+  }
+}
+
+void WorkerPool::parallel_for(size_t count,
+                              const std::function<void(size_t)> &fn,
+                              size_t max_threads) {
+  if (count == 0) {
+    return;
+  }
+
+  const size_t threads =
+      std::min({max_threads == 0 ? concurrency() : max_threads,
+                concurrency(), count});
+  if (threads <= 1) {
+    for (size_t i = 0; i < count; ++i) {
+      fn(i);
+    }
+    return;
+  }
+
+  auto loop = std::make_shared<Loop>();
+  loop->fn = &fn;
+  loop->count = count;
+  loop->helpers = threads - 1;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queue.push_back(loop);
+  }
+  if (loop->helpers == 1) {
+    m_ready.notify_one();
+  } else {
+    m_ready.notify_all();
+  }
+
+  loop->run();
+
+  // Helpers that have not picked the loop up yet have nothing left to do
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::find(m_queue.begin(), m_queue.end(), loop);
+    if (it != m_queue.end()) {
+      m_queue.erase(it);
+    }
+  }
+
+  for (size_t done = loop->done.load(std::memory_order_acquire);
+       done != count; done = loop->done.load(std::memory_order_acquire)) {
+    loop->done.wait(done, std::memory_order_acquire);
+  }
+}
+
+WorkerPool &WorkerPool::shared() {
+  static WorkerPool pool(
+      std::max<size_t>(config::global_config().worker_threads, 1) - 1);
+  return pool;
+}
+
+} // namespace velox::query
@@ -0,0 +1,43 @@
+#include <velox/storage/storage_engine.hpp>
+
+namespace velox::storage {
+namespace {
+/// @brief FNV-1a over the header bytes, with the checksum field as zero
+uint32_t header_checksum(const PageHeader &header) noexcept {
+  PageHeader copy = header;
+  copy.checksum = 0;
+
+  const auto *bytes = reinterpret_cast<const uint8_t *>(&copy);
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < sizeof(PageHeader); ++i) {
+    hash = (hash ^ bytes[i]) * 16777619u;
+  }
+
+  return hash;
+}
+} // namespace
+
+// PageHeader
+
+PageHeader::PageHeader(PageId id, PageType type)
+    : page_type(type), free_space_offset(0),
+      free_space_size(static_cast<uint32_t>(config::PAGE_DATA_SIZE)),
+      record_count(0), flags(0), page_id(id),
+      next_page(config::INVALID_PAGE_ID), prev_page(config::INVALID_PAGE_ID),
+      lsn(0), checksum(0), reserved{} {}
+
+void PageHeader::update_checksum() noexcept {
+  checksum = header_checksum(*this);
+}
+
+bool PageHeader::verify_checksum() const noexcept {
+  return checksum == header_checksum(*this);
+}
+
+// Page
+
+Page::Page(PageId id)
+    : m_header(id), m_data{},
+      m_last_accessed(std::chrono::steady_clock::now()),
+      m_last_modified(m_last_accessed) {}
+} // namespace velox::storage
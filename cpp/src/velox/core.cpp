@@ -11,10 +11,10 @@ namespace {
 std::mutex loggers_mutex;
 std::unordered_map<std::string, std::shared_ptr<spdlog::logger>> loggers;
 bool initialized = false;
-} // namespace
 
-void initialize(spdlog::level::level_enum level, const std::string &pattern) {
-  std::lock_guard<std::mutex> lock(loggers_mutex);
+/// @brief Initialize logging; caller must hold loggers_mutex
+void initialize_locked(spdlog::level::level_enum level,
+                       const std::string &pattern) {
   if (initialized) {
     return;
   }
@@ -36,11 +36,17 @@ void initialize(spdlog::level::level_enum level, const std::string &pattern) {
   default_logger->info("VeloxDB logging initialized (level: {})",
                        spdlog::level::to_string_view(level));
 }
+} // namespace
+
+void initialize(spdlog::level::level_enum level, const std::string &pattern) {
+  std::lock_guard<std::mutex> lock(loggers_mutex);
+  initialize_locked(level, pattern);
+}
 
 std::shared_ptr<spdlog::logger> get_logger(const std::string &name) {
   std::lock_guard<std::mutex> lock(loggers_mutex);
   if (!initialized) {
-    initialize();
+    initialize_locked(DEFAULT_LEVEL, std::string(DEFAULT_PATTERN));
   }
 
   auto it = loggers.find(name);
@@ -0,0 +1,260 @@
+/**
+ * @file exporter_test.cpp
+ * @author Carlos Salguero
+ * @brief Tests for the Prometheus text format, the loopback-only scrape
+ *        endpoint and atomic metric dumps
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "test_common.hpp"
+
+#include <arpa/inet.h>
+#include <fstream>
+#include <iterator>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <thread>
+#include <velox/metrics/exporter.hpp>
+
+namespace velox::test {
+namespace {
+using metrics::ExporterConfig;
+using metrics::MetricsExporter;
+using namespace std::chrono_literals;
+
+/// @brief Read a whole file, or an empty string if it is missing
+std::string read_file(const std::filesystem::path &file) {
+  std::ifstream input(file);
+  return std::string((std::istreambuf_iterator<char>(input)),
+                     std::istreambuf_iterator<char>());
+}
+
+/**
+ * @brief Send one HTTP GET to the loopback endpoint
+ *
+ * @param port Bound TCP port
+ * @param target Request target
+ * @return Raw response, or an empty string if the connection failed
+ */
+std::string http_get(uint16_t port, std::string_view target) {
+  const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return {};
+  }
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  std::string response;
+  if (::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0) {
+    const auto request =
+        fmt::format("GET {} HTTP/1.1\r\nHost: localhost\r\n\r\n", target);
+    (void)::send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+
+    char buffer[4096];
+    ssize_t received = 0;
+    while ((received = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+      response.append(buffer, static_cast<size_t>(received));
+    }
+  }
+  ::close(fd);
+
+  return response;
+}
+
+TEST(PrometheusTest, RendersCountersGaugesAndSummaries) {
+  metrics::MetricsRegistry registry;
+  registry.get_counter("query.rows").add(3);
+  registry.gauge("9queue depth", 2.5);
+  auto &latency = registry.get_histogram("query_execute_ns");
+  latency.record(1000);
+  latency.record(3000);
+  registry.get_histogram("page_bytes").record(4096);
+
+  const auto text = metrics::to_prometheus(registry.get_metrics());
+  EXPECT_NE(text.find("# TYPE query_rows_total counter\nquery_rows_total 3\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("# TYPE _queue_depth gauge\n_queue_depth 2.5\n"),
+            std::string::npos);
+
+  // Nanosecond histograms are exported in seconds
+  EXPECT_NE(text.find("# TYPE query_execute_seconds summary\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("query_execute_seconds{quantile=\"0.5\"} 1"),
+            std::string::npos);
+  EXPECT_NE(text.find("query_execute_seconds_sum 4"), std::string::npos);
+  EXPECT_NE(text.find("query_execute_seconds_count 2\n"), std::string::npos);
+  EXPECT_NE(text.find("# TYPE page_bytes summary\n"), std::string::npos);
+  EXPECT_NE(text.find("page_bytes_sum 4096\npage_bytes_count 1\n"),
+            std::string::npos);
+  EXPECT_EQ(text.find("query_execute_ns"), std::string::npos);
+}
+
+TEST(PrometheusTest, RendersStorageStatisticsAndLatches) {
+  storage::StorageStatistics stats;
+  stats.total_pages = 10;
+  stats.buffer_hits = 3;
+  stats.buffer_misses = 1;
+  stats.update_cache_hit_ratio();
+
+  const auto storage_text = metrics::to_prometheus(stats);
+  EXPECT_NE(storage_text.find("# HELP velox_storage_stats_pages Total number "
+                              "of pages\n# TYPE velox_storage_stats_pages "
+                              "gauge\nvelox_storage_stats_pages 10\n"),
+            std::string::npos);
+  EXPECT_NE(storage_text.find("velox_storage_stats_buffer_hits_total 3\n"),
+            std::string::npos);
+  EXPECT_NE(storage_text.find("velox_storage_stats_cache_hit_ratio 0.75\n"),
+            std::string::npos);
+
+  metrics::LatchSnapshot page;
+  page.name = "page";
+  page.acquisitions = 8;
+  page.contended = 2;
+  page.wait_ns = 1'500'000'000;
+  page.top_keys = {{42, 2, 1'500'000'000}};
+  const std::vector<metrics::LatchSnapshot> latches{page};
+
+  const auto latch_text = metrics::to_prometheus(latches);
+  EXPECT_NE(
+      latch_text.find("velox_latch_acquisitions_total{latch=\"page\"} 8\n"),
+      std::string::npos);
+  EXPECT_NE(latch_text.find("velox_latch_contended_total{latch=\"page\"} 2\n"),
+            std::string::npos);
+  EXPECT_NE(latch_text.find("velox_latch_wait_seconds_total{latch=\"page\"} "
+                            "1.5"),
+            std::string::npos);
+  EXPECT_NE(latch_text.find("velox_latch_key_wait_seconds_total{latch=\"page\","
+                            "key=\"42\"} 1.5"),
+            std::string::npos);
+  EXPECT_TRUE(metrics::to_prometheus(
+                  std::span<const metrics::LatchSnapshot>{})
+                  .empty());
+}
+
+TEST(ExporterConfigTest, OnlyLoopbackAddressesAreValid) {
+  ExporterConfig config;
+  EXPECT_TRUE(config.is_valid());
+
+  for (const char *address : {"127.0.0.1", "::1", "localhost"}) {
+    config.bind_address = address;
+    EXPECT_TRUE(config.is_valid()) << address;
+  }
+  for (const char *address : {"0.0.0.0", "::", "192.168.1.10", ""}) {
+    config.bind_address = address;
+    EXPECT_FALSE(config.is_valid()) << address;
+  }
+
+  // Without a TCP server the bind address does not matter
+  config.enable_server = false;
+  EXPECT_TRUE(config.is_valid());
+
+  config.dump_interval = 5s;
+  EXPECT_FALSE(config.is_valid()) << "periodic dumps need a file";
+  config.dump_file = "metrics.prom";
+  EXPECT_TRUE(config.is_valid());
+  config.dump_interval = -1s;
+  EXPECT_FALSE(config.is_valid());
+}
+
+TEST(MetricsExporterTest, RefusesToBindNonLoopbackAddresses) {
+  ExporterConfig config;
+  config.bind_address = "0.0.0.0";
+  config.port = 0;
+  MetricsExporter exporter(config);
+
+  auto started = exporter.start();
+  ASSERT_FALSE(started.has_value());
+  EXPECT_EQ(started.error(), error::ErrorCode::INVALID_ARGUMENT);
+  EXPECT_FALSE(exporter.is_running());
+  EXPECT_EQ(exporter.bound_port(), 0u);
+}
+
+TEST(MetricsExporterTest, ServesMetricsOnLoopback) {
+  metrics::MetricsRegistry registry;
+  registry.get_counter("scrapes").add(7);
+
+  ExporterConfig config;
+  config.port = 0;
+  MetricsExporter exporter(config, registry);
+  exporter.set_statistics_provider([] {
+    storage::StorageStatistics stats;
+    stats.total_pages = 12;
+    return stats;
+  });
+  ASSERT_TRUE(exporter.start().has_value());
+  ASSERT_TRUE(exporter.is_running());
+  ASSERT_NE(exporter.bound_port(), 0u);
+
+  const auto response = http_get(exporter.bound_port(), "/metrics");
+  EXPECT_TRUE(response.starts_with("HTTP/1.1 200 OK\r\n"));
+  EXPECT_NE(response.find("Content-Type: text/plain; version=0.0.4\r\n"),
+            std::string::npos);
+  EXPECT_NE(response.find("scrapes_total 7\n"), std::string::npos);
+  EXPECT_NE(response.find("velox_storage_stats_pages 12\n"),
+            std::string::npos);
+
+  EXPECT_TRUE(http_get(exporter.bound_port(), "/other")
+                  .starts_with("HTTP/1.1 404 Not Found\r\n"));
+
+  const auto port = exporter.bound_port();
+  exporter.stop();
+  EXPECT_FALSE(exporter.is_running());
+  EXPECT_TRUE(http_get(port, "/metrics").empty());
+}
+
+TEST(MetricsExporterTest, DumpReplacesTheFileAtomically) {
+  metrics::MetricsRegistry registry;
+  auto &counter = registry.get_counter("dumps");
+
+  ExporterConfig config;
+  config.enable_server = false;
+  MetricsExporter exporter(config, registry);
+
+  TempDirectory directory("velox_exporter");
+  const auto file = directory.path() / "metrics.prom";
+  {
+    std::ofstream stale(file);
+    stale << "stale\n";
+  }
+
+  counter.add(1);
+  ASSERT_TRUE(exporter.dump(file).has_value());
+  EXPECT_EQ(read_file(file), exporter.render());
+  EXPECT_NE(read_file(file).find("dumps_total 1\n"), std::string::npos);
+  EXPECT_EQ(directory.file_count(), 1u) << "temporary file left behind";
+
+  const auto missing = directory.path() / "missing" / "metrics.prom";
+  EXPECT_FALSE(exporter.dump(missing).has_value());
+  EXPECT_FALSE(std::filesystem::exists(missing));
+}
+
+TEST(MetricsExporterTest, DumpsPeriodically) {
+  metrics::MetricsRegistry registry;
+  registry.get_counter("ticks").add(2);
+
+  TempDirectory directory("velox_exporter");
+  ExporterConfig config;
+  config.enable_server = false;
+  config.dump_file = directory.path() / "metrics.prom";
+  config.dump_interval = 1s;
+  MetricsExporter exporter(config, registry);
+  ASSERT_TRUE(exporter.start().has_value());
+
+  const auto deadline = std::chrono::steady_clock::now() + 10s;
+  while (!std::filesystem::exists(config.dump_file) &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(50ms);
+  }
+  exporter.stop();
+
+  EXPECT_NE(read_file(config.dump_file).find("ticks_total 2\n"),
+            std::string::npos);
+}
+} // namespace
+} // namespace velox::test
@@ -0,0 +1,100 @@
+/**
+ * @file external_sort_test.cpp
+ * @author Carlos Salguero
+ * @brief Tests for ExternalSort against Sort, including multi-pass merges
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "test_common.hpp"
+
+#include <random>
+
+namespace velox::test {
+namespace {
+using dtypes::TypeId;
+using dtypes::Value;
+
+const query::Schema EVENTS{{"bucket", TypeId::INTEGER},
+                           {"tag", TypeId::VARCHAR},
+                           {"score", TypeId::DOUBLE},
+                           {"seq", TypeId::BIGINT}};
+
+/// @brief Events with many ties; seq records input order for stability
+Rows make_events(size_t count) {
+  std::mt19937_64 rng(23);
+  Rows rows;
+  for (size_t i = 0; i < count; ++i) {
+    Value bucket = rng() % 19 == 0
+                       ? Value(nullptr)
+                       : Value(static_cast<int32_t>(rng() % 200) - 100);
+    Value tag = rng() % 23 == 0 ? Value(nullptr)
+                                : Value(fmt::format("t{}", rng() % 5));
+    Value score = static_cast<double>(rng() % 64) / 8;
+    rows.push_back({bucket, tag, score, static_cast<int64_t>(i)});
+  }
+
+  return rows;
+}
+
+const std::vector<std::vector<query::SortKey>> ORDERINGS{
+    {{0, true, false}},
+    {{0, false, true}, {1, true, false}},
+    {{1, false, false}, {2, true, false}, {0, true, true}},
+    {{2, false, false}}};
+
+struct ExternalSortCase {
+  const char *name;
+  size_t rows;
+  size_t memory_budget;
+};
+
+class ExternalSortTest : public ::testing::TestWithParam<ExternalSortCase> {};
+
+TEST_P(ExternalSortTest, MatchesSortIncludingTies) {
+  const auto &param = GetParam();
+  auto table = make_table(EVENTS, make_events(param.rows));
+
+  for (const auto &keys : ORDERINGS) {
+    query::Sort reference(std::make_unique<query::TableScan>(table), keys);
+    const auto expected = collect(reference);
+    ASSERT_EQ(expected.size(), param.rows);
+
+    TempDirectory directory("external_sort");
+    query::ExternalSortOptions options;
+    options.threads = 4;
+    options.memory_budget = param.memory_budget;
+    options.spill_directory = directory.path();
+    query::ExternalSort sort(std::make_unique<query::TableScan>(table), keys,
+                             options);
+    EXPECT_EQ(collect(sort), expected);
+
+    sort.reset();
+    EXPECT_EQ(collect(sort), expected);
+  }
+}
+
+// A budget of one byte cuts a run per input chunk: 150 chunks need an
+// intermediate pass before the final 64-way merge
+INSTANTIATE_TEST_SUITE_P(
+    Budgets, ExternalSortTest,
+    ::testing::Values(ExternalSortCase{"in_memory", 20000, 0},
+                      ExternalSortCase{"single_pass", 20000, 64 * 1024},
+                      ExternalSortCase{"multi_pass", 150 * 1024, 1},
+                      ExternalSortCase{"empty", 0, 1}),
+    [](const auto &info) { return std::string(info.param.name); });
+
+TEST(ExternalSortErrorTest, RejectsUnknownKeyColumn) {
+  auto table = make_table(EVENTS, make_events(10));
+  query::ExternalSort sort(std::make_unique<query::TableScan>(table),
+                           {{EVENTS.size(), true, false}});
+  query::DataChunk chunk;
+  auto more = sort.next(chunk);
+  ASSERT_FALSE(more.has_value());
+  EXPECT_EQ(more.error(), error::ErrorCode::INVALID_ARGUMENT);
+}
+} // namespace
+} // namespace velox::test
@@ -0,0 +1,341 @@
+/**
+ * @file kernels_test.cpp
+ * @author Carlos Salguero
+ * @brief Tests for the SIMD filter kernels against a scalar reference at
+ *        every instruction set the CPU supports
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "test_common.hpp"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <velox/query/kernels.hpp>
+
+namespace velox::test {
+namespace {
+using query::CompareOp;
+using query::kernels::SimdLevel;
+
+constexpr CompareOp ALL_OPS[] = {CompareOp::EQ, CompareOp::NE, CompareOp::LT,
+                                 CompareOp::LE, CompareOp::GT, CompareOp::GE};
+
+/// @brief Row counts around the SIMD widths and the bitmap word size
+constexpr size_t ROW_COUNTS[] = {0, 1, 7, 31, 63, 64, 65, 129, 1000, 1024};
+
+/// @brief Levels the CPU supports, scalar first
+std::vector<SimdLevel> supported_levels() {
+  std::vector<SimdLevel> levels;
+  for (auto level : {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+    if (level <= query::kernels::detected_simd_level()) {
+      levels.push_back(level);
+    }
+  }
+
+  return levels;
+}
+
+/// @brief Restores the detected level when a test ends
+class SimdLevelGuard {
+public:
+  SimdLevelGuard() = default;
+  ~SimdLevelGuard() {
+    query::kernels::set_simd_level(query::kernels::detected_simd_level());
+  }
+
+  SimdLevelGuard(const SimdLevelGuard &) = delete;
+  SimdLevelGuard &operator=(const SimdLevelGuard &) = delete;
+};
+
+template <typename T> bool apply(CompareOp op, T a, T b) {
+  switch (op) {
+  case CompareOp::EQ:
+    return a == b;
+  case CompareOp::NE:
+    return a != b;
+  case CompareOp::LT:
+    return a < b;
+  case CompareOp::LE:
+    return a <= b;
+  case CompareOp::GT:
+    return a > b;
+  case CompareOp::GE:
+    return a >= b;
+  }
+
+  return false;
+}
+
+/// @brief Small values, so equality hits often, plus the type's extremes
+template <typename T> std::vector<T> make_values(size_t rows, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<T> values(rows);
+  for (auto &value : values) {
+    switch (rng() % 16) {
+    case 0:
+      value = std::numeric_limits<T>::lowest();
+      break;
+    case 1:
+      value = std::numeric_limits<T>::max();
+      break;
+    case 2:
+      if constexpr (std::is_floating_point_v<T>) {
+        value = std::numeric_limits<T>::quiet_NaN();
+        break;
+      }
+      [[fallthrough]];
+    default:
+      value = static_cast<T>(static_cast<int64_t>(rng() % 41) - 20);
+    }
+  }
+
+  return values;
+}
+
+template <typename Pred>
+std::vector<uint64_t> reference_bitmap(size_t rows, Pred &&pred) {
+  std::vector<uint64_t> bitmap(query::kernels::bitmap_words(rows), 0);
+  for (size_t row = 0; row < rows; ++row) {
+    bitmap[row / 64] |= uint64_t{pred(row)} << (row % 64);
+  }
+
+  return bitmap;
+}
+
+std::vector<uint32_t> reference_selection(const std::vector<uint64_t> &bitmap,
+                                          size_t rows) {
+  std::vector<uint32_t> selection;
+  for (size_t row = 0; row < rows; ++row) {
+    if ((bitmap[row / 64] >> (row % 64)) & 1) {
+      selection.push_back(static_cast<uint32_t>(row));
+    }
+  }
+
+  return selection;
+}
+
+template <typename T> class FilterKernelTest : public ::testing::Test {};
+
+using FilterTypes =
+    ::testing::Types<int8_t, int16_t, int32_t, int64_t, float, double>;
+TYPED_TEST_SUITE(FilterKernelTest, FilterTypes);
+
+TYPED_TEST(FilterKernelTest, CompareMatchesScalarReference) {
+  using T = TypeParam;
+  SimdLevelGuard guard;
+  const std::vector<T> constants{T{0}, T{-20}, T{19},
+                                 std::numeric_limits<T>::max()};
+
+  for (auto level : supported_levels()) {
+    ASSERT_EQ(query::kernels::set_simd_level(level), level);
+    for (auto rows : ROW_COUNTS) {
+      const auto values = make_values<T>(rows, rows + 1);
+      for (auto op : ALL_OPS) {
+        for (auto constant : constants) {
+          const auto expected = reference_bitmap(rows, [&](size_t row) {
+            return apply(op, values[row], constant);
+          });
+          std::vector<uint64_t> bitmap(expected.size(), ~uint64_t{0});
+          query::kernels::compare<T>(values, op, constant, bitmap.data());
+          EXPECT_EQ(bitmap, expected)
+              << to_string(level) << " rows=" << rows << " op="
+              << query::to_string(op) << " value=" << +constant;
+
+          std::vector<uint32_t> selection(rows);
+          const size_t selected = query::kernels::select_compare<T>(
+              values, op, constant, selection.data());
+          selection.resize(selected);
+          EXPECT_EQ(selection, reference_selection(expected, rows))
+              << to_string(level) << " rows=" << rows;
+        }
+      }
+    }
+  }
+}
+
+TYPED_TEST(FilterKernelTest, CompareAgainstNaNOnlySatisfiesNotEqual) {
+  using T = TypeParam;
+  if constexpr (std::is_floating_point_v<T>) {
+    SimdLevelGuard guard;
+    const auto values = make_values<T>(300, 5);
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+    for (auto level : supported_levels()) {
+      query::kernels::set_simd_level(level);
+      for (auto op : ALL_OPS) {
+        std::vector<uint64_t> bitmap(query::kernels::bitmap_words(300));
+        query::kernels::compare<T>(values, op, nan, bitmap.data());
+        const auto expected = reference_bitmap(
+            300, [&](size_t) { return op == CompareOp::NE; });
+        EXPECT_EQ(bitmap, expected) << to_string(level);
+      }
+    }
+  }
+}
+
+TYPED_TEST(FilterKernelTest, BetweenMatchesScalarReference) {
+  using T = TypeParam;
+  SimdLevelGuard guard;
+  const std::vector<std::pair<T, T>> bounds{
+      {T{-5}, T{5}},
+      {T{3}, T{3}},
+      {T{10}, T{-10}},
+      {std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max()}};
+
+  for (auto level : supported_levels()) {
+    query::kernels::set_simd_level(level);
+    for (auto rows : ROW_COUNTS) {
+      const auto values = make_values<T>(rows, 2 * rows + 3);
+      for (const auto &[low, high] : bounds) {
+        const auto expected = reference_bitmap(rows, [&](size_t row) {
+          return low <= values[row] && values[row] <= high;
+        });
+        std::vector<uint64_t> bitmap(expected.size(), ~uint64_t{0});
+        query::kernels::between<T>(values, low, high, bitmap.data());
+        EXPECT_EQ(bitmap, expected)
+            << to_string(level) << " rows=" << rows << " [" << +low << ", "
+            << +high << "]";
+
+        std::vector<uint32_t> selection(rows);
+        selection.resize(query::kernels::select_between<T>(
+            values, low, high, selection.data()));
+        EXPECT_EQ(selection, reference_selection(expected, rows));
+      }
+    }
+  }
+}
+
+TYPED_TEST(FilterKernelTest, InListMatchesScalarReference) {
+  using T = TypeParam;
+  SimdLevelGuard guard;
+
+  // Short lists broadcast each element; long ones take the other path
+  std::vector<std::vector<T>> lists{{}, {T{0}}, {T{-3}, T{7}, T{19}}};
+  std::vector<T> long_list;
+  for (int i = -20; i < 20; i += 2) {
+    long_list.push_back(static_cast<T>(i));
+  }
+  ASSERT_GT(long_list.size(), query::kernels::IN_LIST_SIMD_LIMIT);
+  lists.push_back(long_list);
+  lists.push_back({std::numeric_limits<T>::max()});
+
+  for (auto level : supported_levels()) {
+    query::kernels::set_simd_level(level);
+    for (auto rows : ROW_COUNTS) {
+      const auto values = make_values<T>(rows, 3 * rows + 7);
+      for (const auto &list : lists) {
+        const auto expected = reference_bitmap(rows, [&](size_t row) {
+          return std::find(list.begin(), list.end(), values[row]) !=
+                 list.end();
+        });
+        std::vector<uint64_t> bitmap(expected.size(), ~uint64_t{0});
+        query::kernels::in_list<T>(values, list, bitmap.data());
+        EXPECT_EQ(bitmap, expected) << to_string(level) << " rows=" << rows
+                                    << " list=" << list.size();
+
+        std::vector<uint32_t> selection(rows);
+        selection.resize(
+            query::kernels::select_in<T>(values, list, selection.data()));
+        EXPECT_EQ(selection, reference_selection(expected, rows));
+      }
+    }
+  }
+}
+
+TEST(BitmapKernelTest, ToSelectionAndBitmapAnd) {
+  std::mt19937_64 rng(9);
+  for (auto rows : ROW_COUNTS) {
+    const size_t words = query::kernels::bitmap_words(rows);
+    std::vector<uint64_t> a(words);
+    std::vector<uint64_t> b(words);
+    for (size_t w = 0; w < words; ++w) {
+      a[w] = rng();
+      b[w] = rng();
+    }
+    if (rows % 64 != 0) {
+      a.back() &= (uint64_t{1} << (rows % 64)) - 1;
+    }
+
+    std::vector<uint32_t> selection(rows);
+    selection.resize(
+        query::kernels::to_selection(a.data(), rows, selection.data()));
+    EXPECT_EQ(selection, reference_selection(a, rows)) << rows;
+
+    auto both = a;
+    query::kernels::bitmap_and(both.data(), b.data(), words);
+    for (size_t w = 0; w < words; ++w) {
+      EXPECT_EQ(both[w], a[w] & b[w]);
+    }
+  }
+}
+
+TEST(ColumnKernelTest, NullRowsAndNullScalarsNeverMatch) {
+  SimdLevelGuard guard;
+  query::ColumnVector column(dtypes::TypeId::INTEGER);
+  for (int32_t i = 0; i < 500; ++i) {
+    if (i % 5 == 0) {
+      column.append_null();
+    } else {
+      column.append<int32_t>(i % 10);
+    }
+  }
+  query::ColumnVector scalar(dtypes::TypeId::INTEGER);
+  scalar.append<int32_t>(3);
+  query::ColumnVector null_scalar(dtypes::TypeId::INTEGER);
+  null_scalar.append_null();
+  query::ColumnVector list(dtypes::TypeId::INTEGER);
+  list.append<int32_t>(1);
+  list.append<int32_t>(5);
+
+  for (auto level : supported_levels()) {
+    query::kernels::set_simd_level(level);
+    for (auto op : ALL_OPS) {
+      std::vector<uint64_t> bitmap(query::kernels::bitmap_words(500));
+      query::kernels::compare(column, op, scalar, bitmap.data());
+      const auto expected = reference_bitmap(500, [&](size_t row) {
+        return column.is_valid(row) &&
+               apply(op, column.data<int32_t>()[row], int32_t{3});
+      });
+      EXPECT_EQ(bitmap, expected) << to_string(level);
+
+      query::kernels::compare(column, op, null_scalar, bitmap.data());
+      EXPECT_EQ(bitmap, std::vector<uint64_t>(bitmap.size(), 0));
+    }
+
+    std::vector<uint64_t> bitmap(query::kernels::bitmap_words(500));
+    query::kernels::between(column, scalar, scalar, bitmap.data());
+    EXPECT_EQ(bitmap, reference_bitmap(500, [&](size_t row) {
+                return column.is_valid(row) &&
+                       column.data<int32_t>()[row] == 3;
+              }));
+
+    query::kernels::in_list(column, list, bitmap.data());
+    EXPECT_EQ(bitmap, reference_bitmap(500, [&](size_t row) {
+                const auto value = column.data<int32_t>()[row];
+                return column.is_valid(row) && (value == 1 || value == 5);
+              }));
+  }
+}
+
+TEST(ColumnKernelTest, MaskRoundTripsThroughBitmap) {
+  std::vector<uint64_t> bitmap(query::kernels::bitmap_words(200));
+  std::mt19937_64 rng(4);
+  for (auto &word : bitmap) {
+    word = rng();
+  }
+  bitmap.back() &= (uint64_t{1} << (200 % 64)) - 1;
+
+  query::ColumnVector mask(dtypes::TypeId::BOOLEAN);
+  query::kernels::bitmap_to_mask(bitmap.data(), 200, mask);
+  ASSERT_EQ(mask.size(), 200u);
+
+  std::vector<uint64_t> round_trip(bitmap.size());
+  query::kernels::mask_to_bitmap(mask, round_trip.data());
+  EXPECT_EQ(round_trip, bitmap);
+}
+} // namespace
+} // namespace velox::test
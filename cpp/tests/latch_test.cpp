@@ -0,0 +1,260 @@
+/**
+ * @file latch_test.cpp
+ * @author Carlos Salguero
+ * @brief Tests for instrumented latches: wait counts, contended keys and
+ *        the profiling switch
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "test_common.hpp"
+
+#include <thread>
+#include <velox/metrics/latch.hpp>
+#include <velox/query/plan_cache.hpp>
+#include <velox/storage/storage_engine.hpp>
+
+namespace velox::test {
+namespace {
+using metrics::InstrumentedMutex;
+using metrics::InstrumentedSharedMutex;
+using metrics::LatchStats;
+using namespace std::chrono_literals;
+
+/// @brief Enables latch profiling for the lifetime of a test
+class LatchTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    metrics::set_latch_profiling(true);
+    metrics::reset_latch_stats();
+  }
+
+  void TearDown() override { metrics::set_latch_profiling(false); }
+};
+
+/**
+ * @brief Hold a latch exclusively while another thread acquires it
+ *
+ * @param hold_lock Acquire and release the latch on the holding thread
+ * @param acquire Acquire and release the latch on the waiting thread
+ */
+template <typename HoldFn, typename AcquireFn>
+void contend(HoldFn &&hold_lock, AcquireFn &&acquire) {
+  std::atomic<bool> held{false};
+  std::atomic<bool> release{false};
+  std::thread holder([&] {
+    hold_lock([&] {
+      held.store(true, std::memory_order_release);
+      while (!release.load(std::memory_order_acquire)) {
+        std::this_thread::sleep_for(1ms);
+      }
+    });
+  });
+  while (!held.load(std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+
+  std::thread waiter([&] { acquire(); });
+  std::this_thread::sleep_for(10ms);
+  release.store(true, std::memory_order_release);
+  holder.join();
+  waiter.join();
+}
+
+TEST_F(LatchTest, UncontendedAcquisitionsAreCounted) {
+  LatchStats stats("uncontended");
+  InstrumentedSharedMutex latch(stats);
+  for (int i = 0; i < 3; ++i) {
+    latch.lock(7);
+    latch.unlock();
+    latch.lock_shared(7);
+    latch.unlock_shared();
+  }
+
+  const auto snapshot = stats.snapshot();
+  EXPECT_EQ(snapshot.name, "uncontended");
+  EXPECT_EQ(snapshot.acquisitions, 6u);
+  EXPECT_EQ(snapshot.contended, 0u);
+  EXPECT_EQ(snapshot.wait_ns, 0u);
+  EXPECT_TRUE(snapshot.top_keys.empty());
+  EXPECT_EQ(snapshot.contention_ratio(), 0.0);
+}
+
+TEST_F(LatchTest, WaitsAreCountedAndTimed) {
+  LatchStats stats("waits");
+  InstrumentedSharedMutex latch(stats);
+
+  contend(
+      [&](auto &&body) {
+        latch.lock(3);
+        body();
+        latch.unlock();
+      },
+      [&] {
+        latch.lock_shared(3);
+        latch.unlock_shared();
+      });
+
+  const auto snapshot = stats.snapshot();
+  EXPECT_EQ(snapshot.acquisitions, 2u);
+  EXPECT_EQ(snapshot.contended, 1u);
+  EXPECT_GT(snapshot.wait_ns, 0u);
+  EXPECT_EQ(snapshot.wait.count, 1u);
+  EXPECT_EQ(snapshot.wait.sum, snapshot.wait_ns);
+  EXPECT_DOUBLE_EQ(snapshot.contention_ratio(), 0.5);
+  ASSERT_EQ(snapshot.top_keys.size(), 1u);
+  EXPECT_EQ(snapshot.top_keys[0].key, 3u);
+  EXPECT_EQ(snapshot.top_keys[0].wait_ns, snapshot.wait_ns);
+}
+
+TEST_F(LatchTest, WaitsAreChargedToTheActiveTrace) {
+  LatchStats stats("traced");
+  InstrumentedMutex latch(stats);
+  metrics::set_trace_sample_rate(1);
+
+  uint64_t latch_wait = 0;
+  contend(
+      [&](auto &&body) {
+        latch.lock();
+        body();
+        latch.unlock();
+      },
+      [&] {
+        metrics::TraceScope trace("latched");
+        latch.lock();
+        latch.unlock();
+        latch_wait = metrics::active_trace()->phase_time(
+            metrics::TracePhase::LATCH_WAIT);
+      });
+  metrics::set_trace_sample_rate(metrics::config::DEFAULT_TRACE_SAMPLE_RATE);
+
+  EXPECT_GT(latch_wait, 0u);
+  EXPECT_EQ(latch_wait, stats.snapshot().wait_ns);
+}
+
+TEST_F(LatchTest, TopKeysAreSortedByWaitTime) {
+  LatchStats stats("keys");
+  for (int i = 0; i < 3; ++i) {
+    stats.record_contended(7, 5000);
+  }
+  stats.record_contended(9, 1000);
+  stats.record_contended(11, 100000);
+  stats.record_contended(0, 2000);
+
+  const auto all = stats.snapshot();
+  EXPECT_EQ(all.contended, 6u);
+  EXPECT_EQ(all.wait_ns, 118000u);
+  ASSERT_EQ(all.top_keys.size(), 4u);
+  EXPECT_EQ(all.top_keys[0].key, 11u);
+  EXPECT_EQ(all.top_keys[1].key, 7u);
+  EXPECT_EQ(all.top_keys[1].contended, 3u);
+  EXPECT_EQ(all.top_keys[1].wait_ns, 15000u);
+  EXPECT_EQ(all.top_keys[2].key, 0u) << "unkeyed waits are reported as 0";
+  EXPECT_EQ(all.top_keys[3].key, 9u);
+
+  const auto top = stats.snapshot(2);
+  ASSERT_EQ(top.top_keys.size(), 2u);
+  EXPECT_EQ(top.top_keys[0].key, 11u);
+  EXPECT_EQ(top.top_keys[1].key, 7u);
+
+  stats.reset();
+  EXPECT_EQ(stats.snapshot().contended, 0u);
+  EXPECT_TRUE(stats.snapshot().top_keys.empty());
+}
+
+TEST_F(LatchTest, KeysBeyondTheTableFoldIntoTheOverflowSlot) {
+  LatchStats stats("overflow");
+  constexpr uint64_t KEYS = metrics::config::LATCH_KEY_SLOTS * 2;
+  for (uint64_t key = 1; key <= KEYS; ++key) {
+    stats.record_contended(key, key);
+  }
+
+  const auto snapshot = stats.snapshot(KEYS);
+  uint64_t contended = 0;
+  uint64_t wait_ns = 0;
+  size_t overflow = 0;
+  for (const auto &sample : snapshot.top_keys) {
+    contended += sample.contended;
+    wait_ns += sample.wait_ns;
+    overflow += sample.key == 0 ? 1 : 0;
+  }
+
+  EXPECT_LE(snapshot.top_keys.size(), metrics::config::LATCH_KEY_SLOTS + 1);
+  EXPECT_EQ(overflow, 1u);
+  EXPECT_EQ(contended, KEYS) << "no wait is lost when keys overflow";
+  EXPECT_EQ(wait_ns, KEYS * (KEYS + 1) / 2);
+}
+
+TEST_F(LatchTest, PageLatchesReportContendedPageIds) {
+  storage::Page hot(42);
+  storage::Page cold(43);
+
+  for (int round = 0; round < 2; ++round) {
+    contend(
+        [&](auto &&body) {
+          auto lock = hot.write_lock();
+          body();
+        },
+        [&] { auto lock = hot.read_lock(); });
+  }
+  { auto lock = cold.write_lock(); }
+
+  const auto snapshot = metrics::page_latch_stats().snapshot();
+  EXPECT_EQ(snapshot.name, metrics::latch_names::PAGE);
+  EXPECT_EQ(snapshot.acquisitions, 5u);
+  EXPECT_EQ(snapshot.contended, 2u);
+  ASSERT_EQ(snapshot.top_keys.size(), 1u);
+  EXPECT_EQ(snapshot.top_keys[0].key, 42u);
+  EXPECT_EQ(snapshot.top_keys[0].contended, 2u);
+
+  bool found = false;
+  for (const auto &latch : metrics::latch_snapshot()) {
+    found = found || latch.name == metrics::latch_names::PAGE;
+  }
+  EXPECT_TRUE(found);
+}
+
+TEST_F(LatchTest, PlanCacheLatchIsRegistered) {
+  query::PlanCache cache;
+  (void)cache.statistics();
+
+  const auto snapshot =
+      metrics::latch_stats(metrics::latch_names::PLAN_CACHE).snapshot();
+  EXPECT_GE(snapshot.acquisitions, 1u);
+}
+
+TEST(LatchProfilingTest, DisabledProfilingRecordsNothing) {
+  ASSERT_FALSE(metrics::is_latch_profiling_enabled());
+  LatchStats stats("disabled");
+  InstrumentedSharedMutex latch(stats);
+
+  contend(
+      [&](auto &&body) {
+        latch.lock(5);
+        body();
+        latch.unlock();
+      },
+      [&] {
+        latch.lock(5);
+        latch.unlock();
+      });
+  latch.lock_shared();
+  latch.unlock_shared();
+
+  const auto snapshot = stats.snapshot();
+  EXPECT_EQ(snapshot.acquisitions, 0u);
+  EXPECT_EQ(snapshot.contended, 0u);
+  EXPECT_TRUE(snapshot.top_keys.empty());
+
+  metrics::set_latch_profiling(true);
+  EXPECT_TRUE(metrics::is_latch_profiling_enabled());
+  latch.lock();
+  latch.unlock();
+  metrics::set_latch_profiling(false);
+  EXPECT_EQ(stats.snapshot().acquisitions, 1u);
+}
+} // namespace
+} // namespace velox::test
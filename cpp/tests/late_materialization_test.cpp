@@ -0,0 +1,177 @@
+/**
+ * @file late_materialization_test.cpp
+ * @author Carlos Salguero
+ * @brief Tests for row id scans, IndexScan and Materialize
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "test_common.hpp"
+
+#include <random>
+
+namespace velox::test {
+namespace {
+using dtypes::TypeId;
+using dtypes::Value;
+using query::CompareOp;
+using query::ROW_ID_COLUMN;
+
+const query::Schema ITEMS{{"id", TypeId::BIGINT},
+                          {"status", TypeId::VARCHAR},
+                          {"description", TypeId::VARCHAR},
+                          {"weight", TypeId::DOUBLE}};
+
+Rows make_items(size_t count) {
+  std::mt19937_64 rng(53);
+  Rows rows;
+  for (size_t i = 0; i < count; ++i) {
+    Value description = rng() % 9 == 0
+                            ? Value(nullptr)
+                            : Value(std::string(rng() % 40, 'a' + i % 26));
+    rows.push_back({static_cast<int64_t>(i), rng() % 3 == 0 ? "open" : "done",
+                    description, static_cast<double>(rng() % 100) / 2});
+  }
+
+  return rows;
+}
+
+/// @brief Filter keeping status = 'open' over any input holding "status"
+query::OperatorPtr open_items(query::OperatorPtr input) {
+  auto status = *query::expr::column(input->schema(), "status");
+  auto predicate = *query::expr::compare(
+      CompareOp::EQ, status, query::expr::literal(std::string("open")));
+  return std::make_unique<query::Filter>(std::move(input), predicate);
+}
+
+TEST(RowIdScanTest, RowIdIsTheTableRowIndex) {
+  auto table = make_table(ITEMS, make_items(3000));
+  query::TableScan scan(table, {ROW_ID_COLUMN, 0});
+  ASSERT_EQ(scan.schema().size(), 2u);
+  EXPECT_EQ(scan.schema()[0].name, query::ROW_ID_NAME);
+
+  query::DataChunk chunk;
+  size_t rows = 0;
+  while (*scan.next(chunk)) {
+    for (size_t row = 0; row < chunk.size(); ++row) {
+      EXPECT_EQ(chunk.column(0).data<int64_t>()[row],
+                chunk.column(1).data<int64_t>()[row]);
+    }
+    rows += chunk.size();
+  }
+  EXPECT_EQ(rows, 3000u);
+}
+
+TEST(MaterializeTest, MatchesEarlyMaterialization) {
+  const auto rows = make_items(5000);
+  auto table = make_table(ITEMS, rows);
+
+  // Filter on the narrow columns, then fetch the wide ones
+  query::Materialize late(
+      open_items(std::make_unique<query::TableScan>(
+          table, std::vector<size_t>{ROW_ID_COLUMN, 1})),
+      0, table, {0, 2, 3});
+  ASSERT_EQ(late.schema().size(), 5u);
+  EXPECT_EQ(late.schema()[2].name, "id");
+
+  Rows expected;
+  for (size_t i = 0; i < rows.size(); ++i) {
+    if (std::get<std::string>(rows[i][1]) == "open") {
+      expected.push_back({static_cast<int64_t>(i), rows[i][1], rows[i][0],
+                          rows[i][2], rows[i][3]});
+    }
+  }
+  ASSERT_FALSE(expected.empty());
+  std::vector<std::string> rendered;
+  for (const auto &values : expected) {
+    rendered.push_back(render_values(values));
+  }
+  EXPECT_EQ(collect(late), rendered);
+
+  late.reset();
+  EXPECT_EQ(collect(late).size(), expected.size());
+}
+
+TEST(MaterializeTest, NullRowIdsYieldNulls) {
+  auto table = make_table(ITEMS, make_items(100));
+  const query::Schema refs{{"ref", TypeId::BIGINT}};
+  auto input = make_table(refs, {{int64_t{7}}, {nullptr}, {int64_t{8}},
+                                 {int64_t{99}}, {nullptr}});
+
+  query::Materialize materialize(std::make_unique<query::TableScan>(input), 0,
+                                 table, {0});
+  EXPECT_EQ(collect(materialize),
+            (std::vector<std::string>{"7|7", "NULL|NULL", "8|8", "99|99",
+                                      "NULL|NULL"}));
+}
+
+TEST(MaterializeTest, RejectsBadRowIdsAndColumns) {
+  auto table = make_table(ITEMS, make_items(100));
+  const query::Schema refs{{"ref", TypeId::BIGINT}, {"name", TypeId::VARCHAR}};
+  auto input = make_table(refs, {{int64_t{100}, std::string("x")}});
+  auto negative = make_table(refs, {{int64_t{-1}, std::string("x")}});
+
+  auto expect_invalid = [](query::Operator &op) {
+    query::DataChunk chunk;
+    auto more = op.next(chunk);
+    ASSERT_FALSE(more.has_value());
+    EXPECT_EQ(more.error(), error::ErrorCode::INVALID_ARGUMENT);
+  };
+
+  query::Materialize out_of_range(std::make_unique<query::TableScan>(input),
+                                  0, table, {0});
+  expect_invalid(out_of_range);
+  query::Materialize below_zero(std::make_unique<query::TableScan>(negative),
+                                0, table, {0});
+  expect_invalid(below_zero);
+  query::Materialize not_an_id(std::make_unique<query::TableScan>(input), 1,
+                               table, {0});
+  expect_invalid(not_an_id);
+  query::Materialize no_column(std::make_unique<query::TableScan>(negative),
+                               0, table, {ITEMS.size()});
+  expect_invalid(no_column);
+}
+
+TEST(IndexScanTest, ReturnsLookedUpRowsInTableOrder) {
+  const auto rows = make_items(4000);
+  auto table = make_table(ITEMS, rows);
+
+  // Unsorted ids spanning chunk boundaries, with consecutive runs
+  std::vector<size_t> ids{3999, 5, 1023, 1024, 1025, 6, 7, 2048, 0};
+  size_t lookups = 0;
+  query::IndexScan scan(
+      table, "id IN (...)",
+      [&]() -> error::Result<std::vector<size_t>> {
+        ++lookups;
+        return ids;
+      },
+      {ROW_ID_COLUMN, 0, 2});
+
+  std::sort(ids.begin(), ids.end());
+  std::vector<std::string> expected;
+  for (auto id : ids) {
+    expected.push_back(render_values(
+        {static_cast<int64_t>(id), rows[id][0], rows[id][2]}));
+  }
+  EXPECT_EQ(collect(scan), expected);
+
+  scan.reset();
+  EXPECT_EQ(collect(scan), expected);
+  EXPECT_EQ(lookups, 2u);
+}
+
+TEST(IndexScanTest, RejectsRowIdsPastTheTable) {
+  auto table = make_table(ITEMS, make_items(10));
+  query::IndexScan scan(table, "bad", [] {
+    return error::Result<std::vector<size_t>>(std::vector<size_t>{3, 10});
+  });
+  query::DataChunk chunk;
+  auto more = scan.next(chunk);
+  ASSERT_FALSE(more.has_value());
+  EXPECT_EQ(more.error(), error::ErrorCode::INVALID_ARGUMENT);
+}
+} // namespace
+} // namespace velox::test
@@ -0,0 +1,281 @@
+/**
+ * @file metrics_test.cpp
+ * @author Carlos Salguero
+ * @brief Tests for sharded counters, the HDR-style histogram layout,
+ *        percentile math and snapshot merging
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "test_common.hpp"
+
+#include <cmath>
+#include <random>
+#include <set>
+#include <thread>
+#include <velox/metrics/metrics.hpp>
+
+namespace velox::test {
+namespace {
+using metrics::HistogramSnapshot;
+using metrics::LatencyHistogram;
+
+/// @brief Values spread over several orders of magnitude
+std::vector<uint64_t> make_latencies(size_t count, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::lognormal_distribution<double> distribution(9.0, 2.0);
+  std::vector<uint64_t> values(count);
+  for (auto &value : values) {
+    value = static_cast<uint64_t>(distribution(rng));
+  }
+
+  return values;
+}
+
+/// @brief Exact value at a quantile, with the same rank rule as percentile()
+uint64_t exact_percentile(std::vector<uint64_t> values, double quantile) {
+  std::sort(values.begin(), values.end());
+  auto rank = static_cast<size_t>(
+      std::ceil(quantile * static_cast<double>(values.size())));
+  rank = std::clamp<size_t>(rank, 1, values.size());
+
+  return values[rank - 1];
+}
+
+TEST(CounterTest, ConcurrentAddsSumAcrossShards) {
+  metrics::Counter counter;
+  constexpr size_t THREADS = 8;
+  constexpr uint64_t ADDS = 100000;
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < THREADS; ++t) {
+    threads.emplace_back([&counter, t] {
+      for (uint64_t i = 0; i < ADDS; ++i) {
+        counter.add(t + 1);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(counter.value(), ADDS * THREADS * (THREADS + 1) / 2);
+  counter.reset();
+  EXPECT_EQ(counter.value(), 0u);
+}
+
+TEST(CounterTest, ConsecutiveThreadsUseDistinctShards) {
+  std::set<size_t> shards;
+  for (size_t t = 0; t < metrics::config::COUNTER_SHARDS; ++t) {
+    std::thread([&shards] {
+      shards.insert(metrics::detail::thread_shard() %
+                    metrics::config::COUNTER_SHARDS);
+    }).join();
+  }
+
+  EXPECT_EQ(shards.size(), metrics::config::COUNTER_SHARDS);
+}
+
+TEST(LatencyHistogramTest, SmallValuesHaveExactBuckets) {
+  for (uint64_t value = 0; value < LatencyHistogram::SUB_BUCKET_COUNT;
+       ++value) {
+    const auto index = LatencyHistogram::bucket_index(value);
+    EXPECT_EQ(index, value);
+    EXPECT_EQ(LatencyHistogram::bucket_lower_bound(index), value);
+    EXPECT_EQ(LatencyHistogram::bucket_upper_bound(index), value);
+  }
+}
+
+TEST(LatencyHistogramTest, BucketsTileTheRangeWithBoundedError) {
+  for (size_t index = 0; index < LatencyHistogram::BUCKET_COUNT; ++index) {
+    const auto lower = LatencyHistogram::bucket_lower_bound(index);
+    const auto upper = LatencyHistogram::bucket_upper_bound(index);
+    ASSERT_LE(lower, upper);
+    EXPECT_EQ(LatencyHistogram::bucket_index(lower), index);
+    EXPECT_EQ(LatencyHistogram::bucket_index(upper), index);
+    if (index + 1 < LatencyHistogram::BUCKET_COUNT) {
+      EXPECT_EQ(upper + 1, LatencyHistogram::bucket_lower_bound(index + 1));
+    }
+    if (index >= LatencyHistogram::SUB_BUCKET_COUNT) {
+      EXPECT_LE(upper - lower, lower / LatencyHistogram::SUB_BUCKET_COUNT)
+          << "bucket " << index;
+    }
+  }
+}
+
+TEST(LatencyHistogramTest, HugeValuesLandInTheLastBucket) {
+  const uint64_t top = uint64_t{1}
+                       << (metrics::config::HISTOGRAM_MAX_MAGNITUDE + 1);
+  EXPECT_EQ(LatencyHistogram::bucket_index(top),
+            LatencyHistogram::BUCKET_COUNT - 1);
+  EXPECT_EQ(LatencyHistogram::bucket_index(UINT64_MAX),
+            LatencyHistogram::BUCKET_COUNT - 1);
+
+  LatencyHistogram histogram;
+  histogram.record(UINT64_MAX);
+  const auto snapshot = histogram.snapshot();
+  EXPECT_EQ(snapshot.buckets.back(), 1u);
+  EXPECT_EQ(snapshot.percentile(0.5), UINT64_MAX);
+}
+
+TEST(LatencyHistogramTest, PercentilesAreWithinOneBucketOfExact) {
+  const auto values = make_latencies(20000, 7);
+  LatencyHistogram histogram;
+  for (auto value : values) {
+    histogram.record(value);
+  }
+
+  const auto snapshot = histogram.snapshot();
+  ASSERT_EQ(snapshot.count, values.size());
+  EXPECT_EQ(snapshot.min, *std::min_element(values.begin(), values.end()));
+  EXPECT_EQ(snapshot.max, *std::max_element(values.begin(), values.end()));
+
+  for (double quantile : {0.0, 0.1, 0.5, 0.9, 0.99, 0.999, 1.0}) {
+    const auto exact = exact_percentile(values, quantile);
+    const auto estimate = snapshot.percentile(quantile);
+    EXPECT_GE(estimate, exact) << "q=" << quantile;
+    EXPECT_LE(estimate, exact + exact / LatencyHistogram::SUB_BUCKET_COUNT)
+        << "q=" << quantile;
+  }
+  EXPECT_EQ(snapshot.percentile(1.0), snapshot.max);
+}
+
+TEST(LatencyHistogramTest, PercentileOfUniformRange) {
+  LatencyHistogram histogram;
+  for (uint64_t value = 1; value <= 1000; ++value) {
+    histogram.record(value);
+  }
+
+  const auto snapshot = histogram.snapshot();
+  EXPECT_DOUBLE_EQ(snapshot.mean(), 500.5);
+  // 500 falls in [496, 503]; the percentile reports the bucket's top
+  EXPECT_EQ(snapshot.percentile(0.5), 503u);
+  EXPECT_EQ(snapshot.percentile(0.999), 1000u);
+  EXPECT_EQ(snapshot.percentile(-1.0), 1u);
+  EXPECT_EQ(snapshot.percentile(2.0), 1000u);
+}
+
+TEST(LatencyHistogramTest, EmptySnapshot) {
+  LatencyHistogram histogram;
+  const auto snapshot = histogram.snapshot();
+  EXPECT_EQ(snapshot.count, 0u);
+  EXPECT_EQ(snapshot.min, 0u);
+  EXPECT_EQ(snapshot.percentile(0.99), 0u);
+  EXPECT_EQ(snapshot.mean(), 0.0);
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecordsAreAllCounted) {
+  LatencyHistogram histogram;
+  constexpr size_t THREADS = 8;
+  constexpr uint64_t RECORDS = 20000;
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < THREADS; ++t) {
+    threads.emplace_back([&histogram, t] {
+      for (uint64_t i = 0; i < RECORDS; ++i) {
+        histogram.record(1 + t * RECORDS + i);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  const auto snapshot = histogram.snapshot();
+  const uint64_t n = THREADS * RECORDS;
+  EXPECT_EQ(snapshot.count, n);
+  EXPECT_EQ(snapshot.sum, n * (n + 1) / 2);
+  EXPECT_EQ(snapshot.min, 1u);
+  EXPECT_EQ(snapshot.max, n);
+}
+
+TEST(HistogramSnapshotTest, MergeMatchesRecordingEverything) {
+  const auto low = make_latencies(5000, 1);
+  auto high = make_latencies(5000, 2);
+  for (auto &value : high) {
+    value += 1'000'000;
+  }
+
+  LatencyHistogram a;
+  LatencyHistogram b;
+  LatencyHistogram both;
+  for (auto value : low) {
+    a.record(value);
+    both.record(value);
+  }
+  for (auto value : high) {
+    b.record(value);
+    both.record(value);
+  }
+
+  auto merged = a.snapshot();
+  merged.merge(b.snapshot());
+  const auto expected = both.snapshot();
+  EXPECT_EQ(merged.buckets, expected.buckets);
+  EXPECT_EQ(merged.count, expected.count);
+  EXPECT_EQ(merged.sum, expected.sum);
+  EXPECT_EQ(merged.min, expected.min);
+  EXPECT_EQ(merged.max, expected.max);
+  for (double quantile : {0.5, 0.9, 0.99}) {
+    EXPECT_EQ(merged.percentile(quantile), expected.percentile(quantile));
+  }
+}
+
+TEST(HistogramSnapshotTest, MergeWithEmpty) {
+  LatencyHistogram histogram;
+  histogram.record(40);
+  histogram.record(4000);
+  const auto snapshot = histogram.snapshot();
+
+  // Into a default snapshot: takes the other's min instead of 0
+  HistogramSnapshot merged;
+  merged.merge(snapshot);
+  EXPECT_EQ(merged.buckets, snapshot.buckets);
+  EXPECT_EQ(merged.min, 40u);
+  EXPECT_EQ(merged.max, 4000u);
+
+  // An empty snapshot changes nothing
+  merged.merge(LatencyHistogram().snapshot());
+  EXPECT_EQ(merged.count, 2u);
+  EXPECT_EQ(merged.min, 40u);
+}
+
+TEST(MetricsRegistryTest, HandlesAreStableAndSnapshotsSorted) {
+  metrics::MetricsRegistry registry;
+  auto &counter = registry.get_counter("b_total");
+  EXPECT_EQ(&counter, &registry.get_counter("b_total"));
+  counter.add(3);
+  registry.counter("a_total", 2.9);
+  registry.gauge("depth", -1.5);
+  registry.histogram("op_ns", 1200.0);
+
+  const auto snapshot = registry.get_metrics();
+  ASSERT_EQ(snapshot.counters.size(), 2u);
+  EXPECT_EQ(snapshot.counters[0].name, "a_total");
+  EXPECT_EQ(snapshot.counters[0].value, 2u);
+  EXPECT_EQ(snapshot.counters[1].value, 3u);
+  ASSERT_EQ(snapshot.gauges.size(), 1u);
+  EXPECT_EQ(snapshot.gauges[0].value, -1.5);
+  ASSERT_NE(snapshot.find_histogram("op_ns"), nullptr);
+  EXPECT_EQ(snapshot.find_histogram("op_ns")->data.count, 1u);
+  EXPECT_EQ(snapshot.find_histogram("missing"), nullptr);
+
+  registry.reset();
+  EXPECT_EQ(registry.get_counter("b_total").value(), 0u);
+}
+
+TEST(ScopedLatencyTest, RecordsOnlyWhenEnabled) {
+  LatencyHistogram histogram;
+  { metrics::ScopedLatency timer(histogram); }
+  EXPECT_EQ(histogram.snapshot().count, 1u);
+
+  metrics::set_enabled(false);
+  { metrics::ScopedLatency timer(histogram); }
+  metrics::set_enabled(true);
+  EXPECT_EQ(histogram.snapshot().count, 1u);
+}
+} // namespace
+} // namespace velox::test
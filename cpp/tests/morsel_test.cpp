@@ -0,0 +1,274 @@
+/**
+ * @file morsel_test.cpp
+ * @author Carlos Salguero
+ * @brief Tests for the morsel queue and morsel-driven scan pipelines
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "test_common.hpp"
+
+#include <random>
+#include <thread>
+#include <velox/query/morsel.hpp>
+#include <velox/query/worker_pool.hpp>
+
+namespace velox::test {
+namespace {
+using dtypes::TypeId;
+using dtypes::Value;
+using query::CompareOp;
+using namespace std::chrono_literals;
+
+const query::Schema VISITS{{"id", TypeId::BIGINT},
+                           {"site", TypeId::VARCHAR},
+                           {"bytes", TypeId::INTEGER}};
+
+Rows make_visits(size_t count) {
+  std::mt19937_64 rng(41);
+  Rows rows;
+  for (size_t i = 0; i < count; ++i) {
+    Value bytes = rng() % 11 == 0
+                      ? Value(nullptr)
+                      : Value(static_cast<int32_t>(rng() % 10000));
+    rows.push_back({static_cast<int64_t>(i), fmt::format("s{}", rng() % 50),
+                    bytes});
+  }
+
+  return rows;
+}
+
+TEST(MorselQueueTest, HandsOutEveryChunkOnce) {
+  for (size_t chunks : {0, 1, 15, 16, 17, 1000}) {
+    for (size_t morsel_chunks : {0, 1, 3, 64}) {
+      for (size_t stripes : {1, 2, 3}) {
+        query::MorselQueue queue(chunks, morsel_chunks, stripes);
+        std::vector<std::atomic<int>> claims(chunks);
+        std::vector<std::thread> workers;
+        for (size_t w = 0; w < 4; ++w) {
+          workers.emplace_back([&, w] {
+            while (auto morsel = queue.next(w)) {
+              EXPECT_LT(morsel->first, morsel->end);
+              for (size_t c = morsel->first; c < morsel->end; ++c) {
+                claims[c].fetch_add(1);
+              }
+            }
+          });
+        }
+        for (auto &worker : workers) {
+          worker.join();
+        }
+        for (size_t c = 0; c < chunks; ++c) {
+          EXPECT_EQ(claims[c].load(), 1)
+              << "chunk " << c << " of " << chunks << ", morsel "
+              << morsel_chunks << ", stripes " << stripes;
+        }
+      }
+    }
+  }
+}
+
+TEST(MorselQueueTest, WorkerStealsFromOtherStripes) {
+  query::MorselQueue queue(100, 4, 3);
+  EXPECT_EQ(queue.stripes(), 3u);
+
+  // One worker drains its home stripe, then every other one
+  size_t claimed = 0;
+  while (auto morsel = queue.next(1)) {
+    claimed += morsel->end - morsel->first;
+  }
+  EXPECT_EQ(claimed, 100u);
+}
+
+TEST(MorselQueueTest, CloseStopsHandingOut) {
+  query::MorselQueue queue(100, 4, 2);
+  ASSERT_TRUE(queue.next(0).has_value());
+  queue.close();
+  EXPECT_FALSE(queue.next(0).has_value());
+  EXPECT_FALSE(queue.next(1).has_value());
+}
+
+/// @brief Keep the visits of at least 5000 bytes
+error::Result<query::OperatorPtr> filter_pipeline(query::OperatorPtr scan) {
+  const auto schema = scan->schema();
+  auto bytes = query::expr::column(schema, "bytes");
+  if (!bytes) {
+    return tl::unexpected(bytes.error());
+  }
+  auto predicate = query::expr::compare(CompareOp::GE, *bytes,
+                                        query::expr::literal(int32_t{5000}));
+  if (!predicate) {
+    return tl::unexpected(predicate.error());
+  }
+  return std::make_unique<query::Filter>(std::move(scan), *predicate);
+}
+
+TEST(MorselGatherTest, MatchesSingleThreadedPipeline) {
+  auto table = make_table(VISITS, make_visits(60000));
+
+  auto reference = filter_pipeline(std::make_unique<query::TableScan>(table));
+  ASSERT_TRUE(reference.has_value());
+  const auto expected = collect_sorted(**reference);
+  ASSERT_FALSE(expected.empty());
+
+  for (size_t threads : {1, 2, 4}) {
+    for (size_t morsel_chunks : {0, 1, 5}) {
+      query::MorselOptions options;
+      options.threads = threads;
+      options.morsel_chunks = morsel_chunks;
+      query::MorselGather gather(table, {}, filter_pipeline, options);
+      EXPECT_EQ(collect_sorted(gather), expected)
+          << threads << " threads, " << morsel_chunks << " chunks";
+
+      gather.reset();
+      EXPECT_EQ(collect_sorted(gather), expected);
+    }
+  }
+}
+
+TEST(MorselGatherTest, ProjectionAndIdentityPipeline) {
+  auto table = make_table(VISITS, make_visits(5000));
+  query::TableScan scan(table, {2, 0});
+  const auto expected = collect_sorted(scan);
+
+  query::MorselOptions options;
+  options.threads = 3;
+  options.morsel_chunks = 1;
+  query::MorselGather gather(
+      table, {2, 0},
+      [](query::OperatorPtr scan) -> error::Result<query::OperatorPtr> {
+        return scan;
+      },
+      options);
+  EXPECT_EQ(gather.schema().size(), 2u);
+  EXPECT_EQ(collect_sorted(gather), expected);
+}
+
+/// @brief Passes chunks through, counting those produced
+class CountingOperator final : public query::Operator {
+public:
+  CountingOperator(query::OperatorPtr child, std::atomic<size_t> &produced)
+      : Operator(child->schema()), m_child(std::move(child)),
+        m_produced(produced) {}
+
+  [[nodiscard]] error::Result<bool> next(query::DataChunk &output) override {
+    auto more = m_child->next(output);
+    if (more && *more) {
+      m_produced.fetch_add(1);
+    }
+    return more;
+  }
+  void reset() override { m_child->reset(); }
+  [[nodiscard]] std::string name() const override { return "Counting"; }
+
+private:
+  query::OperatorPtr m_child;
+  std::atomic<size_t> &m_produced;
+};
+
+TEST(MorselGatherTest, BuffersAtMostQueueChunks) {
+  auto table =
+      make_table(VISITS, make_visits(200 * query::config::VECTOR_SIZE));
+  std::atomic<size_t> produced{0};
+  query::MorselOptions options;
+  options.threads = 4;
+  options.morsel_chunks = 1;
+  options.queue_chunks = 2;
+  query::MorselGather gather(
+      table, {},
+      [&](query::OperatorPtr scan) -> error::Result<query::OperatorPtr> {
+        return std::make_unique<CountingOperator>(std::move(scan), produced);
+      },
+      options);
+
+  query::DataChunk chunk;
+  ASSERT_TRUE(gather.next(chunk).value_or(false));
+  std::this_thread::sleep_for(50ms);
+
+  // The chunk returned, a full queue and one chunk in hand per worker
+  const size_t threads = std::min(options.threads,
+                                  query::WorkerPool::shared().concurrency());
+  EXPECT_LE(produced.load(), 1 + options.queue_chunks + threads);
+
+  size_t rows = chunk.size();
+  while (gather.next(chunk).value_or(false)) {
+    rows += chunk.size();
+  }
+  EXPECT_EQ(rows, table->row_count());
+  EXPECT_EQ(produced.load(), table->chunk_count());
+
+  // Stopping mid-stream releases workers waiting on the full queue
+  gather.reset();
+  ASSERT_TRUE(gather.next(chunk).value_or(false));
+  gather.reset();
+  EXPECT_LT(produced.load(), 2 * table->chunk_count());
+}
+
+TEST(MorselGatherTest, EmptyTable) {
+  auto table = make_table(VISITS, {});
+  query::MorselGather gather(table, {}, filter_pipeline);
+  EXPECT_TRUE(collect(gather).empty());
+}
+
+TEST(RunMorselsTest, SinkSeesEveryRowOnce) {
+  auto table = make_table(VISITS, make_visits(20000));
+  std::vector<std::atomic<int>> seen(table->row_count());
+  query::MorselOptions options;
+  options.threads = 4;
+  options.morsel_chunks = 2;
+  auto status = query::run_morsels(
+      table, {0},
+      [](query::OperatorPtr scan) -> error::Result<query::OperatorPtr> {
+        return scan;
+      },
+      [&](size_t, query::DataChunk &chunk) -> error::VoidResult {
+        const auto *ids = chunk.column(0).data<int64_t>();
+        for (size_t row = 0; row < chunk.size(); ++row) {
+          seen[ids[row]].fetch_add(1);
+        }
+        return error::ok();
+      },
+      options);
+  ASSERT_TRUE(status.has_value());
+  for (const auto &count : seen) {
+    EXPECT_EQ(count.load(), 1);
+  }
+}
+
+TEST(RunMorselsTest, ReportsFactoryAndSinkErrors) {
+  auto table = make_table(VISITS, make_visits(20000));
+  query::MorselOptions options;
+  options.threads = 4;
+
+  auto factory_failed = query::run_morsels(
+      table, {},
+      [](query::OperatorPtr) -> error::Result<query::OperatorPtr> {
+        return error::error<query::OperatorPtr>(
+            error::ErrorCode::NOT_IMPLEMENTED);
+      },
+      [](size_t, query::DataChunk &) { return error::ok(); }, options);
+  ASSERT_FALSE(factory_failed.has_value());
+  EXPECT_EQ(factory_failed.error(), error::ErrorCode::NOT_IMPLEMENTED);
+
+  auto sink_failed = query::run_morsels(
+      table, {}, filter_pipeline,
+      [](size_t, query::DataChunk &) {
+        return error::error<void>(error::ErrorCode::DISK_FULL);
+      },
+      options);
+  ASSERT_FALSE(sink_failed.has_value());
+  EXPECT_EQ(sink_failed.error(), error::ErrorCode::DISK_FULL);
+
+  query::MorselGather gather(table, {}, [](query::OperatorPtr) {
+    return error::error<query::OperatorPtr>(error::ErrorCode::INVALID_ARGUMENT);
+  });
+  query::DataChunk chunk;
+  auto more = gather.next(chunk);
+  ASSERT_FALSE(more.has_value());
+  EXPECT_EQ(more.error(), error::ErrorCode::INVALID_ARGUMENT);
+}
+} // namespace
+} // namespace velox::test
@@ -0,0 +1,382 @@
+/**
+ * @file optimizer_test.cpp
+ * @author Carlos Salguero
+ * @brief Tests for the QueryOptimizer's DPccp join enumeration against
+ *        costing every join tree, and for the plans it builds
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "test_common.hpp"
+
+#include <bit>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <random>
+#include <velox/query/optimizer.hpp>
+
+namespace velox::test {
+namespace {
+using dtypes::TypeId;
+using dtypes::Value;
+
+const query::Schema KEYS{{"k0", TypeId::BIGINT},
+                         {"k1", TypeId::BIGINT},
+                         {"k2", TypeId::BIGINT}};
+
+using Edges = std::vector<std::pair<size_t, size_t>>;
+
+Edges chain(size_t n) {
+  Edges edges;
+  for (size_t i = 0; i + 1 < n; ++i) {
+    edges.emplace_back(i, i + 1);
+  }
+  return edges;
+}
+
+Edges star(size_t n) {
+  Edges edges;
+  for (size_t i = 1; i < n; ++i) {
+    edges.emplace_back(0, i);
+  }
+  return edges;
+}
+
+Edges cycle(size_t n) {
+  auto edges = chain(n);
+  edges.emplace_back(n - 1, 0);
+  return edges;
+}
+
+Edges clique(size_t n) {
+  Edges edges;
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = i + 1; j < n; ++j) {
+      edges.emplace_back(i, j);
+    }
+  }
+  return edges;
+}
+
+/// @brief A spanning chain over a shuffled order plus random extra edges
+Edges random_graph(size_t n, std::mt19937_64 &rng) {
+  std::vector<size_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::shuffle(order.begin(), order.end(), rng);
+  Edges edges;
+  for (size_t i = 0; i + 1 < n; ++i) {
+    edges.emplace_back(order[i], order[i + 1]);
+  }
+  for (size_t extra = rng() % n; extra > 0; --extra) {
+    const size_t a = rng() % n;
+    const size_t b = rng() % n;
+    if (a != b) {
+      edges.emplace_back(a, b);
+    }
+  }
+  return edges;
+}
+
+/**
+ * @brief Query over placeholder tables whose statistics vary by orders of
+ *        magnitude, so join orders differ widely in cost
+ */
+query::JoinQuery make_query(const Edges &edges, size_t n,
+                            std::mt19937_64 &rng) {
+  static const auto table = make_table(KEYS, {{int64_t{1}, int64_t{1},
+                                               int64_t{1}}});
+  query::JoinQuery query;
+  for (size_t r = 0; r < n; ++r) {
+    query::TableStatistics statistics;
+    statistics.rows = static_cast<double>(10 << (rng() % 14));
+    statistics.columns.resize(KEYS.size());
+    for (auto &column : statistics.columns) {
+      column.type = dtypes::TypeInfo(TypeId::BIGINT);
+      column.distinct = std::max(1.0, statistics.rows /
+                                          static_cast<double>(1 << (rng() % 8)));
+      column.null_fraction = rng() % 4 == 0 ? 0.25 : 0;
+    }
+    query.relations.push_back(
+        {fmt::format("t{}", r), table, {}, {}, std::move(statistics)});
+  }
+  for (const auto &[left, right] : edges) {
+    query.joins.push_back(
+        {left, rng() % KEYS.size(), right, rng() % KEYS.size()});
+  }
+  return query;
+}
+
+/**
+ * @brief Every join tree of a query without cross products
+ *
+ * @note Trees are built bottom-up over relation sets; each set is split
+ *       into two connected halves sharing an edge. Mirror images cost the
+ *       same, so only the split keeping the lowest relation on the left
+ *       is generated.
+ */
+class BruteForce {
+public:
+  explicit BruteForce(const query::JoinQuery &query) : m_query(query) {}
+
+  const std::vector<query::JoinOrder> &trees(uint64_t set) {
+    if (auto it = m_trees.find(set); it != m_trees.end()) {
+      return it->second;
+    }
+
+    std::vector<query::JoinOrder> result;
+    if (std::has_single_bit(set)) {
+      query::JoinOrder leaf;
+      leaf.nodes.push_back({static_cast<size_t>(std::countr_zero(set)),
+                            query::JoinOrder::LEAF, query::JoinOrder::LEAF});
+      result.push_back(std::move(leaf));
+    } else {
+      const uint64_t lowest = set & (~set + 1);
+      for (uint64_t left = (set - 1) & set; left != 0;
+           left = (left - 1) & set) {
+        const uint64_t right = set & ~left;
+        if ((left & lowest) == 0 || !connected(left) || !connected(right) ||
+            !adjacent(left, right)) {
+          continue;
+        }
+        for (const auto &l : trees(left)) {
+          for (const auto &r : trees(right)) {
+            result.push_back(combine(l, r));
+          }
+        }
+      }
+    }
+
+    return m_trees.emplace(set, std::move(result)).first->second;
+  }
+
+private:
+  bool adjacent(uint64_t left, uint64_t right) const {
+    for (const auto &edge : m_query.joins) {
+      const uint64_t a = uint64_t{1} << edge.left;
+      const uint64_t b = uint64_t{1} << edge.right;
+      if (((left & a) && (right & b)) || ((left & b) && (right & a))) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool connected(uint64_t set) const {
+    uint64_t reached = set & (~set + 1);
+    for (bool grew = true; grew;) {
+      grew = false;
+      for (const auto &edge : m_query.joins) {
+        const uint64_t a = uint64_t{1} << edge.left;
+        const uint64_t b = uint64_t{1} << edge.right;
+        if ((set & a) && (set & b) && ((reached & a) != 0) !=
+                                          ((reached & b) != 0)) {
+          reached |= a | b;
+          grew = true;
+        }
+      }
+    }
+    return reached == set;
+  }
+
+  static query::JoinOrder combine(const query::JoinOrder &left,
+                                  const query::JoinOrder &right) {
+    query::JoinOrder order = left;
+    const size_t shift = left.nodes.size();
+    for (auto node : right.nodes) {
+      if (node.left != query::JoinOrder::LEAF) {
+        node.left += shift;
+        node.right += shift;
+      }
+      order.nodes.push_back(node);
+    }
+    order.nodes.push_back({0, shift - 1, order.nodes.size() - 1});
+    return order;
+  }
+
+  const query::JoinQuery &m_query;
+  std::map<uint64_t, std::vector<query::JoinOrder>> m_trees;
+};
+
+struct Shape {
+  const char *name;
+  Edges (*edges)(size_t);
+};
+
+class DPccpTest : public ::testing::TestWithParam<Shape> {};
+
+TEST_P(DPccpTest, FindsTheCheapestJoinTree) {
+  std::mt19937_64 rng(83);
+  const query::QueryOptimizer optimizer;
+
+  for (size_t n = 2; n <= 6; ++n) {
+    for (size_t trial = 0; trial < 4; ++trial) {
+      const auto query = make_query(GetParam().edges(n), n, rng);
+      auto best = optimizer.optimize(query);
+      ASSERT_TRUE(best.has_value()) << n;
+
+      BruteForce brute(query);
+      const auto &trees = brute.trees((uint64_t{1} << n) - 1);
+      ASSERT_FALSE(trees.empty());
+      double cheapest = std::numeric_limits<double>::infinity();
+      for (const auto &tree : trees) {
+        auto plan = optimizer.optimize(query, tree);
+        ASSERT_TRUE(plan.has_value());
+        EXPECT_EQ(plan->estimated_rows, best->estimated_rows);
+        cheapest = std::min(cheapest, plan->estimated_cost);
+      }
+      EXPECT_NEAR(best->estimated_cost, cheapest, 1e-9 * cheapest)
+          << GetParam().name << " n=" << n << " trial=" << trial << " over "
+          << trees.size() << " trees";
+
+      // The order found replans to the same cost
+      auto order = optimizer.order(query);
+      ASSERT_TRUE(order.has_value());
+      auto replanned = optimizer.optimize(query, *order);
+      ASSERT_TRUE(replanned.has_value());
+      EXPECT_EQ(replanned->estimated_cost, best->estimated_cost);
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    JoinGraphs, DPccpTest,
+    ::testing::Values(Shape{"chain", chain}, Shape{"star", star},
+                      Shape{"cycle", cycle}, Shape{"clique", clique}),
+    [](const auto &info) { return std::string(info.param.name); });
+
+TEST(DPccpRandomTest, FindsTheCheapestJoinTree) {
+  std::mt19937_64 rng(89);
+  const query::QueryOptimizer optimizer;
+  for (size_t trial = 0; trial < 40; ++trial) {
+    const size_t n = 3 + trial % 5;
+    const auto query = make_query(random_graph(n, rng), n, rng);
+    auto best = optimizer.optimize(query);
+    ASSERT_TRUE(best.has_value());
+
+    BruteForce brute(query);
+    double cheapest = std::numeric_limits<double>::infinity();
+    for (const auto &tree : brute.trees((uint64_t{1} << n) - 1)) {
+      auto plan = optimizer.optimize(query, tree);
+      ASSERT_TRUE(plan.has_value());
+      cheapest = std::min(cheapest, plan->estimated_cost);
+    }
+    EXPECT_NEAR(best->estimated_cost, cheapest, 1e-9 * cheapest)
+        << "trial " << trial;
+  }
+}
+
+TEST(GreedyOrderTest, NeverBeatsDPccp) {
+  std::mt19937_64 rng(97);
+  const query::QueryOptimizer exhaustive;
+  query::OptimizerOptions options;
+  options.dp_limit = 1;
+  const query::QueryOptimizer greedy(options);
+
+  for (size_t trial = 0; trial < 20; ++trial) {
+    const size_t n = 2 + trial % 6;
+    const auto query = make_query(random_graph(n, rng), n, rng);
+    auto best = exhaustive.optimize(query);
+    auto fast = greedy.optimize(query);
+    ASSERT_TRUE(best.has_value());
+    ASSERT_TRUE(fast.has_value());
+    EXPECT_GE(fast->estimated_cost, best->estimated_cost * (1 - 1e-9));
+    EXPECT_EQ(fast->estimated_rows, best->estimated_rows);
+  }
+}
+
+TEST(OptimizerTest, PlanReturnsTheJoinResult) {
+  std::mt19937_64 rng(101);
+  const size_t sizes[] = {300, 40, 900, 7};
+  std::vector<Rows> data;
+  query::JoinQuery query;
+  for (size_t r = 0; r < 4; ++r) {
+    Rows rows;
+    for (size_t i = 0; i < sizes[r]; ++i) {
+      Value key = rng() % 15 == 0 ? Value(nullptr)
+                                  : Value(static_cast<int64_t>(rng() % 30));
+      rows.push_back({key, static_cast<int64_t>(rng() % 20),
+                      static_cast<int64_t>(i)});
+    }
+    query.relations.push_back(
+        {fmt::format("t{}", r), make_table(KEYS, rows), {}, {}, {}});
+    data.push_back(std::move(rows));
+  }
+  // t0.k0 = t1.k0, t1.k1 = t2.k1, t0.k0 = t3.k0
+  query.joins = {{0, 0, 1, 0}, {1, 1, 2, 1}, {0, 0, 3, 0}};
+  query.relations[2].predicates = {{0, query::CompareOp::LT, int64_t{10}}};
+  query.output = {{3, 2}, {0, 2}, {2, 0}, {1, 2}};
+
+  auto equal = [](const Value &a, const Value &b) {
+    return !is_null_value(a) && !is_null_value(b) &&
+           std::get<int64_t>(a) == std::get<int64_t>(b);
+  };
+  Rows expected;
+  for (const auto &a : data[0]) {
+    for (const auto &b : data[1]) {
+      if (!equal(a[0], b[0])) {
+        continue;
+      }
+      for (const auto &c : data[2]) {
+        if (!equal(b[1], c[1]) || is_null_value(c[0]) ||
+            std::get<int64_t>(c[0]) >= 10) {
+          continue;
+        }
+        for (const auto &d : data[3]) {
+          if (equal(a[0], d[0])) {
+            expected.push_back({d[2], a[2], c[0], b[2]});
+          }
+        }
+      }
+    }
+  }
+  ASSERT_FALSE(expected.empty());
+
+  auto plan = query::QueryOptimizer().optimize(query);
+  ASSERT_TRUE(plan.has_value());
+  ASSERT_EQ(plan->schema().size(), 4u);
+  EXPECT_EQ(plan->schema()[0].name, "t3.k2");
+  EXPECT_GT(plan->estimated_cost, 0);
+  EXPECT_EQ(collect_sorted(*plan->root), render_sorted(expected));
+}
+
+TEST(OptimizerTest, RejectsMalformedQueriesAndOrders) {
+  std::mt19937_64 rng(103);
+  const query::QueryOptimizer optimizer;
+
+  auto disconnected = make_query({{0, 1}, {2, 3}}, 4, rng);
+  auto plan = optimizer.optimize(disconnected);
+  ASSERT_FALSE(plan.has_value());
+  EXPECT_EQ(plan.error(), error::ErrorCode::NOT_IMPLEMENTED);
+
+  auto bad_edge = make_query({{0, 1}}, 2, rng);
+  bad_edge.joins.push_back({0, 0, 2, 0});
+  plan = optimizer.optimize(bad_edge);
+  ASSERT_FALSE(plan.has_value());
+  EXPECT_EQ(plan.error(), error::ErrorCode::INVALID_ARGUMENT);
+
+  const auto query = make_query(chain(3), 3, rng);
+  using Node = query::JoinOrder::Node;
+  constexpr size_t LEAF = query::JoinOrder::LEAF;
+  const std::vector<query::JoinOrder> invalid{
+      {},
+      // Cross product of t0 and t2
+      {{Node{0, LEAF, LEAF}, Node{2, LEAF, LEAF}, Node{0, 0, 1},
+        Node{1, LEAF, LEAF}, Node{0, 2, 3}}},
+      // t1 twice, t2 never
+      {{Node{0, LEAF, LEAF}, Node{1, LEAF, LEAF}, Node{0, 0, 1},
+        Node{1, LEAF, LEAF}, Node{0, 2, 3}}},
+      // Parent before its children
+      {{Node{0, 3, 4}, Node{0, LEAF, LEAF}, Node{1, LEAF, LEAF},
+        Node{0, 1, 2}, Node{2, LEAF, LEAF}}}};
+  for (size_t i = 0; i < invalid.size(); ++i) {
+    plan = optimizer.optimize(query, invalid[i]);
+    ASSERT_FALSE(plan.has_value()) << i;
+    EXPECT_EQ(plan.error(), error::ErrorCode::INVALID_ARGUMENT) << i;
+  }
+}
+} // namespace
+} // namespace velox::test
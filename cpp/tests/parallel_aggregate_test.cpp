@@ -0,0 +1,180 @@
+/**
+ * @file parallel_aggregate_test.cpp
+ * @author Carlos Salguero
+ * @brief Tests for ParallelHashAggregate against HashAggregate, in memory
+ *        and spilling, and for SUM overflow in both
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "test_common.hpp"
+
+#include <limits>
+#include <random>
+
+namespace velox::test {
+namespace {
+using dtypes::TypeId;
+using dtypes::Value;
+using query::AggregateFunction;
+
+const query::Schema SALES{{"region", TypeId::INTEGER},
+                          {"product", TypeId::VARCHAR},
+                          {"quantity", TypeId::BIGINT},
+                          {"price", TypeId::DOUBLE}};
+
+const std::vector<query::AggregateSpec> AGGREGATES{
+    {AggregateFunction::COUNT_STAR, 0, ""},
+    {AggregateFunction::COUNT, 1, ""},
+    {AggregateFunction::SUM, 2, ""},
+    {AggregateFunction::SUM, 3, ""},
+    {AggregateFunction::AVG, 2, ""},
+    {AggregateFunction::MIN, 1, ""},
+    {AggregateFunction::MAX, 3, ""}};
+
+/// @brief Sales rows; prices are multiples of 1/4 so sums are exact
+Rows make_sales(size_t count, size_t regions) {
+  std::mt19937_64 rng(17);
+  Rows rows;
+  for (size_t i = 0; i < count; ++i) {
+    Value region = rng() % 53 == 0
+                       ? Value(nullptr)
+                       : Value(static_cast<int32_t>(rng() % regions));
+    Value product = rng() % 47 == 0 ? Value(nullptr)
+                                    : Value(fmt::format("p{}", rng() % 7));
+    Value quantity = rng() % 31 == 0
+                         ? Value(nullptr)
+                         : Value(static_cast<int64_t>(rng() % 1000) - 300);
+    Value price = static_cast<double>(rng() % 4000) / 4;
+    rows.push_back({region, product, quantity, price});
+  }
+
+  return rows;
+}
+
+struct AggregateCase {
+  const char *name;
+  std::vector<size_t> group_by;
+  bool spill;
+};
+
+class ParallelHashAggregateTest
+    : public ::testing::TestWithParam<AggregateCase> {};
+
+TEST_P(ParallelHashAggregateTest, MatchesHashAggregate) {
+  const auto &param = GetParam();
+  auto table = make_table(SALES, make_sales(80000, 20000));
+
+  query::HashAggregate reference(std::make_unique<query::TableScan>(table),
+                                 param.group_by, AGGREGATES);
+  const auto expected = collect_sorted(reference);
+
+  TempDirectory directory("parallel_aggregate");
+  query::ParallelAggregateOptions options;
+  options.threads = 4;
+  options.partition_bits = 1;
+  if (param.spill) {
+    // Far below a partition, so merging splits partitions recursively
+    options.memory_budget = 32 * 1024;
+    options.spill_directory = directory.path();
+  }
+  query::ParallelHashAggregate aggregate(
+      std::make_unique<query::TableScan>(table), param.group_by, AGGREGATES,
+      options);
+  EXPECT_EQ(collect_sorted(aggregate), expected);
+
+  aggregate.reset();
+  EXPECT_EQ(collect_sorted(aggregate), expected);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Groupings, ParallelHashAggregateTest,
+    ::testing::Values(AggregateCase{"global_memory", {}, false},
+                      AggregateCase{"global_spill", {}, true},
+                      AggregateCase{"int_key_memory", {0}, false},
+                      AggregateCase{"int_key_spill", {0}, true},
+                      AggregateCase{"two_keys_memory", {1, 0}, false},
+                      AggregateCase{"two_keys_spill", {1, 0}, true}),
+    [](const auto &info) { return std::string(info.param.name); });
+
+TEST(ParallelHashAggregateEmptyTest, GlobalAggregateYieldsOneRow) {
+  auto table = make_table(SALES, {});
+  query::ParallelAggregateOptions options;
+  options.memory_budget = 1024;
+  query::ParallelHashAggregate aggregate(
+      std::make_unique<query::TableScan>(table), {},
+      {{AggregateFunction::COUNT_STAR, 0, ""},
+       {AggregateFunction::SUM, 2, ""}},
+      options);
+  EXPECT_EQ(collect(aggregate), (std::vector<std::string>{"0|NULL"}));
+}
+
+/// @brief Run an operator until it fails, returning the error
+error::ErrorCode first_error(query::Operator &op) {
+  query::DataChunk chunk;
+  while (true) {
+    auto more = op.next(chunk);
+    if (!more) {
+      return more.error();
+    }
+    if (!*more) {
+      return error::ErrorCode::SUCCESS;
+    }
+  }
+}
+
+class SumOverflowTest : public ::testing::TestWithParam<bool> {};
+
+TEST_P(SumOverflowTest, BigintSumOverflowFails) {
+  const bool grouped = GetParam();
+  const std::vector<size_t> group_by =
+      grouped ? std::vector<size_t>{0} : std::vector<size_t>{};
+  const std::vector<query::AggregateSpec> sum{{AggregateFunction::SUM, 2, ""}};
+
+  // 4096 rows summing to about 1.4 * INT64_MAX; every chunk fits
+  constexpr int64_t VALUE = std::numeric_limits<int64_t>::max() / 3000;
+  Rows rows;
+  for (int32_t i = 0; i < 4096; ++i) {
+    rows.push_back({int32_t{1}, std::string("p"), VALUE, 1.0});
+  }
+  auto overflowing = make_table(SALES, rows);
+  rows.resize(3000);
+  auto fitting = make_table(SALES, rows);
+
+  for (const auto &table : {overflowing, fitting}) {
+    const auto expected = table == overflowing
+                              ? error::ErrorCode::NUMERIC_OVERFLOW
+                              : error::ErrorCode::SUCCESS;
+    query::HashAggregate serial(std::make_unique<query::TableScan>(table),
+                                group_by, sum);
+    EXPECT_EQ(first_error(serial), expected);
+
+    query::ParallelAggregateOptions options;
+    options.threads = 4;
+    query::ParallelHashAggregate parallel(
+        std::make_unique<query::TableScan>(table), group_by, sum, options);
+    EXPECT_EQ(first_error(parallel), expected);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Groupings, SumOverflowTest, ::testing::Bool(),
+                         [](const auto &info) {
+                           return std::string(info.param ? "grouped"
+                                                         : "global");
+                         });
+
+TEST(SumOverflowTest, NegativeOverflowFails) {
+  Rows rows;
+  rows.push_back({int32_t{1}, std::string("p"),
+                  std::numeric_limits<int64_t>::min(), 1.0});
+  rows.push_back({int32_t{1}, std::string("p"), int64_t{-1}, 1.0});
+  query::HashAggregate aggregate(
+      std::make_unique<query::TableScan>(make_table(SALES, rows)), {0},
+      {{AggregateFunction::SUM, 2, ""}});
+  EXPECT_EQ(first_error(aggregate), error::ErrorCode::NUMERIC_OVERFLOW);
+}
+} // namespace
+} // namespace velox::test
@@ -0,0 +1,311 @@
+/**
+ * @file plan_cache_test.cpp
+ * @author Carlos Salguero
+ * @brief Tests for query fingerprints, the PlanCache and prepared
+ *        statements
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "test_common.hpp"
+
+#include <memory>
+#include <random>
+#include <velox/query/plan_cache.hpp>
+
+namespace velox::test {
+namespace {
+using dtypes::TypeId;
+using dtypes::Value;
+using query::CompareOp;
+
+const query::Schema CUSTOMERS{{"id", TypeId::BIGINT},
+                              {"country", TypeId::INTEGER}};
+const query::Schema ORDERS{{"customer", TypeId::BIGINT},
+                           {"amount", TypeId::INTEGER}};
+
+std::shared_ptr<query::ColumnarTable> make_customers(size_t count) {
+  Rows rows;
+  for (size_t i = 0; i < count; ++i) {
+    rows.push_back({static_cast<int64_t>(i), static_cast<int32_t>(i % 20)});
+  }
+  return make_table(CUSTOMERS, rows);
+}
+
+std::shared_ptr<query::ColumnarTable> make_orders(size_t count,
+                                                  size_t customers) {
+  std::mt19937_64 rng(107);
+  Rows rows;
+  for (size_t i = 0; i < count; ++i) {
+    rows.push_back({static_cast<int64_t>(rng() % customers),
+                    static_cast<int32_t>(rng() % 1000)});
+  }
+  return make_table(ORDERS, rows);
+}
+
+/// @brief Orders of customers in a country above an amount
+query::JoinQuery make_query(std::shared_ptr<query::ColumnarTable> customers,
+                            std::shared_ptr<query::ColumnarTable> orders,
+                            int32_t country, int32_t amount) {
+  query::JoinQuery query;
+  query.relations.push_back(
+      {"c", std::move(customers), {{1, CompareOp::EQ, country}}, {}, {}});
+  query.relations.push_back(
+      {"o", std::move(orders), {{1, CompareOp::GT, amount}}, {}, {}});
+  query.joins = {{0, 0, 1, 0}};
+  query.output = {{0, 0}, {1, 1}};
+  return query;
+}
+
+std::vector<std::string> run(const error::Result<query::QueryPlan> &plan) {
+  EXPECT_TRUE(plan.has_value());
+  return plan ? collect_sorted(*plan->root) : std::vector<std::string>{};
+}
+
+std::vector<std::string> reference(const query::JoinQuery &query) {
+  return run(query::QueryOptimizer().optimize(query));
+}
+
+class PlanCacheTest : public ::testing::Test {
+protected:
+  std::shared_ptr<query::ColumnarTable> m_customers = make_customers(500);
+  std::shared_ptr<query::ColumnarTable> m_orders = make_orders(5000, 500);
+};
+
+TEST_F(PlanCacheTest, FingerprintIgnoresLiteralsAndOrdering) {
+  const auto base = make_query(m_customers, m_orders, 3, 100);
+  const auto print = query::fingerprint(base);
+
+  EXPECT_EQ(query::fingerprint(make_query(m_customers, m_orders, 7, 900)),
+            print);
+
+  auto reordered = base;
+  reordered.relations[1].predicates.insert(
+      reordered.relations[1].predicates.begin(),
+      {0, CompareOp::NE, int64_t{1}});
+  auto swapped = base;
+  swapped.relations[1].predicates.push_back({0, CompareOp::NE, int64_t{2}});
+  swapped.joins = {{1, 0, 0, 0}};
+  EXPECT_EQ(query::fingerprint(reordered), query::fingerprint(swapped));
+  EXPECT_NE(query::fingerprint(reordered), print);
+
+  auto other_op = base;
+  other_op.relations[1].predicates[0].op = CompareOp::LT;
+  EXPECT_NE(query::fingerprint(other_op), print);
+  auto other_output = base;
+  other_output.output.pop_back();
+  EXPECT_NE(query::fingerprint(other_output), print);
+}
+
+TEST_F(PlanCacheTest, FingerprintKeysOnTableIdNotAddress) {
+  const auto print = query::fingerprint(make_query(m_customers, m_orders, 3,
+                                                   100));
+
+  // Same schema and contents, but another table
+  auto copy = std::make_shared<query::ColumnarTable>(*m_orders);
+  EXPECT_NE(copy->id(), m_orders->id());
+  EXPECT_NE(query::fingerprint(make_query(m_customers, copy, 3, 100)), print);
+
+  // Reassigning a table makes it a new one as well
+  const auto id = copy->id();
+  *copy = *m_customers;
+  EXPECT_NE(copy->id(), id);
+  EXPECT_NE(copy->id(), m_customers->id());
+}
+
+TEST_F(PlanCacheTest, HitsReuseTheOrderWithNewLiterals) {
+  query::PlanCache cache;
+  for (int32_t country : {3, 3, 11, 19}) {
+    for (int32_t amount : {100, 990}) {
+      const auto query = make_query(m_customers, m_orders, country, amount);
+      EXPECT_EQ(run(cache.plan(query)), reference(query))
+          << country << " " << amount;
+    }
+  }
+
+  const auto statistics = cache.statistics();
+  EXPECT_EQ(statistics.misses, 1u);
+  EXPECT_EQ(statistics.hits, 7u);
+  EXPECT_EQ(statistics.invalidations, 0u);
+  EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST_F(PlanCacheTest, ReplacedTableAtTheSameAddressMisses) {
+  query::PlanCache cache;
+  auto query = make_query(m_customers, m_orders, 3, 100);
+  ASSERT_TRUE(cache.plan(query).has_value());
+
+  // End the table's life and start another of the same schema and size in
+  // its storage, as an allocator reusing the address would
+  auto *table = m_orders.get();
+  const auto old_id = table->id();
+  std::destroy_at(table);
+  std::construct_at(table, ORDERS);
+  const auto replacement = make_orders(5000, 20);
+  for (size_t c = 0; c < replacement->chunk_count(); ++c) {
+    ASSERT_TRUE(table->append_chunk(replacement->chunk(c)).has_value());
+  }
+  ASSERT_EQ(query.relations[1].table.get(), table);
+  EXPECT_NE(table->id(), old_id);
+
+  EXPECT_EQ(run(cache.plan(query)), reference(query));
+  const auto statistics = cache.statistics();
+  EXPECT_EQ(statistics.hits, 0u);
+  EXPECT_EQ(statistics.misses, 2u);
+  EXPECT_EQ(cache.size(), 2u);
+}
+
+TEST_F(PlanCacheTest, NewStatisticsVersionInvalidates) {
+  query::PlanCache cache;
+  auto query = make_query(m_customers, m_orders, 3, 100);
+  query.relations[1].statistics = query::analyze(*m_orders);
+  ASSERT_TRUE(cache.plan(query).has_value());
+  ASSERT_TRUE(cache.plan(query).has_value());
+
+  query.relations[1].statistics = query::analyze(*m_orders);
+  EXPECT_EQ(run(cache.plan(query)), reference(query));
+
+  const auto statistics = cache.statistics();
+  EXPECT_EQ(statistics.hits, 1u);
+  EXPECT_EQ(statistics.misses, 2u);
+  EXPECT_EQ(statistics.invalidations, 1u);
+  EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST_F(PlanCacheTest, RowCountDriftInvalidatesUnversionedPlans) {
+  query::PlanCacheOptions options;
+  options.replan_growth = 2.0;
+  query::PlanCache cache(options);
+  const auto query = make_query(m_customers, m_orders, 3, 100);
+  ASSERT_TRUE(cache.plan(query).has_value());
+
+  // Growing by less than the factor keeps the plan
+  std::mt19937_64 rng(109);
+  auto grow = [&](size_t rows) {
+    for (size_t i = 0; i < rows; ++i) {
+      const Value customer = static_cast<int64_t>(rng() % 500);
+      const Value amount = static_cast<int32_t>(rng() % 1000);
+      ASSERT_TRUE(
+          m_orders->append_row(dtypes::Row({customer, amount})).has_value());
+    }
+  };
+  grow(4000);
+  ASSERT_TRUE(cache.plan(query).has_value());
+  EXPECT_EQ(cache.statistics().hits, 1u);
+
+  grow(2000);
+  EXPECT_EQ(run(cache.plan(query)), reference(query));
+  const auto statistics = cache.statistics();
+  EXPECT_EQ(statistics.hits, 1u);
+  EXPECT_EQ(statistics.misses, 2u);
+  EXPECT_EQ(statistics.invalidations, 1u);
+}
+
+TEST_F(PlanCacheTest, InvalidateDropsPlansReadingTheTable) {
+  query::PlanCache cache;
+  auto regions = make_customers(50);
+  auto first = make_query(m_customers, m_orders, 3, 100);
+  auto second = make_query(regions, m_orders, 3, 100);
+  auto unrelated = make_query(m_customers, make_orders(100, 500), 3, 100);
+  for (const auto *query : {&first, &second, &unrelated}) {
+    ASSERT_TRUE(cache.plan(*query).has_value());
+  }
+  ASSERT_EQ(cache.size(), 3u);
+
+  cache.invalidate(*m_orders);
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.statistics().invalidations, 2u);
+  ASSERT_TRUE(cache.plan(unrelated).has_value());
+  EXPECT_EQ(cache.statistics().hits, 1u);
+
+  // A table nothing reads drops nothing
+  cache.invalidate(*make_customers(1));
+  EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST_F(PlanCacheTest, HashCollisionIsAMiss) {
+  query::PlanCache cache;
+  const auto query = make_query(m_customers, m_orders, 3, 100);
+  const auto print = query::fingerprint(query);
+
+  // Another query's entry squatting on this hash
+  auto squatter = std::make_shared<query::CachedPlan>();
+  squatter->fingerprint = query::fingerprint(
+      make_query(m_orders, m_customers, 3, 100));
+  squatter->fingerprint.hash = print.hash;
+  cache.put(print.hash, squatter);
+
+  EXPECT_EQ(run(cache.plan(query)), reference(query));
+  const auto statistics = cache.statistics();
+  EXPECT_EQ(statistics.hits, 0u);
+  EXPECT_EQ(statistics.misses, 1u);
+  EXPECT_EQ(statistics.invalidations, 1u);
+  EXPECT_EQ(cache.get(print.hash)->fingerprint, print);
+}
+
+TEST_F(PlanCacheTest, EvictsLeastRecentlyUsed) {
+  query::PlanCacheOptions options;
+  options.capacity = 2;
+  query::PlanCache cache(options);
+  EXPECT_EQ(cache.capacity(), 2u);
+
+  std::vector<query::JoinQuery> queries;
+  for (size_t i = 0; i < 3; ++i) {
+    queries.push_back(make_query(make_customers(10 + i), m_orders, 3, 100));
+  }
+  ASSERT_TRUE(cache.plan(queries[0]).has_value());
+  ASSERT_TRUE(cache.plan(queries[1]).has_value());
+  ASSERT_TRUE(cache.plan(queries[0]).has_value()); // queries[1] is now LRU
+  ASSERT_TRUE(cache.plan(queries[2]).has_value());
+  EXPECT_EQ(cache.size(), 2u);
+
+  const auto key = [&](size_t i) {
+    return query::fingerprint(queries[i]).hash;
+  };
+  EXPECT_NE(cache.get(key(0)), nullptr);
+  EXPECT_EQ(cache.get(key(1)), nullptr);
+  EXPECT_NE(cache.get(key(2)), nullptr);
+
+  cache.evict(key(0));
+  EXPECT_EQ(cache.get(key(0)), nullptr);
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0u);
+
+  query::PlanCacheOptions disabled;
+  disabled.capacity = 0;
+  query::PlanCache none(disabled);
+  ASSERT_TRUE(none.plan(queries[0]).has_value());
+  EXPECT_EQ(none.size(), 0u);
+}
+
+TEST_F(PlanCacheTest, PreparedStatementBindsParameters) {
+  auto cache = std::make_shared<query::PlanCache>();
+  query::PreparedStatement statement(
+      cache, make_query(m_customers, m_orders, 0, 0));
+  EXPECT_EQ(statement.parameter_count(), 2u);
+
+  const std::vector<Value> too_few{int32_t{3}};
+  auto plan = statement.bind(too_few);
+  ASSERT_FALSE(plan.has_value());
+  EXPECT_EQ(plan.error(), error::ErrorCode::INVALID_ARGUMENT);
+
+  for (int32_t country : {3, 8, 15}) {
+    const std::vector<Value> parameters{country, int32_t{500}};
+    EXPECT_EQ(run(statement.bind(parameters)),
+              reference(make_query(m_customers, m_orders, country, 500)));
+    EXPECT_EQ(std::get<int32_t>(
+                  statement.query().relations[0].predicates[0].constant),
+              country);
+  }
+  EXPECT_EQ(cache->statistics().misses, 1u);
+  EXPECT_EQ(cache->statistics().hits, 2u);
+
+  // Planning errors come through
+  const std::vector<Value> wrong_type{std::string("x"), int32_t{1}};
+  EXPECT_FALSE(statement.bind(wrong_type).has_value());
+}
+} // namespace
+} // namespace velox::test
@@ -0,0 +1,422 @@
+/**
+ * @file query_engine_test.cpp
+ * @author Carlos Salguero
+ * @brief Tests for the vectorized execution engine: vectors, expressions
+ *        and the core operators
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "test_common.hpp"
+
+#include <limits>
+#include <map>
+#include <random>
+#include <velox/query/query_processor.hpp>
+
+namespace velox::test {
+namespace {
+using dtypes::TypeId;
+using dtypes::Value;
+using query::CompareOp;
+using query::JoinType;
+
+const query::Schema ORDERS{{"id", TypeId::BIGINT},
+                           {"customer", TypeId::INTEGER},
+                           {"amount", TypeId::BIGINT},
+                           {"status", TypeId::VARCHAR}};
+
+/// @brief Orders spanning several chunks, with NULL customers and amounts
+Rows make_orders(size_t count, uint64_t seed = 1) {
+  std::mt19937_64 rng(seed);
+  const char *statuses[] = {"open", "shipped", "returned"};
+  Rows rows;
+  for (size_t i = 0; i < count; ++i) {
+    Value customer = rng() % 17 == 0 ? Value(nullptr)
+                                     : Value(static_cast<int32_t>(rng() % 50));
+    Value amount = rng() % 23 == 0
+                       ? Value(nullptr)
+                       : Value(static_cast<int64_t>(rng() % 1000) - 100);
+    rows.push_back({static_cast<int64_t>(i), customer, amount,
+                    std::string(statuses[rng() % 3])});
+  }
+
+  return rows;
+}
+
+TEST(ColumnVectorTest, AppendsFixedWidthValuesAndNulls) {
+  query::ColumnVector vector(TypeId::INTEGER);
+  for (int32_t i = 0; i < 2000; ++i) {
+    if (i % 7 == 0) {
+      vector.append_null();
+    } else {
+      vector.append<int32_t>(i);
+    }
+  }
+
+  ASSERT_EQ(vector.size(), 2000u);
+  EXPECT_TRUE(vector.may_have_nulls());
+  for (size_t i = 0; i < vector.size(); ++i) {
+    EXPECT_EQ(vector.is_valid(i), i % 7 != 0) << i;
+    if (i % 7 != 0) {
+      EXPECT_EQ(vector.data<int32_t>()[i], static_cast<int32_t>(i));
+    }
+  }
+}
+
+TEST(ColumnVectorTest, StoresStringsInHeap) {
+  query::ColumnVector vector(TypeId::VARCHAR);
+  vector.append_string("alpha");
+  vector.append_string("");
+  vector.append_null();
+  vector.append_string("gamma");
+
+  ASSERT_EQ(vector.size(), 4u);
+  EXPECT_EQ(vector.string_at(0), "alpha");
+  EXPECT_EQ(vector.string_at(1), "");
+  EXPECT_FALSE(vector.is_valid(2));
+  EXPECT_EQ(vector.string_at(3), "gamma");
+
+  query::ColumnVector selected(TypeId::VARCHAR);
+  const std::vector<uint32_t> rows{3, 2, 0};
+  selected.append_selected(vector, rows);
+  ASSERT_EQ(selected.size(), 3u);
+  EXPECT_EQ(selected.string_at(0), "gamma");
+  EXPECT_FALSE(selected.is_valid(1));
+  EXPECT_EQ(selected.string_at(2), "alpha");
+}
+
+TEST(ColumnVectorTest, BoundsTheStringHeapToItsOffsets) {
+  query::ColumnVector vector(TypeId::VARCHAR);
+  EXPECT_TRUE(vector.heap_fits(query::config::MAX_HEAP_BYTES));
+  EXPECT_FALSE(vector.heap_fits(query::config::MAX_HEAP_BYTES + 1));
+
+  vector.append_string("alpha");
+  EXPECT_TRUE(vector.heap_fits(query::config::MAX_HEAP_BYTES - 5));
+  EXPECT_FALSE(vector.heap_fits(query::config::MAX_HEAP_BYTES - 4));
+
+  const query::Schema schema{{"id", TypeId::BIGINT},
+                             {"name", TypeId::VARCHAR}};
+  query::DataChunk source(schema);
+  const dtypes::Row row(std::vector<Value>{int64_t{1}, std::string("abc")});
+  ASSERT_TRUE(source.append_row(row).has_value());
+  query::DataChunk target(schema);
+  EXPECT_TRUE(target.range_fits(source, 0, 1));
+}
+
+TEST(ColumnVectorTest, OrdersNaNAfterEveryValue) {
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double inf = std::numeric_limits<double>::infinity();
+  query::ColumnVector vector(TypeId::DOUBLE);
+  for (double value : {nan, inf, -inf, 0.0, -nan}) {
+    vector.append<double>(value);
+  }
+
+  EXPECT_GT(vector.compare(0, vector, 1), 0);
+  EXPECT_LT(vector.compare(1, vector, 0), 0);
+  EXPECT_GT(vector.compare(0, vector, 2), 0);
+  EXPECT_LT(vector.compare(3, vector, 4), 0);
+  EXPECT_EQ(vector.compare(0, vector, 4), 0);
+  EXPECT_TRUE(vector.equals(0, vector, 0));
+
+  // Mixed widths compare through double with the same order
+  query::ColumnVector integers(TypeId::BIGINT);
+  integers.append<int64_t>(std::numeric_limits<int64_t>::max());
+  EXPECT_GT(vector.compare(0, integers, 0), 0);
+  EXPECT_LT(integers.compare(0, vector, 0), 0);
+}
+
+TEST(ColumnVectorTest, ConvertsValuesToColumnType) {
+  query::ColumnVector vector(TypeId::BIGINT);
+  ASSERT_TRUE(vector.append_value(int32_t{42}).has_value());
+  ASSERT_TRUE(vector.append_value(nullptr).has_value());
+  EXPECT_FALSE(vector.append_value(std::string("x")).has_value());
+
+  EXPECT_EQ(query::format_literal(vector.value_at(0)), "42");
+  EXPECT_EQ(query::format_literal(vector.value_at(1)), "NULL");
+}
+
+TEST(ColumnarTableTest, SplitsRowsIntoChunks) {
+  const auto rows = make_orders(3000);
+  auto table = make_table(ORDERS, rows);
+
+  EXPECT_EQ(table->row_count(), rows.size());
+  EXPECT_EQ(table->chunk_count(), 3u);
+  query::TableScan scan(table);
+  EXPECT_EQ(collect_sorted(scan), render_sorted(rows));
+}
+
+TEST(FilterTest, DropsRowsWherePredicateIsFalseOrNull) {
+  const auto rows = make_orders(2500);
+  auto table = make_table(ORDERS, rows);
+
+  auto amount = *query::expr::column(ORDERS, "amount");
+  auto status = *query::expr::column(ORDERS, "status");
+  auto predicate = *query::expr::conjunction(
+      query::ConjunctionOp::AND,
+      {*query::expr::compare(CompareOp::GE, amount,
+                             query::expr::literal(int64_t{500})),
+       *query::expr::compare(CompareOp::NE, status,
+                             query::expr::literal(std::string("returned")))});
+  query::Filter filter(std::make_unique<query::TableScan>(table), predicate);
+
+  Rows expected;
+  for (const auto &row : rows) {
+    if (!is_null_value(row[2]) && std::get<int64_t>(row[2]) >= 500 &&
+        std::get<std::string>(row[3]) != "returned") {
+      expected.push_back(row);
+    }
+  }
+  EXPECT_EQ(collect_sorted(filter), render_sorted(expected));
+}
+
+TEST(FilterTest, KeepsRowsWhereOrIsTrueDespiteNull) {
+  const auto rows = make_orders(1500);
+  auto table = make_table(ORDERS, rows);
+
+  auto customer = *query::expr::column(ORDERS, "customer");
+  auto id = *query::expr::column(ORDERS, "id");
+  auto predicate = *query::expr::conjunction(
+      query::ConjunctionOp::OR,
+      {*query::expr::compare(CompareOp::EQ, customer,
+                             query::expr::literal(int32_t{3})),
+       *query::expr::compare(CompareOp::LT, id,
+                             query::expr::literal(int64_t{10}))});
+  query::Filter filter(std::make_unique<query::TableScan>(table), predicate);
+
+  Rows expected;
+  for (const auto &row : rows) {
+    const bool by_customer =
+        !is_null_value(row[1]) && std::get<int32_t>(row[1]) == 3;
+    if (by_customer || std::get<int64_t>(row[0]) < 10) {
+      expected.push_back(row);
+    }
+  }
+  EXPECT_EQ(collect_sorted(filter), render_sorted(expected));
+}
+
+TEST(ProjectionTest, EvaluatesArithmeticWithNullSemantics) {
+  const query::Schema schema{{"a", TypeId::BIGINT}, {"b", TypeId::BIGINT}};
+  auto table = make_table(schema, {{int64_t{7}, int64_t{2}},
+                                   {int64_t{9}, int64_t{0}},
+                                   {nullptr, int64_t{4}},
+                                   {int64_t{-8}, int64_t{3}}});
+
+  auto a = *query::expr::column(schema, "a");
+  auto b = *query::expr::column(schema, "b");
+  query::Projection projection(
+      std::make_unique<query::TableScan>(table),
+      {*query::expr::arithmetic(query::ArithmeticOp::ADD, a, b),
+       *query::expr::arithmetic(query::ArithmeticOp::DIV, a, b),
+       query::expr::is_null(a)},
+      {"sum", "quotient", "a_null"});
+
+  EXPECT_EQ(projection.schema()[0].name, "sum");
+  EXPECT_EQ(collect(projection),
+            (std::vector<std::string>{"9|3|FALSE", "9|NULL|FALSE",
+                                      "NULL|NULL|TRUE", "-5|-2|FALSE"}));
+}
+
+TEST(ExpressionTest, RejectsIncompatibleOperands) {
+  auto status = *query::expr::column(ORDERS, "status");
+  auto compared = query::expr::compare(CompareOp::EQ, status,
+                                       query::expr::literal(int64_t{1}));
+  ASSERT_FALSE(compared.has_value());
+  EXPECT_EQ(compared.error(), error::ErrorCode::TYPE_MISMATCH);
+
+  EXPECT_FALSE(query::expr::column(ORDERS, "missing").has_value());
+}
+
+TEST(HashAggregateTest, MatchesReferenceGrouping) {
+  const auto rows = make_orders(5000);
+  auto table = make_table(ORDERS, rows);
+
+  query::HashAggregate aggregate(
+      std::make_unique<query::TableScan>(table), {1},
+      {{query::AggregateFunction::COUNT_STAR, 0, "n"},
+       {query::AggregateFunction::COUNT, 2, "amounts"},
+       {query::AggregateFunction::SUM, 2, "total"},
+       {query::AggregateFunction::MIN, 2, "low"},
+       {query::AggregateFunction::MAX, 2, "high"}});
+
+  struct Group {
+    int64_t rows{0};
+    int64_t values{0};
+    int64_t sum{0};
+    int64_t min{INT64_MAX};
+    int64_t max{INT64_MIN};
+  };
+  std::map<std::string, Group> groups;
+  for (const auto &row : rows) {
+    auto &group = groups[query::format_literal(row[1])];
+    ++group.rows;
+    if (!is_null_value(row[2])) {
+      const auto amount = std::get<int64_t>(row[2]);
+      ++group.values;
+      group.sum += amount;
+      group.min = std::min(group.min, amount);
+      group.max = std::max(group.max, amount);
+    }
+  }
+
+  std::vector<std::string> expected;
+  for (const auto &[key, group] : groups) {
+    const bool any = group.values > 0;
+    expected.push_back(fmt::format(
+        "{}|{}|{}|{}|{}|{}", key, group.rows, group.values,
+        any ? std::to_string(group.sum) : "NULL",
+        any ? std::to_string(group.min) : "NULL",
+        any ? std::to_string(group.max) : "NULL"));
+  }
+  std::sort(expected.begin(), expected.end());
+
+  EXPECT_EQ(collect_sorted(aggregate), expected);
+}
+
+TEST(HashAggregateTest, EmptyInputWithoutGroupsYieldsOneRow) {
+  auto table = make_table(ORDERS, {});
+  query::HashAggregate aggregate(
+      std::make_unique<query::TableScan>(table), {},
+      {{query::AggregateFunction::COUNT_STAR, 0, "n"},
+       {query::AggregateFunction::SUM, 2, "total"}});
+
+  EXPECT_EQ(collect(aggregate), (std::vector<std::string>{"0|NULL"}));
+}
+
+class HashJoinTest : public ::testing::TestWithParam<JoinType> {};
+
+TEST_P(HashJoinTest, MatchesNestedLoopReference) {
+  const auto type = GetParam();
+  const query::Schema probe_schema{{"key", TypeId::INTEGER},
+                                   {"probe", TypeId::BIGINT}};
+  const query::Schema build_schema{{"key", TypeId::INTEGER},
+                                   {"build", TypeId::VARCHAR}};
+
+  std::mt19937_64 rng(11);
+  Rows probe_rows;
+  for (int64_t i = 0; i < 3000; ++i) {
+    Value key = rng() % 31 == 0 ? Value(nullptr)
+                                : Value(static_cast<int32_t>(rng() % 400));
+    probe_rows.push_back({key, i});
+  }
+  Rows build_rows;
+  for (int64_t i = 0; i < 600; ++i) {
+    Value key = rng() % 29 == 0 ? Value(nullptr)
+                                : Value(static_cast<int32_t>(rng() % 500));
+    build_rows.push_back({key, fmt::format("b{}", i)});
+  }
+
+  Rows expected;
+  for (const auto &p : probe_rows) {
+    bool matched = false;
+    for (const auto &b : build_rows) {
+      if (is_null_value(p[0]) || is_null_value(b[0]) ||
+          std::get<int32_t>(p[0]) != std::get<int32_t>(b[0])) {
+        continue;
+      }
+      matched = true;
+      if (type == JoinType::INNER || type == JoinType::LEFT) {
+        expected.push_back({p[0], p[1], b[0], b[1]});
+      }
+    }
+    if ((type == JoinType::LEFT && !matched)) {
+      expected.push_back({p[0], p[1], nullptr, nullptr});
+    } else if ((type == JoinType::SEMI && matched) ||
+               (type == JoinType::ANTI && !matched)) {
+      expected.push_back({p[0], p[1]});
+    }
+  }
+
+  query::HashJoin join(
+      std::make_unique<query::TableScan>(make_table(probe_schema, probe_rows)),
+      std::make_unique<query::TableScan>(make_table(build_schema, build_rows)),
+      {0}, {0}, type);
+  EXPECT_EQ(collect_sorted(join), render_sorted(expected));
+
+  join.reset();
+  EXPECT_EQ(collect(join).size(), expected.size());
+}
+
+INSTANTIATE_TEST_SUITE_P(JoinTypes, HashJoinTest,
+                         ::testing::Values(JoinType::INNER, JoinType::LEFT,
+                                           JoinType::SEMI, JoinType::ANTI),
+                         [](const auto &info) {
+                           return std::string(query::to_string(info.param));
+                         });
+
+TEST(SortTest, OrdersByMultipleKeysWithNulls) {
+  const auto rows = make_orders(2200);
+  auto table = make_table(ORDERS, rows);
+  query::Sort sort(std::make_unique<query::TableScan>(table),
+                   {{1, true, true}, {2, false, false}, {0, true, false}});
+
+  auto ordered = rows;
+  auto rank = [](const Value &value, bool ascending, bool nulls_first) {
+    return std::pair<int, int64_t>(
+        is_null_value(value) == nulls_first ? 0 : 1,
+        is_null_value(value) ? 0
+                       : std::visit(
+                             [&](const auto &v) -> int64_t {
+                               using V = std::decay_t<decltype(v)>;
+                               if constexpr (std::is_integral_v<V>) {
+                                 return ascending ? v : -v;
+                               } else {
+                                 return 0;
+                               }
+                             },
+                             value));
+  };
+  std::stable_sort(ordered.begin(), ordered.end(),
+                   [&](const auto &a, const auto &b) {
+                     return std::tuple(rank(a[1], true, true),
+                                       rank(a[2], false, false),
+                                       rank(a[0], true, false)) <
+                            std::tuple(rank(b[1], true, true),
+                                       rank(b[2], false, false),
+                                       rank(b[0], true, false));
+                   });
+
+  std::vector<std::string> expected;
+  for (const auto &row : ordered) {
+    expected.push_back(render_values(row));
+  }
+  EXPECT_EQ(collect(sort), expected);
+}
+
+TEST(LimitTest, AppliesOffsetAcrossChunks) {
+  const auto rows = make_orders(3000);
+  auto table = make_table(ORDERS, rows);
+  query::Limit limit(std::make_unique<query::TableScan>(table), 1500, 1000);
+
+  const auto output = collect(limit);
+  ASSERT_EQ(output.size(), 1500u);
+  EXPECT_EQ(output.front(), render_values(rows[1000]));
+  EXPECT_EQ(output.back(), render_values(rows[2499]));
+}
+
+TEST(QueryProcessorTest, ExecutesPlanAndRecordsStatistics) {
+  const auto rows = make_orders(2100);
+  query::QueryPlan plan(
+      std::make_unique<query::TableScan>(make_table(ORDERS, rows)));
+  query::QueryProcessor processor;
+
+  auto result = processor.execute(plan);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->row_count(), rows.size());
+  EXPECT_EQ(processor.last_statistics().rows, rows.size());
+  EXPECT_EQ(processor.last_statistics().chunks, result->chunks.size());
+
+  plan.root->reset();
+  size_t seen = 0;
+  auto streamed = processor.execute(plan, [&](const query::DataChunk &chunk) {
+    seen += chunk.size();
+    return false;
+  });
+  ASSERT_TRUE(streamed.has_value());
+  EXPECT_EQ(seen, query::config::VECTOR_SIZE);
+}
+} // namespace
+} // namespace velox::test
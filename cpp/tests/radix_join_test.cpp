@@ -0,0 +1,147 @@
+/**
+ * @file radix_join_test.cpp
+ * @author Carlos Salguero
+ * @brief Tests for RadixHashJoin against HashJoin, in memory and spilling
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "test_common.hpp"
+
+#include <random>
+
+namespace velox::test {
+namespace {
+using dtypes::TypeId;
+using dtypes::Value;
+using query::JoinType;
+
+const query::Schema PROBE{{"key", TypeId::INTEGER},
+                          {"name", TypeId::VARCHAR},
+                          {"probe", TypeId::BIGINT}};
+const query::Schema BUILD{{"key", TypeId::BIGINT},
+                          {"name", TypeId::VARCHAR},
+                          {"build", TypeId::DOUBLE}};
+
+/// @brief Rows keyed on (key, name); key 7 is heavily duplicated
+Rows make_rows(size_t count, uint64_t seed, bool build) {
+  std::mt19937_64 rng(seed);
+  Rows rows;
+  for (size_t i = 0; i < count; ++i) {
+    const int64_t key =
+        rng() % 10 == 0 ? 7 : static_cast<int64_t>(rng() % 3000);
+    Value key_value = rng() % 37 == 0 ? Value(nullptr)
+                      : build        ? Value(key)
+                                     : Value(static_cast<int32_t>(key));
+    Value name = rng() % 41 == 0 ? Value(nullptr)
+                                 : Value(fmt::format("n{}", rng() % 3));
+    Value payload = build ? Value(static_cast<double>(i) / 4)
+                          : Value(static_cast<int64_t>(i));
+    rows.push_back({key_value, name, payload});
+  }
+
+  return rows;
+}
+
+struct RadixJoinCase {
+  JoinType type;
+  bool spill;
+};
+
+class RadixHashJoinTest : public ::testing::TestWithParam<RadixJoinCase> {};
+
+TEST_P(RadixHashJoinTest, MatchesHashJoin) {
+  const auto [type, spill] = GetParam();
+  auto probe = make_table(PROBE, make_rows(12000, 1, false));
+  auto build = make_table(BUILD, make_rows(4000, 2, true));
+
+  query::HashJoin reference(std::make_unique<query::TableScan>(probe),
+                            std::make_unique<query::TableScan>(build), {0, 1},
+                            {0, 1}, type);
+  const auto expected = collect_sorted(reference);
+  ASSERT_FALSE(expected.empty());
+
+  TempDirectory directory("radix_join");
+  query::RadixJoinOptions options;
+  options.threads = 4;
+  options.partition_bits = 4;
+  if (spill) {
+    options.memory_budget = 64 * 1024;
+    options.spill_directory = directory.path();
+  }
+  query::RadixHashJoin join(std::make_unique<query::TableScan>(probe),
+                            std::make_unique<query::TableScan>(build), {0, 1},
+                            {0, 1}, type, options);
+  EXPECT_EQ(join.schema().size(), reference.schema().size());
+  EXPECT_EQ(collect_sorted(join), expected);
+
+  join.reset();
+  EXPECT_EQ(collect_sorted(join), expected);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    JoinTypes, RadixHashJoinTest,
+    ::testing::Values(RadixJoinCase{JoinType::INNER, false},
+                      RadixJoinCase{JoinType::INNER, true},
+                      RadixJoinCase{JoinType::LEFT, false},
+                      RadixJoinCase{JoinType::LEFT, true},
+                      RadixJoinCase{JoinType::SEMI, false},
+                      RadixJoinCase{JoinType::SEMI, true},
+                      RadixJoinCase{JoinType::ANTI, false},
+                      RadixJoinCase{JoinType::ANTI, true}),
+    [](const auto &info) {
+      return std::string(query::to_string(info.param.type)) +
+             (info.param.spill ? "_spill" : "_memory");
+    });
+
+TEST(RadixHashJoinOutputTest, OutputLargerThanBudgetSpills) {
+  // Inputs fit the budget; the 40000-row result does not
+  Rows probe_rows;
+  for (int32_t i = 0; i < 4000; ++i) {
+    probe_rows.push_back({int32_t{1}, fmt::format("p{}", i), int64_t{i}});
+  }
+  Rows build_rows;
+  for (int64_t i = 0; i < 10; ++i) {
+    build_rows.push_back({int64_t{1}, std::string("b"), double{0.5}});
+  }
+  auto probe = make_table(PROBE, probe_rows);
+  auto build = make_table(BUILD, build_rows);
+
+  query::RadixJoinOptions options;
+  options.threads = 2;
+  options.partition_bits = 1;
+  options.memory_budget = 1024 * 1024;
+
+  // A missing spill directory turns any spill into an error
+  options.spill_directory = "/nonexistent/velox_radix_join";
+  query::RadixHashJoin failing(std::make_unique<query::TableScan>(probe),
+                               std::make_unique<query::TableScan>(build), {0},
+                               {0}, JoinType::INNER, options);
+  query::DataChunk chunk;
+  EXPECT_FALSE(failing.next(chunk).has_value());
+
+  // The inputs alone stay in memory: a SEMI join's output is the probe side
+  query::RadixHashJoin semi(std::make_unique<query::TableScan>(probe),
+                            std::make_unique<query::TableScan>(build), {0},
+                            {0}, JoinType::SEMI, options);
+  EXPECT_EQ(collect(semi).size(), 4000u);
+
+  TempDirectory directory("radix_join_output");
+  options.spill_directory = directory.path();
+  query::RadixHashJoin join(std::make_unique<query::TableScan>(probe),
+                            std::make_unique<query::TableScan>(build), {0},
+                            {0}, JoinType::INNER, options);
+  EXPECT_EQ(collect(join).size(), 40000u);
+
+  options.memory_budget = 0;
+  options.spill_directory = "/nonexistent/velox_radix_join";
+  query::RadixHashJoin in_memory(std::make_unique<query::TableScan>(probe),
+                                 std::make_unique<query::TableScan>(build),
+                                 {0}, {0}, JoinType::INNER, options);
+  EXPECT_EQ(collect(in_memory).size(), 40000u);
+}
+} // namespace
+} // namespace velox::test
@@ -0,0 +1,441 @@
+/**
+ * @file statistics_test.cpp
+ * @author Carlos Salguero
+ * @brief Tests for HyperLogLog, the ANALYZE collector and the selectivity
+ *        estimates built on its statistics
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "test_common.hpp"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <velox/query/optimizer.hpp>
+#include <velox/query/statistics.hpp>
+#include <velox/storage/storage_engine.hpp>
+#include <velox/utils/hash.hpp>
+
+namespace velox::test {
+namespace {
+using dtypes::TypeId;
+using dtypes::Value;
+using query::CompareOp;
+using utils::hash::mix64;
+
+TEST(HyperLogLogTest, EstimatesDistinctCounts) {
+  for (size_t distinct : {0, 1, 100, 1000, 20000, 500000}) {
+    query::HyperLogLog sketch;
+    for (uint64_t i = 0; i < distinct; ++i) {
+      sketch.add(mix64(i));
+      sketch.add(mix64(i)); // Duplicates never count twice
+    }
+    // Three standard errors at precision 12
+    EXPECT_NEAR(sketch.estimate(), static_cast<double>(distinct),
+                0.05 * static_cast<double>(distinct) + 1)
+        << distinct;
+  }
+}
+
+TEST(HyperLogLogTest, MergeEqualsSketchOfUnion) {
+  query::HyperLogLog left(10);
+  query::HyperLogLog right(10);
+  query::HyperLogLog both(10);
+  for (uint64_t i = 0; i < 30000; ++i) {
+    (i % 3 == 0 ? left : right).add(mix64(i));
+    both.add(mix64(i));
+  }
+  left.merge(right);
+  EXPECT_TRUE(std::ranges::equal(left.registers(), both.registers()));
+
+  // Sketches of another precision are ignored
+  query::HyperLogLog other(8);
+  other.add(mix64(123456789));
+  left.merge(other);
+  EXPECT_TRUE(std::ranges::equal(left.registers(), both.registers()));
+}
+
+TEST(HyperLogLogTest, RestoresFromRegisters) {
+  query::HyperLogLog sketch(6);
+  for (uint64_t i = 0; i < 500; ++i) {
+    sketch.add(mix64(i));
+  }
+  auto restored = query::HyperLogLog::from_registers(sketch.registers());
+  ASSERT_TRUE(restored.has_value());
+  EXPECT_EQ(restored->precision(), 6);
+  EXPECT_EQ(restored->estimate(), sketch.estimate());
+
+  EXPECT_EQ(query::HyperLogLog(1).precision(), 4);
+  EXPECT_EQ(query::HyperLogLog(30).precision(), 16);
+  EXPECT_FALSE(
+      query::HyperLogLog::from_registers(std::vector<uint8_t>(48)));
+  EXPECT_FALSE(query::HyperLogLog::from_registers(std::vector<uint8_t>(8)));
+  EXPECT_FALSE(
+      query::HyperLogLog::from_registers(std::vector<uint8_t>(1 << 17)));
+}
+
+const query::Schema ORDERS{{"status", TypeId::BIGINT},
+                           {"amount", TypeId::DOUBLE},
+                           {"region", TypeId::VARCHAR}};
+
+/**
+ * @brief Orders with a skewed status, a uniform amount and a region that
+ *        is NULL a tenth of the time
+ *
+ * @note status is 7 for 30% of the rows, 8 for 10% and otherwise one of
+ *       1000 rare values; region is "north" for 40% of the non-NULL rows.
+ */
+Rows make_orders(size_t count, uint64_t seed = 61) {
+  std::mt19937_64 rng(seed);
+  Rows rows;
+  for (size_t i = 0; i < count; ++i) {
+    const auto pick = rng() % 100;
+    const int64_t status = pick < 30   ? 7
+                           : pick < 40 ? 8
+                                       : 1000 + static_cast<int64_t>(
+                                                    rng() % 1000);
+    const double amount = static_cast<double>(rng() % 100000) / 100;
+    Value region = rng() % 10 == 0 ? Value(nullptr)
+                   : rng() % 5 < 2 ? Value(std::string("north"))
+                                   : Value(fmt::format("r{}", rng() % 50));
+    rows.push_back({status, amount, region});
+  }
+
+  return rows;
+}
+
+/// @brief Fraction of rows whose column satisfies a predicate
+template <typename T>
+double actual_fraction(const Rows &rows, size_t column,
+                       const std::function<bool(const T &)> &accept) {
+  size_t matches = 0;
+  for (const auto &row : rows) {
+    if (!is_null_value(row[column]) && accept(std::get<T>(row[column]))) {
+      ++matches;
+    }
+  }
+
+  return static_cast<double>(matches) / static_cast<double>(rows.size());
+}
+
+double selectivity(const query::TableStatistics &statistics, size_t column,
+                   CompareOp op, Value constant) {
+  return query::QueryOptimizer::selectivity(
+      statistics, query::ScanPredicate{column, op, std::move(constant)});
+}
+
+void expect_same(const query::TableStatistics &a,
+                 const query::TableStatistics &b) {
+  EXPECT_EQ(a.rows, b.rows);
+  ASSERT_EQ(a.columns.size(), b.columns.size());
+  for (size_t c = 0; c < a.columns.size(); ++c) {
+    const auto &x = a.columns[c];
+    const auto &y = b.columns[c];
+    EXPECT_EQ(x.type.type_id, y.type.type_id) << c;
+    EXPECT_EQ(x.distinct, y.distinct) << c;
+    EXPECT_EQ(x.null_fraction, y.null_fraction) << c;
+    EXPECT_EQ(x.min, y.min) << c;
+    EXPECT_EQ(x.max, y.max) << c;
+    EXPECT_EQ(x.histogram, y.histogram) << c;
+    ASSERT_EQ(x.most_common.size(), y.most_common.size()) << c;
+    for (size_t i = 0; i < x.most_common.size(); ++i) {
+      EXPECT_EQ(x.most_common[i].hash, y.most_common[i].hash);
+      EXPECT_EQ(x.most_common[i].number, y.most_common[i].number);
+      EXPECT_EQ(x.most_common[i].frequency, y.most_common[i].frequency);
+    }
+  }
+}
+
+class StatisticsTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    m_rows = make_orders(60000);
+    m_table = make_table(ORDERS, m_rows);
+    m_statistics = query::analyze(*m_table);
+  }
+
+  Rows m_rows;
+  std::shared_ptr<query::ColumnarTable> m_table;
+  query::TableStatistics m_statistics;
+};
+
+TEST_F(StatisticsTest, ExactCountsAndSketchedDistincts) {
+  EXPECT_EQ(m_statistics.rows, 60000);
+  EXPECT_NE(m_statistics.version, 0u);
+  ASSERT_EQ(m_statistics.columns.size(), ORDERS.size());
+
+  const auto &status = m_statistics.columns[0];
+  EXPECT_EQ(status.type.type_id, TypeId::BIGINT);
+  EXPECT_EQ(status.null_fraction, 0);
+  EXPECT_EQ(status.min, 7);
+  EXPECT_EQ(status.max, 1999);
+  EXPECT_NEAR(status.distinct, 1002, 50);
+
+  const auto &amount = m_statistics.columns[1];
+  double low = std::numeric_limits<double>::max();
+  double high = 0;
+  for (const auto &row : m_rows) {
+    low = std::min(low, std::get<double>(row[1]));
+    high = std::max(high, std::get<double>(row[1]));
+  }
+  EXPECT_EQ(amount.min, low);
+  EXPECT_EQ(amount.max, high);
+  ASSERT_GE(amount.histogram.size(), 2u);
+  EXPECT_EQ(amount.histogram.front(), low);
+  EXPECT_EQ(amount.histogram.back(), high);
+  EXPECT_TRUE(std::is_sorted(amount.histogram.begin(),
+                             amount.histogram.end()));
+
+  const auto &region = m_statistics.columns[2];
+  const double nulls = 1 - actual_fraction<std::string>(
+                               m_rows, 2, [](const auto &) { return true; });
+  EXPECT_DOUBLE_EQ(region.null_fraction, nulls);
+  EXPECT_FALSE(region.min.has_value());
+  EXPECT_TRUE(region.histogram.empty());
+  EXPECT_NEAR(region.distinct, 51, 3);
+}
+
+TEST_F(StatisticsTest, MostCommonValuesComeFirst) {
+  const auto &status = m_statistics.columns[0].most_common;
+  ASSERT_EQ(status.size(), 2u);
+  EXPECT_EQ(status[0].number, 7);
+  EXPECT_NEAR(status[0].frequency, 0.3, 0.03);
+  EXPECT_EQ(status[1].number, 8);
+  EXPECT_NEAR(status[1].frequency, 0.1, 0.02);
+
+  const auto &region = m_statistics.columns[2].most_common;
+  ASSERT_EQ(region.size(), 1u);
+  EXPECT_FALSE(region[0].number.has_value());
+  EXPECT_NEAR(region[0].frequency, 0.36, 0.03);
+
+  // Values repeated by chance in a uniform column stay negligible
+  for (const auto &value : m_statistics.columns[1].most_common) {
+    EXPECT_LT(value.frequency, 0.001);
+  }
+}
+
+TEST_F(StatisticsTest, SelectivityTracksTheData) {
+  const auto &stats = m_statistics;
+
+  // Most common values are looked up, the rest share what is left
+  EXPECT_NEAR(selectivity(stats, 0, CompareOp::EQ, int64_t{7}), 0.3, 0.03);
+  EXPECT_NEAR(selectivity(stats, 0, CompareOp::NE, int64_t{7}), 0.7, 0.03);
+  EXPECT_NEAR(selectivity(stats, 0, CompareOp::EQ, int64_t{1500}), 0.0006,
+              0.0002);
+  EXPECT_NEAR(selectivity(stats, 2, CompareOp::EQ, std::string("north")),
+              actual_fraction<std::string>(
+                  m_rows, 2, [](const auto &v) { return v == "north"; }),
+              0.03);
+  EXPECT_NEAR(selectivity(stats, 2, CompareOp::EQ, std::string("r3")),
+              actual_fraction<std::string>(
+                  m_rows, 2, [](const auto &v) { return v == "r3"; }),
+              0.005);
+
+  // Ranges use the histogram plus the common values they cover
+  for (double cut : {0.0, 10.0, 250.5, 500.0, 999.0, 2000.0}) {
+    for (auto op : {CompareOp::LT, CompareOp::GE}) {
+      const bool less = op == CompareOp::LT;
+      EXPECT_NEAR(selectivity(stats, 1, op, cut),
+                  actual_fraction<double>(m_rows, 1,
+                                          [&](double v) {
+                                            return less ? v < cut : v >= cut;
+                                          }),
+                  0.03)
+          << "amount " << query::to_string(op) << " " << cut;
+    }
+  }
+  for (int64_t cut : {int64_t{0}, int64_t{8}, int64_t{9}, int64_t{1500}}) {
+    EXPECT_NEAR(selectivity(stats, 0, CompareOp::LE, cut),
+                actual_fraction<int64_t>(
+                    m_rows, 0, [&](int64_t v) { return v <= cut; }),
+                0.03)
+        << "status <= " << cut;
+  }
+
+  // NULL never matches; an unknown column falls back to defaults
+  EXPECT_EQ(selectivity(stats, 0, CompareOp::EQ, nullptr), 0);
+  EXPECT_NEAR(selectivity(stats, 9, CompareOp::EQ, int64_t{1}), 0.1, 1e-9);
+  EXPECT_NEAR(selectivity(stats, 9, CompareOp::LT, int64_t{1}), 1.0 / 3,
+              1e-9);
+}
+
+TEST_F(StatisticsTest, ZoneStatisticsKnowOnlyCountsAndNulls) {
+  const auto zone = query::zone_statistics(*m_table);
+  EXPECT_EQ(zone.rows, 60000);
+  EXPECT_EQ(zone.version, 0u);
+  EXPECT_DOUBLE_EQ(zone.columns[2].null_fraction,
+                   m_statistics.columns[2].null_fraction);
+  EXPECT_EQ(zone.columns[0].distinct, 0);
+  EXPECT_FALSE(zone.columns[0].min.has_value());
+
+  // Interpolation has nothing to work with, so defaults apply
+  EXPECT_NEAR(selectivity(zone, 0, CompareOp::EQ, int64_t{7}), 0.1, 1e-9);
+}
+
+TEST(StatisticsCollectorTest, RefreshFoldsInAppendedRows) {
+  const auto rows = make_orders(70000, 67);
+  auto table = std::make_shared<query::ColumnarTable>(ORDERS);
+  query::StatisticsCollector collector;
+  uint64_t version = 0;
+  for (size_t row = 0; row < rows.size(); ++row) {
+    ASSERT_TRUE(table->append_row(dtypes::Row(rows[row])).has_value());
+    if (row % 9000 == 4321 || row + 1 == rows.size()) {
+      const auto &statistics = collector.refresh(*table);
+      EXPECT_GT(statistics.version, version);
+      version = statistics.version;
+      EXPECT_EQ(collector.analyzed_rows(), row + 1);
+    }
+  }
+
+  expect_same(collector.statistics(), query::analyze(*table));
+
+  // A table that shrank is collected from scratch
+  auto smaller = make_table(ORDERS, make_orders(5000, 71));
+  expect_same(collector.refresh(*smaller), query::analyze(*smaller));
+}
+
+TEST(StatisticsCollectorTest, SerializeRoundTrip) {
+  const auto rows = make_orders(50000, 73);
+  auto table = make_table(ORDERS, Rows(rows.begin(), rows.begin() + 30000));
+  query::AnalyzeOptions options;
+  options.sample_chunks = 8;
+  options.histogram_buckets = 16;
+  options.most_common = 3;
+  options.sketch_precision = 10;
+  query::StatisticsCollector collector(options);
+  ASSERT_EQ(collector.refresh(*table).rows, 30000);
+
+  const auto bytes = collector.serialize();
+  auto restored = query::StatisticsCollector::deserialize(bytes);
+  ASSERT_TRUE(restored.has_value());
+  expect_same(restored->statistics(), collector.statistics());
+  EXPECT_NE(restored->statistics().version, collector.statistics().version);
+  EXPECT_EQ(restored->analyzed_rows(), collector.analyzed_rows());
+  EXPECT_EQ(restored->serialize(), bytes);
+
+  // Both continue identically, options included
+  for (size_t row = 30000; row < rows.size(); ++row) {
+    ASSERT_TRUE(table->append_row(dtypes::Row(rows[row])).has_value());
+  }
+  expect_same(restored->refresh(*table), collector.refresh(*table));
+  EXPECT_LE(collector.statistics().columns[1].histogram.size(), 17u);
+  EXPECT_LE(collector.statistics().columns[0].most_common.size(), 3u);
+}
+
+TEST(StatisticsCollectorTest, DeserializeRejectsCorruption) {
+  auto table = make_table(ORDERS, make_orders(3000));
+  query::StatisticsCollector collector;
+  ASSERT_EQ(collector.refresh(*table).rows, 3000);
+  const auto bytes = collector.serialize();
+
+  auto expect_corrupt = [](std::vector<uint8_t> input) {
+    auto restored = query::StatisticsCollector::deserialize(input);
+    ASSERT_FALSE(restored.has_value());
+    EXPECT_EQ(restored.error(), error::ErrorCode::CORRUPTION);
+  };
+
+  expect_corrupt({});
+  for (size_t size : {size_t{4}, size_t{40}, bytes.size() / 2,
+                      bytes.size() - 1}) {
+    expect_corrupt(std::vector<uint8_t>(bytes.begin(), bytes.begin() + size));
+  }
+  auto trailing = bytes;
+  trailing.push_back(0);
+  expect_corrupt(trailing);
+  auto magic = bytes;
+  magic[0] ^= 0xff;
+  expect_corrupt(magic);
+}
+
+/// @brief Pages with consecutive ids, and pointers to them in chain order
+struct PageChain {
+  std::vector<std::unique_ptr<storage::Page>> owned;
+  std::vector<storage::Page *> pages;
+
+  explicit PageChain(size_t count, storage::PageId first = 40) {
+    for (size_t i = 0; i < count; ++i) {
+      owned.push_back(std::make_unique<storage::Page>(
+          first + static_cast<storage::PageId>(i)));
+      pages.push_back(owned.back().get());
+    }
+  }
+
+  [[nodiscard]] std::vector<const storage::Page *> chain() const {
+    return {pages.begin(), pages.end()};
+  }
+};
+
+TEST(MetadataPagesTest, PersistsSerializedStatistics) {
+  auto table = make_table(ORDERS, make_orders(20000, 79));
+  query::StatisticsCollector collector;
+  ASSERT_EQ(collector.refresh(*table).rows, 20000);
+  const auto bytes = collector.serialize();
+
+  const size_t count = query::metadata_pages(bytes.size());
+  ASSERT_GT(count, 1u) << "the payload should span several pages";
+  PageChain chain(count);
+
+  PageChain short_chain(count - 1);
+  auto rejected = query::write_metadata(bytes, short_chain.pages);
+  ASSERT_FALSE(rejected.has_value());
+  EXPECT_EQ(rejected.error(), error::ErrorCode::INVALID_ARGUMENT);
+
+  ASSERT_TRUE(query::write_metadata(bytes, chain.pages).has_value());
+  for (const auto *page : chain.pages) {
+    EXPECT_EQ(page->header().page_type, storage::PageType::METADATA);
+    EXPECT_TRUE(page->is_dirty());
+  }
+
+  auto payload = query::read_metadata(chain.chain());
+  ASSERT_TRUE(payload.has_value());
+  EXPECT_EQ(*payload, bytes);
+  auto restored = query::StatisticsCollector::deserialize(*payload);
+  ASSERT_TRUE(restored.has_value());
+  expect_same(restored->statistics(), collector.statistics());
+
+  // An empty payload still occupies one page
+  EXPECT_EQ(query::metadata_pages(0), 1u);
+  PageChain empty(1, 90);
+  ASSERT_TRUE(query::write_metadata({}, empty.pages).has_value());
+  auto nothing = query::read_metadata(empty.chain());
+  ASSERT_TRUE(nothing.has_value());
+  EXPECT_TRUE(nothing->empty());
+}
+
+TEST(MetadataPagesTest, ReadRejectsBrokenChains) {
+  std::vector<uint8_t> bytes(3 * storage::config::PAGE_DATA_SIZE);
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    bytes[i] = static_cast<uint8_t>(mix64(i));
+  }
+  PageChain chain(query::metadata_pages(bytes.size()));
+  ASSERT_TRUE(query::write_metadata(bytes, chain.pages).has_value());
+  ASSERT_TRUE(query::read_metadata(chain.chain()).has_value());
+
+  auto expect_corrupt = [](std::vector<const storage::Page *> pages) {
+    auto payload = query::read_metadata(pages);
+    ASSERT_FALSE(payload.has_value());
+    EXPECT_EQ(payload.error(), error::ErrorCode::CORRUPTION);
+  };
+
+  expect_corrupt({});
+  auto pages = chain.chain();
+  expect_corrupt({pages.begin(), pages.end() - 1});
+  expect_corrupt({pages.begin() + 1, pages.end()});
+  auto swapped = pages;
+  std::swap(swapped[0], swapped[1]);
+  expect_corrupt(swapped);
+
+  // A header edit fails the checksum; a damaged magic is caught too
+  chain.pages[1]->header().record_count = 7;
+  expect_corrupt(pages);
+  chain.pages[1]->header().record_count = 0;
+  ASSERT_TRUE(query::read_metadata(pages).has_value());
+  chain.pages[2]->data()[0] ^= 0xff;
+  expect_corrupt(pages);
+}
+} // namespace
+} // namespace velox::test
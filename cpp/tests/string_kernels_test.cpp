@@ -0,0 +1,231 @@
+/**
+ * @file string_kernels_test.cpp
+ * @author Carlos Salguero
+ * @brief Tests for the string match kernels against a scalar reference at
+ *        every instruction set the CPU supports
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "test_common.hpp"
+
+#include <random>
+#include <velox/query/kernels.hpp>
+
+namespace velox::test {
+namespace {
+using query::StringMatch;
+using query::kernels::SimdLevel;
+
+constexpr StringMatch ALL_SHAPES[] = {StringMatch::EQUALS,
+                                      StringMatch::PREFIX,
+                                      StringMatch::SUFFIX,
+                                      StringMatch::CONTAINS};
+
+std::vector<SimdLevel> supported_levels() {
+  std::vector<SimdLevel> levels;
+  for (auto level : {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+    if (level <= query::kernels::detected_simd_level()) {
+      levels.push_back(level);
+    }
+  }
+
+  return levels;
+}
+
+/// @brief Restores the detected level when a test ends
+class SimdLevelGuard {
+public:
+  SimdLevelGuard() = default;
+  ~SimdLevelGuard() {
+    query::kernels::set_simd_level(query::kernels::detected_simd_level());
+  }
+
+  SimdLevelGuard(const SimdLevelGuard &) = delete;
+  SimdLevelGuard &operator=(const SimdLevelGuard &) = delete;
+};
+
+char fold(char c) {
+  return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+bool same(std::string_view a, std::string_view b, bool ignore_case) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (ignore_case ? fold(a[i]) != fold(b[i]) : a[i] != b[i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool reference_match(std::string_view value, StringMatch shape,
+                     std::string_view pattern, bool ignore_case) {
+  if (pattern.size() > value.size()) {
+    return false;
+  }
+  switch (shape) {
+  case StringMatch::EQUALS:
+    return same(value, pattern, ignore_case);
+  case StringMatch::PREFIX:
+    return same(value.substr(0, pattern.size()), pattern, ignore_case);
+  case StringMatch::SUFFIX:
+    return same(value.substr(value.size() - pattern.size()), pattern,
+                ignore_case);
+  case StringMatch::CONTAINS:
+    for (size_t i = 0; i + pattern.size() <= value.size(); ++i) {
+      if (same(value.substr(i, pattern.size()), pattern, ignore_case)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  return false;
+}
+
+/// @brief Strings packed as a heap plus offsets, like a VARLEN vector
+struct StringBatch {
+  std::vector<std::string> values;
+  std::vector<uint32_t> offsets{0};
+  std::string heap;
+
+  void add(std::string value) {
+    heap += value;
+    offsets.push_back(static_cast<uint32_t>(heap.size()));
+    values.push_back(std::move(value));
+  }
+};
+
+/**
+ * @brief Random strings over a tiny alphabet so patterns hit often
+ *
+ * The alphabet includes the bytes on either side of 'A'-'Z' and 'a'-'z'
+ * and a non-ASCII byte, which case folding must leave alone.
+ */
+StringBatch make_batch(size_t rows, uint64_t seed) {
+  static constexpr std::string_view ALPHABET = "abcABC@[`{/\xC3";
+  std::mt19937_64 rng(seed);
+  StringBatch batch;
+  for (size_t row = 0; row < rows; ++row) {
+    // Mostly short strings, some past a 64-byte register
+    const size_t length = rng() % 8 == 0 ? rng() % 150 : rng() % 12;
+    std::string value;
+    for (size_t i = 0; i < length; ++i) {
+      value += ALPHABET[rng() % ALPHABET.size()];
+    }
+    batch.add(std::move(value));
+  }
+
+  return batch;
+}
+
+std::vector<std::string> make_patterns() {
+  return {"",       "a",  "A",      "ab",   "aB",
+          "abc",    "@[", "`{",     "\xC3", "cab/AbC",
+          std::string(40, 'a'),     "abcabcabcabcabcabcabcabcabcabcabcabc"};
+}
+
+TEST(StringKernelTest, MatchMatchesScalarReference) {
+  SimdLevelGuard guard;
+  const auto patterns = make_patterns();
+
+  for (auto level : supported_levels()) {
+    query::kernels::set_simd_level(level);
+    for (size_t rows : {0, 1, 31, 64, 65, 1000}) {
+      const auto batch = make_batch(rows, rows + 11);
+      for (auto shape : ALL_SHAPES) {
+        for (const auto &pattern : patterns) {
+          for (bool ignore_case : {false, true}) {
+            std::vector<uint64_t> expected(query::kernels::bitmap_words(rows));
+            std::vector<uint32_t> expected_selection;
+            for (size_t row = 0; row < rows; ++row) {
+              if (reference_match(batch.values[row], shape, pattern,
+                                  ignore_case)) {
+                expected[row / 64] |= uint64_t{1} << (row % 64);
+                expected_selection.push_back(static_cast<uint32_t>(row));
+              }
+            }
+
+            std::vector<uint64_t> bitmap(expected.size(), ~uint64_t{0});
+            query::kernels::match(batch.offsets, batch.heap, shape, pattern,
+                                  ignore_case, bitmap.data());
+            EXPECT_EQ(bitmap, expected)
+                << to_string(level) << " rows=" << rows
+                << " shape=" << query::to_string(shape) << " pattern='"
+                << pattern << "' ignore_case=" << ignore_case;
+
+            std::vector<uint32_t> selection(rows);
+            selection.resize(query::kernels::select_match(
+                batch.offsets, batch.heap, shape, pattern, ignore_case,
+                selection.data()));
+            EXPECT_EQ(selection, expected_selection)
+                << to_string(level) << " rows=" << rows;
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(StringKernelTest, OffsetsNeedNotStartAtZero) {
+  SimdLevelGuard guard;
+  StringBatch batch;
+  batch.add("abcab");
+  batch.add("xxab");
+  batch.add("abxx");
+  batch.add("cab");
+
+  // Skip the first string; its bytes stay in the heap before offsets[0]
+  const std::span<const uint32_t> offsets(batch.offsets.data() + 1, 4);
+  for (auto level : supported_levels()) {
+    query::kernels::set_simd_level(level);
+    std::vector<uint64_t> bitmap(1);
+    query::kernels::match(offsets, batch.heap, StringMatch::CONTAINS, "ab",
+                          false, bitmap.data());
+    EXPECT_EQ(bitmap[0], 0b111u) << to_string(level);
+
+    query::kernels::match(offsets, batch.heap, StringMatch::CONTAINS, "bca",
+                          false, bitmap.data());
+    EXPECT_EQ(bitmap[0], 0u) << to_string(level);
+  }
+}
+
+TEST(StringKernelTest, ColumnNullsNeverMatch) {
+  SimdLevelGuard guard;
+  query::ColumnVector column(dtypes::TypeId::VARCHAR);
+  for (size_t row = 0; row < 200; ++row) {
+    if (row % 3 == 0) {
+      column.append_null();
+    } else {
+      column.append_string(row % 2 == 0 ? "http://Example.com/a"
+                                        : "https://example.org");
+    }
+  }
+
+  for (auto level : supported_levels()) {
+    query::kernels::set_simd_level(level);
+    std::vector<uint64_t> bitmap(query::kernels::bitmap_words(200));
+    query::kernels::match(column, StringMatch::CONTAINS, "EXAMPLE", true,
+                          bitmap.data());
+    std::vector<uint32_t> selection(200);
+    selection.resize(
+        query::kernels::to_selection(bitmap.data(), 200, selection.data()));
+
+    std::vector<uint32_t> expected;
+    for (uint32_t row = 0; row < 200; ++row) {
+      if (row % 3 != 0) {
+        expected.push_back(row);
+      }
+    }
+    EXPECT_EQ(selection, expected) << to_string(level);
+  }
+}
+} // namespace
+} // namespace velox::test
@@ -0,0 +1,175 @@
+/**
+ * @file test_common.hpp
+ * @author Carlos Salguero
+ * @brief Shared fixtures and helpers for VeloxDB unit tests
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+#include <vector>
+#include <velox/query/operators.hpp>
+
+namespace velox::test {
+/// @brief Rows as value lists, for building tables and expected results
+using Rows = std::vector<std::vector<dtypes::Value>>;
+
+/// @brief Check for a NULL value without the dtypes helpers
+inline bool is_null_value(const dtypes::Value &value) noexcept {
+  return std::holds_alternative<std::nullptr_t>(value);
+}
+
+/**
+ * @brief Build an in-memory table
+ *
+ * @param schema Table schema
+ * @param rows Rows to append
+ * @return Table holding the rows in order
+ */
+inline std::shared_ptr<query::ColumnarTable>
+make_table(const query::Schema &schema, const Rows &rows) {
+  auto table = std::make_shared<query::ColumnarTable>(schema);
+  for (const auto &values : rows) {
+    auto appended = table->append_row(dtypes::Row(values));
+    EXPECT_TRUE(appended.has_value());
+  }
+
+  return table;
+}
+
+/**
+ * @brief Render one row as text
+ *
+ * @note Values are compared through their literal text so tests do not
+ *       depend on dtypes comparison operators.
+ */
+inline std::string render_row(const query::DataChunk &chunk, size_t row) {
+  std::string text;
+  for (size_t c = 0; c < chunk.column_count(); ++c) {
+    text += c == 0 ? "" : "|";
+    text += query::format_literal(chunk.column(c).value_at(row));
+  }
+
+  return text;
+}
+
+/// @brief Render a list of values the way render_row() renders a row
+inline std::string render_values(const std::vector<dtypes::Value> &values) {
+  std::string text;
+  for (size_t c = 0; c < values.size(); ++c) {
+    text += c == 0 ? "" : "|";
+    text += query::format_literal(values[c]);
+  }
+
+  return text;
+}
+
+/**
+ * @brief Pull an operator to completion
+ *
+ * @param op Operator to run
+ * @return Rendered rows in output order
+ */
+inline std::vector<std::string> collect(query::Operator &op) {
+  std::vector<std::string> rows;
+  query::DataChunk chunk;
+  while (true) {
+    auto more = op.next(chunk);
+    EXPECT_TRUE(more.has_value());
+    if (!more || !*more) {
+      break;
+    }
+    EXPECT_LE(chunk.size(), query::config::VECTOR_SIZE);
+    for (size_t row = 0; row < chunk.size(); ++row) {
+      rows.push_back(render_row(chunk, row));
+    }
+  }
+
+  return rows;
+}
+
+/// @brief Pull an operator to completion, ignoring row order
+inline std::vector<std::string> collect_sorted(query::Operator &op) {
+  auto rows = collect(op);
+  std::sort(rows.begin(), rows.end());
+
+  return rows;
+}
+
+/// @brief Render and sort expected rows
+inline std::vector<std::string> render_sorted(const Rows &rows) {
+  std::vector<std::string> rendered;
+  rendered.reserve(rows.size());
+  for (const auto &values : rows) {
+    rendered.push_back(render_values(values));
+  }
+  std::sort(rendered.begin(), rendered.end());
+
+  return rendered;
+}
+
+/**
+ * @brief Unique scratch directory removed on destruction
+ */
+class TempDirectory {
+public:
+  /**
+   * @brief Create a fresh directory under the system temp path
+   *
+   * @param prefix Directory name prefix
+   */
+  explicit TempDirectory(std::string_view prefix = "velox_test") {
+    static std::atomic<uint64_t> sequence{0};
+    m_path = std::filesystem::temp_directory_path() /
+             fmt::format("{}_{}_{}", prefix, ::getpid(),
+                         sequence.fetch_add(1, std::memory_order_relaxed));
+    std::filesystem::create_directories(m_path);
+  }
+
+  /// @brief Remove the directory and its contents
+  ~TempDirectory() {
+    std::error_code ec;
+    std::filesystem::remove_all(m_path, ec);
+  }
+
+  TempDirectory(const TempDirectory &) = delete;
+  TempDirectory &operator=(const TempDirectory &) = delete;
+
+  /**
+   * @brief Get the directory path
+   * @return Path of the directory
+   */
+  [[nodiscard]] const std::filesystem::path &path() const noexcept {
+    return m_path;
+  }
+
+  /**
+   * @brief Count the regular files left in the directory
+   * @return Number of files
+   */
+  [[nodiscard]] size_t file_count() const {
+    size_t files = 0;
+    for (const auto &entry :
+         std::filesystem::recursive_directory_iterator(m_path)) {
+      files += entry.is_regular_file() ? 1 : 0;
+    }
+
+    return files;
+  }
+
+private:
+  std::filesystem::path m_path;
+};
+} // namespace velox::test
@@ -0,0 +1,157 @@
+/**
+ * @file top_n_test.cpp
+ * @author Carlos Salguero
+ * @brief Tests for TopN against Sort followed by Limit, and for the scan
+ *        threshold it publishes
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "test_common.hpp"
+
+#include <random>
+
+namespace velox::test {
+namespace {
+using dtypes::TypeId;
+using dtypes::Value;
+
+const query::Schema EVENTS{{"ts", TypeId::BIGINT},
+                           {"user", TypeId::VARCHAR},
+                           {"score", TypeId::DOUBLE},
+                           {"seq", TypeId::INTEGER}};
+
+/// @brief Events with ties and NULLs; seq records input order
+Rows make_events(size_t count) {
+  std::mt19937_64 rng(31);
+  Rows rows;
+  for (size_t i = 0; i < count; ++i) {
+    Value ts = rng() % 17 == 0 ? Value(nullptr)
+                               : Value(static_cast<int64_t>(rng() % 500));
+    Value user = rng() % 13 == 0 ? Value(nullptr)
+                                 : Value(fmt::format("u{}", rng() % 9));
+    Value score = static_cast<double>(rng() % 100) - 50.5;
+    rows.push_back({ts, user, score, static_cast<int32_t>(i)});
+  }
+
+  return rows;
+}
+
+/// @brief Pass-through that counts the rows flowing out of its child
+class CountingOperator final : public query::Operator {
+public:
+  CountingOperator(query::OperatorPtr child, size_t &rows)
+      : Operator(child->schema()), m_child(std::move(child)), m_rows(rows) {}
+
+  error::Result<bool> next(query::DataChunk &output) override {
+    auto more = m_child->next(output);
+    if (more && *more) {
+      m_rows += output.size();
+    }
+    return more;
+  }
+
+  void reset() override { m_child->reset(); }
+
+  std::string name() const override { return "Counting"; }
+
+private:
+  query::OperatorPtr m_child;
+  size_t &m_rows;
+};
+
+const std::vector<std::vector<query::SortKey>> ORDERINGS{
+    {{0, false, false}},
+    {{0, true, true}, {3, false, false}},
+    {{1, true, false}, {2, false, false}},
+    {{2, true, false}, {0, false, true}, {1, false, true}}};
+
+TEST(TopNTest, MatchesSortThenLimit) {
+  auto table = make_table(EVENTS, make_events(5000));
+
+  for (const auto &keys : ORDERINGS) {
+    for (size_t limit : {0, 1, 10, 100, 1024, 1500, 6000}) {
+      for (size_t offset : {0, 7, 1100}) {
+        query::Limit reference(
+            std::make_unique<query::Sort>(
+                std::make_unique<query::TableScan>(table), keys),
+            limit, offset);
+        const auto expected = collect(reference);
+
+        query::TopN top_n(std::make_unique<query::TableScan>(table), keys,
+                          limit, offset);
+        EXPECT_EQ(collect(top_n), expected)
+            << "limit=" << limit << " offset=" << offset;
+
+        top_n.reset();
+        EXPECT_EQ(collect(top_n).size(), expected.size());
+      }
+    }
+  }
+}
+
+TEST(TopNTest, BoundLetsScanSkipChunks) {
+  // Rows arrive best first in both directions, so once the first chunk
+  // fills the heap every later chunk is behind the threshold
+  Rows rows;
+  for (int64_t i = 0; i < 50000; ++i) {
+    rows.push_back({i, std::string("u"), 0.0, static_cast<int32_t>(i)});
+  }
+  auto ascending = make_table(EVENTS, rows);
+  std::reverse(rows.begin(), rows.end());
+  auto descending = make_table(EVENTS, rows);
+
+  for (bool latest : {true, false}) {
+    const query::SortKey key{0, !latest, false};
+    auto table = latest ? descending : ascending;
+
+    size_t scanned = 0;
+    auto bound = std::make_shared<query::TopNBound>(key);
+    auto scan = std::make_unique<query::TableScan>(table);
+    scan->set_bound(bound, 0);
+    query::TopN top_n(std::make_unique<CountingOperator>(std::move(scan),
+                                                         scanned),
+                      {key}, 100, 0, bound);
+
+    query::Limit reference(
+        std::make_unique<query::Sort>(
+            std::make_unique<query::TableScan>(table),
+            std::vector<query::SortKey>{key}),
+        100);
+    EXPECT_EQ(collect(top_n), collect(reference));
+    EXPECT_LT(scanned, table->row_count() / 10);
+
+    // The bound now rejects a chunk entirely behind the kept rows
+    query::ZoneMap behind;
+    std::vector<uint64_t> prefixes(2);
+    query::ColumnVector values(TypeId::BIGINT);
+    values.append<int64_t>(latest ? 0 : 49999);
+    values.append<int64_t>(latest ? 1 : 49998);
+    query::order_prefixes(values, 0, 2, true, prefixes.data());
+    behind.min = std::min(prefixes[0], prefixes[1]);
+    behind.max = std::max(prefixes[0], prefixes[1]);
+    behind.values = 2;
+    EXPECT_TRUE(bound->excludes(behind));
+  }
+}
+
+TEST(TopNTest, BoundNeverExcludesLeadingNulls) {
+  auto bound = std::make_shared<query::TopNBound>(query::SortKey{0, true,
+                                                                 true});
+  bound->publish(0);
+  query::ZoneMap zone;
+  zone.min = 10;
+  zone.max = 20;
+  zone.values = 5;
+  zone.nulls = 1;
+  EXPECT_FALSE(bound->excludes(zone));
+  zone.nulls = 0;
+  EXPECT_TRUE(bound->excludes(zone));
+  bound->reset();
+  EXPECT_FALSE(bound->excludes(zone));
+}
+} // namespace
+} // namespace velox::test
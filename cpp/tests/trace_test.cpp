@@ -0,0 +1,290 @@
+/**
+ * @file trace_test.cpp
+ * @author Carlos Salguero
+ * @brief Tests for per-operation latency breakdowns: exclusive phase time,
+ *        the seqlock trace ring and the Chrome trace output
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "test_common.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <velox/metrics/trace.hpp>
+#include <velox/query/query_processor.hpp>
+#include <velox/query/spill.hpp>
+
+namespace velox::test {
+namespace {
+using metrics::OperationTrace;
+using metrics::PhaseScope;
+using metrics::TracePhase;
+using metrics::TraceScope;
+using namespace std::chrono_literals;
+
+/// @brief Samples every operation for the lifetime of a test
+class TraceTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    metrics::set_trace_sample_rate(1);
+    metrics::detail::t_sample_countdown = 0;
+    metrics::global_trace_ring().clear();
+  }
+
+  void TearDown() override {
+    metrics::set_trace_sample_rate(metrics::config::DEFAULT_TRACE_SAMPLE_RATE);
+  }
+
+  /// @brief Latest published trace of an operation, if any
+  static std::optional<OperationTrace> find_trace(std::string_view operation) {
+    const auto traces = metrics::global_trace_ring().snapshot();
+    for (auto it = traces.rbegin(); it != traces.rend(); ++it) {
+      if (it->operation == operation) {
+        return *it;
+      }
+    }
+
+    return std::nullopt;
+  }
+};
+
+/// @brief Trace whose fields all derive from one value, to detect torn reads
+OperationTrace make_trace(uint64_t value) {
+  OperationTrace trace;
+  trace.operation = "ring";
+  trace.thread_index = value;
+  trace.start_ns = value;
+  trace.duration_ns = value * 8;
+  trace.phase_ns.fill(value);
+  trace.span_count = 1;
+  trace.spans[0] = {TracePhase::IO_WAIT, value, value};
+
+  return trace;
+}
+
+TEST_F(TraceTest, NestedPhasesAreChargedExclusiveTime) {
+  {
+    TraceScope trace("nested_phases");
+    ASSERT_TRUE(trace.is_sampled());
+    PhaseScope io(TracePhase::IO_WAIT);
+    std::this_thread::sleep_for(2ms);
+    {
+      PhaseScope latch(TracePhase::LATCH_WAIT);
+      std::this_thread::sleep_for(20ms);
+    }
+  }
+
+  const auto trace = find_trace("nested_phases");
+  ASSERT_TRUE(trace.has_value());
+  const auto io = trace->phase_time(TracePhase::IO_WAIT);
+  const auto latch = trace->phase_time(TracePhase::LATCH_WAIT);
+  EXPECT_GE(latch, 20'000'000u);
+  EXPECT_GE(io, 2'000'000u);
+  EXPECT_LT(io, 20'000'000u) << "outer phase was charged the inner one";
+  EXPECT_LE(io + latch + trace->unattributed_ns(), trace->duration_ns);
+  EXPECT_EQ(trace->phase_time(TracePhase::FSYNC), 0u);
+
+  // Spans keep full durations: the outer one covers the inner one
+  ASSERT_EQ(trace->span_count, 2u);
+  EXPECT_EQ(trace->spans[0].phase, TracePhase::LATCH_WAIT);
+  EXPECT_EQ(trace->spans[1].phase, TracePhase::IO_WAIT);
+  EXPECT_GE(trace->spans[1].duration_ns, trace->spans[0].duration_ns);
+}
+
+TEST_F(TraceTest, InnerScopesJoinTheOutermostTrace) {
+  {
+    TraceScope outer("outer_operation");
+    TraceScope inner("inner_operation");
+    EXPECT_FALSE(inner.is_sampled());
+    PhaseScope wal(TracePhase::WAL_WAIT);
+  }
+
+  EXPECT_TRUE(find_trace("outer_operation").has_value());
+  EXPECT_FALSE(find_trace("inner_operation").has_value());
+
+  // Without an active trace a phase records nothing
+  { PhaseScope orphan(TracePhase::FSYNC); }
+  EXPECT_EQ(metrics::active_trace(), nullptr);
+}
+
+TEST_F(TraceTest, SpansBeyondTheLimitAreSummedAndCounted) {
+  constexpr size_t PHASES = metrics::config::TRACE_MAX_SPANS + 5;
+  {
+    TraceScope trace("many_spans");
+    for (size_t i = 0; i < PHASES; ++i) {
+      PhaseScope hit(TracePhase::BUFFER_HIT);
+    }
+  }
+
+  const auto trace = find_trace("many_spans");
+  ASSERT_TRUE(trace.has_value());
+  EXPECT_EQ(trace->span_count, metrics::config::TRACE_MAX_SPANS);
+  EXPECT_EQ(trace->dropped_spans, 5u);
+}
+
+TEST_F(TraceTest, SamplingRateSkipsOperations) {
+  metrics::set_trace_sample_rate(0);
+  { TraceScope trace("never_sampled"); }
+  EXPECT_FALSE(find_trace("never_sampled").has_value());
+
+  metrics::set_trace_sample_rate(4);
+  size_t sampled = 0;
+  for (size_t i = 0; i < 40; ++i) {
+    TraceScope trace("one_in_four");
+    sampled += trace.is_sampled() ? 1 : 0;
+  }
+  EXPECT_EQ(sampled, 10u);
+}
+
+TEST(TraceRingTest, OverwritesTheOldestTraces) {
+  metrics::TraceRing ring(4);
+  EXPECT_TRUE(ring.snapshot().empty());
+
+  for (uint64_t i = 0; i < 10; ++i) {
+    ring.push(make_trace(i));
+  }
+
+  EXPECT_EQ(ring.capacity(), 4u);
+  EXPECT_EQ(ring.total_pushed(), 10u);
+  EXPECT_EQ(ring.dropped(), 0u);
+
+  const auto traces = ring.snapshot();
+  ASSERT_EQ(traces.size(), 4u);
+  for (size_t i = 0; i < traces.size(); ++i) {
+    EXPECT_EQ(traces[i].start_ns, 6 + i);
+  }
+
+  ring.clear();
+  EXPECT_TRUE(ring.snapshot().empty());
+  ring.push(make_trace(42));
+  ASSERT_EQ(ring.snapshot().size(), 1u);
+  EXPECT_EQ(ring.snapshot()[0].start_ns, 42u);
+}
+
+TEST(TraceRingTest, ConcurrentReadersNeverSeeTornTraces) {
+  metrics::TraceRing ring(8);
+  constexpr size_t WRITERS = 4;
+  constexpr uint64_t PUSHES = 20000;
+  std::atomic<bool> done{false};
+
+  std::vector<std::thread> writers;
+  for (size_t w = 0; w < WRITERS; ++w) {
+    writers.emplace_back([&ring, w] {
+      for (uint64_t i = 1; i <= PUSHES; ++i) {
+        ring.push(make_trace(w * PUSHES + i));
+      }
+    });
+  }
+
+  size_t checked = 0;
+  std::thread reader([&] {
+    while (!done.load(std::memory_order_acquire)) {
+      for (const auto &trace : ring.snapshot()) {
+        const auto value = trace.start_ns;
+        ASSERT_EQ(trace.thread_index, value);
+        ASSERT_EQ(trace.duration_ns, value * 8);
+        ASSERT_EQ(trace.spans[0].duration_ns, value);
+        for (auto phase : trace.phase_ns) {
+          ASSERT_EQ(phase, value);
+        }
+        ++checked;
+      }
+    }
+  });
+
+  for (auto &writer : writers) {
+    writer.join();
+  }
+  done.store(true, std::memory_order_release);
+  reader.join();
+
+  EXPECT_EQ(ring.total_pushed(), WRITERS * PUSHES);
+  EXPECT_LE(ring.snapshot().size(), ring.capacity());
+  EXPECT_GT(checked, 0u);
+}
+
+TEST(ChromeTraceTest, RendersOperationsAndPhaseSpans) {
+  auto trace = make_trace(1500);
+  trace.operation = "get \"record\"";
+  trace.phase_ns.fill(0);
+  trace.phase_ns[static_cast<size_t>(TracePhase::IO_WAIT)] = 1500;
+  trace.duration_ns = 4000;
+  trace.dropped_spans = 3;
+  const std::vector<OperationTrace> traces{trace};
+
+  const auto json = metrics::to_chrome_trace_json(traces);
+  EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0),
+            0u);
+  EXPECT_EQ(json.substr(json.size() - 2), "]}");
+  EXPECT_NE(json.find("{\"name\":\"get \\\"record\\\"\",\"cat\":\"operation\","
+                      "\"ph\":\"X\",\"ts\":1.500,\"dur\":4.000,\"pid\":1,"
+                      "\"tid\":1500,"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"io_wait_us\":1.500"), std::string::npos);
+  EXPECT_NE(json.find("\"fsync_us\":0.000"), std::string::npos);
+  EXPECT_NE(json.find("\"unattributed_us\":2.500,\"dropped_spans\":3"),
+            std::string::npos);
+  EXPECT_NE(json.find("{\"name\":\"io_wait\",\"cat\":\"phase\",\"ph\":\"X\","
+                      "\"ts\":3.000,\"dur\":1.500,\"pid\":1,\"tid\":1500}"),
+            std::string::npos);
+
+  EXPECT_EQ(metrics::to_chrome_trace_json({}),
+            "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[]}");
+}
+
+TEST_F(TraceTest, DumpWritesTheGlobalRing) {
+  { TraceScope trace("dumped_operation"); }
+
+  TempDirectory directory("velox_trace");
+  const auto file = directory.path() / "trace.json";
+  ASSERT_TRUE(metrics::dump_chrome_trace(file).has_value());
+
+  std::ifstream input(file);
+  const std::string json((std::istreambuf_iterator<char>(input)),
+                         std::istreambuf_iterator<char>());
+  EXPECT_NE(json.find("\"name\":\"dumped_operation\""), std::string::npos);
+
+  EXPECT_FALSE(
+      metrics::dump_chrome_trace(directory.path() / "missing" / "trace.json")
+          .has_value());
+}
+
+TEST_F(TraceTest, QueryExecutionAndSpillIoAreTraced) {
+  const query::Schema schema{{"id", dtypes::TypeId::BIGINT}};
+  Rows rows;
+  for (int64_t i = 0; i < 100; ++i) {
+    rows.push_back({i});
+  }
+  query::QueryPlan plan(
+      std::make_unique<query::TableScan>(make_table(schema, rows)));
+  query::QueryProcessor processor;
+  ASSERT_TRUE(processor.execute(plan).has_value());
+  EXPECT_TRUE(find_trace("query_execute").has_value());
+
+  TempDirectory directory("velox_trace");
+  {
+    TraceScope trace("spill_round_trip");
+    auto spill = query::SpillFile::create(directory.path(), schema);
+    ASSERT_TRUE(spill.has_value());
+
+    query::TableScan scan(make_table(schema, rows));
+    query::DataChunk chunk;
+    ASSERT_TRUE(scan.next(chunk).value_or(false));
+    ASSERT_TRUE((*spill)->write(chunk).has_value());
+    ASSERT_TRUE((*spill)->rewind().has_value());
+    ASSERT_TRUE((*spill)->read(chunk).value_or(false));
+    EXPECT_EQ(chunk.size(), rows.size());
+  }
+
+  const auto trace = find_trace("spill_round_trip");
+  ASSERT_TRUE(trace.has_value());
+  EXPECT_GT(trace->phase_time(TracePhase::IO_WAIT), 0u);
+  EXPECT_GE(trace->span_count, 2u);
+}
+} // namespace
+} // namespace velox::test